@@ -0,0 +1,327 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_ACTIVEOBJECT_HPP
+#define FREERTOS_ACTIVEOBJECT_HPP
+
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <type_traits>
+#include <variant>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class ActiveObjectQueue ActiveObject.hpp <FreeRTOS/ActiveObject.hpp>
+ *
+ * @brief Class that holds the event queue of a FreeRTOS::ActiveObject.  It is
+ * a separate base class so that the queue is created before the task that
+ * reads it.
+ *
+ * @note This class is not intended to be instantiated by the user.  Use
+ * FreeRTOS::ActiveObject.
+ *
+ * @tparam Event Type of the events stored in the queue.
+ * @tparam Depth The number of events the queue can hold.
+ */
+template <class Event, UBaseType_t Depth>
+class ActiveObjectQueue {
+ protected:
+  ActiveObjectQueue() = default;
+  ~ActiveObjectQueue() = default;
+
+  ActiveObjectQueue(const ActiveObjectQueue&) = delete;
+  ActiveObjectQueue& operator=(const ActiveObjectQueue&) = delete;
+
+  StaticQueue<Event, Depth> events;
+};
+
+/**
+ * @class ActiveObject ActiveObject.hpp <FreeRTOS/ActiveObject.hpp>
+ *
+ * @brief Class that pairs a task with a queue of events and dispatches every
+ * event to a handler selected at compile time.
+ *
+ * The event type is a <tt>std::variant</tt> of the event structures the
+ * object accepts.  The task blocks on the queue and, for every event it
+ * receives, calls the <tt>on()</tt> overload of the derived class that takes
+ * the alternative held by the variant.  The overload is chosen by
+ * <tt>std::visit</tt>, so there is no virtual call per event and a missing
+ * handler is a compile error rather than a silently ignored message.
+ *
+ * Each handler runs to completion before the next event is received.  If a
+ * budget is given to the constructor, a handler that takes longer than the
+ * budget is counted and reported to <tt>onBudgetExceeded()</tt> of the derived
+ * class, which may be declared to log or assert on the overrun.
+ *
+ * @note This class is not intended to be instantiated by the user.  The user
+ * should create a class that derives from this class and implements an
+ * <tt>on()</tt> handler for every alternative of EventVariant.  The handlers
+ * must be accessible to this class, either by being public or by the derived
+ * class declaring this class a friend.
+ *
+ * @tparam Derived The class that derives from this class.
+ * @tparam EventVariant Type of the events, normally a <tt>std::variant</tt>.
+ * Must be trivially copyable because it is copied by the queue.
+ * @tparam Depth The number of events the queue can hold.
+ * @tparam StackWords The number of words of stack of the task.
+ *
+ * <b>Example Usage</b>
+ * @include ActiveObject/activeObject.cpp
+ */
+template <class Derived, class EventVariant, UBaseType_t Depth,
+          UBaseType_t StackWords = configMINIMAL_STACK_SIZE>
+class ActiveObject : private ActiveObjectQueue<EventVariant, Depth>,
+                     public StaticTask<StackWords> {
+  static_assert(std::is_trivially_copyable_v<EventVariant>,
+                "ActiveObject events must be trivially copyable.");
+
+ public:
+  ActiveObject(const ActiveObject&) = delete;
+  ActiveObject& operator=(const ActiveObject&) = delete;
+
+  /**
+   * ActiveObject.hpp
+   *
+   * @brief Function that posts an event to the back of the queue of the
+   * object.
+   *
+   * @param event The event to post.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for space to become available on the queue, should it already be full.
+   * @retval true The event was posted.
+   * @retval false The queue stayed full for ticksToWait ticks.
+   */
+  inline bool post(const EventVariant& event,
+                   const TickType_t ticksToWait = portMAX_DELAY) const {
+    return this->events.sendToBack(event, ticksToWait);
+  }
+
+  /**
+   * ActiveObject.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool post(const EventVariant& event,
+                   const std::chrono::duration<Rep, Period>& timeout) const {
+    return post(event, Clock::toTicks(timeout));
+  }
+
+  /**
+   * ActiveObject.hpp
+   *
+   * @brief Function that posts an event to the back of the queue of the object
+   * from an ISR.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * posting the event woke the task of the object, and that task has a
+   * priority higher than the currently running task.
+   * @param event The event to post.
+   * @retval true The event was posted.
+   * @retval false The queue was full, so the event was dropped.
+   */
+  inline bool postFromISR(bool& higherPriorityTaskWoken,
+                          const EventVariant& event) const {
+    return this->events.sendToBackFromISR(higherPriorityTaskWoken, event);
+  }
+
+  /**
+   * ActiveObject.hpp
+   *
+   * @overload
+   */
+  inline bool postFromISR(const EventVariant& event) const {
+    return this->events.sendToBackFromISR(event);
+  }
+
+  /**
+   * ActiveObject.hpp
+   *
+   * @brief Function that posts an event to the front of the queue of the
+   * object, so that it is handled before every event already waiting.
+   *
+   * @param event The event to post.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for space to become available on the queue, should it already be full.
+   * @retval true The event was posted.
+   * @retval false The queue stayed full for ticksToWait ticks.
+   */
+  inline bool postUrgent(const EventVariant& event,
+                         const TickType_t ticksToWait = portMAX_DELAY) const {
+    return this->events.sendToFront(event, ticksToWait);
+  }
+
+  /**
+   * ActiveObject.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool postUrgent(
+      const EventVariant& event,
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return postUrgent(event, Clock::toTicks(timeout));
+  }
+
+  /**
+   * ActiveObject.hpp
+   *
+   * @brief Function that posts an event to the front of the queue of the
+   * object from an ISR.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * posting the event woke the task of the object, and that task has a
+   * priority higher than the currently running task.
+   * @param event The event to post.
+   * @retval true The event was posted.
+   * @retval false The queue was full, so the event was dropped.
+   */
+  inline bool postUrgentFromISR(bool& higherPriorityTaskWoken,
+                                const EventVariant& event) const {
+    return this->events.sendToFrontFromISR(higherPriorityTaskWoken, event);
+  }
+
+  /**
+   * ActiveObject.hpp
+   *
+   * @overload
+   */
+  inline bool postUrgentFromISR(const EventVariant& event) const {
+    return this->events.sendToFrontFromISR(event);
+  }
+
+  /**
+   * ActiveObject.hpp
+   *
+   * @brief Function that returns the number of events waiting to be handled.
+   *
+   * @return UBaseType_t The number of events in the queue.
+   */
+  inline UBaseType_t eventsWaiting() const {
+    return this->events.messagesWaiting();
+  }
+
+  /**
+   * ActiveObject.hpp
+   *
+   * @brief Function that returns the number of handlers that took longer than
+   * the budget given to the constructor.
+   *
+   * @return uint32_t The number of budget overruns.
+   */
+  inline uint32_t getOverruns() const {
+    return overruns;
+  }
+
+  /**
+   * ActiveObject.hpp
+   *
+   * @brief Function that returns the longest time a single handler has taken.
+   * Handlers are only timed when a budget was given to the constructor.
+   *
+   * @return TickType_t The longest handler time in ticks.
+   */
+  inline TickType_t getMaxHandlerTicks() const {
+    return maxHandlerTicks;
+  }
+
+ protected:
+  /**
+   * ActiveObject.hpp
+   *
+   * @brief Construct a new ActiveObject object, its queue and its task.
+   *
+   * @param priority The priority of the task.
+   * @param name A descriptive name for the task.
+   * @param budget The number of ticks a single handler may take before it is
+   * reported as an overrun.  0 disables the check.
+   */
+  explicit ActiveObject(const UBaseType_t priority = tskIDLE_PRIORITY,
+                        const char* name = "", const TickType_t budget = 0)
+      : StaticTask<StackWords>(deferCreate), budget(budget) {
+    // The task is created last, as it reads the budget as soon as it runs.
+    this->create(priority, name);
+  }
+  ~ActiveObject() = default;
+
+  /**
+   * ActiveObject.hpp
+   *
+   * @brief Function that is called by the task after a handler took longer
+   * than the budget.  The derived class may declare a function with the same
+   * signature to replace this one, which does nothing.
+   *
+   * @param elapsed The number of ticks the handler took.
+   */
+  inline void onBudgetExceeded(const TickType_t elapsed) {
+    static_cast<void>(elapsed);
+  }
+
+ private:
+  void taskFunction() final {
+    Derived& derived = static_cast<Derived&>(*this);
+    EventVariant event;
+
+    for (;;) {
+      if (!this->events.receive(event, portMAX_DELAY)) {
+        continue;
+      }
+
+      const TickType_t start = (budget > 0) ? xTaskGetTickCount() : 0;
+      std::visit([&derived](auto& alternative) { derived.on(alternative); },
+                 event);
+      if (budget > 0) {
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed > maxHandlerTicks) {
+          maxHandlerTicks = elapsed;
+        }
+        if (elapsed > budget) {
+          overruns++;
+          derived.onBudgetExceeded(elapsed);
+        }
+      }
+    }
+  }
+
+  const TickType_t budget;
+  TickType_t maxHandlerTicks = 0;
+  uint32_t overruns = 0;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_ACTIVEOBJECT_HPP
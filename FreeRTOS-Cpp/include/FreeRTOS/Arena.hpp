@@ -0,0 +1,235 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_ARENA_HPP
+#define FREERTOS_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_MALLOC_FAILED_HOOK == 1)
+extern "C" void vApplicationMallocFailedHook(void);
+#endif /* configUSE_MALLOC_FAILED_HOOK */
+
+namespace FreeRTOS {
+
+/**
+ * @class StaticArena Arena.hpp <FreeRTOS/Arena.hpp>
+ *
+ * @brief Class that allocates memory by bumping a pointer through a buffer
+ * contained in the object instance.
+ *
+ * An arena suits an application that creates all of its dynamic objects at
+ * boot and never deletes them.  Compared to heap_4 there is no free list, no
+ * coalescing, no search and no per block header, so allocation takes a few
+ * instructions, the memory can never fragment and every byte of the buffer is
+ * usable apart from alignment padding.  Memory can not be freed.
+ *
+ * The arena can be frozen, after which every allocation fails.  When it is
+ * used as the FreeRTOS heap with FREERTOS_CPP_DEFINE_ARENA_HEAP() it freezes
+ * itself once the scheduler has started, so an object created at run time by
+ * mistake is caught by <tt>configASSERT()</tt> instead of slowly consuming the
+ * arena.  Objects that really are created and deleted at run time should use
+ * static allocation or a FreeRTOS::StaticBlockPool.
+ *
+ * @warning The arena is not protected against concurrent use.  Allocate from
+ * one task, or before the scheduler is started.
+ *
+ * @tparam Size The number of bytes in the arena.
+ *
+ * <b>Example Usage</b>
+ * @include Arena/arena.cpp
+ */
+template <size_t Size>
+class StaticArena {
+  static_assert(Size > 0, "The arena must contain at least one byte.");
+
+ public:
+  StaticArena() = default;
+  ~StaticArena() = default;
+
+  StaticArena(const StaticArena&) = delete;
+  StaticArena& operator=(const StaticArena&) = delete;
+
+  /**
+   * Arena.hpp
+   *
+   * @brief Function that allocates memory from the arena.
+   *
+   * @param size The number of bytes to allocate.
+   * @param alignment The alignment of the memory, which must be a power of two.
+   * @return void* The allocated memory, or NULL if the arena is frozen or does
+   * not have enough space left.
+   */
+  void* allocate(const size_t size,
+                 const size_t alignment = portBYTE_ALIGNMENT) {
+    const size_t start = (used + alignment - 1) & ~(alignment - 1);
+    if (frozen || (size == 0) || (start > Size) || (size > Size - start)) {
+      return NULL;
+    }
+    used = start + size;
+    return &storage[start];
+  }
+
+  /**
+   * Arena.hpp
+   *
+   * @brief Function that allocates memory on behalf of
+   * <tt>pvPortMalloc()</tt>.
+   *
+   * The arena is frozen the first time it is called after the scheduler has
+   * started.  A failed allocation calls <tt>vApplicationMallocFailedHook()</tt>
+   * when <tt>configUSE_MALLOC_FAILED_HOOK</tt> is 1, and
+   * <tt>configASSERT()</tt> if the arena was frozen.
+   *
+   * @param size The number of bytes to allocate.
+   * @return void* The allocated memory, or NULL on failure.
+   */
+  void* allocateForKernel(const size_t size) {
+#if (INCLUDE_xTaskGetSchedulerState == 1)
+    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) {
+      freeze();
+    }
+#endif /* INCLUDE_xTaskGetSchedulerState */
+    void* pointer = allocate(size);
+    if (pointer == NULL) {
+#if (configUSE_MALLOC_FAILED_HOOK == 1)
+      vApplicationMallocFailedHook();
+#endif /* configUSE_MALLOC_FAILED_HOOK */
+      configASSERT(!frozen);
+    }
+    return pointer;
+  }
+
+  /**
+   * Arena.hpp
+   *
+   * @brief Function that stops any further allocation from the arena.
+   */
+  inline void freeze() {
+    frozen = true;
+  }
+
+  /**
+   * Arena.hpp
+   *
+   * @brief Function that checks if the arena is frozen.
+   *
+   * @retval true The arena is frozen and every allocation fails.
+   * @retval false Otherwise.
+   */
+  inline bool isFrozen() const {
+    return frozen;
+  }
+
+  /**
+   * Arena.hpp
+   *
+   * @brief Function that checks if a pointer was allocated from the arena.
+   *
+   * @param pointer The pointer to check.
+   * @retval true pointer is inside the allocated part of the arena.
+   * @retval false Otherwise.
+   */
+  inline bool contains(const void* pointer) const {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+    const uintptr_t first = reinterpret_cast<uintptr_t>(&storage[0]);
+    return (address >= first) && (address < first + used);
+  }
+
+  /**
+   * Arena.hpp
+   *
+   * @brief Function that returns the number of bytes allocated, including
+   * alignment padding.
+   *
+   * @return size_t The number of bytes used.
+   */
+  inline size_t getUsedSize() const {
+    return used;
+  }
+
+  /**
+   * Arena.hpp
+   *
+   * @brief Function that returns the number of bytes that have not been
+   * allocated.
+   *
+   * @return size_t The number of bytes left in the arena.
+   */
+  inline size_t getFreeSize() const {
+    return Size - used;
+  }
+
+ private:
+  alignas(portBYTE_ALIGNMENT) uint8_t storage[Size];
+  size_t used = 0;
+  bool frozen = false;
+};
+
+}  // namespace FreeRTOS
+
+/**
+ * @brief Macro that defines the FreeRTOS heap functions on top of a
+ * FreeRTOS::StaticArena.
+ *
+ * Expand this macro in exactly one source file, and do not link any of the
+ * kernel's heap_n.c files.  <tt>vPortFree()</tt> asserts, like heap_1, as the
+ * arena can not free memory.  <tt>xPortGetFreeHeapSize()</tt> and
+ * <tt>xPortGetMinimumEverFreeHeapSize()</tt> both return the space left in the
+ * arena, so FreeRTOS::Heap can still report on it.
+ *
+ * @code{cpp}
+ * #include <FreeRTOS/Arena.hpp>
+ *
+ * static FreeRTOS::StaticArena<8192> arena;
+ * FREERTOS_CPP_DEFINE_ARENA_HEAP(arena)
+ * @endcode
+ *
+ * @param arena The FreeRTOS::StaticArena object to allocate from.
+ */
+#define FREERTOS_CPP_DEFINE_ARENA_HEAP(arena)                                  \
+  extern "C" void* pvPortMalloc(size_t size) {                                 \
+    return (arena).allocateForKernel(size);                                    \
+  }                                                                            \
+  extern "C" void vPortFree(void* pointer) {                                   \
+    configASSERT(pointer == NULL);                                             \
+    (void)pointer;                                                             \
+  }                                                                            \
+  extern "C" size_t xPortGetFreeHeapSize(void) {                               \
+    return (arena).getFreeSize();                                              \
+  }                                                                            \
+  extern "C" size_t xPortGetMinimumEverFreeHeapSize(void) {                    \
+    return (arena).getFreeSize();                                              \
+  }                                                                            \
+  extern "C" void vPortInitialiseBlocks(void) {}
+
+#endif  // FREERTOS_ARENA_HPP
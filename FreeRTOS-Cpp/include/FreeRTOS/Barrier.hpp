@@ -0,0 +1,323 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_BARRIER_HPP
+#define FREERTOS_BARRIER_HPP
+
+#include <FreeRTOS/EventGroups.hpp>
+
+#include "FreeRTOS.h"
+#include "event_groups.h"
+#include "task.h"
+
+#if (configUSE_EVENT_GROUPS == 1) && (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class Barrier Barrier.hpp <FreeRTOS/Barrier.hpp>
+ *
+ * @brief Class that makes N tasks wait for each other at a synchronisation
+ * point, and that can be reused for any number of phases.
+ *
+ * Each task gets a Barrier::Participant from participant(), which assigns it
+ * its own event group bit.  Barrier::Participant::arriveAndWait() is a single
+ * call to <tt>xEventGroupSync()</tt>: it sets the bit of the participant and
+ * waits until the bits of all N participants are set, at which point the
+ * kernel clears them and releases every participant together.
+ *
+ * Consecutive phases use two separate sets of bits, selected by the phase
+ * generation that each participant keeps.  A participant that times out
+ * withdraws its arrival by clearing its bit in the set of the current phase,
+ * so a late participant can never be counted in the wrong phase.
+ *
+ * configUSE_EVENT_GROUPS and configSUPPORT_STATIC_ALLOCATION must be defined
+ * as 1 for this class to be available.
+ *
+ * @warning This class contains the storage buffer for the event group, so the
+ * user should create this object as a global object or with the static storage
+ * specifier so that the object instance is not on the stack.
+ *
+ * @tparam N The number of participants.  Two bits are used per participant, so
+ * N can be at most 4 when TickType_t is 16 bits and 12 when it is 32 bits.
+ *
+ * <b>Example Usage</b>
+ * @include Barrier/barrier.cpp
+ */
+template <UBaseType_t N>
+class Barrier {
+  static_assert(N > 0, "N must be at least 1.");
+  static_assert((2 * N) <= EventGroupBase::EventBits().size(),
+                "Two event group bits are needed for each participant.");
+
+ public:
+  /**
+   * @class Participant Barrier.hpp <FreeRTOS/Barrier.hpp>
+   *
+   * @brief The place of one task in a FreeRTOS::Barrier.
+   */
+  class Participant {
+   public:
+    /**
+     * Barrier.hpp
+     *
+     * @brief Function that calls <tt>EventBits_t xEventGroupSync(
+     * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, const
+     * EventBits_t uxBitsToWaitFor, TickType_t xTicksToWait )</tt> to arrive at
+     * the barrier and wait for the other participants.
+     *
+     * @see <https://www.freertos.org/xEventGroupSync.html>
+     *
+     * @warning This function cannot be called from an interrupt.
+     *
+     * @param ticksToWait The maximum amount of time to wait for the other
+     * participants.
+     * @retval true Every participant arrived and the next call waits for the
+     * next phase.
+     * @retval false The wait timed out.  The arrival was withdrawn, so the next
+     * call waits for the same phase again.
+     */
+    bool arriveAndWait(const TickType_t ticksToWait = portMAX_DELAY) {
+      const UBaseType_t shift = (phase ? N : 0);
+      const EventBits_t own = (static_cast<EventBits_t>(1) << index) << shift;
+      const EventBits_t all = allMask << shift;
+
+      if ((barrier->group.sync(own, all, ticksToWait) & all) != all) {
+        // Withdraw the arrival.  If the last participant arrived in the
+        // meantime the bit has already been cleared by the kernel.
+        if ((barrier->group.clear(own) & own) != 0) {
+          return false;
+        }
+      }
+      phase = !phase;
+      return true;
+    }
+
+    /**
+     * Barrier.hpp
+     *
+     * @brief Function that returns the index of the participant, which is the
+     * order in which it called participant().
+     *
+     * @return UBaseType_t The index, from 0 to N - 1.
+     */
+    inline UBaseType_t getIndex() const {
+      return index;
+    }
+
+   private:
+    friend class Barrier;
+
+    Participant(Barrier* barrier, const UBaseType_t index)
+        : barrier(barrier), index(index) {}
+
+    Barrier* barrier;
+    UBaseType_t index;
+    bool phase = false;
+  };
+
+  Barrier() = default;
+  ~Barrier() = default;
+
+  Barrier(const Barrier&) = delete;
+  Barrier& operator=(const Barrier&) = delete;
+
+  /**
+   * Barrier.hpp
+   *
+   * @brief Function that assigns the next free event group bit to a new
+   * participant.  It must be called exactly N times, once by each task, before
+   * the first phase.
+   *
+   * @return Participant The place of the calling task in the barrier.
+   */
+  Participant participant() {
+    taskENTER_CRITICAL();
+    const UBaseType_t index = participants++;
+    taskEXIT_CRITICAL();
+    configASSERT(index < N);
+    return Participant(this, index);
+  }
+
+ private:
+  static constexpr EventBits_t allMask =
+      (static_cast<EventBits_t>(1) << N) - 1;
+
+  StaticEventGroup group;
+  UBaseType_t participants = 0;
+};
+
+/**
+ * @class Latch Barrier.hpp <FreeRTOS/Barrier.hpp>
+ *
+ * @brief Class that lets any number of tasks wait until a counter, set when
+ * the latch is constructed, has been counted down to zero.
+ *
+ * Unlike a FreeRTOS::Barrier, a latch is used only once: after it has been
+ * released every current and future wait() returns immediately.  The count is
+ * decremented in a critical section and only the final countDown() makes a
+ * kernel call, which sets the single event group bit that wait() blocks on.
+ *
+ * configUSE_EVENT_GROUPS and configSUPPORT_STATIC_ALLOCATION must be defined
+ * as 1 for this class to be available.
+ *
+ * @warning This class contains the storage buffer for the event group, so the
+ * user should create this object as a global object or with the static storage
+ * specifier so that the object instance is not on the stack.
+ *
+ * <b>Example Usage</b>
+ * @include Barrier/latch.cpp
+ */
+class Latch {
+ public:
+  /**
+   * Barrier.hpp
+   *
+   * @brief Construct a new Latch object.
+   *
+   * @param count The number of countDown() calls needed to release the latch.
+   * A count of 0 creates a latch that is already released.
+   */
+  explicit Latch(const UBaseType_t count) : count(count) {
+    if (count == 0) {
+      group.set(releasedBit);
+    }
+  }
+  ~Latch() = default;
+
+  Latch(const Latch&) = delete;
+  Latch& operator=(const Latch&) = delete;
+
+  /**
+   * Barrier.hpp
+   *
+   * @brief Function that decrements the count, and releases the latch when it
+   * reaches zero.  Calls after the latch has been released have no effect.
+   */
+  inline void countDown() {
+    if (decrement()) {
+      group.set(releasedBit);
+    }
+  }
+
+  /**
+   * Barrier.hpp
+   *
+   * @brief A version of countDown() that can be called from an interrupt
+   * service routine.  The release is performed by the timer service task.
+   *
+   * @param higherPriorityTaskWoken Set to true if the timer service task was
+   * woken and a context switch should be requested before the interrupt exits.
+   * @retval true The count was decremented, or the release was posted to the
+   * timer service task.
+   * @retval false The release could not be posted because the timer command
+   * queue was full.
+   */
+  inline bool countDownFromISR(bool& higherPriorityTaskWoken) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool released = (count == 1);
+    if (count > 0) {
+      count--;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return (!released ||
+            group.setFromISR(higherPriorityTaskWoken, releasedBit));
+  }
+
+  /**
+   * Barrier.hpp
+   *
+   * @brief Function that calls <tt>EventBits_t xEventGroupWaitBits( const
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor, const
+   * BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits, TickType_t
+   * xTicksToWait )</tt> to wait for the latch to be released.
+   *
+   * @see <https://www.freertos.org/xEventGroupWaitBits.html>
+   *
+   * @warning This function cannot be called from an interrupt.
+   *
+   * @param ticksToWait The maximum amount of time to wait.
+   * @retval true The latch has been released.
+   * @retval false The wait timed out.
+   */
+  inline bool wait(const TickType_t ticksToWait = portMAX_DELAY) const {
+    return ((group.wait(releasedBit, false, false, ticksToWait) &
+             releasedBit) != 0);
+  }
+
+  /**
+   * Barrier.hpp
+   *
+   * @brief Function that counts down and then waits for the latch to be
+   * released.
+   *
+   * @param ticksToWait The maximum amount of time to wait.
+   * @retval true The latch has been released.
+   * @retval false The wait timed out.
+   */
+  inline bool arriveAndWait(const TickType_t ticksToWait = portMAX_DELAY) {
+    countDown();
+    return wait(ticksToWait);
+  }
+
+  /**
+   * Barrier.hpp
+   *
+   * @brief Function that checks if the latch has been released without
+   * blocking.
+   *
+   * @retval true The latch has been released.
+   * @retval false Otherwise.
+   */
+  inline bool tryWait() const {
+    return ((group.get().to_ulong() & releasedBit) != 0);
+  }
+
+ private:
+  static constexpr EventBits_t releasedBit = 1;
+
+  // Returns true for the call that takes the count to zero.
+  inline bool decrement() {
+    taskENTER_CRITICAL();
+    const bool released = (count == 1);
+    if (count > 0) {
+      count--;
+    }
+    taskEXIT_CRITICAL();
+    return released;
+  }
+
+  StaticEventGroup group;
+  UBaseType_t count;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_EVENT_GROUPS && configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_BARRIER_HPP
@@ -0,0 +1,286 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_BLOCKPOOL_HPP
+#define FREERTOS_BLOCKPOOL_HPP
+
+#include <FreeRTOS/Deadline.hpp>
+#include <FreeRTOS/Semaphore.hpp>
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class StaticBlockPool BlockPool.hpp <FreeRTOS/BlockPool.hpp>
+ *
+ * @brief Class that hands out fixed size memory blocks from a pool contained
+ * in the object instance, from tasks and from interrupts.
+ *
+ * Free blocks are kept on an intrusive list, so allocating and freeing a block
+ * pops or pushes one list entry in constant time.  The list is updated inside
+ * a critical section of a few instructions, as atomic compare and swap is not
+ * available on every port, and this works the same from a task or an
+ * interrupt.  Unlike <tt>pvPortMalloc()</tt> the pool can not fragment.
+ *
+ * allocate() can block until another task or interrupt frees a block.  Blocked
+ * tasks wait on a counting semaphore that is only given when a task is
+ * actually waiting, so allocating and freeing never calls into the kernel in
+ * the common case.
+ *
+ * @tparam BlockSize The usable size, in bytes, of each block.  Blocks are
+ * aligned for any type.
+ * @tparam Count The number of blocks in the pool.
+ *
+ * <b>Example Usage</b>
+ * @include BlockPool/blockPool.cpp
+ */
+template <size_t BlockSize, UBaseType_t Count>
+class StaticBlockPool {
+  static_assert(BlockSize > 0, "Blocks must be at least one byte.");
+  static_assert(Count > 0, "The pool must contain at least one block.");
+
+ public:
+  /**
+   * BlockPool.hpp
+   *
+   * @brief Construct a new StaticBlockPool object with every block free.
+   *
+   * @warning This class contains the storage for the blocks, so the user should
+   * create this object as a global object or with the static storage specifier
+   * so that the object instance is not on the stack.
+   */
+  StaticBlockPool() : blocksFreed(Count, 0) {
+    for (UBaseType_t i = 0; i < Count; i++) {
+      blocks[i].next = (i + 1 < Count) ? &blocks[i + 1] : NULL;
+    }
+  }
+  ~StaticBlockPool() = default;
+
+  StaticBlockPool(const StaticBlockPool&) = delete;
+  StaticBlockPool& operator=(const StaticBlockPool&) = delete;
+
+  /**
+   * BlockPool.hpp
+   *
+   * @brief Function that allocates a block from a task.
+   *
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for a block to be freed, should the pool be exhausted.
+   * @return void* The block, or NULL if ticksToWait expired first.
+   */
+  void* allocate(const TickType_t ticksToWait = portMAX_DELAY) {
+    const Deadline deadline(ticksToWait);
+    for (;;) {
+      taskENTER_CRITICAL();
+      Block* block = pop();
+      const bool wait = (block == NULL) && (ticksToWait != 0);
+      if (wait) {
+        waiting++;
+      }
+      taskEXIT_CRITICAL();
+      if (!wait) {
+        return block;
+      }
+
+      const bool woken = blocksFreed.take(deadline);
+
+      taskENTER_CRITICAL();
+      waiting--;
+      taskEXIT_CRITICAL();
+      if (!woken) {
+        // A block may have been freed just as the wait timed out.
+        taskENTER_CRITICAL();
+        block = pop();
+        taskEXIT_CRITICAL();
+        return block;
+      }
+    }
+  }
+
+  /**
+   * BlockPool.hpp
+   *
+   * @brief A version of allocate() that can be called from an interrupt
+   * service routine.  It does not block.
+   *
+   * @return void* The block, or NULL if the pool is exhausted.
+   */
+  void* allocateFromISR() {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    Block* block = pop();
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return block;
+  }
+
+  /**
+   * BlockPool.hpp
+   *
+   * @brief Function that returns a block to the pool from a task.
+   *
+   * @param block A block returned by allocate() or allocateFromISR().  NULL is
+   * ignored.
+   */
+  void free(void* block) {
+    if (block == NULL) {
+      return;
+    }
+    taskENTER_CRITICAL();
+    const bool wake = push(block);
+    taskEXIT_CRITICAL();
+    if (wake) {
+      blocksFreed.give();
+    }
+  }
+
+  /**
+   * BlockPool.hpp
+   *
+   * @brief A version of free() that can be called from an interrupt service
+   * routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * freeing the block unblocked a task with a priority higher than the
+   * currently running task.
+   * @param block A block returned by allocate() or allocateFromISR().  NULL is
+   * ignored.
+   */
+  void freeFromISR(bool& higherPriorityTaskWoken, void* block) {
+    if (block == NULL) {
+      return;
+    }
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool wake = push(block);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    if (wake) {
+      blocksFreed.giveFromISR(higherPriorityTaskWoken);
+    }
+  }
+
+  /**
+   * BlockPool.hpp
+   *
+   * @overload
+   */
+  void freeFromISR(void* block) {
+    bool higherPriorityTaskWoken = false;
+    freeFromISR(higherPriorityTaskWoken, block);
+  }
+
+  /**
+   * BlockPool.hpp
+   *
+   * @brief Function that checks if a pointer is one of the pool's blocks.
+   *
+   * @param block The pointer to check.
+   * @retval true block is the start of one of the pool's blocks.
+   * @retval false Otherwise.
+   */
+  bool contains(const void* block) const {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(block);
+    const uintptr_t first = reinterpret_cast<uintptr_t>(&blocks[0]);
+    return (address >= first) && (address < first + sizeof(blocks)) &&
+           ((address - first) % sizeof(Block) == 0);
+  }
+
+  /**
+   * BlockPool.hpp
+   *
+   * @brief Function that returns the number of free blocks.
+   *
+   * @return UBaseType_t The number of blocks that can be allocated.
+   */
+  UBaseType_t available() const {
+    return Count - inUse;
+  }
+
+  /**
+   * BlockPool.hpp
+   *
+   * @brief Function that returns the largest number of blocks that have been
+   * allocated at the same time.
+   *
+   * @return UBaseType_t The high water mark of allocated blocks.
+   */
+  UBaseType_t getHighWaterMark() const {
+    return maxInUse;
+  }
+
+ private:
+  union Block {
+    Block* next;
+    alignas(std::max_align_t) uint8_t data[BlockSize];
+  };
+
+  // Must be called inside a critical section.
+  inline Block* pop() {
+    Block* block = freeList;
+    if (block != NULL) {
+      freeList = block->next;
+      inUse++;
+      if (inUse > maxInUse) {
+        maxInUse = inUse;
+      }
+    }
+    return block;
+  }
+
+  // Must be called inside a critical section.  Returns true if a task is
+  // waiting for a block.
+  inline bool push(void* pointer) {
+    configASSERT(contains(pointer));
+    Block* block = static_cast<Block*>(pointer);
+    block->next = freeList;
+    freeList = block;
+    inUse--;
+    return (waiting != 0);
+  }
+
+  Block blocks[Count];
+  Block* freeList = &blocks[0];
+  UBaseType_t inUse = 0;
+  UBaseType_t maxInUse = 0;
+  UBaseType_t waiting = 0;
+
+  /**
+   * @brief Given once for each block freed while a task is waiting.  A waiter
+   * that finds the block already taken by someone else just waits again.
+   */
+  StaticCountingSemaphore blocksFreed;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_BLOCKPOOL_HPP
@@ -0,0 +1,230 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_CLOCK_HPP
+#define FREERTOS_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+namespace FreeRTOS {
+
+/**
+ * @class Clock Clock.hpp <FreeRTOS/Clock.hpp>
+ *
+ * @brief Class that provides a 64-bit monotonic tick count and a
+ * <tt>std::chrono</tt> clock based on it.
+ *
+ * The kernel tick count is only as wide as TickType_t, so it wraps after about
+ * 49 days with a 32-bit tick at 1 kHz, and after about a minute with a 16-bit
+ * tick.  Clock extends it to 64 bits by tracking the overflows of the kernel
+ * tick count.  An overflow is only seen if the tick count is read at least
+ * once per wrap period, so an application that may not call now() that often
+ * should call onTick() from <tt>vApplicationTickHook()</tt>.
+ *
+ * Clock meets the requirements of a steady clock, so the standard duration
+ * and time point arithmetic can be used with it.  Every blocking function of
+ * the library also accepts a <tt>std::chrono::duration</tt> as its timeout,
+ * which is converted to ticks by toTicks().
+ *
+ * <b>Example Usage</b>
+ * @include Clock/clock.cpp
+ */
+class Clock {
+ public:
+  using rep = int64_t;
+  using period = std::ratio<1, configTICK_RATE_HZ>;
+  using duration = std::chrono::duration<rep, period>;
+  using time_point = std::chrono::time_point<Clock>;
+  static constexpr bool is_steady = true;
+
+  Clock() = delete;
+
+  /**
+   * Clock.hpp
+   *
+   * @brief Function that calls <tt>TickType_t xTaskGetTickCount( void )</tt>
+   * and returns the current time.
+   *
+   * @see <https://www.freertos.org/a00021.html#xTaskGetTickCount>
+   *
+   * @return time_point The time since the scheduler was started.
+   *
+   * <b>Example Usage</b>
+   * @include Clock/clock.cpp
+   */
+  static time_point now() {
+    return time_point(duration(static_cast<rep>(getTickCount64())));
+  }
+
+  /**
+   * Clock.hpp
+   *
+   * @brief Function that calls <tt>TickType_t xTaskGetTickCountFromISR( void
+   * )</tt> and returns the current time.
+   *
+   * @see <https://www.freertos.org/a00021.html#xTaskGetTickCountFromISR>
+   *
+   * @return time_point The time since the scheduler was started.
+   */
+  static time_point nowFromISR() {
+    return time_point(duration(static_cast<rep>(getTickCount64FromISR())));
+  }
+
+  /**
+   * Clock.hpp
+   *
+   * @brief Function that calls <tt>TickType_t xTaskGetTickCount( void )</tt>
+   * and extends the result to 64 bits.
+   *
+   * @see <https://www.freertos.org/a00021.html#xTaskGetTickCount>
+   *
+   * @return uint64_t The number of ticks since the scheduler was started.
+   */
+  static uint64_t getTickCount64() {
+    if constexpr (sizeof(TickType_t) >= sizeof(uint64_t)) {
+      return xTaskGetTickCount();
+    } else {
+      taskENTER_CRITICAL();
+      const uint64_t ticks = extend(xTaskGetTickCount());
+      taskEXIT_CRITICAL();
+      return ticks;
+    }
+  }
+
+  /**
+   * Clock.hpp
+   *
+   * @brief Function that calls <tt>TickType_t xTaskGetTickCountFromISR( void
+   * )</tt> and extends the result to 64 bits.
+   *
+   * @see <https://www.freertos.org/a00021.html#xTaskGetTickCountFromISR>
+   *
+   * @return uint64_t The number of ticks since the scheduler was started.
+   */
+  static uint64_t getTickCount64FromISR() {
+    if constexpr (sizeof(TickType_t) >= sizeof(uint64_t)) {
+      return xTaskGetTickCountFromISR();
+    } else {
+      const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+      const uint64_t ticks = extend(xTaskGetTickCountFromISR());
+      taskEXIT_CRITICAL_FROM_ISR(status);
+      return ticks;
+    }
+  }
+
+  /**
+   * Clock.hpp
+   *
+   * @brief Function that may be called from <tt>vApplicationTickHook()</tt>
+   * so that no overflow of the kernel tick count is missed, however rarely the
+   * application reads the clock.
+   *
+   * configUSE_TICK_HOOK must be defined as 1 for the tick hook to be called.
+   */
+  static inline void onTick() {
+    getTickCount64FromISR();
+  }
+
+  /**
+   * Clock.hpp
+   *
+   * @brief Function that converts a duration to a number of ticks that can be
+   * passed to a blocking function.
+   *
+   * The duration is rounded up to the next tick, so the call never waits for
+   * less than the requested time, and saturates at portMAX_DELAY.  A duration
+   * of zero or less is converted to 0.  The conversion is done at compile time
+   * if the duration is a constant expression.
+   *
+   * @tparam Rep The arithmetic type of the duration.
+   * @tparam Period The tick period of the duration.
+   * @param timeout The duration to convert.
+   * @return TickType_t The number of ticks.
+   */
+  template <class Rep, class Period>
+  static constexpr TickType_t toTicks(
+      const std::chrono::duration<Rep, Period>& timeout) {
+    if (timeout <= timeout.zero()) {
+      return 0;
+    }
+    if constexpr (std::ratio_greater<Period, period>::value) {
+      // A coarser unit is scaled up to ticks, so compare before converting to
+      // avoid an overflow.
+      constexpr auto limit =
+          std::chrono::floor<std::chrono::duration<Rep, Period>>(maxTimeout);
+      if (timeout > limit) {
+        return portMAX_DELAY;
+      }
+    }
+    const rep ticks = std::chrono::ceil<duration>(timeout).count();
+    return (static_cast<uint64_t>(ticks) >= maxTicks)
+               ? portMAX_DELAY
+               : static_cast<TickType_t>(ticks);
+  }
+
+  /**
+   * Clock.hpp
+   *
+   * @brief Function that converts a number of ticks to a duration.
+   *
+   * @param ticks The number of ticks.
+   * @return duration The duration of the ticks.
+   */
+  static constexpr duration fromTicks(const TickType_t ticks) {
+    return duration(static_cast<rep>(ticks));
+  }
+
+ private:
+  // The largest timeout, limited to what rep can hold if TickType_t is 64 bits.
+  static constexpr uint64_t maxTicks =
+      (static_cast<uint64_t>(portMAX_DELAY) >
+       static_cast<uint64_t>(std::numeric_limits<rep>::max()))
+          ? static_cast<uint64_t>(std::numeric_limits<rep>::max())
+          : static_cast<uint64_t>(portMAX_DELAY);
+  static constexpr duration maxTimeout = duration(static_cast<rep>(maxTicks));
+
+  // Adds the ticks since the last call, which is correct as long as the
+  // kernel tick count has wrapped at most once in between.  Must be called
+  // from a critical section.
+  static uint64_t extend(const TickType_t ticks) {
+    const TickType_t last = static_cast<TickType_t>(ticks64);
+    ticks64 += static_cast<TickType_t>(ticks - last);
+    return ticks64;
+  }
+
+  static inline uint64_t ticks64 = 0;
+};
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_CLOCK_HPP
@@ -0,0 +1,229 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_CONDITIONVARIABLE_HPP
+#define FREERTOS_CONDITIONVARIABLE_HPP
+
+#include <FreeRTOS/Deadline.hpp>
+#include <FreeRTOS/Mutex.hpp>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TASK_NOTIFICATIONS == 1) && (configUSE_MUTEXES == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class ConditionVariable ConditionVariable.hpp
+ * <FreeRTOS/ConditionVariable.hpp>
+ *
+ * @brief Class that lets tasks block until another task changes some state
+ * that is protected by a FreeRTOS::MutexBase.
+ *
+ * A waiting task releases the mutex and blocks on its own task notification at
+ * index Index until notify_one() or notify_all() is called, then takes the
+ * mutex again before returning.  Each waiter is a node on the stack of the
+ * waiting task that is linked into a list held by the condition variable, so
+ * no memory is allocated and no kernel object is created.  Waiters are woken
+ * in the order in which they started waiting.
+ *
+ * As with std::condition_variable the state should be checked in a loop, or
+ * with wait_until(), because it may have changed again by the time the woken
+ * task takes the mutex.
+ *
+ * @warning The mutex must be held by the calling task when wait() or
+ * wait_until() is called.  The notification at index Index of a waiting task
+ * must not be used for any other purpose while it waits.
+ *
+ * @tparam Index The index within each waiting task's array of notification
+ * values that is used to wake it.
+ *
+ * <b>Example Usage</b>
+ * @include ConditionVariable/conditionVariable.cpp
+ */
+template <UBaseType_t Index = 0>
+class ConditionVariable {
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+
+ public:
+  ConditionVariable() = default;
+  ~ConditionVariable() = default;
+
+  ConditionVariable(const ConditionVariable&) = delete;
+  ConditionVariable& operator=(const ConditionVariable&) = delete;
+
+  /**
+   * ConditionVariable.hpp
+   *
+   * @brief Function that releases mutex, blocks until the condition variable
+   * is notified, and then takes mutex again.
+   *
+   * @param mutex The mutex that protects the state being waited for.  It must
+   * be held by the calling task.
+   * @param ticksToWait The maximum time to wait for a notification.
+   * @retval true The condition variable was notified.
+   * @retval false ticksToWait expired first.  mutex is held again in either
+   * case.
+   */
+  bool wait(const MutexBase& mutex,
+            const TickType_t ticksToWait = portMAX_DELAY) {
+    Waiter waiter;
+    waiter.task = xTaskGetCurrentTaskHandle();
+    xTaskNotifyStateClearIndexed(NULL, Index);
+
+    vTaskSuspendAll();
+    if (tail == NULL) {
+      head = &waiter;
+    } else {
+      tail->next = &waiter;
+    }
+    tail = &waiter;
+    xTaskResumeAll();
+
+    mutex.unlock();
+
+    const Deadline deadline(ticksToWait);
+    bool signalled = false;
+    for (;;) {
+      const bool notified =
+          (ulTaskNotifyTakeIndexed(Index, pdTRUE, deadline) != 0);
+      vTaskSuspendAll();
+      signalled = waiter.signalled;
+      if (!signalled && !notified) {
+        remove(waiter);
+      }
+      xTaskResumeAll();
+      // A notification without the signalled flag is left over from an
+      // earlier wait, so keep waiting.
+      if (signalled || !notified) {
+        break;
+      }
+    }
+
+    mutex.lock(portMAX_DELAY);
+    return signalled;
+  }
+
+  /**
+   * ConditionVariable.hpp
+   *
+   * @brief Function that waits until predicate returns true, calling wait() as
+   * many times as needed within a single time budget.
+   *
+   * @param mutex The mutex that protects the state being waited for.  It must
+   * be held by the calling task.
+   * @param predicate Callable that returns true once the state is the one
+   * being waited for.  It is called with mutex held.
+   * @param ticksToWait The maximum time to wait in total.
+   * @return bool The final result of predicate.  false means ticksToWait
+   * expired first.  mutex is held again in either case.
+   */
+  template <class Predicate>
+  bool wait_until(const MutexBase& mutex, Predicate predicate,  // NOLINT
+                  const TickType_t ticksToWait = portMAX_DELAY) {
+    const Deadline deadline(ticksToWait);
+    while (!predicate()) {
+      if (!wait(mutex, deadline)) {
+        return predicate();
+      }
+    }
+    return true;
+  }
+
+  /**
+   * ConditionVariable.hpp
+   *
+   * @brief Function that wakes the task that has been waiting the longest, if
+   * any task is waiting.
+   */
+  void notify_one() {  // NOLINT
+    vTaskSuspendAll();
+    if (head != NULL) {
+      signal(*head);
+    }
+    xTaskResumeAll();
+  }
+
+  /**
+   * ConditionVariable.hpp
+   *
+   * @brief Function that wakes every waiting task.
+   */
+  void notify_all() {  // NOLINT
+    vTaskSuspendAll();
+    while (head != NULL) {
+      signal(*head);
+    }
+    xTaskResumeAll();
+  }
+
+ private:
+  struct Waiter {
+    TaskHandle_t task = NULL;
+    Waiter* next = NULL;
+    bool signalled = false;
+  };
+
+  // Must be called with the scheduler suspended.
+  inline void signal(Waiter& waiter) {
+    remove(waiter);
+    waiter.signalled = true;
+    xTaskNotifyGiveIndexed(waiter.task, Index);
+  }
+
+  // Must be called with the scheduler suspended.
+  inline void remove(Waiter& waiter) {
+    Waiter* previous = NULL;
+    for (Waiter* node = head; node != NULL; node = node->next) {
+      if (node == &waiter) {
+        if (previous == NULL) {
+          head = node->next;
+        } else {
+          previous->next = node->next;
+        }
+        if (tail == node) {
+          tail = previous;
+        }
+        break;
+      }
+      previous = node;
+    }
+  }
+
+  Waiter* head = NULL;
+  Waiter* tail = NULL;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* (configUSE_TASK_NOTIFICATIONS == 1) && (configUSE_MUTEXES == 1) */
+
+#endif  // FREERTOS_CONDITIONVARIABLE_HPP
@@ -0,0 +1,786 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_COROUTINE_HPP
+#define FREERTOS_COROUTINE_HPP
+
+#include <FreeRTOS/EventGroups.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Semaphore.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if defined(__cpp_impl_coroutine) && (__cpp_impl_coroutine >= 201902L) && \
+    (configSUPPORT_STATIC_ALLOCATION == 1) &&                                \
+    (configUSE_TASK_NOTIFICATIONS == 1)
+
+#include <coroutine>
+
+/**
+ * @brief Expression that allocates size bytes for a coroutine frame, or
+ * returns NULL.  Defaults to <tt>pvPortMalloc()</tt>, which can be backed by a
+ * FreeRTOS::StaticArena in a build without a heap.
+ */
+#ifndef FREERTOS_CPP_COROUTINE_ALLOCATE
+#define FREERTOS_CPP_COROUTINE_ALLOCATE(size) pvPortMalloc(size)
+#endif
+
+/**
+ * @brief Statement that frees a coroutine frame allocated with
+ * FREERTOS_CPP_COROUTINE_ALLOCATE().  Defaults to <tt>vPortFree()</tt>.
+ */
+#ifndef FREERTOS_CPP_COROUTINE_FREE
+#define FREERTOS_CPP_COROUTINE_FREE(pointer) vPortFree(pointer)
+#endif
+
+namespace FreeRTOS {
+
+class CoroutineExecutorBase;
+
+/**
+ * @class Coroutine Coroutine.hpp <FreeRTOS/Coroutine.hpp>
+ *
+ * @brief Class that is the return type of a C++20 coroutine run by a
+ * FreeRTOS::CoroutineExecutor.
+ *
+ * A function returning Coroutine that uses <tt>co_await</tt> on the
+ * awaitables in FreeRTOS::Await is a stackless coroutine.  Calling it only
+ * allocates its frame, and the returned object is passed to
+ * CoroutineExecutor::spawn(), which runs it on the executor's task.  The frame
+ * is freed when the coroutine returns.
+ *
+ * Frames are allocated with FREERTOS_CPP_COROUTINE_ALLOCATE().  If that fails
+ * the returned object is not valid and spawn() returns false.
+ *
+ * This class is only available when the compiler supports C++20 coroutines,
+ * and configSUPPORT_STATIC_ALLOCATION and configUSE_TASK_NOTIFICATIONS are
+ * both 1.
+ *
+ * <b>Example Usage</b>
+ * @include Coroutine/coroutine.cpp
+ */
+class Coroutine {
+ public:
+  /**
+   * @brief Function that checks whether an awaited condition has been met,
+   * used by the executor to decide when to resume a suspended coroutine.
+   */
+  using Poll = bool (*)(void* awaiter);
+
+  /**
+   * @brief The promise type required by the compiler.  The fields are used by
+   * the executor and the awaitables in FreeRTOS::Await, and should not be used
+   * directly.
+   */
+  struct promise_type {
+    Coroutine get_return_object() noexcept {
+      return Coroutine(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    static Coroutine get_return_object_on_allocation_failure() noexcept {
+      return Coroutine();
+    }
+    std::suspend_always initial_suspend() noexcept {
+      return {};
+    }
+    std::suspend_always final_suspend() noexcept {
+      return {};
+    }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept {
+      configASSERT(false);
+    }
+
+    static void* operator new(const size_t size) noexcept {
+      return FREERTOS_CPP_COROUTINE_ALLOCATE(size);
+    }
+    static void operator delete(void* pointer) noexcept {
+      FREERTOS_CPP_COROUTINE_FREE(pointer);
+    }
+
+    // Suspends the coroutine until poll returns true or, unless timeout is
+    // portMAX_DELAY, until timeout ticks have passed.  A condition that is not
+    // periodic is only checked when the executor is woken.
+    void waitFor(const Poll condition, void* context, const TickType_t timeout,
+                 const bool isPeriodic = true) {
+      poll = condition;
+      awaiter = context;
+      periodic = isPeriodic;
+      timedOut = false;
+      hasWakeTime = (timeout != portMAX_DELAY);
+      wakeTime = xTaskGetTickCount() + timeout;
+    }
+
+    CoroutineExecutorBase* executor = nullptr;
+    promise_type* next = nullptr;
+    Poll poll = nullptr;
+    void* awaiter = nullptr;
+    TickType_t wakeTime = 0;
+    bool hasWakeTime = false;
+    bool periodic = false;
+    bool timedOut = false;
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  Coroutine() = default;
+  ~Coroutine() {
+    if (handle) {
+      handle.destroy();
+    }
+  }
+
+  Coroutine(const Coroutine&) = delete;
+  Coroutine& operator=(const Coroutine&) = delete;
+
+  Coroutine(Coroutine&& other) noexcept : handle(other.handle) {
+    other.handle = nullptr;
+  }
+  Coroutine& operator=(Coroutine&& other) noexcept {
+    if (this != &other) {
+      if (handle) {
+        handle.destroy();
+      }
+      handle = other.handle;
+      other.handle = nullptr;
+    }
+    return *this;
+  }
+
+  /**
+   * Coroutine.hpp
+   *
+   * @brief Function that checks whether the coroutine frame was allocated.
+   *
+   * @retval true If the coroutine can be spawned.
+   * @retval false If the frame could not be allocated.
+   */
+  inline bool isValid() const {
+    return static_cast<bool>(handle);
+  }
+
+ private:
+  explicit Coroutine(const Handle handle) : handle(handle) {}
+
+  // Gives up ownership of the frame to the executor.
+  inline Handle release() {
+    const Handle released = handle;
+    handle = nullptr;
+    return released;
+  }
+
+  Handle handle = nullptr;
+
+  friend class CoroutineExecutorBase;
+};
+
+/**
+ * @class CoroutineExecutorBase Coroutine.hpp <FreeRTOS/Coroutine.hpp>
+ *
+ * @brief Base class of FreeRTOS::CoroutineExecutor that holds the coroutines
+ * and resumes them.  This class is not intended to be instantiated by the
+ * user.
+ */
+class CoroutineExecutorBase {
+ public:
+  CoroutineExecutorBase(const CoroutineExecutorBase&) = delete;
+  CoroutineExecutorBase& operator=(const CoroutineExecutorBase&) = delete;
+
+  /**
+   * Coroutine.hpp
+   *
+   * @brief Function that hands a coroutine to the executor, which starts it
+   * the next time its task runs.  It can be called from any task, including
+   * from a coroutine running on the executor.
+   *
+   * @param coroutine The coroutine to run.
+   * @retval true If the coroutine was spawned.
+   * @retval false If the coroutine frame could not be allocated.
+   */
+  bool spawn(Coroutine&& coroutine) {
+    if (!coroutine.isValid()) {
+      return false;
+    }
+    Coroutine::promise_type& promise = coroutine.release().promise();
+    promise.executor = this;
+    promise.poll = ready;
+
+    taskENTER_CRITICAL();
+    promise.next = spawned;
+    spawned = &promise;
+    taskEXIT_CRITICAL();
+
+    wake();
+    return true;
+  }
+
+  /**
+   * Coroutine.hpp
+   *
+   * @brief Function that makes the executor check its waiting coroutines now
+   * instead of at the end of the poll period.  Call it after giving a
+   * semaphore or sending to a queue that a coroutine may be waiting on.
+   */
+  inline void wake() const {
+    if (taskHandle != NULL) {
+      xTaskNotifyGiveIndexed(taskHandle, 0);
+    }
+  }
+
+  /**
+   * Coroutine.hpp
+   *
+   * @brief Version of wake() that can be called from an interrupt service
+   * routine.
+   *
+   * @param higherPriorityTaskWoken Set to true if the executor task has a
+   * higher priority than the interrupted task.
+   */
+  inline void wakeFromISR(bool& higherPriorityTaskWoken) const {
+    if (taskHandle != NULL) {
+      BaseType_t taskWoken = pdFALSE;
+      vTaskNotifyGiveIndexedFromISR(taskHandle, 0, &taskWoken);
+      if (taskWoken == pdTRUE) {
+        higherPriorityTaskWoken = true;
+      }
+    }
+  }
+
+  /**
+   * Coroutine.hpp
+   *
+   * @brief Function that returns the number of coroutines that have been
+   * started and have not returned.
+   *
+   * @return size_t The number of running coroutines.
+   */
+  inline size_t getCount() const {
+    return count;
+  }
+
+ protected:
+  explicit CoroutineExecutorBase(const TickType_t pollPeriod)
+      : pollPeriod(pollPeriod) {}
+  ~CoroutineExecutorBase() = default;
+
+  // Resumes every coroutine whose condition is met, then returns the number of
+  // ticks the task may block before it has to check again.
+  TickType_t runOnce() {
+    taskENTER_CRITICAL();
+    Coroutine::promise_type* added = spawned;
+    spawned = nullptr;
+    taskEXIT_CRITICAL();
+
+    while (added != nullptr) {
+      Coroutine::promise_type* const promise = added;
+      added = added->next;
+      promise->next = running;
+      running = promise;
+      count++;
+    }
+
+    TickType_t sleep = portMAX_DELAY;
+    Coroutine::promise_type** link = &running;
+    while (*link != nullptr) {
+      Coroutine::promise_type& promise = **link;
+      const TickType_t now = xTaskGetTickCount();
+
+      bool resume = false;
+      if ((promise.poll != nullptr) && promise.poll(promise.awaiter)) {
+        resume = true;
+      } else if (promise.hasWakeTime && expired(promise.wakeTime, now)) {
+        promise.timedOut = true;
+        resume = true;
+      }
+
+      if (resume) {
+        promise.poll = nullptr;
+        promise.hasWakeTime = false;
+        const Coroutine::Handle handle =
+            Coroutine::Handle::from_promise(promise);
+        handle.resume();
+        if (handle.done()) {
+          *link = promise.next;
+          count--;
+          handle.destroy();
+          continue;
+        }
+      }
+
+      if ((promise.poll != nullptr) && promise.periodic) {
+        sleep = (sleep < pollPeriod) ? sleep : pollPeriod;
+      }
+      if (promise.hasWakeTime) {
+        const TickType_t left = remaining(promise.wakeTime);
+        sleep = (sleep < left) ? sleep : left;
+      }
+      link = &promise.next;
+    }
+    return sleep;
+  }
+
+  TaskHandle_t taskHandle = NULL;
+
+ private:
+  static bool ready(void*) {
+    return true;
+  }
+
+  inline static bool expired(const TickType_t time, const TickType_t now) {
+    return (static_cast<TickType_t>(now - time) <
+            (static_cast<TickType_t>(portMAX_DELAY / 2) + 1));
+  }
+
+  inline static TickType_t remaining(const TickType_t time) {
+    const TickType_t now = xTaskGetTickCount();
+    return expired(time, now) ? 0 : static_cast<TickType_t>(time - now);
+  }
+
+  const TickType_t pollPeriod;
+  Coroutine::promise_type* spawned = nullptr;
+  Coroutine::promise_type* running = nullptr;
+  size_t count = 0;
+};
+
+/**
+ * @class CoroutineExecutor Coroutine.hpp <FreeRTOS/Coroutine.hpp>
+ *
+ * @brief Class that runs many FreeRTOS::Coroutine objects on a single static
+ * task.
+ *
+ * Each coroutine costs a frame holding only the variables that live across a
+ * <tt>co_await</tt>, instead of a task control block and a stack, so hundreds
+ * of protocol state machines can share one task.  The coroutines are resumed
+ * one at a time by the executor task, so they never run concurrently with each
+ * other, but they must never call a blocking kernel function directly, as that
+ * would block every coroutine.  They wait with the awaitables in
+ * FreeRTOS::Await instead.
+ *
+ * The kernel has no way of telling the executor that a queue, semaphore or
+ * event group it waits on has changed, so waiting coroutines are checked every
+ * pollPeriod ticks.  Code that gives a semaphore or sends to a queue can call
+ * wake() to have them checked at once.  Delays and FreeRTOS::
+ * CoroutineNotification wake the executor exactly when they are due, without
+ * polling.
+ *
+ * Coroutines share the executor task, so a mutex locked in one coroutine is
+ * also held by all the others.  Do not use mutexes across a
+ * <tt>co_await</tt>.
+ *
+ * @tparam N The stack depth of the executor task.  It must hold the deepest
+ * call chain of any coroutine between two suspension points.
+ *
+ * <b>Example Usage</b>
+ * @include Coroutine/coroutine.cpp
+ */
+template <UBaseType_t N = configMINIMAL_STACK_SIZE * 2>
+class CoroutineExecutor : public CoroutineExecutorBase, public StaticTask<N> {
+ public:
+  /**
+   * Coroutine.hpp
+   *
+   * @brief Construct a new CoroutineExecutor object and its task.
+   *
+   * @param priority The priority of the executor task.
+   * @param name The name of the executor task.
+   * @param pollPeriod The number of ticks between checks of coroutines that
+   * wait on a queue, semaphore or event group.
+   */
+  explicit CoroutineExecutor(const UBaseType_t priority = tskIDLE_PRIORITY + 1,
+                             const char* name = "Coroutines",
+                             const TickType_t pollPeriod = 1)
+      : CoroutineExecutorBase(pollPeriod), StaticTask<N>(priority, name) {}
+  ~CoroutineExecutor() = default;
+
+ protected:
+  void taskFunction() final {
+    taskHandle = xTaskGetCurrentTaskHandle();
+    for (;;) {
+      const TickType_t sleep = runOnce();
+      TaskBase::notifyTake(sleep);
+    }
+  }
+};
+
+/**
+ * @class CoroutineNotification Coroutine.hpp <FreeRTOS/Coroutine.hpp>
+ *
+ * @brief Class that lets a task or an interrupt signal a coroutine, like a
+ * task notification does for a task.
+ *
+ * notify() sets bits in the notification value and wakes the executor of the
+ * coroutine waiting with FreeRTOS::Await::notification(), which receives and
+ * clears the bits.
+ *
+ * <b>Example Usage</b>
+ * @include Coroutine/coroutine.cpp
+ */
+class CoroutineNotification {
+ public:
+  CoroutineNotification() = default;
+  ~CoroutineNotification() = default;
+
+  CoroutineNotification(const CoroutineNotification&) = delete;
+  CoroutineNotification& operator=(const CoroutineNotification&) = delete;
+
+  /**
+   * Coroutine.hpp
+   *
+   * @brief Function that sets bits in the notification value and wakes the
+   * waiting coroutine.
+   *
+   * @param bits The bits to set.
+   */
+  void notify(const uint32_t bits = 1) {
+    taskENTER_CRITICAL();
+    value |= bits;
+    const CoroutineExecutorBase* const waiter = executor;
+    taskEXIT_CRITICAL();
+    if (waiter != nullptr) {
+      waiter->wake();
+    }
+  }
+
+  /**
+   * Coroutine.hpp
+   *
+   * @brief Version of notify() that can be called from an interrupt service
+   * routine.
+   *
+   * @param higherPriorityTaskWoken Set to true if the executor task has a
+   * higher priority than the interrupted task.
+   * @param bits The bits to set.
+   */
+  void notifyFromISR(bool& higherPriorityTaskWoken, const uint32_t bits = 1) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    value |= bits;
+    const CoroutineExecutorBase* const waiter = executor;
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    if (waiter != nullptr) {
+      waiter->wakeFromISR(higherPriorityTaskWoken);
+    }
+  }
+
+ private:
+  // Returns and clears the notification value.
+  uint32_t take() {
+    taskENTER_CRITICAL();
+    const uint32_t bits = value;
+    value = 0;
+    taskEXIT_CRITICAL();
+    return bits;
+  }
+
+  uint32_t value = 0;
+  CoroutineExecutorBase* executor = nullptr;
+
+  friend class NotificationAwaiter;
+};
+
+/**
+ * @brief Awaiter that polls a condition until it is met or the timeout
+ * passes.  Derived classes implement <tt>bool poll()</tt>.
+ */
+template <class Derived>
+class PollingAwaiter {
+ public:
+  inline bool await_ready() {
+    return static_cast<Derived*>(this)->poll();
+  }
+
+  inline void await_suspend(const Coroutine::Handle handle) {
+    handle.promise().waitFor(pollThunk, this, timeout);
+  }
+
+ protected:
+  explicit PollingAwaiter(const TickType_t timeout) : timeout(timeout) {}
+
+  static bool pollThunk(void* awaiter) {
+    return static_cast<Derived*>(static_cast<PollingAwaiter*>(awaiter))
+        ->poll();
+  }
+
+  const TickType_t timeout;
+};
+
+/**
+ * @brief Awaiter returned by FreeRTOS::Await::receive().
+ */
+template <class T>
+class ReceiveAwaiter : public PollingAwaiter<ReceiveAwaiter<T>> {
+ public:
+  ReceiveAwaiter(const QueueBase<T>& queue, const TickType_t timeout)
+      : PollingAwaiter<ReceiveAwaiter<T>>(timeout), queue(queue) {}
+
+  inline bool poll() {
+    item = queue.receive(static_cast<TickType_t>(0));
+    return item.has_value();
+  }
+
+  inline std::optional<T> await_resume() {
+    return std::move(item);
+  }
+
+ private:
+  const QueueBase<T>& queue;
+  std::optional<T> item;
+};
+
+/**
+ * @brief Awaiter returned by FreeRTOS::Await::take().
+ */
+class TakeAwaiter : public PollingAwaiter<TakeAwaiter> {
+ public:
+  TakeAwaiter(const SemaphoreBase& semaphore, const TickType_t timeout)
+      : PollingAwaiter<TakeAwaiter>(timeout), semaphore(semaphore) {}
+
+  inline bool poll() {
+    taken = semaphore.take(0);
+    return taken;
+  }
+
+  inline bool await_resume() const {
+    return taken;
+  }
+
+ private:
+  const SemaphoreBase& semaphore;
+  bool taken = false;
+};
+
+#if (configUSE_EVENT_GROUPS == 1)
+/**
+ * @brief Awaiter returned by FreeRTOS::Await::wait().
+ */
+class WaitAwaiter : public PollingAwaiter<WaitAwaiter> {
+ public:
+  WaitAwaiter(const EventGroupBase& eventGroup, const EventBits_t bitsToWaitFor,
+              const bool clearOnExit, const bool waitForAllBits,
+              const TickType_t timeout)
+      : PollingAwaiter<WaitAwaiter>(timeout),
+        eventGroup(eventGroup),
+        bitsToWaitFor(bitsToWaitFor),
+        clearOnExit(clearOnExit),
+        waitForAllBits(waitForAllBits) {}
+
+  inline bool poll() {
+    bits = eventGroup.wait(bitsToWaitFor, clearOnExit, waitForAllBits, 0);
+    const EventBits_t set = bits & bitsToWaitFor;
+    return waitForAllBits ? (set == bitsToWaitFor) : (set != 0);
+  }
+
+  inline EventBits_t await_resume() const {
+    return bits;
+  }
+
+ private:
+  const EventGroupBase& eventGroup;
+  const EventBits_t bitsToWaitFor;
+  const bool clearOnExit;
+  const bool waitForAllBits;
+  EventBits_t bits = 0;
+};
+#endif /* configUSE_EVENT_GROUPS */
+
+/**
+ * @brief Awaiter returned by FreeRTOS::Await::notification().
+ */
+class NotificationAwaiter : public PollingAwaiter<NotificationAwaiter> {
+ public:
+  NotificationAwaiter(CoroutineNotification& notification,
+                      const TickType_t timeout)
+      : PollingAwaiter<NotificationAwaiter>(timeout),
+        notification(notification) {}
+
+  inline bool poll() {
+    bits = notification.take();
+    return (bits != 0);
+  }
+
+  inline void await_suspend(const Coroutine::Handle handle) {
+    CoroutineExecutorBase* const executor = handle.promise().executor;
+    handle.promise().waitFor(pollThunk, this, timeout, false);
+
+    taskENTER_CRITICAL();
+    notification.executor = executor;
+    const bool pending = (notification.value != 0);
+    taskEXIT_CRITICAL();
+
+    // A notification that arrived before the executor was known did not wake
+    // it, so make sure it is seen on the next pass.
+    if (pending) {
+      executor->wake();
+    }
+  }
+
+  inline uint32_t await_resume() const {
+    return bits;
+  }
+
+ private:
+  CoroutineNotification& notification;
+  uint32_t bits = 0;
+};
+
+/**
+ * @brief Awaiter returned by FreeRTOS::Await::delay() and
+ * FreeRTOS::Await::yield().
+ */
+class DelayAwaiter {
+ public:
+  explicit DelayAwaiter(const TickType_t ticks) : ticks(ticks) {}
+
+  inline bool await_ready() const {
+    return false;
+  }
+
+  inline void await_suspend(const Coroutine::Handle handle) const {
+    handle.promise().waitFor(nullptr, nullptr, ticks);
+  }
+
+  inline void await_resume() const {}
+
+ private:
+  const TickType_t ticks;
+};
+
+/**
+ * @brief Awaitables for the coroutines run by a FreeRTOS::CoroutineExecutor.
+ *
+ * Each function returns an object to <tt>co_await</tt>.  The operation is
+ * first tried without blocking, so a coroutine only suspends if it has to
+ * wait.  A timeout of portMAX_DELAY waits forever.
+ */
+namespace Await {
+
+/**
+ * Coroutine.hpp
+ *
+ * @brief Function that waits for an item from a queue.
+ *
+ * @tparam T The type of the items in the queue.
+ * @param queue The queue to receive from.
+ * @param timeout The maximum number of ticks to wait.
+ * @return std::optional<T> The item, or no value if the timeout passed.
+ */
+template <class T>
+inline ReceiveAwaiter<T> receive(const QueueBase<T>& queue,
+                                 const TickType_t timeout = portMAX_DELAY) {
+  return ReceiveAwaiter<T>(queue, timeout);
+}
+
+/**
+ * Coroutine.hpp
+ *
+ * @brief Function that waits to take a semaphore.
+ *
+ * @param semaphore The semaphore to take.
+ * @param timeout The maximum number of ticks to wait.
+ * @retval true If the semaphore was taken.
+ * @retval false If the timeout passed.
+ */
+inline TakeAwaiter take(const SemaphoreBase& semaphore,
+                        const TickType_t timeout = portMAX_DELAY) {
+  return TakeAwaiter(semaphore, timeout);
+}
+
+#if (configUSE_EVENT_GROUPS == 1)
+/**
+ * Coroutine.hpp
+ *
+ * @brief Function that waits for bits in an event group, with the same
+ * arguments as FreeRTOS::EventGroupBase::wait().
+ *
+ * @param eventGroup The event group to wait on.
+ * @param bitsToWaitFor The bits to wait for.
+ * @param clearOnExit Whether the bits waited for are cleared when the wait is
+ * satisfied.
+ * @param waitForAllBits Whether all bits must be set, rather than any of them.
+ * @param timeout The maximum number of ticks to wait.
+ * @return EventBits_t The value of the event group when the wait ended.
+ */
+inline WaitAwaiter wait(const EventGroupBase& eventGroup,
+                        const EventBits_t bitsToWaitFor,
+                        const bool clearOnExit = false,
+                        const bool waitForAllBits = false,
+                        const TickType_t timeout = portMAX_DELAY) {
+  return WaitAwaiter(eventGroup, bitsToWaitFor, clearOnExit, waitForAllBits,
+                     timeout);
+}
+#endif /* configUSE_EVENT_GROUPS */
+
+/**
+ * Coroutine.hpp
+ *
+ * @brief Function that waits for a FreeRTOS::CoroutineNotification.
+ *
+ * @param notification The notification to wait for.  Only one coroutine may
+ * wait for a notification at a time.
+ * @param timeout The maximum number of ticks to wait.
+ * @return uint32_t The bits that were set, which are cleared, or 0 if the
+ * timeout passed.
+ */
+inline NotificationAwaiter notification(
+    CoroutineNotification& notification,
+    const TickType_t timeout = portMAX_DELAY) {
+  return NotificationAwaiter(notification, timeout);
+}
+
+/**
+ * Coroutine.hpp
+ *
+ * @brief Function that suspends the coroutine for a number of ticks.
+ *
+ * @param ticks The number of ticks to wait.
+ */
+inline DelayAwaiter delay(const TickType_t ticks) {
+  return DelayAwaiter(ticks);
+}
+
+/**
+ * Coroutine.hpp
+ *
+ * @brief Function that lets the other coroutines of the executor run before
+ * this one continues.
+ */
+inline DelayAwaiter yield() {
+  return DelayAwaiter(0);
+}
+
+}  // namespace Await
+
+}  // namespace FreeRTOS
+
+#endif /* __cpp_impl_coroutine && configSUPPORT_STATIC_ALLOCATION && \
+          configUSE_TASK_NOTIFICATIONS */
+
+#endif  // FREERTOS_COROUTINE_HPP
@@ -0,0 +1,275 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_CPULOADMONITOR_HPP
+#define FREERTOS_CPULOADMONITOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configGENERATE_RUN_TIME_STATS == 1) && \
+    (INCLUDE_xTaskGetIdleTaskHandle == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class CpuLoadMonitor CpuLoadMonitor.hpp <FreeRTOS/CpuLoadMonitor.hpp>
+ *
+ * @brief Class that measures the CPU load by comparing the run time of the
+ * idle task with the total run time.
+ *
+ * sample() reads <tt>ulTaskGetIdleRunTimeCounter()</tt> and the run time
+ * counter, and should be called at a fixed interval, for example from the
+ * callback of a FreeRTOS::Timer.  Each window covers a number of these
+ * samples, so with a sampling interval of 100 ms windows of 1, 10 and 100
+ * samples measure the load over 100 ms, 1 s and 10 s.  When a window is
+ * complete its load becomes the current load of the window, its peak is
+ * updated, and the threshold callback is called if the load is at or above
+ * the threshold.
+ *
+ * Loads are given in parts per thousand, so 1000 means that the idle task did
+ * not run at all.  A sample only costs two counter reads and a few additions
+ * per window, so the monitor can be left running in production.
+ *
+ * On SMP ports the idle run time of every core is summed, so the load is the
+ * average over all cores.
+ *
+ * configGENERATE_RUN_TIME_STATS and INCLUDE_xTaskGetIdleTaskHandle must both
+ * be defined as 1 for this class to be available.
+ *
+ * @tparam Windows The number of windows.
+ *
+ * <b>Example Usage</b>
+ * @include CpuLoadMonitor/cpuLoadMonitor.cpp
+ */
+template <size_t Windows = 3>
+class CpuLoadMonitor {
+  static_assert(Windows > 0, "A CpuLoadMonitor needs at least one window.");
+
+ public:
+  /**
+   * @brief Function called when a window completes with a load at or above the
+   * threshold.  It is called from the context that called sample().
+   */
+  using Callback = void (*)(size_t window, uint32_t load);
+
+  /**
+   * CpuLoadMonitor.hpp
+   *
+   * @brief Construct a new CpuLoadMonitor object.
+   *
+   * @param samplesPerWindow The length of each window as a number of calls to
+   * sample().  Every length must be at least 1.
+   * @param threshold The load, in parts per thousand, at or above which the
+   * callback is called.
+   * @param callback Function called when a window completes with a load at or
+   * above the threshold, or nullptr.
+   */
+  explicit CpuLoadMonitor(const uint32_t (&samplesPerWindow)[Windows],
+                          const uint32_t threshold = 1000,
+                          const Callback callback = nullptr)
+      : threshold(threshold), callback(callback) {
+    for (size_t i = 0; i < Windows; i++) {
+      configASSERT(samplesPerWindow[i] > 0);
+      windows[i].length = samplesPerWindow[i];
+    }
+  }
+  ~CpuLoadMonitor() = default;
+
+  CpuLoadMonitor(const CpuLoadMonitor&) = delete;
+  CpuLoadMonitor& operator=(const CpuLoadMonitor&) = delete;
+
+  /**
+   * CpuLoadMonitor.hpp
+   *
+   * @brief Function that calls <tt>configRUN_TIME_COUNTER_TYPE
+   * ulTaskGetIdleRunTimeCounter( void )</tt> and adds the run time since the
+   * previous call to every window.
+   *
+   * @see <https://www.freertos.org/a00021.html#ulTaskGetIdleRunTimeCounter>
+   *
+   * The first call only records the starting point.  This function must not
+   * be called from more than one task at the same time.
+   */
+  void sample() {
+    const configRUN_TIME_COUNTER_TYPE idle = ulTaskGetIdleRunTimeCounter();
+    const configRUN_TIME_COUNTER_TYPE now = getRunTimeCounter();
+
+    if (!started) {
+      started = true;
+      lastIdle = idle;
+      lastTotal = now;
+      return;
+    }
+
+    const uint32_t idleDelta = static_cast<uint32_t>(idle - lastIdle);
+    const uint32_t totalDelta =
+        static_cast<uint32_t>(now - lastTotal) * configNUMBER_OF_CORES;
+    lastIdle = idle;
+    lastTotal = now;
+
+    // The totals are 64 bits wide, so keep getAverageLoad() from seeing half
+    // of an update.
+    taskENTER_CRITICAL();
+    idleTime += idleDelta;
+    totalTime += totalDelta;
+    taskEXIT_CRITICAL();
+
+    for (size_t i = 0; i < Windows; i++) {
+      Window& window = windows[i];
+      window.idle += idleDelta;
+      window.total += totalDelta;
+      if (++window.count < window.length) {
+        continue;
+      }
+
+      const uint32_t load = toLoad(window.idle, window.total);
+      window.load = load;
+      if (load > window.peak) {
+        window.peak = load;
+      }
+      window.idle = 0;
+      window.total = 0;
+      window.count = 0;
+
+      if ((callback != nullptr) && (load >= threshold)) {
+        callback(i, load);
+      }
+    }
+  }
+
+  /**
+   * CpuLoadMonitor.hpp
+   *
+   * @brief Function that returns the load over the last complete window.
+   *
+   * @param window The index of the window.
+   * @return uint32_t The load in parts per thousand, or 0 if the window has not
+   * completed yet.
+   */
+  inline uint32_t getLoad(const size_t window = 0) const {
+    configASSERT(window < Windows);
+    return windows[window].load;
+  }
+
+  /**
+   * CpuLoadMonitor.hpp
+   *
+   * @brief Function that returns the highest load of any complete window since
+   * the monitor was created or reset.
+   *
+   * @param window The index of the window.
+   * @return uint32_t The peak load in parts per thousand.
+   */
+  inline uint32_t getPeakLoad(const size_t window = 0) const {
+    configASSERT(window < Windows);
+    return windows[window].peak;
+  }
+
+  /**
+   * CpuLoadMonitor.hpp
+   *
+   * @brief Function that returns the average load since the monitor was
+   * created or reset.
+   *
+   * @return uint32_t The average load in parts per thousand.
+   */
+  inline uint32_t getAverageLoad() const {
+    taskENTER_CRITICAL();
+    const uint64_t idle = idleTime;
+    const uint64_t total = totalTime;
+    taskEXIT_CRITICAL();
+    return toLoad(idle, total);
+  }
+
+  /**
+   * CpuLoadMonitor.hpp
+   *
+   * @brief Function that clears the average, the peaks and the partially
+   * filled windows.  The next call to sample() records a new starting point.
+   */
+  void reset() {
+    taskENTER_CRITICAL();
+    started = false;
+    idleTime = 0;
+    totalTime = 0;
+    for (Window& window : windows) {
+      window.idle = 0;
+      window.total = 0;
+      window.count = 0;
+      window.load = 0;
+      window.peak = 0;
+    }
+    taskEXIT_CRITICAL();
+  }
+
+ private:
+  struct Window {
+    uint64_t idle = 0;
+    uint64_t total = 0;
+    uint32_t count = 0;
+    uint32_t length = 1;
+    uint32_t load = 0;
+    uint32_t peak = 0;
+  };
+
+  // Reads the counter the same way the kernel does for its run time stats.
+  inline static configRUN_TIME_COUNTER_TYPE getRunTimeCounter() {
+    configRUN_TIME_COUNTER_TYPE now;
+#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+    portALT_GET_RUN_TIME_COUNTER_VALUE(now);
+#else
+    now = portGET_RUN_TIME_COUNTER_VALUE();
+#endif /* portALT_GET_RUN_TIME_COUNTER_VALUE */
+    return now;
+  }
+
+  inline static uint32_t toLoad(const uint64_t idle, const uint64_t total) {
+    if ((total == 0) || (idle >= total)) {
+      return 0;
+    }
+    return static_cast<uint32_t>(((total - idle) * 1000) / total);
+  }
+
+  const uint32_t threshold;
+  const Callback callback;
+  bool started = false;
+  configRUN_TIME_COUNTER_TYPE lastIdle = 0;
+  configRUN_TIME_COUNTER_TYPE lastTotal = 0;
+  uint64_t idleTime = 0;
+  uint64_t totalTime = 0;
+  Window windows[Windows];
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configGENERATE_RUN_TIME_STATS && INCLUDE_xTaskGetIdleTaskHandle */
+
+#endif  // FREERTOS_CPULOADMONITOR_HPP
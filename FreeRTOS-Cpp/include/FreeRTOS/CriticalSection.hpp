@@ -0,0 +1,506 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_CRITICALSECTION_HPP
+#define FREERTOS_CRITICALSECTION_HPP
+
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Set FREERTOS_CPP_CRITICAL_SECTION_TIMING to 1 in FreeRTOSConfig.h (or
+ * on the compiler command line) to have FreeRTOS::CriticalSection,
+ * FreeRTOS::CriticalSectionFromISR and FreeRTOS::SchedulerLock record the
+ * longest time each kind of guard was held and where it was created.  Leave it
+ * at 0 in production builds, as timing adds two timestamp reads and a compare
+ * to every guard.
+ */
+#ifndef FREERTOS_CPP_CRITICAL_SECTION_TIMING
+#define FREERTOS_CPP_CRITICAL_SECTION_TIMING 0
+#endif
+
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+/**
+ * @brief Expression that reads the free running counter used to time guards.
+ * It defaults to the run time stats counter.  On a Cortex-M3 or later the DWT
+ * cycle counter gives cycle resolution.
+ */
+#ifndef FREERTOS_CPP_CRITICAL_SECTION_TIMESTAMP
+#define FREERTOS_CPP_CRITICAL_SECTION_TIMESTAMP() \
+  static_cast<uint32_t>(portGET_RUN_TIME_COUNTER_VALUE())
+#endif
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+#define FREERTOS_CPP_CEILING_BASEPRI
+#elif defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_8M_BASE__)
+#define FREERTOS_CPP_CEILING_PRIMASK
+#endif
+
+namespace FreeRTOS {
+
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+/**
+ * @class HoldTime CriticalSection.hpp <FreeRTOS/CriticalSection.hpp>
+ *
+ * @brief Record of the longest time a kind of guard has been held.
+ *
+ * FREERTOS_CPP_CRITICAL_SECTION_TIMING must be set to 1 for this class to be
+ * available.
+ */
+struct HoldTime {
+  /**
+   * @brief The longest time a guard was held, in
+   * FREERTOS_CPP_CRITICAL_SECTION_TIMESTAMP() counts.
+   */
+  uint32_t longest = 0;
+
+  /**
+   * @brief Name of the function that created the guard held for longest.
+   */
+  const char* function = NULL;
+
+  /**
+   * @brief Line of the source file that created the guard held for longest.
+   */
+  uint32_t line = 0;
+
+  // Must be called with the guard still held, so that the update is atomic.
+  inline void record(const uint32_t start, const char* where,
+                     const uint32_t atLine) {
+    const uint32_t held = FREERTOS_CPP_CRITICAL_SECTION_TIMESTAMP() - start;
+    if (held > longest) {
+      longest = held;
+      function = where;
+      line = atLine;
+    }
+  }
+};
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+
+/**
+ * @class CriticalSection CriticalSection.hpp <FreeRTOS/CriticalSection.hpp>
+ *
+ * @brief Class that calls <tt>taskENTER_CRITICAL()</tt> when it is constructed
+ * and <tt>taskEXIT_CRITICAL()</tt> when it goes out of scope, so the critical
+ * section can not be left open by an early return.
+ *
+ * @see <https://www.freertos.org/taskENTER_CRITICAL_taskEXIT_CRITICAL.html>
+ *
+ * Interrupts at or below configMAX_SYSCALL_INTERRUPT_PRIORITY are masked for
+ * the lifetime of the object, so keep the scope short.  Critical sections may
+ * nest.  Use FreeRTOS::CriticalSectionFromISR in an interrupt.
+ *
+ * When FREERTOS_CPP_CRITICAL_SECTION_TIMING is 1 the constructor takes the
+ * name of the calling function and the line it was called from as default
+ * arguments, and getHoldTime() reports the section that was held the longest.
+ *
+ * <b>Example Usage</b>
+ * @include CriticalSection/criticalSection.cpp
+ */
+class CriticalSection {
+ public:
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+  explicit CriticalSection(const char* function = __builtin_FUNCTION(),
+                           const uint32_t line = __builtin_LINE())
+      : function(function), line(line) {
+    taskENTER_CRITICAL();
+    start = FREERTOS_CPP_CRITICAL_SECTION_TIMESTAMP();
+  }
+  ~CriticalSection() {
+    holdTime.record(start, function, line);
+    taskEXIT_CRITICAL();
+  }
+#else
+  CriticalSection() {
+    taskENTER_CRITICAL();
+  }
+  ~CriticalSection() {
+    taskEXIT_CRITICAL();
+  }
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+
+  CriticalSection(const CriticalSection&) = delete;
+  CriticalSection& operator=(const CriticalSection&) = delete;
+
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+  /**
+   * CriticalSection.hpp
+   *
+   * @brief Function that returns the record of the critical section that has
+   * been held the longest since the last call to resetHoldTime().
+   *
+   * FREERTOS_CPP_CRITICAL_SECTION_TIMING must be set to 1 for this function to
+   * be available.
+   *
+   * @return HoldTime The longest hold time and where that guard was created.
+   */
+  static HoldTime getHoldTime() {
+    taskENTER_CRITICAL();
+    const HoldTime copy = holdTime;
+    taskEXIT_CRITICAL();
+    return copy;
+  }
+
+  /**
+   * CriticalSection.hpp
+   *
+   * @brief Function that clears the record returned by getHoldTime().
+   */
+  static void resetHoldTime() {
+    taskENTER_CRITICAL();
+    holdTime = HoldTime();
+    taskEXIT_CRITICAL();
+  }
+
+ private:
+  static inline HoldTime holdTime;
+
+  const char* function;
+  uint32_t line;
+  uint32_t start;
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+};
+
+/**
+ * @class CriticalSectionFromISR CriticalSection.hpp
+ * <FreeRTOS/CriticalSection.hpp>
+ *
+ * @brief Class that calls <tt>taskENTER_CRITICAL_FROM_ISR()</tt> when it is
+ * constructed and <tt>taskEXIT_CRITICAL_FROM_ISR()</tt> with the saved
+ * interrupt status when it goes out of scope.
+ *
+ * @see
+ * <https://www.freertos.org/taskENTER_CRITICAL_FROM_ISR_taskEXIT_CRITICAL_FROM_ISR.html>
+ *
+ * When FREERTOS_CPP_CRITICAL_SECTION_TIMING is 1 the longest hold is recorded
+ * separately from the task level critical sections.
+ *
+ * <b>Example Usage</b>
+ * @include CriticalSection/criticalSection.cpp
+ */
+class CriticalSectionFromISR {
+ public:
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+  explicit CriticalSectionFromISR(const char* function = __builtin_FUNCTION(),
+                                  const uint32_t line = __builtin_LINE())
+      : status(taskENTER_CRITICAL_FROM_ISR()), function(function), line(line) {
+    start = FREERTOS_CPP_CRITICAL_SECTION_TIMESTAMP();
+  }
+  ~CriticalSectionFromISR() {
+    holdTime.record(start, function, line);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+  }
+#else
+  CriticalSectionFromISR() : status(taskENTER_CRITICAL_FROM_ISR()) {}
+  ~CriticalSectionFromISR() {
+    taskEXIT_CRITICAL_FROM_ISR(status);
+  }
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+
+  CriticalSectionFromISR(const CriticalSectionFromISR&) = delete;
+  CriticalSectionFromISR& operator=(const CriticalSectionFromISR&) = delete;
+
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+  /**
+   * CriticalSection.hpp
+   *
+   * @brief Function that returns the record of the interrupt critical section
+   * that has been held the longest since the last call to resetHoldTime().
+   *
+   * FREERTOS_CPP_CRITICAL_SECTION_TIMING must be set to 1 for this function to
+   * be available.
+   *
+   * @return HoldTime The longest hold time and where that guard was created.
+   */
+  static HoldTime getHoldTime() {
+    taskENTER_CRITICAL();
+    const HoldTime copy = holdTime;
+    taskEXIT_CRITICAL();
+    return copy;
+  }
+
+  /**
+   * CriticalSection.hpp
+   *
+   * @brief Function that clears the record returned by getHoldTime().
+   */
+  static void resetHoldTime() {
+    taskENTER_CRITICAL();
+    holdTime = HoldTime();
+    taskEXIT_CRITICAL();
+  }
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+
+ private:
+  const UBaseType_t status;
+
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+  static inline HoldTime holdTime;
+
+  const char* function;
+  uint32_t line;
+  uint32_t start;
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+};
+
+/**
+ * @class CeilingCriticalSection CriticalSection.hpp
+ * <FreeRTOS/CriticalSection.hpp>
+ *
+ * @brief Class that masks only the interrupts at or below a priority ceiling
+ * while it is in scope, so that higher priority interrupts keep their latency.
+ *
+ * FreeRTOS::CriticalSection masks every interrupt up to
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.  When data is only shared with tasks
+ * and with interrupts at or below a lower priority, set Ceiling to the
+ * priority of the highest of those interrupts.  On ARMv7-M and ARMv8-M
+ * mainline cores the constructor raises BASEPRI to Ceiling, without ever
+ * lowering it, and the destructor restores the previous value, so these
+ * sections nest and may be used in interrupts as well as tasks.  The interrupt
+ * that switches tasks runs at the lowest priority, so no other task runs while
+ * the section is in scope either.
+ *
+ * ARMv6-M and ARMv8-M baseline cores have no BASEPRI, so all interrupts are
+ * masked with PRIMASK, and other ports use
+ * <tt>taskENTER_CRITICAL_FROM_ISR()</tt>.
+ *
+ * FreeRTOS API functions must not be called while the section is in scope.
+ * Their own critical sections set BASEPRI to
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY and then clear it, which would end the
+ * masking early.
+ *
+ * When FREERTOS_CPP_CRITICAL_SECTION_TIMING is 1 the longest hold is recorded
+ * for each ceiling.
+ *
+ * @tparam Ceiling The highest priority to mask, encoded the same way as
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY, that is shifted into the implemented
+ * bits of the priority register.  It must not be 0.
+ *
+ * <b>Example Usage</b>
+ * @include CriticalSection/ceilingCriticalSection.cpp
+ */
+template <UBaseType_t Ceiling>
+class CeilingCriticalSection {
+  static_assert(Ceiling > 0, "A ceiling of 0 would not mask any interrupt.");
+  static_assert(Ceiling <= 0xFF,
+                "The ceiling must be an 8 bit interrupt priority.");
+
+ public:
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+  explicit CeilingCriticalSection(const char* function = __builtin_FUNCTION(),
+                                  const uint32_t line = __builtin_LINE())
+      : status(raise()), function(function), line(line) {
+    start = FREERTOS_CPP_CRITICAL_SECTION_TIMESTAMP();
+  }
+  ~CeilingCriticalSection() {
+    holdTime.record(start, function, line);
+    restore(status);
+  }
+#else
+  CeilingCriticalSection() : status(raise()) {}
+  ~CeilingCriticalSection() {
+    restore(status);
+  }
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+
+  CeilingCriticalSection(const CeilingCriticalSection&) = delete;
+  CeilingCriticalSection& operator=(const CeilingCriticalSection&) = delete;
+
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+  /**
+   * CriticalSection.hpp
+   *
+   * @brief Function that returns the record of the section with this ceiling
+   * that has been held the longest since the last call to resetHoldTime().
+   *
+   * FREERTOS_CPP_CRITICAL_SECTION_TIMING must be set to 1 for this function to
+   * be available.
+   *
+   * @return HoldTime The longest hold time and where that guard was created.
+   */
+  static HoldTime getHoldTime() {
+    const UBaseType_t previous = raise();
+    const HoldTime copy = holdTime;
+    restore(previous);
+    return copy;
+  }
+
+  /**
+   * CriticalSection.hpp
+   *
+   * @brief Function that clears the record returned by getHoldTime().
+   */
+  static void resetHoldTime() {
+    const UBaseType_t previous = raise();
+    holdTime = HoldTime();
+    restore(previous);
+  }
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+
+ private:
+  inline static UBaseType_t raise() {
+#if defined(FREERTOS_CPP_CEILING_BASEPRI)
+    uint32_t previous;
+    // BASEPRI_MAX only accepts the new value if it masks more, so a section
+    // nested in a wider one leaves the wider mask in place.
+    __asm volatile(
+        "mrs %0, basepri\n\t"
+        "msr basepri_max, %1\n\t"
+        "isb"
+        : "=&r"(previous)
+        : "r"(Ceiling)
+        : "memory");
+    return previous;
+#elif defined(FREERTOS_CPP_CEILING_PRIMASK)
+    uint32_t previous;
+    __asm volatile(
+        "mrs %0, primask\n\t"
+        "cpsid i"
+        : "=r"(previous)
+        :
+        : "memory");
+    return previous;
+#else
+    return taskENTER_CRITICAL_FROM_ISR();
+#endif
+  }
+
+  inline static void restore(const UBaseType_t previous) {
+#if defined(FREERTOS_CPP_CEILING_BASEPRI)
+    __asm volatile("msr basepri, %0" ::"r"(previous) : "memory");
+#elif defined(FREERTOS_CPP_CEILING_PRIMASK)
+    __asm volatile("msr primask, %0" ::"r"(previous) : "memory");
+#else
+    taskEXIT_CRITICAL_FROM_ISR(previous);
+#endif
+  }
+
+  const UBaseType_t status;
+
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+  static inline HoldTime holdTime;
+
+  const char* function;
+  uint32_t line;
+  uint32_t start;
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+};
+
+/**
+ * @class SchedulerLock CriticalSection.hpp <FreeRTOS/CriticalSection.hpp>
+ *
+ * @brief Class that calls <tt>vTaskSuspendAll()</tt> when it is constructed
+ * and <tt>xTaskResumeAll()</tt> when it goes out of scope, so the scheduler
+ * can not be left suspended by an early return.
+ *
+ * @see <https://www.freertos.org/a00134.html>
+ *
+ * Interrupts stay enabled while the scheduler is suspended.  A context switch
+ * requested while the lock is held, for example by an interrupt that unblocks
+ * a higher priority task, is deferred until the lock goes out of scope, and
+ * then performed by <tt>xTaskResumeAll()</tt>.  API functions that can block
+ * must not be called while the lock is held.  Locks may nest.
+ *
+ * When FREERTOS_CPP_CRITICAL_SECTION_TIMING is 1 the longest hold is recorded
+ * separately from the critical sections.
+ *
+ * <b>Example Usage</b>
+ * @include CriticalSection/schedulerLock.cpp
+ */
+class SchedulerLock {
+ public:
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+  explicit SchedulerLock(const char* function = __builtin_FUNCTION(),
+                         const uint32_t line = __builtin_LINE())
+      : function(function), line(line) {
+    vTaskSuspendAll();
+    start = FREERTOS_CPP_CRITICAL_SECTION_TIMESTAMP();
+  }
+  ~SchedulerLock() {
+    // Only tasks use this record, and none can run while it is updated.
+    holdTime.record(start, function, line);
+    xTaskResumeAll();
+  }
+#else
+  SchedulerLock() {
+    vTaskSuspendAll();
+  }
+  ~SchedulerLock() {
+    xTaskResumeAll();
+  }
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+
+  SchedulerLock(const SchedulerLock&) = delete;
+  SchedulerLock& operator=(const SchedulerLock&) = delete;
+
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+  /**
+   * CriticalSection.hpp
+   *
+   * @brief Function that returns the record of the scheduler lock that has
+   * been held the longest since the last call to resetHoldTime().
+   *
+   * FREERTOS_CPP_CRITICAL_SECTION_TIMING must be set to 1 for this function to
+   * be available.
+   *
+   * @return HoldTime The longest hold time and where that lock was created.
+   */
+  static HoldTime getHoldTime() {
+    vTaskSuspendAll();
+    const HoldTime copy = holdTime;
+    xTaskResumeAll();
+    return copy;
+  }
+
+  /**
+   * CriticalSection.hpp
+   *
+   * @brief Function that clears the record returned by getHoldTime().
+   */
+  static void resetHoldTime() {
+    vTaskSuspendAll();
+    holdTime = HoldTime();
+    xTaskResumeAll();
+  }
+
+ private:
+  static inline HoldTime holdTime;
+
+  const char* function;
+  uint32_t line;
+  uint32_t start;
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+};
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_CRITICALSECTION_HPP
@@ -0,0 +1,146 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_DEADLINE_HPP
+#define FREERTOS_DEADLINE_HPP
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+namespace FreeRTOS {
+
+/**
+ * @class Deadline Deadline.hpp <FreeRTOS/Deadline.hpp>
+ *
+ * @brief Class that holds a time budget that is shared by a sequence of
+ * blocking calls.
+ *
+ * A Deadline is started with a budget in ticks.  Every time it is used it
+ * calls <tt>xTaskCheckForTimeOut()</tt> to find how much of the budget is left,
+ * so a chain of blocking calls as a whole never waits longer than the budget,
+ * however long each individual call blocks.
+ *
+ * A Deadline converts implicitly to the number of ticks that are left, so it
+ * can be passed as the ticksToWait or blockTime argument of any blocking
+ * function of the library, for example FreeRTOS::Queue::receive(),
+ * FreeRTOS::Semaphore::take() or FreeRTOS::Mutex::lock().
+ *
+ * A budget of portMAX_DELAY never expires if INCLUDE_vTaskSuspend is 1.
+ *
+ * <b>Example Usage</b>
+ * @include Deadline/deadline.cpp
+ */
+class Deadline {
+ public:
+  /**
+   * Deadline.hpp
+   *
+   * @brief Construct a new Deadline object by calling <tt>void
+   * vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )</tt>
+   *
+   * @see <https://www.freertos.org/xTaskCheckForTimeOut.html>
+   *
+   * @param budget The total number of ticks that the blocking calls using this
+   * deadline may wait for.
+   */
+  explicit Deadline(const TickType_t budget) : ticksLeft(budget) {
+    vTaskSetTimeOutState(&timeOut);
+  }
+  ~Deadline() = default;
+
+  Deadline(const Deadline&) = default;
+  Deadline& operator=(const Deadline&) = default;
+
+  /**
+   * Deadline.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskCheckForTimeOut( TimeOut_t
+   * * const pxTimeOut, TickType_t * const pxTicksToWait )</tt> to find the
+   * number of ticks left in the budget.
+   *
+   * @see <https://www.freertos.org/xTaskCheckForTimeOut.html>
+   *
+   * @return TickType_t The number of ticks left, or 0 if the deadline has
+   * passed.
+   */
+  TickType_t remaining() const {
+    if (ticksLeft != 0) {
+      if (xTaskCheckForTimeOut(&timeOut, &ticksLeft) != pdFALSE) {
+        ticksLeft = 0;
+      }
+    }
+    return ticksLeft;
+  }
+
+  /**
+   * Deadline.hpp
+   *
+   * @brief Function that returns whether the deadline has passed.
+   *
+   * @retval true No time is left in the budget.
+   * @retval false Otherwise.
+   */
+  inline bool hasExpired() const {
+    return (remaining() == 0);
+  }
+
+  /**
+   * Deadline.hpp
+   *
+   * @brief Function that starts the deadline again with a new budget.
+   *
+   * @param budget The total number of ticks that the blocking calls using this
+   * deadline may wait for.
+   */
+  inline void reset(const TickType_t budget) {
+    ticksLeft = budget;
+    vTaskSetTimeOutState(&timeOut);
+  }
+
+  /**
+   * Deadline.hpp
+   *
+   * @brief Conversion to the number of ticks left in the budget, so that a
+   * Deadline can be passed to any blocking function.  Equivalent to
+   * remaining().
+   *
+   * @return TickType_t The number of ticks left, or 0 if the deadline has
+   * passed.
+   */
+  inline operator TickType_t() const {  // NOLINT
+    return remaining();
+  }
+
+ private:
+  mutable TimeOut_t timeOut;
+  mutable TickType_t ticksLeft;
+};
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_DEADLINE_HPP
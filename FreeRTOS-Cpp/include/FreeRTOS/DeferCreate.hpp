@@ -0,0 +1,68 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_DEFERCREATE_HPP
+#define FREERTOS_DEFERCREATE_HPP
+
+namespace FreeRTOS {
+
+/**
+ * @brief Tag type that selects the constructor of a static class which does
+ * not create the kernel object.
+ *
+ * The normal constructors of FreeRTOS::StaticTask, FreeRTOS::StaticQueue and
+ * the other static classes call the kernel's create function.  For a global
+ * object that happens during C++ static initialization, in an order that is
+ * unspecified between source files and before the application had any chance
+ * to prepare the kernel, and it adds to the time spent before main().
+ *
+ * The constructors that take FreeRTOS::deferCreate are constexpr and do not
+ * call the kernel, so a global object constructed with one is constant
+ * initialized: it is placed in <tt>.bss</tt> and no constructor runs for it at
+ * startup.  The kernel object is then created by calling create() on the
+ * object, in whatever order the application chooses.  Until create() succeeds
+ * isValid() returns false and no other member function may be called.
+ *
+ * Objects whose storage is in a FREERTOS_CPP_DEFINE_REGION() region still take
+ * their storage from the region when they are constructed, so they are not
+ * constant initialized.
+ *
+ * <b>Example Usage</b>
+ * @include DeferCreate/deferCreate.cpp
+ */
+struct DeferCreate {
+  explicit DeferCreate() = default;
+};
+
+/**
+ * @brief The FreeRTOS::DeferCreate tag to pass to a constructor.
+ */
+inline constexpr DeferCreate deferCreate{};
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_DEFERCREATE_HPP
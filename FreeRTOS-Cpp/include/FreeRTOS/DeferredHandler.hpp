@@ -0,0 +1,280 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_DEFERREDHANDLER_HPP
+#define FREERTOS_DEFERREDHANDLER_HPP
+
+#include <FreeRTOS/Task.hpp>
+#include <atomic>
+#include <type_traits>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TASK_NOTIFICATIONS == 1) && \
+    (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @brief Counters collected by FreeRTOS::DeferredHandler.
+ */
+struct DeferredStatistics {
+  /**
+   * @brief The number of events that have been handled.
+   */
+  uint32_t events;
+
+  /**
+   * @brief The number of times the handler task woke up and found at least one
+   * event.
+   */
+  uint32_t wakeUps;
+
+  /**
+   * @brief The number of events that were handled in the same wake-up as an
+   * earlier event, i.e. that did not cost a context switch of their own.
+   */
+  uint32_t coalesced;
+
+  /**
+   * @brief The number of events that were discarded because the ring was full.
+   */
+  uint32_t dropped;
+};
+
+/**
+ * @class DeferredHandler DeferredHandler.hpp <FreeRTOS/DeferredHandler.hpp>
+ *
+ * @brief Class that implements a task that handles events posted by interrupt
+ * service routines, processing every pending event each time it wakes up.
+ *
+ * An ISR calls postFromISR() to copy a small event record into a ring inside
+ * the object.  The handler task is only notified when the ring goes from empty
+ * to not empty, and it then calls handle() for all the events in the ring
+ * before it blocks again.  A burst of events therefore costs one notification
+ * and one context switch instead of one per event.
+ *
+ * The handler task reads the ring without a lock.  Posting takes a short
+ * critical section, <tt>taskENTER_CRITICAL_FROM_ISR()</tt>, so that ISRs of
+ * different priorities can post to the same handler, including on cores
+ * without atomic read-modify-write instructions such as the Cortex-M0.
+ *
+ * @note This class is not intended to be instantiated by the user.  The user
+ * should create a class that derives from this class and implement handle().
+ *
+ * @warning The notification at index Index of the handler task is used by this
+ * class and must not be used for any other purpose.
+ *
+ * @tparam Event Type of the event records.  Must be trivially copyable.
+ * @tparam N The number of events the ring can hold.  Must be a power of 2.
+ * @tparam StackWords The number of words of stack of the handler task.
+ * @tparam Index The index of the task notification used to wake the handler.
+ *
+ * <b>Example Usage</b>
+ * @include DeferredHandler/deferredHandler.cpp
+ */
+template <class Event, UBaseType_t N,
+          UBaseType_t StackWords = configMINIMAL_STACK_SIZE,
+          UBaseType_t Index = 0>
+class DeferredHandler : public StaticTask<StackWords> {
+  static_assert(std::is_trivially_copyable_v<Event>,
+                "DeferredHandler events must be trivially copyable.");
+  static_assert((N > 0) && ((N & (N - 1)) == 0), "N must be a power of 2.");
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+
+ public:
+  DeferredHandler(const DeferredHandler&) = delete;
+  DeferredHandler& operator=(const DeferredHandler&) = delete;
+
+  /**
+   * DeferredHandler.hpp
+   *
+   * @brief Function that posts an event to the handler task from an ISR.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * posting the event woke the handler task, and the handler task has a
+   * priority higher than the currently running task.
+   * @param event The event to post.
+   * @retval true The event was posted.
+   * @retval false The ring was full, so the event was dropped.
+   */
+  bool postFromISR(bool& higherPriorityTaskWoken, const Event& event) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const Push result = push(event);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    if (result == Push::First) {
+      this->notifyGiveFromISR(higherPriorityTaskWoken, Index);
+    }
+    return (result != Push::Full);
+  }
+
+  /**
+   * DeferredHandler.hpp
+   *
+   * @overload
+   */
+  bool postFromISR(const Event& event) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const Push result = push(event);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    if (result == Push::First) {
+      this->notifyGiveFromISR(Index);
+    }
+    return (result != Push::Full);
+  }
+
+  /**
+   * DeferredHandler.hpp
+   *
+   * @brief Function that posts an event to the handler task from a task.
+   *
+   * @param event The event to post.
+   * @retval true The event was posted.
+   * @retval false The ring was full, so the event was dropped.
+   */
+  bool post(const Event& event) {
+    taskENTER_CRITICAL();
+    const Push result = push(event);
+    taskEXIT_CRITICAL();
+    if (result == Push::First) {
+      this->notifyGive(Index);
+    }
+    return (result != Push::Full);
+  }
+
+  /**
+   * DeferredHandler.hpp
+   *
+   * @brief Function that returns the number of events that have been posted
+   * but not handled yet.
+   *
+   * @return UBaseType_t The number of pending events.
+   */
+  inline UBaseType_t eventsWaiting() const {
+    return head.load(std::memory_order_acquire) -
+           tail.load(std::memory_order_acquire);
+  }
+
+  /**
+   * DeferredHandler.hpp
+   *
+   * @brief Function that returns a copy of the counters of the handler.  The
+   * copy is taken in a critical section so that it is consistent.
+   *
+   * @return DeferredStatistics The counters of the handler.
+   */
+  DeferredStatistics getStatistics() const {
+    taskENTER_CRITICAL();
+    const DeferredStatistics copy = statistics;
+    taskEXIT_CRITICAL();
+    return copy;
+  }
+
+ protected:
+  /**
+   * DeferredHandler.hpp
+   *
+   * @brief Construct a new DeferredHandler object and its handler task.
+   *
+   * @param priority The priority of the handler task.
+   * @param name A descriptive name for the handler task.
+   */
+  explicit DeferredHandler(const UBaseType_t priority = tskIDLE_PRIORITY,
+                           const char* name = "")
+      : StaticTask<StackWords>(deferCreate) {
+    // The task is created last, as it reads the ring as soon as it runs.
+    this->create(priority, name);
+  }
+  ~DeferredHandler() = default;
+
+  DeferredHandler(DeferredHandler&&) noexcept = default;
+  DeferredHandler& operator=(DeferredHandler&&) noexcept = default;
+
+  /**
+   * DeferredHandler.hpp
+   *
+   * @brief Function that is called by the handler task once for every posted
+   * event, in the order that the events were posted.
+   *
+   * @param event The event to handle.
+   */
+  virtual void handle(const Event& event) = 0;
+
+ private:
+  enum class Push { First, More, Full };
+
+  inline Push push(const Event& event) {
+    const UBaseType_t write = head.load(std::memory_order_relaxed);
+    const UBaseType_t read = tail.load(std::memory_order_acquire);
+    if ((write - read) == N) {
+      statistics.dropped++;
+      return Push::Full;
+    }
+    ring[write & (N - 1)] = event;
+    head.store(write + 1, std::memory_order_release);
+    return (write == read) ? Push::First : Push::More;
+  }
+
+  void taskFunction() final {
+    for (;;) {
+      this->notifyTake(portMAX_DELAY, true, Index);
+
+      uint32_t handled = 0;
+      UBaseType_t read = tail.load(std::memory_order_relaxed);
+      while (read != head.load(std::memory_order_acquire)) {
+        const Event event = ring[read & (N - 1)];
+        read++;
+        tail.store(read, std::memory_order_release);
+        handle(event);
+        handled++;
+      }
+
+      if (handled > 0) {
+        taskENTER_CRITICAL();
+        statistics.events += handled;
+        statistics.wakeUps++;
+        statistics.coalesced += handled - 1;
+        taskEXIT_CRITICAL();
+      }
+    }
+  }
+
+  Event ring[N];
+  std::atomic<UBaseType_t> head{0};
+  std::atomic<UBaseType_t> tail{0};
+  DeferredStatistics statistics = {0, 0, 0, 0};
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TASK_NOTIFICATIONS && configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_DEFERREDHANDLER_HPP
@@ -0,0 +1,330 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_EDFSCHEDULER_HPP
+#define FREERTOS_EDFSCHEDULER_HPP
+
+#include <FreeRTOS/Task.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (INCLUDE_vTaskPrioritySet == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @brief Counters collected by FreeRTOS::EdfScheduler for one task.
+ */
+struct EdfStatistics {
+  /**
+   * @brief The number of jobs that have completed.
+   */
+  uint32_t jobs;
+
+  /**
+   * @brief The number of jobs that completed after their deadline.
+   */
+  uint32_t misses;
+
+  /**
+   * @brief The longest time in ticks by which a job completed after its
+   * deadline.
+   */
+  TickType_t maxLateness;
+};
+
+/**
+ * @class EdfScheduler EdfScheduler.hpp <FreeRTOS/EdfScheduler.hpp>
+ *
+ * @brief Class that schedules a group of tasks earliest deadline first by
+ * reassigning their priorities within a band reserved for them.
+ *
+ * Rate monotonic priorities can only guarantee the deadlines of a periodic set
+ * up to about 69% utilization in general, while earliest deadline first meets
+ * every deadline of a set with implicit deadlines up to 100%.  The kernel only
+ * knows fixed priorities, so this class emulates EDF on top of them: each task
+ * calls release() with the absolute deadline of the job it is starting and
+ * complete() when the job is done.  Every call ranks the jobs in progress by
+ * deadline and gives the earliest the highest priority of the band, the next
+ * one the priority below, and so on.  Tasks with no job in progress drop to the
+ * lowest priority of the band.  Jobs with the same deadline share a priority.
+ *
+ * The priorities are changed with the scheduler suspended, so no task runs
+ * with a partly updated order, and only tasks whose priority changes are
+ * touched.  A band with fewer priorities than tasks still works, but the jobs
+ * with the latest deadlines then share the lowest active priority.
+ *
+ * complete() counts a job that finishes after its deadline as a miss, and
+ * records how late it was.  A job that never completes is not counted.
+ *
+ * Tasks outside the band keep their fixed priorities, so interrupt deferral
+ * tasks can stay above the EDF group and background tasks below it.  Use
+ * FreeRTOS::TaskSet::isEdfSchedulable() to check a set before deploying it.
+ *
+ * @warning release() and complete() must only be called from tasks.  A task
+ * must not change its own priority while it belongs to the group, and mutex
+ * priority inheritance between tasks in the band is overridden by the next
+ * reorder.
+ *
+ * @tparam MaxTasks The maximum number of tasks in the group.
+ *
+ * <b>Example Usage</b>
+ * @include EdfScheduler/edfScheduler.cpp
+ */
+template <size_t MaxTasks>
+class EdfScheduler {
+  static_assert(MaxTasks > 0, "An EDF group must hold at least one task.");
+
+ public:
+  /**
+   * EdfScheduler.hpp
+   *
+   * @brief Construct a new EdfScheduler object.
+   *
+   * @param lowestPriority The lowest priority of the band, given to tasks that
+   * have no job in progress.
+   * @param highestPriority The highest priority of the band, given to the job
+   * with the earliest deadline.  It must be greater than lowestPriority.
+   */
+  EdfScheduler(const UBaseType_t lowestPriority,
+               const UBaseType_t highestPriority)
+      : lowestPriority(lowestPriority), highestPriority(highestPriority) {
+    configASSERT(highestPriority > lowestPriority);
+    configASSERT(highestPriority < configMAX_PRIORITIES);
+  }
+  ~EdfScheduler() = default;
+
+  EdfScheduler(const EdfScheduler&) = delete;
+  EdfScheduler& operator=(const EdfScheduler&) = delete;
+
+  /**
+   * EdfScheduler.hpp
+   *
+   * @brief Function that adds a task to the group and sets it to the lowest
+   * priority of the band.
+   *
+   * @param task The task to add.  It must outlive the group.
+   * @retval true The task was added.
+   * @retval false The group is full or already holds the task.
+   */
+  bool add(const TaskBase& task) {
+    bool added = false;
+    vTaskSuspendAll();
+    if ((count < MaxTasks) && (find(task) == nullptr)) {
+      Entry& entry = entries[count++];
+      entry.task = &task;
+      entry.priority = lowestPriority;
+      task.setPriority(lowestPriority);
+      added = true;
+    }
+    xTaskResumeAll();
+    return added;
+  }
+
+  /**
+   * EdfScheduler.hpp
+   *
+   * @brief Function that starts a job of a task and reorders the priorities of
+   * the group.  Releasing a task whose previous job has not completed moves the
+   * deadline of that job.
+   *
+   * @param task The task starting a job.  It must have been added.
+   * @param deadline The tick count by which the job must complete.
+   */
+  void release(const TaskBase& task, const TickType_t deadline) {
+    vTaskSuspendAll();
+    Entry* entry = find(task);
+    configASSERT(entry != nullptr);
+    if (entry != nullptr) {
+      entry->deadline = deadline;
+      entry->active = true;
+      reorder();
+    }
+    xTaskResumeAll();
+  }
+
+  /**
+   * EdfScheduler.hpp
+   *
+   * @brief Function that starts a job of a task with a deadline relative to
+   * the current tick count.
+   *
+   * @param task The task starting a job.  It must have been added.
+   * @param relativeDeadline The number of ticks from now by which the job must
+   * complete.
+   */
+  inline void releaseAfter(const TaskBase& task,
+                           const TickType_t relativeDeadline) {
+    release(task, xTaskGetTickCount() + relativeDeadline);
+  }
+
+  /**
+   * EdfScheduler.hpp
+   *
+   * @brief Function that ends the job of a task, counts a miss if it is late,
+   * and reorders the priorities of the group.
+   *
+   * @param task The task whose job is done.  It must have been added.
+   * @retval true The job met its deadline.
+   * @retval false The job completed late, or no job was in progress.
+   */
+  bool complete(const TaskBase& task) {
+    bool met = false;
+    vTaskSuspendAll();
+    Entry* entry = find(task);
+    configASSERT(entry != nullptr);
+    if ((entry != nullptr) && entry->active) {
+      const SignedTick lateness =
+          static_cast<SignedTick>(xTaskGetTickCount() - entry->deadline);
+      entry->statistics.jobs++;
+      if (lateness > 0) {
+        entry->statistics.misses++;
+        if (static_cast<TickType_t>(lateness) >
+            entry->statistics.maxLateness) {
+          entry->statistics.maxLateness = static_cast<TickType_t>(lateness);
+        }
+      } else {
+        met = true;
+      }
+      entry->active = false;
+      reorder();
+    }
+    xTaskResumeAll();
+    return met;
+  }
+
+  /**
+   * EdfScheduler.hpp
+   *
+   * @brief Function that returns a copy of the counters of one task.
+   *
+   * @param task The task to report on.
+   * @return EdfStatistics The counters, or all zeros if the task is not in the
+   * group.
+   */
+  EdfStatistics getStatistics(const TaskBase& task) const {
+    EdfStatistics copy = {0, 0, 0};
+    vTaskSuspendAll();
+    const Entry* entry = find(task);
+    if (entry != nullptr) {
+      copy = entry->statistics;
+    }
+    xTaskResumeAll();
+    return copy;
+  }
+
+  /**
+   * EdfScheduler.hpp
+   *
+   * @brief Function that returns the number of deadline misses of the whole
+   * group.
+   *
+   * @return uint32_t The sum of the misses of every task.
+   */
+  uint32_t getMisses() const {
+    uint32_t misses = 0;
+    vTaskSuspendAll();
+    for (size_t i = 0; i < count; i++) {
+      misses += entries[i].statistics.misses;
+    }
+    xTaskResumeAll();
+    return misses;
+  }
+
+ private:
+  using SignedTick = std::make_signed_t<TickType_t>;
+
+  struct Entry {
+    const TaskBase* task = nullptr;
+    TickType_t deadline = 0;
+    UBaseType_t priority = 0;
+    bool active = false;
+    EdfStatistics statistics = {0, 0, 0};
+  };
+
+  const UBaseType_t lowestPriority;
+  const UBaseType_t highestPriority;
+  Entry entries[MaxTasks];
+  size_t count = 0;
+
+  Entry* find(const TaskBase& task) {
+    for (size_t i = 0; i < count; i++) {
+      if (entries[i].task == &task) {
+        return &entries[i];
+      }
+    }
+    return nullptr;
+  }
+
+  const Entry* find(const TaskBase& task) const {
+    return const_cast<EdfScheduler*>(this)->find(task);
+  }
+
+  // Deadlines are compared by their signed difference so that the order
+  // survives the tick count wrapping, as long as every deadline in progress is
+  // within half the tick range of the others.
+  static inline bool isEarlier(const Entry& a, const Entry& b) {
+    return static_cast<SignedTick>(a.deadline - b.deadline) < 0;
+  }
+
+  void reorder() {
+    const UBaseType_t activeLevels = highestPriority - lowestPriority;
+
+    for (size_t i = 0; i < count; i++) {
+      Entry& entry = entries[i];
+      UBaseType_t priority = lowestPriority;
+
+      if (entry.active) {
+        UBaseType_t rank = 0;
+        for (size_t j = 0; j < count; j++) {
+          if (entries[j].active && isEarlier(entries[j], entry)) {
+            rank++;
+          }
+        }
+        if (rank >= activeLevels) {
+          rank = activeLevels - 1;
+        }
+        priority = highestPriority - rank;
+      }
+
+      if (priority != entry.priority) {
+        entry.priority = priority;
+        entry.task->setPriority(priority);
+      }
+    }
+  }
+};
+
+}  // namespace FreeRTOS
+
+#endif /* INCLUDE_vTaskPrioritySet */
+
+#endif  // FREERTOS_EDFSCHEDULER_HPP
@@ -0,0 +1,218 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_EVENTCOUNTER_HPP
+#define FREERTOS_EVENTCOUNTER_HPP
+
+#include <FreeRTOS/Deadline.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class EventCounter EventCounter.hpp <FreeRTOS/EventCounter.hpp>
+ *
+ * @brief Class that counts events signalled by interrupts or tasks and wakes a
+ * single consuming task once per batch of events rather than once per event.
+ *
+ * add() and addFromISR() increment the count inside a short critical section.
+ * The consuming task is only notified when the count reaches the threshold
+ * given to the constructor, so with the default threshold of 1 it is woken on
+ * the transition from no events to one event, and events that arrive while it
+ * is still running just increase the count.  take() collects the whole count
+ * in one call.
+ *
+ * Unlike a FreeRTOS::CountingSemaphore there is no maximum count to run into,
+ * so events are never dropped.  The count saturates at UINT32_MAX.
+ *
+ * @warning take() must only be called by the task passed to the constructor.
+ * The notification at index Index of that task must not be used for any other
+ * purpose.
+ *
+ * @tparam Index The index within the consuming task's array of notification
+ * values that is used to wake it.
+ *
+ * <b>Example Usage</b>
+ * @include EventCounter/eventCounter.cpp
+ */
+template <UBaseType_t Index = 0>
+class EventCounter {
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+
+ public:
+  /**
+   * EventCounter.hpp
+   *
+   * @brief Construct a new EventCounter object that wakes consumer.
+   *
+   * @param consumer The only task that takes the events.  It must outlive the
+   * counter.
+   * @param threshold The number of uncollected events at which the consumer is
+   * woken.  Must be at least 1.
+   */
+  explicit EventCounter(const TaskBase& consumer,
+                        const uint32_t threshold = 1)
+      : handle(consumer.handle), threshold(threshold) {
+    configASSERT(threshold != 0);
+  }
+  ~EventCounter() = default;
+
+  EventCounter(const EventCounter&) = delete;
+  EventCounter& operator=(const EventCounter&) = delete;
+
+  /**
+   * EventCounter.hpp
+   *
+   * @brief Function that adds events to the count and notifies the consumer if
+   * the count reached the threshold.
+   *
+   * @param events The number of events to add.
+   */
+  inline void add(const uint32_t events = 1) {
+    taskENTER_CRITICAL();
+    const bool crossed = increment(events);
+    taskEXIT_CRITICAL();
+    if (crossed) {
+      xTaskNotifyGiveIndexed(handle, Index);
+    }
+  }
+
+  /**
+   * EventCounter.hpp
+   *
+   * @brief A version of add() that can be called from an interrupt service
+   * routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * adding the events woke the consumer, and the consumer has a priority
+   * higher than the currently running task.
+   * @param events The number of events to add.
+   */
+  inline void addFromISR(bool& higherPriorityTaskWoken,
+                         const uint32_t events = 1) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool crossed = increment(events);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    if (crossed) {
+      BaseType_t taskWoken = pdFALSE;
+      vTaskNotifyGiveIndexedFromISR(handle, Index, &taskWoken);
+      if (taskWoken == pdTRUE) {
+        higherPriorityTaskWoken = true;
+      }
+    }
+  }
+
+  /**
+   * EventCounter.hpp
+   *
+   * @overload
+   */
+  inline void addFromISR(const uint32_t events = 1) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool crossed = increment(events);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    if (crossed) {
+      vTaskNotifyGiveIndexedFromISR(handle, Index, NULL);
+    }
+  }
+
+  /**
+   * EventCounter.hpp
+   *
+   * @brief Function that waits for the count to reach the threshold and then
+   * collects every event counted so far, resetting the count to zero.
+   *
+   * @warning This function must only be called by the consuming task.
+   *
+   * @param ticksToWait The maximum time to wait for the threshold to be
+   * reached.  If it expires, the events counted so far are still collected.
+   * @return uint32_t The number of events collected.  0 if ticksToWait expired
+   * before any event was counted.
+   */
+  inline uint32_t take(const TickType_t ticksToWait = portMAX_DELAY) {
+#if (INCLUDE_xTaskGetCurrentTaskHandle == 1)
+    configASSERT(xTaskGetCurrentTaskHandle() == handle);
+#endif
+    const Deadline deadline(ticksToWait);
+    for (;;) {
+      const bool notified =
+          (ulTaskNotifyTakeIndexed(Index, pdTRUE, deadline) != 0);
+      taskENTER_CRITICAL();
+      const uint32_t events = count;
+      count = 0;
+      taskEXIT_CRITICAL();
+      // A notification with no events left was sent for events that an
+      // earlier take() collected after timing out, so wait again.
+      if (events != 0 || !notified) {
+        return events;
+      }
+    }
+  }
+
+  /**
+   * EventCounter.hpp
+   *
+   * @brief Function that returns the number of events that have not been
+   * collected yet, without collecting them.
+   *
+   * @return uint32_t The number of uncollected events.
+   */
+  inline uint32_t getCount() const {
+    taskENTER_CRITICAL();
+    const uint32_t events = count;
+    taskEXIT_CRITICAL();
+    return events;
+  }
+
+ private:
+  // Must be called inside a critical section.  Returns true if the count
+  // reached the threshold.
+  inline bool increment(const uint32_t events) {
+    const uint32_t previous = count;
+    count = (events > UINT32_MAX - previous) ? UINT32_MAX : previous + events;
+    return (previous < threshold) && (count >= threshold);
+  }
+
+  TaskHandle_t handle = NULL;
+  uint32_t threshold;
+  uint32_t count = 0;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+#endif  // FREERTOS_EVENTCOUNTER_HPP
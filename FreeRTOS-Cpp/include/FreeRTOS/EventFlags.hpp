@@ -0,0 +1,339 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_EVENTFLAGS_HPP
+#define FREERTOS_EVENTFLAGS_HPP
+
+#include <FreeRTOS/EventGroups.hpp>
+#include <type_traits>
+
+#include "FreeRTOS.h"
+#include "event_groups.h"
+
+#if (configUSE_EVENT_GROUPS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class EventFlags EventFlags.hpp <FreeRTOS/EventFlags.hpp>
+ *
+ * @brief Class that gives type safe access to an event group whose bits are
+ * named by the enumerators of Enum.
+ *
+ * Each enumerator is the number of the bit it names, so the masks are built at
+ * compile time from the enumerators given as template arguments, and every
+ * function compiles down to the kernel call with a constant mask.  A
+ * static_assert rejects enumerators that do not fit in the bits of an event
+ * group that are available to the application: 8 when TickType_t is 16 bits
+ * and 24 when it is 32 bits.
+ *
+ * An EventFlags object refers to an existing FreeRTOS::EventGroup or
+ * FreeRTOS::StaticEventGroup, which must outlive it.
+ *
+ * @tparam Enum An enumeration type whose enumerators are bit numbers.
+ *
+ * <b>Example Usage</b>
+ * @include EventFlags/eventFlags.cpp
+ */
+template <class Enum>
+class EventFlags {
+  static_assert(std::is_enum_v<Enum>, "Enum must be an enumeration type.");
+
+ public:
+  /**
+   * @brief The number of bits of an event group that can be used.
+   */
+  static constexpr UBaseType_t usableBits = EventGroupBase::EventBits().size();
+
+  /**
+   * @brief The mask with the bit of each of Flags set.
+   */
+  template <Enum... Flags>
+  static constexpr EventBits_t mask =
+      (static_cast<EventBits_t>(0) | ... |
+       (static_cast<EventBits_t>(1)
+        << static_cast<UBaseType_t>(Flags)));
+
+  /**
+   * @class Value EventFlags.hpp <FreeRTOS/EventFlags.hpp>
+   *
+   * @brief Typed copy of the bits of an event group, as returned by the
+   * functions of FreeRTOS::EventFlags.
+   */
+  class Value {
+   public:
+    /**
+     * EventFlags.hpp
+     *
+     * @brief Construct a Value from the raw bits of an event group.
+     */
+    constexpr explicit Value(const EventBits_t bits) : bits(bits) {}
+
+    /**
+     * EventFlags.hpp
+     *
+     * @brief Function that checks if the bit named flag is set.
+     *
+     * @param flag The flag to test.
+     * @retval true The flag is set.
+     * @retval false Otherwise.
+     */
+    constexpr bool test(const Enum flag) const {
+      return ((bits & (static_cast<EventBits_t>(1)
+                       << static_cast<UBaseType_t>(flag))) != 0);
+    }
+
+    /**
+     * EventFlags.hpp
+     *
+     * @brief Function that checks if any of Flags is set.
+     */
+    template <Enum... Flags>
+    constexpr bool any() const {
+      return ((bits & checkedMask<Flags...>()) != 0);
+    }
+
+    /**
+     * EventFlags.hpp
+     *
+     * @brief Function that checks if all of Flags are set.
+     */
+    template <Enum... Flags>
+    constexpr bool all() const {
+      return ((bits & checkedMask<Flags...>()) == checkedMask<Flags...>());
+    }
+
+    /**
+     * EventFlags.hpp
+     *
+     * @brief Function that returns the raw bits.
+     *
+     * @return EventBits_t The bits of the event group.
+     */
+    constexpr EventBits_t raw() const {
+      return bits;
+    }
+
+   private:
+    EventBits_t bits;
+  };
+
+  /**
+   * EventFlags.hpp
+   *
+   * @brief Construct a new EventFlags object that uses group.
+   *
+   * @param group The event group that holds the flags.
+   */
+  explicit EventFlags(const EventGroupBase& group) : group(group) {}
+
+  /**
+   * EventFlags.hpp
+   *
+   * @brief Function that calls <tt>EventBits_t xEventGroupSetBits(
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )</tt> to set
+   * Flags.
+   *
+   * @see <https://www.freertos.org/xEventGroupSetBits.html>
+   *
+   * @tparam Flags The flags to set.
+   * @return Value The value of the event group when set() returns.
+   */
+  template <Enum... Flags>
+  inline Value set() const {
+    return Value(group.set(checkedMask<Flags...>()));
+  }
+
+  /**
+   * EventFlags.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xEventGroupSetBitsFromISR(
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t
+   * *pxHigherPriorityTaskWoken )</tt> to set Flags.
+   *
+   * @see <https://www.freertos.org/xEventGroupSetBitsFromISR.html>
+   *
+   * @tparam Flags The flags to set.
+   * @param higherPriorityTaskWoken Set to true if the timer service task was
+   * woken and a context switch should be requested before the interrupt exits.
+   * @retval true The message was posted to the timer service task.
+   * @retval false The timer command queue was full.
+   */
+  template <Enum... Flags>
+  inline bool setFromISR(bool& higherPriorityTaskWoken) const {
+    return group.setFromISR(higherPriorityTaskWoken, checkedMask<Flags...>());
+  }
+
+  /**
+   * EventFlags.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xEventGroupSetBitsFromISR(
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t
+   * *pxHigherPriorityTaskWoken )</tt> to set Flags.
+   *
+   * @see <https://www.freertos.org/xEventGroupSetBitsFromISR.html>
+   *
+   * @overload
+   */
+  template <Enum... Flags>
+  inline bool setFromISR() const {
+    return group.setFromISR(checkedMask<Flags...>());
+  }
+
+  /**
+   * EventFlags.hpp
+   *
+   * @brief Function that calls <tt>EventBits_t xEventGroupClearBits(
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )</tt> to
+   * clear Flags.
+   *
+   * @see <https://www.freertos.org/xEventGroupClearBits.html>
+   *
+   * @tparam Flags The flags to clear.
+   * @return Value The value of the event group before the flags were cleared.
+   */
+  template <Enum... Flags>
+  inline Value clear() const {
+    return Value(group.clear(checkedMask<Flags...>()));
+  }
+
+  /**
+   * EventFlags.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xEventGroupClearBitsFromISR(
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )</tt> to
+   * clear Flags.
+   *
+   * @see <https://www.freertos.org/xEventGroupClearBitsFromISR.html>
+   *
+   * @tparam Flags The flags to clear.
+   * @retval true The message was posted to the timer service task.
+   * @retval false The timer command queue was full.
+   */
+  template <Enum... Flags>
+  inline bool clearFromISR() const {
+    return group.clearFromISR(checkedMask<Flags...>());
+  }
+
+  /**
+   * EventFlags.hpp
+   *
+   * @brief Function that calls <tt>EventBits_t xEventGroupGetBits(
+   * EventGroupHandle_t xEventGroup )</tt>
+   *
+   * @see <https://www.freertos.org/xEventGroupGetBits.html>
+   *
+   * @return Value The current value of the event group.
+   */
+  inline Value get() const {
+    return Value(xEventGroupGetBits(group.handle));
+  }
+
+  /**
+   * EventFlags.hpp
+   *
+   * @brief Function that calls <tt>EventBits_t xEventGroupGetBitsFromISR(
+   * EventGroupHandle_t xEventGroup )</tt>
+   *
+   * @see <https://www.freertos.org/xEventGroupGetBitsFromISR.html>
+   *
+   * @return Value The current value of the event group.
+   */
+  inline Value getFromISR() const {
+    return Value(xEventGroupGetBitsFromISR(group.handle));
+  }
+
+  /**
+   * EventFlags.hpp
+   *
+   * @brief Function that calls <tt>EventBits_t xEventGroupWaitBits( const
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor, const
+   * BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits, TickType_t
+   * xTicksToWait )</tt> to wait for any of Flags to be set.
+   *
+   * @see <https://www.freertos.org/xEventGroupWaitBits.html>
+   *
+   * @warning This function cannot be called from an interrupt.
+   *
+   * @tparam Flags The flags to wait for.
+   * @param clearOnExit If true the flags that were waited for are cleared
+   * before waitAny() returns, unless it timed out.
+   * @param ticksToWait The maximum amount of time to wait.
+   * @return Value The value of the event group when the wait ended.  Test it to
+   * know which flags were set, or if the wait timed out.
+   */
+  template <Enum... Flags>
+  inline Value waitAny(const bool clearOnExit = false,
+                       const TickType_t ticksToWait = portMAX_DELAY) const {
+    return Value(
+        group.wait(checkedMask<Flags...>(), clearOnExit, false, ticksToWait));
+  }
+
+  /**
+   * EventFlags.hpp
+   *
+   * @brief Function that calls <tt>EventBits_t xEventGroupWaitBits( const
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor, const
+   * BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits, TickType_t
+   * xTicksToWait )</tt> to wait for all of Flags to be set.
+   *
+   * @see <https://www.freertos.org/xEventGroupWaitBits.html>
+   *
+   * @warning This function cannot be called from an interrupt.
+   *
+   * @tparam Flags The flags to wait for.
+   * @param clearOnExit If true the flags that were waited for are cleared
+   * before waitAll() returns, unless it timed out.
+   * @param ticksToWait The maximum amount of time to wait.
+   * @return Value The value of the event group when the wait ended.  Use
+   * Value::all() to know if the wait timed out.
+   */
+  template <Enum... Flags>
+  inline Value waitAll(const bool clearOnExit = false,
+                       const TickType_t ticksToWait = portMAX_DELAY) const {
+    return Value(
+        group.wait(checkedMask<Flags...>(), clearOnExit, true, ticksToWait));
+  }
+
+ private:
+  template <Enum... Flags>
+  inline static constexpr EventBits_t checkedMask() {
+    static_assert(sizeof...(Flags) > 0, "At least one flag must be given.");
+    static_assert(((static_cast<UBaseType_t>(Flags) < usableBits) && ...),
+                  "A flag does not fit in the usable bits of an event group.");
+    return mask<Flags...>;
+  }
+
+  const EventGroupBase& group;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_EVENT_GROUPS */
+
+#endif  // FREERTOS_EVENTFLAGS_HPP
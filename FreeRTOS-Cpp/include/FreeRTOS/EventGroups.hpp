@@ -28,6 +28,9 @@
 #ifndef FREERTOS_EVENTGROUPS_HPP
 #define FREERTOS_EVENTGROUPS_HPP
 
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/DeferCreate.hpp>
+#include <FreeRTOS/Instrumentation.hpp>
 #include <bitset>
 
 #include "FreeRTOS.h"
@@ -50,6 +53,8 @@ class EventGroupBase {
  public:
   friend class EventGroup;
   friend class StaticEventGroup;
+  template <class>
+  friend class EventFlags;
 
   EventGroupBase(const EventGroupBase&) = delete;
   EventGroupBase& operator=(const EventGroupBase&) = delete;
@@ -140,9 +145,71 @@ class EventGroupBase {
                         const bool clearOnExit = false,
                         const bool waitForAllBits = false,
                         const TickType_t ticksToWait = portMAX_DELAY) const {
-    return EventBits(xEventGroupWaitBits(
-        handle, bitsToWaitFor.to_ulong(), (clearOnExit ? pdTRUE : pdFALSE),
-        (waitForAllBits ? pdTRUE : pdFALSE), ticksToWait));
+    return EventBits(wait(static_cast<EventBits_t>(bitsToWaitFor.to_ulong()),
+                          clearOnExit, waitForAllBits, ticksToWait));
+  }
+
+  /**
+   * EventGroups.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline EventBits wait(
+      const EventBits& bitsToWaitFor, const bool clearOnExit,
+      const bool waitForAllBits,
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return wait(bitsToWaitFor, clearOnExit, waitForAllBits,
+                Clock::toTicks(timeout));
+  }
+
+  /**
+   * EventGroups.hpp
+   *
+   * @brief Function that calls <tt>EventBits_t xEventGroupWaitBits( const
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor, const
+   * BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits, TickType_t
+   * xTicksToWait )</tt>
+   *
+   * @see <https://www.freertos.org/xEventGroupWaitBits.html>
+   *
+   * A version of wait() that takes and returns the bits as a raw EventBits_t
+   * mask, so no conversion to or from EventBits is made.
+   *
+   * @overload
+   *
+   * <b>Example Usage</b>
+   * @include EventGroups/rawBits.cpp
+   */
+  inline EventBits_t wait(const EventBits_t bitsToWaitFor,
+                          const bool clearOnExit = false,
+                          const bool waitForAllBits = false,
+                          const TickType_t ticksToWait = portMAX_DELAY) const {
+    return Instrument::call(
+        InstrumentedCall::EventGroupWait, handle, ticksToWait,
+        [&] {
+          return xEventGroupWaitBits(
+              handle, bitsToWaitFor, (clearOnExit ? pdTRUE : pdFALSE),
+              (waitForAllBits ? pdTRUE : pdFALSE), ticksToWait);
+        },
+        [&](const EventBits_t bits) {
+          return waitForAllBits ? ((bits & bitsToWaitFor) == bitsToWaitFor)
+                                : ((bits & bitsToWaitFor) != 0);
+        });
+  }
+
+  /**
+   * EventGroups.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline EventBits_t wait(
+      const EventBits_t bitsToWaitFor, const bool clearOnExit,
+      const bool waitForAllBits,
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return wait(bitsToWaitFor, clearOnExit, waitForAllBits,
+                Clock::toTicks(timeout));
   }
 
   /**
@@ -179,6 +246,23 @@ class EventGroupBase {
     return EventBits(xEventGroupSetBits(handle, bitsToSet.to_ulong()));
   }
 
+  /**
+   * EventGroups.hpp
+   *
+   * @brief Function that calls <tt>EventBits_t xEventGroupSetBits(
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )</tt>
+   *
+   * @see <https://www.freertos.org/xEventGroupSetBits.html>
+   *
+   * A version of set() that takes and returns the bits as a raw EventBits_t
+   * mask, so no conversion to or from EventBits is made.
+   *
+   * @overload
+   */
+  inline EventBits_t set(const EventBits_t bitsToSet) const {
+    return xEventGroupSetBits(handle, bitsToSet);
+  }
+
   /**
    * EventGroups.hpp
    *
@@ -231,8 +315,11 @@ class EventGroupBase {
   inline bool setFromISR(bool& higherPriorityTaskWoken,
                          const EventBits& bitsToSet) const {
     BaseType_t taskWoken = pdFALSE;
-    const bool result = (xEventGroupSetBitsFromISR(handle, bitsToSet.to_ulong(),
-                                                   &taskWoken) == pdPASS);
+    const bool result =
+        Instrument::callFromISR(InstrumentedCall::EventGroupSet, handle, [&] {
+          return (xEventGroupSetBitsFromISR(handle, bitsToSet.to_ulong(),
+                                            &taskWoken) == pdPASS);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
@@ -251,8 +338,92 @@ class EventGroupBase {
    * @overload
    */
   inline bool setFromISR(const EventBits& bitsToSet) const {
-    return (xEventGroupSetBitsFromISR(handle, bitsToSet.to_ulong(), NULL) ==
-            pdPASS);
+    return Instrument::callFromISR(
+        InstrumentedCall::EventGroupSet, handle, [&] {
+          return (xEventGroupSetBitsFromISR(handle, bitsToSet.to_ulong(),
+                                            NULL) == pdPASS);
+        });
+  }
+
+  /**
+   * EventGroups.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xEventGroupSetBitsFromISR(
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t
+   * *pxHigherPriorityTaskWoken )</tt>
+   *
+   * @see <https://www.freertos.org/xEventGroupSetBitsFromISR.html>
+   *
+   * A version of setFromISR() that takes the bits as a raw EventBits_t mask, so
+   * the call compiles down to the kernel function alone.
+   *
+   * @overload
+   */
+  inline bool setFromISR(bool& higherPriorityTaskWoken,
+                         const EventBits_t bitsToSet) const {
+    BaseType_t taskWoken = pdFALSE;
+    const bool result =
+        Instrument::callFromISR(InstrumentedCall::EventGroupSet, handle, [&] {
+          return (xEventGroupSetBitsFromISR(handle, bitsToSet, &taskWoken) ==
+                  pdPASS);
+        });
+    if (taskWoken == pdTRUE) {
+      higherPriorityTaskWoken = true;
+    }
+    return result;
+  }
+
+  /**
+   * EventGroups.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xEventGroupSetBitsFromISR(
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t
+   * *pxHigherPriorityTaskWoken )</tt>
+   *
+   * @see <https://www.freertos.org/xEventGroupSetBitsFromISR.html>
+   *
+   * @overload
+   */
+  inline bool setFromISR(const EventBits_t bitsToSet) const {
+    return Instrument::callFromISR(
+        InstrumentedCall::EventGroupSet, handle, [&] {
+          return (xEventGroupSetBitsFromISR(handle, bitsToSet, NULL) == pdPASS);
+        });
+  }
+
+  /**
+   * EventGroups.hpp
+   *
+   * @brief Function that sets the same bits in several event groups with one
+   * reschedule, by calling <tt>EventBits_t xEventGroupSetBits(
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )</tt> for
+   * each group with the scheduler suspended.
+   *
+   * @see <https://www.freertos.org/xEventGroupSetBits.html>
+   *
+   * Calling set() once per group can switch to the tasks woken by each group
+   * before the next group is set.  setAll() suspends the scheduler, so every
+   * group is set first and the highest priority task that was woken runs once
+   * the scheduler is resumed.
+   *
+   * This must not be used from an ISR.
+   *
+   * @param groups Pointer to the first element of an array of pointers to the
+   * event groups to set.
+   * @param count The number of event groups in the array.
+   * @param bitsToSet A bitwise value that indicates the bit or bits to set in
+   * every event group.
+   *
+   * <b>Example Usage</b>
+   * @include EventGroups/setAll.cpp
+   */
+  static void setAll(const EventGroupBase* const* groups, const size_t count,
+                     const EventBits& bitsToSet) {
+    vTaskSuspendAll();
+    for (size_t i = 0; i < count; i++) {
+      groups[i]->set(bitsToSet);
+    }
+    xTaskResumeAll();
   }
 
   /**
@@ -279,6 +450,23 @@ class EventGroupBase {
     return EventBits(xEventGroupClearBits(handle, bitsToClear.to_ulong()));
   }
 
+  /**
+   * EventGroups.hpp
+   *
+   * @brief Function that calls <tt>EventBits_t xEventGroupClearBits(
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )</tt>
+   *
+   * @see <https://www.freertos.org/xEventGroupClearBits.html>
+   *
+   * A version of clear() that takes and returns the bits as a raw EventBits_t
+   * mask, so no conversion to or from EventBits is made.
+   *
+   * @overload
+   */
+  inline EventBits_t clear(const EventBits_t bitsToClear) const {
+    return xEventGroupClearBits(handle, bitsToClear);
+  }
+
   /**
    * EventGroups.hpp
    *
@@ -302,8 +490,31 @@ class EventGroupBase {
    * @include EventGroups/clearFromISR.cpp
    */
   inline bool clearFromISR(const EventBits& bitsToClear) const {
-    return (xEventGroupClearBitsFromISR(handle, bitsToClear.to_ulong()) ==
-            pdPASS);
+    return Instrument::callFromISR(
+        InstrumentedCall::EventGroupSet, handle, [&] {
+          return (xEventGroupClearBitsFromISR(handle, bitsToClear.to_ulong()) ==
+                  pdPASS);
+        });
+  }
+
+  /**
+   * EventGroups.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xEventGroupClearBitsFromISR(
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )</tt>
+   *
+   * @see <https://www.freertos.org/xEventGroupClearBitsFromISR.html>
+   *
+   * A version of clearFromISR() that takes the bits as a raw EventBits_t mask,
+   * so the call compiles down to the kernel function alone.
+   *
+   * @overload
+   */
+  inline bool clearFromISR(const EventBits_t bitsToClear) const {
+    return Instrument::callFromISR(
+        InstrumentedCall::EventGroupSet, handle, [&] {
+          return (xEventGroupClearBitsFromISR(handle, bitsToClear) == pdPASS);
+        });
   }
 
   /**
@@ -380,8 +591,60 @@ class EventGroupBase {
   inline EventBits sync(const EventBits& bitsToSet = 0,
                         const EventBits& bitsToWaitFor = 0,
                         const TickType_t ticksToWait = portMAX_DELAY) const {
-    return EventBits(xEventGroupSync(handle, bitsToSet.to_ulong(),
-                                     bitsToWaitFor.to_ulong(), ticksToWait));
+    return EventBits(sync(static_cast<EventBits_t>(bitsToSet.to_ulong()),
+                          static_cast<EventBits_t>(bitsToWaitFor.to_ulong()),
+                          ticksToWait));
+  }
+
+  /**
+   * EventGroups.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline EventBits sync(
+      const EventBits& bitsToSet, const EventBits& bitsToWaitFor,
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return sync(bitsToSet, bitsToWaitFor, Clock::toTicks(timeout));
+  }
+
+  /**
+   * EventGroups.hpp
+   *
+   * @brief Function that calls <tt>EventBits_t xEventGroupSync(
+   * EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, const
+   * EventBits_t uxBitsToWaitFor, TickType_t xTicksToWait )</tt>
+   *
+   * @see <https://www.freertos.org/xEventGroupSync.html>
+   *
+   * A version of sync() that takes and returns the bits as raw EventBits_t
+   * masks, so no conversion to or from EventBits is made.
+   *
+   * @overload
+   */
+  inline EventBits_t sync(const EventBits_t bitsToSet,
+                          const EventBits_t bitsToWaitFor,
+                          const TickType_t ticksToWait = portMAX_DELAY) const {
+    return Instrument::call(
+        InstrumentedCall::EventGroupSync, handle, ticksToWait,
+        [&] {
+          return xEventGroupSync(handle, bitsToSet, bitsToWaitFor, ticksToWait);
+        },
+        [&](const EventBits_t bits) {
+          return ((bits & bitsToWaitFor) == bitsToWaitFor);
+        });
+  }
+
+  /**
+   * EventGroups.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline EventBits_t sync(
+      const EventBits_t bitsToSet, const EventBits_t bitsToWaitFor,
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return sync(bitsToSet, bitsToWaitFor, Clock::toTicks(timeout));
   }
 
  private:
@@ -410,7 +673,9 @@ class EventGroupBase {
    * and report an event group value of 0.
    */
   ~EventGroupBase() {
-    vEventGroupDelete(this->handle);
+    if (this->handle != NULL) {
+      vEventGroupDelete(this->handle);
+    }
   };
 
   EventGroupBase(EventGroupBase&&) noexcept = default;
@@ -503,8 +768,20 @@ class StaticEventGroup : public EventGroupBase {
    * @include EventGroups/staticEventGroup.cpp
    */
   StaticEventGroup() {
-    this->handle = xEventGroupCreateStatic(&staticEventGroup);
+    create();
   }
+
+  /**
+   * EventGroups.hpp
+   *
+   * @brief Construct a new StaticEventGroup object without creating the event
+   * group.
+   *
+   * This constructor is constexpr, so a global object constructed with it is
+   * constant initialized.  create() must be called before the event group is
+   * used.
+   */
+  constexpr explicit StaticEventGroup(DeferCreate) : staticEventGroup() {}
   ~StaticEventGroup() = default;
 
   StaticEventGroup(const StaticEventGroup&) = delete;
@@ -513,6 +790,24 @@ class StaticEventGroup : public EventGroupBase {
   StaticEventGroup(StaticEventGroup&&) noexcept = default;
   StaticEventGroup& operator=(StaticEventGroup&&) noexcept = default;
 
+  /**
+   * EventGroups.hpp
+   *
+   * @brief Function that calls <tt>EventGroupHandle_t xEventGroupCreateStatic(
+   * StaticEventGroup_t *pxEventGroupBuffer )</tt> to create an event group
+   * that was constructed with FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/xEventGroupCreateStatic.html>
+   *
+   * @retval true If the event group was created.
+   * @retval false Otherwise.
+   */
+  bool create() {
+    configASSERT(this->handle == NULL);
+    this->handle = xEventGroupCreateStatic(&staticEventGroup);
+    return (this->handle != NULL);
+  }
+
  private:
   StaticEventGroup_t staticEventGroup;
 };
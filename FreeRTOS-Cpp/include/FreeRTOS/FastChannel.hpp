@@ -0,0 +1,222 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_FASTCHANNEL_HPP
+#define FREERTOS_FASTCHANNEL_HPP
+
+#include <FreeRTOS/NotifyChannel.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <optional>
+#include <type_traits>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief The default index of the task notification that FreeRTOS::FastChannel
+ * uses to carry payloads that fit in 32 bits.  The notification at this index
+ * of a task that receives from a FastChannel must not be used for any other
+ * purpose.
+ */
+#ifndef FREERTOS_CPP_FAST_CHANNEL_INDEX
+#define FREERTOS_CPP_FAST_CHANNEL_INDEX 1
+#endif
+
+#if (configUSE_TASK_NOTIFICATIONS == 1) && \
+    (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class FastChannel FastChannel.hpp <FreeRTOS/FastChannel.hpp>
+ *
+ * @brief Class that sends single values to one receiving task through the
+ * cheapest mechanism that can carry them.
+ *
+ * When T fits in 32 bits the value is written into a task notification of the
+ * receiving task with <tt>eSetValueWithoutOverwrite</tt>, as
+ * FreeRTOS::NotifyChannel does, which needs no kernel object and no copy
+ * through a queue storage area.  Larger types fall back to a
+ * FreeRTOS::StaticQueue of length 1 held in the object.  Both hold at most one
+ * value, so send() fails while the previous value has not been received, and
+ * code using the channel does not change when T grows past 32 bits.
+ * usesNotification tells which mechanism was chosen.
+ *
+ * @warning When usesNotification is true, the notification at index Index of
+ * the receiving task must not be used for any other purpose.
+ *
+ * @tparam T Type of the values.  Must be trivially copyable.
+ * @tparam Index The index within the receiving task's array of notification
+ * values that carries the value when it fits in 32 bits.
+ *
+ * <b>Example Usage</b>
+ * @include FastChannel/fastChannel.cpp
+ */
+template <class T, UBaseType_t Index = FREERTOS_CPP_FAST_CHANNEL_INDEX>
+class FastChannel {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "FastChannel values must be trivially copyable.");
+#if (FREERTOS_CPP_TASK_JOIN == 1)
+  static_assert(Index != FREERTOS_CPP_TASK_JOIN_INDEX,
+                "The notification index is used by join().");
+#endif /* FREERTOS_CPP_TASK_JOIN */
+
+ public:
+  /**
+   * @brief Whether values are carried by a task notification, rather than by a
+   * queue.
+   */
+  static constexpr bool usesNotification = (sizeof(T) <= sizeof(uint32_t));
+
+  /**
+   * FastChannel.hpp
+   *
+   * @brief Construct a new FastChannel object that sends to receiver.
+   *
+   * @param receiver The task that receives the values.  It must outlive the
+   * channel.
+   */
+  explicit FastChannel(const TaskBase& receiver)
+      : channel(makeChannel(receiver)) {}
+  ~FastChannel() = default;
+
+  FastChannel(const FastChannel&) = delete;
+  FastChannel& operator=(const FastChannel&) = delete;
+
+  /**
+   * FastChannel.hpp
+   *
+   * @brief Function that sends a value without blocking.
+   *
+   * @param value The value to send.
+   * @retval true The value was sent.
+   * @retval false The previous value had not been received yet, so value was
+   * not sent.
+   */
+  inline bool send(const T& value) const {
+    if constexpr (usesNotification) {
+      return channel.send(value);
+    } else {
+      return channel.sendToBack(value, 0);
+    }
+  }
+
+  /**
+   * FastChannel.hpp
+   *
+   * @brief Function that sends a value from an interrupt.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * sending the value caused the receiving task to unblock, and the receiving
+   * task has a priority higher than the currently running task.
+   * @param value The value to send.
+   * @retval true The value was sent.
+   * @retval false The previous value had not been received yet, so value was
+   * not sent.
+   */
+  inline bool sendFromISR(bool& higherPriorityTaskWoken, const T& value) const {
+    if constexpr (usesNotification) {
+      return channel.sendFromISR(higherPriorityTaskWoken, value);
+    } else {
+      return channel.sendToBackFromISR(higherPriorityTaskWoken, value);
+    }
+  }
+
+  /**
+   * FastChannel.hpp
+   *
+   * @overload
+   */
+  inline bool sendFromISR(const T& value) const {
+    if constexpr (usesNotification) {
+      return channel.sendFromISR(value);
+    } else {
+      return channel.sendToBackFromISR(value);
+    }
+  }
+
+  /**
+   * FastChannel.hpp
+   *
+   * @brief Function that waits for a value.
+   *
+   * @warning When usesNotification is true, this function must only be called
+   * by the receiving task.
+   *
+   * @param value Reference the value is copied into.  It is left unmodified if
+   * no value was received.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for a value should none be pending at the time of the call.
+   * @retval true A value was received.
+   * @retval false No value was received before ticksToWait expired.
+   */
+  inline bool receive(T& value,
+                      const TickType_t ticksToWait = portMAX_DELAY) const {
+    return channel.receive(value, ticksToWait);
+  }
+
+  /**
+   * FastChannel.hpp
+   *
+   * @brief Function that waits for a value.
+   *
+   * @warning When usesNotification is true, this function must only be called
+   * by the receiving task.
+   *
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for a value should none be pending at the time of the call.
+   * @return std::optional<T> The received value.  User should check that the
+   * value is present.
+   */
+  inline std::optional<T> receive(
+      const TickType_t ticksToWait = portMAX_DELAY) const {
+    return channel.receive(ticksToWait);
+  }
+
+ private:
+  using Channel = std::conditional_t<usesNotification, NotifyChannel<Index, T>,
+                                     StaticQueue<T, 1>>;
+
+  // Returns a prvalue, so the queue is created in place and never moved.
+  static Channel makeChannel(const TaskBase& receiver) {
+    if constexpr (usesNotification) {
+      return Channel(receiver);
+    } else {
+      static_cast<void>(receiver);
+      return Channel();
+    }
+  }
+
+  Channel channel;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TASK_NOTIFICATIONS && configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_FASTCHANNEL_HPP
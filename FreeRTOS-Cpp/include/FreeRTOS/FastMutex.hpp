@@ -0,0 +1,288 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_FASTMUTEX_HPP
+#define FREERTOS_FASTMUTEX_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1) && \
+    (INCLUDE_vTaskPrioritySet == 1) && (INCLUDE_uxTaskPriorityGet == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class FastMutex FastMutex.hpp <FreeRTOS/FastMutex.hpp>
+ *
+ * @brief Class that implements a mutex whose uncontended lock() and unlock()
+ * do not enter the kernel.
+ *
+ * The mutex is an atomic word holding the handle of the owner.  When the mutex
+ * is free lock() claims it with a single compare and swap (LDREX/STREX on
+ * ARMv7-M and ARMv8-M, a short critical section on ARMv6-M, which has no
+ * exclusive access instructions), and unlock() releases it the same way, so an
+ * uncontended lock and unlock cost tens of cycles instead of two trips through
+ * the queue code.
+ *
+ * Only a task that finds the mutex taken enters the kernel.  It marks the word
+ * as contended and blocks on a binary semaphore, and the owner then hands the
+ * mutex directly to the highest priority waiter when it unlocks.  As the owner
+ * never took a kernel mutex, the blocked task applies priority inheritance
+ * itself: if it has a higher priority than the owner it raises the priority of
+ * the owner, which unlock() then restores.
+ *
+ * configSUPPORT_STATIC_ALLOCATION, INCLUDE_vTaskPrioritySet and
+ * INCLUDE_uxTaskPriorityGet must be defined as 1 for this class to be
+ * available.
+ *
+ * @warning This class contains the storage buffer for the semaphore, so the
+ * user should create this object as a global object or with the static storage
+ * specifier so that the object instance is not on the stack.  FastMutex can not
+ * be used from an interrupt and is not recursive.
+ *
+ * <b>Example Usage</b>
+ * @include FastMutex/fastMutex.cpp
+ */
+class FastMutex {
+ public:
+  /**
+   * FastMutex.hpp
+   *
+   * @brief Construct a new FastMutex object by calling <tt>SemaphoreHandle_t
+   * xSemaphoreCreateBinaryStatic( StaticSemaphore_t *pxSemaphoreBuffer )</tt>
+   * for the semaphore used when the mutex is contended.
+   *
+   * @see <https://www.freertos.org/xSemaphoreCreateBinaryStatic.html>
+   */
+  FastMutex() : handoff(xSemaphoreCreateBinaryStatic(&handoffBuffer)) {}
+
+  /**
+   * FastMutex.hpp
+   *
+   * @brief Destroy the FastMutex object by calling <tt>void vSemaphoreDelete(
+   * SemaphoreHandle_t xSemaphore )</tt>
+   *
+   * @see <https://www.freertos.org/a00113.html#vSemaphoreDelete>
+   */
+  ~FastMutex() {
+    vSemaphoreDelete(handoff);
+  }
+
+  FastMutex(const FastMutex&) = delete;
+  FastMutex& operator=(const FastMutex&) = delete;
+
+  /**
+   * FastMutex.hpp
+   *
+   * @brief Function that checks if the semaphore used under contention was
+   * created.
+   *
+   * @retval true If the mutex was created successfully.
+   * @retval false Otherwise.
+   */
+  inline bool isValid() const {
+    return (handoff != NULL);
+  }
+
+  /**
+   * FastMutex.hpp
+   *
+   * @brief Function that locks the mutex, blocking for up to ticksToWait if it
+   * is owned by another task.
+   *
+   * @param ticksToWait The time in ticks to wait for the mutex to become
+   * available.  A block time of zero can be used to poll the mutex.
+   * @retval true If the mutex was locked.
+   * @retval false If ticksToWait expired without the mutex becoming available.
+   *
+   * <b>Example Usage</b>
+   * @include FastMutex/fastMutex.cpp
+   */
+  inline bool lock(const TickType_t ticksToWait = portMAX_DELAY) {
+    const uintptr_t self = currentTask();
+    if (exchange(0, self)) {
+      return true;
+    }
+    return lockContended(self, ticksToWait);
+  }
+
+  /**
+   * FastMutex.hpp
+   *
+   * @brief Function that unlocks the mutex.
+   *
+   * @retval true If the mutex was unlocked.
+   * @retval false If the calling task does not own the mutex.
+   */
+  inline bool unlock() {
+    const uintptr_t self = currentTask();
+    if (exchange(self, 0)) {
+      return true;
+    }
+    return unlockContended(self);
+  }
+
+  /**
+   * FastMutex.hpp
+   *
+   * @brief Function that returns the task that owns the mutex.
+   *
+   * @return TaskHandle_t The owner, or NULL if the mutex is free or being
+   * handed to a waiting task.
+   */
+  inline TaskHandle_t getOwner() const {
+    return reinterpret_cast<TaskHandle_t>(
+        owner.load(std::memory_order_relaxed) & ~contended);
+  }
+
+ private:
+  // Task control blocks are word aligned, so the lowest bit of the owner word
+  // is free to mark that tasks may be waiting.  The word is only contended
+  // while it is being handed from the unlocking task to a waiting task.
+  static constexpr uintptr_t contended = 1;
+
+  inline static uintptr_t currentTask() {
+    return reinterpret_cast<uintptr_t>(xTaskGetCurrentTaskHandle());
+  }
+
+  inline bool exchange(uintptr_t expected, const uintptr_t desired) {
+#if defined(__ARM_ARCH_6M__)
+    bool result = false;
+    taskENTER_CRITICAL();
+    if (owner.load(std::memory_order_relaxed) == expected) {
+      owner.store(desired, std::memory_order_relaxed);
+      result = true;
+    }
+    taskEXIT_CRITICAL();
+    return result;
+#else
+    return owner.compare_exchange_strong(expected, desired,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_relaxed);
+#endif /* __ARM_ARCH_6M__ */
+  }
+
+  // Must be called with the scheduler suspended.
+  inline void inheritPriority(const uintptr_t holder) {
+    if (holder == 0) {
+      return;
+    }
+    TaskHandle_t task = reinterpret_cast<TaskHandle_t>(holder);
+    const UBaseType_t priority = uxTaskPriorityGet(NULL);
+    if (uxTaskPriorityGet(task) < priority) {
+      if (!boosted) {
+#if (configUSE_MUTEXES == 1)
+        ownerPriority = uxTaskBasePriorityGet(task);
+#else
+        ownerPriority = uxTaskPriorityGet(task);
+#endif /* configUSE_MUTEXES */
+        boosted = true;
+      }
+      vTaskPrioritySet(task, priority);
+    }
+  }
+
+  bool lockContended(const uintptr_t self, const TickType_t ticksToWait) {
+    for (;;) {
+      vTaskSuspendAll();
+      const uintptr_t word = owner.load(std::memory_order_relaxed);
+      if (word == 0) {
+        const bool locked = exchange(0, self);
+        xTaskResumeAll();
+        if (locked) {
+          return true;
+        }
+        continue;
+      }
+      if (((word & contended) == 0) && !exchange(word, word | contended)) {
+        xTaskResumeAll();
+        continue;
+      }
+      waiters++;
+      inheritPriority(word & ~contended);
+      xTaskResumeAll();
+      break;
+    }
+
+    bool locked = (xSemaphoreTake(handoff, ticksToWait) == pdTRUE);
+
+    vTaskSuspendAll();
+    if (!locked) {
+      // The mutex may have been handed over just after the wait timed out.
+      locked = (xSemaphoreTake(handoff, 0) == pdTRUE);
+    }
+    waiters--;
+    if (locked) {
+      owner.store(self | ((waiters > 0) ? contended : 0),
+                  std::memory_order_release);
+    }
+    xTaskResumeAll();
+    return locked;
+  }
+
+  bool unlockContended(const uintptr_t self) {
+    vTaskSuspendAll();
+    const bool owned =
+        ((owner.load(std::memory_order_relaxed) & ~contended) == self);
+    if (owned) {
+      if (boosted) {
+        boosted = false;
+        vTaskPrioritySet(NULL, ownerPriority);
+      }
+      if (waiters == 0) {
+        // Every waiter timed out.
+        owner.store(0, std::memory_order_release);
+      } else {
+        // The highest priority waiter is unblocked and becomes the owner.
+        owner.store(contended, std::memory_order_release);
+        xSemaphoreGive(handoff);
+      }
+    }
+    xTaskResumeAll();
+    return owned;
+  }
+
+  std::atomic<uintptr_t> owner{0};
+  StaticSemaphore_t handoffBuffer;
+  SemaphoreHandle_t handoff;
+  UBaseType_t waiters = 0;
+  UBaseType_t ownerPriority = 0;
+  bool boosted = false;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION && INCLUDE_vTaskPrioritySet && \
+          INCLUDE_uxTaskPriorityGet */
+
+#endif  // FREERTOS_FASTMUTEX_HPP
@@ -0,0 +1,339 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_FUTURE_HPP
+#define FREERTOS_FUTURE_HPP
+
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/Deadline.hpp>
+#include <optional>
+#include <type_traits>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+
+namespace FreeRTOS {
+
+template <class T, UBaseType_t Index>
+class Future;
+
+/**
+ * @class Promise Future.hpp <FreeRTOS/Future.hpp>
+ *
+ * @brief Class that delivers a single result to a FreeRTOS::Future.
+ *
+ * A Promise is created by FreeRTOS::Future::getPromise() and is no more than a
+ * pointer to the future, so it is trivially copyable and can be sent to the
+ * task that produces the result inside a request, for example through a
+ * FreeRTOS::Queue.  Calling setValue() copies the result into the future and
+ * notifies the waiting task.  It may be called from an ISR with
+ * setValueFromISR().
+ *
+ * @warning The future must outlive every use of its promises.  A producer that
+ * receives a request after the requester has given up waiting may still set
+ * the value, so the requester must keep the future alive until the producer is
+ * known to be done with the promise.
+ *
+ * @tparam T Type of the result.  Must be trivially copyable.
+ * @tparam Index The index of the task notification used to wake the waiting
+ * task.
+ *
+ * <b>Example Usage</b>
+ * @include Future/future.cpp
+ */
+template <class T, UBaseType_t Index = 0>
+class Promise {
+ public:
+  Promise() = default;
+  ~Promise() = default;
+
+  Promise(const Promise&) = default;
+  Promise& operator=(const Promise&) = default;
+
+  /**
+   * Future.hpp
+   *
+   * @brief Function that returns whether the promise refers to a future.
+   *
+   * @retval true The promise was created by FreeRTOS::Future::getPromise().
+   * @retval false The promise was default constructed.
+   */
+  inline bool isValid() const {
+    return (future != nullptr);
+  }
+
+  /**
+   * Future.hpp
+   *
+   * @brief Function that stores the result in the future and wakes the task
+   * waiting in FreeRTOS::Future::get().
+   *
+   * @param value The result.
+   * @retval true The result was stored.
+   * @retval false The future already holds a result, so value was discarded.
+   */
+  inline bool setValue(const T& value) const {
+    taskENTER_CRITICAL();
+    const bool claimed = future->claim();
+    taskEXIT_CRITICAL();
+    if (!claimed) {
+      return false;
+    }
+
+    future->value = value;
+
+    taskENTER_CRITICAL();
+    const TaskHandle_t waiter = future->publish();
+    taskEXIT_CRITICAL();
+    if (waiter != NULL) {
+      xTaskNotifyGiveIndexed(waiter, Index);
+    }
+    return true;
+  }
+
+  /**
+   * Future.hpp
+   *
+   * @brief Function that stores the result in the future and wakes the task
+   * waiting in FreeRTOS::Future::get() from an ISR.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * setting the value woke the waiting task, and the waiting task has a
+   * priority higher than the currently running task.
+   * @param value The result.
+   * @retval true The result was stored.
+   * @retval false The future already holds a result, so value was discarded.
+   */
+  inline bool setValueFromISR(bool& higherPriorityTaskWoken,
+                              const T& value) const {
+    UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool claimed = future->claim();
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    if (!claimed) {
+      return false;
+    }
+
+    future->value = value;
+
+    status = taskENTER_CRITICAL_FROM_ISR();
+    const TaskHandle_t waiter = future->publish();
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    if (waiter != NULL) {
+      BaseType_t taskWoken = pdFALSE;
+      vTaskNotifyGiveIndexedFromISR(waiter, Index, &taskWoken);
+      if (taskWoken == pdTRUE) {
+        higherPriorityTaskWoken = true;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Future.hpp
+   *
+   * @overload
+   */
+  inline bool setValueFromISR(const T& value) const {
+    bool higherPriorityTaskWoken = false;
+    return setValueFromISR(higherPriorityTaskWoken, value);
+  }
+
+ private:
+  explicit Promise(Future<T, Index>* future) : future(future) {}
+
+  Future<T, Index>* future = nullptr;
+
+  friend class Future<T, Index>;
+};
+
+/**
+ * @class Future Future.hpp <FreeRTOS/Future.hpp>
+ *
+ * @brief Class that holds the result of a request made to another task or to
+ * an ISR, and lets the requesting task block until the result arrives.
+ *
+ * The result is stored inside the future, so a request/response exchange
+ * needs no reply queue and no heap.  The requesting task creates a future,
+ * sends getPromise() with its request and calls get().  The producer calls
+ * FreeRTOS::Promise::setValue(), which costs one task notification to wake the
+ * requester.
+ *
+ * If get() times out the future stops waking the task, so a result that
+ * arrives late is stored but does not disturb whatever the task is waiting for
+ * next.  Calling get() again waits for it once more.  reset() makes the future
+ * ready for the next request.
+ *
+ * @warning The notification at index Index of the waiting task is used by this
+ * class.  Futures may share an index with each other, because get() ignores
+ * notifications that did not deliver its own result, but not with any other
+ * use of task notifications.
+ *
+ * @tparam T Type of the result.  Must be trivially copyable.
+ * @tparam Index The index of the task notification used to wake the waiting
+ * task.
+ *
+ * <b>Example Usage</b>
+ * @include Future/future.cpp
+ */
+template <class T, UBaseType_t Index = 0>
+class Future {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Future results must be trivially copyable.");
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+
+ public:
+  Future() = default;
+  ~Future() = default;
+
+  Future(const Future&) = delete;
+  Future& operator=(const Future&) = delete;
+  Future(Future&&) = delete;
+  Future& operator=(Future&&) = delete;
+
+  /**
+   * Future.hpp
+   *
+   * @brief Function that returns a promise that delivers its result to this
+   * future.
+   *
+   * @return Promise<T, Index> The promise to send to the producer.
+   */
+  inline Promise<T, Index> getPromise() {
+    return Promise<T, Index>(this);
+  }
+
+  /**
+   * Future.hpp
+   *
+   * @brief Function that blocks the calling task until the result has been
+   * set or the timeout expires.
+   *
+   * @param ticksToWait The maximum amount of time to wait for the result.
+   * @return std::optional<T> The result, or <tt>std::nullopt</tt> if it did
+   * not arrive in time.
+   */
+  std::optional<T> get(const TickType_t ticksToWait = portMAX_DELAY) {
+    const Deadline deadline(ticksToWait);
+
+    for (;;) {
+      taskENTER_CRITICAL();
+      const bool ready = (state == State::Ready);
+      waiter = ready ? NULL : xTaskGetCurrentTaskHandle();
+      taskEXIT_CRITICAL();
+      if (ready) {
+        return value;
+      }
+
+      const TickType_t remaining = deadline.remaining();
+      if ((remaining == 0) ||
+          (ulTaskNotifyTakeIndexed(Index, pdTRUE, remaining) == 0)) {
+        taskENTER_CRITICAL();
+        const bool late = (state == State::Ready);
+        waiter = NULL;
+        taskEXIT_CRITICAL();
+        if (late) {
+          return value;
+        }
+        if (deadline.hasExpired()) {
+          return std::nullopt;
+        }
+      }
+    }
+  }
+
+  /**
+   * Future.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline std::optional<T> get(
+      const std::chrono::duration<Rep, Period>& timeout) {
+    return get(Clock::toTicks(timeout));
+  }
+
+  /**
+   * Future.hpp
+   *
+   * @brief Function that returns whether the result has been set.
+   *
+   * @retval true get() will return the result without blocking.
+   * @retval false Otherwise.
+   */
+  inline bool isReady() const {
+    return (state == State::Ready);
+  }
+
+  /**
+   * Future.hpp
+   *
+   * @brief Function that discards the result so that the future can be used
+   * for another request.
+   *
+   * @warning The promises of the previous request must no longer be in use.
+   */
+  inline void reset() {
+    taskENTER_CRITICAL();
+    state = State::Empty;
+    waiter = NULL;
+    taskEXIT_CRITICAL();
+  }
+
+ private:
+  enum class State : uint8_t { Empty, Setting, Ready };
+
+  // Called in a critical section.  Only one producer may write the value.
+  inline bool claim() {
+    if (state != State::Empty) {
+      return false;
+    }
+    state = State::Setting;
+    return true;
+  }
+
+  // Called in a critical section.  Returns the task to wake, if any.
+  inline TaskHandle_t publish() {
+    state = State::Ready;
+    return waiter;
+  }
+
+  T value{};
+  TaskHandle_t waiter = NULL;
+  volatile State state = State::Empty;
+
+  friend class Promise<T, Index>;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+#endif  // FREERTOS_FUTURE_HPP
@@ -0,0 +1,329 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_HEAP_HPP
+#define FREERTOS_HEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class Heap Heap.hpp <FreeRTOS/Heap.hpp>
+ *
+ * @brief Class that provides an interface to the FreeRTOS heap.
+ *
+ * Memory comes from <tt>pvPortMalloc()</tt>, so C++ allocations share the heap
+ * used by the kernel for dynamically allocated objects instead of competing
+ * with it through the C library's <tt>malloc()</tt>.  Like
+ * <tt>pvPortMalloc()</tt>, these functions must not be called from an
+ * interrupt.
+ *
+ * <b>Example Usage</b>
+ * @include Heap/heap.cpp
+ */
+class Heap {
+ public:
+  Heap() = delete;
+
+  /**
+   * Heap.hpp
+   *
+   * @brief Function that calls <tt>pvPortMalloc()</tt>
+   *
+   * @see <https://www.freertos.org/a00111.html>
+   *
+   * @param size The number of bytes to allocate.
+   * @return void* The allocated memory, aligned to
+   * <tt>portBYTE_ALIGNMENT</tt>, or NULL if the heap could not satisfy the
+   * request.
+   */
+  static inline void* allocate(const size_t size) {
+    void* pointer = pvPortMalloc(size);
+    if (pointer != NULL) {
+      taskENTER_CRITICAL();
+      allocations = allocations + 1;
+      taskEXIT_CRITICAL();
+    }
+    return pointer;
+  }
+
+  /**
+   * Heap.hpp
+   *
+   * @brief Function that calls allocate() and treats a failed allocation as an
+   * error.
+   *
+   * If exceptions are enabled <tt>std::bad_alloc</tt> is thrown, otherwise
+   * <tt>configASSERT()</tt> is called.  Enable
+   * <tt>configUSE_MALLOC_FAILED_HOOK</tt> to also be notified through
+   * <tt>vApplicationMallocFailedHook()</tt>.
+   *
+   * @param size The number of bytes to allocate.
+   * @return void* The allocated memory.  NULL is only returned if exceptions
+   * are disabled and <tt>configASSERT()</tt> returns.
+   */
+  static inline void* allocateOrFail(const size_t size) {
+    void* pointer = allocate(size);
+#if defined(__cpp_exceptions)
+    if (pointer == NULL) {
+      throw std::bad_alloc();
+    }
+#else
+    configASSERT(pointer != NULL);
+#endif
+    return pointer;
+  }
+
+  /**
+   * Heap.hpp
+   *
+   * @brief Function that calls <tt>vPortFree()</tt>
+   *
+   * @see <https://www.freertos.org/a00111.html>
+   *
+   * @param pointer Memory returned by allocate() or allocateOrFail().  NULL is
+   * ignored.
+   */
+  static inline void free(void* pointer) {
+    if (pointer == NULL) {
+      return;
+    }
+    vPortFree(pointer);
+    taskENTER_CRITICAL();
+    allocations = allocations - 1;
+    taskEXIT_CRITICAL();
+  }
+
+  /**
+   * Heap.hpp
+   *
+   * @brief Function that calls <tt>xPortGetFreeHeapSize()</tt>
+   *
+   * @see <https://www.freertos.org/a00111.html>
+   *
+   * @return size_t The number of free bytes in the heap.  Not available when
+   * heap_3 is used.
+   */
+  static inline size_t getFreeSize() {
+    return xPortGetFreeHeapSize();
+  }
+
+  /**
+   * Heap.hpp
+   *
+   * @brief Function that calls <tt>xPortGetMinimumEverFreeHeapSize()</tt>
+   *
+   * @see <https://www.freertos.org/a00111.html>
+   *
+   * @return size_t The lowest number of free bytes the heap has had since the
+   * system booted.  Only available when heap_4 or heap_5 is used.
+   */
+  static inline size_t getMinimumEverFreeSize() {
+    return xPortGetMinimumEverFreeHeapSize();
+  }
+
+  /**
+   * Heap.hpp
+   *
+   * @brief Function that returns the number of blocks allocated through this
+   * class that have not been freed.
+   *
+   * Allocations made by the kernel or directly through <tt>pvPortMalloc()</tt>
+   * are not counted.
+   *
+   * @return size_t The number of live allocations.
+   */
+  static inline size_t getAllocationCount() {
+    return allocations;
+  }
+
+ private:
+  static inline volatile size_t allocations = 0;
+};
+
+/**
+ * @class Allocator Heap.hpp <FreeRTOS/Heap.hpp>
+ *
+ * @brief Allocator that satisfies the standard allocator requirements using
+ * the FreeRTOS heap, so STL containers can be used without the C library's
+ * <tt>malloc()</tt>.
+ *
+ * Every instance allocates from the same heap, so all instances compare equal
+ * and memory allocated by one may be freed by any other.
+ *
+ * @tparam T The type of the objects to allocate.  Its alignment may not exceed
+ * <tt>portBYTE_ALIGNMENT</tt>.
+ *
+ * <b>Example Usage</b>
+ * @include Heap/heap.cpp
+ */
+template <class T>
+class Allocator {
+  static_assert(alignof(T) <= portBYTE_ALIGNMENT,
+                "pvPortMalloc() does not align memory for this type.");
+
+ public:
+  using value_type = T;
+
+  Allocator() noexcept = default;
+
+  template <class U>
+  Allocator(const Allocator<U>&) noexcept {}  // NOLINT
+
+  /**
+   * Heap.hpp
+   *
+   * @brief Function that allocates uninitialized storage for objects.
+   *
+   * A failed allocation is handled by Heap::allocateOrFail().
+   *
+   * @param count The number of objects to allocate storage for.
+   * @return T* The allocated storage.
+   */
+  T* allocate(const size_t count) {
+    if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+      return static_cast<T*>(Heap::allocateOrFail(SIZE_MAX));
+    }
+    return static_cast<T*>(Heap::allocateOrFail(count * sizeof(T)));
+  }
+
+  /**
+   * Heap.hpp
+   *
+   * @brief Function that frees storage returned by allocate().
+   *
+   * @param pointer The storage to free.
+   */
+  void deallocate(T* pointer, size_t) noexcept {
+    Heap::free(pointer);
+  }
+};
+
+template <class T, class U>
+inline bool operator==(const Allocator<T>&, const Allocator<U>&) noexcept {
+  return true;
+}
+
+template <class T, class U>
+inline bool operator!=(const Allocator<T>&, const Allocator<U>&) noexcept {
+  return false;
+}
+
+}  // namespace FreeRTOS
+
+/**
+ * @brief Macro that replaces the global <tt>operator new</tt> and
+ * <tt>operator delete</tt> with versions that use the FreeRTOS heap.
+ *
+ * Replacement allocation functions can not be defined in a header, so expand
+ * this macro in exactly one source file of the application.  Allocations with
+ * an alignment above <tt>portBYTE_ALIGNMENT</tt> over allocate and store the
+ * original pointer in front of the aligned block.  Memory allocated before the
+ * scheduler starts is allowed, as <tt>pvPortMalloc()</tt> supports it.
+ *
+ * @code{cpp}
+ * #include <FreeRTOS/Heap.hpp>
+ *
+ * FREERTOS_CPP_DEFINE_GLOBAL_NEW()
+ * @endcode
+ */
+#define FREERTOS_CPP_DEFINE_GLOBAL_NEW()                                     \
+  void* operator new(std::size_t size) {                                     \
+    return FreeRTOS::Heap::allocateOrFail((size == 0) ? 1 : size);           \
+  }                                                                          \
+  void* operator new[](std::size_t size) {                                   \
+    return FreeRTOS::Heap::allocateOrFail((size == 0) ? 1 : size);           \
+  }                                                                          \
+  void* operator new(std::size_t size, const std::nothrow_t&) noexcept {     \
+    return FreeRTOS::Heap::allocate((size == 0) ? 1 : size);                 \
+  }                                                                          \
+  void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {   \
+    return FreeRTOS::Heap::allocate((size == 0) ? 1 : size);                 \
+  }                                                                          \
+  void* operator new(std::size_t size, std::align_val_t alignment) {         \
+    const std::size_t align = static_cast<std::size_t>(alignment);           \
+    if (align <= portBYTE_ALIGNMENT) {                                       \
+      return operator new(size);                                             \
+    }                                                                        \
+    void* raw =                                                              \
+        FreeRTOS::Heap::allocateOrFail(size + align - 1 + sizeof(void*));    \
+    if (raw == NULL) {                                                       \
+      return NULL;                                                           \
+    }                                                                        \
+    const std::uintptr_t aligned =                                           \
+        (reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*) + align - 1) & \
+        ~(align - 1);                                                        \
+    reinterpret_cast<void**>(aligned)[-1] = raw;                             \
+    return reinterpret_cast<void*>(aligned);                                 \
+  }                                                                          \
+  void* operator new[](std::size_t size, std::align_val_t alignment) {       \
+    return operator new(size, alignment);                                    \
+  }                                                                          \
+  void operator delete(void* pointer) noexcept {                             \
+    FreeRTOS::Heap::free(pointer);                                           \
+  }                                                                          \
+  void operator delete[](void* pointer) noexcept {                           \
+    FreeRTOS::Heap::free(pointer);                                           \
+  }                                                                          \
+  void operator delete(void* pointer, std::size_t) noexcept {                \
+    FreeRTOS::Heap::free(pointer);                                           \
+  }                                                                          \
+  void operator delete[](void* pointer, std::size_t) noexcept {              \
+    FreeRTOS::Heap::free(pointer);                                           \
+  }                                                                          \
+  void operator delete(void* pointer, std::align_val_t alignment) noexcept { \
+    if (static_cast<std::size_t>(alignment) <= portBYTE_ALIGNMENT) {         \
+      FreeRTOS::Heap::free(pointer);                                         \
+    } else if (pointer != NULL) {                                            \
+      FreeRTOS::Heap::free(static_cast<void**>(pointer)[-1]);                \
+    }                                                                        \
+  }                                                                          \
+  void operator delete[](void* pointer, std::align_val_t alignment) noexcept { \
+    operator delete(pointer, alignment);                                     \
+  }                                                                          \
+  void operator delete(void* pointer, std::size_t,                           \
+                       std::align_val_t alignment) noexcept {                \
+    operator delete(pointer, alignment);                                     \
+  }                                                                          \
+  void operator delete[](void* pointer, std::size_t,                         \
+                         std::align_val_t alignment) noexcept {              \
+    operator delete(pointer, alignment);                                     \
+  }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+#endif  // FREERTOS_HEAP_HPP
@@ -0,0 +1,348 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_HEAPMONITOR_HPP
+#define FREERTOS_HEAPMONITOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1) && \
+    (!defined(configFRTOS_MEMORY_SCHEME) || \
+     (configFRTOS_MEMORY_SCHEME == 4) || (configFRTOS_MEMORY_SCHEME == 5))
+
+namespace FreeRTOS {
+
+/**
+ * @brief The state of the FreeRTOS heap as reported by
+ * FreeRTOS::HeapMonitor.  Sizes are in bytes.
+ */
+struct HeapStatistics {
+  /**
+   * @brief The total number of free bytes.
+   */
+  size_t freeSize;
+
+  /**
+   * @brief The size of the largest free block, which is the largest
+   * allocation that can succeed.
+   */
+  size_t largestFreeBlock;
+
+  /**
+   * @brief The size of the smallest free block.
+   */
+  size_t smallestFreeBlock;
+
+  /**
+   * @brief The number of free blocks.
+   */
+  size_t freeBlocks;
+
+  /**
+   * @brief The lowest number of free bytes since the system booted.
+   */
+  size_t minimumEverFree;
+
+  /**
+   * @brief The number of calls to <tt>pvPortMalloc()</tt> that succeeded.
+   */
+  size_t allocations;
+
+  /**
+   * @brief The number of calls to <tt>vPortFree()</tt> that freed a block.
+   */
+  size_t frees;
+
+  /**
+   * @brief How much of the free memory is outside the largest free block, in
+   * parts per thousand.  0 means that all of the free memory is one block,
+   * and values near 1000 mean that it is split into many small blocks.
+   */
+  uint32_t fragmentation;
+};
+
+/**
+ * @class HeapMonitor HeapMonitor.hpp <FreeRTOS/HeapMonitor.hpp>
+ *
+ * @brief Class that samples the statistics of the heap_4 or heap_5 heap and
+ * raises alarms before an allocation fails.
+ *
+ * sample() calls <tt>vPortGetHeapStats()</tt> and should be called at a fixed
+ * interval, for example from a low priority task or the callback of a
+ * FreeRTOS::Timer.  When the free size or the largest free block falls below
+ * its threshold, or the fragmentation rises above its threshold, the callback
+ * is called once with the alarm and the sample.  An alarm is raised again
+ * only after a sample in which its condition has cleared.
+ *
+ * The monitor also keeps the lowest largest free block and the highest
+ * fragmentation seen since it was created or reset, which together with
+ * minimumEverFree are the figures worth reporting in telemetry.  The largest
+ * free block is what decides whether the constructor of a dynamically
+ * allocated FreeRTOS object succeeds.
+ *
+ * <tt>vPortGetHeapStats()</tt> walks the free list with the scheduler
+ * suspended, so sample() takes time proportional to the number of free
+ * blocks and must not be called from an interrupt.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be defined as 1, and heap_4 or heap_5
+ * must be used, for this class to be available.
+ *
+ * <b>Example Usage</b>
+ * @include HeapMonitor/heapMonitor.cpp
+ */
+class HeapMonitor {
+ public:
+  /**
+   * @brief The conditions that the monitor raises alarms for.
+   */
+  enum class Alarm {
+    LowFreeSize,        /**< The free size is below its threshold. */
+    LowLargestBlock,    /**< The largest free block is below its threshold. */
+    HighFragmentation,  /**< The fragmentation is above its threshold. */
+  };
+
+  /**
+   * @brief Function called when an alarm is raised.  It is called from the
+   * context that called sample().
+   */
+  using Callback = void (*)(Alarm alarm, const HeapStatistics& statistics);
+
+  /**
+   * HeapMonitor.hpp
+   *
+   * @brief Construct a new HeapMonitor object.
+   *
+   * @param minimumFreeSize The free size, in bytes, below which the
+   * LowFreeSize alarm is raised.
+   * @param minimumLargestBlock The size, in bytes, of the largest free block
+   * below which the LowLargestBlock alarm is raised.  Set it to the size of
+   * the largest object the application creates at run time.
+   * @param maximumFragmentation The fragmentation, in parts per thousand,
+   * above which the HighFragmentation alarm is raised.
+   * @param callback Function called when an alarm is raised, or nullptr.
+   */
+  explicit HeapMonitor(const size_t minimumFreeSize = 0,
+                       const size_t minimumLargestBlock = 0,
+                       const uint32_t maximumFragmentation = 1000,
+                       const Callback callback = nullptr)
+      : minimumFreeSize(minimumFreeSize),
+        minimumLargestBlock(minimumLargestBlock),
+        maximumFragmentation(maximumFragmentation),
+        callback(callback) {}
+  ~HeapMonitor() = default;
+
+  HeapMonitor(const HeapMonitor&) = delete;
+  HeapMonitor& operator=(const HeapMonitor&) = delete;
+
+  /**
+   * HeapMonitor.hpp
+   *
+   * @brief Function that calls <tt>void vPortGetHeapStats( HeapStats_t
+   * *pxHeapStats )</tt> and returns the result without recording it.
+   *
+   * @see <https://www.freertos.org/a00111.html>
+   *
+   * @return HeapStatistics The current state of the heap.
+   */
+  static HeapStatistics read() {
+    HeapStats_t stats;
+    vPortGetHeapStats(&stats);
+
+    HeapStatistics statistics;
+    statistics.freeSize = stats.xAvailableHeapSpaceInBytes;
+    statistics.largestFreeBlock = stats.xSizeOfLargestFreeBlockInBytes;
+    statistics.smallestFreeBlock = stats.xSizeOfSmallestFreeBlockInBytes;
+    statistics.freeBlocks = stats.xNumberOfFreeBlocks;
+    statistics.minimumEverFree = stats.xMinimumEverFreeBytesRemaining;
+    statistics.allocations = stats.xNumberOfSuccessfulAllocations;
+    statistics.frees = stats.xNumberOfSuccessfulFrees;
+    statistics.fragmentation =
+        toFragmentation(statistics.largestFreeBlock, statistics.freeSize);
+    return statistics;
+  }
+
+  /**
+   * HeapMonitor.hpp
+   *
+   * @brief Function that reads the heap statistics, records them, and raises
+   * any new alarms.
+   *
+   * This function must not be called from more than one task at the same
+   * time.
+   */
+  void sample() {
+    const HeapStatistics current = read();
+
+    taskENTER_CRITICAL();
+    latest = current;
+    samples++;
+    if (current.largestFreeBlock < lowestLargestBlock) {
+      lowestLargestBlock = current.largestFreeBlock;
+    }
+    if (current.fragmentation > peakFragmentation) {
+      peakFragmentation = current.fragmentation;
+    }
+    taskEXIT_CRITICAL();
+
+    check(Alarm::LowFreeSize, current.freeSize < minimumFreeSize, current);
+    check(Alarm::LowLargestBlock,
+          current.largestFreeBlock < minimumLargestBlock, current);
+    check(Alarm::HighFragmentation,
+          current.fragmentation > maximumFragmentation, current);
+  }
+
+  /**
+   * HeapMonitor.hpp
+   *
+   * @brief Function that returns the statistics recorded by the last call to
+   * sample().
+   *
+   * @return HeapStatistics The last sample, or all zeros if sample() has not
+   * been called.
+   */
+  HeapStatistics getStatistics() const {
+    taskENTER_CRITICAL();
+    const HeapStatistics copy = latest;
+    taskEXIT_CRITICAL();
+    return copy;
+  }
+
+  /**
+   * HeapMonitor.hpp
+   *
+   * @brief Function that returns the smallest largest free block of any
+   * sample since the monitor was created or reset.
+   *
+   * @return size_t The size in bytes, or SIZE_MAX if sample() has not been
+   * called.
+   */
+  inline size_t getLowestLargestBlock() const {
+    return lowestLargestBlock;
+  }
+
+  /**
+   * HeapMonitor.hpp
+   *
+   * @brief Function that returns the highest fragmentation of any sample since
+   * the monitor was created or reset.
+   *
+   * @return uint32_t The fragmentation in parts per thousand.
+   */
+  inline uint32_t getPeakFragmentation() const {
+    return peakFragmentation;
+  }
+
+  /**
+   * HeapMonitor.hpp
+   *
+   * @brief Function that returns whether an alarm is currently raised.
+   *
+   * @param alarm The alarm.
+   * @return true If the condition of the alarm held at the last sample.
+   * @return false Otherwise.
+   */
+  inline bool isRaised(const Alarm alarm) const {
+    return (raised & mask(alarm)) != 0;
+  }
+
+  /**
+   * HeapMonitor.hpp
+   *
+   * @brief Function that returns the number of calls to sample() since the
+   * monitor was created or reset.
+   *
+   * @return uint32_t The number of samples.
+   */
+  inline uint32_t getSampleCount() const {
+    return samples;
+  }
+
+  /**
+   * HeapMonitor.hpp
+   *
+   * @brief Function that clears the recorded statistics, the peaks and the
+   * raised alarms.
+   */
+  void reset() {
+    taskENTER_CRITICAL();
+    latest = HeapStatistics();
+    lowestLargestBlock = SIZE_MAX;
+    peakFragmentation = 0;
+    samples = 0;
+    raised = 0;
+    taskEXIT_CRITICAL();
+  }
+
+ private:
+  inline static uint32_t mask(const Alarm alarm) {
+    return 1UL << static_cast<uint32_t>(alarm);
+  }
+
+  inline static uint32_t toFragmentation(const size_t largest,
+                                         const size_t free) {
+    if ((free == 0) || (largest >= free)) {
+      return 0;
+    }
+    return static_cast<uint32_t>(
+        (static_cast<uint64_t>(free - largest) * 1000) / free);
+  }
+
+  void check(const Alarm alarm, const bool condition,
+             const HeapStatistics& statistics) {
+    if (!condition) {
+      raised &= ~mask(alarm);
+      return;
+    }
+    if ((raised & mask(alarm)) != 0) {
+      return;
+    }
+    raised |= mask(alarm);
+    if (callback != nullptr) {
+      callback(alarm, statistics);
+    }
+  }
+
+  const size_t minimumFreeSize;
+  const size_t minimumLargestBlock;
+  const uint32_t maximumFragmentation;
+  const Callback callback;
+  HeapStatistics latest = HeapStatistics();
+  size_t lowestLargestBlock = SIZE_MAX;
+  uint32_t peakFragmentation = 0;
+  uint32_t samples = 0;
+  volatile uint32_t raised = 0;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION && configFRTOS_MEMORY_SCHEME */
+
+#endif  // FREERTOS_HEAPMONITOR_HPP
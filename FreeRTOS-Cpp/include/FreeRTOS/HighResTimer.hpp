@@ -0,0 +1,418 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_HIGHRESTIMER_HPP
+#define FREERTOS_HIGHRESTIMER_HPP
+
+#include <FreeRTOS/Task.hpp>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+namespace FreeRTOS {
+
+/**
+ * @class HighResTimer HighResTimer.hpp <FreeRTOS/HighResTimer.hpp>
+ *
+ * @brief Class that implements timers with the resolution of a hardware
+ * counter by multiplexing them over one compare channel.
+ *
+ * FreeRTOS software timers can not expire more often than once per tick.  A
+ * HighResTimer is driven by a free running hardware counter instead, so its
+ * period is in counter ticks, which may be a microsecond or less.  Every
+ * HighResTimer that uses the same Hardware class shares the one compare
+ * channel: the active timers are kept in a list sorted by deadline and the
+ * compare register is always set to the earliest deadline.
+ *
+ * When a timer expires it either calls its callback in the context of the
+ * compare interrupt, or gives a task notification to a task so that the work
+ * is done at task level.
+ *
+ * The port provides the Hardware class, which must have these static member
+ * functions:
+ * - <tt>uint32_t now()</tt> returns the value of a free running 32-bit
+ *   up-counter.
+ * - <tt>void setCompare(uint32_t time)</tt> sets the compare register so that
+ *   the compare interrupt fires when the counter reaches time, and enables the
+ *   compare interrupt.
+ * - <tt>void disableCompare()</tt> disables the compare interrupt.
+ * - <tt>void trigger()</tt> makes the compare interrupt pending immediately.
+ *
+ * The compare interrupt handler must call handleCompareFromISR().  Its
+ * priority must be at or below configMAX_SYSCALL_INTERRUPT_PRIORITY, as the
+ * list of timers is protected by critical sections.
+ *
+ * @warning A HighResTimer must be persistent (not declared on the stack of
+ * another function) while it is active.  The destructor stops the timer.
+ *
+ * @tparam Hardware Class that gives access to the hardware counter and compare
+ * channel.
+ *
+ * <b>Example Usage</b>
+ * @include HighResTimer/highResTimer.cpp
+ */
+template <class Hardware>
+class HighResTimer {
+ public:
+  /**
+   * @brief Function called in the context of the compare interrupt when the
+   * timer expires.
+   *
+   * The callback may use any FromISR function, including those of this and
+   * other HighResTimer objects.
+   */
+  using Callback = void (*)(void* argument, bool& higherPriorityTaskWoken);
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief Construct a new HighResTimer object that calls callback in the
+   * context of the compare interrupt when it expires.  Timers are created in
+   * the dormant state.
+   *
+   * @param callback Function called when the timer expires.
+   * @param argument Value passed to callback.
+   * @param period The period of the timer in counter ticks.  The timer period
+   * must be greater than 0.
+   * @param autoReload If true the timer expires repeatedly with a frequency set
+   * by period, otherwise it is a one-shot timer.
+   */
+  HighResTimer(const Callback callback, void* argument, const uint32_t period,
+               const bool autoReload = false)
+      : callback(callback),
+        argument(argument),
+        period(period),
+        autoReload(autoReload) {
+    configASSERT(period > 0);
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief Construct a new HighResTimer object that gives a task notification
+   * to task when it expires, so that the timer can be handled at task level.
+   * Timers are created in the dormant state.
+   *
+   * @param task The task to notify.
+   * @param index The index of the task notification to give.
+   * @param period The period of the timer in counter ticks.  The timer period
+   * must be greater than 0.
+   * @param autoReload If true the timer expires repeatedly with a frequency set
+   * by period, otherwise it is a one-shot timer.
+   */
+  HighResTimer(const TaskBase& task, const UBaseType_t index,
+               const uint32_t period, const bool autoReload = false)
+      : task(&task), index(index), period(period), autoReload(autoReload) {
+    configASSERT(period > 0);
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief Destroy the HighResTimer object.  The timer is stopped first.
+   */
+  ~HighResTimer() {
+    stop();
+  }
+
+  HighResTimer(const HighResTimer&) = delete;
+  HighResTimer& operator=(const HighResTimer&) = delete;
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief Function that starts the timer, or restarts it if it is already
+   * active, so that it expires period counter ticks from now.
+   */
+  inline void start() {
+    taskENTER_CRITICAL();
+    arm(Hardware::now());
+    taskEXIT_CRITICAL();
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief A version of start() that can be called from an ISR.
+   */
+  inline void startFromISR() {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    arm(Hardware::now());
+    taskEXIT_CRITICAL_FROM_ISR(status);
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief Function that re-starts the timer.  Equivalent to start().
+   */
+  inline void reset() {
+    start();
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief A version of reset() that can be called from an ISR.
+   */
+  inline void resetFromISR() {
+    startFromISR();
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief Function that stops the timer.
+   *
+   * @retval true The timer was active and has been stopped.
+   * @retval false The timer was not active.
+   */
+  inline bool stop() {
+    taskENTER_CRITICAL();
+    const bool result = disarm();
+    taskEXIT_CRITICAL();
+    return result;
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief A version of stop() that can be called from an ISR.
+   *
+   * @retval true The timer was active and has been stopped.
+   * @retval false The timer was not active.
+   */
+  inline bool stopFromISR() {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool result = disarm();
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return result;
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief Function that changes the period of the timer and starts it, so
+   * that it expires newPeriod counter ticks from now.
+   *
+   * @param newPeriod The new period in counter ticks.  The timer period must
+   * be greater than 0.
+   */
+  inline void changePeriod(const uint32_t newPeriod) {
+    configASSERT(newPeriod > 0);
+    taskENTER_CRITICAL();
+    period = newPeriod;
+    arm(Hardware::now());
+    taskEXIT_CRITICAL();
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief A version of changePeriod() that can be called from an ISR.
+   *
+   * @param newPeriod The new period in counter ticks.
+   */
+  inline void changePeriodFromISR(const uint32_t newPeriod) {
+    configASSERT(newPeriod > 0);
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    period = newPeriod;
+    arm(Hardware::now());
+    taskEXIT_CRITICAL_FROM_ISR(status);
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief Function that returns whether the timer is active.
+   *
+   * @retval true The timer is active.
+   * @retval false The timer is dormant.
+   */
+  inline bool isActive() const {
+    return active;
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief Function that returns the period of the timer.
+   *
+   * @return uint32_t The period in counter ticks.
+   */
+  inline uint32_t getPeriod() const {
+    return period;
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief Function that returns the counter value at which the timer will
+   * next expire.  Only meaningful if the timer is active.
+   *
+   * @return uint32_t The deadline in counter ticks.
+   */
+  inline uint32_t getExpiryTime() const {
+    return deadline;
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @brief Function that must be called by the compare interrupt handler.  It
+   * dispatches every timer whose deadline has passed and sets the compare
+   * register to the next deadline.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if a
+   * dispatch unblocked a task with a priority higher than the currently
+   * running task.
+   */
+  static void handleCompareFromISR(bool& higherPriorityTaskWoken) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    for (;;) {
+      HighResTimer* const timer = head;
+      if ((timer == nullptr) || !expired(timer->deadline, Hardware::now())) {
+        break;
+      }
+
+      head = timer->next;
+      timer->next = nullptr;
+      if (timer->autoReload) {
+        // Keep the phase of the timer, even if the interrupt was late.
+        timer->deadline += timer->period;
+        timer->insert();
+      } else {
+        timer->active = false;
+      }
+
+      if (timer->task != nullptr) {
+        timer->task->notifyGiveFromISR(higherPriorityTaskWoken, timer->index);
+      } else {
+        timer->callback(timer->argument, higherPriorityTaskWoken);
+      }
+    }
+    program();
+    taskEXIT_CRITICAL_FROM_ISR(status);
+  }
+
+  /**
+   * HighResTimer.hpp
+   *
+   * @overload
+   */
+  static void handleCompareFromISR() {
+    bool higherPriorityTaskWoken = false;
+    handleCompareFromISR(higherPriorityTaskWoken);
+  }
+
+ private:
+  inline static bool expired(const uint32_t time, const uint32_t now) {
+    return (static_cast<int32_t>(now - time) >= 0);
+  }
+
+  // Sets the compare register to the earliest deadline.  If that deadline has
+  // already passed the interrupt is made pending, as the counter will not match
+  // the compare register again until it wraps.
+  inline static void program() {
+    if (head == nullptr) {
+      Hardware::disableCompare();
+      return;
+    }
+    Hardware::setCompare(head->deadline);
+    if (expired(head->deadline, Hardware::now())) {
+      Hardware::trigger();
+    }
+  }
+
+  // Must be called in a critical section.
+  inline void insert() {
+    HighResTimer** link = &head;
+    while ((*link != nullptr) &&
+           (static_cast<int32_t>((*link)->deadline - deadline) <= 0)) {
+      link = &(*link)->next;
+    }
+    next = *link;
+    *link = this;
+    active = true;
+  }
+
+  // Must be called in a critical section.
+  inline void remove() {
+    for (HighResTimer** link = &head; *link != nullptr;
+         link = &(*link)->next) {
+      if (*link == this) {
+        *link = next;
+        break;
+      }
+    }
+    next = nullptr;
+    active = false;
+  }
+
+  // Must be called in a critical section.
+  inline void arm(const uint32_t now) {
+    const HighResTimer* const previousHead = head;
+    if (active) {
+      remove();
+    }
+    deadline = now + period;
+    insert();
+    if (head != previousHead) {
+      program();
+    }
+  }
+
+  // Must be called in a critical section.
+  inline bool disarm() {
+    if (!active) {
+      return false;
+    }
+    const HighResTimer* const previousHead = head;
+    remove();
+    if (head != previousHead) {
+      program();
+    }
+    return true;
+  }
+
+  static inline HighResTimer* head = nullptr;
+
+  HighResTimer* next = nullptr;
+  const Callback callback = nullptr;
+  void* const argument = nullptr;
+  const TaskBase* const task = nullptr;
+  const UBaseType_t index = 0;
+  uint32_t period;
+  uint32_t deadline = 0;
+  const bool autoReload;
+  bool active = false;
+};
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_HIGHRESTIMER_HPP
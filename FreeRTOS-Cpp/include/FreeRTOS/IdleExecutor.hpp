@@ -0,0 +1,411 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_IDLEEXECUTOR_HPP
+#define FREERTOS_IDLEEXECUTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Expression that reads the clock used to measure the budgets of the
+ * jobs of a FreeRTOS::IdleExecutor.  It defaults to the run time stats counter
+ * when configGENERATE_RUN_TIME_STATS is 1, and to the tick count otherwise.
+ * Define it before including this header to use a cycle counter.
+ */
+#ifndef FREERTOS_CPP_IDLE_EXECUTOR_TIME
+#if (configGENERATE_RUN_TIME_STATS == 1) && \
+    defined(portGET_RUN_TIME_COUNTER_VALUE)
+#define FREERTOS_CPP_IDLE_EXECUTOR_TIME() \
+  static_cast<uint32_t>(portGET_RUN_TIME_COUNTER_VALUE())
+#else
+#define FREERTOS_CPP_IDLE_EXECUTOR_TIME() \
+  static_cast<uint32_t>(xTaskGetTickCount())
+#endif /* configGENERATE_RUN_TIME_STATS */
+#endif /* FREERTOS_CPP_IDLE_EXECUTOR_TIME */
+
+namespace FreeRTOS {
+
+/**
+ * @brief Counters collected by FreeRTOS::IdleExecutor.
+ */
+struct IdleStatistics {
+  /**
+   * @brief The number of times run() found at least one job to work on.
+   */
+  uint32_t slices;
+
+  /**
+   * @brief The total number of steps run.
+   */
+  uint32_t steps;
+
+  /**
+   * @brief The number of jobs that have finished.
+   */
+  uint32_t completed;
+
+  /**
+   * @brief The number of single steps that took longer than the budget of
+   * their job.  A non zero value means a job needs smaller steps.
+   */
+  uint32_t overruns;
+};
+
+/**
+ * @class IdleJob IdleExecutor.hpp <FreeRTOS/IdleExecutor.hpp>
+ *
+ * @brief Class that holds one resumable background job of a
+ * FreeRTOS::IdleExecutor.
+ *
+ * The work is split into short steps.  The step function does the next piece
+ * of work, keeping its progress in the object pointed to by argument, and
+ * returns true once there is nothing left to do.  It must not block.
+ *
+ * @warning An IdleJob must not be destroyed while it is posted.
+ *
+ * <b>Example Usage</b>
+ * @include IdleExecutor/idleExecutor.cpp
+ */
+class IdleJob {
+ public:
+  /**
+   * @brief Function called from the idle task to run one step of the job.  It
+   * returns true when the job has finished.
+   */
+  using Step = bool (*)(void* argument);
+
+  /**
+   * IdleExecutor.hpp
+   *
+   * @brief Construct a new IdleJob object.
+   *
+   * @param step Function that runs one step of the job.
+   * @param argument Value passed to step.
+   * @param budget The time the job may use in each idle slice, in units of
+   * FREERTOS_CPP_IDLE_EXECUTOR_TIME().  At least one step is run in each
+   * slice, so 0 runs exactly one step.
+   */
+  explicit IdleJob(const Step step, void* argument = nullptr,
+                   const uint32_t budget = 0)
+      : step(step), argument(argument), budget(budget) {}
+  ~IdleJob() = default;
+
+  IdleJob(const IdleJob&) = delete;
+  IdleJob& operator=(const IdleJob&) = delete;
+
+  /**
+   * IdleExecutor.hpp
+   *
+   * @brief Function that returns whether the job is waiting for, or in the
+   * middle of, an idle slice.
+   *
+   * @retval true The job is posted and has not finished.
+   * @retval false The job has finished, was cancelled or was never posted.
+   */
+  inline bool isPending() const {
+    return state != State::Idle;
+  }
+
+ private:
+  friend class IdleExecutor;
+
+  enum class State : uint8_t { Idle, Queued, Running, Cancelled };
+
+  IdleJob* next = nullptr;
+  volatile State state = State::Idle;
+  const Step step;
+  void* const argument;
+  const uint32_t budget;
+};
+
+/**
+ * @class IdleExecutor IdleExecutor.hpp <FreeRTOS/IdleExecutor.hpp>
+ *
+ * @brief Class that runs resumable background jobs from the idle hook, so that
+ * they only use time no other task wants.
+ *
+ * Flash wear levelling, log compaction and memory scrubbing can take a long
+ * time, but nothing waits for them.  Each becomes a FreeRTOS::IdleJob that is
+ * posted to the executor, and vApplicationIdleHook() calls run().  Every call
+ * is one idle slice: the jobs take turns in the order they were posted, and
+ * each runs steps until it finishes or its budget for the slice is used up.
+ * Unfinished jobs go back to the end of the queue for the next slice.  run()
+ * returns after one pass over the queue so that the idle task can still free
+ * the memory of deleted tasks and enter tickless idle.
+ *
+ * With configUSE_PREEMPTION set to 1 the kernel switches away from the idle
+ * task as soon as any other task becomes ready, in the middle of a step if
+ * need be, and the step continues the next time the processor is idle.  The
+ * time spent in other tasks counts against the budget of the job, so run()
+ * returns soon after the idle task is resumed.  With a cooperative scheduler
+ * run() yields after every step instead, which is where steps have to be
+ * short.
+ *
+ * Jobs can be posted and cancelled from any task, and posted from interrupts.
+ * The queue is updated inside short critical sections.
+ *
+ * @note Set configUSE_IDLE_HOOK to 1 and expand
+ * FREERTOS_CPP_DEFINE_IDLE_EXECUTOR_HOOK() in one source file, or call run()
+ * from an existing idle hook.  When configUSE_TICKLESS_IDLE is used, the
+ * sleep processing can check hasWork() to stay awake while work is pending.
+ *
+ * @warning Every step runs on the stack of the idle task, so
+ * configMINIMAL_STACK_SIZE must cover the deepest step.  A step must never
+ * block.
+ *
+ * <b>Example Usage</b>
+ * @include IdleExecutor/idleExecutor.cpp
+ */
+class IdleExecutor {
+ public:
+  IdleExecutor() = default;
+  ~IdleExecutor() = default;
+
+  IdleExecutor(const IdleExecutor&) = delete;
+  IdleExecutor& operator=(const IdleExecutor&) = delete;
+
+  /**
+   * IdleExecutor.hpp
+   *
+   * @brief Function that adds a job to the end of the queue.
+   *
+   * @param job The job to post.
+   * @retval true The job was posted.
+   * @retval false The job is already pending.
+   */
+  bool post(IdleJob& job) {
+    taskENTER_CRITICAL();
+    const bool posted = link(job);
+    taskEXIT_CRITICAL();
+    return posted;
+  }
+
+  /**
+   * IdleExecutor.hpp
+   *
+   * @brief Function that adds a job to the end of the queue from an interrupt.
+   *
+   * @param job The job to post.
+   * @retval true The job was posted.
+   * @retval false The job is already pending.
+   */
+  bool postFromISR(IdleJob& job) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool posted = link(job);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return posted;
+  }
+
+  /**
+   * IdleExecutor.hpp
+   *
+   * @brief Function that removes a job from the queue.  A job that is in the
+   * middle of its slice finishes its current step and is then dropped.
+   *
+   * @param job The job to cancel.
+   * @retval true The job was pending and will not run again.
+   * @retval false The job was not pending.
+   */
+  bool cancel(IdleJob& job) {
+    bool cancelled = false;
+    taskENTER_CRITICAL();
+    if (job.state == IdleJob::State::Queued) {
+      unlink(job);
+      job.state = IdleJob::State::Idle;
+      cancelled = true;
+    } else if (job.state == IdleJob::State::Running) {
+      job.state = IdleJob::State::Cancelled;
+      cancelled = true;
+    }
+    taskEXIT_CRITICAL();
+    return cancelled;
+  }
+
+  /**
+   * IdleExecutor.hpp
+   *
+   * @brief Function that returns whether any job is queued.
+   *
+   * @retval true At least one job is waiting for an idle slice.
+   * @retval false The queue is empty.
+   */
+  inline bool hasWork() const {
+    return head != nullptr;
+  }
+
+  /**
+   * IdleExecutor.hpp
+   *
+   * @brief Function that runs one idle slice.  Call it from
+   * vApplicationIdleHook().
+   */
+  void run() {
+    // Only the jobs that are queued now are run, so that a job posted during
+    // the slice waits for the next one and the pass always ends.
+    taskENTER_CRITICAL();
+    size_t remaining = queued;
+    taskEXIT_CRITICAL();
+    if (remaining == 0) {
+      return;
+    }
+    statistics.slices++;
+
+    for (; remaining > 0; remaining--) {
+      IdleJob* job = takeFirst();
+      if (job == nullptr) {
+        return;
+      }
+      runSlice(*job);
+    }
+  }
+
+  /**
+   * IdleExecutor.hpp
+   *
+   * @brief Function that returns a copy of the counters.
+   *
+   * @return IdleStatistics The counters.
+   */
+  IdleStatistics getStatistics() const {
+    taskENTER_CRITICAL();
+    const IdleStatistics copy = statistics;
+    taskEXIT_CRITICAL();
+    return copy;
+  }
+
+ private:
+  IdleJob* head = nullptr;
+  IdleJob* tail = nullptr;
+  size_t queued = 0;
+  IdleStatistics statistics = {0, 0, 0, 0};
+
+  bool link(IdleJob& job) {
+    if (job.state != IdleJob::State::Idle) {
+      return false;
+    }
+    append(job);
+    return true;
+  }
+
+  void append(IdleJob& job) {
+    job.state = IdleJob::State::Queued;
+    job.next = nullptr;
+    if (tail == nullptr) {
+      head = &job;
+    } else {
+      tail->next = &job;
+    }
+    tail = &job;
+    queued++;
+  }
+
+  void unlink(IdleJob& job) {
+    IdleJob* previous = nullptr;
+    for (IdleJob* node = head; node != nullptr; node = node->next) {
+      if (node == &job) {
+        if (previous == nullptr) {
+          head = node->next;
+        } else {
+          previous->next = node->next;
+        }
+        if (tail == node) {
+          tail = previous;
+        }
+        queued--;
+        return;
+      }
+      previous = node;
+    }
+  }
+
+  IdleJob* takeFirst() {
+    taskENTER_CRITICAL();
+    IdleJob* job = head;
+    if (job != nullptr) {
+      unlink(*job);
+      job->state = IdleJob::State::Running;
+    }
+    taskEXIT_CRITICAL();
+    return job;
+  }
+
+  void runSlice(IdleJob& job) {
+    const uint32_t start = FREERTOS_CPP_IDLE_EXECUTOR_TIME();
+    uint32_t steps = 0;
+    bool finished = false;
+
+    uint32_t elapsed = 0;
+    for (;;) {
+      const uint32_t before = elapsed;
+      finished = job.step(job.argument);
+      steps++;
+      elapsed = FREERTOS_CPP_IDLE_EXECUTOR_TIME() - start;
+      if ((elapsed - before) > job.budget) {
+        statistics.overruns++;
+      }
+#if (configUSE_PREEMPTION == 0)
+      taskYIELD();
+#endif /* configUSE_PREEMPTION */
+      if (finished || (elapsed >= job.budget) ||
+          (job.state != IdleJob::State::Running)) {
+        break;
+      }
+    }
+
+    taskENTER_CRITICAL();
+    statistics.steps += steps;
+    if (finished) {
+      statistics.completed++;
+    }
+    if (finished || (job.state == IdleJob::State::Cancelled)) {
+      job.state = IdleJob::State::Idle;
+    } else {
+      append(job);
+    }
+    taskEXIT_CRITICAL();
+  }
+};
+
+}  // namespace FreeRTOS
+
+/**
+ * @brief Macro that defines vApplicationIdleHook() to run one idle slice of a
+ * FreeRTOS::IdleExecutor.  Expand it in exactly one source file, with
+ * configUSE_IDLE_HOOK set to 1.
+ *
+ * @param executor The FreeRTOS::IdleExecutor object to run.
+ */
+#define FREERTOS_CPP_DEFINE_IDLE_EXECUTOR_HOOK(executor) \
+  extern "C" void vApplicationIdleHook(void) {           \
+    (executor).run();                                    \
+  }
+
+#endif  // FREERTOS_IDLEEXECUTOR_HPP
@@ -0,0 +1,278 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_INSTRUMENTATION_HPP
+#define FREERTOS_INSTRUMENTATION_HPP
+
+#include <cstdint>
+#include <utility>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Set FREERTOS_CPP_INSTRUMENTATION to 1 in FreeRTOSConfig.h (or on the
+ * compiler command line) to have the queue, semaphore, mutex, event group,
+ * timer, stream buffer and message buffer wrappers call the hooks of
+ * FreeRTOS::ApplicationInstrumentation, which the application defines.  When
+ * it is 0 (the default) FreeRTOS::NoInstrumentation is used and the wrappers
+ * call straight through to the kernel.
+ */
+#ifndef FREERTOS_CPP_INSTRUMENTATION
+#define FREERTOS_CPP_INSTRUMENTATION 0
+#endif
+
+/**
+ * @brief Expression that reads the free running counter used to timestamp
+ * instrumentation hooks.  It defaults to the run time stats counter.
+ */
+#if (FREERTOS_CPP_INSTRUMENTATION == 1) && \
+    !defined(FREERTOS_CPP_INSTRUMENTATION_TIMESTAMP)
+#define FREERTOS_CPP_INSTRUMENTATION_TIMESTAMP() \
+  static_cast<uint32_t>(portGET_RUN_TIME_COUNTER_VALUE())
+#endif
+
+namespace FreeRTOS {
+
+/**
+ * @brief The wrapper call that an instrumentation hook is reporting.
+ */
+enum class InstrumentedCall : uint8_t {
+  QueueSend,
+  QueueReceive,
+  QueuePeek,
+  SemaphoreTake,
+  SemaphoreGive,
+  MutexLock,
+  MutexUnlock,
+  EventGroupWait,
+  EventGroupSet,
+  EventGroupSync,
+  TimerCommand,
+  StreamBufferSend,
+  StreamBufferReceive,
+  MessageBufferSend,
+  MessageBufferReceive,
+};
+
+/**
+ * @class NoInstrumentation Instrumentation.hpp <FreeRTOS/Instrumentation.hpp>
+ *
+ * @brief Instrumentation policy that does nothing.  It is used unless
+ * FREERTOS_CPP_INSTRUMENTATION is 1, and every wrapper then compiles to the
+ * C API call it wraps.
+ */
+struct NoInstrumentation {
+  static inline void onBlockBegin(const InstrumentedCall, const void*,
+                                  const TickType_t, const uint32_t) {}
+  static inline void onBlockEnd(const InstrumentedCall, const void*,
+                                const uint32_t, const uint32_t) {}
+  static inline void onFail(const InstrumentedCall, const void*,
+                            const uint32_t) {}
+  static inline void onIsrCall(const InstrumentedCall, const void*,
+                               const bool, const uint32_t) {}
+};
+
+/**
+ * @class ApplicationInstrumentation Instrumentation.hpp
+ * <FreeRTOS/Instrumentation.hpp>
+ *
+ * @brief Instrumentation policy whose hooks are defined by the application.
+ * It is used when FREERTOS_CPP_INSTRUMENTATION is 1.
+ *
+ * Every hook receives the call being made, the handle of the kernel object and
+ * one or more FREERTOS_CPP_INSTRUMENTATION_TIMESTAMP() values.  Hooks are
+ * called from the context of the caller, so a hook called for a task level
+ * function may block the task only briefly, and onIsrCall() runs inside the
+ * interrupt.  The hooks must not call any of the instrumented wrappers.
+ *
+ * <b>Example Usage</b>
+ * @include Instrumentation/instrumentation.cpp
+ */
+struct ApplicationInstrumentation {
+  /**
+   * Instrumentation.hpp
+   *
+   * @brief Hook called before a task level call that may block, which is any
+   * call with a non zero timeout.
+   *
+   * @param call The call that may block.
+   * @param object The handle of the kernel object.
+   * @param ticksToWait The timeout passed to the call.
+   * @param timestamp The time before the call.
+   */
+  static void onBlockBegin(InstrumentedCall call, const void* object,
+                           TickType_t ticksToWait, uint32_t timestamp);
+
+  /**
+   * Instrumentation.hpp
+   *
+   * @brief Hook called when a call that onBlockBegin() was called for
+   * returns, whether or not it succeeded.
+   *
+   * @param call The call that returned.
+   * @param object The handle of the kernel object.
+   * @param begin The timestamp passed to onBlockBegin().
+   * @param end The time after the call.
+   */
+  static void onBlockEnd(InstrumentedCall call, const void* object,
+                         uint32_t begin, uint32_t end);
+
+  /**
+   * Instrumentation.hpp
+   *
+   * @brief Hook called when a task level call fails, for example because its
+   * timeout expired or the queue was full.
+   *
+   * @param call The call that failed.
+   * @param object The handle of the kernel object.
+   * @param timestamp The time after the call.
+   */
+  static void onFail(InstrumentedCall call, const void* object,
+                     uint32_t timestamp);
+
+  /**
+   * Instrumentation.hpp
+   *
+   * @brief Hook called after every interrupt safe call.
+   *
+   * @param call The call that was made.
+   * @param object The handle of the kernel object.
+   * @param succeeded Whether the call succeeded.
+   * @param timestamp The time after the call.
+   */
+  static void onIsrCall(InstrumentedCall call, const void* object,
+                        bool succeeded, uint32_t timestamp);
+};
+
+#if (FREERTOS_CPP_INSTRUMENTATION == 1)
+using InstrumentationPolicy = ApplicationInstrumentation;
+#else
+using InstrumentationPolicy = NoInstrumentation;
+#endif /* FREERTOS_CPP_INSTRUMENTATION */
+
+/**
+ * @class Instrument Instrumentation.hpp <FreeRTOS/Instrumentation.hpp>
+ *
+ * @brief Class used by the wrappers to call the hooks of the selected
+ * instrumentation policy around a C API call.
+ *
+ * @note This class is not intended to be used by the application.
+ */
+struct Instrument {
+  /**
+   * Instrumentation.hpp
+   *
+   * @brief Function that makes a task level call and reports it.
+   *
+   * @param call The call being made.
+   * @param object The handle of the kernel object.
+   * @param ticksToWait The timeout passed to the call.
+   * @param function Function that makes the C API call.
+   * @param succeeded Function that returns whether the result of function
+   * means that the call succeeded.
+   * @return The result of function.
+   */
+  template <class Function, class Succeeded>
+  static inline auto call(const InstrumentedCall call, const void* object,
+                          const TickType_t ticksToWait, Function&& function,
+                          Succeeded&& succeeded) {
+#if (FREERTOS_CPP_INSTRUMENTATION == 1)
+    const uint32_t begin = FREERTOS_CPP_INSTRUMENTATION_TIMESTAMP();
+    if (ticksToWait != 0) {
+      InstrumentationPolicy::onBlockBegin(call, object, ticksToWait, begin);
+    }
+    const auto result = std::forward<Function>(function)();
+    const uint32_t end = FREERTOS_CPP_INSTRUMENTATION_TIMESTAMP();
+    if (ticksToWait != 0) {
+      InstrumentationPolicy::onBlockEnd(call, object, begin, end);
+    }
+    if (!std::forward<Succeeded>(succeeded)(result)) {
+      InstrumentationPolicy::onFail(call, object, end);
+    }
+    return result;
+#else
+    static_cast<void>(call);
+    static_cast<void>(object);
+    static_cast<void>(ticksToWait);
+    static_cast<void>(succeeded);
+    return std::forward<Function>(function)();
+#endif /* FREERTOS_CPP_INSTRUMENTATION */
+  }
+
+  /**
+   * Instrumentation.hpp
+   *
+   * @brief Function that makes a task level call and reports it.  The call
+   * failed if its result converts to false.
+   *
+   * @param call The call being made.
+   * @param object The handle of the kernel object.
+   * @param ticksToWait The timeout passed to the call.
+   * @param function Function that makes the C API call.
+   * @return The result of function.
+   */
+  template <class Function>
+  static inline auto call(const InstrumentedCall call, const void* object,
+                          const TickType_t ticksToWait, Function&& function) {
+    return Instrument::call(call, object, ticksToWait,
+                            std::forward<Function>(function),
+                            [](const auto& result) {
+                              return static_cast<bool>(result);
+                            });
+  }
+
+  /**
+   * Instrumentation.hpp
+   *
+   * @brief Function that makes an interrupt safe call and reports it.  The
+   * call failed if its result converts to false.
+   *
+   * @param call The call being made.
+   * @param object The handle of the kernel object.
+   * @param function Function that makes the C API call.
+   * @return The result of function.
+   */
+  template <class Function>
+  static inline auto callFromISR(const InstrumentedCall call,
+                                 const void* object, Function&& function) {
+#if (FREERTOS_CPP_INSTRUMENTATION == 1)
+    const auto result = std::forward<Function>(function)();
+    InstrumentationPolicy::onIsrCall(call, object, static_cast<bool>(result),
+                                     FREERTOS_CPP_INSTRUMENTATION_TIMESTAMP());
+    return result;
+#else
+    static_cast<void>(call);
+    static_cast<void>(object);
+    return std::forward<Function>(function)();
+#endif /* FREERTOS_CPP_INSTRUMENTATION */
+  }
+};
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_INSTRUMENTATION_HPP
@@ -0,0 +1,303 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_INTERCORECHANNEL_HPP
+#define FREERTOS_INTERCORECHANNEL_HPP
+
+#include <FreeRTOS/DeferCreate.hpp>
+#include <FreeRTOS/MessageBuffer.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "message_buffer.h"
+
+/**
+ * @brief Statement that writes the data cache lines covering size bytes at
+ * address back to memory, so that the other core can see them.  It defaults
+ * to nothing, which is right when the channel is in non-cacheable memory.
+ */
+#ifndef FREERTOS_CPP_INTER_CORE_CACHE_CLEAN
+#define FREERTOS_CPP_INTER_CORE_CACHE_CLEAN(address, size)
+#endif
+
+/**
+ * @brief Statement that discards the data cache lines covering size bytes at
+ * address, so that the next read sees what the other core wrote.  It defaults
+ * to nothing.
+ */
+#ifndef FREERTOS_CPP_INTER_CORE_CACHE_INVALIDATE
+#define FREERTOS_CPP_INTER_CORE_CACHE_INVALIDATE(address, size)
+#endif
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1) && \
+    (configUSE_SB_COMPLETED_CALLBACK == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class InterCoreChannel InterCoreChannel.hpp <FreeRTOS/InterCoreChannel.hpp>
+ *
+ * @brief Class that carries messages from a task or interrupt on one core to
+ * a task on another core of an asymmetric multiprocessing (AMP) system, in
+ * which each core runs its own instance of the kernel.
+ *
+ * The whole object, including the message buffer control block and storage,
+ * lives in memory shared by both cores.  Declare it in both images, in a
+ * section that both linker scripts place at the same address and that neither
+ * image initializes, for example a NOLOAD section.  The sending core calls
+ * create() once, which creates the message buffer and then marks the channel
+ * ready.  The receiving core waits for isReady() before it uses the channel.
+ *
+ * The sender never blocks, so the kernel on the receiving core never needs to
+ * wake a task of the sending core.  After each message is written, send()
+ * cleans the cache, and then calls the signal function given to create().
+ * That function raises the inter-core interrupt, for example by writing to a
+ * mailbox peripheral.  The message buffer's send completed callback
+ * replaces the default one, which would try to wake the receiver through the
+ * kernel of the wrong core.  The handler of the inter-core interrupt on the
+ * receiving core calls handleInterrupt(), which wakes the receiving task
+ * through <tt>xMessageBufferSendCompletedFromISR()</tt>.
+ *
+ * Messages are copied into and out of the shared storage once each, as with
+ * any message buffer.  The control block is written by both cores, so the
+ * shared section should be non-cacheable, for example through an MPU region.
+ * Otherwise FREERTOS_CPP_INTER_CORE_CACHE_CLEAN and
+ * FREERTOS_CPP_INTER_CORE_CACHE_INVALIDATE must be defined, and the cache
+ * must not write back lines that the other core is writing, which in practice
+ * means a write-through cache.
+ *
+ * configSUPPORT_STATIC_ALLOCATION and configUSE_SB_COMPLETED_CALLBACK must
+ * both be defined as 1, on both cores, for this class to be available.
+ *
+ * @tparam N The size, in bytes, of the storage for the messages.
+ * @tparam Alignment The alignment, in bytes, of the storage.  Set it to the
+ * data cache line size.
+ *
+ * <b>Example Usage</b>
+ * @include InterCoreChannel/interCoreChannel.cpp
+ */
+template <size_t N, size_t Alignment = 32>
+class InterCoreChannel {
+ public:
+  /**
+   * @brief Function that raises the inter-core interrupt on the receiving
+   * core.  It is called on the sending core, from a task or an interrupt.
+   */
+  using Signal = void (*)();
+
+  /**
+   * InterCoreChannel.hpp
+   *
+   * @brief Construct a new InterCoreChannel object without creating the
+   * message buffer.  The constructor is constexpr and writes nothing, so the
+   * object needs no initialization in either image.
+   */
+  constexpr InterCoreChannel() : buffer(deferCreate) {}
+  ~InterCoreChannel() = default;
+
+  InterCoreChannel(const InterCoreChannel&) = delete;
+  InterCoreChannel& operator=(const InterCoreChannel&) = delete;
+
+  /**
+   * InterCoreChannel.hpp
+   *
+   * @brief Function that creates the message buffer and marks the channel
+   * ready.  It must be called once, by the sending core, before the receiving
+   * core uses the channel.
+   *
+   * @param signal Function that raises the inter-core interrupt.
+   * @retval true If the message buffer was created.
+   * @retval false Otherwise.
+   */
+  bool create(const Signal signal) {
+    configASSERT(signal != nullptr);
+    ready.store(0, std::memory_order_relaxed);
+    this->signal = signal;
+    if (!buffer.create(sendCompleted, NULL)) {
+      return false;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    FREERTOS_CPP_INTER_CORE_CACHE_CLEAN(this, sizeof(*this));
+    ready.store(readyMarker, std::memory_order_release);
+    FREERTOS_CPP_INTER_CORE_CACHE_CLEAN(&ready, sizeof(ready));
+    return true;
+  }
+
+  /**
+   * InterCoreChannel.hpp
+   *
+   * @brief Function that returns whether the sending core has created the
+   * channel.
+   *
+   * @retval true If the channel can be used.
+   * @retval false Otherwise.
+   */
+  bool isReady() const {
+    FREERTOS_CPP_INTER_CORE_CACHE_INVALIDATE(&ready, sizeof(ready));
+    if (ready.load(std::memory_order_acquire) != readyMarker) {
+      return false;
+    }
+    FREERTOS_CPP_INTER_CORE_CACHE_INVALIDATE(this, sizeof(*this));
+    return true;
+  }
+
+  /**
+   * InterCoreChannel.hpp
+   *
+   * @brief Function that sends a message to the other core without blocking.
+   * It must only be called on the sending core.
+   *
+   * @param data Pointer to the message.
+   * @param length The length of the message in bytes.
+   * @return size_t The number of bytes sent, which is length, or 0 if there
+   * was not enough space for the message.
+   */
+  size_t send(const void* data, const size_t length) const {
+    sync();
+    const size_t sent = buffer.send(data, length, 0);
+    publish(sent);
+    return sent;
+  }
+
+  /**
+   * InterCoreChannel.hpp
+   *
+   * @brief Function that sends a message to the other core from an interrupt.
+   * It must only be called on the sending core.
+   *
+   * @param data Pointer to the message.
+   * @param length The length of the message in bytes.
+   * @return size_t The number of bytes sent, which is length, or 0 if there
+   * was not enough space for the message.
+   */
+  size_t sendFromISR(const void* data, const size_t length) const {
+    sync();
+    const size_t sent = buffer.sendFromISR(data, length);
+    publish(sent);
+    return sent;
+  }
+
+  /**
+   * InterCoreChannel.hpp
+   *
+   * @brief Function that receives a message from the other core.  It must
+   * only be called by the receiving task on the receiving core.
+   *
+   * @param data Pointer to the buffer the message is copied into.
+   * @param length The length of the buffer in bytes.
+   * @param ticksToWait The maximum amount of time the task should block
+   * waiting for a message.
+   * @return size_t The length of the received message, or 0 if no message
+   * was received.
+   */
+  size_t receive(void* data, const size_t length,
+                 const TickType_t ticksToWait = portMAX_DELAY) const {
+    sync();
+    const size_t received = buffer.receive(data, length, ticksToWait);
+    if (received > 0) {
+      std::atomic_thread_fence(std::memory_order_release);
+      FREERTOS_CPP_INTER_CORE_CACHE_CLEAN(this, sizeof(*this));
+    }
+    return received;
+  }
+
+  /**
+   * InterCoreChannel.hpp
+   *
+   * @brief Function that wakes the receiving task.  Call it from the handler
+   * of the inter-core interrupt on the receiving core, after clearing the
+   * interrupt.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if the
+   * receiving task was unblocked and has a priority higher than the currently
+   * running task.
+   */
+  void handleInterrupt(bool& higherPriorityTaskWoken) const {
+    sync();
+    BaseType_t taskWoken = pdFALSE;
+    xMessageBufferSendCompletedFromISR(buffer.handle, &taskWoken);
+    if (taskWoken == pdTRUE) {
+      higherPriorityTaskWoken = true;
+    }
+  }
+
+  /**
+   * InterCoreChannel.hpp
+   *
+   * @overload
+   */
+  void handleInterrupt() const {
+    sync();
+    xMessageBufferSendCompletedFromISR(buffer.handle, NULL);
+  }
+
+  /**
+   * InterCoreChannel.hpp
+   *
+   * @brief Function that returns the number of bytes that can be sent
+   * without the send failing.
+   *
+   * @return size_t The free space, which includes the length word of the next
+   * message.
+   */
+  size_t spacesAvailable() const {
+    sync();
+    return buffer.spacesAvailable();
+  }
+
+ private:
+  static constexpr uint32_t readyMarker = 0x49434331UL;
+
+  // Replaces sbSEND_COMPLETED(), which would notify the receiving task
+  // through the kernel of this core.  send() signals the other core instead.
+  static void sendCompleted(StreamBufferHandle_t, BaseType_t, BaseType_t*) {}
+
+  inline void sync() const {
+    FREERTOS_CPP_INTER_CORE_CACHE_INVALIDATE(this, sizeof(*this));
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+
+  inline void publish(const size_t sent) const {
+    if (sent > 0) {
+      std::atomic_thread_fence(std::memory_order_release);
+      FREERTOS_CPP_INTER_CORE_CACHE_CLEAN(this, sizeof(*this));
+      signal();
+    }
+  }
+
+  StaticMessageBuffer<N, Alignment> buffer;
+  Signal signal = nullptr;
+  std::atomic<uint32_t> ready = 0;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION && configUSE_SB_COMPLETED_CALLBACK */
+
+#endif  // FREERTOS_INTERCORECHANNEL_HPP
@@ -0,0 +1,111 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_ISRCONTEXT_HPP
+#define FREERTOS_ISRCONTEXT_HPP
+
+#include <new>
+
+#include "FreeRTOS.h"
+
+namespace FreeRTOS {
+
+/**
+ * @class IsrContext IsrContext.hpp <FreeRTOS/IsrContext.hpp>
+ *
+ * @brief Class that collects the higherPriorityTaskWoken result of every
+ * <tt>*FromISR</tt> call made during an interrupt and requests a single context
+ * switch when it goes out of scope.
+ *
+ * An IsrContext converts to <tt>bool&</tt>, so it can be passed to every
+ * <tt>*FromISR</tt> overload that takes a higherPriorityTaskWoken reference.
+ * Those functions only ever set the flag to true, so any number of calls can
+ * share one IsrContext.  When the IsrContext is destroyed it calls
+ * <tt>portYIELD_FROM_ISR()</tt> once if any of those calls unblocked a task
+ * with a priority higher than the interrupted task.
+ *
+ * Create the IsrContext at the top of the interrupt service routine so that it
+ * is destroyed as the interrupt returns.  It must never be used from a task.
+ *
+ * <b>Example Usage</b>
+ * @include IsrContext/isrContext.cpp
+ */
+class IsrContext {
+ public:
+  IsrContext() = default;
+
+  /**
+   * IsrContext.hpp
+   *
+   * @brief Destroy the IsrContext object by calling <tt>portYIELD_FROM_ISR(
+   * higherPriorityTaskWoken )</tt>
+   *
+   * A context switch is only requested if one of the <tt>*FromISR</tt>
+   * functions the context was passed to woke a higher priority task.
+   */
+  ~IsrContext() {
+    portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+  }
+
+  IsrContext(const IsrContext&) = delete;
+  IsrContext& operator=(const IsrContext&) = delete;
+  IsrContext(IsrContext&&) = delete;
+  IsrContext& operator=(IsrContext&&) = delete;
+
+  static void* operator new(size_t) = delete;
+  static void* operator new[](size_t) = delete;
+
+  /**
+   * IsrContext.hpp
+   *
+   * @brief Conversion that allows the context to be passed as the
+   * higherPriorityTaskWoken argument of any <tt>*FromISR</tt> function.
+   */
+  inline operator bool&() {
+    return higherPriorityTaskWoken;
+  }
+
+  /**
+   * IsrContext.hpp
+   *
+   * @brief Function that checks if a context switch will be requested when the
+   * context goes out of scope.
+   *
+   * @retval true A higher priority task has been woken.
+   * @retval false No higher priority task has been woken.
+   */
+  inline bool isHigherPriorityTaskWoken() const {
+    return higherPriorityTaskWoken;
+  }
+
+ private:
+  bool higherPriorityTaskWoken = false;
+};
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_ISRCONTEXT_HPP
@@ -0,0 +1,409 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_JOBSCHEDULER_HPP
+#define FREERTOS_JOBSCHEDULER_HPP
+
+#include <FreeRTOS/Task.hpp>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Expression that reads the clock used to measure the execution time of
+ * the jobs of a FreeRTOS::JobScheduler.  It defaults to the run time stats
+ * counter when configGENERATE_RUN_TIME_STATS is 1, and to the tick count
+ * otherwise.  Define it before including this header to use a cycle counter.
+ */
+#ifndef FREERTOS_CPP_JOB_SCHEDULER_TIME
+#if (configGENERATE_RUN_TIME_STATS == 1) && \
+    defined(portGET_RUN_TIME_COUNTER_VALUE)
+#define FREERTOS_CPP_JOB_SCHEDULER_TIME() \
+  static_cast<uint32_t>(portGET_RUN_TIME_COUNTER_VALUE())
+#else
+#define FREERTOS_CPP_JOB_SCHEDULER_TIME() \
+  static_cast<uint32_t>(xTaskGetTickCount())
+#endif /* configGENERATE_RUN_TIME_STATS */
+#endif /* FREERTOS_CPP_JOB_SCHEDULER_TIME */
+
+#if (configUSE_TASK_NOTIFICATIONS == 1) && \
+    (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @brief Execution time counters of one FreeRTOS::Job.  Times are in units of
+ * FREERTOS_CPP_JOB_SCHEDULER_TIME().
+ */
+struct JobStatistics {
+  /**
+   * @brief The number of times the job has run.
+   */
+  uint32_t runs;
+
+  /**
+   * @brief The total time spent in the callback of the job.
+   */
+  uint64_t totalTime;
+
+  /**
+   * @brief The longest time a single run of the job took.
+   */
+  uint32_t maxTime;
+
+  /**
+   * @brief The number of periods skipped because the job started more than one
+   * period late.
+   */
+  uint32_t missedPeriods;
+};
+
+/**
+ * @class Job JobScheduler.hpp <FreeRTOS/JobScheduler.hpp>
+ *
+ * @brief Class that holds one run-to-completion job of a
+ * FreeRTOS::JobScheduler.
+ *
+ * A Job is an intrusive list node plus a callback, a priority and execution
+ * time counters.  It has no stack of its own: the callback runs on the stack
+ * of the scheduler task and must return before any other job can run.
+ *
+ * @warning A Job must not be destroyed while it is scheduled.
+ *
+ * <b>Example Usage</b>
+ * @include JobScheduler/jobScheduler.cpp
+ */
+class Job {
+ public:
+  /**
+   * @brief Function called from the scheduler task when the job runs.
+   */
+  using Callback = void (*)(void* argument);
+
+  /**
+   * JobScheduler.hpp
+   *
+   * @brief Construct a new Job object.
+   *
+   * @param callback Function called when the job runs.
+   * @param argument Value passed to callback.
+   * @param priority When several jobs are due at the same time, the job with
+   * the highest priority runs first.
+   */
+  explicit Job(const Callback callback, void* argument = nullptr,
+               const UBaseType_t priority = 0)
+      : callback(callback), argument(argument), priority(priority) {}
+  ~Job() = default;
+
+  Job(const Job&) = delete;
+  Job& operator=(const Job&) = delete;
+
+  /**
+   * JobScheduler.hpp
+   *
+   * @brief Function that returns whether the job is waiting to run.
+   *
+   * @retval true The job is scheduled.
+   * @retval false The job is running, has finished or was cancelled.
+   */
+  inline bool isScheduled() const {
+    return linked;
+  }
+
+  /**
+   * JobScheduler.hpp
+   *
+   * @brief Function that returns a copy of the execution time counters of the
+   * job.  The copy is taken in a critical section so that it is consistent.
+   *
+   * @return JobStatistics The counters of the job.
+   */
+  JobStatistics getStatistics() const {
+    taskENTER_CRITICAL();
+    const JobStatistics copy = statistics;
+    taskEXIT_CRITICAL();
+    return copy;
+  }
+
+ private:
+  template <UBaseType_t>
+  friend class JobScheduler;
+
+  Job* next = nullptr;
+  TickType_t due = 0;
+  TickType_t period = 0;
+  bool linked = false;
+  const Callback callback;
+  void* const argument;
+  const UBaseType_t priority;
+  JobStatistics statistics = {0, 0, 0, 0};
+};
+
+/**
+ * @class JobScheduler JobScheduler.hpp <FreeRTOS/JobScheduler.hpp>
+ *
+ * @brief Class that implements a task that runs any number of stackless,
+ * run-to-completion FreeRTOS::Job objects.
+ *
+ * Low rate housekeeping such as LED patterns, status polls and watchdog kicks
+ * does not need a stack of its own between runs.  Each piece of work becomes a
+ * Job that is scheduled once after a delay, periodically, or immediately with
+ * trigger().  The scheduled jobs are kept on one list sorted by due time, and
+ * the scheduler task sleeps on its task notification until the first of them
+ * is due or the list changes.  When several jobs are due the one with the
+ * highest priority runs first.
+ *
+ * Periodic jobs are due a whole number of periods after they were first
+ * scheduled, so they do not drift.  A job that starts more than one period
+ * late skips the periods it missed instead of running several times in a row,
+ * and the skipped periods are counted in its JobStatistics.
+ *
+ * Jobs can be scheduled, triggered and cancelled from any task, and triggered
+ * from interrupts.  The list is updated inside short critical sections.
+ * Inserting a job walks the list, so the time spent in the critical section
+ * grows with the number of scheduled jobs.
+ *
+ * @warning Every job runs on the stack of the scheduler task, so StackWords
+ * must cover the deepest job.  A job that blocks delays every other job.
+ *
+ * @tparam StackWords The stack depth of the scheduler task, in words.
+ *
+ * <b>Example Usage</b>
+ * @include JobScheduler/jobScheduler.cpp
+ */
+template <UBaseType_t StackWords = configMINIMAL_STACK_SIZE>
+class JobScheduler : public StaticTask<StackWords> {
+ public:
+  /**
+   * JobScheduler.hpp
+   *
+   * @brief Construct a new JobScheduler object and its task.
+   *
+   * @param priority The priority of the scheduler task.
+   * @param name A descriptive name for the scheduler task.
+   */
+  explicit JobScheduler(const UBaseType_t priority = tskIDLE_PRIORITY + 1,
+                        const char* name = "Jobs")
+      : StaticTask<StackWords>(deferCreate) {
+    // The task is created last, as it reads head as soon as it runs.
+    this->create(priority, name);
+  }
+  ~JobScheduler() = default;
+
+  JobScheduler(const JobScheduler&) = delete;
+  JobScheduler& operator=(const JobScheduler&) = delete;
+
+  /**
+   * JobScheduler.hpp
+   *
+   * @brief Function that schedules a job to run after a delay, and then every
+   * period ticks if period is not 0.  A job that is already scheduled is moved
+   * to the new time.
+   *
+   * @param job The job to schedule.
+   * @param delay The number of ticks until the job first runs.
+   * @param period The number of ticks between runs, or 0 to run once.
+   */
+  void schedule(Job& job, const TickType_t delay, const TickType_t period = 0) {
+    taskENTER_CRITICAL();
+    const TickType_t now = xTaskGetTickCount();
+    unlink(job);
+    job.due = now + delay;
+    job.period = period;
+    const bool first = link(job, now);
+    taskEXIT_CRITICAL();
+    if (first) {
+      this->notifyGive();
+    }
+  }
+
+  /**
+   * JobScheduler.hpp
+   *
+   * @brief Function that schedules a job to run once as soon as possible.  A
+   * periodic job keeps its period.
+   *
+   * @param job The job to run.
+   */
+  void trigger(Job& job) {
+    taskENTER_CRITICAL();
+    const TickType_t now = xTaskGetTickCount();
+    unlink(job);
+    job.due = now;
+    const bool first = link(job, now);
+    taskEXIT_CRITICAL();
+    if (first) {
+      this->notifyGive();
+    }
+  }
+
+  /**
+   * JobScheduler.hpp
+   *
+   * @brief A version of trigger() that can be called from an interrupt service
+   * routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * triggering the job woke the scheduler task, and the scheduler task has a
+   * priority higher than the currently running task.
+   * @param job The job to run.
+   */
+  void triggerFromISR(bool& higherPriorityTaskWoken, Job& job) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const TickType_t now = xTaskGetTickCountFromISR();
+    unlink(job);
+    job.due = now;
+    const bool first = link(job, now);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    if (first) {
+      this->notifyGiveFromISR(higherPriorityTaskWoken);
+    }
+  }
+
+  /**
+   * JobScheduler.hpp
+   *
+   * @brief Function that cancels a job.  A periodic job that is running while
+   * it is cancelled finishes its current run and is not scheduled again.
+   *
+   * @param job The job to cancel.
+   */
+  void cancel(Job& job) {
+    taskENTER_CRITICAL();
+    unlink(job);
+    job.period = 0;
+    taskEXIT_CRITICAL();
+  }
+
+ private:
+  static inline TickType_t until(const Job& job, const TickType_t now) {
+    const TickType_t wait = job.due - now;
+    // Jobs that are already due appear to be due almost a whole wrap away.
+    return (wait > (portMAX_DELAY / 2)) ? 0 : wait;
+  }
+
+  // Called in a critical section.  Returns true if job is now at the head of
+  // the list, in which case the scheduler may need to wake up earlier.
+  inline bool link(Job& job, const TickType_t now) {
+    const TickType_t wait = until(job, now);
+    Job** position = &head;
+    while ((*position != nullptr) && (until(**position, now) <= wait)) {
+      position = &(*position)->next;
+    }
+    job.next = *position;
+    *position = &job;
+    job.linked = true;
+    return (position == &head);
+  }
+
+  // Called in a critical section.
+  inline void unlink(Job& job) {
+    if (!job.linked) {
+      return;
+    }
+    Job** position = &head;
+    while (*position != &job) {
+      position = &(*position)->next;
+    }
+    *position = job.next;
+    job.next = nullptr;
+    job.linked = false;
+  }
+
+  // Called in a critical section.  Removes and returns the due job with the
+  // highest priority, or returns nullptr and sets wait to the ticks until the
+  // first job is due.
+  inline Job* takeDue(const TickType_t now, TickType_t& wait) {
+    Job* best = nullptr;
+    for (Job* job = head; (job != nullptr) && (until(*job, now) == 0);
+         job = job->next) {
+      if ((best == nullptr) || (job->priority > best->priority)) {
+        best = job;
+      }
+    }
+    if (best != nullptr) {
+      unlink(*best);
+    } else {
+      wait = (head != nullptr) ? until(*head, now) : portMAX_DELAY;
+    }
+    return best;
+  }
+
+  // Called in a critical section after job has run.
+  inline void finish(Job& job, const TickType_t now, const uint32_t elapsed) {
+    job.statistics.runs++;
+    job.statistics.totalTime += elapsed;
+    if (elapsed > job.statistics.maxTime) {
+      job.statistics.maxTime = elapsed;
+    }
+
+    // A job that was scheduled again while it ran keeps its new time.
+    if (job.linked || (job.period == 0)) {
+      return;
+    }
+    job.due += job.period;
+    if (until(job, now) == 0) {
+      const TickType_t late = now - job.due;
+      const TickType_t missed = (late / job.period) + 1;
+      job.statistics.missedPeriods += missed;
+      job.due += missed * job.period;
+    }
+    link(job, now);
+  }
+
+  void taskFunction() final {
+    for (;;) {
+      TickType_t wait = portMAX_DELAY;
+
+      taskENTER_CRITICAL();
+      Job* const job = takeDue(xTaskGetTickCount(), wait);
+      taskEXIT_CRITICAL();
+
+      if (job == nullptr) {
+        this->notifyTake(wait);
+        continue;
+      }
+
+      const uint32_t start = FREERTOS_CPP_JOB_SCHEDULER_TIME();
+      job->callback(job->argument);
+      const uint32_t elapsed = FREERTOS_CPP_JOB_SCHEDULER_TIME() - start;
+
+      taskENTER_CRITICAL();
+      finish(*job, xTaskGetTickCount(), elapsed);
+      taskEXIT_CRITICAL();
+    }
+  }
+
+  Job* head = nullptr;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TASK_NOTIFICATIONS && configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_JOBSCHEDULER_HPP
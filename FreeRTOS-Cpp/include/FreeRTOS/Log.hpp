@@ -0,0 +1,315 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_LOG_HPP
+#define FREERTOS_LOG_HPP
+
+#include <FreeRTOS/StreamBuffer.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+#include <utility>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief The largest number of arguments a single log record can carry.  Each
+ * argument takes one word in the record.
+ */
+#ifndef FREERTOS_CPP_LOG_MAX_ARGS
+#define FREERTOS_CPP_LOG_MAX_ARGS 4
+#endif
+
+#if (configUSE_STREAM_BUFFERS == 1) && (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @brief A log record as read back by the draining task.
+ */
+struct LogRecord {
+  /**
+   * @brief The format string passed to StaticLog::write().  It is the address
+   * of a string literal, so it also identifies the call site to a host side
+   * decoder that has the firmware image.
+   */
+  const char* format;
+
+  /**
+   * @brief Tick count when the record was written.
+   */
+  TickType_t timestamp;
+
+  /**
+   * @brief Number of valid entries in args.
+   */
+  uint8_t count;
+
+  /**
+   * @brief The arguments, each stored as one word.
+   */
+  uintptr_t args[FREERTOS_CPP_LOG_MAX_ARGS];
+};
+
+/**
+ * @class StaticLog Log.hpp <FreeRTOS/Log.hpp>
+ *
+ * @brief Class that implements a deferred, binary log.
+ *
+ * A call to write() or writeFromISR() does not format anything.  It copies the
+ * address of its format string, the tick count and its arguments, a few words
+ * in all, into a stream buffer inside a short critical section.  A low
+ * priority task then calls receive() and either formats each record with
+ * format() or passes the raw bytes from receiveRaw() to a decoder on a host,
+ * which looks the format strings up in the firmware image.
+ *
+ * Every argument must be an integer, enumeration or pointer no larger than a
+ * word, and each conversion in the format string must consume exactly one
+ * word, for example <tt>%d</tt>, <tt>%u</tt>, <tt>%x</tt>, <tt>%c</tt> or
+ * <tt>%p</tt>.  <tt>%s</tt> may only be used with strings that are never
+ * modified or freed, such as string literals, as the string is read when the
+ * record is formatted.  Floating point values are not supported.
+ *
+ * If the stream buffer does not have room for a whole record the record is
+ * dropped and counted, see getDropped(), so a log call never blocks.
+ *
+ * @warning The format argument must be a string literal or another string with
+ * static storage duration.
+ *
+ * @tparam N The size, in bytes, of the stream buffer that holds the records.
+ *
+ * <b>Example Usage</b>
+ * @include Log/log.cpp
+ */
+template <size_t N>
+class StaticLog {
+ public:
+  /**
+   * Log.hpp
+   *
+   * @brief Construct a new StaticLog object.
+   *
+   * @warning This class contains the storage buffer for the records, so the
+   * user should create this object as a global object or with the static
+   * storage specifier so that the object instance is not on the stack.
+   */
+  StaticLog() : buffer(sizeof(Header)) {}
+  ~StaticLog() = default;
+
+  StaticLog(const StaticLog&) = delete;
+  StaticLog& operator=(const StaticLog&) = delete;
+
+  /**
+   * Log.hpp
+   *
+   * @brief Function that writes a log record from a task.  It never blocks.
+   *
+   * @param format String literal used to format the record.
+   * @param args The arguments for format.
+   * @retval true The record was written.
+   * @retval false There was not enough space, so the record was dropped.
+   */
+  template <class... Args>
+  bool write(const char* format, const Args... args) {
+    const Encoded record = encode(xTaskGetTickCount(), format, args...);
+    // The task level stream buffer API must not be called inside a critical
+    // section, so the interrupt safe one is used and any yield it asks for is
+    // made after the critical section ends.
+    bool higherPriorityTaskWoken = false;
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool written = send(record, higherPriorityTaskWoken);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    if (higherPriorityTaskWoken) {
+      taskYIELD();
+    }
+    return written;
+  }
+
+  /**
+   * Log.hpp
+   *
+   * @brief A version of write() that can be called from an interrupt service
+   * routine.
+   *
+   * @param format String literal used to format the record.
+   * @param args The arguments for format.
+   * @retval true The record was written.
+   * @retval false There was not enough space, so the record was dropped.
+   */
+  template <class... Args>
+  bool writeFromISR(const char* format, const Args... args) {
+    const Encoded record = encode(xTaskGetTickCountFromISR(), format, args...);
+    bool higherPriorityTaskWoken = false;
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool written = send(record, higherPriorityTaskWoken);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return written;
+  }
+
+  /**
+   * Log.hpp
+   *
+   * @brief Function that receives the oldest record.
+   *
+   * @warning Only one task may read from the log.
+   *
+   * @param record Reference the record is copied into.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for a record.
+   * @retval true A record was received.
+   * @retval false ticksToWait expired first.
+   */
+  bool receive(LogRecord& record,
+               const TickType_t ticksToWait = portMAX_DELAY) const {
+    Header header;
+    if (buffer.receive(&header, sizeof(header), ticksToWait) !=
+        sizeof(header)) {
+      return false;
+    }
+    record.format = header.format;
+    record.timestamp = header.timestamp;
+    record.count = static_cast<uint8_t>(header.count);
+    // Records are written whole, so the arguments are already there.
+    buffer.receive(record.args, header.count * sizeof(uintptr_t), 0);
+    return true;
+  }
+
+  /**
+   * Log.hpp
+   *
+   * @brief Function that receives raw record bytes, for sending to a host side
+   * decoder.  Each record is a header of a format string address, a tick count
+   * and an argument count, followed by that many words.
+   *
+   * @warning Only one task may read from the log, and receive() and
+   * receiveRaw() must not both be used.
+   *
+   * @param data Buffer the bytes are copied into.
+   * @param length The length of data.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for a record.
+   * @return size_t The number of bytes received.
+   */
+  size_t receiveRaw(void* data, const size_t length,
+                    const TickType_t ticksToWait = portMAX_DELAY) const {
+    return buffer.receive(data, length, ticksToWait);
+  }
+
+  /**
+   * Log.hpp
+   *
+   * @brief Function that formats a record as text.
+   *
+   * @param record The record to format.
+   * @param text Buffer the text is written into.  It is always terminated.
+   * @param length The length of text.
+   * @return int The value returned by <tt>snprintf()</tt>.
+   */
+  static int format(const LogRecord& record, char* text, const size_t length) {
+    return formatArgs(record, text, length,
+                      std::make_index_sequence<FREERTOS_CPP_LOG_MAX_ARGS>{});
+  }
+
+  /**
+   * Log.hpp
+   *
+   * @brief Function that returns the number of records that were dropped
+   * because the stream buffer was full.
+   *
+   * @return size_t The number of dropped records.
+   */
+  inline size_t getDropped() const {
+    return dropped;
+  }
+
+ private:
+  struct Header {
+    const char* format;
+    TickType_t timestamp;
+    uintptr_t count;
+  };
+
+  struct Encoded {
+    Header header;
+    uintptr_t args[FREERTOS_CPP_LOG_MAX_ARGS];
+  };
+
+  template <class T>
+  static uintptr_t word(const T arg) {
+    static_assert(std::is_integral_v<T> || std::is_enum_v<T> ||
+                      std::is_pointer_v<T>,
+                  "Log arguments must be integers, enumerations or pointers.");
+    static_assert(sizeof(T) <= sizeof(uintptr_t),
+                  "Log arguments must fit in a word.");
+    if constexpr (std::is_pointer_v<T>) {
+      return reinterpret_cast<uintptr_t>(arg);
+    } else {
+      return static_cast<uintptr_t>(arg);
+    }
+  }
+
+  template <class... Args>
+  static Encoded encode(const TickType_t timestamp, const char* format,
+                        const Args... args) {
+    static_assert(sizeof...(Args) <= FREERTOS_CPP_LOG_MAX_ARGS,
+                  "Too many log arguments, see FREERTOS_CPP_LOG_MAX_ARGS.");
+    return Encoded{{format, timestamp, sizeof...(Args)}, {word(args)...}};
+  }
+
+  // Must be called inside a critical section, which makes this the only
+  // writer and means the record is written whole or not at all.  Only the
+  // interrupt safe stream buffer API may be used there.
+  inline bool send(const Encoded& record, bool& higherPriorityTaskWoken) {
+    const size_t length =
+        sizeof(Header) + (record.header.count * sizeof(uintptr_t));
+    if (buffer.spacesAvailable() < length) {
+      dropped++;
+      return false;
+    }
+    buffer.sendFromISR(higherPriorityTaskWoken, &record, length);
+    return true;
+  }
+
+  template <size_t... I>
+  static int formatArgs(const LogRecord& record, char* text,
+                        const size_t length, std::index_sequence<I...>) {
+    // Unused arguments are passed as well, which printf ignores.
+    return std::snprintf(text, length, record.format,  // NOLINT
+                         record.args[I]...);
+  }
+
+  StaticStreamBuffer<N> buffer;
+  size_t dropped = 0;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_STREAM_BUFFERS && configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_LOG_HPP
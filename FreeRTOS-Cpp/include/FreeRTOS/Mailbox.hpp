@@ -0,0 +1,331 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_MAILBOX_HPP
+#define FREERTOS_MAILBOX_HPP
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class Mailbox Mailbox.hpp <FreeRTOS/Mailbox.hpp>
+ *
+ * @brief Class that holds the latest value of some state for any number of
+ * readers, using a sequence counter instead of a kernel critical section.
+ *
+ * A Mailbox replaces a FreeRTOS::Queue of length 1 that is written with
+ * overwrite() and read with peek().  The writer increments a sequence counter
+ * before and after copying the new value in.  A reader copies the value out
+ * and retries if the counter changed while it was copying, so readers never
+ * block the writer or each other.
+ *
+ * Readers can optionally block until a new value is written with wait().  Up
+ * to MaxWaiters tasks can wait at the same time.  They are unblocked with the
+ * task notification at index Index.
+ *
+ * Every write is made inside a critical section, so tasks and interrupt
+ * service routines on any core can write to the same mailbox, and the last
+ * write wins.
+ *
+ * @warning read() spins while a write is in progress, so see read() before
+ * reading from an interrupt service routine.
+ *
+ * @warning While a task is waiting in wait(), its notification at index Index
+ * is used to unblock it, so that task must not use it for any other purpose.
+ *
+ * @tparam T Type of the value.  Must be trivially copyable.
+ * @tparam MaxWaiters The maximum number of tasks that can block in wait() at
+ * the same time.  Set this to 0 if no reader needs to block.
+ * @tparam Index The index within the tasks' array of notification values that
+ * is used to unblock a waiting reader.
+ *
+ * <b>Example Usage</b>
+ * @include Mailbox/mailbox.cpp
+ */
+template <class T, UBaseType_t MaxWaiters = 0, UBaseType_t Index = 0>
+class Mailbox {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Mailbox can only hold trivially copyable types.");
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+
+ public:
+  /**
+   * Mailbox.hpp
+   *
+   * @brief Construct a new Mailbox object.  The mailbox holds no value until
+   * the first write, and version() returns 0.
+   */
+  Mailbox() = default;
+  ~Mailbox() = default;
+
+  Mailbox(const Mailbox&) = delete;
+  Mailbox& operator=(const Mailbox&) = delete;
+  Mailbox(Mailbox&&) = delete;
+  Mailbox& operator=(Mailbox&&) = delete;
+
+  static void* operator new(size_t) = delete;
+  static void* operator new[](size_t) = delete;
+
+  static void* operator new(size_t, void* ptr) {
+    return ptr;
+  }
+
+  static void* operator new[](size_t, void* ptr) {
+    return ptr;
+  }
+
+  /**
+   * Mailbox.hpp
+   *
+   * @brief Function that replaces the value held by the mailbox.  This
+   * function must not be called from an interrupt service routine.  See
+   * writeFromISR() for an alternative which may be used in an ISR.
+   *
+   * The value is copied in inside a critical section that lasts only as long as
+   * the copy.  That stops a higher priority reader from preempting the writer
+   * part way through and then retrying until the writer runs again.
+   *
+   * @param value The new value.
+   */
+  void write(const T& value) {
+    taskENTER_CRITICAL();
+    store(value);
+    taskEXIT_CRITICAL();
+    wake();
+  }
+
+  /**
+   * Mailbox.hpp
+   *
+   * @brief A version of write() that can be called from an interrupt service
+   * routine.
+   *
+   * The value is copied in inside a critical section, so that a nested
+   * interrupt or a writer on another core can not interleave with the copy.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * writing the value caused a waiting task to unblock, and the unblocked task
+   * has a priority higher than the currently running task.
+   * @param value The new value.
+   */
+  void writeFromISR(bool& higherPriorityTaskWoken, const T& value) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    store(value);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    wakeFromISR(higherPriorityTaskWoken);
+  }
+
+  /**
+   * Mailbox.hpp
+   *
+   * @overload
+   */
+  void writeFromISR(const T& value) {
+    bool higherPriorityTaskWoken = false;
+    writeFromISR(higherPriorityTaskWoken, value);
+  }
+
+  /**
+   * Mailbox.hpp
+   *
+   * @brief Function that copies the latest value out of the mailbox.  This
+   * function can be called from tasks and interrupt service routines.
+   *
+   * @warning An interrupt service routine that preempted a write on the same
+   * core spins here forever, as the write can not finish until the interrupt
+   * returns.  Only read from interrupts that can not preempt a writer.
+   *
+   * The copy is retried if the writer changed the value while it was being
+   * copied, so the value returned is never a mix of two writes.
+   *
+   * @param value Reference the value is copied into.  It is left unmodified if
+   * the mailbox has never been written.
+   * @return uint32_t The version of the value that was copied.  This is the
+   * number of writes made to the mailbox, so 0 means that nothing has been
+   * written yet.
+   */
+  uint32_t read(T& value) const {
+    for (;;) {
+      const uint32_t before = sequence.load(std::memory_order_acquire);
+      if ((before & 1U) != 0) {
+        continue;
+      }
+      if (before == 0) {
+        return 0;
+      }
+      std::memcpy(&value, data, sizeof(T));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == before) {
+        return before / 2;
+      }
+    }
+  }
+
+  /**
+   * Mailbox.hpp
+   *
+   * @brief Function that returns the version of the value held by the mailbox.
+   *
+   * @return uint32_t The number of writes made to the mailbox.
+   */
+  inline uint32_t version() const {
+    return sequence.load(std::memory_order_acquire) / 2;
+  }
+
+  /**
+   * Mailbox.hpp
+   *
+   * @brief Function that blocks the calling task until the mailbox holds a
+   * newer value than lastVersion, then copies it out.
+   *
+   * MaxWaiters must be greater than 0 for this function to be available.
+   *
+   * @param value Reference the new value is copied into.
+   * @param lastVersion The version the caller last read.  Updated to the
+   * version of the value that was copied.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for a new value.
+   * @retval true if a newer value was copied into value.
+   * @retval false if no newer value was written before ticksToWait expired.
+   */
+  bool wait(T& value, uint32_t& lastVersion,
+            TickType_t ticksToWait = portMAX_DELAY) const {
+    static_assert(MaxWaiters > 0, "MaxWaiters must be greater than 0.");
+
+    if ((version() == lastVersion) && (ticksToWait != 0)) {
+      TimeOut_t timeOut;
+      vTaskSetTimeOutState(&timeOut);
+      std::atomic<TaskHandle_t>* waiter = registerWaiter();
+      configASSERT(waiter != nullptr);
+      while (version() == lastVersion) {
+        if (waiter != nullptr) {
+          ulTaskNotifyTakeIndexed(Index, pdTRUE, ticksToWait);
+        } else {
+          vTaskDelay(1);
+        }
+        if (xTaskCheckForTimeOut(&timeOut, &ticksToWait) == pdTRUE) {
+          break;
+        }
+      }
+      if (waiter != nullptr) {
+        waiter->store(NULL);
+      }
+    }
+
+    if (version() == lastVersion) {
+      return false;
+    }
+    lastVersion = read(value);
+    return true;
+  }
+
+ private:
+  static constexpr UBaseType_t WaiterSlots = (MaxWaiters > 0) ? MaxWaiters : 1;
+
+  void store(const T& value) {
+    const uint32_t current = sequence.load(std::memory_order_relaxed);
+    sequence.store(current + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(data, &value, sizeof(T));
+    sequence.store(current + 2);
+  }
+
+  /**
+   * @brief Publish the calling task in a free waiter slot.  The slot is
+   * published before the caller checks the version for the final time, so the
+   * writer can not store a new value without also seeing that it needs to
+   * notify the waiter.
+   */
+  std::atomic<TaskHandle_t>* registerWaiter() const {
+    std::atomic<TaskHandle_t>* slot = nullptr;
+    taskENTER_CRITICAL();
+    for (auto& waiter : waiters) {
+      if (waiter.load(std::memory_order_relaxed) == NULL) {
+        waiter.store(xTaskGetCurrentTaskHandle());
+        slot = &waiter;
+        break;
+      }
+    }
+    taskEXIT_CRITICAL();
+    return slot;
+  }
+
+  void wake() const {
+    if constexpr (MaxWaiters > 0) {
+      for (const auto& waiter : waiters) {
+        const TaskHandle_t task = waiter.load();
+        if (task != NULL) {
+          xTaskNotifyGiveIndexed(task, Index);
+        }
+      }
+    }
+  }
+
+  void wakeFromISR(bool& higherPriorityTaskWoken) const {
+    if constexpr (MaxWaiters > 0) {
+      for (const auto& waiter : waiters) {
+        const TaskHandle_t task = waiter.load();
+        if (task != NULL) {
+          BaseType_t taskWoken = pdFALSE;
+          vTaskNotifyGiveIndexedFromISR(task, Index, &taskWoken);
+          if (taskWoken == pdTRUE) {
+            higherPriorityTaskWoken = true;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Twice the number of completed writes.  Odd while a write is in
+   * progress.
+   */
+  std::atomic<uint32_t> sequence{0};
+
+  /**
+   * @brief Tasks blocked in wait(), or NULL.
+   */
+  mutable std::atomic<TaskHandle_t> waiters[WaiterSlots] = {};
+
+  alignas(T) uint8_t data[sizeof(T)];
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+#endif  // FREERTOS_MAILBOX_HPP
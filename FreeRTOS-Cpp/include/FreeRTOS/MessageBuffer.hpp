@@ -28,6 +28,15 @@
 #ifndef FREERTOS_MESSAGEBUFFER_HPP
 #define FREERTOS_MESSAGEBUFFER_HPP
 
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/DeferCreate.hpp>
+#include <FreeRTOS/Instrumentation.hpp>
+#include <FreeRTOS/Region.hpp>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
 #include "FreeRTOS.h"
 #include "message_buffer.h"
 
@@ -59,8 +68,10 @@ namespace FreeRTOS {
 class MessageBufferBase {
  public:
   friend class MessageBuffer;
-  template <size_t>
+  template <size_t, size_t, class>
   friend class StaticMessageBuffer;
+  template <size_t, size_t>
+  friend class InterCoreChannel;
 
   MessageBufferBase(const MessageBufferBase&) = delete;
   MessageBufferBase& operator=(const MessageBufferBase&) = delete;
@@ -136,7 +147,20 @@ class MessageBufferBase {
    */
   inline size_t send(const void* data, const size_t length,
                      const TickType_t ticksToWait = portMAX_DELAY) const {
-    return xMessageBufferSend(handle, data, length, ticksToWait);
+    return Instrument::call(
+        InstrumentedCall::MessageBufferSend, handle, ticksToWait,
+        [&] { return xMessageBufferSend(handle, data, length, ticksToWait); });
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline size_t send(const void* data, const size_t length,
+                     const std::chrono::duration<Rep, Period>& timeout) const {
+    return send(data, length, Clock::toTicks(timeout));
   }
 
   /**
@@ -186,8 +210,10 @@ class MessageBufferBase {
   inline size_t sendFromISR(bool& higherPriorityTaskWoken, const void* data,
                             const size_t length) const {
     BaseType_t taskWoken = pdFALSE;
-    const size_t result =
-        xMessageBufferSendFromISR(handle, data, length, &taskWoken);
+    const size_t result = Instrument::callFromISR(
+        InstrumentedCall::MessageBufferSend, handle, [&] {
+          return xMessageBufferSendFromISR(handle, data, length, &taskWoken);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
@@ -206,7 +232,107 @@ class MessageBufferBase {
    * @overload
    */
   inline size_t sendFromISR(const void* data, const size_t length) const {
-    return xMessageBufferSendFromISR(handle, data, length, NULL);
+    return Instrument::callFromISR(
+        InstrumentedCall::MessageBufferSend, handle, [&] {
+          return xMessageBufferSendFromISR(handle, data, length, NULL);
+        });
+  }
+
+  /**
+   * @brief One piece of a message sent with the gathering overloads of send()
+   * and sendFromISR().
+   */
+  struct Fragment {
+    const void* data;
+    size_t length;
+  };
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Function that sends several fragments, for example a header, a
+   * payload and a checksum, as one discrete message.
+   *
+   * The kernel can only write a message from one contiguous buffer, so the
+   * fragments are gathered into scratch and then sent with
+   * <tt>xMessageBufferSend()</tt>.  Only one task or interrupt may write to a
+   * message buffer, so a single statically allocated scratch buffer can serve
+   * every call site for that message buffer, rather than each writing task
+   * assembling the message on its own stack.
+   *
+   * @param fragments The pieces of the message, in order.
+   * @param scratch Buffer the message is assembled in.  It must not be used
+   * by anything else during the call.
+   * @param scratchLength The length of scratch.
+   * @param ticksToWait The maximum amount of time the calling task should
+   * remain in the Blocked state to wait for enough space to become available in
+   * the message buffer.
+   * @return size_t The length of the message that was written, or 0 if the
+   * call timed out or the fragments do not fit in scratch.
+   *
+   * <b>Example Usage</b>
+   * @include MessageBuffer/sendFragments.cpp
+   */
+  inline size_t send(const std::initializer_list<Fragment> fragments,
+                     void* scratch, const size_t scratchLength,
+                     const TickType_t ticksToWait = portMAX_DELAY) const {
+    const size_t length = gather(fragments, scratch, scratchLength);
+    if (length == 0) {
+      return 0;
+    }
+    return send(scratch, length, ticksToWait);
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline size_t send(const std::initializer_list<Fragment> fragments,
+                     void* scratch, const size_t scratchLength,
+                     const std::chrono::duration<Rep, Period>& timeout) const {
+    return send(fragments, scratch, scratchLength, Clock::toTicks(timeout));
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief A version of the gathering send() that can be called from an
+   * interrupt service routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * sending the message caused a task to unblock, and the unblocked task has a
+   * priority higher than the currently running task.
+   * @param fragments The pieces of the message, in order.
+   * @param scratch Buffer the message is assembled in.  It must not be used
+   * by anything else during the call.
+   * @param scratchLength The length of scratch.
+   * @return size_t The length of the message that was written, or 0 if there
+   * was not enough free space or the fragments do not fit in scratch.
+   */
+  inline size_t sendFromISR(bool& higherPriorityTaskWoken,
+                            const std::initializer_list<Fragment> fragments,
+                            void* scratch, const size_t scratchLength) const {
+    const size_t length = gather(fragments, scratch, scratchLength);
+    if (length == 0) {
+      return 0;
+    }
+    return sendFromISR(higherPriorityTaskWoken, scratch, length);
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @overload
+   */
+  inline size_t sendFromISR(const std::initializer_list<Fragment> fragments,
+                            void* scratch, const size_t scratchLength) const {
+    const size_t length = gather(fragments, scratch, scratchLength);
+    if (length == 0) {
+      return 0;
+    }
+    return sendFromISR(scratch, length);
   }
 
   /**
@@ -249,7 +375,24 @@ class MessageBufferBase {
    */
   inline size_t receive(void* buffer, const size_t bufferLength,
                         const TickType_t ticksToWait = portMAX_DELAY) const {
-    return xMessageBufferReceive(handle, buffer, bufferLength, ticksToWait);
+    return Instrument::call(
+        InstrumentedCall::MessageBufferReceive, handle, ticksToWait,
+        [&] {
+          return xMessageBufferReceive(handle, buffer, bufferLength,
+                                       ticksToWait);
+        });
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline size_t receive(
+      void* buffer, const size_t bufferLength,
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return receive(buffer, bufferLength, Clock::toTicks(timeout));
   }
 
   /**
@@ -293,8 +436,11 @@ class MessageBufferBase {
   inline size_t receiveFromISR(bool& higherPriorityTaskWoken, void* buffer,
                                const size_t bufferLength) const {
     BaseType_t taskWoken = pdFALSE;
-    const size_t result =
-        xMessageBufferReceiveFromISR(handle, buffer, bufferLength, &taskWoken);
+    const size_t result = Instrument::callFromISR(
+        InstrumentedCall::MessageBufferReceive, handle, [&] {
+          return xMessageBufferReceiveFromISR(handle, buffer, bufferLength,
+                                              &taskWoken);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
@@ -313,7 +459,107 @@ class MessageBufferBase {
    * @overload
    */
   inline size_t receiveFromISR(void* buffer, const size_t bufferLength) const {
-    return xMessageBufferReceiveFromISR(handle, buffer, bufferLength, NULL);
+    return Instrument::callFromISR(
+        InstrumentedCall::MessageBufferReceive, handle, [&] {
+          return xMessageBufferReceiveFromISR(handle, buffer, bufferLength,
+                                              NULL);
+        });
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Function that calls <tt>size_t xMessageBufferNextLengthBytes(
+   * MessageBufferHandle_t xMessageBuffer )</tt>
+   *
+   * @see <https://www.freertos.org/xMessageBufferNextLengthBytes.html>
+   *
+   * Returns the length of the next message in the message buffer without
+   * receiving it.  This function can be called from a task or an interrupt
+   * service routine.
+   *
+   * @return size_t The length, in bytes, of the next message, or 0 if the
+   * message buffer is empty.
+   */
+  inline size_t nextLength() const {
+    return xMessageBufferNextLengthBytes(handle);
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Function that waits for a message and receives it into a buffer
+   * that is obtained for exactly its length, for example from a block pool.
+   *
+   * The function blocks until a message is available, calls allocate with the
+   * length returned by nextLength(), and then receives the message into the
+   * returned buffer.  No receive buffer sized for the longest possible message
+   * is needed.
+   *
+   * @tparam Allocate Callable with the signature <tt>void*(size_t)</tt>.
+   * @param allocate Called with the length of the message.  It returns a
+   * buffer that is at least that long, or NULL to leave the message in the
+   * message buffer.  It is not called if ticksToWait expires first.
+   * @param ticksToWait The maximum amount of time the task should remain in the
+   * Blocked state to wait for a message.
+   * @return std::pair<void*, size_t> The buffer returned by allocate and the
+   * length of the message received into it.  The length is 0 if ticksToWait
+   * expired or allocate returned NULL, in which case no message was received.
+   *
+   * <b>Example Usage</b>
+   * @include MessageBuffer/receiveInto.cpp
+   */
+  template <class Allocate>
+  std::pair<void*, size_t> receiveInto(
+      Allocate&& allocate, const TickType_t ticksToWait = portMAX_DELAY) const {
+    // A zero length receive blocks until a message arrives, and then leaves it
+    // in the message buffer because it does not fit.
+    uint8_t unused;
+    xMessageBufferReceive(handle, &unused, 0, ticksToWait);
+    const size_t length = nextLength();
+    if (length == 0) {
+      return {NULL, 0};
+    }
+    return receiveAllocated(allocate(length), length, false, NULL);
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @overload
+   */
+  template <class Allocate, class Rep, class Period>
+  std::pair<void*, size_t> receiveInto(
+      Allocate&& allocate,
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return receiveInto(std::forward<Allocate>(allocate),
+                       Clock::toTicks(timeout));
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief A version of receiveInto() that can be called from an interrupt
+   * service routine.  It does not block.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * receiving the message caused a task to unblock, and the unblocked task has
+   * a priority higher than the currently running task.
+   * @param allocate Called with the length of the message.  It returns a
+   * buffer that is at least that long, or NULL to leave the message in the
+   * message buffer.  It is not called if the message buffer is empty.
+   * @return std::pair<void*, size_t> The buffer returned by allocate and the
+   * length of the message received into it.
+   */
+  template <class Allocate>
+  std::pair<void*, size_t> receiveIntoFromISR(bool& higherPriorityTaskWoken,
+                                              Allocate&& allocate) const {
+    const size_t length = nextLength();
+    if (length == 0) {
+      return {NULL, 0};
+    }
+    return receiveAllocated(allocate(length), length, true,
+                            &higherPriorityTaskWoken);
   }
 
   /**
@@ -413,12 +659,41 @@ class MessageBufferBase {
    * placed on the queue.
    */
   ~MessageBufferBase() {
-    vMessageBufferDelete(this->handle);
+    if (this->handle != NULL) {
+      vMessageBufferDelete(this->handle);
+    }
   }
 
   MessageBufferBase(MessageBufferBase&&) noexcept = default;
   MessageBufferBase& operator=(MessageBufferBase&&) noexcept = default;
 
+  std::pair<void*, size_t> receiveAllocated(
+      void* buffer, const size_t length, const bool fromISR,
+      bool* higherPriorityTaskWoken) const {
+    if (buffer == NULL) {
+      return {NULL, 0};
+    }
+    if (fromISR) {
+      return {buffer, receiveFromISR(*higherPriorityTaskWoken, buffer, length)};
+    }
+    return {buffer, receive(buffer, length, 0)};
+  }
+
+  // Returns the total length, or 0 if the fragments do not fit in scratch.
+  static size_t gather(const std::initializer_list<Fragment> fragments,
+                       void* scratch, const size_t scratchLength) {
+    size_t length = 0;
+    for (const auto& fragment : fragments) {
+      if (fragment.length > scratchLength - length) {
+        return 0;
+      }
+      std::memcpy(static_cast<uint8_t*>(scratch) + length, fragment.data,
+                  fragment.length);
+      length += fragment.length;
+    }
+    return length;
+  }
+
   MessageBufferHandle_t handle = NULL;
 };
 
@@ -462,6 +737,42 @@ class MessageBuffer : public MessageBufferBase {
   explicit MessageBuffer(size_t size) {
     this->handle = xMessageBufferCreate(size);
   }
+
+#if (configUSE_SB_COMPLETED_CALLBACK == 1)
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Construct a new MessageBuffer object by calling
+   * <tt>MessageBufferHandle_t xMessageBufferCreateWithCallback( size_t
+   * xBufferSizeBytes, StreamBufferCallbackFunction_t pxSendCompletedCallback,
+   * StreamBufferCallbackFunction_t pxReceiveCompletedCallback )</tt>
+   *
+   * @see <https://www.freertos.org/xMessageBufferCreate.html>
+   *
+   * configUSE_SB_COMPLETED_CALLBACK must be set to 1 in FreeRTOSConfig.h for
+   * this constructor to be available.
+   *
+   * @warning The user should call isValid() on this object to verify that the
+   * message buffer was created successfully.
+   *
+   * @param size The total number of bytes (not messages) the message buffer
+   * will be able to hold at any one time.
+   * @param sendCompleted Function called instead of the sbSEND_COMPLETED()
+   * macro each time data is written to the buffer, for example to signal
+   * another core or start a DMA transfer.  It is passed the buffer handle,
+   * whether it is being called from an interrupt, and a pointer through which
+   * it can request a context switch.  NULL uses sbSEND_COMPLETED().
+   * @param receiveCompleted Function called instead of the
+   * sbRECEIVE_COMPLETED() macro each time data is read from the buffer.  NULL
+   * uses sbRECEIVE_COMPLETED().
+   */
+  MessageBuffer(const size_t size,
+                const StreamBufferCallbackFunction_t sendCompleted,
+                const StreamBufferCallbackFunction_t receiveCompleted = NULL) {
+    this->handle =
+        xMessageBufferCreateWithCallback(size, sendCompleted, receiveCompleted);
+  }
+#endif /* configUSE_SB_COMPLETED_CALLBACK */
   ~MessageBuffer() = default;
 
   MessageBuffer(const MessageBuffer&) = delete;
@@ -485,10 +796,29 @@ class MessageBuffer : public MessageBufferBase {
  * the application writer as part of the object instance and allows the RAM to
  * be statically allocated at compile time.
  *
+ * The storage is part of the object instance, so to place it in a particular
+ * memory region, such as non-cacheable, DMA capable or tightly coupled RAM,
+ * give the object declaration a section attribute, for example
+ * <tt>__attribute__((section(".dma_buffers")))</tt>.  The control block is
+ * placed in the same region.
+ *
  * @tparam N The size, in bytes, of the storage for the message buffer.
+ * @tparam Alignment The alignment, in bytes, of the storage.  Set it to the
+ * data cache line size (for example 32 on a Cortex-M7) when the storage is the
+ * source or destination of DMA transfers, so that cache maintenance on the
+ * storage never touches a line shared with other data.  Must be a power of
+ * two.
+ * @tparam Region The memory region that holds the control block and storage.
+ * By default they are part of the object instance.  A region defined with
+ * FREERTOS_CPP_DEFINE_REGION() places them in a linker section independently
+ * of where the object itself is placed.
  */
-template <size_t N>
+template <size_t N, size_t Alignment = alignof(uint8_t),
+          class Region = DefaultRegion>
 class StaticMessageBuffer : public MessageBufferBase {
+  static_assert((Alignment & (Alignment - 1)) == 0,
+                "Alignment must be a power of two.");
+
  public:
   /**
    * MessageBuffer.hpp
@@ -508,9 +838,57 @@ class StaticMessageBuffer : public MessageBufferBase {
    * @include MessageBuffer/staticMessageBuffer.cpp
    */
   StaticMessageBuffer() : MessageBufferBase() {
-    this->handle = xMessageBufferCreateStatic(sizeof(storage), storage,
-                                              &staticMessageBuffer);
+    create();
+  }
+
+#if (configUSE_SB_COMPLETED_CALLBACK == 1)
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Construct a new StaticMessageBuffer object by calling
+   * <tt>MessageBufferHandle_t xMessageBufferCreateStaticWithCallback( size_t
+   * xBufferSizeBytes, uint8_t *pucMessageBufferStorageArea,
+   * StaticMessageBuffer_t *pxStaticMessageBuffer,
+   * StreamBufferCallbackFunction_t pxSendCompletedCallback,
+   * StreamBufferCallbackFunction_t pxReceiveCompletedCallback )</tt>
+   *
+   * @see <https://www.freertos.org/xMessageBufferCreateStatic.html>
+   *
+   * configUSE_SB_COMPLETED_CALLBACK must be set to 1 in FreeRTOSConfig.h for
+   * this constructor to be available.
+   *
+   * @param sendCompleted Function called instead of the sbSEND_COMPLETED()
+   * macro each time data is written to the buffer, for example to signal
+   * another core or start a DMA transfer.  It is passed the buffer handle,
+   * whether it is being called from an interrupt, and a pointer through which
+   * it can request a context switch.  NULL uses sbSEND_COMPLETED().
+   * @param receiveCompleted Function called instead of the
+   * sbRECEIVE_COMPLETED() macro each time data is read from the buffer.  NULL
+   * uses sbRECEIVE_COMPLETED().
+   *
+   * <b>Example Usage</b>
+   * @include MessageBuffer/completedCallback.cpp
+   */
+  explicit StaticMessageBuffer(
+      const StreamBufferCallbackFunction_t sendCompleted,
+      const StreamBufferCallbackFunction_t receiveCompleted = NULL)
+      : MessageBufferBase() {
+    create(sendCompleted, receiveCompleted);
   }
+#endif /* configUSE_SB_COMPLETED_CALLBACK */
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Construct a new StaticMessageBuffer object without creating the
+   * message buffer.
+   *
+   * This constructor is constexpr, so a global object constructed with it is
+   * constant initialized.  create() must be called before the message buffer
+   * is used.
+   */
+  constexpr explicit StaticMessageBuffer(DeferCreate)
+      : staticMessageBuffer(deferCreate), storage(deferCreate) {}
   ~StaticMessageBuffer() = default;
 
   StaticMessageBuffer(const StaticMessageBuffer&) = delete;
@@ -519,9 +897,326 @@ class StaticMessageBuffer : public MessageBufferBase {
   StaticMessageBuffer(StaticMessageBuffer&&) noexcept = default;
   StaticMessageBuffer& operator=(StaticMessageBuffer&&) noexcept = default;
 
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Function that calls <tt>MessageBufferHandle_t
+   * xMessageBufferCreateStatic( size_t xBufferSizeBytes, uint8_t
+   * *pucMessageBufferStorageArea, StaticMessageBuffer_t *pxStaticMessageBuffer
+   * )</tt> to create a message buffer that was constructed with
+   * FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/xMessageBufferCreateStatic.html>
+   *
+   * @retval true If the message buffer was created.
+   * @retval false Otherwise.
+   */
+  bool create() {
+    configASSERT(this->handle == NULL);
+    this->handle = xMessageBufferCreateStatic(N, storage.get(),
+                                              staticMessageBuffer.get());
+    return (this->handle != NULL);
+  }
+
+#if (configUSE_SB_COMPLETED_CALLBACK == 1)
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Function that calls <tt>MessageBufferHandle_t
+   * xMessageBufferCreateStaticWithCallback( size_t xBufferSizeBytes, uint8_t
+   * *pucMessageBufferStorageArea, StaticMessageBuffer_t
+   * *pxStaticMessageBuffer, StreamBufferCallbackFunction_t
+   * pxSendCompletedCallback, StreamBufferCallbackFunction_t
+   * pxReceiveCompletedCallback )</tt> to create a message buffer that was
+   * constructed with FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/xMessageBufferCreateStatic.html>
+   *
+   * @param sendCompleted Function called instead of the sbSEND_COMPLETED()
+   * macro, or NULL.
+   * @param receiveCompleted Function called instead of the
+   * sbRECEIVE_COMPLETED() macro, or NULL.
+   * @retval true If the message buffer was created.
+   * @retval false Otherwise.
+   */
+  bool create(const StreamBufferCallbackFunction_t sendCompleted,
+              const StreamBufferCallbackFunction_t receiveCompleted = NULL) {
+    configASSERT(this->handle == NULL);
+    this->handle = xMessageBufferCreateStaticWithCallback(
+        N, storage.get(), staticMessageBuffer.get(), sendCompleted,
+        receiveCompleted);
+    return (this->handle != NULL);
+  }
+#endif /* configUSE_SB_COMPLETED_CALLBACK */
+
  private:
-  StaticMessageBuffer_t staticMessageBuffer;
-  uint8_t storage[N] = {0};
+  RegionStorage<StaticMessageBuffer_t, 1, Region> staticMessageBuffer;
+  RegionStorage<uint8_t, N, Region, Alignment> storage;
+};
+
+/**
+ * @class StaticSizedMessageBuffer MessageBuffer.hpp
+ * <FreeRTOS/MessageBuffer.hpp>
+ *
+ * @brief Class that encapsulates a FreeRTOS message buffer that is sized from
+ * the longest message it carries and the number of such messages it must hold.
+ *
+ * Each message in a message buffer is stored with a
+ * <tt>configMESSAGE_BUFFER_LENGTH_TYPE</tt> length word, and the kernel always
+ * leaves one byte of a statically allocated buffer unused.  This class works
+ * out the storage size from those rules at compile time, so that Count
+ * messages of MaxLength bytes always fit and no more storage than that is
+ * allocated.
+ *
+ * receive() takes a caller provided Buffer, which is exactly large enough for
+ * the longest message, and returns a View of the bytes that were received.
+ * Trivially copyable objects can also be sent and received directly.
+ *
+ * @tparam MaxLength The length, in bytes, of the longest message.
+ * @tparam Count The number of messages of MaxLength bytes that must fit in the
+ * message buffer at once.
+ * @tparam Alignment The alignment, in bytes, of the storage.  See
+ * FreeRTOS::StaticMessageBuffer.
+ * @tparam Region The memory region that holds the control block and storage.
+ * See FreeRTOS::StaticMessageBuffer.
+ *
+ * <b>Example Usage</b>
+ * @include MessageBuffer/staticSizedMessageBuffer.cpp
+ */
+template <size_t MaxLength, size_t Count, size_t Alignment = alignof(uint8_t),
+          class Region = DefaultRegion>
+class StaticSizedMessageBuffer
+    : public StaticMessageBuffer<
+          (Count * (MaxLength + sizeof(configMESSAGE_BUFFER_LENGTH_TYPE))) + 1,
+          Alignment, Region> {
+  static_assert(MaxLength > 0, "Messages must be at least one byte long.");
+  static_assert(Count > 0, "The message buffer must hold a message.");
+
+ public:
+  /**
+   * @brief The number of bytes of storage allocated for the message buffer.
+   */
+  static constexpr size_t StorageSize =
+      (Count * (MaxLength + sizeof(configMESSAGE_BUFFER_LENGTH_TYPE))) + 1;
+
+  /**
+   * @brief Array type that can hold the longest message.
+   */
+  using Buffer = uint8_t[MaxLength];
+
+  /**
+   * @brief The bytes of a received message, inside the caller's Buffer.
+   */
+  struct View {
+    const uint8_t* data;
+    size_t size;
+
+    inline bool empty() const {
+      return (size == 0);
+    }
+  };
+
+  StaticSizedMessageBuffer() = default;
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Construct a new StaticSizedMessageBuffer object without creating
+   * the message buffer.  See FreeRTOS::StaticMessageBuffer::create().
+   */
+  constexpr explicit StaticSizedMessageBuffer(DeferCreate)
+      : StaticMessageBuffer<StorageSize, Alignment, Region>(deferCreate) {}
+
+#if (configUSE_SB_COMPLETED_CALLBACK == 1)
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Construct a new StaticSizedMessageBuffer object with per-instance
+   * completed callbacks.  See FreeRTOS::StaticMessageBuffer.
+   *
+   * configUSE_SB_COMPLETED_CALLBACK must be set to 1 in FreeRTOSConfig.h for
+   * this constructor to be available.
+   *
+   * @param sendCompleted Function called instead of the sbSEND_COMPLETED()
+   * macro each time data is written to the buffer, for example to signal
+   * another core or start a DMA transfer.  It is passed the buffer handle,
+   * whether it is being called from an interrupt, and a pointer through which
+   * it can request a context switch.  NULL uses sbSEND_COMPLETED().
+   * @param receiveCompleted Function called instead of the
+   * sbRECEIVE_COMPLETED() macro each time data is read from the buffer.  NULL
+   * uses sbRECEIVE_COMPLETED().
+   */
+  explicit StaticSizedMessageBuffer(
+      const StreamBufferCallbackFunction_t sendCompleted,
+      const StreamBufferCallbackFunction_t receiveCompleted = NULL)
+      : StaticMessageBuffer<StorageSize, Alignment, Region>(
+            sendCompleted, receiveCompleted) {}
+#endif /* configUSE_SB_COMPLETED_CALLBACK */
+  ~StaticSizedMessageBuffer() = default;
+
+  StaticSizedMessageBuffer(const StaticSizedMessageBuffer&) = delete;
+  StaticSizedMessageBuffer& operator=(const StaticSizedMessageBuffer&) =
+      delete;
+
+  StaticSizedMessageBuffer(StaticSizedMessageBuffer&&) noexcept = default;
+  StaticSizedMessageBuffer& operator=(StaticSizedMessageBuffer&&) noexcept =
+      default;
+
+  using MessageBufferBase::receive;
+  using MessageBufferBase::receiveFromISR;
+  using MessageBufferBase::send;
+  using MessageBufferBase::sendFromISR;
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Function that calls <tt>size_t xMessageBufferReceive(
+   * MessageBufferHandle_t xMessageBuffer, void *pvRxData, size_t
+   * xBufferLengthBytes, TickType_t xTicksToWait )</tt> with a buffer that can
+   * hold the longest message.
+   *
+   * @see <https://www.freertos.org/xMessageBufferReceive.html>
+   *
+   * @param buffer The array the message is copied into.
+   * @param ticksToWait The maximum amount of time the task should remain in the
+   * Blocked state to wait for a message.
+   * @return View The received message.  It is empty if ticksToWait expired
+   * first.
+   */
+  inline View receive(Buffer& buffer,
+                      const TickType_t ticksToWait = portMAX_DELAY) const {
+    return View{buffer, MessageBufferBase::receive(buffer, MaxLength,
+                                                   ticksToWait)};
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline View receive(Buffer& buffer,
+                      const std::chrono::duration<Rep, Period>& timeout) const {
+    return receive(buffer, Clock::toTicks(timeout));
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief A version of receive() that can be called from an interrupt service
+   * routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * receiving the message caused a task to unblock, and the unblocked task has
+   * a priority higher than the currently running task.
+   * @param buffer The array the message is copied into.
+   * @return View The received message.  It is empty if there was no message.
+   */
+  inline View receiveFromISR(bool& higherPriorityTaskWoken,
+                             Buffer& buffer) const {
+    return View{buffer, MessageBufferBase::receiveFromISR(
+                            higherPriorityTaskWoken, buffer, MaxLength)};
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Function that sends a trivially copyable object as one message.
+   *
+   * @tparam T The type of the object.  It must be no larger than MaxLength.
+   * @param message The object to send.
+   * @param ticksToWait The maximum amount of time the task should remain in the
+   * Blocked state to wait for enough free space.
+   * @retval true The message was sent.
+   * @retval false ticksToWait expired first.
+   */
+  template <class T>
+  inline bool sendObject(const T& message,
+                         const TickType_t ticksToWait = portMAX_DELAY) const {
+    checkObject<T>();
+    return (MessageBufferBase::send(&message, sizeof(T), ticksToWait) ==
+            sizeof(T));
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @overload
+   */
+  template <class T, class Rep, class Period>
+  inline bool sendObject(
+      const T& message,
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return sendObject(message, Clock::toTicks(timeout));
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief A version of sendObject() that can be called from an interrupt
+   * service routine.
+   *
+   * @tparam T The type of the object.  It must be no larger than MaxLength.
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * sending the message caused a task to unblock, and the unblocked task has a
+   * priority higher than the currently running task.
+   * @param message The object to send.
+   * @retval true The message was sent.
+   * @retval false There was not enough free space.
+   */
+  template <class T>
+  inline bool sendObjectFromISR(bool& higherPriorityTaskWoken,
+                                const T& message) const {
+    checkObject<T>();
+    return (MessageBufferBase::sendFromISR(higherPriorityTaskWoken, &message,
+                                           sizeof(T)) == sizeof(T));
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @brief Function that receives a message sent with sendObject().
+   *
+   * @tparam T The type of the object.  It must be no larger than MaxLength.
+   * @param message Reference the message is copied into.
+   * @param ticksToWait The maximum amount of time the task should remain in the
+   * Blocked state to wait for a message.
+   * @retval true A message of exactly sizeof(T) bytes was received.
+   * @retval false ticksToWait expired first, or the message had a different
+   * length, in which case it has been discarded.
+   */
+  template <class T>
+  inline bool receiveObject(
+      T& message, const TickType_t ticksToWait = portMAX_DELAY) const {
+    checkObject<T>();
+    Buffer buffer;
+    const View view = receive(buffer, ticksToWait);
+    if (view.size != sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&message, view.data, sizeof(T));
+    return true;
+  }
+
+  /**
+   * MessageBuffer.hpp
+   *
+   * @overload
+   */
+  template <class T, class Rep, class Period>
+  inline bool receiveObject(
+      T& message, const std::chrono::duration<Rep, Period>& timeout) const {
+    return receiveObject(message, Clock::toTicks(timeout));
+  }
+
+ private:
+  template <class T>
+  static constexpr void checkObject() {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Objects sent as messages must be trivially copyable.");
+    static_assert(sizeof(T) <= MaxLength,
+                  "The object is longer than the longest message.");
+  }
 };
 
 #endif /* configSUPPORT_STATIC_ALLOCATION */
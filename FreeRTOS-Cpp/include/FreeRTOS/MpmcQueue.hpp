@@ -0,0 +1,433 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_MPMCQUEUE_HPP
+#define FREERTOS_MPMCQUEUE_HPP
+
+#include <FreeRTOS/Deadline.hpp>
+#include <FreeRTOS/Semaphore.hpp>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class StaticMpmcQueue MpmcQueue.hpp <FreeRTOS/MpmcQueue.hpp>
+ *
+ * @brief Class that implements a bounded multiple producer, multiple consumer
+ * queue that does not take a kernel lock unless a task has to block.
+ *
+ * <tt>xQueueSend()</tt> and <tt>xQueueReceive()</tt> always enter a kernel
+ * critical section, which on an SMP port serialises every core.  This queue is
+ * a ring of N cells that each carry a sequence number, following Dmitry
+ * Vyukov's bounded MPMC design.  A producer claims a cell with one compare and
+ * swap on the enqueue position and publishes the item by advancing the cell's
+ * sequence number, and a consumer does the same on the other side, so
+ * producers and consumers on different cores only meet on the cell they hand
+ * over.
+ *
+ * Blocking is layered on top.  A task that finds the queue full or empty
+ * registers itself as waiting and blocks on a
+ * FreeRTOS::StaticCountingSemaphore.  The other side only gives that semaphore
+ * when the waiting count is not zero, so while the queue is neither full nor
+ * empty no kernel function is called at all.
+ *
+ * When configNUMBER_OF_CORES is 1 the compare and swap is done in a critical
+ * section, so the queue also works on cores without atomic read modify write
+ * instructions.  On SMP ports the target must support them.
+ *
+ * @tparam T Type to be stored in the queue.
+ * @tparam N The maximum number of items the queue can hold at any one time.
+ * Must be a power of 2.
+ *
+ * <b>Example Usage</b>
+ * @include MpmcQueue/mpmcQueue.cpp
+ */
+template <class T, UBaseType_t N>
+class StaticMpmcQueue {
+  static_assert((N > 1) && ((N & (N - 1)) == 0),
+                "N must be a power of 2 greater than 1.");
+
+ public:
+  /**
+   * MpmcQueue.hpp
+   *
+   * @brief Construct a new StaticMpmcQueue object.
+   *
+   * @warning This class contains the storage buffer for the queue, so the user
+   * should create this object as a global object or with the static storage
+   * specifier so that the object instance is not on the stack.
+   */
+  StaticMpmcQueue() : itemsAdded(N, 0), spacesFreed(N, 0) {
+    for (uint32_t i = 0; i < N; i++) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * MpmcQueue.hpp
+   *
+   * @brief Destroy the StaticMpmcQueue object and any items still in the queue.
+   */
+  ~StaticMpmcQueue() {
+    T item;
+    while (pop(item)) {
+    }
+  }
+
+  StaticMpmcQueue(const StaticMpmcQueue&) = delete;
+  StaticMpmcQueue& operator=(const StaticMpmcQueue&) = delete;
+  StaticMpmcQueue(StaticMpmcQueue&&) = delete;
+  StaticMpmcQueue& operator=(StaticMpmcQueue&&) = delete;
+
+  /**
+   * MpmcQueue.hpp
+   *
+   * @brief Post an item to the back of the queue.  The item is queued by copy,
+   * not by reference.  This function must not be called from an interrupt
+   * service routine.  See sendToBackFromISR() for an alternative which may be
+   * used in an ISR.
+   *
+   * @param item A reference to the item that is to be placed on the queue.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for space to become available on the queue, should it already be full.  The
+   * call will return immediately if this is set to 0 and the queue is full.
+   * @retval true if the item was successfully posted.
+   * @retval false otherwise.
+   */
+  bool sendToBack(const T& item, const TickType_t ticksToWait = portMAX_DELAY) {
+    if (!waitFor(producersWaiting, spacesFreed, ticksToWait,
+                 [this, &item] { return push(item); })) {
+      return false;
+    }
+    wake(consumersWaiting, itemsAdded);
+    return true;
+  }
+
+  /**
+   * MpmcQueue.hpp
+   *
+   * @brief Post an item to the back of the queue from an interrupt service
+   * routine.  The item is queued by copy, not by reference.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * sending to the queue caused a task to unblock, and the unblocked task has a
+   * priority higher than the currently running task.
+   * @param item A reference to the item that is to be placed on the queue.
+   * @retval true if the item was successfully posted.
+   * @retval false if the queue was full.
+   */
+  bool sendToBackFromISR(bool& higherPriorityTaskWoken, const T& item) {
+    if (!push(item)) {
+      return false;
+    }
+    wakeFromISR(higherPriorityTaskWoken, consumersWaiting, itemsAdded);
+    return true;
+  }
+
+  /**
+   * MpmcQueue.hpp
+   *
+   * @overload
+   */
+  bool sendToBackFromISR(const T& item) {
+    bool higherPriorityTaskWoken = false;
+    return sendToBackFromISR(higherPriorityTaskWoken, item);
+  }
+
+  /**
+   * MpmcQueue.hpp
+   *
+   * @brief Receive an item from the queue into storage owned by the caller.
+   * This function must not be used in an interrupt service routine.  See
+   * receiveFromISR() for an alternative that can.
+   *
+   * @param item A reference to the object that the received item will be moved
+   * into.  item is left unmodified if no item was received.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for an item to receive should the queue be empty at the time of the call.
+   * @retval true if an item was successfully received from the queue.
+   * @retval false otherwise.
+   */
+  bool receive(T& item, const TickType_t ticksToWait = portMAX_DELAY) {
+    if (!waitFor(consumersWaiting, itemsAdded, ticksToWait,
+                 [this, &item] { return pop(item); })) {
+      return false;
+    }
+    wake(producersWaiting, spacesFreed);
+    return true;
+  }
+
+  /**
+   * MpmcQueue.hpp
+   *
+   * @brief Receive an item from the queue.  This function must not be used in
+   * an interrupt service routine.  See receiveFromISR() for an alternative that
+   * can.
+   *
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for an item to receive should the queue be empty at the time of the call.
+   * @return std::optional<T> Object from the queue. User should check that the
+   * value is present.
+   */
+  std::optional<T> receive(const TickType_t ticksToWait = portMAX_DELAY) {
+    T item;
+    if (!receive(item, ticksToWait)) {
+      return std::nullopt;
+    }
+    return std::optional<T>(std::move(item));
+  }
+
+  /**
+   * MpmcQueue.hpp
+   *
+   * @brief Receive an item from the queue from an interrupt service routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * receiving from the queue caused a task to unblock, and the unblocked task
+   * has a priority higher than the currently running task.
+   * @param item A reference to the object that the received item will be moved
+   * into.  item is left unmodified if no item was received.
+   * @retval true if an item was successfully received from the queue.
+   * @retval false if the queue was empty.
+   */
+  bool receiveFromISR(bool& higherPriorityTaskWoken, T& item) {
+    if (!pop(item)) {
+      return false;
+    }
+    wakeFromISR(higherPriorityTaskWoken, producersWaiting, spacesFreed);
+    return true;
+  }
+
+  /**
+   * MpmcQueue.hpp
+   *
+   * @overload
+   */
+  bool receiveFromISR(T& item) {
+    bool higherPriorityTaskWoken = false;
+    return receiveFromISR(higherPriorityTaskWoken, item);
+  }
+
+  /**
+   * MpmcQueue.hpp
+   *
+   * @brief Return the number of messages stored in the queue.  While other
+   * tasks are sending or receiving the result is only a snapshot.
+   *
+   * @retval UBaseType_t The number of messages available in the queue.
+   */
+  UBaseType_t messagesWaiting() const {
+    const uint32_t first = dequeuePosition.load(std::memory_order_acquire);
+    const uint32_t last = enqueuePosition.load(std::memory_order_acquire);
+    const uint32_t count = last - first;
+    return static_cast<UBaseType_t>((count > N) ? 0 : count);
+  }
+
+  /**
+   * MpmcQueue.hpp
+   *
+   * @brief Return the number of free spaces in the queue.  While other tasks
+   * are sending or receiving the result is only a snapshot.
+   *
+   * @retval UBaseType_t The number of free spaces available in the queue.
+   */
+  UBaseType_t spacesAvailable() const {
+    return N - messagesWaiting();
+  }
+
+ private:
+  struct Cell {
+    std::atomic<uint32_t> sequence;
+    alignas(T) uint8_t storage[sizeof(T)];
+
+    inline T& item() {
+      return *std::launder(reinterpret_cast<T*>(storage));  // NOLINT
+    }
+  };
+
+  static inline int32_t distance(const uint32_t a, const uint32_t b) {
+    return static_cast<int32_t>(a - b);
+  }
+
+  // Moves position from expected to expected + 1 if no other task has done so
+  // already.  expected is updated with the current position on failure.
+  static inline bool claim(std::atomic<uint32_t>& position,
+                           uint32_t& expected) {
+#if (configNUMBER_OF_CORES > 1)
+    return position.compare_exchange_weak(expected, expected + 1,
+                                          std::memory_order_relaxed,
+                                          std::memory_order_relaxed);
+#else
+    // Masking interrupts is enough on a single core, and the mask form works
+    // from both tasks and interrupts.
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const uint32_t current = position.load(std::memory_order_relaxed);
+    const bool claimed = (current == expected);
+    if (claimed) {
+      position.store(expected + 1, std::memory_order_relaxed);
+    } else {
+      expected = current;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return claimed;
+#endif /* configNUMBER_OF_CORES */
+  }
+
+  bool push(const T& item) {
+    uint32_t position = enqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &cells[position & (N - 1)];
+      const int32_t difference =
+          distance(cell->sequence.load(std::memory_order_acquire), position);
+      if (difference == 0) {
+        if (claim(enqueuePosition, position)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = enqueuePosition.load(std::memory_order_relaxed);
+      }
+    }
+    ::new (cell->storage) T(item);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T& item) {
+    uint32_t position = dequeuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &cells[position & (N - 1)];
+      const int32_t difference = distance(
+          cell->sequence.load(std::memory_order_acquire), position + 1);
+      if (difference == 0) {
+        if (claim(dequeuePosition, position)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = dequeuePosition.load(std::memory_order_relaxed);
+      }
+    }
+    item = std::move(cell->item());
+    cell->item().~T();
+    cell->sequence.store(position + N, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Call attempt() until it succeeds or ticksToWait expires.  The
+   * waiting count is raised before the final attempt, so the other side can not
+   * make room (or add an item) without also seeing that it must give the
+   * semaphore.
+   */
+  template <class Attempt>
+  static bool waitFor(std::atomic<UBaseType_t>& waiting,
+                      const StaticCountingSemaphore& semaphore,
+                      const TickType_t ticksToWait, Attempt attempt) {
+    if (attempt()) {
+      return true;
+    }
+    if (ticksToWait == 0) {
+      return false;
+    }
+
+    const Deadline deadline(ticksToWait);
+    for (;;) {
+      taskENTER_CRITICAL();
+      waiting.store(waiting.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+      taskEXIT_CRITICAL();
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      const bool result = attempt() || (semaphore.take(deadline) && attempt());
+
+      taskENTER_CRITICAL();
+      waiting.store(waiting.load(std::memory_order_relaxed) - 1,
+                    std::memory_order_relaxed);
+      taskEXIT_CRITICAL();
+      if (result) {
+        return true;
+      }
+      if (deadline.hasExpired()) {
+        return attempt();
+      }
+    }
+  }
+
+  static void wake(const std::atomic<UBaseType_t>& waiting,
+                   const StaticCountingSemaphore& semaphore) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed) != 0) {
+      semaphore.give();
+    }
+  }
+
+  static void wakeFromISR(bool& higherPriorityTaskWoken,
+                          const std::atomic<UBaseType_t>& waiting,
+                          const StaticCountingSemaphore& semaphore) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed) != 0) {
+      semaphore.giveFromISR(higherPriorityTaskWoken);
+    }
+  }
+
+  Cell cells[N];
+  std::atomic<uint32_t> enqueuePosition{0};
+  std::atomic<uint32_t> dequeuePosition{0};
+  std::atomic<UBaseType_t> producersWaiting{0};
+  std::atomic<UBaseType_t> consumersWaiting{0};
+
+  /**
+   * @brief Given once for each item sent while a consumer is waiting.  A
+   * consumer that finds the item already taken by another consumer waits again.
+   */
+  StaticCountingSemaphore itemsAdded;
+
+  /**
+   * @brief Given once for each item received while a producer is waiting.
+   */
+  StaticCountingSemaphore spacesFreed;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_MPMCQUEUE_HPP
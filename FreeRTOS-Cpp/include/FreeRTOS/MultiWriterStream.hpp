@@ -0,0 +1,334 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_MULTIWRITERSTREAM_HPP
+#define FREERTOS_MULTIWRITERSTREAM_HPP
+
+#include <FreeRTOS/StreamBuffer.hpp>
+#include <atomic>
+#include <cstring>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_STREAM_BUFFERS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class StaticMultiWriterStream MultiWriterStream.hpp
+ * <FreeRTOS/MultiWriterStream.hpp>
+ *
+ * @brief Class that lets any number of tasks and interrupts write to a stream
+ * buffer, which on its own only supports a single writer.
+ *
+ * A write reserves one or more consecutive staging slots inside a critical
+ * section that only updates two counters, copies its bytes into the slots with
+ * interrupts enabled, and then marks the slots as committed.  Whichever writer
+ * finds no other writer flushing then becomes the flusher, and copies every
+ * committed slot into the stream buffer in the order the slots were reserved,
+ * so bytes from different writes are never interleaved.  A writer that
+ * preempts the flusher just leaves its slots for the flusher to pick up, so
+ * no writer ever blocks on another one and there is no mutex to cause priority
+ * inversion or lock convoys.
+ *
+ * The flusher never blocks either.  If the stream buffer is full, committed
+ * slots wait in the staging area until the next write or flush().  A write
+ * that finds too few free slots is dropped and counted, see getDropped().
+ *
+ * @warning The stream buffer must not be written to in any other way while it
+ * is used through this class.
+ *
+ * @tparam Slots The number of staging slots.
+ * @tparam SlotSize The size, in bytes, of each staging slot.  A write longer
+ * than SlotSize uses several consecutive slots.
+ *
+ * <b>Example Usage</b>
+ * @include MultiWriterStream/multiWriterStream.cpp
+ */
+template <size_t Slots, size_t SlotSize = 32>
+class StaticMultiWriterStream {
+  static_assert(Slots > 0, "There must be at least one staging slot.");
+  static_assert(SlotSize > 0, "Staging slots must hold at least one byte.");
+
+ public:
+  /**
+   * MultiWriterStream.hpp
+   *
+   * @brief Construct a new StaticMultiWriterStream object that writes to
+   * stream.
+   *
+   * @param stream The stream buffer written to.  It must outlive this object.
+   */
+  explicit StaticMultiWriterStream(const StreamBufferBase& stream)
+      : stream(stream) {}
+  ~StaticMultiWriterStream() = default;
+
+  StaticMultiWriterStream(const StaticMultiWriterStream&) = delete;
+  StaticMultiWriterStream& operator=(const StaticMultiWriterStream&) = delete;
+
+  /**
+   * MultiWriterStream.hpp
+   *
+   * @brief Function that writes bytes to the stream buffer from a task.  It
+   * never blocks.
+   *
+   * @param data The bytes to write.
+   * @param length The number of bytes to write.
+   * @retval true The bytes were staged, and are written to the stream buffer as
+   * soon as it has space.
+   * @retval false Too few staging slots were free, so the bytes were dropped.
+   */
+  bool write(const void* data, const size_t length) {
+    taskENTER_CRITICAL();
+    const size_t first = reserve(length);
+    taskEXIT_CRITICAL();
+    if (first == Slots) {
+      return false;
+    }
+    stage(first, data, length);
+    bool unused = false;
+    drain(false, unused);
+    return true;
+  }
+
+  /**
+   * MultiWriterStream.hpp
+   *
+   * @brief A version of write() that can be called from an interrupt service
+   * routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * writing to the stream buffer caused a task to unblock, and the unblocked
+   * task has a priority higher than the currently running task.
+   * @param data The bytes to write.
+   * @param length The number of bytes to write.
+   * @retval true The bytes were staged.
+   * @retval false Too few staging slots were free, so the bytes were dropped.
+   */
+  bool writeFromISR(bool& higherPriorityTaskWoken, const void* data,
+                    const size_t length) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const size_t first = reserve(length);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    if (first == Slots) {
+      return false;
+    }
+    stage(first, data, length);
+    drain(true, higherPriorityTaskWoken);
+    return true;
+  }
+
+  /**
+   * MultiWriterStream.hpp
+   *
+   * @overload
+   */
+  bool writeFromISR(const void* data, const size_t length) {
+    bool higherPriorityTaskWoken = false;
+    return writeFromISR(higherPriorityTaskWoken, data, length);
+  }
+
+  /**
+   * MultiWriterStream.hpp
+   *
+   * @brief Function that copies committed slots into the stream buffer, for
+   * example after the reader has made space and no new write has happened
+   * since.  It never blocks.
+   */
+  void flush() {
+    bool unused = false;
+    drain(false, unused);
+  }
+
+  /**
+   * MultiWriterStream.hpp
+   *
+   * @brief A version of flush() that can be called from an interrupt service
+   * routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * writing to the stream buffer caused a task to unblock, and the unblocked
+   * task has a priority higher than the currently running task.
+   */
+  void flushFromISR(bool& higherPriorityTaskWoken) {
+    drain(true, higherPriorityTaskWoken);
+  }
+
+  /**
+   * MultiWriterStream.hpp
+   *
+   * @brief Function that returns the number of writes that were dropped
+   * because too few staging slots were free.
+   *
+   * @return size_t The number of dropped writes.
+   */
+  inline size_t getDropped() const {
+    return dropped.load();
+  }
+
+ private:
+  struct Slot {
+    uint8_t data[SlotSize];
+    size_t length;
+    size_t sent;
+    std::atomic<bool> committed;
+  };
+
+  static constexpr size_t slotsFor(const size_t length) {
+    return (length == 0) ? 1 : ((length + SlotSize - 1) / SlotSize);
+  }
+
+  // Must be called inside a critical section.  Returns the first reserved slot,
+  // or Slots if there is not enough room.
+  inline size_t reserve(const size_t length) {
+    const size_t needed = slotsFor(length);
+    if (needed > Slots - used) {
+      dropped.store(dropped.load() + 1);
+      return Slots;
+    }
+    const size_t first = (head + used) % Slots;
+    used += needed;
+    return first;
+  }
+
+  // Copies data into the reserved slots, committing the first slot last so
+  // the flusher never starts on a partly staged write.
+  inline void stage(const size_t first, const void* data, size_t length) {
+    const size_t needed = slotsFor(length);
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t index = first;
+    for (size_t i = 0; i < needed; i++) {
+      Slot& slot = slots[index];
+      const size_t chunk = (length < SlotSize) ? length : SlotSize;
+      std::memcpy(slot.data, bytes, chunk);
+      slot.length = chunk;
+      slot.sent = 0;
+      bytes += chunk;
+      length -= chunk;
+      if (i != 0) {
+        slot.committed.store(true);
+      }
+      index = (index + 1) % Slots;
+    }
+    slots[first].committed.store(true);
+  }
+
+  // Copies committed slots into the stream buffer until it is full or the
+  // oldest reserved slot is still being staged.  Only one writer drains at a
+  // time.
+  void drain(const bool fromISR, bool& higherPriorityTaskWoken) {
+    for (;;) {
+      if (!claimFlush(fromISR)) {
+        return;
+      }
+
+      bool full = false;
+      for (;;) {
+        Slot& slot = slots[head];
+        if (!slot.committed.load()) {
+          break;
+        }
+        const size_t remaining = slot.length - slot.sent;
+        const size_t sent =
+            fromISR ? stream.sendFromISR(higherPriorityTaskWoken,
+                                         slot.data + slot.sent, remaining)
+                    : stream.send(slot.data + slot.sent, remaining, 0);
+        slot.sent += sent;
+        if (sent != remaining) {
+          full = true;
+          break;
+        }
+        slot.committed.store(false);
+        release(fromISR);
+      }
+
+      flushing.store(false);
+
+      // A write that committed while this writer held the flag may have given
+      // up on draining, so go round again unless the stream buffer is full.
+      if (full || !slots[head].committed.load()) {
+        return;
+      }
+    }
+  }
+
+  // Atomic read modify write operations are not available on every port, so
+  // the flushing flag is claimed inside a critical section.
+  inline bool claimFlush(const bool fromISR) {
+    bool claimed = false;
+    if (fromISR) {
+      const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+      claimed = !flushing.load();
+      flushing.store(true);
+      taskEXIT_CRITICAL_FROM_ISR(status);
+    } else {
+      taskENTER_CRITICAL();
+      claimed = !flushing.load();
+      flushing.store(true);
+      taskEXIT_CRITICAL();
+    }
+    return claimed;
+  }
+
+  inline void release(const bool fromISR) {
+    if (fromISR) {
+      const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+      head = (head + 1) % Slots;
+      used--;
+      taskEXIT_CRITICAL_FROM_ISR(status);
+    } else {
+      taskENTER_CRITICAL();
+      head = (head + 1) % Slots;
+      used--;
+      taskEXIT_CRITICAL();
+    }
+  }
+
+  const StreamBufferBase& stream;
+
+  /**
+   * @brief Oldest reserved slot.  Only written by the flusher.
+   */
+  size_t head = 0;
+
+  /**
+   * @brief Number of reserved slots.
+   */
+  size_t used = 0;
+
+  std::atomic<bool> flushing{false};
+  std::atomic<size_t> dropped{0};
+  Slot slots[Slots] = {};
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_STREAM_BUFFERS */
+
+#endif  // FREERTOS_MULTIWRITERSTREAM_HPP
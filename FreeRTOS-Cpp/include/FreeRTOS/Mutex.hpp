@@ -28,11 +28,76 @@
 #ifndef FREERTOS_MUTEX_HPP
 #define FREERTOS_MUTEX_HPP
 
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/DeferCreate.hpp>
+#include <FreeRTOS/Instrumentation.hpp>
+
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "task.h"
+
+/**
+ * @brief Set FREERTOS_CPP_MUTEX_PROFILER to 1 in FreeRTOSConfig.h (or on the
+ * compiler command line) to have every mutex record how often locking it is
+ * contended, how long tasks wait for it and how long it is held.  The
+ * statistics of every mutex can be read through FreeRTOS::MutexRegistry.
+ * When it is 0 (the default) lock() and unlock() call the kernel directly.
+ */
+#ifndef FREERTOS_CPP_MUTEX_PROFILER
+#define FREERTOS_CPP_MUTEX_PROFILER 0
+#endif
+
+/**
+ * @brief The maximum number of mutexes FreeRTOS::MutexRegistry can track.
+ */
+#ifndef FREERTOS_CPP_MUTEX_PROFILER_MAX_MUTEXES
+#define FREERTOS_CPP_MUTEX_PROFILER_MAX_MUTEXES 16
+#endif
 
 namespace FreeRTOS {
 
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+
+/**
+ * @brief Contention statistics recorded by FreeRTOS::MutexBase when
+ * FREERTOS_CPP_MUTEX_PROFILER is set to 1.  All times are in ticks.
+ */
+struct MutexStatistics {
+  /**
+   * @brief The number of successful calls to lock().
+   */
+  uint32_t locks = 0;
+
+  /**
+   * @brief The number of calls to lock() that found the mutex held by another
+   * task.
+   */
+  uint32_t contended = 0;
+
+  /**
+   * @brief The longest time a contended call to lock() waited.
+   */
+  TickType_t maxWait = 0;
+
+  /**
+   * @brief The total time contended calls to lock() waited.
+   */
+  uint32_t totalWait = 0;
+
+  /**
+   * @brief The longest time the mutex was held.
+   */
+  TickType_t maxHold = 0;
+
+  /**
+   * @brief The task that held the mutex the last time locking it was
+   * contended.  Only recorded when INCLUDE_xSemaphoreGetMutexHolder is 1.
+   */
+  TaskHandle_t lastOwner = NULL;
+};
+
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
+
 /**
  * @class MutexBase Mutex.hpp <FreeRTOS/Mutex.hpp>
  *
@@ -51,6 +116,8 @@ class MutexBase {
   friend class RecursiveMutexBase;
   friend class RecursiveMutex;
   friend class StaticRecursiveMutex;
+  friend class QueueSetBase;
+  friend class QueueSetMember;
 
   MutexBase(const MutexBase&) = delete;
   MutexBase& operator=(const MutexBase&) = delete;
@@ -97,7 +164,24 @@ class MutexBase {
    * @include Mutex/lock.cpp
    */
   inline bool lock(const TickType_t ticksToWait = portMAX_DELAY) const {
-    return (xSemaphoreTake(handle, ticksToWait) == pdTRUE);
+    return Instrument::call(
+        InstrumentedCall::MutexLock, handle, ticksToWait, [&] {
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+          return profiledLock(false, ticksToWait);
+#else
+          return (xSemaphoreTake(handle, ticksToWait) == pdTRUE);
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
+        });
+  }
+
+  /**
+   * Mutex.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool lock(const std::chrono::duration<Rep, Period>& timeout) const {
+    return lock(Clock::toTicks(timeout));
   }
 
   /**
@@ -122,7 +206,10 @@ class MutexBase {
    */
   inline bool lockFromISR(bool& higherPriorityTaskWoken) const {
     BaseType_t taskWoken = pdFALSE;
-    const bool result = (xSemaphoreTakeFromISR(handle, &taskWoken) == pdTRUE);
+    const bool result = Instrument::callFromISR(
+        InstrumentedCall::MutexLock, handle, [&] {
+          return (xSemaphoreTakeFromISR(handle, &taskWoken) == pdTRUE);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
@@ -140,7 +227,9 @@ class MutexBase {
    * @overload
    */
   inline bool lockFromISR() const {
-    return (xSemaphoreTakeFromISR(handle, NULL) == pdTRUE);
+    return Instrument::callFromISR(InstrumentedCall::MutexLock, handle, [&] {
+      return (xSemaphoreTakeFromISR(handle, NULL) == pdTRUE);
+    });
   }
 
   /**
@@ -162,11 +251,88 @@ class MutexBase {
    * @include Mutex/unlock.cpp
    */
   inline bool unlock() const {
-    return (xSemaphoreGive(handle) == pdTRUE);
+    return Instrument::call(InstrumentedCall::MutexUnlock, handle, 0, [&] {
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+      return profiledUnlock(false);
+#else
+      return (xSemaphoreGive(handle) == pdTRUE);
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
+    });
   }
 
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+  /**
+   * Mutex.hpp
+   *
+   * @brief Function that gives the mutex a name, which is reported with its
+   * statistics by FreeRTOS::MutexRegistry.
+   *
+   * FREERTOS_CPP_MUTEX_PROFILER must be defined as 1 for this function to be
+   * available.
+   *
+   * @param newName The name.  The string must outlive the mutex.
+   */
+  inline void setName(const char* newName) {
+    name = newName;
+  }
+
+  /**
+   * Mutex.hpp
+   *
+   * @brief Function that returns the name set by setName().
+   *
+   * FREERTOS_CPP_MUTEX_PROFILER must be defined as 1 for this function to be
+   * available.
+   *
+   * @return const char* The name, or nullptr if no name was set.
+   */
+  inline const char* getName() const {
+    return name;
+  }
+
+  /**
+   * Mutex.hpp
+   *
+   * @brief Function that returns a copy of the contention statistics of the
+   * mutex.
+   *
+   * FREERTOS_CPP_MUTEX_PROFILER must be defined as 1 for this function to be
+   * available.
+   *
+   * @return MutexStatistics The statistics recorded since the mutex was
+   * created or resetStatistics() was last called.
+   *
+   * <b>Example Usage</b>
+   * @include Mutex/profiler.cpp
+   */
+  inline MutexStatistics getStatistics() const {
+    taskENTER_CRITICAL();
+    const MutexStatistics copy = statistics;
+    taskEXIT_CRITICAL();
+    return copy;
+  }
+
+  /**
+   * Mutex.hpp
+   *
+   * @brief Function that clears the contention statistics of the mutex.
+   *
+   * FREERTOS_CPP_MUTEX_PROFILER must be defined as 1 for this function to be
+   * available.
+   */
+  inline void resetStatistics() {
+    taskENTER_CRITICAL();
+    statistics = MutexStatistics();
+    taskEXIT_CRITICAL();
+  }
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
+
  private:
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+  MutexBase();
+#else
   MutexBase() = default;
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
 
   /**
    * Mutex.hpp
@@ -180,19 +346,219 @@ class MutexBase {
    * the Blocked state waiting for the mutex to become available).
    */
   ~MutexBase() {
-    vSemaphoreDelete(this->handle);
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+    unregister();
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
+    if (this->handle != NULL) {
+      vSemaphoreDelete(this->handle);
+    }
+  }
+
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+  MutexBase(MutexBase&& other) noexcept;
+  MutexBase& operator=(MutexBase&&) noexcept = default;
+
+  void unregister() const;
+
+  inline bool take(const bool recursive, const TickType_t ticksToWait) const {
+    return (recursive ? xSemaphoreTakeRecursive(handle, ticksToWait)
+                      : xSemaphoreTake(handle, ticksToWait)) == pdTRUE;
   }
 
+  bool profiledLock(const bool recursive, const TickType_t ticksToWait) const {
+    if (take(recursive, 0)) {
+      taskENTER_CRITICAL();
+      statistics.locks++;
+      if (depth++ == 0) {
+        lockedAt = xTaskGetTickCount();
+      }
+      taskEXIT_CRITICAL();
+      return true;
+    }
+
+#if (INCLUDE_xSemaphoreGetMutexHolder == 1)
+    const TaskHandle_t holder = xSemaphoreGetMutexHolder(handle);
+#else
+    const TaskHandle_t holder = NULL;
+#endif /* INCLUDE_xSemaphoreGetMutexHolder */
+    const TickType_t start = xTaskGetTickCount();
+    const bool locked = (ticksToWait > 0) && take(recursive, ticksToWait);
+    const TickType_t now = xTaskGetTickCount();
+    const TickType_t waited = now - start;
+
+    taskENTER_CRITICAL();
+    statistics.contended++;
+    statistics.totalWait += waited;
+    if (waited > statistics.maxWait) {
+      statistics.maxWait = waited;
+    }
+    statistics.lastOwner = holder;
+    if (locked) {
+      statistics.locks++;
+      depth = 1;
+      lockedAt = now;
+    }
+    taskEXIT_CRITICAL();
+    return locked;
+  }
+
+  bool profiledUnlock(const bool recursive) const {
+    if (depth == 0) {
+      return false;
+    }
+    if (--depth == 0) {
+      const TickType_t held = xTaskGetTickCount() - lockedAt;
+      taskENTER_CRITICAL();
+      if (held > statistics.maxHold) {
+        statistics.maxHold = held;
+      }
+      taskEXIT_CRITICAL();
+    }
+    return (recursive ? xSemaphoreGiveRecursive(handle)
+                      : xSemaphoreGive(handle)) == pdTRUE;
+  }
+#else
   MutexBase(MutexBase&&) noexcept = default;
   MutexBase& operator=(MutexBase&&) noexcept = default;
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
 
   /**
    * @brief Handle used to refer to the semaphore when using the FreeRTOS
    * interface.
    */
   SemaphoreHandle_t handle = NULL;
+
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+  const char* name = nullptr;
+  mutable MutexStatistics statistics;
+  // Only written by the task that holds the mutex.
+  mutable TickType_t lockedAt = 0;
+  mutable UBaseType_t depth = 0;
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
+};
+
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+
+/**
+ * @class MutexRegistry Mutex.hpp <FreeRTOS/Mutex.hpp>
+ *
+ * @brief Class that records every mutex while FREERTOS_CPP_MUTEX_PROFILER is
+ * set to 1, so that a monitor task can find the most contended ones.
+ *
+ * Mutexes are added when they are created and removed when they are
+ * destroyed.  Up to FREERTOS_CPP_MUTEX_PROFILER_MAX_MUTEXES mutexes are
+ * tracked.
+ *
+ * <b>Example Usage</b>
+ * @include Mutex/profiler.cpp
+ */
+class MutexRegistry {
+ public:
+  /**
+   * Mutex.hpp
+   *
+   * @brief Function that calls function for every registered mutex.
+   *
+   * @param function Function called as <tt>function(const MutexBase& mutex,
+   * const MutexStatistics& statistics)</tt>.  It is called outside of any
+   * critical section, so it may block, but it must not create or destroy a
+   * mutex.
+   */
+  template <class Function>
+  static void forEach(Function&& function) {
+    for (const MutexBase* const& entry : entries) {
+      taskENTER_CRITICAL();
+      const MutexBase* const mutex = entry;
+      taskEXIT_CRITICAL();
+      if (mutex != nullptr) {
+        function(*mutex, mutex->getStatistics());
+      }
+    }
+  }
+
+  /**
+   * Mutex.hpp
+   *
+   * @brief Function that finds the registered mutex with the most contended
+   * locks.
+   *
+   * @param exclude Mutexes already reported, for example the results of
+   * previous calls, which are skipped.
+   * @param excluded The number of entries in exclude.
+   * @return const MutexBase* The most contended mutex, or nullptr if no other
+   * mutex has been contended.
+   */
+  static const MutexBase* mostContended(const MutexBase* const* exclude =
+                                            nullptr,
+                                        const UBaseType_t excluded = 0) {
+    const MutexBase* result = nullptr;
+    uint32_t highest = 0;
+    forEach([&](const MutexBase& mutex, const MutexStatistics& statistics) {
+      for (UBaseType_t i = 0; i < excluded; i++) {
+        if (exclude[i] == &mutex) {
+          return;
+        }
+      }
+      if (statistics.contended > highest) {
+        highest = statistics.contended;
+        result = &mutex;
+      }
+    });
+    return result;
+  }
+
+ private:
+  friend class MutexBase;
+
+  static void add(const MutexBase* const mutex) {
+    taskENTER_CRITICAL();
+    for (auto& entry : entries) {
+      if (entry == nullptr) {
+        entry = mutex;
+        break;
+      }
+    }
+    taskEXIT_CRITICAL();
+  }
+
+  static void remove(const MutexBase* const mutex) {
+    taskENTER_CRITICAL();
+    for (auto& entry : entries) {
+      if (entry == mutex) {
+        entry = nullptr;
+        break;
+      }
+    }
+    taskEXIT_CRITICAL();
+  }
+
+  /**
+   * @brief Registered mutexes.  Zero initialized, so every entry starts unused
+   * before any mutex constructor runs.
+   */
+  static inline const MutexBase*
+      entries[FREERTOS_CPP_MUTEX_PROFILER_MAX_MUTEXES] = {};
 };
 
+inline MutexBase::MutexBase() {
+  MutexRegistry::add(this);
+}
+
+inline MutexBase::MutexBase(MutexBase&& other) noexcept
+    : handle(other.handle),
+      name(other.name),
+      statistics(other.statistics),
+      lockedAt(other.lockedAt),
+      depth(other.depth) {
+  MutexRegistry::add(this);
+}
+
+inline void MutexBase::unregister() const {
+  MutexRegistry::remove(this);
+}
+
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
+
 /**
  * @class RecursiveMutexBase Mutex.hpp <FreeRTOS/Mutex.hpp>
  *
@@ -233,11 +599,44 @@ class RecursiveMutexBase : public MutexBase {
    * @retval true If the mutex was locked.
    * @retval false If ticksToWait expired without the mutex becoming available.
    *
+   * @note The owner and the nesting depth are also kept in the object, so only
+   * the outermost lock() calls into the kernel.  A nested lock() by the task
+   * that already owns the mutex only increments the depth.  It is not seen by
+   * the instrumentation hooks or the mutex profiler.
+   *
    * <b>Example Usage</b>
    * @include Mutex/recursiveLock.cpp
    */
   inline bool lock(const TickType_t ticksToWait = portMAX_DELAY) const {
-    return (xSemaphoreTakeRecursive(handle, ticksToWait) == pdTRUE);
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    if ((nesting > 0) && (owner == self)) {
+      nesting++;
+      return true;
+    }
+
+    const bool locked = Instrument::call(
+        InstrumentedCall::MutexLock, handle, ticksToWait, [&] {
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+          return profiledLock(true, ticksToWait);
+#else
+          return (xSemaphoreTakeRecursive(handle, ticksToWait) == pdTRUE);
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
+        });
+    if (locked) {
+      owner = self;
+      nesting = 1;
+    }
+    return locked;
+  }
+
+  /**
+   * Mutex.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool lock(const std::chrono::duration<Rep, Period>& timeout) const {
+    return lock(Clock::toTicks(timeout));
   }
 
   /**
@@ -254,14 +653,30 @@ class RecursiveMutexBase : public MutexBase {
    * same mutex 5 times then the mutex will not be available to any other task
    * until it has also unlocked the mutex back exactly five times.
    *
+   * Only the final unlock() calls into the kernel to give the mutex back.
+   *
    * @return true If the mutex was unlocked.
-   * @return false Otherwise.
+   * @return false If the calling task does not own the mutex.
    *
    * <b>Example Usage</b>
    * @include Mutex/recursiveLock.cpp
    */
   inline bool unlock() const {
-    return (xSemaphoreGiveRecursive(handle) == pdTRUE);
+    if ((nesting == 0) || (owner != xTaskGetCurrentTaskHandle())) {
+      return false;
+    }
+    if (--nesting > 0) {
+      return true;
+    }
+    owner = NULL;
+
+    return Instrument::call(InstrumentedCall::MutexUnlock, handle, 0, [&] {
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+      return profiledUnlock(true);
+#else
+      return (xSemaphoreGiveRecursive(handle) == pdTRUE);
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
+    });
   }
 
  private:
@@ -270,6 +685,11 @@ class RecursiveMutexBase : public MutexBase {
 
   RecursiveMutexBase(RecursiveMutexBase&&) noexcept = default;
   RecursiveMutexBase& operator=(RecursiveMutexBase&&) noexcept = default;
+
+  // Only written by the task that holds the mutex.  Another task may read a
+  // stale owner, but never its own handle, so it always takes the kernel path.
+  mutable TaskHandle_t owner = NULL;
+  mutable UBaseType_t nesting = 0;
 };
 
 #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
@@ -433,8 +853,23 @@ class StaticMutex : public MutexBase {
    * @include Mutex/staticMutex.cpp
    */
   StaticMutex() {
-    this->handle = xSemaphoreCreateMutexStatic(&staticMutex);
+    create();
   }
+
+  /**
+   * Mutex.hpp
+   *
+   * @brief Construct a new StaticMutex object without creating the mutex.
+   *
+   * This constructor is constexpr, so a global object constructed with it is
+   * constant initialized, unless FREERTOS_CPP_MUTEX_PROFILER is 1.  create()
+   * must be called before the mutex is used.
+   */
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+  explicit StaticMutex(DeferCreate) : staticMutex() {}
+#else
+  constexpr explicit StaticMutex(DeferCreate) : staticMutex() {}
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
   ~StaticMutex() = default;
 
   StaticMutex(const StaticMutex&) = delete;
@@ -443,6 +878,24 @@ class StaticMutex : public MutexBase {
   StaticMutex(StaticMutex&&) noexcept = default;
   StaticMutex& operator=(StaticMutex&&) noexcept = default;
 
+  /**
+   * Mutex.hpp
+   *
+   * @brief Function that calls <tt>SemaphoreHandle_t
+   * xSemaphoreCreateMutexStatic( StaticSemaphore_t *pxMutexBuffer )</tt> to
+   * create a mutex that was constructed with FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/xSemaphoreCreateMutexStatic.html>
+   *
+   * @retval true If the mutex was created.
+   * @retval false Otherwise.
+   */
+  bool create() {
+    configASSERT(this->handle == NULL);
+    this->handle = xSemaphoreCreateMutexStatic(&staticMutex);
+    return (this->handle != NULL);
+  }
+
  private:
   StaticSemaphore_t staticMutex;
 };
@@ -492,8 +945,25 @@ class StaticRecursiveMutex : public RecursiveMutexBase {
    * @include Mutex/staticRecursiveMutex.cpp
    */
   StaticRecursiveMutex() {
-    this->handle = xSemaphoreCreateRecursiveMutexStatic(&staticRecursiveMutex);
+    create();
   }
+
+  /**
+   * Mutex.hpp
+   *
+   * @brief Construct a new StaticRecursiveMutex object without creating the
+   * recursive mutex.
+   *
+   * This constructor is constexpr, so a global object constructed with it is
+   * constant initialized, unless FREERTOS_CPP_MUTEX_PROFILER is 1.  create()
+   * must be called before the recursive mutex is used.
+   */
+#if (FREERTOS_CPP_MUTEX_PROFILER == 1)
+  explicit StaticRecursiveMutex(DeferCreate) : staticRecursiveMutex() {}
+#else
+  constexpr explicit StaticRecursiveMutex(DeferCreate)
+      : staticRecursiveMutex() {}
+#endif /* FREERTOS_CPP_MUTEX_PROFILER */
   ~StaticRecursiveMutex() = default;
 
   StaticRecursiveMutex(const StaticRecursiveMutex&) = delete;
@@ -502,6 +972,25 @@ class StaticRecursiveMutex : public RecursiveMutexBase {
   StaticRecursiveMutex(StaticRecursiveMutex&&) noexcept = default;
   StaticRecursiveMutex& operator=(StaticRecursiveMutex&&) noexcept = default;
 
+  /**
+   * Mutex.hpp
+   *
+   * @brief Function that calls <tt>SemaphoreHandle_t
+   * xSemaphoreCreateRecursiveMutexStatic( StaticSemaphore_t *pxMutexBuffer
+   * )</tt> to create a recursive mutex that was constructed with
+   * FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/xSemaphoreCreateRecursiveMutexStatic.html>
+   *
+   * @retval true If the recursive mutex was created.
+   * @retval false Otherwise.
+   */
+  bool create() {
+    configASSERT(this->handle == NULL);
+    this->handle = xSemaphoreCreateRecursiveMutexStatic(&staticRecursiveMutex);
+    return (this->handle != NULL);
+  }
+
  private:
   StaticSemaphore_t staticRecursiveMutex;
 };
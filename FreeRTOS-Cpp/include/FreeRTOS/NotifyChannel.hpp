@@ -0,0 +1,295 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_NOTIFYCHANNEL_HPP
+#define FREERTOS_NOTIFYCHANNEL_HPP
+
+#include <FreeRTOS/Task.hpp>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class NotifyChannel NotifyChannel.hpp <FreeRTOS/NotifyChannel.hpp>
+ *
+ * @brief Class that sends 32-bit payloads to a single receiving task through
+ * one of its indexed task notification values.
+ *
+ * A NotifyChannel needs no kernel object of its own.  The only state it holds
+ * is the handle of the receiving task, and the payload is stored in the
+ * receiving task's notification value at index Index.  It is a lighter
+ * alternative to a FreeRTOS::Queue of length 1 when there is exactly one
+ * receiving task.
+ *
+ * A payload can be sent with send(), which fails if the previous payload has
+ * not been received yet, or with overwrite(), which always replaces it.
+ *
+ * @warning The notification at index Index of the receiving task must not be
+ * used for any other purpose.  Use a different Index for each channel that
+ * sends to the same task.
+ *
+ * @tparam Index The index within the receiving task's array of notification
+ * values that carries the payload.
+ * @tparam T Type of the payload.  Must be trivially copyable and no larger than
+ * 32 bits.
+ *
+ * <b>Example Usage</b>
+ * @include NotifyChannel/notifyChannel.cpp
+ */
+template <UBaseType_t Index, class T = uint32_t>
+class NotifyChannel {
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+  static_assert(std::is_trivially_copyable_v<T>,
+                "NotifyChannel payloads must be trivially copyable.");
+  static_assert(sizeof(T) <= sizeof(uint32_t),
+                "NotifyChannel payloads must fit in 32 bits.");
+
+ public:
+  /**
+   * NotifyChannel.hpp
+   *
+   * @brief Construct a new NotifyChannel object that sends to receiver.
+   *
+   * @param receiver The task that receives the payloads.  It must outlive the
+   * channel.
+   */
+  explicit NotifyChannel(const TaskBase& receiver) : handle(receiver.handle) {}
+  ~NotifyChannel() = default;
+
+  NotifyChannel(const NotifyChannel&) = default;
+  NotifyChannel& operator=(const NotifyChannel&) = default;
+
+  /**
+   * NotifyChannel.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskNotifyIndexed(
+   * TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+   * eNotifyAction eAction )</tt> with <tt>eSetValueWithoutOverwrite</tt>
+   *
+   * @see <https://www.freertos.org/xTaskNotify.html>
+   *
+   * @param value The payload to send.
+   * @retval true The payload was sent.
+   * @retval false The receiving task had not yet received the previous
+   * payload, so value was not sent.
+   */
+  inline bool send(const T& value) const {
+    return (xTaskNotifyIndexed(handle, Index, encode(value),
+                               eSetValueWithoutOverwrite) == pdPASS);
+  }
+
+  /**
+   * NotifyChannel.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskNotifyIndexedFromISR(
+   * TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+   * eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken )</tt> with
+   * <tt>eSetValueWithoutOverwrite</tt>
+   *
+   * @see <https://www.freertos.org/xTaskNotifyFromISR.html>
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * sending the payload caused the receiving task to unblock, and the receiving
+   * task has a priority higher than the currently running task.
+   * @param value The payload to send.
+   * @retval true The payload was sent.
+   * @retval false The receiving task had not yet received the previous
+   * payload, so value was not sent.
+   */
+  inline bool sendFromISR(bool& higherPriorityTaskWoken, const T& value) const {
+    BaseType_t taskWoken = pdFALSE;
+    const bool result =
+        (xTaskNotifyIndexedFromISR(handle, Index, encode(value),
+                                   eSetValueWithoutOverwrite,
+                                   &taskWoken) == pdPASS);
+    if (taskWoken == pdTRUE) {
+      higherPriorityTaskWoken = true;
+    }
+    return result;
+  }
+
+  /**
+   * NotifyChannel.hpp
+   *
+   * @overload
+   */
+  inline bool sendFromISR(const T& value) const {
+    return (xTaskNotifyIndexedFromISR(handle, Index, encode(value),
+                                      eSetValueWithoutOverwrite,
+                                      NULL) == pdPASS);
+  }
+
+  /**
+   * NotifyChannel.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskNotifyIndexed(
+   * TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+   * eNotifyAction eAction )</tt> with <tt>eSetValueWithOverwrite</tt>
+   *
+   * @see <https://www.freertos.org/xTaskNotify.html>
+   *
+   * @param value The payload to send.  It replaces any payload that has not
+   * been received yet.
+   */
+  inline void overwrite(const T& value) const {
+    xTaskNotifyIndexed(handle, Index, encode(value), eSetValueWithOverwrite);
+  }
+
+  /**
+   * NotifyChannel.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskNotifyIndexedFromISR(
+   * TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+   * eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken )</tt> with
+   * <tt>eSetValueWithOverwrite</tt>
+   *
+   * @see <https://www.freertos.org/xTaskNotifyFromISR.html>
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * sending the payload caused the receiving task to unblock, and the receiving
+   * task has a priority higher than the currently running task.
+   * @param value The payload to send.  It replaces any payload that has not
+   * been received yet.
+   */
+  inline void overwriteFromISR(bool& higherPriorityTaskWoken,
+                               const T& value) const {
+    BaseType_t taskWoken = pdFALSE;
+    xTaskNotifyIndexedFromISR(handle, Index, encode(value),
+                              eSetValueWithOverwrite, &taskWoken);
+    if (taskWoken == pdTRUE) {
+      higherPriorityTaskWoken = true;
+    }
+  }
+
+  /**
+   * NotifyChannel.hpp
+   *
+   * @overload
+   */
+  inline void overwriteFromISR(const T& value) const {
+    xTaskNotifyIndexedFromISR(handle, Index, encode(value),
+                              eSetValueWithOverwrite, NULL);
+  }
+
+  /**
+   * NotifyChannel.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskNotifyWaitIndexed(
+   * UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t
+   * ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t
+   * xTicksToWait )</tt>
+   *
+   * @see <https://www.freertos.org/xTaskNotifyWait.html>
+   *
+   * @warning This function must only be called by the receiving task.
+   *
+   * @param value Reference the payload is copied into.  It is left unmodified
+   * if no payload was received.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for a payload should none be pending at the time of the call.
+   * @retval true A payload was received.
+   * @retval false No payload was received before ticksToWait expired.
+   */
+  inline bool receive(T& value,
+                      const TickType_t ticksToWait = portMAX_DELAY) const {
+#if (INCLUDE_xTaskGetCurrentTaskHandle == 1)
+    configASSERT(xTaskGetCurrentTaskHandle() == handle);
+#endif
+    uint32_t notificationValue = 0;
+    if (xTaskNotifyWaitIndexed(Index, 0, 0, &notificationValue,
+                               ticksToWait) != pdTRUE) {
+      return false;
+    }
+    std::memcpy(&value, &notificationValue, sizeof(T));
+    return true;
+  }
+
+  /**
+   * NotifyChannel.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskNotifyWaitIndexed(
+   * UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t
+   * ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t
+   * xTicksToWait )</tt>
+   *
+   * @see <https://www.freertos.org/xTaskNotifyWait.html>
+   *
+   * @warning This function must only be called by the receiving task.
+   *
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for a payload should none be pending at the time of the call.
+   * @return std::optional<T> The received payload.  User should check that the
+   * value is present.
+   */
+  inline std::optional<T> receive(
+      const TickType_t ticksToWait = portMAX_DELAY) const {
+    T value;
+    return receive(value, ticksToWait) ? std::optional<T>(value)
+                                       : std::nullopt;
+  }
+
+  /**
+   * NotifyChannel.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskNotifyStateClearIndexed(
+   * TaskHandle_t xTask, UBaseType_t uxIndexToClear )</tt>
+   *
+   * @see <https://www.freertos.org/xTaskNotifyStateClear.html>
+   *
+   * Discards a payload that has been sent but not yet received.
+   *
+   * @retval true A payload was pending and has been discarded.
+   * @retval false No payload was pending.
+   */
+  inline bool clear() const {
+    return (xTaskNotifyStateClearIndexed(handle, Index) == pdTRUE);
+  }
+
+ private:
+  inline static uint32_t encode(const T& value) {
+    uint32_t notificationValue = 0;
+    std::memcpy(&notificationValue, &value, sizeof(T));
+    return notificationValue;
+  }
+
+  TaskHandle_t handle = NULL;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+#endif  // FREERTOS_NOTIFYCHANNEL_HPP
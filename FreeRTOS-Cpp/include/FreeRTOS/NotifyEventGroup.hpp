@@ -0,0 +1,341 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_NOTIFYEVENTGROUP_HPP
+#define FREERTOS_NOTIFYEVENTGROUP_HPP
+
+#include <FreeRTOS/Deadline.hpp>
+#include <FreeRTOS/ObjectLock.hpp>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class NotifyEventGroup NotifyEventGroup.hpp <FreeRTOS/NotifyEventGroup.hpp>
+ *
+ * @brief Class that behaves like a FreeRTOS::EventGroup waited on by at most
+ * MaxWaiters tasks at a time, and that wakes those tasks directly from
+ * setFromISR().
+ *
+ * FreeRTOS::EventGroupBase::setFromISR() defers the work to the timer service
+ * task, so every interrupt costs a switch to that task and a slot in the timer
+ * command queue, and fails when a burst of interrupts fills that queue.  A
+ * NotifyEventGroup keeps its 32 bits and a table of MaxWaiters waiters in the
+ * object, protected by a FreeRTOS::ObjectLock.  set() and setFromISR() update
+ * the bits, mark every waiter whose condition is now met and give that task's
+ * notification at index Index, so they never fail and the woken task runs
+ * straight after the interrupt.
+ *
+ * As with an event group a waiter can wait for any or all of a set of bits, and
+ * can have the bits it waited for cleared atomically when its condition is
+ * met.  Unlike an event group all 32 bits are available.
+ *
+ * @warning The notification at index Index of a waiting task must not be used
+ * for any other purpose while it waits.  wait() asserts if more than
+ * MaxWaiters tasks wait at the same time.
+ *
+ * @tparam Index The index within each waiting task's array of notification
+ * values that is used to wake it.
+ * @tparam MaxWaiters The largest number of tasks that can wait at the same
+ * time.
+ *
+ * <b>Example Usage</b>
+ * @include NotifyEventGroup/notifyEventGroup.cpp
+ */
+template <UBaseType_t Index = 0, UBaseType_t MaxWaiters = 1>
+class NotifyEventGroup {
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+  static_assert(MaxWaiters > 0, "MaxWaiters must be at least 1.");
+
+ public:
+  NotifyEventGroup() = default;
+  ~NotifyEventGroup() = default;
+
+  NotifyEventGroup(const NotifyEventGroup&) = delete;
+  NotifyEventGroup& operator=(const NotifyEventGroup&) = delete;
+
+  /**
+   * NotifyEventGroup.hpp
+   *
+   * @brief Function that blocks until any or all of bitsToWaitFor are set,
+   * like FreeRTOS::EventGroupBase::wait().
+   *
+   * @warning This function cannot be called from an interrupt.
+   *
+   * @param bitsToWaitFor A bitwise value that indicates the bit or bits to wait
+   * for.  It must not be 0.
+   * @param clearOnExit If true the bits in bitsToWaitFor are cleared when the
+   * condition is met.  They are not cleared if wait() times out.
+   * @param waitForAllBits If true wait() waits for all of bitsToWaitFor to be
+   * set, otherwise for any of them.
+   * @param ticksToWait The maximum amount of time to wait.
+   * @return uint32_t The value of the bits when the condition was met, before
+   * any were cleared, or the value of the bits when ticksToWait expired.  Test
+   * the returned value to know which of these happened.
+   */
+  uint32_t wait(const uint32_t bitsToWaitFor, const bool clearOnExit = false,
+                const bool waitForAllBits = false,
+                const TickType_t ticksToWait = portMAX_DELAY) {
+    configASSERT(bitsToWaitFor != 0);
+
+    Waiter* waiter = NULL;
+    lock.enter();
+    const uint32_t current = bits;
+    if (isMet(current, bitsToWaitFor, waitForAllBits)) {
+      if (clearOnExit) {
+        bits &= ~bitsToWaitFor;
+      }
+      lock.exit();
+      return current;
+    }
+    if (ticksToWait != 0) {
+      waiter = claim(bitsToWaitFor, clearOnExit, waitForAllBits);
+    }
+    lock.exit();
+
+    if (waiter == NULL) {
+      return current;
+    }
+
+    const Deadline deadline(ticksToWait);
+    for (;;) {
+      const bool notified =
+          (ulTaskNotifyTakeIndexed(Index, pdTRUE, deadline) != 0);
+      lock.enter();
+      // A notification without the met flag is left over from an earlier
+      // wait, so keep waiting.
+      if (waiter->met || !notified) {
+        const uint32_t result = waiter->met ? waiter->result : bits;
+        waiter->task = NULL;
+        lock.exit();
+        return result;
+      }
+      lock.exit();
+    }
+  }
+
+  /**
+   * NotifyEventGroup.hpp
+   *
+   * @brief Function that sets bitsToSet and wakes every waiter whose condition
+   * is met, like FreeRTOS::EventGroupBase::set().
+   *
+   * @param bitsToSet A bitwise value that indicates the bit or bits to set.
+   * @return uint32_t The value of the bits when set() returns, after the bits
+   * of woken waiters that asked for clearOnExit were cleared.
+   */
+  uint32_t set(const uint32_t bitsToSet) {
+    TaskHandle_t woken[MaxWaiters];
+    UBaseType_t count = 0;
+
+    lock.enter();
+    const uint32_t value = update(bitsToSet, woken, count);
+    lock.exit();
+
+    for (UBaseType_t i = 0; i < count; i++) {
+      xTaskNotifyGiveIndexed(woken[i], Index);
+    }
+    return value;
+  }
+
+  /**
+   * NotifyEventGroup.hpp
+   *
+   * @brief Function that sets bitsToSet from an interrupt and wakes every
+   * waiter whose condition is met without involving the timer service task.
+   *
+   * @param higherPriorityTaskWoken setFromISR() will set
+   * higherPriorityTaskWoken to true if a woken waiter has a priority higher
+   * than the currently running task.
+   * @param bitsToSet A bitwise value that indicates the bit or bits to set.
+   * @return uint32_t The value of the bits when setFromISR() returns, after the
+   * bits of woken waiters that asked for clearOnExit were cleared.
+   */
+  uint32_t setFromISR(bool& higherPriorityTaskWoken, const uint32_t bitsToSet) {
+    TaskHandle_t woken[MaxWaiters];
+    UBaseType_t count = 0;
+
+    const UBaseType_t status = lock.enterFromISR();
+    const uint32_t value = update(bitsToSet, woken, count);
+    lock.exitFromISR(status);
+
+    for (UBaseType_t i = 0; i < count; i++) {
+      BaseType_t taskWoken = pdFALSE;
+      vTaskNotifyGiveIndexedFromISR(woken[i], Index, &taskWoken);
+      if (taskWoken == pdTRUE) {
+        higherPriorityTaskWoken = true;
+      }
+    }
+    return value;
+  }
+
+  /**
+   * NotifyEventGroup.hpp
+   *
+   * @brief Function that sets bitsToSet from an interrupt and wakes every
+   * waiter whose condition is met without involving the timer service task.
+   *
+   * @overload
+   */
+  uint32_t setFromISR(const uint32_t bitsToSet) {
+    bool higherPriorityTaskWoken = false;
+    return setFromISR(higherPriorityTaskWoken, bitsToSet);
+  }
+
+  /**
+   * NotifyEventGroup.hpp
+   *
+   * @brief Function that clears bitsToClear.
+   *
+   * @param bitsToClear A bitwise value that indicates the bit or bits to
+   * clear.
+   * @return uint32_t The value of the bits before they were cleared.
+   */
+  inline uint32_t clear(const uint32_t bitsToClear) {
+    const ObjectLock::Guard guard(lock);
+    const uint32_t value = bits;
+    bits &= ~bitsToClear;
+    return value;
+  }
+
+  /**
+   * NotifyEventGroup.hpp
+   *
+   * @brief Function that clears bitsToClear from an interrupt.
+   *
+   * @param bitsToClear A bitwise value that indicates the bit or bits to
+   * clear.
+   * @return uint32_t The value of the bits before they were cleared.
+   */
+  inline uint32_t clearFromISR(const uint32_t bitsToClear) {
+    const UBaseType_t status = lock.enterFromISR();
+    const uint32_t value = bits;
+    bits &= ~bitsToClear;
+    lock.exitFromISR(status);
+    return value;
+  }
+
+  /**
+   * NotifyEventGroup.hpp
+   *
+   * @brief Function that returns the current value of the bits.
+   *
+   * @return uint32_t The current value of the bits.
+   */
+  inline uint32_t get() const {
+    const ObjectLock::Guard guard(lock);
+    return bits;
+  }
+
+  /**
+   * NotifyEventGroup.hpp
+   *
+   * @brief Function that returns the current value of the bits from an
+   * interrupt.
+   *
+   * @return uint32_t The current value of the bits.
+   */
+  inline uint32_t getFromISR() const {
+    const UBaseType_t status = lock.enterFromISR();
+    const uint32_t value = bits;
+    lock.exitFromISR(status);
+    return value;
+  }
+
+ private:
+  struct Waiter {
+    TaskHandle_t task = NULL;
+    uint32_t bitsToWaitFor = 0;
+    uint32_t result = 0;
+    bool clearOnExit = false;
+    bool waitForAllBits = false;
+    bool met = false;
+  };
+
+  inline static bool isMet(const uint32_t value, const uint32_t bitsToWaitFor,
+                           const bool waitForAllBits) {
+    return waitForAllBits ? ((value & bitsToWaitFor) == bitsToWaitFor)
+                          : ((value & bitsToWaitFor) != 0);
+  }
+
+  // Must be called with the lock held.
+  Waiter* claim(const uint32_t bitsToWaitFor, const bool clearOnExit,
+                const bool waitForAllBits) {
+    for (Waiter& waiter : waiters) {
+      if (waiter.task == NULL) {
+        waiter.task = xTaskGetCurrentTaskHandle();
+        waiter.bitsToWaitFor = bitsToWaitFor;
+        waiter.clearOnExit = clearOnExit;
+        waiter.waitForAllBits = waitForAllBits;
+        waiter.met = false;
+        return &waiter;
+      }
+    }
+    configASSERT(false);
+    return NULL;
+  }
+
+  // Must be called with the lock held.  The tasks to wake are copied out so
+  // that they can be notified after the lock is released, as a waiter that
+  // times out may free its slot as soon as the lock is released.
+  uint32_t update(const uint32_t bitsToSet, TaskHandle_t* woken,
+                  UBaseType_t& count) {
+    bits |= bitsToSet;
+    uint32_t bitsToClear = 0;
+    for (Waiter& waiter : waiters) {
+      if ((waiter.task != NULL) && !waiter.met &&
+          isMet(bits, waiter.bitsToWaitFor, waiter.waitForAllBits)) {
+        waiter.met = true;
+        waiter.result = bits;
+        if (waiter.clearOnExit) {
+          bitsToClear |= waiter.bitsToWaitFor;
+        }
+        woken[count++] = waiter.task;
+      }
+    }
+    bits &= ~bitsToClear;
+    return bits;
+  }
+
+  ObjectLock lock;
+  uint32_t bits = 0;
+  Waiter waiters[MaxWaiters];
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+#endif  // FREERTOS_NOTIFYEVENTGROUP_HPP
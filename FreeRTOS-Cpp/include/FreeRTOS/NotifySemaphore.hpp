@@ -0,0 +1,364 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_NOTIFYSEMAPHORE_HPP
+#define FREERTOS_NOTIFYSEMAPHORE_HPP
+
+#include <FreeRTOS/Task.hpp>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class NotifySemaphore NotifySemaphore.hpp <FreeRTOS/NotifySemaphore.hpp>
+ *
+ * @brief Class that behaves like a FreeRTOS::BinarySemaphore that only one
+ * task ever takes, implemented with one of that task's indexed task
+ * notification values.
+ *
+ * A NotifySemaphore needs no kernel object of its own, so it saves the RAM of
+ * a semaphore control block, and giving it unblocks the waiting task faster
+ * than giving a semaphore does.  It provides the same give(), giveFromISR() and
+ * take() functions as FreeRTOS::SemaphoreBase, so it can replace a binary
+ * semaphore that has a single known taker.
+ *
+ * @warning take() must only be called by the task passed to the constructor,
+ * and there is no equivalent of takeFromISR().  The notification at index
+ * Index of that task must not be used for any other purpose.
+ *
+ * @tparam Index The index within the taking task's array of notification
+ * values that holds the semaphore.
+ *
+ * <b>Example Usage</b>
+ * @include NotifySemaphore/notifySemaphore.cpp
+ */
+template <UBaseType_t Index = 0>
+class NotifySemaphore {
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+
+ public:
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Construct a new NotifySemaphore object that is taken by taker.  The
+   * semaphore starts out empty.
+   *
+   * @param taker The only task that takes the semaphore.  It must outlive the
+   * semaphore.
+   */
+  explicit NotifySemaphore(const TaskBase& taker) : handle(taker.handle) {}
+  ~NotifySemaphore() = default;
+
+  NotifySemaphore(const NotifySemaphore&) = default;
+  NotifySemaphore& operator=(const NotifySemaphore&) = default;
+
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Function that checks if the taking task handle is not NULL.
+   *
+   * @retval true the handle is not NULL.
+   * @retval false the handle is NULL.
+   */
+  inline bool isValid() const {
+    return (handle != NULL);
+  }
+
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Function that calls <tt>uint32_t ulTaskNotifyValueClearIndexed(
+   * TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear
+   * )</tt> without clearing any bits.
+   *
+   * @see <https://www.freertos.org/ulTasknotifyValueClear.html>
+   *
+   * @return UBaseType_t 1 if the semaphore is available, otherwise 0.
+   */
+  inline UBaseType_t getCount() const {
+    return (ulTaskNotifyValueClearIndexed(handle, Index, 0) != 0) ? 1 : 0;
+  }
+
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Function that calls <tt>uint32_t ulTaskNotifyTakeIndexed(
+   * UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t
+   * xTicksToWait )</tt>
+   *
+   * @see <https://www.freertos.org/ulTaskNotifyTake.html>
+   *
+   * @warning This function must only be called by the taking task.
+   *
+   * @param ticksToWait The time in ticks to wait for the semaphore to become
+   * available.  A block time of zero can be used to poll the semaphore.
+   * @retval true If the semaphore was obtained.
+   * @retval false If ticksToWait expired without the semaphore becoming
+   * available.
+   */
+  inline bool take(const TickType_t ticksToWait = portMAX_DELAY) const {
+#if (INCLUDE_xTaskGetCurrentTaskHandle == 1)
+    configASSERT(xTaskGetCurrentTaskHandle() == handle);
+#endif
+    return (ulTaskNotifyTakeIndexed(Index, pdTRUE, ticksToWait) != 0);
+  }
+
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskNotifyIndexed(
+   * TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+   * eNotifyAction eAction )</tt> with <tt>eSetValueWithoutOverwrite</tt>
+   *
+   * @see <https://www.freertos.org/xTaskNotify.html>
+   *
+   * @retval true If the semaphore was released.
+   * @retval false If the semaphore was already available.
+   */
+  inline bool give() const {
+    return (xTaskNotifyIndexed(handle, Index, 1, eSetValueWithoutOverwrite) ==
+            pdPASS);
+  }
+
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskNotifyIndexedFromISR(
+   * TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+   * eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken )</tt> with
+   * <tt>eSetValueWithoutOverwrite</tt>
+   *
+   * @see <https://www.freertos.org/xTaskNotifyFromISR.html>
+   *
+   * @param higherPriorityTaskWoken giveFromISR() will set
+   * higherPriorityTaskWoken to true if giving the semaphore caused the taking
+   * task to unblock, and the taking task has a priority higher than the
+   * currently running task.
+   * @retval true If the semaphore was released.
+   * @retval false If the semaphore was already available.
+   */
+  inline bool giveFromISR(bool& higherPriorityTaskWoken) const {
+    BaseType_t taskWoken = pdFALSE;
+    const bool result =
+        (xTaskNotifyIndexedFromISR(handle, Index, 1, eSetValueWithoutOverwrite,
+                                   &taskWoken) == pdPASS);
+    if (taskWoken == pdTRUE) {
+      higherPriorityTaskWoken = true;
+    }
+    return result;
+  }
+
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskNotifyIndexedFromISR(
+   * TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+   * eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken )</tt> with
+   * <tt>eSetValueWithoutOverwrite</tt>
+   *
+   * @see <https://www.freertos.org/xTaskNotifyFromISR.html>
+   *
+   * @overload
+   */
+  inline bool giveFromISR() const {
+    return (xTaskNotifyIndexedFromISR(handle, Index, 1,
+                                      eSetValueWithoutOverwrite,
+                                      NULL) == pdPASS);
+  }
+
+ private:
+  TaskHandle_t handle = NULL;
+};
+
+/**
+ * @class NotifyCountingSemaphore NotifySemaphore.hpp
+ * <FreeRTOS/NotifySemaphore.hpp>
+ *
+ * @brief Class that behaves like a FreeRTOS::CountingSemaphore that only one
+ * task ever takes, implemented with one of that task's indexed task
+ * notification values.
+ *
+ * Each give() increments the notification value and each take() decrements
+ * it, so events given faster than the taking task handles them are counted
+ * rather than lost.
+ *
+ * @warning take() must only be called by the task passed to the constructor,
+ * and there is no equivalent of takeFromISR().  The notification at index
+ * Index of that task must not be used for any other purpose.  Unlike a
+ * FreeRTOS::CountingSemaphore there is no maximum count, so give() always
+ * succeeds.
+ *
+ * @tparam Index The index within the taking task's array of notification
+ * values that holds the count.
+ *
+ * <b>Example Usage</b>
+ * @include NotifySemaphore/notifyCountingSemaphore.cpp
+ */
+template <UBaseType_t Index = 0>
+class NotifyCountingSemaphore {
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+
+ public:
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Construct a new NotifyCountingSemaphore object that is taken by
+   * taker.  The count starts at zero.
+   *
+   * @param taker The only task that takes the semaphore.  It must outlive the
+   * semaphore.
+   */
+  explicit NotifyCountingSemaphore(const TaskBase& taker)
+      : handle(taker.handle) {}
+  ~NotifyCountingSemaphore() = default;
+
+  NotifyCountingSemaphore(const NotifyCountingSemaphore&) = default;
+  NotifyCountingSemaphore& operator=(const NotifyCountingSemaphore&) = default;
+
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Function that checks if the taking task handle is not NULL.
+   *
+   * @retval true the handle is not NULL.
+   * @retval false the handle is NULL.
+   */
+  inline bool isValid() const {
+    return (handle != NULL);
+  }
+
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Function that calls <tt>uint32_t ulTaskNotifyValueClearIndexed(
+   * TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear
+   * )</tt> without clearing any bits.
+   *
+   * @see <https://www.freertos.org/ulTasknotifyValueClear.html>
+   *
+   * @return UBaseType_t The current count.
+   */
+  inline UBaseType_t getCount() const {
+    return ulTaskNotifyValueClearIndexed(handle, Index, 0);
+  }
+
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Function that calls <tt>uint32_t ulTaskNotifyTakeIndexed(
+   * UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t
+   * xTicksToWait )</tt> so that the count is decremented on exit.
+   *
+   * @see <https://www.freertos.org/ulTaskNotifyTake.html>
+   *
+   * @warning This function must only be called by the taking task.
+   *
+   * @param ticksToWait The time in ticks to wait for the count to become
+   * non-zero.  A block time of zero can be used to poll the semaphore.
+   * @retval true If the semaphore was obtained.
+   * @retval false If ticksToWait expired without the semaphore becoming
+   * available.
+   */
+  inline bool take(const TickType_t ticksToWait = portMAX_DELAY) const {
+#if (INCLUDE_xTaskGetCurrentTaskHandle == 1)
+    configASSERT(xTaskGetCurrentTaskHandle() == handle);
+#endif
+    return (ulTaskNotifyTakeIndexed(Index, pdFALSE, ticksToWait) != 0);
+  }
+
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskNotifyGiveIndexed(
+   * TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify )</tt>
+   *
+   * @see <https://www.freertos.org/xTaskNotifyGive.html>
+   *
+   * @retval true Always, as the count has no maximum.
+   */
+  inline bool give() const {
+    return (xTaskNotifyGiveIndexed(handle, Index) == pdPASS);
+  }
+
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Function that calls <tt>void vTaskNotifyGiveIndexedFromISR(
+   * TaskHandle_t xTaskHandle, UBaseType_t uxIndexToNotify, BaseType_t
+   * *pxHigherPriorityTaskWoken )</tt>
+   *
+   * @see <https://www.freertos.org/vTaskNotifyGiveFromISR.html>
+   *
+   * @param higherPriorityTaskWoken giveFromISR() will set
+   * higherPriorityTaskWoken to true if giving the semaphore caused the taking
+   * task to unblock, and the taking task has a priority higher than the
+   * currently running task.
+   * @retval true Always, as the count has no maximum.
+   */
+  inline bool giveFromISR(bool& higherPriorityTaskWoken) const {
+    BaseType_t taskWoken = pdFALSE;
+    vTaskNotifyGiveIndexedFromISR(handle, Index, &taskWoken);
+    if (taskWoken == pdTRUE) {
+      higherPriorityTaskWoken = true;
+    }
+    return true;
+  }
+
+  /**
+   * NotifySemaphore.hpp
+   *
+   * @brief Function that calls <tt>void vTaskNotifyGiveIndexedFromISR(
+   * TaskHandle_t xTaskHandle, UBaseType_t uxIndexToNotify, BaseType_t
+   * *pxHigherPriorityTaskWoken )</tt>
+   *
+   * @see <https://www.freertos.org/vTaskNotifyGiveFromISR.html>
+   *
+   * @overload
+   */
+  inline bool giveFromISR() const {
+    vTaskNotifyGiveIndexedFromISR(handle, Index, NULL);
+    return true;
+  }
+
+ private:
+  TaskHandle_t handle = NULL;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+#endif  // FREERTOS_NOTIFYSEMAPHORE_HPP
@@ -0,0 +1,185 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_OBJECTLOCK_HPP
+#define FREERTOS_OBJECTLOCK_HPP
+
+#include <FreeRTOS/SpinLock.hpp>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Set FREERTOS_CPP_OBJECT_LOCKS to 1 to protect the state that the
+ * wrappers keep next to each kernel object, such as queue statistics, with a
+ * lock of its own instead of the kernel critical section.  It defaults to 1 on
+ * SMP builds whose port defines portUSING_GRANULAR_LOCKS as 1, so that the
+ * wrappers do not bring back the global lock that the kernel avoids, and to 0
+ * otherwise.  It can be set to 1 on any SMP port whose target supports atomic
+ * read modify write operations.
+ */
+#ifndef FREERTOS_CPP_OBJECT_LOCKS
+#if (configNUMBER_OF_CORES > 1) && defined(portUSING_GRANULAR_LOCKS) && \
+    (portUSING_GRANULAR_LOCKS == 1)
+#define FREERTOS_CPP_OBJECT_LOCKS 1
+#else
+#define FREERTOS_CPP_OBJECT_LOCKS 0
+#endif /* portUSING_GRANULAR_LOCKS */
+#endif /* FREERTOS_CPP_OBJECT_LOCKS */
+
+namespace FreeRTOS {
+
+/**
+ * @class ObjectLock ObjectLock.hpp <FreeRTOS/ObjectLock.hpp>
+ *
+ * @brief Class that protects the data of one object, taking only that object's
+ * lock when FREERTOS_CPP_OBJECT_LOCKS is 1.
+ *
+ * On an SMP kernel <tt>taskENTER_CRITICAL()</tt> takes the global task and ISR
+ * locks, so two cores updating the statistics of two unrelated queues wait for
+ * each other.  An ObjectLock masks interrupts on the calling core and spins on
+ * a FreeRTOS::SpinLock that belongs to the object, so only cores using the
+ * same object contend.  Kernels built with granular locks already give each
+ * queue, semaphore and event group its own lock, and the wrappers then do the
+ * same for their own state.
+ *
+ * When FREERTOS_CPP_OBJECT_LOCKS is 0, enter() and exit() are
+ * <tt>taskENTER_CRITICAL()</tt> and <tt>taskEXIT_CRITICAL()</tt>, and the
+ * object holds no lock word, so single core builds are unchanged.
+ *
+ * @warning Hold the lock for a few instructions only and never call a FreeRTOS
+ * API function while holding it.  The lock is not recursive.
+ *
+ * <b>Example Usage</b>
+ * @include ObjectLock/objectLock.cpp
+ */
+class ObjectLock {
+ public:
+  /**
+   * @class Guard ObjectLock.hpp <FreeRTOS/ObjectLock.hpp>
+   *
+   * @brief Class that calls enter() when it is constructed and exit() when it
+   * goes out of scope.
+   */
+  class Guard {
+   public:
+    explicit Guard(const ObjectLock& objectLock) : objectLock(objectLock) {
+      objectLock.enter();
+    }
+    ~Guard() {
+      objectLock.exit();
+    }
+
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+   private:
+    const ObjectLock& objectLock;
+  };
+
+  ObjectLock() = default;
+  ~ObjectLock() = default;
+
+  ObjectLock(const ObjectLock&) = delete;
+  ObjectLock& operator=(const ObjectLock&) = delete;
+
+  // A moved object gets a lock of its own.  Neither object may be locked.
+  ObjectLock(ObjectLock&&) noexcept {}
+  ObjectLock& operator=(ObjectLock&&) noexcept {
+    return *this;
+  }
+
+  /**
+   * ObjectLock.hpp
+   *
+   * @brief Function that enters the section protected by the lock from a task.
+   */
+  inline void enter() const {
+#if (FREERTOS_CPP_OBJECT_LOCKS == 1)
+    spinLock.lockFromISR();
+#else
+    taskENTER_CRITICAL();
+#endif /* FREERTOS_CPP_OBJECT_LOCKS */
+  }
+
+  /**
+   * ObjectLock.hpp
+   *
+   * @brief Function that leaves the section entered with enter().
+   */
+  inline void exit() const {
+#if (FREERTOS_CPP_OBJECT_LOCKS == 1)
+    spinLock.unlockFromISR();
+#else
+    taskEXIT_CRITICAL();
+#endif /* FREERTOS_CPP_OBJECT_LOCKS */
+  }
+
+  /**
+   * ObjectLock.hpp
+   *
+   * @brief Function that enters the section protected by the lock from an
+   * interrupt service routine.
+   *
+   * @return UBaseType_t The value to pass to exitFromISR().
+   */
+  inline UBaseType_t enterFromISR() const {
+#if (FREERTOS_CPP_OBJECT_LOCKS == 1)
+    spinLock.lockFromISR();
+    return 0;
+#else
+    return taskENTER_CRITICAL_FROM_ISR();
+#endif /* FREERTOS_CPP_OBJECT_LOCKS */
+  }
+
+  /**
+   * ObjectLock.hpp
+   *
+   * @brief Function that leaves the section entered with enterFromISR().
+   *
+   * @param status The value returned by the matching enterFromISR().
+   */
+  inline void exitFromISR(const UBaseType_t status) const {
+#if (FREERTOS_CPP_OBJECT_LOCKS == 1)
+    static_cast<void>(status);
+    spinLock.unlockFromISR();
+#else
+    taskEXIT_CRITICAL_FROM_ISR(status);
+#endif /* FREERTOS_CPP_OBJECT_LOCKS */
+  }
+
+ private:
+#if (FREERTOS_CPP_OBJECT_LOCKS == 1)
+  // The previous interrupt mask is saved inside the spin lock, so the task and
+  // interrupt versions are the same.
+  mutable SpinLock<> spinLock;
+#endif /* FREERTOS_CPP_OBJECT_LOCKS */
+};
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_OBJECTLOCK_HPP
@@ -0,0 +1,290 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_OBJECTREGISTRY_HPP
+#define FREERTOS_OBJECTREGISTRY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+namespace FreeRTOS {
+
+class TaskBase;
+template <class T>
+class QueueBase;
+class SemaphoreBase;
+class MutexBase;
+class RecursiveMutexBase;
+class TimerBase;
+class EventGroupBase;
+class StreamBufferBase;
+class MessageBufferBase;
+
+/**
+ * @class ObjectRegistry ObjectRegistry.hpp <FreeRTOS/ObjectRegistry.hpp>
+ *
+ * @brief Class that finds tasks, queues, semaphores, mutexes, timers, event
+ * groups and buffers by name in constant time.
+ *
+ * <tt>xTaskGetHandle()</tt> walks every task list comparing names, and the
+ * queue registry is an array that is searched from the start.  This registry
+ * is an open addressing hash table with Capacity slots.  A lookup hashes the
+ * name, compares the stored hashes of the slots it probes, and compares the
+ * strings only when the hashes match, so while the table is less than about
+ * three quarters full a lookup costs one hash of the name and, on average,
+ * fewer than two probes.
+ *
+ * Objects are stored with the type they are looked up as, and find() only
+ * returns an object registered under that type.  Any object derived from one
+ * of the wrapper base classes, such as FreeRTOS::StaticTask or
+ * FreeRTOS::Queue<T>, is stored as its base class, that is FreeRTOS::TaskBase
+ * or FreeRTOS::QueueBase<T>, so it is found by that type whichever derived
+ * class it is.  Other types are stored as themselves.
+ *
+ * The registry stores the name pointer, not a copy, so the name must outlive
+ * the registration.  All functions use critical sections and must not be
+ * called from an interrupt.
+ *
+ * @tparam Capacity The number of slots.  Must be a power of two.
+ *
+ * <b>Example Usage</b>
+ * @include ObjectRegistry/objectRegistry.cpp
+ */
+template <size_t Capacity>
+class ObjectRegistry {
+  static_assert((Capacity > 0) && ((Capacity & (Capacity - 1)) == 0),
+                "The capacity of an ObjectRegistry must be a power of two.");
+
+  // Overloads that are never defined.  Overload resolution picks the most
+  // derived wrapper base class of an object, or NotWrapped for other types.
+  struct NotWrapped {};
+  static TaskBase* keyOf(TaskBase*);
+  template <class U>
+  static QueueBase<U>* keyOf(QueueBase<U>*);
+  static SemaphoreBase* keyOf(SemaphoreBase*);
+  static RecursiveMutexBase* keyOf(RecursiveMutexBase*);
+  static MutexBase* keyOf(MutexBase*);
+  static TimerBase* keyOf(TimerBase*);
+  static EventGroupBase* keyOf(EventGroupBase*);
+  static StreamBufferBase* keyOf(StreamBufferBase*);
+  static MessageBufferBase* keyOf(MessageBufferBase*);
+  static NotWrapped* keyOf(const volatile void*);
+
+  template <class T>
+  using BaseOf = std::remove_pointer_t<decltype(keyOf(
+      static_cast<std::remove_cv_t<T>*>(nullptr)))>;
+
+ public:
+  /**
+   * @brief The type an object of type T is stored and looked up as.
+   */
+  template <class T>
+  using KeyType =
+      std::conditional_t<std::is_same_v<BaseOf<T>, NotWrapped>, T, BaseOf<T>>;
+
+  ObjectRegistry() = default;
+  ~ObjectRegistry() = default;
+
+  ObjectRegistry(const ObjectRegistry&) = delete;
+  ObjectRegistry& operator=(const ObjectRegistry&) = delete;
+
+  /**
+   * ObjectRegistry.hpp
+   *
+   * @brief Function that adds an object to the registry.
+   *
+   * @param name The name to find the object by.  It must outlive the
+   * registration.
+   * @param object The object.  It must be removed before it is destroyed.
+   * @retval true The object was added.
+   * @retval false An object with the same name is already registered, or the
+   * registry is full.
+   */
+  template <class T>
+  bool add(const char* name, T& object) {
+    configASSERT(name != NULL);
+    using Key = KeyType<T>;
+    const uint32_t hashed = hash(name);
+
+    taskENTER_CRITICAL();
+    Slot* free = NULL;
+    bool duplicate = false;
+    for (size_t probe = 0; probe < Capacity; probe++) {
+      Slot& slot = slots[(hashed + probe) & (Capacity - 1)];
+      if (slot.name == NULL) {
+        if (free == NULL) {
+          free = &slot;
+        }
+        break;
+      }
+      if (slot.object == NULL) {
+        if (free == NULL) {
+          free = &slot;
+        }
+      } else if (matches(slot, hashed, name)) {
+        duplicate = true;
+        break;
+      }
+    }
+    const bool added = !duplicate && (free != NULL);
+    if (added) {
+      free->name = name;
+      free->hash = hashed;
+      free->type = typeTag<Key>();
+      free->object = static_cast<Key*>(&object);
+      count++;
+    }
+    taskEXIT_CRITICAL();
+    return added;
+  }
+
+  /**
+   * ObjectRegistry.hpp
+   *
+   * @brief Function that removes an object from the registry.
+   *
+   * @param name The name the object was added with.
+   * @retval true The object was removed.
+   * @retval false No object is registered with this name.
+   */
+  bool remove(const char* name) {
+    const uint32_t hashed = hash(name);
+
+    taskENTER_CRITICAL();
+    Slot* const slot = lookup(hashed, name);
+    if (slot != NULL) {
+      // The name stays behind as a marker, so that probes for names added
+      // after this one do not stop here.
+      slot->object = NULL;
+      slot->type = NULL;
+      count--;
+    }
+    taskEXIT_CRITICAL();
+    return (slot != NULL);
+  }
+
+  /**
+   * ObjectRegistry.hpp
+   *
+   * @brief Function that finds an object by name.
+   *
+   * @tparam T The type the object was stored as, for example
+   * FreeRTOS::TaskBase or FreeRTOS::QueueBase<Message>.
+   * @param name The name the object was added with.
+   * @return T* The object, or NULL if no object of type T is registered with
+   * this name.
+   */
+  template <class T>
+  T* find(const char* name) const {
+    static_assert(std::is_same_v<T, KeyType<T>>,
+                  "Objects derived from a wrapper base class are found by "
+                  "their base class, for example TaskBase.");
+    const uint32_t hashed = hash(name);
+
+    taskENTER_CRITICAL();
+    const Slot* const slot = lookup(hashed, name);
+    void* const object =
+        ((slot != NULL) && (slot->type == typeTag<T>())) ? slot->object : NULL;
+    taskEXIT_CRITICAL();
+    return static_cast<T*>(object);
+  }
+
+  /**
+   * ObjectRegistry.hpp
+   *
+   * @brief Function that returns the number of registered objects.
+   *
+   * @return size_t The number of registered objects.
+   */
+  inline size_t size() const {
+    return count;
+  }
+
+  /**
+   * ObjectRegistry.hpp
+   *
+   * @brief Function that hashes a name the same way the registry does, with
+   * 32-bit FNV-1a.
+   *
+   * @param name The name to hash.
+   * @return uint32_t The hash of name.
+   */
+  static constexpr uint32_t hash(const char* name) {
+    uint32_t value = 2166136261UL;
+    while (*name != '\0') {
+      value = (value ^ static_cast<uint8_t>(*name++)) * 16777619UL;
+    }
+    return value;
+  }
+
+ private:
+  struct Slot {
+    const char* name = NULL;
+    uint32_t hash = 0;
+    const void* type = NULL;
+    void* object = NULL;
+  };
+
+  // The address of this variable identifies T without RTTI.
+  template <class T>
+  static const void* typeTag() {
+    static const char tag = 0;
+    return &tag;
+  }
+
+  static inline bool matches(const Slot& slot, const uint32_t hashed,
+                             const char* name) {
+    return (slot.hash == hashed) &&
+           ((slot.name == name) || (std::strcmp(slot.name, name) == 0));
+  }
+
+  // Must be called in a critical section.
+  Slot* lookup(const uint32_t hashed, const char* name) const {
+    for (size_t probe = 0; probe < Capacity; probe++) {
+      const Slot& slot = slots[(hashed + probe) & (Capacity - 1)];
+      if (slot.name == NULL) {
+        return NULL;
+      }
+      if ((slot.object != NULL) && matches(slot, hashed, name)) {
+        return const_cast<Slot*>(&slot);
+      }
+    }
+    return NULL;
+  }
+
+  Slot slots[Capacity];
+  size_t count = 0;
+};
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_OBJECTREGISTRY_HPP
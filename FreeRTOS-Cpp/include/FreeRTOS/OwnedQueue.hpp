@@ -0,0 +1,417 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_OWNEDQUEUE_HPP
+#define FREERTOS_OWNEDQUEUE_HPP
+
+#include <FreeRTOS/Queue.hpp>
+#include <new>
+#include <utility>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class OwnedQueue OwnedQueue.hpp <FreeRTOS/OwnedQueue.hpp>
+ *
+ * @brief Class that passes large objects between tasks by pointer while keeping
+ * ownership of the object storage.
+ *
+ * Objects are constructed in a fixed pool of N slots that is contained in the
+ * object instance.  Only the pointer to a slot is copied through the underlying
+ * FreeRTOS::StaticQueue, so the cost of sending and receiving is the same no
+ * matter how large T is.  Slots are handed to the user as an
+ * OwnedQueue::Handle, which destroys the object and returns the slot to the
+ * pool when it goes out of scope.
+ *
+ * The pool of free slots is itself a FreeRTOS::StaticQueue of pointers, so
+ * allocating a slot can block with a timeout when the pool is exhausted, and
+ * can be done from an interrupt service routine.
+ *
+ * @tparam T Type to be stored in the queue.
+ * @tparam N The maximum number of objects that can exist at any one time.  This
+ * is also the length of the queue.
+ */
+template <class T, UBaseType_t N>
+class OwnedQueue {
+ public:
+  /**
+   * @class Handle OwnedQueue.hpp <FreeRTOS/OwnedQueue.hpp>
+   *
+   * @brief Move only handle that owns an object allocated from an
+   * FreeRTOS::OwnedQueue pool.
+   */
+  class Handle {
+   public:
+    Handle() = default;
+
+    /**
+     * OwnedQueue.hpp
+     *
+     * @brief Destroy the Handle object, destroying the owned object and
+     * returning its slot to the pool.
+     *
+     * @warning This must not run in an interrupt service routine.  Call
+     * releaseFromISR() before an ISR owned handle goes out of scope.
+     */
+    ~Handle() {
+      reset();
+    }
+
+    Handle(const Handle&) = delete;
+    Handle& operator=(const Handle&) = delete;
+
+    Handle(Handle&& other) noexcept
+        : owner(std::exchange(other.owner, nullptr)),
+          item(std::exchange(other.item, nullptr)) {}
+
+    Handle& operator=(Handle&& other) noexcept {
+      if (this != &other) {
+        reset();
+        owner = std::exchange(other.owner, nullptr);
+        item = std::exchange(other.item, nullptr);
+      }
+      return *this;
+    }
+
+    /**
+     * OwnedQueue.hpp
+     *
+     * @brief Function that checks if the handle owns an object.
+     *
+     * @retval true The handle owns an object.
+     * @retval false The handle is empty.
+     */
+    inline bool isValid() const {
+      return (item != nullptr);
+    }
+
+    inline explicit operator bool() const {
+      return isValid();
+    }
+
+    inline T* get() const {
+      return item;
+    }
+
+    inline T& operator*() const {
+      return *item;
+    }
+
+    inline T* operator->() const {
+      return item;
+    }
+
+    /**
+     * OwnedQueue.hpp
+     *
+     * @brief Destroy the owned object and return its slot to the pool.  The
+     * handle is empty afterwards.
+     */
+    inline void reset() {
+      if (item != nullptr) {
+        owner->free(item);
+        item = nullptr;
+      }
+    }
+
+    /**
+     * OwnedQueue.hpp
+     *
+     * @brief A version of reset() that can be called from an interrupt service
+     * routine.
+     *
+     * @param higherPriorityTaskWoken A reference that will be set to true if
+     * returning the slot caused a task that was waiting for a free slot to
+     * unblock, and the unblocked task has a priority higher than the currently
+     * running task.
+     */
+    inline void releaseFromISR(bool& higherPriorityTaskWoken) {
+      if (item != nullptr) {
+        owner->freeFromISR(higherPriorityTaskWoken, item);
+        item = nullptr;
+      }
+    }
+
+   private:
+    friend class OwnedQueue;
+
+    Handle(OwnedQueue* owner, T* item) : owner(owner), item(item) {}
+
+    inline T* release() {
+      return std::exchange(item, nullptr);
+    }
+
+    OwnedQueue* owner = nullptr;
+    T* item = nullptr;
+  };
+
+  /**
+   * OwnedQueue.hpp
+   *
+   * @brief Construct a new OwnedQueue object and place every slot of the pool
+   * in the free list.
+   *
+   * @warning This class contains the storage for the objects and both queues,
+   * so the user should create this object as a global object or with the
+   * static storage specifier so that the object instance is not on the stack.
+   *
+   * <b>Example Usage</b>
+   * @include OwnedQueue/ownedQueue.cpp
+   */
+  OwnedQueue() {
+    for (auto& slot : storage) {
+      freeSlots.sendToBack(slot.get(), 0);
+    }
+  }
+
+  /**
+   * OwnedQueue.hpp
+   *
+   * @brief Destroy the OwnedQueue object, destroying any objects that are still
+   * in the queue.
+   *
+   * @warning All handles must have been released before the pool is destroyed.
+   */
+  ~OwnedQueue() {
+    T* item = nullptr;
+    while (queue.receive(item, 0)) {
+      item->~T();
+    }
+  }
+
+  OwnedQueue(const OwnedQueue&) = delete;
+  OwnedQueue& operator=(const OwnedQueue&) = delete;
+  OwnedQueue(OwnedQueue&&) = delete;
+  OwnedQueue& operator=(OwnedQueue&&) = delete;
+
+  static void* operator new(size_t) = delete;
+  static void* operator new[](size_t) = delete;
+
+  static void* operator new(size_t, void* ptr) {
+    return ptr;
+  }
+
+  static void* operator new[](size_t, void* ptr) {
+    return ptr;
+  }
+
+  /**
+   * OwnedQueue.hpp
+   *
+   * @brief Function that allocates a slot from the pool and constructs an
+   * object in it.
+   *
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for a slot to become free, should the pool be exhausted.
+   * @param args Arguments forwarded to the constructor of T.
+   * @return Handle Handle to the constructed object.  The handle is empty if no
+   * slot became free before ticksToWait expired.
+   */
+  template <class... Args>
+  Handle allocate(const TickType_t ticksToWait, Args&&... args) {
+    T* slot = nullptr;
+    if (!freeSlots.receive(slot, ticksToWait)) {
+      return Handle();
+    }
+    return Handle(this, ::new (slot) T(std::forward<Args>(args)...));
+  }
+
+  /**
+   * OwnedQueue.hpp
+   *
+   * @brief A version of allocate() that can be called from an interrupt
+   * service routine.
+   *
+   * @param args Arguments forwarded to the constructor of T.
+   * @return Handle Handle to the constructed object.  The handle is empty if
+   * the pool is exhausted.
+   */
+  template <class... Args>
+  Handle allocateFromISR(Args&&... args) {
+    T* slot = nullptr;
+    if (!freeSlots.receiveFromISR(slot)) {
+      return Handle();
+    }
+    return Handle(this, ::new (slot) T(std::forward<Args>(args)...));
+  }
+
+  /**
+   * OwnedQueue.hpp
+   *
+   * @brief Function that posts an object to the back of the queue.  Only the
+   * pointer to the object is copied.
+   *
+   * @param handle Handle to the object that is to be placed on the queue.  On
+   * success the handle is emptied and ownership passes to the receiver.  On
+   * failure the handle keeps ownership of the object.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for space to become available on the queue, should it already be full.
+   * @retval true if the object was successfully posted.
+   * @retval false otherwise.
+   */
+  bool sendToBack(Handle& handle,
+                  const TickType_t ticksToWait = portMAX_DELAY) const {
+    if (handle.isValid() && queue.sendToBack(handle.get(), ticksToWait)) {
+      handle.release();
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * OwnedQueue.hpp
+   *
+   * @brief A version of sendToBack() that can be called from an interrupt
+   * service routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * sending to the queue caused a task to unblock, and the unblocked task has a
+   * priority higher than the currently running task.
+   * @param handle Handle to the object that is to be placed on the queue.
+   * @retval true if the object was successfully posted.
+   * @retval false otherwise.
+   */
+  bool sendToBackFromISR(bool& higherPriorityTaskWoken, Handle& handle) const {
+    if (handle.isValid() &&
+        queue.sendToBackFromISR(higherPriorityTaskWoken, handle.get())) {
+      handle.release();
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * OwnedQueue.hpp
+   *
+   * @brief Function that posts an object to the front of the queue.  Only the
+   * pointer to the object is copied.
+   *
+   * @param handle Handle to the object that is to be placed on the queue.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for space to become available on the queue, should it already be full.
+   * @retval true if the object was successfully posted.
+   * @retval false otherwise.
+   */
+  bool sendToFront(Handle& handle,
+                   const TickType_t ticksToWait = portMAX_DELAY) const {
+    if (handle.isValid() && queue.sendToFront(handle.get(), ticksToWait)) {
+      handle.release();
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * OwnedQueue.hpp
+   *
+   * @brief Function that receives an object from the queue.
+   *
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for an object to receive should the queue be empty at the time of the call.
+   * @return Handle Handle that owns the received object.  The handle is empty
+   * if no object was received.
+   */
+  Handle receive(const TickType_t ticksToWait = portMAX_DELAY) {
+    T* item = nullptr;
+    return queue.receive(item, ticksToWait) ? Handle(this, item) : Handle();
+  }
+
+  /**
+   * OwnedQueue.hpp
+   *
+   * @brief A version of receive() that can be called from an interrupt service
+   * routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * receiving from the queue caused a task to unblock, and the unblocked task
+   * has a priority higher than the currently running task.
+   * @return Handle Handle that owns the received object.
+   */
+  Handle receiveFromISR(bool& higherPriorityTaskWoken) {
+    T* item = nullptr;
+    return queue.receiveFromISR(higherPriorityTaskWoken, item)
+               ? Handle(this, item)
+               : Handle();
+  }
+
+  /**
+   * OwnedQueue.hpp
+   *
+   * @brief Function that returns the number of objects stored in the queue.
+   *
+   * @retval UBaseType_t The number of objects available in the queue.
+   */
+  inline UBaseType_t messagesWaiting() const {
+    return queue.messagesWaiting();
+  }
+
+  /**
+   * OwnedQueue.hpp
+   *
+   * @brief Function that returns the number of slots that can still be
+   * allocated from the pool.
+   *
+   * @retval UBaseType_t The number of free slots in the pool.
+   */
+  inline UBaseType_t slotsAvailable() const {
+    return freeSlots.messagesWaiting();
+  }
+
+ private:
+  inline void free(T* item) {
+    item->~T();
+    freeSlots.sendToBack(item, 0);
+  }
+
+  inline void freeFromISR(bool& higherPriorityTaskWoken, T* item) {
+    item->~T();
+    freeSlots.sendToBackFromISR(higherPriorityTaskWoken, item);
+  }
+
+  struct Slot {
+    inline T* get() {
+      return reinterpret_cast<T*>(data);  // NOLINT
+    }
+
+    alignas(T) uint8_t data[sizeof(T)];
+  };
+
+  StaticQueue<T*, N> queue;
+  StaticQueue<T*, N> freeSlots;
+  Slot storage[N];
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_OWNEDQUEUE_HPP
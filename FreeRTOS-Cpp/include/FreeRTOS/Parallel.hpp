@@ -0,0 +1,290 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_PARALLEL_HPP
+#define FREERTOS_PARALLEL_HPP
+
+#include <FreeRTOS/DeferCreate.hpp>
+#include <FreeRTOS/Mutex.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1) && \
+    (configUSE_TASK_NOTIFICATIONS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class ParallelPool Parallel.hpp <FreeRTOS/Parallel.hpp>
+ *
+ * @brief Class that splits loops and independent functions across a fixed set
+ * of helper tasks and the calling task.
+ *
+ * The pool owns Helpers FreeRTOS::StaticTask objects that are created once and
+ * then sleep on a task notification.  parallelFor() publishes a range and wakes
+ * the helpers, and every participant, including the calling task, claims
+ * chunks of grain indices until the range is exhausted.  The caller then waits
+ * for each helper to notify it back, so a call costs one notification per
+ * helper in each direction and never creates a task.
+ *
+ * On an SMP build with configUSE_CORE_AFFINITY helper i is pinned to core
+ * <tt>(i + 1) % configNUMBER_OF_CORES</tt>, so with one helper per spare core
+ * and the caller on core 0 every core takes part.  On a single core build the
+ * pool still works but only interleaves the work.
+ *
+ * Calls from several tasks are serialised by a mutex.  The function passed to
+ * parallelFor() must not itself use the same pool.
+ *
+ * @warning The notification at index Index of the calling task is used to wait
+ * for the helpers.  The helpers that are still working are counted in the pool,
+ * so a give to that notification from elsewhere only wakes the caller early to
+ * check the count again.  The helpers should run at the priority of the calling
+ * task, or the caller may finish its share and wait while a helper is
+ * preempted.
+ *
+ * @tparam Helpers The number of helper tasks, normally one for each core other
+ * than the one the caller runs on, i.e. configNUMBER_OF_CORES - 1.
+ * @tparam StackWords The stack depth of each helper task, in words.
+ * @tparam Index The index of the notification of the calling task that the
+ * helpers give when they finish.
+ *
+ * <b>Example Usage</b>
+ * @include Parallel/parallel.cpp
+ */
+template <UBaseType_t Helpers = 1,
+          UBaseType_t StackWords = configMINIMAL_STACK_SIZE,
+          UBaseType_t Index = 0>
+class ParallelPool {
+  static_assert(Helpers > 0, "ParallelPool needs at least one helper.");
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+
+ public:
+  /**
+   * Parallel.hpp
+   *
+   * @brief Construct a new ParallelPool object and create its helper tasks.
+   *
+   * @warning This class contains the stacks of the helpers, so the user should
+   * create this object as a global object or with the static storage specifier
+   * so that the object instance is not on the stack.
+   *
+   * @param priority The priority of the helper tasks.
+   * @param name The name given to every helper task.
+   */
+  explicit ParallelPool(const UBaseType_t priority = tskIDLE_PRIORITY + 1,
+                        const char* name = "Parallel") {
+    for (UBaseType_t i = 0; i < Helpers; i++) {
+      helpers[i].pool = this;
+#if (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1)
+      helpers[i].create(priority, name,
+                        1U << ((i + 1) % configNUMBER_OF_CORES));
+#else
+      helpers[i].create(priority, name);
+#endif /* (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1) */
+    }
+  }
+  ~ParallelPool() = default;
+
+  ParallelPool(const ParallelPool&) = delete;
+  ParallelPool& operator=(const ParallelPool&) = delete;
+  ParallelPool(ParallelPool&&) = delete;
+  ParallelPool& operator=(ParallelPool&&) = delete;
+
+  /**
+   * Parallel.hpp
+   *
+   * @brief Function that calls function(i) for every i in [begin, end),
+   * sharing the indices between the helpers and the calling task, and returns
+   * once every call has returned.
+   *
+   * Ranges no longer than grain run on the calling task alone, without waking
+   * the helpers.
+   *
+   * @param begin The first index.
+   * @param end One past the last index.
+   * @param grain The number of consecutive indices a participant claims at a
+   * time.  Larger grains cost fewer critical sections, smaller grains balance
+   * uneven work better.
+   * @param function Callable object taking a <tt>size_t</tt> index.
+   */
+  template <class Function>
+  void parallelFor(const size_t begin, const size_t end, const size_t grain,
+                   Function&& function) {
+    if (begin >= end) {
+      return;
+    }
+    const size_t chunk = (grain > 0) ? grain : 1;
+    if ((end - begin) <= chunk) {
+      for (size_t i = begin; i < end; i++) {
+        function(i);
+      }
+      return;
+    }
+
+    using Callable = std::remove_reference_t<Function>;
+
+    mutex.lock();
+    job.invoke = [](void* context, const size_t first, const size_t last) {
+      Callable& callable = *static_cast<Callable*>(context);
+      for (size_t i = first; i < last; i++) {
+        callable(i);
+      }
+    };
+    job.context = const_cast<void*>(static_cast<const void*>(&function));
+    job.next = begin;
+    job.end = end;
+    job.grain = chunk;
+    job.caller = xTaskGetCurrentTaskHandle();
+    job.pending = Helpers;
+
+    for (auto& helper : helpers) {
+      helper.notifyGive();
+    }
+    work();
+    // function lives on this stack, so do not return until every helper has
+    // finished with it.
+    while (pending() != 0) {
+      ulTaskNotifyTakeIndexed(Index, pdTRUE, portMAX_DELAY);
+    }
+    mutex.unlock();
+  }
+
+  /**
+   * Parallel.hpp
+   *
+   * @overload
+   */
+  template <class Function>
+  inline void parallelFor(const size_t count, const size_t grain,
+                          Function&& function) {
+    parallelFor(0, count, grain, std::forward<Function>(function));
+  }
+
+  /**
+   * Parallel.hpp
+   *
+   * @brief Function that runs every function given to it at the same time on
+   * the helpers and the calling task, and returns once they have all returned.
+   *
+   * @param functions Callable objects taking no arguments.
+   */
+  template <class... Functions>
+  void forkJoin(Functions&&... functions) {
+    auto table = std::forward_as_tuple(functions...);
+    parallelFor(0, sizeof...(Functions), 1, [&table](const size_t i) {
+      invokeAt(table, i, std::index_sequence_for<Functions...>());
+    });
+  }
+
+ private:
+  struct Job {
+    void (*invoke)(void* context, size_t first, size_t last) = nullptr;
+    void* context = nullptr;
+    size_t next = 0;
+    size_t end = 0;
+    size_t grain = 1;
+    TaskHandle_t caller = NULL;
+    UBaseType_t pending = 0;
+  };
+
+  class Helper : public StaticTask<StackWords> {
+   public:
+    Helper() : StaticTask<StackWords>(deferCreate) {}
+
+    ParallelPool* pool = nullptr;
+
+   private:
+    void taskFunction() final {
+      for (;;) {
+        this->notifyTake(portMAX_DELAY);
+        // Copied first, as the job may be reused once pending reaches 0.
+        const TaskHandle_t caller = pool->job.caller;
+        pool->work();
+        if (pool->finish()) {
+          xTaskNotifyGiveIndexed(caller, Index);
+        }
+      }
+    }
+  };
+
+  // Claims chunks in a critical section until the range is exhausted.
+  void work() {
+    for (;;) {
+      taskENTER_CRITICAL();
+      const size_t first = job.next;
+      const size_t last =
+          ((job.end - first) > job.grain) ? (first + job.grain) : job.end;
+      job.next = last;
+      taskEXIT_CRITICAL();
+
+      if (first >= last) {
+        return;
+      }
+      job.invoke(job.context, first, last);
+    }
+  }
+
+  // Returns true for the helper that finished last.
+  bool finish() {
+    taskENTER_CRITICAL();
+    const bool last = (--job.pending == 0);
+    taskEXIT_CRITICAL();
+    return last;
+  }
+
+  UBaseType_t pending() const {
+    taskENTER_CRITICAL();
+    const UBaseType_t count = job.pending;
+    taskEXIT_CRITICAL();
+    return count;
+  }
+
+  template <class Table, size_t... Indices>
+  static inline void invokeAt(Table& table, const size_t i,
+                              std::index_sequence<Indices...>) {
+    static_cast<void>(
+        ((i == Indices ? (std::get<Indices>(table)(), true) : false) || ...));
+  }
+
+  Job job;
+  StaticMutex mutex;
+  Helper helpers[Helpers];
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION && configUSE_TASK_NOTIFICATIONS */
+
+#endif  // FREERTOS_PARALLEL_HPP
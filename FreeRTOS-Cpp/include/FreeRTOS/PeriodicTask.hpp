@@ -0,0 +1,280 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_PERIODICTASK_HPP
+#define FREERTOS_PERIODICTASK_HPP
+
+#include <FreeRTOS/Task.hpp>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (INCLUDE_xTaskDelayUntil == 1) && (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @brief Timing statistics collected by FreeRTOS::PeriodicTask.  All times
+ * are in ticks.
+ */
+struct PeriodicStatistics {
+  /**
+   * @brief The number of times cycle() has been called.
+   */
+  uint32_t cycles;
+
+  /**
+   * @brief The number of times a cycle finished after the start of the next
+   * period.
+   */
+  uint32_t overruns;
+
+  /**
+   * @brief The smallest delay between the start of a period and the start of
+   * its cycle.
+   */
+  TickType_t minJitter;
+
+  /**
+   * @brief The largest delay between the start of a period and the start of
+   * its cycle.
+   */
+  TickType_t maxJitter;
+
+  /**
+   * @brief The longest time a call to cycle() took, including any time the
+   * task was preempted.
+   */
+  TickType_t maxExecution;
+
+  /**
+   * @brief The number of times a call to cycle() took longer than the budget
+   * of the task.  It stays 0 if the task has no budget.
+   */
+  uint32_t budgetOverruns;
+};
+
+/**
+ * @class PeriodicTask PeriodicTask.hpp <FreeRTOS/PeriodicTask.hpp>
+ *
+ * @brief Class that implements a task that calls cycle() once every period
+ * and detects when a period is missed.
+ *
+ * The task uses <tt>xTaskDelayUntil()</tt> so that the periods do not drift.
+ * When <tt>xTaskDelayUntil()</tt> reports that the next period has already
+ * started, the overrun is counted, overrun() is called, and policy decides
+ * whether the missed periods are made up or dropped.
+ *
+ * The wake-up jitter of every cycle, the time between the start of the period
+ * and the start of cycle(), is recorded so that the timing of the task can be
+ * checked with getStatistics() while the application runs.
+ *
+ * INCLUDE_xTaskDelayUntil must be defined as 1 for this class to be available.
+ *
+ * @note This class is not intended to be instantiated by the user.  The user
+ * should create a class that derives from this class and implement cycle().
+ *
+ * @tparam N The number of indexes in the array of <tt>StackType_t</tt> used to
+ * store the stack for this task.
+ *
+ * <b>Example Usage</b>
+ * @include PeriodicTask/periodicTask.cpp
+ */
+template <UBaseType_t N = configMINIMAL_STACK_SIZE>
+class PeriodicTask : public StaticTask<N> {
+ public:
+  /**
+   * @brief What the task does when a cycle overruns its period.
+   */
+  enum class OverrunPolicy {
+    CatchUp, /**< Call cycle() immediately for every missed period, keeping
+                the number of cycles equal to the number of periods. */
+    Skip,    /**< Drop the missed periods and call cycle() once, immediately,
+                for the most recent period. */
+  };
+
+  PeriodicTask(const PeriodicTask&) = delete;
+  PeriodicTask& operator=(const PeriodicTask&) = delete;
+
+  /**
+   * PeriodicTask.hpp
+   *
+   * @brief Function that returns the period of the task.
+   *
+   * @return TickType_t The period in ticks.
+   */
+  inline TickType_t getPeriod() const {
+    return period;
+  }
+
+  /**
+   * PeriodicTask.hpp
+   *
+   * @brief Function that returns the execution time budget of the task.
+   *
+   * @return TickType_t The budget in ticks, or 0 if the task has no budget.
+   */
+  inline TickType_t getBudget() const {
+    return budget;
+  }
+
+  /**
+   * PeriodicTask.hpp
+   *
+   * @brief Function that returns a copy of the timing statistics of the task.
+   * The copy is taken in a critical section so that it is consistent.
+   *
+   * @return PeriodicStatistics The timing statistics of the task.
+   */
+  PeriodicStatistics getStatistics() const {
+    taskENTER_CRITICAL();
+    const PeriodicStatistics copy = statistics;
+    taskEXIT_CRITICAL();
+    return copy;
+  }
+
+  /**
+   * PeriodicTask.hpp
+   *
+   * @brief Function that resets the timing statistics of the task.
+   */
+  void resetStatistics() {
+    taskENTER_CRITICAL();
+    statistics = initialStatistics();
+    taskEXIT_CRITICAL();
+  }
+
+ protected:
+  /**
+   * PeriodicTask.hpp
+   *
+   * @brief Construct a new PeriodicTask object.
+   *
+   * @param period The period of the task in ticks.  The period must be
+   * greater than 0.
+   * @param priority The priority at which the created task will execute.
+   * @param name A descriptive name for the task.
+   * @param policy What the task does when a cycle overruns its period.
+   * @param budget The worst case execution time of cycle() in ticks, as used
+   * by FreeRTOS::TaskSet.  Cycles that take longer are counted in
+   * PeriodicStatistics::budgetOverruns.  0 means that the task has no budget.
+   */
+  explicit PeriodicTask(const TickType_t period,
+                        const UBaseType_t priority = tskIDLE_PRIORITY,
+                        const char* name = "",
+                        const OverrunPolicy policy = OverrunPolicy::CatchUp,
+                        const TickType_t budget = 0)
+      : StaticTask<N>(deferCreate),
+        period(period),
+        budget(budget),
+        policy(policy) {
+    configASSERT(period > 0);
+    // The task is created last, as it reads the period as soon as it runs.
+    this->create(priority, name);
+  }
+  ~PeriodicTask() = default;
+
+  PeriodicTask(PeriodicTask&&) noexcept = default;
+  PeriodicTask& operator=(PeriodicTask&&) noexcept = default;
+
+  /**
+   * PeriodicTask.hpp
+   *
+   * @brief Function that is called once every period.
+   */
+  virtual void cycle() = 0;
+
+  /**
+   * PeriodicTask.hpp
+   *
+   * @brief Function that is called, from the task, each time a cycle overruns
+   * its period and before the policy is applied.  The default implementation
+   * does nothing.  Override it to log the overrun or notify a supervisor.
+   *
+   * @param lateness The number of ticks between the start of the period that
+   * was missed and the time the overrun was detected.
+   */
+  virtual void overrun(const TickType_t lateness) {
+    static_cast<void>(lateness);
+  }
+
+ private:
+  void taskFunction() final {
+    TickType_t release = xTaskGetTickCount();
+    for (;;) {
+      const TickType_t start = xTaskGetTickCount();
+      cycle();
+      const TickType_t end = xTaskGetTickCount();
+      record(start - release, end - start);
+
+      if (xTaskDelayUntil(&release, period) == pdFALSE) {
+        const TickType_t lateness = xTaskGetTickCount() - release;
+        taskENTER_CRITICAL();
+        statistics.overruns++;
+        taskEXIT_CRITICAL();
+        overrun(lateness);
+        if (policy == OverrunPolicy::Skip) {
+          release += (lateness / period) * period;
+        }
+      }
+    }
+  }
+
+  inline void record(const TickType_t jitter, const TickType_t execution) {
+    taskENTER_CRITICAL();
+    statistics.cycles++;
+    if (jitter < statistics.minJitter) {
+      statistics.minJitter = jitter;
+    }
+    if (jitter > statistics.maxJitter) {
+      statistics.maxJitter = jitter;
+    }
+    if (execution > statistics.maxExecution) {
+      statistics.maxExecution = execution;
+    }
+    if ((budget > 0) && (execution > budget)) {
+      statistics.budgetOverruns++;
+    }
+    taskEXIT_CRITICAL();
+  }
+
+  static constexpr PeriodicStatistics initialStatistics() {
+    return {0, 0, portMAX_DELAY, 0, 0, 0};
+  }
+
+  const TickType_t period;
+  const TickType_t budget;
+  const OverrunPolicy policy;
+  PeriodicStatistics statistics = initialStatistics();
+};
+
+}  // namespace FreeRTOS
+
+#endif /* INCLUDE_xTaskDelayUntil && configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_PERIODICTASK_HPP
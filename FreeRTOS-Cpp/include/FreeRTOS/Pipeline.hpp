@@ -0,0 +1,395 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_PIPELINE_HPP
+#define FREERTOS_PIPELINE_HPP
+
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @brief Counters collected by FreeRTOS::Pipeline for one stage.
+ */
+struct StageStatistics {
+  /**
+   * @brief The number of items the stage has taken from its input queue, or
+   * the number of items produced by the first stage.
+   */
+  uint32_t processed;
+
+  /**
+   * @brief The number of items the stage has passed to the next stage.
+   */
+  uint32_t forwarded;
+
+  /**
+   * @brief The largest number of items seen waiting in the input queue of the
+   * stage.  A stage whose peak reaches its queue depth is slower than the
+   * stage before it.
+   */
+  UBaseType_t peakOccupancy;
+
+  /**
+   * @brief The number of times the stage found the queue to the next stage
+   * full and had to wait.  A stage that stalls often is held up by a later
+   * stage.
+   */
+  uint32_t stalls;
+};
+
+/**
+ * @class Stage Pipeline.hpp <FreeRTOS/Pipeline.hpp>
+ *
+ * @brief Class that declares one stage of a FreeRTOS::Pipeline.
+ *
+ * The first stage is a source and is called with no arguments.  Every other
+ * stage is called with a const reference to one item from the stage before it,
+ * or, if Batch is greater than 1, with a pointer to Batch items and the count.
+ * Every stage but the last returns the item it passes on, and may return a
+ * std::optional to pass on nothing.  The last stage returns void.
+ *
+ * @tparam Function The type of the callable, for example a function pointer or
+ * the type of a lambda.
+ * @tparam StackWords The stack depth of the task that runs the stage, in
+ * words.
+ * @tparam Depth The number of items the queue in front of the stage holds.  It
+ * is ignored for the first stage.
+ * @tparam Batch The number of items the stage takes per call.  It is ignored
+ * for the first stage.
+ */
+template <class Function, UBaseType_t StackWords = configMINIMAL_STACK_SIZE,
+          UBaseType_t Depth = 4, size_t Batch = 1>
+struct Stage {
+  static_assert(Depth > 0, "The queue of a stage must hold at least 1 item.");
+  static_assert((Batch > 0) && (Batch <= Depth),
+                "The batch of a stage must be between 1 and its queue depth.");
+
+  using FunctionType = Function;
+  static constexpr UBaseType_t stackWords = StackWords;
+  static constexpr UBaseType_t depth = Depth;
+  static constexpr size_t batch = Batch;
+};
+
+/**
+ * @class Pipeline Pipeline.hpp <FreeRTOS/Pipeline.hpp>
+ *
+ * @brief Class that connects a chain of stages with statically allocated
+ * queues and runs each stage in a task of its own.
+ *
+ * A signal processing chain such as acquire, filter, detect and report is
+ * declared as one object.  The item type of each queue is the type returned
+ * by the stage before it, so the queues never have to be declared by hand.
+ * Each stage has its own stack size and the depth of its input queue, and a
+ * stage that works on blocks, such as an FFT, can take a batch of items per
+ * call.  Every task, queue and buffer is part of the object.
+ *
+ * The StageStatistics of each stage show where the chain is limited: the
+ * stage in front of a queue that keeps reaching its depth is the bottleneck,
+ * and the processed counts, sampled over a known interval, give the
+ * throughput of each stage.
+ *
+ * The tasks of all stages run at the same priority, so each stage wakes when
+ * its queue has data and the chain advances one item at a time.  The queues
+ * are created before the tasks that use them, so a pipeline can be declared
+ * before or after the scheduler starts.
+ *
+ * @note Items pass through FreeRTOS queues, so every item type must be
+ * trivially copyable.
+ *
+ * @tparam Stages One FreeRTOS::Stage for each stage, from source to sink.
+ *
+ * <b>Example Usage</b>
+ * @include Pipeline/pipeline.cpp
+ */
+template <class... Stages>
+class Pipeline {
+  static_assert(sizeof...(Stages) >= 2,
+                "A pipeline needs a source and at least one more stage.");
+
+  template <class T>
+  struct Unwrap {
+    using type = T;
+  };
+
+  template <class T>
+  struct Unwrap<std::optional<T>> {
+    using type = T;
+  };
+
+  // Stands in for the queue before the first stage and after the last.
+  struct NoQueue {};
+
+  template <class T, UBaseType_t Depth>
+  using Link = std::conditional_t<std::is_void_v<T>, NoQueue,
+                                  StaticQueue<T, Depth>>;
+
+  template <class In, class S, bool Batched = (S::batch > 1)>
+  struct Call {
+    using type =
+        std::invoke_result_t<typename S::FunctionType&, const In&>;
+  };
+
+  template <class In, class S>
+  struct Call<In, S, true> {
+    using type = std::invoke_result_t<typename S::FunctionType&,
+                                      const In*, size_t>;
+  };
+
+  template <class S>
+  struct Call<void, S, false> {
+    using type = std::invoke_result_t<typename S::FunctionType&>;
+  };
+
+  template <class S>
+  struct Call<void, S, true> : Call<void, S, false> {};
+
+  template <class In, class S>
+  using Result = typename Call<In, S>::type;
+
+  template <class Input, class Output, class In, class S>
+  class StageTask : public StaticTask<S::stackWords> {
+   public:
+    StageTask(const char* name, const UBaseType_t priority,
+              typename S::FunctionType function, Input& input,
+              Output& output)
+        : StaticTask<S::stackWords>(deferCreate),
+          function(std::move(function)),
+          input(input),
+          output(output) {
+      // The task is created last, as a source stage calls function as soon
+      // as it runs.
+      this->create(priority, name);
+    }
+
+    StageStatistics getStatistics() const {
+      taskENTER_CRITICAL();
+      const StageStatistics copy = statistics;
+      taskEXIT_CRITICAL();
+      return copy;
+    }
+
+   private:
+    typename S::FunctionType function;
+    Input& input;
+    Output& output;
+    StageStatistics statistics = {0, 0, 0, 0};
+
+    void taskFunction() final {
+      for (;;) {
+        if constexpr (std::is_void_v<In>) {
+          count(1);
+          process();
+        } else if constexpr (S::batch > 1) {
+          In items[S::batch];
+          size_t received = 0;
+          while (received < S::batch) {
+            observe();
+            received += input.receiveN(items + received, S::batch - received,
+                                       portMAX_DELAY);
+          }
+          count(received);
+          process(static_cast<const In*>(items), received);
+        } else {
+          observe();
+          In item;
+          input.receive(item, portMAX_DELAY);
+          count(1);
+          process(static_cast<const In&>(item));
+        }
+      }
+    }
+
+    template <class... Args>
+    inline void process(Args&&... args) {
+      using Value = Result<In, S>;
+      if constexpr (std::is_void_v<Value>) {
+        function(std::forward<Args>(args)...);
+      } else if constexpr (!std::is_same_v<Value,
+                                           typename Unwrap<Value>::type>) {
+        const Value value = function(std::forward<Args>(args)...);
+        if (value.has_value()) {
+          send(*value);
+        }
+      } else {
+        send(function(std::forward<Args>(args)...));
+      }
+    }
+
+    template <class Item>
+    inline void send(const Item& item) {
+      if (output.spacesAvailable() == 0) {
+        taskENTER_CRITICAL();
+        statistics.stalls++;
+        taskEXIT_CRITICAL();
+      }
+      output.sendToBack(item, portMAX_DELAY);
+      taskENTER_CRITICAL();
+      statistics.forwarded++;
+      taskEXIT_CRITICAL();
+    }
+
+    inline void observe() {
+      const UBaseType_t waiting = input.messagesWaiting();
+      taskENTER_CRITICAL();
+      if (waiting > statistics.peakOccupancy) {
+        statistics.peakOccupancy = waiting;
+      }
+      taskEXIT_CRITICAL();
+    }
+
+    inline void count(const size_t items) {
+      taskENTER_CRITICAL();
+      statistics.processed += items;
+      taskEXIT_CRITICAL();
+    }
+  };
+
+  // Takes the place of the stage after the last one.
+  struct End {
+    using Queue = NoQueue;
+
+    End(const char*, const UBaseType_t) {}
+
+    inline Queue& inputQueue() {
+      return queue;
+    }
+
+    StageStatistics getStatistics(size_t) const {
+      return {0, 0, 0, 0};
+    }
+
+    Queue queue;
+  };
+
+  template <size_t Index, class In, class S, class... Rest>
+  class Node;
+
+  template <size_t Index, class In, class... Rest>
+  struct NextNode {
+    using type = Node<Index, In, Rest...>;
+  };
+
+  template <size_t Index, class In>
+  struct NextNode<Index, In> {
+    using type = End;
+  };
+
+  template <size_t Index, class In, class S, class... Rest>
+  class Node {
+    using Out = typename Unwrap<Result<In, S>>::type;
+
+    static_assert((sizeof...(Rest) == 0) || !std::is_void_v<Out>,
+                  "Every stage but the last must return an item.");
+    static_assert((sizeof...(Rest) > 0) || std::is_void_v<Out>,
+                  "The last stage must return void.");
+
+    using Next = typename NextNode<Index + 1, Out, Rest...>::type;
+
+   public:
+    using Queue = Link<In, S::depth>;
+
+    template <class... Functions>
+    Node(const char* name, const UBaseType_t priority,
+         typename S::FunctionType function, Functions&&... functions)
+        : next(name, priority, std::forward<Functions>(functions)...),
+          task(name, priority, std::move(function), queue,
+               next.inputQueue()) {}
+
+    inline Queue& inputQueue() {
+      return queue;
+    }
+
+    StageStatistics getStatistics(const size_t index) const {
+      return (index == Index) ? task.getStatistics()
+                              : next.getStatistics(index);
+    }
+
+   private:
+    // Declared in this order so that the later stages and every queue exist
+    // before the task of this stage is created.
+    Next next;
+    Queue queue;
+    StageTask<Queue, typename Next::Queue, In, S> task;
+  };
+
+  Node<0, void, Stages...> head;
+
+ public:
+  /**
+   * @brief The number of stages in the pipeline.
+   */
+  static constexpr size_t size = sizeof...(Stages);
+
+  /**
+   * Pipeline.hpp
+   *
+   * @brief Construct a new Pipeline object, its queues and the tasks of its
+   * stages.
+   *
+   * @param name A descriptive name shared by the tasks of the stages.
+   * @param priority The priority of the tasks of every stage.
+   * @param functions The callable of each stage, in the order of Stages.
+   */
+  explicit Pipeline(const char* name, const UBaseType_t priority,
+                    typename Stages::FunctionType... functions)
+      : head(name, priority, std::move(functions)...) {}
+  ~Pipeline() = default;
+
+  Pipeline(const Pipeline&) = delete;
+  Pipeline& operator=(const Pipeline&) = delete;
+
+  /**
+   * Pipeline.hpp
+   *
+   * @brief Function that returns a copy of the counters of one stage.
+   *
+   * @param index The position of the stage, where 0 is the source.
+   * @return StageStatistics The counters of the stage.
+   */
+  StageStatistics getStatistics(const size_t index) const {
+    configASSERT(index < size);
+    return head.getStatistics(index);
+  }
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_PIPELINE_HPP
@@ -0,0 +1,308 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_PRIORITYQUEUE_HPP
+#define FREERTOS_PRIORITYQUEUE_HPP
+
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Semaphore.hpp>
+#include <new>
+#include <optional>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class PriorityQueue PriorityQueue.hpp <FreeRTOS/PriorityQueue.hpp>
+ *
+ * @brief Class that implements a queue with several priority levels, where a
+ * receive always returns the oldest item of the highest priority level that has
+ * an item waiting.
+ *
+ * Each priority level is a FreeRTOS::StaticQueue of length Depth, so items of
+ * the same priority are received in the order they were sent.  A
+ * FreeRTOS::StaticCountingSemaphore counts the items waiting on all levels and
+ * is the only object a receiving task blocks on.  Receiving an item therefore
+ * takes the semaphore and then scans at most Levels queues, starting at the
+ * highest priority.
+ *
+ * As with task priorities, a larger value denotes a higher priority, so
+ * <tt>Levels - 1</tt> is the most urgent level and 0 is the least urgent.
+ *
+ * @warning This class contains the storage for every level, so the user should
+ * create this object as a global object or with the static storage specifier
+ * so that the object instance is not on the stack.
+ *
+ * @tparam T Type to be stored in the queue.
+ * @tparam Levels The number of priority levels.
+ * @tparam Depth The maximum number of items each priority level can hold.
+ *
+ * <b>Example Usage</b>
+ * @include PriorityQueue/priorityQueue.cpp
+ */
+template <class T, UBaseType_t Levels, UBaseType_t Depth>
+class PriorityQueue {
+  static_assert(Levels > 0, "A PriorityQueue needs at least one level");
+  static_assert(Depth > 0, "Each PriorityQueue level needs a nonzero depth");
+
+ public:
+  PriorityQueue() : waiting(Levels * Depth, 0) {}
+  ~PriorityQueue() = default;
+
+  PriorityQueue(const PriorityQueue&) = delete;
+  PriorityQueue& operator=(const PriorityQueue&) = delete;
+  PriorityQueue(PriorityQueue&&) = delete;
+  PriorityQueue& operator=(PriorityQueue&&) = delete;
+
+  static void* operator new(size_t) = delete;
+  static void* operator new[](size_t) = delete;
+
+  static void* operator new(size_t, void* ptr) {
+    return ptr;
+  }
+
+  static void* operator new[](size_t, void* ptr) {
+    return ptr;
+  }
+
+  /**
+   * PriorityQueue.hpp
+   *
+   * @brief Function that checks if the underlying queues and semaphore were
+   * created successfully.
+   *
+   * @retval true If every kernel object was created successfully.
+   * @retval false Otherwise.
+   */
+  inline bool isValid() const {
+    for (const auto& level : levels) {
+      if (!level.isValid()) {
+        return false;
+      }
+    }
+    return waiting.isValid();
+  }
+
+  /**
+   * PriorityQueue.hpp
+   *
+   * @brief Function that posts an item to the back of a priority level.
+   *
+   * @param item A reference to the item that is to be placed on the queue.
+   * @param priority The priority level the item is placed on.  Must be less
+   * than Levels.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for space to become available on the level, should it already be full.
+   * @retval true if the item was successfully posted.
+   * @retval false otherwise.
+   */
+  bool sendToBack(const T& item, const UBaseType_t priority,
+                  const TickType_t ticksToWait = portMAX_DELAY) const {
+    configASSERT(priority < Levels);
+    if ((priority < Levels) &&
+        levels[priority].sendToBack(item, ticksToWait)) {
+      waiting.give();
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * PriorityQueue.hpp
+   *
+   * @brief A version of sendToBack() that can be called from an interrupt
+   * service routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * sending the item caused a task to unblock, and the unblocked task has a
+   * priority higher than the currently running task.
+   * @param item A reference to the item that is to be placed on the queue.
+   * @param priority The priority level the item is placed on.  Must be less
+   * than Levels.
+   * @retval true if the item was successfully posted.
+   * @retval false otherwise.
+   */
+  bool sendToBackFromISR(bool& higherPriorityTaskWoken, const T& item,
+                         const UBaseType_t priority) const {
+    configASSERT(priority < Levels);
+    if ((priority < Levels) &&
+        levels[priority].sendToBackFromISR(higherPriorityTaskWoken, item)) {
+      waiting.giveFromISR(higherPriorityTaskWoken);
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * PriorityQueue.hpp
+   *
+   * @overload
+   */
+  bool sendToBackFromISR(const T& item, const UBaseType_t priority) const {
+    bool higherPriorityTaskWoken = false;
+    return sendToBackFromISR(higherPriorityTaskWoken, item, priority);
+  }
+
+  /**
+   * PriorityQueue.hpp
+   *
+   * @brief Function that receives the oldest item of the highest priority
+   * level that has an item waiting.
+   *
+   * @param item Reference the received item is copied into.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for an item to receive should every level be empty at the time of the call.
+   * @retval true if an item was received.
+   * @retval false otherwise.
+   */
+  bool receive(T& item, const TickType_t ticksToWait = portMAX_DELAY) const {
+    if (!waiting.take(ticksToWait)) {
+      return false;
+    }
+    return takeHighest(item);
+  }
+
+  /**
+   * PriorityQueue.hpp
+   *
+   * @brief Function that receives the oldest item of the highest priority
+   * level that has an item waiting.
+   *
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for an item to receive should every level be empty at the time of the call.
+   * @return std::optional<T> Object from the queue.  User should check that the
+   * value is present.
+   */
+  std::optional<T> receive(const TickType_t ticksToWait = portMAX_DELAY) const {
+    std::optional<T> item;
+    if (waiting.take(ticksToWait)) {
+      for (UBaseType_t priority = Levels; priority-- > 0;) {
+        item = levels[priority].receive(0);
+        if (item.has_value()) {
+          break;
+        }
+      }
+    }
+    return item;
+  }
+
+  /**
+   * PriorityQueue.hpp
+   *
+   * @brief A version of receive() that can be called from an interrupt service
+   * routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * receiving the item caused a task to unblock, and the unblocked task has a
+   * priority higher than the currently running task.
+   * @param item Reference the received item is copied into.
+   * @retval true if an item was received.
+   * @retval false otherwise.
+   */
+  bool receiveFromISR(bool& higherPriorityTaskWoken, T& item) const {
+    if (!waiting.takeFromISR(higherPriorityTaskWoken)) {
+      return false;
+    }
+    for (UBaseType_t priority = Levels; priority-- > 0;) {
+      if (levels[priority].receiveFromISR(higherPriorityTaskWoken, item)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * PriorityQueue.hpp
+   *
+   * @overload
+   */
+  bool receiveFromISR(T& item) const {
+    bool higherPriorityTaskWoken = false;
+    return receiveFromISR(higherPriorityTaskWoken, item);
+  }
+
+  /**
+   * PriorityQueue.hpp
+   *
+   * @brief Function that returns the number of items waiting on every level.
+   *
+   * @retval UBaseType_t The number of items available in the queue.
+   */
+  inline UBaseType_t messagesWaiting() const {
+    return waiting.getCount();
+  }
+
+  /**
+   * PriorityQueue.hpp
+   *
+   * @brief Function that returns the number of items waiting on one level.
+   *
+   * @param priority The priority level to query.  Must be less than Levels.
+   * @retval UBaseType_t The number of items available on that level.
+   */
+  inline UBaseType_t messagesWaiting(const UBaseType_t priority) const {
+    configASSERT(priority < Levels);
+    return levels[priority].messagesWaiting();
+  }
+
+  /**
+   * PriorityQueue.hpp
+   *
+   * @brief Function that returns the number of free spaces on one level.
+   *
+   * @param priority The priority level to query.  Must be less than Levels.
+   * @retval UBaseType_t The number of items that can still be sent to that
+   * level.
+   */
+  inline UBaseType_t spacesAvailable(const UBaseType_t priority) const {
+    configASSERT(priority < Levels);
+    return levels[priority].spacesAvailable();
+  }
+
+ private:
+  inline bool takeHighest(T& item) const {
+    for (UBaseType_t priority = Levels; priority-- > 0;) {
+      if (levels[priority].receive(item, 0)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  StaticQueue<T, Depth> levels[Levels];
+  StaticCountingSemaphore waiting;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_PRIORITYQUEUE_HPP
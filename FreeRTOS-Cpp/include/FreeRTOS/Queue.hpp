@@ -28,13 +28,69 @@
 #ifndef FREERTOS_QUEUE_HPP
 #define FREERTOS_QUEUE_HPP
 
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/Instrumentation.hpp>
+#include <FreeRTOS/ObjectLock.hpp>
+#include <FreeRTOS/Region.hpp>
+#include <new>
 #include <optional>
+#include <type_traits>
 
 #include "FreeRTOS.h"
 #include "queue.h"
+#include "task.h"
+
+/**
+ * @brief Set FREERTOS_CPP_QUEUE_STATISTICS to 1 in FreeRTOSConfig.h (or on the
+ * compiler command line) to have every FreeRTOS::QueueBase record usage
+ * statistics that can be read with FreeRTOS::QueueBase::getStatistics().  When
+ * it is 0 (the default) no statistics are stored and the queue functions call
+ * straight through to the kernel.
+ */
+#ifndef FREERTOS_CPP_QUEUE_STATISTICS
+#define FREERTOS_CPP_QUEUE_STATISTICS 0
+#endif
 
 namespace FreeRTOS {
 
+#if (FREERTOS_CPP_QUEUE_STATISTICS == 1)
+
+/**
+ * @brief Usage statistics recorded by FreeRTOS::QueueBase when
+ * FREERTOS_CPP_QUEUE_STATISTICS is set to 1.
+ */
+struct QueueStatistics {
+  /**
+   * @brief The largest number of items that has been in the queue after an
+   * item was posted.
+   */
+  UBaseType_t maxMessagesWaiting = 0;
+
+  /**
+   * @brief The number of send calls that failed to post an item.
+   */
+  uint32_t sendFailures = 0;
+
+  /**
+   * @brief The number of receive calls that failed to receive an item.
+   */
+  uint32_t receiveFailures = 0;
+
+  /**
+   * @brief The total number of ticks that tasks have spent inside blocking
+   * send, receive and peek calls.
+   */
+  TickType_t totalBlockedTicks = 0;
+
+  /**
+   * @brief The largest number of ticks a task has spent inside a single
+   * blocking send, receive or peek call.
+   */
+  TickType_t maxBlockedTicks = 0;
+};
+
+#endif /* FREERTOS_CPP_QUEUE_STATISTICS */
+
 /**
  * @class QueueBase Queue.hpp <FreeRTOS/Queue.hpp>
  *
@@ -44,16 +100,22 @@ namespace FreeRTOS {
  * @note This class is not intended to be instantiated by the user.  Use
  * FreeRTOS::Queue or FreeRTOS::StaticQueue.
  *
- * @tparam T Type to be stored in the queue.
+ * @tparam T Type to be stored in the queue.  Must be trivially copyable.
  */
 template <class T>
 class QueueBase {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Queue items are copied byte by byte by the kernel, so they "
+                "must be trivially copyable.");
+
  public:
   template <class>
   friend class Queue;
 
-  template <class, UBaseType_t>
+  template <class, UBaseType_t, class>
   friend class StaticQueue;
+  friend class QueueSetBase;
+  friend class QueueSetMember;
 
   QueueBase(const QueueBase&) = delete;
   QueueBase& operator=(const QueueBase&) = delete;
@@ -109,7 +171,24 @@ class QueueBase {
    */
   inline bool sendToBack(const T& item,
                          const TickType_t ticksToWait = portMAX_DELAY) const {
-    return (xQueueSendToBack(handle, &item, ticksToWait) == pdTRUE);
+    const TickType_t start = blockBegin(ticksToWait);
+    const bool result = Instrument::call(
+        InstrumentedCall::QueueSend, handle, ticksToWait, [&] {
+          return (xQueueSendToBack(handle, &item, ticksToWait) == pdTRUE);
+        });
+    recordSend(result, start, ticksToWait);
+    return result;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool sendToBack(
+      const T& item, const std::chrono::duration<Rep, Period>& timeout) const {
+    return sendToBack(item, Clock::toTicks(timeout));
   }
 
   /**
@@ -133,11 +212,14 @@ class QueueBase {
   inline bool sendToBackFromISR(bool& higherPriorityTaskWoken,
                                 const T& item) const {
     BaseType_t taskWoken = pdFALSE;
-    bool result =
-        (xQueueSendToBackFromISR(handle, &item, &taskWoken) == pdPASS);
+    bool result = Instrument::callFromISR(
+        InstrumentedCall::QueueSend, handle, [&] {
+          return (xQueueSendToBackFromISR(handle, &item, &taskWoken) == pdPASS);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
+    recordSendFromISR(result);
     return result;
   }
 
@@ -152,7 +234,124 @@ class QueueBase {
    * @overload
    */
   inline bool sendToBackFromISR(const T& item) const {
-    return (xQueueSendToBackFromISR(handle, &item, NULL) == pdPASS);
+    const bool result = Instrument::callFromISR(
+        InstrumentedCall::QueueSend, handle, [&] {
+          return (xQueueSendToBackFromISR(handle, &item, NULL) == pdPASS);
+        });
+    recordSendFromISR(result);
+    return result;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that posts several items to the back of a queue by calling
+   * <tt>xQueueSendToBack( xQueue, pvItemToQueue, xTicksToWait )</tt> once per
+   * item.
+   *
+   * @see <https://www.freertos.org/a00117.html>
+   *
+   * Only the first item may block waiting for space to become available.  Once
+   * the first item has been posted the remaining items are posted without
+   * blocking, and the function returns as soon as the queue is full.  This
+   * means a task that produces bursts of items is only ever put in the Blocked
+   * state once per burst.  The items are queued by copy, not by reference.
+   * This function must not be called from an interrupt service routine.  See
+   * sendToBackNFromISR() for an alternative which may be used in an ISR.
+   *
+   * @param items Pointer to the first of the items that are to be placed on the
+   * queue.
+   * @param count The number of items pointed to by items.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for space to become available on the queue for the first item, should the
+   * queue already be full.  The call will return immediately if this is set to
+   * 0 and the queue is full.
+   * @return size_t The number of items that were posted to the queue.
+   *
+   * <b>Example Usage</b>
+   * @include Queue/sendReceiveN.cpp
+   */
+  inline size_t sendToBackN(
+      const T* items, const size_t count,
+      const TickType_t ticksToWait = portMAX_DELAY) const {
+    size_t sent = 0;
+    if ((count > 0) && sendToBack(items[0], ticksToWait)) {
+      sent = 1;
+#if (FREERTOS_CPP_QUEUE_STATISTICS == 1)
+      // Stop before the send that would fail, so that it is not counted.
+      UBaseType_t spaces = spacesAvailable();
+      while ((sent < count) && (spaces-- > 0) && sendToBack(items[sent], 0)) {
+        sent++;
+      }
+#else
+      while ((sent < count) && sendToBack(items[sent], 0)) {
+        sent++;
+      }
+#endif /* FREERTOS_CPP_QUEUE_STATISTICS */
+    }
+    return sent;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline size_t sendToBackN(
+      const T* items, const size_t count,
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return sendToBackN(items, count, Clock::toTicks(timeout));
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that posts several items to the back of a queue by calling
+   * <tt>xQueueSendToBackFromISR( xQueue, pvItemToQueue,
+   * pxHigherPriorityTaskWoken )</tt> once per item.
+   *
+   * @see <https://www.freertos.org/xQueueSendToBackFromISR.html>
+   *
+   * Items are posted in order until either all of them have been posted or the
+   * queue is full.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * sending to the queue caused a task to unblock, and the unblocked task has a
+   * priority higher than the currently running task.
+   * @param items Pointer to the first of the items that are to be placed on the
+   * queue.
+   * @param count The number of items pointed to by items.
+   * @return size_t The number of items that were posted to the queue.
+   */
+  inline size_t sendToBackNFromISR(bool& higherPriorityTaskWoken,
+                                   const T* items, const size_t count) const {
+    size_t sent = 0;
+    while ((sent < count) && batchMaySendFromISR() &&
+           sendToBackFromISR(higherPriorityTaskWoken, items[sent])) {
+      sent++;
+    }
+    return sent;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that posts several items to the back of a queue by calling
+   * <tt>xQueueSendToBackFromISR( xQueue, pvItemToQueue,
+   * pxHigherPriorityTaskWoken )</tt> once per item.
+   *
+   * @see <https://www.freertos.org/xQueueSendToBackFromISR.html>
+   *
+   * @overload
+   */
+  inline size_t sendToBackNFromISR(const T* items, const size_t count) const {
+    size_t sent = 0;
+    while ((sent < count) && batchMaySendFromISR() &&
+           sendToBackFromISR(items[sent])) {
+      sent++;
+    }
+    return sent;
   }
 
   /**
@@ -177,7 +376,24 @@ class QueueBase {
    */
   inline bool sendToFront(const T& item,
                           const TickType_t ticksToWait = portMAX_DELAY) const {
-    return (xQueueSendToFront(handle, &item, ticksToWait) == pdTRUE);
+    const TickType_t start = blockBegin(ticksToWait);
+    const bool result = Instrument::call(
+        InstrumentedCall::QueueSend, handle, ticksToWait, [&] {
+          return (xQueueSendToFront(handle, &item, ticksToWait) == pdTRUE);
+        });
+    recordSend(result, start, ticksToWait);
+    return result;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool sendToFront(
+      const T& item, const std::chrono::duration<Rep, Period>& timeout) const {
+    return sendToFront(item, Clock::toTicks(timeout));
   }
 
   /**
@@ -201,11 +417,15 @@ class QueueBase {
   inline bool sendToFrontFromISR(bool& higherPriorityTaskWoken,
                                  const T& item) const {
     BaseType_t taskWoken = pdFALSE;
-    bool result =
-        (xQueueSendToFrontFromISR(handle, &item, &taskWoken) == pdPASS);
+    bool result = Instrument::callFromISR(
+        InstrumentedCall::QueueSend, handle, [&] {
+          return (xQueueSendToFrontFromISR(handle, &item, &taskWoken) ==
+                  pdPASS);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
+    recordSendFromISR(result);
     return result;
   }
 
@@ -220,7 +440,12 @@ class QueueBase {
    * @overload
    */
   inline bool sendToFrontFromISR(const T& item) const {
-    return (xQueueSendToFrontFromISR(handle, &item, NULL) == pdPASS);
+    const bool result = Instrument::callFromISR(
+        InstrumentedCall::QueueSend, handle, [&] {
+          return (xQueueSendToFrontFromISR(handle, &item, NULL) == pdPASS);
+        });
+    recordSendFromISR(result);
+    return result;
   }
 
   /**
@@ -249,10 +474,75 @@ class QueueBase {
    */
   inline std::optional<T> receive(
       const TickType_t ticksToWait = portMAX_DELAY) const {
-    T buffer;
-    return (xQueueReceive(handle, &buffer, ticksToWait) == pdTRUE)
-               ? std::optional<T>(buffer)
-               : std::nullopt;
+    Storage buffer;
+    const TickType_t start = blockBegin(ticksToWait);
+    const bool result = Instrument::call(
+        InstrumentedCall::QueueReceive, handle, ticksToWait, [&] {
+          return (xQueueReceive(handle, buffer.data, ticksToWait) == pdTRUE);
+        });
+    recordReceive(result, start, ticksToWait);
+    return result ? std::optional<T>(buffer.get()) : std::nullopt;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline std::optional<T> receive(
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return receive(Clock::toTicks(timeout));
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xQueueReceive( QueueHandle_t
+   * xQueue, void *pvBuffer, TickType_t xTicksToWait )</tt>
+   *
+   * @see <https://www.freertos.org/a00118.html>
+   *
+   * Receive an item from a queue directly into storage owned by the caller.
+   * The item is copied by the kernel straight into item, so no temporary object
+   * is constructed and T does not need to be default constructible.  This
+   * function must not be used in an interrupt service routine. See
+   * receiveFromISR() for an alternative that can.
+   *
+   * @param item A reference to the object that the received item will be
+   * copied into.  item is left unmodified if no item was received.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for an item to receive should the queue be empty at the time of the call.
+   * Setting ticksToWait to 0 will cause the function to return immediately if
+   * the queue is empty. The time is defined in tick periods so the constant
+   * portTICK_PERIOD_MS should be used to convert to real time if this is
+   * required.
+   * @retval true if an item was successfully received from the queue.
+   * @retval false otherwise.
+   *
+   * <b>Example Usage</b>
+   * @include Queue/receiveInPlace.cpp
+   */
+  inline bool receive(T& item,
+                      const TickType_t ticksToWait = portMAX_DELAY) const {
+    const TickType_t start = blockBegin(ticksToWait);
+    const bool result = Instrument::call(
+        InstrumentedCall::QueueReceive, handle, ticksToWait, [&] {
+          return (xQueueReceive(handle, &item, ticksToWait) == pdTRUE);
+        });
+    recordReceive(result, start, ticksToWait);
+    return result;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool receive(T& item,
+                      const std::chrono::duration<Rep, Period>& timeout) const {
+    return receive(item, Clock::toTicks(timeout));
   }
 
   /**
@@ -277,13 +567,18 @@ class QueueBase {
    * @include Queue/receiveFromISR.cpp
    */
   inline std::optional<T> receiveFromISR(bool& higherPriorityTaskWoken) const {
-    T buffer;
+    Storage buffer;
     BaseType_t taskWoken = pdFALSE;
-    bool result = (xQueueReceiveFromISR(handle, &buffer, &taskWoken) == pdTRUE);
+    bool result = Instrument::callFromISR(
+        InstrumentedCall::QueueReceive, handle, [&] {
+          return (xQueueReceiveFromISR(handle, buffer.data, &taskWoken) ==
+                  pdTRUE);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
-    return result ? std::optional<T>(buffer) : std::nullopt;
+    recordReceiveFromISR(result);
+    return result ? std::optional<T>(buffer.get()) : std::nullopt;
   }
 
   /**
@@ -298,10 +593,177 @@ class QueueBase {
    * @overload
    */
   inline std::optional<T> receiveFromISR() const {
-    T buffer;
-    return (xQueueReceiveFromISR(handle, &buffer, NULL) == pdTRUE)
-               ? std::optional<T>(buffer)
-               : std::nullopt;
+    Storage buffer;
+    const bool result = Instrument::callFromISR(
+        InstrumentedCall::QueueReceive, handle, [&] {
+          return (xQueueReceiveFromISR(handle, buffer.data, NULL) == pdTRUE);
+        });
+    recordReceiveFromISR(result);
+    return result ? std::optional<T>(buffer.get()) : std::nullopt;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xQueueReceiveFromISR(
+   * QueueHandle_t xQueue, void *pvBuffer, BaseType_t *pxHigherPriorityTaskWoken
+   * )</tt>
+   *
+   * @see <https://www.freertos.org/a00120.html>
+   *
+   * Receive an item from a queue directly into storage owned by the caller. It
+   * is safe to use this function from within an interrupt service routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * sending to the queue caused a task to unblock, and the unblocked task has a
+   * priority higher than the currently running task.
+   * @param item A reference to the object that the received item will be
+   * copied into.  item is left unmodified if no item was received.
+   * @retval true if an item was successfully received from the queue.
+   * @retval false otherwise.
+   */
+  inline bool receiveFromISR(bool& higherPriorityTaskWoken, T& item) const {
+    BaseType_t taskWoken = pdFALSE;
+    bool result = Instrument::callFromISR(
+        InstrumentedCall::QueueReceive, handle, [&] {
+          return (xQueueReceiveFromISR(handle, &item, &taskWoken) == pdTRUE);
+        });
+    if (taskWoken == pdTRUE) {
+      higherPriorityTaskWoken = true;
+    }
+    recordReceiveFromISR(result);
+    return result;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xQueueReceiveFromISR(
+   * QueueHandle_t xQueue, void *pvBuffer, BaseType_t *pxHigherPriorityTaskWoken
+   * )</tt>
+   *
+   * @see <https://www.freertos.org/a00120.html>
+   *
+   * @overload
+   */
+  inline bool receiveFromISR(T& item) const {
+    const bool result = Instrument::callFromISR(
+        InstrumentedCall::QueueReceive, handle, [&] {
+          return (xQueueReceiveFromISR(handle, &item, NULL) == pdTRUE);
+        });
+    recordReceiveFromISR(result);
+    return result;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that receives several items from a queue by calling
+   * <tt>BaseType_t xQueueReceive( QueueHandle_t xQueue, void *pvBuffer,
+   * TickType_t xTicksToWait )</tt> once per item.
+   *
+   * @see <https://www.freertos.org/a00118.html>
+   *
+   * Only the first item may block waiting for data to become available.  Once
+   * the first item has been received every other item that is already in the
+   * queue is received without blocking, up to maxItems.  A task draining a
+   * bursty queue is therefore only woken once per burst instead of once per
+   * item.  This function must not be used in an interrupt service routine. See
+   * receiveNFromISR() for an alternative that can.
+   *
+   * @param items Pointer to the first element of an array that the received
+   * items will be copied into.
+   * @param maxItems The maximum number of items to receive.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for the first item should the queue be empty at the time of the call.
+   * Setting ticksToWait to 0 will cause the function to return immediately if
+   * the queue is empty.
+   * @return size_t The number of items that were received.
+   *
+   * <b>Example Usage</b>
+   * @include Queue/sendReceiveN.cpp
+   */
+  inline size_t receiveN(T* items, const size_t maxItems,
+                         const TickType_t ticksToWait = portMAX_DELAY) const {
+    size_t received = 0;
+    if ((maxItems > 0) && receive(items[0], ticksToWait)) {
+      received = 1;
+#if (FREERTOS_CPP_QUEUE_STATISTICS == 1)
+      // Stop before the receive that would fail, so that it is not counted.
+      UBaseType_t waiting = messagesWaiting();
+      while ((received < maxItems) && (waiting-- > 0) &&
+             receive(items[received], 0)) {
+        received++;
+      }
+#else
+      while ((received < maxItems) && receive(items[received], 0)) {
+        received++;
+      }
+#endif /* FREERTOS_CPP_QUEUE_STATISTICS */
+    }
+    return received;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline size_t receiveN(
+      T* items, const size_t maxItems,
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return receiveN(items, maxItems, Clock::toTicks(timeout));
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that receives several items from a queue by calling
+   * <tt>BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void *pvBuffer,
+   * BaseType_t *pxHigherPriorityTaskWoken )</tt> once per item.
+   *
+   * @see <https://www.freertos.org/a00120.html>
+   *
+   * Items are received until either maxItems have been received or the queue
+   * is empty.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * receiving from the queue caused a task to unblock, and the unblocked task
+   * has a priority higher than the currently running task.
+   * @param items Pointer to the first element of an array that the received
+   * items will be copied into.
+   * @param maxItems The maximum number of items to receive.
+   * @return size_t The number of items that were received.
+   */
+  inline size_t receiveNFromISR(bool& higherPriorityTaskWoken, T* items,
+                                const size_t maxItems) const {
+    size_t received = 0;
+    while ((received < maxItems) && batchMayReceiveFromISR() &&
+           receiveFromISR(higherPriorityTaskWoken, items[received])) {
+      received++;
+    }
+    return received;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that receives several items from a queue by calling
+   * <tt>BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void *pvBuffer,
+   * BaseType_t *pxHigherPriorityTaskWoken )</tt> once per item.
+   *
+   * @see <https://www.freertos.org/a00120.html>
+   *
+   * @overload
+   */
+  inline size_t receiveNFromISR(T* items, const size_t maxItems) const {
+    size_t received = 0;
+    while ((received < maxItems) && batchMayReceiveFromISR() &&
+           receiveFromISR(items[received])) {
+      received++;
+    }
+    return received;
   }
 
   /**
@@ -474,10 +936,73 @@ class QueueBase {
    */
   inline std::optional<T> peek(
       const TickType_t ticksToWait = portMAX_DELAY) const {
-    T buffer;
-    return (xQueuePeek(handle, &buffer, ticksToWait) == pdTRUE)
-               ? std::optional<T>(buffer)
-               : std::nullopt;
+    Storage buffer;
+    const TickType_t start = blockBegin(ticksToWait);
+    const bool result = Instrument::call(
+        InstrumentedCall::QueuePeek, handle, ticksToWait, [&] {
+          return (xQueuePeek(handle, buffer.data, ticksToWait) == pdTRUE);
+        });
+    recordPeek(start, ticksToWait);
+    return result ? std::optional<T>(buffer.get()) : std::nullopt;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline std::optional<T> peek(
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return peek(Clock::toTicks(timeout));
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xQueuePeek( QueueHandle_t xQueue,
+   * void * const pvBuffer, TickType_t xTicksToWait )</tt>
+   *
+   * @see <https://www.freertos.org/xQueuePeek.html>
+   *
+   * Receive an item from a queue without removing the item from the queue.  The
+   * item is copied by the kernel straight into storage owned by the caller.
+   *
+   * This function must not be used in an interrupt service routine.  See
+   * peekFromISR() for an alternative that can be called from an interrupt
+   * service routine.
+   *
+   * @param item A reference to the object that the peeked item will be copied
+   * into.  item is left unmodified if no item was available.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for an item to receive should the queue be empty at the time of the call.
+   * Setting ticksToWait to 0 will cause the function to return immediately if
+   * the queue is empty. The time is defined in tick periods so the constant
+   * portTICK_PERIOD_MS should be used to convert to real time if this is
+   * required.
+   * @retval true if an item was successfully peeked from the queue.
+   * @retval false otherwise.
+   */
+  inline bool peek(T& item,
+                   const TickType_t ticksToWait = portMAX_DELAY) const {
+    const TickType_t start = blockBegin(ticksToWait);
+    const bool result = Instrument::call(
+        InstrumentedCall::QueuePeek, handle, ticksToWait, [&] {
+          return (xQueuePeek(handle, &item, ticksToWait) == pdTRUE);
+        });
+    recordPeek(start, ticksToWait);
+    return result;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool peek(T& item,
+                   const std::chrono::duration<Rep, Period>& timeout) const {
+    return peek(item, Clock::toTicks(timeout));
   }
 
   /**
@@ -500,10 +1025,34 @@ class QueueBase {
    * value is present.
    */
   inline std::optional<T> peekFromISR() const {
-    T buffer;
-    return (xQueuePeekFromISR(handle, &buffer) == pdTRUE)
-               ? std::optional<T>(buffer)
-               : std::nullopt;
+    Storage buffer;
+    const bool result =
+        Instrument::callFromISR(InstrumentedCall::QueuePeek, handle, [&] {
+          return (xQueuePeekFromISR(handle, buffer.data) == pdTRUE);
+        });
+    return result ? std::optional<T>(buffer.get()) : std::nullopt;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xQueuePeekFromISR( QueueHandle_t
+   * xQueue, void *pvBuffer )</tt>
+   *
+   * @see <https://www.freertos.org/xQueuePeekFromISR.html>
+   *
+   * A version of peek() that can be called from an interrupt service routine
+   * (ISR) and copies the item straight into storage owned by the caller.
+   *
+   * @param item A reference to the object that the peeked item will be copied
+   * into.  item is left unmodified if no item was available.
+   * @retval true if an item was successfully peeked from the queue.
+   * @retval false otherwise.
+   */
+  inline bool peekFromISR(T& item) const {
+    return Instrument::callFromISR(InstrumentedCall::QueuePeek, handle, [&] {
+      return (xQueuePeekFromISR(handle, &item) == pdTRUE);
+    });
   }
 
   /**
@@ -613,6 +1162,45 @@ class QueueBase {
     return (xQueueIsQueueEmptyFromISR(handle) == pdTRUE);
   }
 
+#if (FREERTOS_CPP_QUEUE_STATISTICS == 1)
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that returns a copy of the usage statistics of the queue.
+   *
+   * FREERTOS_CPP_QUEUE_STATISTICS must be defined as 1 for this function to be
+   * available.  The statistics are copied while holding the
+   * FreeRTOS::ObjectLock of the queue, so this can safely be called from a
+   * monitor task while other tasks use the queue.
+   *
+   * @return QueueStatistics The statistics recorded since the queue was created
+   * or resetStatistics() was last called.
+   *
+   * <b>Example Usage</b>
+   * @include Queue/statistics.cpp
+   */
+  inline QueueStatistics getStatistics() const {
+    statisticsLock.enter();
+    const QueueStatistics copy = statistics;
+    statisticsLock.exit();
+    return copy;
+  }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that clears the usage statistics of the queue.
+   *
+   * FREERTOS_CPP_QUEUE_STATISTICS must be defined as 1 for this function to be
+   * available.
+   */
+  inline void resetStatistics() const {
+    statisticsLock.enter();
+    statistics = QueueStatistics();
+    statisticsLock.exit();
+  }
+#endif /* FREERTOS_CPP_QUEUE_STATISTICS */
+
  private:
   /**
    * Queue.hpp
@@ -637,12 +1225,132 @@ class QueueBase {
    * placed on the queue.
    */
   ~QueueBase() {
-    vQueueDelete(this->handle);
+    if (this->handle != NULL) {
+      vQueueDelete(this->handle);
+    }
   }
 
   QueueBase(QueueBase&&) noexcept = default;
   QueueBase& operator=(QueueBase&&) noexcept = default;
 
+  /**
+   * @brief Uninitialized storage that the kernel copies a received item into.
+   * This avoids requiring T to be default constructible and avoids running a
+   * constructor on an object that is immediately overwritten.
+   */
+  struct Storage {
+    inline T& get() {
+      return *std::launder(reinterpret_cast<T*>(data));  // NOLINT
+    }
+
+    alignas(T) uint8_t data[sizeof(T)];
+  };
+
+#if (FREERTOS_CPP_QUEUE_STATISTICS == 1)
+  inline static TickType_t blockBegin(const TickType_t ticksToWait) {
+    return (ticksToWait != 0) ? xTaskGetTickCount() : 0;
+  }
+
+  inline void recordBlocked(const TickType_t start,
+                            const TickType_t ticksToWait) const {
+    if (ticksToWait != 0) {
+      const TickType_t blocked = xTaskGetTickCount() - start;
+      statistics.totalBlockedTicks += blocked;
+      if (blocked > statistics.maxBlockedTicks) {
+        statistics.maxBlockedTicks = blocked;
+      }
+    }
+  }
+
+  inline void recordSend(const bool result, const TickType_t start,
+                         const TickType_t ticksToWait) const {
+    const UBaseType_t waiting = result ? uxQueueMessagesWaiting(handle) : 0;
+    statisticsLock.enter();
+    recordBlocked(start, ticksToWait);
+    if (!result) {
+      statistics.sendFailures++;
+    } else if (waiting > statistics.maxMessagesWaiting) {
+      statistics.maxMessagesWaiting = waiting;
+    }
+    statisticsLock.exit();
+  }
+
+  inline void recordSendFromISR(const bool result) const {
+    const UBaseType_t waiting =
+        result ? uxQueueMessagesWaitingFromISR(handle) : 0;
+    const UBaseType_t interruptStatus = statisticsLock.enterFromISR();
+    if (!result) {
+      statistics.sendFailures++;
+    } else if (waiting > statistics.maxMessagesWaiting) {
+      statistics.maxMessagesWaiting = waiting;
+    }
+    statisticsLock.exitFromISR(interruptStatus);
+  }
+
+  inline void recordReceive(const bool result, const TickType_t start,
+                            const TickType_t ticksToWait) const {
+    statisticsLock.enter();
+    recordBlocked(start, ticksToWait);
+    if (!result) {
+      statistics.receiveFailures++;
+    }
+    statisticsLock.exit();
+  }
+
+  inline void recordReceiveFromISR(const bool result) const {
+    if (!result) {
+      const UBaseType_t interruptStatus = statisticsLock.enterFromISR();
+      statistics.receiveFailures++;
+      statisticsLock.exitFromISR(interruptStatus);
+    }
+  }
+
+  inline void recordPeek(const TickType_t start,
+                         const TickType_t ticksToWait) const {
+    statisticsLock.enter();
+    recordBlocked(start, ticksToWait);
+    statisticsLock.exit();
+  }
+
+  // The ISR batch functions stop before the call that would fail, so that it
+  // is not counted as a failure.
+  inline bool batchMaySendFromISR() const {
+    return !isFullFromISR();
+  }
+
+  inline bool batchMayReceiveFromISR() const {
+    return !isEmptyFromISR();
+  }
+
+  /**
+   * @brief Usage statistics of the queue.
+   */
+  mutable QueueStatistics statistics;
+
+  /**
+   * @brief Lock that protects the statistics, so that queues used on
+   * different cores do not contend for the kernel lock.
+   */
+  ObjectLock statisticsLock;
+#else
+  inline static constexpr TickType_t blockBegin(const TickType_t) {
+    return 0;
+  }
+  inline void recordSend(const bool, const TickType_t,
+                         const TickType_t) const {}
+  inline void recordSendFromISR(const bool) const {}
+  inline void recordReceive(const bool, const TickType_t,
+                            const TickType_t) const {}
+  inline void recordReceiveFromISR(const bool) const {}
+  inline void recordPeek(const TickType_t, const TickType_t) const {}
+  inline static constexpr bool batchMaySendFromISR() {
+    return true;
+  }
+  inline static constexpr bool batchMayReceiveFromISR() {
+    return true;
+  }
+#endif /* FREERTOS_CPP_QUEUE_STATISTICS */
+
   /**
    * @brief Handle used to refer to the queue when using the FreeRTOS interface.
    */
@@ -711,8 +1419,12 @@ class Queue : public QueueBase<T> {
  *
  * @tparam T Type to be stored in the queue.
  * @tparam N The maximum number of items the queue can hold at any one time.
+ * @tparam Region The memory region that holds the queue control block and
+ * storage.  By default they are part of the object instance.  A region defined
+ * with FREERTOS_CPP_DEFINE_REGION() places them in a linker section, such as
+ * tightly coupled RAM, independently of where the object itself is placed.
  */
-template <class T, UBaseType_t N>
+template <class T, UBaseType_t N, class Region = DefaultRegion>
 class StaticQueue : public QueueBase<T> {
  public:
   /**
@@ -733,8 +1445,22 @@ class StaticQueue : public QueueBase<T> {
    * @include Queue/staticQueue.cpp
    */
   StaticQueue() {
-    this->handle = xQueueCreateStatic(N, sizeof(T), storage, &staticQueue);
+    create();
   }
+
+  /**
+   * Queue.hpp
+   *
+   * @brief Construct a new StaticQueue object without creating the queue.
+   *
+   * This constructor is constexpr, so a global object constructed with it is
+   * constant initialized.  create() must be called before the queue is used.
+   *
+   * <b>Example Usage</b>
+   * @include DeferCreate/deferCreate.cpp
+   */
+  constexpr explicit StaticQueue(DeferCreate)
+      : staticQueue(deferCreate), storage(deferCreate) {}
   ~StaticQueue() = default;
 
   StaticQueue(const StaticQueue&) = delete;
@@ -743,9 +1469,32 @@ class StaticQueue : public QueueBase<T> {
   StaticQueue(StaticQueue&&) noexcept = default;
   StaticQueue& operator=(StaticQueue&&) noexcept = default;
 
+  /**
+   * Queue.hpp
+   *
+   * @brief Function that calls <tt>QueueHandle_t xQueueCreateStatic(
+   * UBaseType_t uxQueueLength, UBaseType_t uxItemSize, uint8_t
+   * *pucQueueStorageBuffer, StaticQueue_t *pxQueueBuffer )</tt> to create a
+   * queue that was constructed with FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/xQueueCreateStatic.html>
+   *
+   * @retval true If the queue was created.
+   * @retval false Otherwise.
+   *
+   * <b>Example Usage</b>
+   * @include DeferCreate/deferCreate.cpp
+   */
+  bool create() {
+    configASSERT(this->handle == NULL);
+    this->handle =
+        xQueueCreateStatic(N, sizeof(T), storage.get(), staticQueue.get());
+    return (this->handle != NULL);
+  }
+
  private:
-  StaticQueue_t staticQueue;
-  uint8_t storage[N * sizeof(T)];
+  RegionStorage<StaticQueue_t, 1, Region> staticQueue;
+  RegionStorage<uint8_t, N * sizeof(T), Region> storage;
 };
 
 #endif /* configSUPPORT_STATIC_ALLOCATION */
@@ -0,0 +1,478 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_QUEUESET_HPP
+#define FREERTOS_QUEUESET_HPP
+
+#include <FreeRTOS/Mutex.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Semaphore.hpp>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#if (configUSE_QUEUE_SETS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class QueueSetMember QueueSet.hpp <FreeRTOS/QueueSet.hpp>
+ *
+ * @brief Class that refers to the member of a queue set that was selected by
+ * FreeRTOS::QueueSetBase::select().
+ *
+ * The selected member can be compared against the objects that were added to
+ * the queue set, and converted back into a typed pointer with as().
+ */
+class QueueSetMember {
+ public:
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Construct a new QueueSetMember object.
+   *
+   * @param handle Handle of the queue set member, or NULL if no member was
+   * selected.
+   */
+  explicit QueueSetMember(const QueueSetMemberHandle_t handle = NULL)
+      : handle(handle) {}
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that checks if a member was selected.
+   *
+   * @retval true A member of the queue set contains data.
+   * @retval false The block time expired before a member contained data.
+   */
+  inline bool isValid() const {
+    return (handle != NULL);
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that checks if the selected member is the given queue.
+   *
+   * @tparam T Type stored in the queue.
+   * @param queue The queue to compare against.
+   * @retval true If queue is the selected member.
+   * @retval false Otherwise.
+   */
+  template <class T>
+  inline bool is(const QueueBase<T>& queue) const {
+    return (handle == queue.handle);
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that checks if the selected member is the given semaphore.
+   *
+   * @param semaphore The semaphore to compare against.
+   * @retval true If semaphore is the selected member.
+   * @retval false Otherwise.
+   */
+  inline bool is(const SemaphoreBase& semaphore) const {
+    return (handle == semaphore.handle);
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that checks if the selected member is the given mutex.
+   *
+   * @param mutex The mutex to compare against.
+   * @retval true If mutex is the selected member.
+   * @retval false Otherwise.
+   */
+  inline bool is(const MutexBase& mutex) const {
+    return (handle == mutex.handle);
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that returns a typed pointer to candidate if it is the
+   * selected member.
+   *
+   * @tparam Member Type of the candidate object.  This can be any class derived
+   * from FreeRTOS::QueueBase, FreeRTOS::SemaphoreBase, or FreeRTOS::MutexBase.
+   * @param candidate The object that may be the selected member.
+   * @return Member* Pointer to candidate if it is the selected member, NULL
+   * otherwise.
+   *
+   * <b>Example Usage</b>
+   * @include QueueSet/queueSet.cpp
+   */
+  template <class Member>
+  inline Member* as(Member& candidate) const {
+    return is(candidate) ? &candidate : NULL;
+  }
+
+ private:
+  QueueSetMemberHandle_t handle;
+};
+
+/**
+ * @class QueueSetBase QueueSet.hpp <FreeRTOS/QueueSet.hpp>
+ *
+ * @brief Base class that provides the standard queue set interface to
+ * FreeRTOS::QueueSet and FreeRTOS::StaticQueueSet.
+ *
+ * Queue sets provide a mechanism to allow a task to block (pend) on a read
+ * operation from multiple queues, semaphores, or mutexes simultaneously.
+ *
+ * configUSE_QUEUE_SETS must be set to 1 in FreeRTOSConfig.h for this class to
+ * be available.
+ *
+ * @note This class is not intended to be instantiated by the user.  Use
+ * FreeRTOS::QueueSet or FreeRTOS::StaticQueueSet.
+ */
+class QueueSetBase {
+ public:
+  friend class QueueSet;
+  template <UBaseType_t>
+  friend class StaticQueueSet;
+
+  QueueSetBase(const QueueSetBase&) = delete;
+  QueueSetBase& operator=(const QueueSetBase&) = delete;
+
+  static void* operator new(size_t) = delete;
+  static void* operator new[](size_t) = delete;
+
+  static void* operator new(size_t, void* ptr) {
+    return ptr;
+  }
+
+  static void* operator new[](size_t, void* ptr) {
+    return ptr;
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that checks if the underlying queue set handle is not NULL.
+   * This should be used to ensure a queue set has been created correctly.
+   *
+   * @retval true the handle is not NULL.
+   * @retval false the handle is NULL.
+   */
+  inline bool isValid() const {
+    return (handle != NULL);
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xQueueAddToSet(
+   * QueueSetMemberHandle_t xQueueOrSemaphore, QueueSetHandle_t xQueueSet
+   * )</tt>
+   *
+   * @see <https://www.freertos.org/xQueueAddToSet.html>
+   *
+   * Adds a queue to a queue set.  A queue can only be added to a queue set if
+   * it is empty, and can only be a member of one set at a time.
+   *
+   * @tparam T Type stored in the queue.
+   * @param queue The queue that is being added to the queue set.
+   * @retval true If the queue was successfully added to the queue set.
+   * @retval false If the queue could not be added because it is already a
+   * member of a different set or it is not empty.
+   */
+  template <class T>
+  inline bool add(const QueueBase<T>& queue) const {
+    return (xQueueAddToSet(queue.handle, handle) == pdPASS);
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xQueueAddToSet(
+   * QueueSetMemberHandle_t xQueueOrSemaphore, QueueSetHandle_t xQueueSet
+   * )</tt>
+   *
+   * @see <https://www.freertos.org/xQueueAddToSet.html>
+   *
+   * Adds a semaphore to a queue set.  A semaphore can only be added to a queue
+   * set if its count is zero.
+   *
+   * @param semaphore The semaphore that is being added to the queue set.
+   * @retval true If the semaphore was successfully added to the queue set.
+   * @retval false Otherwise.
+   */
+  inline bool add(const SemaphoreBase& semaphore) const {
+    return (xQueueAddToSet(semaphore.handle, handle) == pdPASS);
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xQueueAddToSet(
+   * QueueSetMemberHandle_t xQueueOrSemaphore, QueueSetHandle_t xQueueSet
+   * )</tt>
+   *
+   * @see <https://www.freertos.org/xQueueAddToSet.html>
+   *
+   * Adds a mutex to a queue set.  A mutex can only be added to a queue set if
+   * it is currently locked.
+   *
+   * @param mutex The mutex that is being added to the queue set.
+   * @retval true If the mutex was successfully added to the queue set.
+   * @retval false Otherwise.
+   */
+  inline bool add(const MutexBase& mutex) const {
+    return (xQueueAddToSet(mutex.handle, handle) == pdPASS);
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xQueueRemoveFromSet(
+   * QueueSetMemberHandle_t xQueueOrSemaphore, QueueSetHandle_t xQueueSet
+   * )</tt>
+   *
+   * @see <https://www.freertos.org/xQueueRemoveFromSet.html>
+   *
+   * Removes a queue from the queue set.  A queue can only be removed from a set
+   * if the queue is empty.
+   *
+   * @tparam T Type stored in the queue.
+   * @param queue The queue that is being removed from the queue set.
+   * @retval true If the queue was successfully removed from the queue set.
+   * @retval false If the queue was not in the queue set, or the queue was not
+   * empty.
+   */
+  template <class T>
+  inline bool remove(const QueueBase<T>& queue) const {
+    return (xQueueRemoveFromSet(queue.handle, handle) == pdPASS);
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xQueueRemoveFromSet(
+   * QueueSetMemberHandle_t xQueueOrSemaphore, QueueSetHandle_t xQueueSet
+   * )</tt>
+   *
+   * @see <https://www.freertos.org/xQueueRemoveFromSet.html>
+   *
+   * @overload
+   */
+  inline bool remove(const SemaphoreBase& semaphore) const {
+    return (xQueueRemoveFromSet(semaphore.handle, handle) == pdPASS);
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xQueueRemoveFromSet(
+   * QueueSetMemberHandle_t xQueueOrSemaphore, QueueSetHandle_t xQueueSet
+   * )</tt>
+   *
+   * @see <https://www.freertos.org/xQueueRemoveFromSet.html>
+   *
+   * @overload
+   */
+  inline bool remove(const MutexBase& mutex) const {
+    return (xQueueRemoveFromSet(mutex.handle, handle) == pdPASS);
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that calls <tt>QueueSetMemberHandle_t xQueueSelectFromSet(
+   * QueueSetHandle_t xQueueSet, const TickType_t xTicksToWait )</tt>
+   *
+   * @see <https://www.freertos.org/xQueueSelectFromSet.html>
+   *
+   * select() selects from the members of a queue set a queue or semaphore that
+   * either contains data (in the case of a queue) or is available to take (in
+   * the case of a semaphore).  select() effectively allows a task to block
+   * (pend) on a read operation on all the queues and semaphores in a queue set
+   * simultaneously.
+   *
+   * @note Data must always be read from the selected member before select() is
+   * called again.  The read should use a block time of zero because the member
+   * is known to contain data.
+   *
+   * @param ticksToWait The maximum time, in ticks, that the calling task will
+   * remain in the Blocked state (with other tasks executing) to wait for a
+   * member of the queue set to be ready for a successful queue read or
+   * semaphore take operation.
+   * @return QueueSetMember The member of the queue set that contains data.  Use
+   * QueueSetMember::isValid() to check whether the block time expired.
+   *
+   * <b>Example Usage</b>
+   * @include QueueSet/queueSet.cpp
+   */
+  inline QueueSetMember select(
+      const TickType_t ticksToWait = portMAX_DELAY) const {
+    return QueueSetMember(xQueueSelectFromSet(handle, ticksToWait));
+  }
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Function that calls <tt>QueueSetMemberHandle_t
+   * xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet )</tt>
+   *
+   * @see <https://www.freertos.org/xQueueSelectFromSetFromISR.html>
+   *
+   * A version of select() that can be used from an interrupt service routine.
+   *
+   * @return QueueSetMember The member of the queue set that contains data.  Use
+   * QueueSetMember::isValid() to check whether a member was selected.
+   */
+  inline QueueSetMember selectFromISR() const {
+    return QueueSetMember(xQueueSelectFromSetFromISR(handle));
+  }
+
+ private:
+  QueueSetBase() = default;
+
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Destroy the QueueSetBase object by calling <tt>void vQueueDelete(
+   * QueueHandle_t xQueue )</tt>
+   *
+   * @see <https://www.freertos.org/a00018.html#vQueueDelete>
+   */
+  ~QueueSetBase() {
+    vQueueDelete(this->handle);
+  }
+
+  QueueSetBase(QueueSetBase&&) noexcept = default;
+  QueueSetBase& operator=(QueueSetBase&&) noexcept = default;
+
+  /**
+   * @brief Handle used to refer to the queue set when using the FreeRTOS
+   * interface.
+   */
+  QueueSetHandle_t handle = NULL;
+};
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+
+/**
+ * @class QueueSet QueueSet.hpp <FreeRTOS/QueueSet.hpp>
+ *
+ * @brief Class that encapsulates the functionality of a FreeRTOS queue set.
+ *
+ * If a queue set is created using this class then the required RAM is
+ * automatically allocated from the FreeRTOS heap.
+ */
+class QueueSet : public QueueSetBase {
+ public:
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Construct a new QueueSet object by calling <tt>QueueSetHandle_t
+   * xQueueCreateSet( const UBaseType_t uxEventQueueLength )</tt>
+   *
+   * @see <https://www.freertos.org/xQueueCreateSet.html>
+   *
+   * @warning The user should call isValid() on this object to verify that the
+   * queue set was created successfully in case the memory required to create
+   * the queue set could not be allocated.
+   *
+   * @param eventQueueLength The maximum number of events that can be queued at
+   * once.  To be absolutely certain that events are not lost this must be at
+   * least the sum of the lengths of all the queues added to the set, where
+   * binary semaphores and mutexes have a length of 1 and counting semaphores
+   * have a length set by their maximum count value.
+   */
+  explicit QueueSet(const UBaseType_t eventQueueLength) {
+    this->handle = xQueueCreateSet(eventQueueLength);
+  }
+  ~QueueSet() = default;
+
+  QueueSet(const QueueSet&) = delete;
+  QueueSet& operator=(const QueueSet&) = delete;
+
+  QueueSet(QueueSet&&) noexcept = default;
+  QueueSet& operator=(QueueSet&&) noexcept = default;
+};
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+/**
+ * @class StaticQueueSet QueueSet.hpp <FreeRTOS/QueueSet.hpp>
+ *
+ * @brief Class that encapsulates the functionality of a FreeRTOS queue set.
+ *
+ * If a queue set is created using this class then the RAM is provided by the
+ * application writer as part of the object instance and allows the RAM to be
+ * statically allocated at compile time.
+ *
+ * @tparam N The maximum number of events that can be queued at once.  This must
+ * be at least the sum of the lengths of all the members added to the set.
+ */
+template <UBaseType_t N>
+class StaticQueueSet : public QueueSetBase {
+ public:
+  /**
+   * QueueSet.hpp
+   *
+   * @brief Construct a new StaticQueueSet object by calling
+   * <tt>QueueSetHandle_t xQueueCreateSetStatic( const UBaseType_t
+   * uxEventQueueLength, uint8_t *pucQueueStorage, StaticQueue_t
+   * *pxStaticQueue )</tt>
+   *
+   * @warning This class contains the storage buffer for the queue set, so the
+   * user should create this object as a global object or with the static
+   * storage specifier so that the object instance is not on the stack.
+   *
+   * <b>Example Usage</b>
+   * @include QueueSet/queueSet.cpp
+   */
+  StaticQueueSet() {
+    this->handle = xQueueCreateSetStatic(N, storage, &staticQueue);
+  }
+  ~StaticQueueSet() = default;
+
+  StaticQueueSet(const StaticQueueSet&) = delete;
+  StaticQueueSet& operator=(const StaticQueueSet&) = delete;
+
+  StaticQueueSet(StaticQueueSet&&) noexcept = default;
+  StaticQueueSet& operator=(StaticQueueSet&&) noexcept = default;
+
+ private:
+  StaticQueue_t staticQueue;
+  uint8_t storage[N * sizeof(QueueSetMemberHandle_t)];
+};
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_QUEUE_SETS */
+
+#endif  // FREERTOS_QUEUESET_HPP
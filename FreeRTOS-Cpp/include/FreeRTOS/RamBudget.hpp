@@ -0,0 +1,127 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_RAMBUDGET_HPP
+#define FREERTOS_RAMBUDGET_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace FreeRTOS {
+
+/**
+ * @brief Trait that gives the number of bytes of RAM used by an object of type
+ * T.
+ *
+ * This is <tt>sizeof(T)</tt>, which for the static kernel object classes
+ * includes both the control block and the storage.  A region policy defined
+ * with FREERTOS_CPP_DEFINE_REGION() counts the size of its whole buffer, as
+ * objects that use the region only hold pointers to their storage.  A
+ * FreeRTOS::RamBudget counts the RAM used by its objects.
+ *
+ * Specialize this trait for a type that owns memory outside of the object, for
+ * example a class that allocates from a FreeRTOS::StaticArena.
+ *
+ * @tparam T The type of the object.
+ */
+template <class T, class = void>
+struct RamSize : std::integral_constant<size_t, sizeof(T)> {};
+
+template <class T>
+struct RamSize<T, std::void_t<decltype(T::regionSize)>>
+    : std::integral_constant<size_t, T::regionSize> {};
+
+/**
+ * @brief Class whose instantiation fails, showing the used and budgeted number
+ * of bytes in the compiler diagnostic, when a FreeRTOS::RamBudget is exceeded.
+ */
+template <size_t Used, size_t Budget>
+struct RamBudgetCheck {
+  static_assert(Used <= Budget,
+                "RAM budget exceeded.  See RamBudgetCheck<Used, Budget>.");
+  static constexpr bool value = true;
+};
+
+/**
+ * @class RamBudget RamBudget.hpp <FreeRTOS/RamBudget.hpp>
+ *
+ * @brief Class that adds up the RAM used by a set of statically allocated
+ * objects at compile time and checks the total against a budget.
+ *
+ * List the types of the objects of a subsystem, normally with
+ * <tt>decltype</tt> on their declarations so the budget follows any change to
+ * a stack depth or queue length.  A budget exceeding its limit fails to
+ * compile, and the diagnostic contains the used and budgeted number of bytes.
+ * A budget can list other budgets, so a budget for the whole application can
+ * be built from one budget per subsystem, with the members of each one giving
+ * the per subsystem breakdown.
+ *
+ * Only the objects that are listed are counted.  Memory from the FreeRTOS heap
+ * and the stacks of the scheduler's own tasks must be budgeted separately.
+ *
+ * @tparam Budget The maximum number of bytes the objects may use.
+ * @tparam Objects The types of the objects.
+ *
+ * <b>Example Usage</b>
+ * @include RamBudget/ramBudget.cpp
+ */
+template <size_t Budget, class... Objects>
+class RamBudget {
+ public:
+  RamBudget() = delete;
+
+  /**
+   * @brief The number of bytes the objects may use.
+   */
+  static constexpr size_t budget = Budget;
+
+  /**
+   * @brief The number of bytes used by the objects.
+   */
+  static constexpr size_t used = (RamSize<Objects>::value + ... + 0);
+
+  static_assert(RamBudgetCheck<used, budget>::value);
+
+  /**
+   * @brief The number of bytes left in the budget.
+   */
+  static constexpr size_t remaining = budget - used;
+
+  /**
+   * @brief The number of objects in the budget.
+   */
+  static constexpr size_t count = sizeof...(Objects);
+};
+
+template <size_t Budget, class... Objects>
+struct RamSize<RamBudget<Budget, Objects...>>
+    : std::integral_constant<size_t, RamBudget<Budget, Objects...>::used> {};
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_RAMBUDGET_HPP
@@ -0,0 +1,224 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_RATELIMITER_HPP
+#define FREERTOS_RATELIMITER_HPP
+
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/Deadline.hpp>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+namespace FreeRTOS {
+
+/**
+ * @class RateLimiter RateLimiter.hpp <FreeRTOS/RateLimiter.hpp>
+ *
+ * @brief Class that implements a token bucket, which limits the average rate
+ * of an operation while still allowing short bursts.
+ *
+ * The bucket holds up to burst tokens and gains tokens tokens every period
+ * ticks.  A producer takes tokens before each operation, for example one token
+ * per byte sent over a radio.  acquire() only blocks when the bucket does not
+ * hold enough tokens, and then sleeps for exactly as long as the refill takes,
+ * so a producer that is under its budget is never delayed.
+ *
+ * The refill is computed from the tick count whenever the bucket is used, so
+ * the limiter needs no timer and no task.  The bucket counts in fractions of a
+ * token, 1 / tokens of a period, so a rate that does not divide evenly into
+ * ticks does not drift.
+ *
+ * The state is updated in a critical section, so tryAcquireFromISR() can be
+ * used from interrupts.  Tasks blocked in acquire() are not served in any
+ * particular order.
+ *
+ * <b>Example Usage</b>
+ * @include RateLimiter/rateLimiter.cpp
+ */
+class RateLimiter {
+ public:
+  /**
+   * RateLimiter.hpp
+   *
+   * @brief Construct a new RateLimiter object with a full bucket.
+   *
+   * @param tokens The number of tokens added to the bucket every period.
+   * @param period The refill period in ticks.
+   * @param burst The largest number of tokens the bucket holds.
+   */
+  RateLimiter(const uint32_t tokens, const TickType_t period,
+              const uint32_t burst)
+      : tokens(tokens),
+        period(period),
+        capacity(static_cast<uint64_t>(burst) * period),
+        balance(capacity),
+        lastRefill(xTaskGetTickCount()) {
+    configASSERT((tokens > 0) && (period > 0));
+  }
+  ~RateLimiter() = default;
+
+  RateLimiter(const RateLimiter&) = delete;
+  RateLimiter& operator=(const RateLimiter&) = delete;
+
+  /**
+   * RateLimiter.hpp
+   *
+   * @brief Function that takes tokens from the bucket, blocking until enough
+   * tokens have been refilled or the timeout expires.
+   *
+   * @param count The number of tokens to take.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for the tokens.
+   * @retval true The tokens were taken.
+   * @retval false The tokens did not become available in time, or count is
+   * larger than the burst size and never can.
+   */
+  bool acquire(const uint32_t count,
+               const TickType_t ticksToWait = portMAX_DELAY) {
+    const uint64_t needed = static_cast<uint64_t>(count) * period;
+    if (needed > capacity) {
+      return false;
+    }
+
+    const Deadline deadline(ticksToWait);
+    for (;;) {
+      taskENTER_CRITICAL();
+      refill(xTaskGetTickCount());
+      const bool taken = take(needed);
+      const uint64_t missing = taken ? 0 : (needed - balance);
+      taskEXIT_CRITICAL();
+      if (taken) {
+        return true;
+      }
+
+      const TickType_t remaining = deadline.remaining();
+      if (remaining == 0) {
+        return false;
+      }
+      const uint64_t wait = (missing + tokens - 1) / tokens;
+      vTaskDelay((wait < remaining) ? static_cast<TickType_t>(wait)
+                                    : remaining);
+    }
+  }
+
+  /**
+   * RateLimiter.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool acquire(const uint32_t count,
+                      const std::chrono::duration<Rep, Period>& timeout) {
+    return acquire(count, Clock::toTicks(timeout));
+  }
+
+  /**
+   * RateLimiter.hpp
+   *
+   * @brief Function that takes tokens from the bucket only if it already holds
+   * enough of them.
+   *
+   * @param count The number of tokens to take.
+   * @retval true The tokens were taken.
+   * @retval false The bucket held fewer than count tokens.
+   */
+  bool tryAcquire(const uint32_t count = 1) {
+    const uint64_t needed = static_cast<uint64_t>(count) * period;
+    taskENTER_CRITICAL();
+    refill(xTaskGetTickCount());
+    const bool taken = take(needed);
+    taskEXIT_CRITICAL();
+    return taken;
+  }
+
+  /**
+   * RateLimiter.hpp
+   *
+   * @brief A version of tryAcquire() that can be called from an interrupt
+   * service routine.
+   *
+   * @param count The number of tokens to take.
+   * @retval true The tokens were taken.
+   * @retval false The bucket held fewer than count tokens.
+   */
+  bool tryAcquireFromISR(const uint32_t count = 1) {
+    const uint64_t needed = static_cast<uint64_t>(count) * period;
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    refill(xTaskGetTickCountFromISR());
+    const bool taken = take(needed);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return taken;
+  }
+
+  /**
+   * RateLimiter.hpp
+   *
+   * @brief Function that returns the number of whole tokens in the bucket.
+   *
+   * @return uint32_t The number of tokens that can be taken without blocking.
+   */
+  uint32_t available() {
+    taskENTER_CRITICAL();
+    refill(xTaskGetTickCount());
+    const uint64_t current = balance;
+    taskEXIT_CRITICAL();
+    return static_cast<uint32_t>(current / period);
+  }
+
+ private:
+  // Called in a critical section.  The bucket is full after any gap long
+  // enough to fill it, so a wrap of the tick count only matters if the bucket
+  // was idle for a whole wrap and then only delays the next refill.
+  inline void refill(const TickType_t now) {
+    const TickType_t elapsed = now - lastRefill;
+    lastRefill = now;
+    const uint64_t headroom = capacity - balance;
+    const uint64_t added = static_cast<uint64_t>(elapsed) * tokens;
+    balance += (added < headroom) ? added : headroom;
+  }
+
+  // Called in a critical section.
+  inline bool take(const uint64_t needed) {
+    if (balance < needed) {
+      return false;
+    }
+    balance -= needed;
+    return true;
+  }
+
+  const uint32_t tokens;
+  const TickType_t period;
+  const uint64_t capacity;
+  uint64_t balance;
+  TickType_t lastRefill;
+};
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_RATELIMITER_HPP
@@ -0,0 +1,151 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_REGION_HPP
+#define FREERTOS_REGION_HPP
+
+#include <FreeRTOS/DeferCreate.hpp>
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+namespace FreeRTOS {
+
+/**
+ * @brief Region policy that keeps the storage of a static object inside the
+ * object instance, so it is placed wherever the object is placed.
+ *
+ * This is the default Region of FreeRTOS::StaticTask, FreeRTOS::StaticQueue,
+ * FreeRTOS::StaticStreamBuffer and FreeRTOS::StaticMessageBuffer.  Any other
+ * Region is a class defined with FREERTOS_CPP_DEFINE_REGION().
+ */
+struct DefaultRegion {};
+
+/**
+ * @class RegionStorage Region.hpp <FreeRTOS/Region.hpp>
+ *
+ * @brief Class that holds the storage of a static kernel object in the memory
+ * region selected by a region policy.
+ *
+ * For a Region defined with FREERTOS_CPP_DEFINE_REGION() the storage is taken
+ * from that region when the object is constructed, and the object only holds a
+ * pointer to it.  For FreeRTOS::DefaultRegion the storage is an array member.
+ *
+ * @tparam T The type of the storage elements.
+ * @tparam Count The number of elements.
+ * @tparam Region The region policy.
+ * @tparam Alignment The alignment, in bytes, of the storage.
+ */
+template <class T, size_t Count, class Region = DefaultRegion,
+          size_t Alignment = alignof(T)>
+class RegionStorage {
+ public:
+  RegionStorage()
+      : data(static_cast<T*>(Region::allocate(sizeof(T) * Count, Alignment))) {
+    configASSERT(data != NULL);
+  }
+  explicit RegionStorage(DeferCreate) : RegionStorage() {}
+
+  /**
+   * Region.hpp
+   *
+   * @brief Function that returns the storage.
+   *
+   * @return T* Pointer to the first element.
+   */
+  inline T* get() {
+    return data;
+  }
+
+ private:
+  T* data;
+};
+
+template <class T, size_t Count, size_t Alignment>
+class RegionStorage<T, Count, DefaultRegion, Alignment> {
+ public:
+  RegionStorage() = default;
+  constexpr explicit RegionStorage(DeferCreate) : data() {}
+
+  inline T* get() {
+    return data;
+  }
+
+ private:
+  alignas(Alignment) T data[Count];
+};
+
+}  // namespace FreeRTOS
+
+/**
+ * @brief Macro that defines a region policy class that allocates storage from
+ * a named linker section, such as CCM or DTCM RAM.
+ *
+ * The region is a buffer of size bytes placed with
+ * <tt>__attribute__((section(sectionName)))</tt>.  Only that buffer is placed
+ * in the section, and it is never initialized, so the section can be marked
+ * <tt>NOLOAD</tt> in the linker script.  The allocation offset is kept in
+ * normal RAM, so objects that use the region may be constructed before or
+ * after the C runtime initializes static objects.  Storage is bump allocated
+ * and never returned, as static kernel objects are normally never destroyed.
+ * Running out of space in the region fails <tt>configASSERT()</tt>.  The size
+ * of the region is available as <tt>Name::regionSize</tt>.
+ *
+ * @code{cpp}
+ * FREERTOS_CPP_DEFINE_REGION(Dtcm, ".dtcm_bss", 16384)
+ *
+ * static MyTask<512, Dtcm> hotTask;
+ * static FreeRTOS::StaticQueue<Sample, 64, Dtcm> samples;
+ * @endcode
+ *
+ * @param Name Name of the region policy class.
+ * @param sectionName The name of the linker section, as a string literal.
+ * @param size The size, in bytes, of the region.
+ */
+#define FREERTOS_CPP_DEFINE_REGION(Name, sectionName, size)                   \
+  struct Name {                                                               \
+    static constexpr size_t regionSize = (size);                              \
+    static void* allocate(const size_t bytes, const size_t alignment) {       \
+      __attribute__((section(sectionName))) alignas(                          \
+          portBYTE_ALIGNMENT) static uint8_t storage[size];                   \
+      static size_t used;                                                     \
+      void* pointer = NULL;                                                   \
+      taskENTER_CRITICAL();                                                   \
+      const size_t start = (used + alignment - 1) & ~(alignment - 1);         \
+      if ((start <= (size)) && (bytes <= (size) - start)) {                   \
+        pointer = &storage[start];                                            \
+        used = start + bytes;                                                 \
+      }                                                                       \
+      taskEXIT_CRITICAL();                                                    \
+      return pointer;                                                         \
+    }                                                                         \
+  };
+
+#endif  // FREERTOS_REGION_HPP
@@ -28,6 +28,10 @@
 #ifndef FREERTOS_SEMAPHORE_HPP
 #define FREERTOS_SEMAPHORE_HPP
 
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/DeferCreate.hpp>
+#include <FreeRTOS/Instrumentation.hpp>
+
 #include "FreeRTOS.h"
 #include "semphr.h"
 
@@ -50,6 +54,8 @@ class SemaphoreBase {
   friend class StaticBinarySemaphore;
   friend class CountingSemaphore;
   friend class StaticCountingSemaphore;
+  friend class QueueSetBase;
+  friend class QueueSetMember;
 
   SemaphoreBase(const SemaphoreBase&) = delete;
   SemaphoreBase& operator=(const SemaphoreBase&) = delete;
@@ -123,7 +129,20 @@ class SemaphoreBase {
    * @include Semaphore/take.cpp
    */
   inline bool take(const TickType_t ticksToWait = portMAX_DELAY) const {
-    return (xSemaphoreTake(handle, ticksToWait) == pdTRUE);
+    return Instrument::call(
+        InstrumentedCall::SemaphoreTake, handle, ticksToWait, [&] {
+          return (xSemaphoreTake(handle, ticksToWait) == pdTRUE);
+        });
+  }
+
+  /**
+   * Semaphore.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool take(const std::chrono::duration<Rep, Period>& timeout) const {
+    return take(Clock::toTicks(timeout));
   }
 
   /**
@@ -157,7 +176,10 @@ class SemaphoreBase {
    */
   inline bool takeFromISR(bool& higherPriorityTaskWoken) const {
     BaseType_t taskWoken = pdFALSE;
-    const bool result = (xSemaphoreTakeFromISR(handle, &taskWoken) == pdTRUE);
+    const bool result = Instrument::callFromISR(
+        InstrumentedCall::SemaphoreTake, handle, [&] {
+          return (xSemaphoreTakeFromISR(handle, &taskWoken) == pdTRUE);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
@@ -175,7 +197,10 @@ class SemaphoreBase {
    * @overload
    */
   inline bool takeFromISR() const {
-    return (xSemaphoreTakeFromISR(handle, NULL) == pdTRUE);
+    return Instrument::callFromISR(
+        InstrumentedCall::SemaphoreTake, handle, [&] {
+          return (xSemaphoreTakeFromISR(handle, NULL) == pdTRUE);
+        });
   }
 
   /**
@@ -200,7 +225,9 @@ class SemaphoreBase {
    * @include Semaphore/give.cpp
    */
   inline bool give() const {
-    return (xSemaphoreGive(handle) == pdTRUE);
+    return Instrument::call(InstrumentedCall::SemaphoreGive, handle, 0, [&] {
+      return (xSemaphoreGive(handle) == pdTRUE);
+    });
   }
 
   /**
@@ -228,7 +255,10 @@ class SemaphoreBase {
    */
   inline bool giveFromISR(bool& higherPriorityTaskWoken) const {
     BaseType_t taskWoken = pdFALSE;
-    const bool result = (xSemaphoreGiveFromISR(handle, &taskWoken) == pdTRUE);
+    const bool result = Instrument::callFromISR(
+        InstrumentedCall::SemaphoreGive, handle, [&] {
+          return (xSemaphoreGiveFromISR(handle, &taskWoken) == pdTRUE);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
@@ -246,7 +276,88 @@ class SemaphoreBase {
    * @overload
    */
   inline bool giveFromISR() const {
-    return (xSemaphoreGiveFromISR(handle, NULL) == pdTRUE);
+    return Instrument::callFromISR(
+        InstrumentedCall::SemaphoreGive, handle, [&] {
+          return (xSemaphoreGiveFromISR(handle, NULL) == pdTRUE);
+        });
+  }
+
+  /**
+   * Semaphore.hpp
+   *
+   * @brief Function that releases a semaphore several times with one
+   * reschedule, by calling <tt>xSemaphoreGive( SemaphoreHandle_t xSemaphore
+   * )</tt> count times with the scheduler suspended.
+   *
+   * @see <https://www.freertos.org/a00123.html>
+   *
+   * Giving a counting semaphore once per waiter can switch to each woken task
+   * in turn.  giveN() suspends the scheduler, so every give is made first and
+   * the highest priority task that was woken runs once the scheduler is
+   * resumed.  The gives stop early if the semaphore reaches its maximum count,
+   * so a binary semaphore is given at most once.
+   *
+   * This must not be used from an ISR. See giveNFromISR() for an alternative
+   * which can be used from an ISR.
+   *
+   * @param count The number of times to give the semaphore.
+   * @return UBaseType_t The number of times the semaphore was given.
+   *
+   * <b>Example Usage</b>
+   * @include Semaphore/giveN.cpp
+   */
+  UBaseType_t giveN(const UBaseType_t count) const {
+    UBaseType_t given = 0;
+    vTaskSuspendAll();
+    while ((given < count) && give()) {
+      given++;
+    }
+    xTaskResumeAll();
+    return given;
+  }
+
+  /**
+   * Semaphore.hpp
+   *
+   * @brief Function that releases a semaphore several times from an interrupt
+   * service routine by calling <tt>xSemaphoreGiveFromISR( SemaphoreHandle_t
+   * xSemaphore, signed BaseType_t *pxHigherPriorityTaskWoken )</tt> count
+   * times.
+   *
+   * @see <https://www.freertos.org/a00124.html>
+   *
+   * The gives are made inside one interrupt mask, and higherPriorityTaskWoken
+   * is set once for all of them, so a single context switch is requested when
+   * the interrupt exits.
+   *
+   * @param higherPriorityTaskWoken giveNFromISR() will set
+   * higherPriorityTaskWoken to true if any give caused a task to unblock, and
+   * the unblocked task has a priority higher than the currently running task.
+   * @param count The number of times to give the semaphore.
+   * @return UBaseType_t The number of times the semaphore was given.
+   */
+  UBaseType_t giveNFromISR(bool& higherPriorityTaskWoken,
+                           const UBaseType_t count) const {
+    UBaseType_t given = 0;
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    while ((given < count) && giveFromISR(higherPriorityTaskWoken)) {
+      given++;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return given;
+  }
+
+  /**
+   * Semaphore.hpp
+   *
+   * @brief Function that releases a semaphore several times from an interrupt
+   * service routine.
+   *
+   * @overload
+   */
+  UBaseType_t giveNFromISR(const UBaseType_t count) const {
+    bool higherPriorityTaskWoken = false;
+    return giveNFromISR(higherPriorityTaskWoken, count);
   }
 
  private:
@@ -264,7 +375,9 @@ class SemaphoreBase {
    * are in the Blocked state waiting for the semaphore to become available).
    */
   ~SemaphoreBase() {
-    vSemaphoreDelete(this->handle);
+    if (this->handle != NULL) {
+      vSemaphoreDelete(this->handle);
+    }
   }
 
   SemaphoreBase(SemaphoreBase&&) noexcept = default;
@@ -478,8 +591,24 @@ class StaticBinarySemaphore : public SemaphoreBase {
    * @include Semaphore/staticBinarySemaphore.cpp
    */
   StaticBinarySemaphore() {
-    this->handle = xSemaphoreCreateBinaryStatic(&staticBinarySemaphore);
+    create();
   }
+
+  /**
+   * Semaphore.hpp
+   *
+   * @brief Construct a new StaticBinarySemaphore object without creating the
+   * semaphore.
+   *
+   * This constructor is constexpr, so a global object constructed with it is
+   * constant initialized.  create() must be called before the semaphore is
+   * used.
+   *
+   * <b>Example Usage</b>
+   * @include DeferCreate/deferCreate.cpp
+   */
+  constexpr explicit StaticBinarySemaphore(DeferCreate)
+      : staticBinarySemaphore() {}
   ~StaticBinarySemaphore() = default;
 
   StaticBinarySemaphore(const StaticBinarySemaphore&) = delete;
@@ -488,6 +617,24 @@ class StaticBinarySemaphore : public SemaphoreBase {
   StaticBinarySemaphore(StaticBinarySemaphore&&) noexcept = default;
   StaticBinarySemaphore& operator=(StaticBinarySemaphore&&) noexcept = default;
 
+  /**
+   * Semaphore.hpp
+   *
+   * @brief Function that calls <tt>SemaphoreHandle_t
+   * xSemaphoreCreateBinaryStatic( StaticSemaphore_t *pxSemaphoreBuffer )</tt>
+   * to create a semaphore that was constructed with FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/xSemaphoreCreateBinaryStatic.html>
+   *
+   * @retval true If the semaphore was created.
+   * @retval false Otherwise.
+   */
+  bool create() {
+    configASSERT(this->handle == NULL);
+    this->handle = xSemaphoreCreateBinaryStatic(&staticBinarySemaphore);
+    return (this->handle != NULL);
+  }
+
  private:
   StaticSemaphore_t staticBinarySemaphore;
 };
@@ -516,9 +663,21 @@ class StaticCountingSemaphore : public SemaphoreBase {
    */
   explicit StaticCountingSemaphore(const UBaseType_t maxCount,
                                    const UBaseType_t initialCount = 0) {
-    this->handle = xSemaphoreCreateCountingStatic(maxCount, initialCount,
-                                                  &staticCountingSemaphore);
+    create(maxCount, initialCount);
   }
+
+  /**
+   * Semaphore.hpp
+   *
+   * @brief Construct a new StaticCountingSemaphore object without creating the
+   * semaphore.
+   *
+   * This constructor is constexpr, so a global object constructed with it is
+   * constant initialized.  create() must be called before the semaphore is
+   * used.
+   */
+  constexpr explicit StaticCountingSemaphore(DeferCreate)
+      : staticCountingSemaphore() {}
   ~StaticCountingSemaphore() = default;
 
   StaticCountingSemaphore(const StaticCountingSemaphore&) = delete;
@@ -528,6 +687,29 @@ class StaticCountingSemaphore : public SemaphoreBase {
   StaticCountingSemaphore& operator=(StaticCountingSemaphore&&) noexcept =
       default;
 
+  /**
+   * Semaphore.hpp
+   *
+   * @brief Function that calls <tt>SemaphoreHandle_t
+   * xSemaphoreCreateCountingStatic( UBaseType_t uxMaxCount, UBaseType_t
+   * uxInitialCount, StaticSemaphore_t *pxSemaphoreBuffer )</tt> to create a
+   * semaphore that was constructed with FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/xSemaphoreCreateCountingStatic.html>
+   *
+   * @param maxCount The maximum count value that can be reached.
+   * @param initialCount The count value assigned to the semaphore when it is
+   * created.
+   * @retval true If the semaphore was created.
+   * @retval false Otherwise.
+   */
+  bool create(const UBaseType_t maxCount, const UBaseType_t initialCount = 0) {
+    configASSERT(this->handle == NULL);
+    this->handle = xSemaphoreCreateCountingStatic(maxCount, initialCount,
+                                                  &staticCountingSemaphore);
+    return (this->handle != NULL);
+  }
+
  private:
   StaticSemaphore_t staticCountingSemaphore;
 };
@@ -0,0 +1,271 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_SERVERQUEUE_HPP
+#define FREERTOS_SERVERQUEUE_HPP
+
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <optional>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1) &&                         \
+    (INCLUDE_vTaskPrioritySet == 1) && (INCLUDE_uxTaskPriorityGet == 1) && \
+    (configUSE_MUTEXES == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class ServerQueue ServerQueue.hpp <FreeRTOS/ServerQueue.hpp>
+ *
+ * @brief Class that queues requests for a server task and lends the server
+ * the priority of its highest priority client.
+ *
+ * A high priority client that sends a request through a FreeRTOS::Queue to a
+ * low priority server waits for as long as medium priority tasks keep the
+ * server from running, and mutex priority inheritance does not help because
+ * no mutex is held.  A ServerQueue records the priority of the sending task
+ * with every item.  While any request is queued or being processed, the server
+ * runs at the highest priority of those clients if that is above its base
+ * priority, so a client is only ever delayed by the requests ahead of it.
+ *
+ * A request is being processed from the time receive() returns it until the
+ * server calls complete() or receive() again.  The base priority of the server
+ * is read when the first donation starts and restored when the last request
+ * is complete.
+ *
+ * @warning receive() and complete() must only be called by the server task,
+ * and nothing else may change the priority of the server while it runs at a
+ * donated priority.  Requests cannot be sent from an interrupt, as an
+ * interrupt has no priority to donate.
+ *
+ * @tparam T Type of the requests.
+ * @tparam N The maximum number of requests that can be queued.
+ *
+ * <b>Example Usage</b>
+ * @include ServerQueue/serverQueue.cpp
+ */
+template <class T, UBaseType_t N>
+class ServerQueue {
+ public:
+  /**
+   * ServerQueue.hpp
+   *
+   * @brief Construct a new ServerQueue object whose requests are received by
+   * server.
+   *
+   * @warning This class contains the storage for the queue, so the user should
+   * create this object as a global object or with the static storage specifier
+   * so that the object instance is not on the stack.
+   *
+   * @param server The only task that receives from the queue.  It must outlive
+   * the queue.
+   */
+  explicit ServerQueue(const TaskBase& server) : server(server) {}
+  ~ServerQueue() = default;
+
+  ServerQueue(const ServerQueue&) = delete;
+  ServerQueue& operator=(const ServerQueue&) = delete;
+
+  /**
+   * ServerQueue.hpp
+   *
+   * @brief Function that sends item to the back of the queue together with
+   * the priority of the calling task, and raises the server to that priority
+   * if it is above the one it runs at.
+   *
+   * The server is raised before the item is sent, so a client that blocks
+   * because the queue is full is not delayed by tasks of lower priority than
+   * itself either.
+   *
+   * @warning This function cannot be called from an interrupt.
+   *
+   * @param item The request to send.
+   * @param ticksToWait The maximum amount of time to wait for space to become
+   * available in the queue.
+   * @retval true If the item was sent.
+   * @retval false If ticksToWait expired first.
+   */
+  bool sendToBack(const T& item, const TickType_t ticksToWait = 0) {
+    const UBaseType_t priority = uxTaskPriorityGet(NULL);
+
+    vTaskSuspendAll();
+    clients[priority]++;
+    donate();
+    xTaskResumeAll();
+
+    if (queue.sendToBack(Request{item, priority}, ticksToWait)) {
+      return true;
+    }
+
+    vTaskSuspendAll();
+    clients[priority]--;
+    donate();
+    xTaskResumeAll();
+    return false;
+  }
+
+  /**
+   * ServerQueue.hpp
+   *
+   * @brief Function that completes the request being processed, if any, and
+   * then receives the next request.
+   *
+   * If no request is waiting the server returns to its base priority before
+   * it blocks.  The received request keeps the server at the priority of its
+   * client until complete() or receive() is called again.
+   *
+   * @warning This function must only be called by the server task.
+   *
+   * @param ticksToWait The maximum amount of time to wait for a request.
+   * @return std::optional<T> The request, or nothing if ticksToWait expired
+   * first.
+   */
+  std::optional<T> receive(const TickType_t ticksToWait = portMAX_DELAY) {
+#if (INCLUDE_xTaskGetCurrentTaskHandle == 1)
+    configASSERT(xTaskGetCurrentTaskHandle() == server.handle);
+#endif
+    complete();
+
+    const std::optional<Request> request = queue.receive(ticksToWait);
+    if (!request) {
+      return std::nullopt;
+    }
+    activePriority = request->priority;
+    processing = true;
+    return request->item;
+  }
+
+  /**
+   * ServerQueue.hpp
+   *
+   * @brief Function that marks the request returned by receive() as processed,
+   * so that its client no longer lends the server its priority.
+   *
+   * Calling complete() when no request is being processed has no effect.
+   *
+   * @warning This function must only be called by the server task.
+   */
+  void complete() {
+    if (processing) {
+      vTaskSuspendAll();
+      processing = false;
+      clients[activePriority]--;
+      donate();
+      xTaskResumeAll();
+    }
+  }
+
+  /**
+   * ServerQueue.hpp
+   *
+   * @brief Function that returns the number of requests waiting in the queue.
+   *
+   * @return UBaseType_t The number of requests waiting.
+   */
+  inline UBaseType_t messagesWaiting() const {
+    return queue.messagesWaiting();
+  }
+
+  /**
+   * ServerQueue.hpp
+   *
+   * @brief Function that checks if the server is running at a priority lent
+   * by a client.
+   *
+   * @retval true The server runs above its base priority for a client.
+   * @retval false The server runs at its base priority.
+   */
+  inline bool isDonating() const {
+    vTaskSuspendAll();
+    const bool result = donating && (appliedPriority != basePriority);
+    xTaskResumeAll();
+    return result;
+  }
+
+ private:
+  struct Request {
+    T item;
+    UBaseType_t priority;
+  };
+
+  // Must be called with the scheduler suspended.  Sets the server to the
+  // highest priority of the queued and active requests, or back to its base
+  // priority once there are none.
+  void donate() {
+    UBaseType_t highest = configMAX_PRIORITIES;
+    for (UBaseType_t priority = configMAX_PRIORITIES; priority > 0;) {
+      priority--;
+      if (clients[priority] > 0) {
+        highest = priority;
+        break;
+      }
+    }
+
+    if (highest == configMAX_PRIORITIES) {
+      if (donating) {
+        if (appliedPriority != basePriority) {
+          server.setPriority(basePriority);
+        }
+        donating = false;
+      }
+      return;
+    }
+
+    if (!donating) {
+      basePriority = server.getBasePriority();
+      appliedPriority = basePriority;
+      donating = true;
+    }
+    const UBaseType_t target =
+        (highest > basePriority) ? highest : basePriority;
+    if (target != appliedPriority) {
+      server.setPriority(target);
+      appliedPriority = target;
+    }
+  }
+
+  const TaskBase& server;
+  StaticQueue<Request, N> queue;
+  UBaseType_t clients[configMAX_PRIORITIES] = {0};
+  UBaseType_t activePriority = 0;
+  UBaseType_t basePriority = 0;
+  UBaseType_t appliedPriority = 0;
+  bool processing = false;
+  bool donating = false;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION && INCLUDE_vTaskPrioritySet && \
+          INCLUDE_uxTaskPriorityGet && configUSE_MUTEXES */
+
+#endif  // FREERTOS_SERVERQUEUE_HPP
@@ -0,0 +1,378 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_SHAREDMUTEX_HPP
+#define FREERTOS_SHAREDMUTEX_HPP
+
+#include <FreeRTOS/Deadline.hpp>
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+
+namespace FreeRTOS {
+
+/**
+ * @class SharedMutexBase SharedMutex.hpp <FreeRTOS/SharedMutex.hpp>
+ *
+ * @brief Base class that provides the reader-writer lock interface to
+ * FreeRTOS::SharedMutex and FreeRTOS::StaticSharedMutex.
+ *
+ * Any number of tasks can hold the lock shared with lock_shared(), or one task
+ * can hold it exclusively with lock().  The writer takes a gate semaphore for
+ * the whole time it holds the lock, and readers pass through the same gate on
+ * their way in, so once a writer is waiting no new reader gets in and writers
+ * can not be starved.  The writer then waits on a second semaphore that the
+ * last reader gives on its way out.  Readers only update a counter in a
+ * critical section and give the gate straight back.
+ *
+ * When the lock is created with priority inheritance the gate is a FreeRTOS
+ * mutex.  A writer that holds, or is waiting for readers to leave, then
+ * inherits the priority of any higher priority reader or writer that is
+ * blocked at the gate.  Otherwise the gate is a binary semaphore.
+ *
+ * The function names match those of std::shared_mutex, so std::unique_lock,
+ * std::lock_guard and std::shared_lock can be used as RAII guards.
+ *
+ * @warning The lock is not recursive.  A task holding the lock shared must not
+ * call lock_shared() again, as it would deadlock with a waiting writer.
+ *
+ * @note This class is not intended to be instantiated by the user. Use
+ * FreeRTOS::SharedMutex or FreeRTOS::StaticSharedMutex.
+ */
+class SharedMutexBase {
+ public:
+  friend class SharedMutex;
+  friend class StaticSharedMutex;
+
+  SharedMutexBase(const SharedMutexBase&) = delete;
+  SharedMutexBase& operator=(const SharedMutexBase&) = delete;
+
+  static void* operator new(size_t) = delete;
+  static void* operator new[](size_t) = delete;
+
+  static void* operator new(size_t, void* ptr) {
+    return ptr;
+  }
+
+  static void* operator new[](size_t, void* ptr) {
+    return ptr;
+  }
+
+  /**
+   * SharedMutex.hpp
+   *
+   * @brief Function that checks if the underlying semaphore handles are not
+   * NULL.  This should be used to ensure the lock has been created correctly.
+   *
+   * @retval true The handles are not NULL.
+   * @retval false A handle is NULL.
+   */
+  inline bool isValid() const {
+    return ((gate != NULL) && (drained != NULL));
+  }
+
+  /**
+   * SharedMutex.hpp
+   *
+   * @brief Function that locks the mutex exclusively.  It waits for the gate,
+   * and then for every reader to unlock.
+   *
+   * @param ticksToWait The total time in ticks to wait for the lock.  A block
+   * time of zero can be used to poll the lock.
+   * @retval true If the lock is held exclusively.
+   * @retval false If ticksToWait expired first.
+   *
+   * <b>Example Usage</b>
+   * @include SharedMutex/sharedMutex.cpp
+   */
+  bool lock(const TickType_t ticksToWait = portMAX_DELAY) {
+    Deadline deadline(ticksToWait);
+    if (xSemaphoreTake(gate, deadline) != pdTRUE) {
+      return false;
+    }
+
+    taskENTER_CRITICAL();
+    const bool mustWait = (readers > 0);
+    writerWaiting = mustWait;
+    taskEXIT_CRITICAL();
+    if (!mustWait || (xSemaphoreTake(drained, deadline) == pdTRUE)) {
+      return true;
+    }
+
+    taskENTER_CRITICAL();
+    const bool timedOut = writerWaiting;
+    writerWaiting = false;
+    taskEXIT_CRITICAL();
+    if (!timedOut) {
+      // The last reader left after the timeout and is about to give drained.
+      xSemaphoreTake(drained, portMAX_DELAY);
+      return true;
+    }
+    xSemaphoreGive(gate);
+    return false;
+  }
+
+  /**
+   * SharedMutex.hpp
+   *
+   * @brief Function that unlocks the mutex after lock().
+   *
+   * @retval true If the mutex was unlocked.
+   * @retval false If the gate could not be given, because the calling task
+   * does not hold the lock exclusively.
+   */
+  inline bool unlock() {
+    return (xSemaphoreGive(gate) == pdTRUE);
+  }
+
+  /**
+   * SharedMutex.hpp
+   *
+   * @brief Function that locks the mutex shared.  It only blocks while a
+   * writer holds, or is waiting for, the lock.
+   *
+   * @param ticksToWait The time in ticks to wait for the lock.  A block time of
+   * zero can be used to poll the lock.
+   * @retval true If the lock is held shared.
+   * @retval false If ticksToWait expired first.
+   *
+   * <b>Example Usage</b>
+   * @include SharedMutex/sharedMutex.cpp
+   */
+  bool lock_shared(const TickType_t ticksToWait = portMAX_DELAY) {  // NOLINT
+    if (xSemaphoreTake(gate, ticksToWait) != pdTRUE) {
+      return false;
+    }
+    taskENTER_CRITICAL();
+    readers++;
+    taskEXIT_CRITICAL();
+    xSemaphoreGive(gate);
+    return true;
+  }
+
+  /**
+   * SharedMutex.hpp
+   *
+   * @brief Function that unlocks the mutex after lock_shared().  The last
+   * reader to unlock wakes a waiting writer.
+   */
+  void unlock_shared() {  // NOLINT
+    taskENTER_CRITICAL();
+    readers--;
+    const bool wakeWriter = ((readers == 0) && writerWaiting);
+    if (wakeWriter) {
+      writerWaiting = false;
+    }
+    taskEXIT_CRITICAL();
+    if (wakeWriter) {
+      xSemaphoreGive(drained);
+    }
+  }
+
+  /**
+   * SharedMutex.hpp
+   *
+   * @brief Function that tries to lock the mutex exclusively without
+   * blocking.  Equivalent to lock(0).
+   */
+  inline bool try_lock() {  // NOLINT
+    return lock(0);
+  }
+
+  /**
+   * SharedMutex.hpp
+   *
+   * @brief Function that tries to lock the mutex shared without blocking.
+   * Equivalent to lock_shared(0).
+   */
+  inline bool try_lock_shared() {  // NOLINT
+    return lock_shared(0);
+  }
+
+  /**
+   * SharedMutex.hpp
+   *
+   * @brief Function that returns the number of tasks that hold the lock
+   * shared.
+   *
+   * @return UBaseType_t The number of readers.
+   */
+  inline UBaseType_t getReaders() const {
+    return readers;
+  }
+
+ private:
+  SharedMutexBase() = default;
+
+  /**
+   * SharedMutex.hpp
+   *
+   * @brief Destroy the SharedMutexBase object by calling <tt>void
+   * vSemaphoreDelete( SemaphoreHandle_t xSemaphore )</tt> for both semaphores.
+   *
+   * @see <https://www.freertos.org/a00113.html#vSemaphoreDelete>
+   *
+   * @note Do not delete a lock that has tasks blocked on it.
+   */
+  ~SharedMutexBase() {
+    vSemaphoreDelete(gate);
+    vSemaphoreDelete(drained);
+  }
+
+  SharedMutexBase(SharedMutexBase&&) noexcept = default;
+  SharedMutexBase& operator=(SharedMutexBase&&) noexcept = default;
+
+  SemaphoreHandle_t gate = NULL;
+  SemaphoreHandle_t drained = NULL;
+  UBaseType_t readers = 0;
+  bool writerWaiting = false;
+};
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+
+/**
+ * @class SharedMutex SharedMutex.hpp <FreeRTOS/SharedMutex.hpp>
+ *
+ * @brief Class that encapsulates a reader-writer lock built from two FreeRTOS
+ * semaphores.
+ *
+ * The RAM required for the semaphores is allocated from the FreeRTOS heap.
+ * Use FreeRTOS::StaticSharedMutex to allocate it at compile time instead.
+ */
+class SharedMutex : public SharedMutexBase {
+ public:
+  /**
+   * SharedMutex.hpp
+   *
+   * @brief Construct a new SharedMutex object by calling <tt>SemaphoreHandle_t
+   * xSemaphoreCreateMutex( void )</tt> (or <tt>xSemaphoreCreateBinary()</tt>)
+   * for the gate and <tt>SemaphoreHandle_t xSemaphoreCreateBinary( void )</tt>
+   * for the semaphore the writer waits on.
+   *
+   * @see <https://www.freertos.org/CreateMutex.html>
+   * @see <https://www.freertos.org/xSemaphoreCreateBinary.html>
+   *
+   * @warning The user should call isValid() on this object to verify that the
+   * semaphores were created successfully.
+   *
+   * @param priorityInheritance If true the gate is a mutex, so a writer
+   * inherits the priority of the tasks it blocks.
+   *
+   * <b>Example Usage</b>
+   * @include SharedMutex/sharedMutex.cpp
+   */
+  explicit SharedMutex(const bool priorityInheritance = true) {
+#if (configUSE_MUTEXES == 1)
+    if (priorityInheritance) {
+      this->gate = xSemaphoreCreateMutex();
+    } else {
+      this->gate = xSemaphoreCreateBinary();
+      xSemaphoreGive(this->gate);
+    }
+#else
+    static_cast<void>(priorityInheritance);
+    this->gate = xSemaphoreCreateBinary();
+    xSemaphoreGive(this->gate);
+#endif /* configUSE_MUTEXES */
+    this->drained = xSemaphoreCreateBinary();
+  }
+  ~SharedMutex() = default;
+
+  SharedMutex(const SharedMutex&) = delete;
+  SharedMutex& operator=(const SharedMutex&) = delete;
+
+  SharedMutex(SharedMutex&&) noexcept = default;
+  SharedMutex& operator=(SharedMutex&&) noexcept = default;
+};
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+/**
+ * @class StaticSharedMutex SharedMutex.hpp <FreeRTOS/SharedMutex.hpp>
+ *
+ * @brief Class that encapsulates a reader-writer lock built from two FreeRTOS
+ * semaphores, with the RAM for the semaphores allocated at compile time.
+ */
+class StaticSharedMutex : public SharedMutexBase {
+ public:
+  /**
+   * SharedMutex.hpp
+   *
+   * @brief Construct a new StaticSharedMutex object by calling
+   * <tt>SemaphoreHandle_t xSemaphoreCreateMutexStatic( StaticSemaphore_t
+   * *pxMutexBuffer )</tt> (or <tt>xSemaphoreCreateBinaryStatic()</tt>) for the
+   * gate and <tt>SemaphoreHandle_t xSemaphoreCreateBinaryStatic(
+   * StaticSemaphore_t *pxSemaphoreBuffer )</tt> for the semaphore the writer
+   * waits on.
+   *
+   * @see <https://www.freertos.org/xSemaphoreCreateMutexStatic.html>
+   * @see <https://www.freertos.org/xSemaphoreCreateBinaryStatic.html>
+   *
+   * @warning This class contains the storage buffers for the semaphores, so
+   * the user should create this object as a global object or with the static
+   * storage specifier so that the object instance is not on the stack.
+   *
+   * @param priorityInheritance If true the gate is a mutex, so a writer
+   * inherits the priority of the tasks it blocks.
+   */
+  explicit StaticSharedMutex(const bool priorityInheritance = true) {
+#if (configUSE_MUTEXES == 1)
+    if (priorityInheritance) {
+      this->gate = xSemaphoreCreateMutexStatic(&staticGate);
+    } else {
+      this->gate = xSemaphoreCreateBinaryStatic(&staticGate);
+      xSemaphoreGive(this->gate);
+    }
+#else
+    static_cast<void>(priorityInheritance);
+    this->gate = xSemaphoreCreateBinaryStatic(&staticGate);
+    xSemaphoreGive(this->gate);
+#endif /* configUSE_MUTEXES */
+    this->drained = xSemaphoreCreateBinaryStatic(&staticDrained);
+  }
+  ~StaticSharedMutex() = default;
+
+  StaticSharedMutex(const StaticSharedMutex&) = delete;
+  StaticSharedMutex& operator=(const StaticSharedMutex&) = delete;
+
+  StaticSharedMutex(StaticSharedMutex&&) noexcept = default;
+  StaticSharedMutex& operator=(StaticSharedMutex&&) noexcept = default;
+
+ private:
+  StaticSemaphore_t staticGate;
+  StaticSemaphore_t staticDrained;
+};
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_SHAREDMUTEX_HPP
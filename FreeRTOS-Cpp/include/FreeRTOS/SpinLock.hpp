@@ -0,0 +1,256 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_SPINLOCK_HPP
+#define FREERTOS_SPINLOCK_HPP
+
+#include <atomic>
+#include <type_traits>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+namespace FreeRTOS {
+
+/**
+ * @class SpinLock SpinLock.hpp <FreeRTOS/SpinLock.hpp>
+ *
+ * @brief Class that protects a few words of state shared between cores, and
+ * between tasks and interrupts, without entering a kernel critical section.
+ *
+ * <tt>taskENTER_CRITICAL()</tt> on an SMP port masks interrupts and also takes
+ * the kernel's own task and ISR locks, so every core that enters any critical
+ * section is serialised.  A SpinLock only masks interrupts on the calling core
+ * and spins on its own lock word, so unrelated critical sections on other
+ * cores carry on.
+ *
+ * lock() and unlock() are for tasks, lockFromISR() and unlockFromISR() are for
+ * interrupts, and both pairs exclude each other.  Interrupts on the calling
+ * core stay masked while the lock is held, so the owner can not be preempted
+ * or interrupted by code that would spin on the same lock.  Task::Guard and
+ * IsrGuard lock for the lifetime of a scope, and the names of lock() and
+ * unlock() also work with std::lock_guard.
+ *
+ * When Fair is true the lock is a ticket lock: cores acquire it in the order in
+ * which they started waiting.
+ *
+ * When configNUMBER_OF_CORES is 1 there is no other core to exclude, so the
+ * lock only masks interrupts.
+ *
+ * @warning Hold the lock for a few instructions only and never call a FreeRTOS
+ * API function while holding it.  The lock saves and restores the interrupt
+ * mask, so it nests inside kernel critical sections and other locks as long as
+ * they are released in the reverse order.  The lock is not recursive.  On SMP
+ * ports the target must support atomic read modify write operations, which
+ * ARMv6-M does not.
+ *
+ * @tparam Fair If true the lock is granted in first come first served order.
+ *
+ * <b>Example Usage</b>
+ * @include SpinLock/spinLock.cpp
+ */
+template <bool Fair = false>
+class SpinLock {
+ public:
+  /**
+   * @class IsrGuard SpinLock.hpp <FreeRTOS/SpinLock.hpp>
+   *
+   * @brief Class that calls lockFromISR() when it is constructed and
+   * unlockFromISR() when it goes out of scope.
+   */
+  class IsrGuard {
+   public:
+    explicit IsrGuard(SpinLock& spinLock) : spinLock(spinLock) {
+      spinLock.lockFromISR();
+    }
+    ~IsrGuard() {
+      spinLock.unlockFromISR();
+    }
+
+    IsrGuard(const IsrGuard&) = delete;
+    IsrGuard& operator=(const IsrGuard&) = delete;
+
+   private:
+    SpinLock& spinLock;
+  };
+
+  /**
+   * @class Guard SpinLock.hpp <FreeRTOS/SpinLock.hpp>
+   *
+   * @brief Class that calls lock() when it is constructed and unlock() when it
+   * goes out of scope.
+   */
+  class Guard {
+   public:
+    explicit Guard(SpinLock& spinLock) : spinLock(spinLock) {
+      spinLock.lock();
+    }
+    ~Guard() {
+      spinLock.unlock();
+    }
+
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+   private:
+    SpinLock& spinLock;
+  };
+
+  SpinLock() = default;
+  ~SpinLock() = default;
+
+  SpinLock(const SpinLock&) = delete;
+  SpinLock& operator=(const SpinLock&) = delete;
+
+  /**
+   * SpinLock.hpp
+   *
+   * @brief Function that masks interrupts on the calling core and then spins
+   * until the lock is acquired.  The previous interrupt mask is saved in the
+   * lock and restored by unlock(), so the lock can be taken inside a kernel
+   * critical section or while another lock is held.
+   *
+   * @warning This function must only be called from a task.
+   */
+  inline void lock() {
+    lockFromISR();
+  }
+
+  /**
+   * SpinLock.hpp
+   *
+   * @brief Function that releases the lock and restores the interrupt mask
+   * that was in effect when lock() was called.
+   *
+   * @warning This function must only be called from a task.
+   */
+  inline void unlock() {
+    unlockFromISR();
+  }
+
+  /**
+   * SpinLock.hpp
+   *
+   * @brief A version of lock() that can be called from an interrupt service
+   * routine.  The previous interrupt mask is saved in the lock and restored by
+   * unlockFromISR().
+   */
+  inline void lockFromISR() {
+    const UBaseType_t status = portSET_INTERRUPT_MASK_FROM_ISR();
+    acquire();
+    savedStatus = status;
+  }
+
+  /**
+   * SpinLock.hpp
+   *
+   * @brief A version of unlock() that can be called from an interrupt service
+   * routine.
+   */
+  inline void unlockFromISR() {
+    const UBaseType_t status = savedStatus;
+    release();
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(status);
+  }
+
+  /**
+   * SpinLock.hpp
+   *
+   * @brief Function that checks if any core holds the lock.  The result is
+   * only a snapshot.
+   *
+   * @retval true The lock is held.
+   * @retval false The lock is free.
+   */
+  inline bool isLocked() const {
+#if (configNUMBER_OF_CORES > 1)
+    if constexpr (Fair) {
+      return (words.next.load(std::memory_order_relaxed) !=
+              words.serving.load(std::memory_order_relaxed));
+    } else {
+      return words.locked.load(std::memory_order_relaxed);
+    }
+#else
+    return false;
+#endif /* configNUMBER_OF_CORES */
+  }
+
+ private:
+  inline void acquire() {
+#if (configNUMBER_OF_CORES > 1)
+    if constexpr (Fair) {
+      const uint32_t ticket =
+          words.next.fetch_add(1, std::memory_order_relaxed);
+      while (words.serving.load(std::memory_order_acquire) != ticket) {
+      }
+    } else {
+      // Spin on a plain load so that waiting cores do not keep claiming the
+      // cache line.
+      while (words.locked.exchange(true, std::memory_order_acquire)) {
+        while (words.locked.load(std::memory_order_relaxed)) {
+        }
+      }
+    }
+#endif /* configNUMBER_OF_CORES */
+  }
+
+  inline void release() {
+#if (configNUMBER_OF_CORES > 1)
+    if constexpr (Fair) {
+      words.serving.store(words.serving.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_release);
+    } else {
+      words.locked.store(false, std::memory_order_release);
+    }
+#endif /* configNUMBER_OF_CORES */
+  }
+
+#if (configNUMBER_OF_CORES > 1)
+  struct TicketWords {
+    std::atomic<uint32_t> next{0};
+    std::atomic<uint32_t> serving{0};
+  };
+
+  struct FlagWord {
+    std::atomic<bool> locked{false};
+  };
+
+  // Only the words of the selected variant are stored.
+  std::conditional_t<Fair, TicketWords, FlagWord> words;
+#endif /* configNUMBER_OF_CORES */
+  UBaseType_t savedStatus = 0;
+};
+
+/**
+ * @brief A FreeRTOS::SpinLock that is granted in first come first served order.
+ */
+using TicketSpinLock = SpinLock<true>;
+
+}  // namespace FreeRTOS
+
+#endif  // FREERTOS_SPINLOCK_HPP
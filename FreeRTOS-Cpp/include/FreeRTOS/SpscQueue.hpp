@@ -0,0 +1,431 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_SPSCQUEUE_HPP
+#define FREERTOS_SPSCQUEUE_HPP
+
+#include <atomic>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class StaticSpscQueue SpscQueue.hpp <FreeRTOS/SpscQueue.hpp>
+ *
+ * @brief Class that implements a lock-free single producer, single consumer
+ * queue with the same calling conventions as FreeRTOS::QueueBase.
+ *
+ * Items are stored in a ring buffer that is contained in the object instance.
+ * Sending and receiving an item only touches the ring buffer indices, so
+ * neither side enters a kernel critical section.  A task notification is only
+ * sent when the other side is actually blocked waiting for data or space,
+ * which keeps the producer path short when it is called from an interrupt
+ * service routine.
+ *
+ * @warning Exactly one task or interrupt may send to the queue, and exactly one
+ * task or interrupt may receive from it.  Use FreeRTOS::Queue or
+ * FreeRTOS::StaticQueue if there are multiple producers or consumers.
+ *
+ * @warning The notification at index Index of the producer and consumer tasks
+ * is used to unblock them, so it must not be used for any other purpose by
+ * those tasks.
+ *
+ * @tparam T Type to be stored in the queue.
+ * @tparam N The maximum number of items the queue can hold at any one time.
+ * @tparam Index The index within the tasks' array of notification values that
+ * is used to unblock a waiting producer or consumer.
+ */
+template <class T, UBaseType_t N, UBaseType_t Index = 0>
+class StaticSpscQueue {
+  static_assert(N > 0, "StaticSpscQueue must hold at least one item.");
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+
+ public:
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Construct a new StaticSpscQueue object.
+   *
+   * @warning This class contains the storage buffer for the queue, so the user
+   * should create this object as a global object or with the static storage
+   * specifier so that the object instance is not on the stack.
+   *
+   * <b>Example Usage</b>
+   * @include SpscQueue/staticSpscQueue.cpp
+   */
+  StaticSpscQueue() = default;
+
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Destroy the StaticSpscQueue object and any items still in the queue.
+   */
+  ~StaticSpscQueue() {
+    Index_t position = head.load(std::memory_order_relaxed);
+    const Index_t end = tail.load(std::memory_order_relaxed);
+    while (position != end) {
+      slot(position).~T();
+      position = next(position);
+    }
+  }
+
+  StaticSpscQueue(const StaticSpscQueue&) = delete;
+  StaticSpscQueue& operator=(const StaticSpscQueue&) = delete;
+  StaticSpscQueue(StaticSpscQueue&&) = delete;
+  StaticSpscQueue& operator=(StaticSpscQueue&&) = delete;
+
+  static void* operator new(size_t) = delete;
+  static void* operator new[](size_t) = delete;
+
+  static void* operator new(size_t, void* ptr) {
+    return ptr;
+  }
+
+  static void* operator new[](size_t, void* ptr) {
+    return ptr;
+  }
+
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Post an item to the back of the queue.  The item is queued by copy,
+   * not by reference.  This function must not be called from an interrupt
+   * service routine.  See sendToBackFromISR() for an alternative which may be
+   * used in an ISR.
+   *
+   * @param item A reference to the item that is to be placed on the queue.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for space to become available on the queue, should it already be full.  The
+   * call will return immediately if this is set to 0 and the queue is full.
+   * @retval true if the item was successfully posted.
+   * @retval false otherwise.
+   */
+  bool sendToBack(const T& item, const TickType_t ticksToWait = portMAX_DELAY) {
+    if (!waitFor(producer, ticksToWait, [this] { return !isFull(); })) {
+      return false;
+    }
+    push(item);
+    wake(consumer);
+    return true;
+  }
+
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Post an item to the back of the queue from an interrupt service
+   * routine.  The item is queued by copy, not by reference.
+   *
+   * The consumer is only notified if it is blocked waiting for an item, so in
+   * the common case this function does not enter a critical section at all.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * sending to the queue caused a task to unblock, and the unblocked task has a
+   * priority higher than the currently running task.
+   * @param item A reference to the item that is to be placed on the queue.
+   * @retval true if the item was successfully posted.
+   * @retval false if the queue was full.
+   */
+  bool sendToBackFromISR(bool& higherPriorityTaskWoken, const T& item) {
+    if (isFull()) {
+      return false;
+    }
+    push(item);
+    wakeFromISR(higherPriorityTaskWoken, consumer);
+    return true;
+  }
+
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Post an item to the back of the queue from an interrupt service
+   * routine.
+   *
+   * @overload
+   */
+  bool sendToBackFromISR(const T& item) {
+    bool higherPriorityTaskWoken = false;
+    return sendToBackFromISR(higherPriorityTaskWoken, item);
+  }
+
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Receive an item from the queue into storage owned by the caller.
+   * This function must not be used in an interrupt service routine. See
+   * receiveFromISR() for an alternative that can.
+   *
+   * @param item A reference to the object that the received item will be moved
+   * into.  item is left unmodified if no item was received.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for an item to receive should the queue be empty at the time of the call.
+   * Setting ticksToWait to 0 will cause the function to return immediately if
+   * the queue is empty.
+   * @retval true if an item was successfully received from the queue.
+   * @retval false otherwise.
+   */
+  bool receive(T& item, const TickType_t ticksToWait = portMAX_DELAY) {
+    if (!waitFor(consumer, ticksToWait, [this] { return !isEmpty(); })) {
+      return false;
+    }
+    pop(item);
+    wake(producer);
+    return true;
+  }
+
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Receive an item from the queue.  This function must not be used in
+   * an interrupt service routine. See receiveFromISR() for an alternative that
+   * can.
+   *
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for an item to receive should the queue be empty at the time of the call.
+   * Setting ticksToWait to 0 will cause the function to return immediately if
+   * the queue is empty.
+   * @return std::optional<T> Object from the queue. User should check that the
+   * value is present.
+   */
+  std::optional<T> receive(const TickType_t ticksToWait = portMAX_DELAY) {
+    if (!waitFor(consumer, ticksToWait, [this] { return !isEmpty(); })) {
+      return std::nullopt;
+    }
+    std::optional<T> item(std::move(slot(head.load())));
+    release();
+    wake(producer);
+    return item;
+  }
+
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Receive an item from the queue from an interrupt service routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * receiving from the queue caused a task to unblock, and the unblocked task
+   * has a priority higher than the currently running task.
+   * @param item A reference to the object that the received item will be moved
+   * into.  item is left unmodified if no item was received.
+   * @retval true if an item was successfully received from the queue.
+   * @retval false if the queue was empty.
+   */
+  bool receiveFromISR(bool& higherPriorityTaskWoken, T& item) {
+    if (isEmpty()) {
+      return false;
+    }
+    pop(item);
+    wakeFromISR(higherPriorityTaskWoken, producer);
+    return true;
+  }
+
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Receive an item from the queue from an interrupt service routine.
+   *
+   * @overload
+   */
+  bool receiveFromISR(T& item) {
+    bool higherPriorityTaskWoken = false;
+    return receiveFromISR(higherPriorityTaskWoken, item);
+  }
+
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Return the number of messages stored in the queue.  This function
+   * can be called from a task or an interrupt service routine.
+   *
+   * @retval UBaseType_t The number of messages available in the queue.
+   */
+  UBaseType_t messagesWaiting() const {
+    const Index_t first = head.load();
+    const Index_t last = tail.load();
+    return static_cast<UBaseType_t>((last >= first) ? (last - first)
+                                                    : (last + Slots - first));
+  }
+
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Return the number of free spaces in the queue.  This function can
+   * be called from a task or an interrupt service routine.
+   *
+   * @retval UBaseType_t The number of free spaces available in the queue.
+   */
+  UBaseType_t spacesAvailable() const {
+    return N - messagesWaiting();
+  }
+
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Queries the queue to determine if the queue is empty.
+   *
+   * @retval true if the queue is empty.
+   * @retval false if the queue is not empty.
+   */
+  bool isEmpty() const {
+    return (head.load() == tail.load());
+  }
+
+  /**
+   * SpscQueue.hpp
+   *
+   * @brief Queries the queue to determine if the queue is full.
+   *
+   * @retval true if the queue is full.
+   * @retval false if the queue is not full.
+   */
+  bool isFull() const {
+    return (next(tail.load()) == head.load());
+  }
+
+ private:
+  using Index_t = UBaseType_t;
+
+  /**
+   * @brief One slot is always left empty so that a full queue can be told apart
+   * from an empty queue without a shared counter.
+   */
+  static constexpr Index_t Slots = N + 1;
+
+  static constexpr Index_t next(const Index_t position) {
+    return ((position + 1) == Slots) ? 0 : (position + 1);
+  }
+
+  T& slot(const Index_t position) {
+    return *std::launder(reinterpret_cast<T*>(storage[position]));  // NOLINT
+  }
+
+  void push(const T& item) {
+    const Index_t position = tail.load(std::memory_order_relaxed);
+    ::new (storage[position]) T(item);
+    tail.store(next(position));
+  }
+
+  void pop(T& item) {
+    item = std::move(slot(head.load(std::memory_order_relaxed)));
+    release();
+  }
+
+  void release() {
+    const Index_t position = head.load(std::memory_order_relaxed);
+    slot(position).~T();
+    head.store(next(position));
+  }
+
+  /**
+   * @brief Block the calling task until ready() returns true or ticksToWait
+   * expires.  The calling task is published in waiter before ready() is checked
+   * for the final time, so the other side of the queue can not publish an item
+   * (or space) without also seeing that it needs to send a notification.
+   */
+  template <class Predicate>
+  static bool waitFor(std::atomic<TaskHandle_t>& waiter,
+                      TickType_t ticksToWait, Predicate ready) {
+    if (ready()) {
+      return true;
+    }
+    if (ticksToWait == 0) {
+      return false;
+    }
+
+    TimeOut_t timeOut;
+    vTaskSetTimeOutState(&timeOut);
+    for (;;) {
+      waiter.store(xTaskGetCurrentTaskHandle());
+      if (!ready()) {
+        ulTaskNotifyTakeIndexed(Index, pdTRUE, ticksToWait);
+      }
+      waiter.store(NULL);
+      if (ready()) {
+        return true;
+      }
+      if (xTaskCheckForTimeOut(&timeOut, &ticksToWait) == pdTRUE) {
+        return false;
+      }
+    }
+  }
+
+  static void wake(const std::atomic<TaskHandle_t>& waiter) {
+    const TaskHandle_t task = waiter.load();
+    if (task != NULL) {
+      xTaskNotifyGiveIndexed(task, Index);
+    }
+  }
+
+  static void wakeFromISR(bool& higherPriorityTaskWoken,
+                          const std::atomic<TaskHandle_t>& waiter) {
+    const TaskHandle_t task = waiter.load();
+    if (task != NULL) {
+      BaseType_t taskWoken = pdFALSE;
+      vTaskNotifyGiveIndexedFromISR(task, Index, &taskWoken);
+      if (taskWoken == pdTRUE) {
+        higherPriorityTaskWoken = true;
+      }
+    }
+  }
+
+  /**
+   * @brief Index of the next item to be received.  Only written by the
+   * consumer.
+   */
+  std::atomic<Index_t> head{0};
+
+  /**
+   * @brief Index of the next free slot.  Only written by the producer.
+   */
+  std::atomic<Index_t> tail{0};
+
+  /**
+   * @brief Task blocked waiting for an item, or NULL.
+   */
+  std::atomic<TaskHandle_t> consumer{NULL};
+
+  /**
+   * @brief Task blocked waiting for space, or NULL.
+   */
+  std::atomic<TaskHandle_t> producer{NULL};
+
+  alignas(T) uint8_t storage[Slots][sizeof(T)];
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+#endif  // FREERTOS_SPSCQUEUE_HPP
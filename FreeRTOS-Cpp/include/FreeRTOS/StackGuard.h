@@ -0,0 +1,81 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_STACKGUARD_H
+#define FREERTOS_STACKGUARD_H
+
+/*
+ * C header that routes traceTASK_SWITCHED_IN() to FreeRTOS::StackGuard so that
+ * an MPU guard region follows the stack of the running task.  The kernel is
+ * compiled as C, so this header must be valid C.  Include it at the end of
+ * FreeRTOSConfig.h, and expand FREERTOS_CPP_DEFINE_STACK_GUARD() from
+ * <FreeRTOS/StackGuard.hpp> in one C++ source file of the application.
+ *
+ * Ports that set portHAS_STACK_OVERFLOW_CHECKING, such as the ARMv8-M
+ * mainline ports, already load PSPLIM with the stack of every task and do not
+ * need this header.
+ *
+ * If traceTASK_SWITCHED_IN() is already defined it is left alone, and it must
+ * call freertosCppStackGuardSwitchedIn(pxCurrentTCB->pxStack) itself.  This
+ * header takes the hook, so include it before <FreeRTOS/TraceHooks.h>.
+ */
+
+#include <stdint.h>
+
+/* The size, in bytes, of the guard region at the bottom of every stack. */
+#ifndef FREERTOS_CPP_STACK_GUARD_SIZE
+#if defined(__ARM_ARCH_6M__)
+#define FREERTOS_CPP_STACK_GUARD_SIZE 256
+#else
+#define FREERTOS_CPP_STACK_GUARD_SIZE 32
+#endif
+#endif /* FREERTOS_CPP_STACK_GUARD_SIZE */
+
+/* Align the stacks of static tasks to the guard, so that the guard covers the
+ * lowest bytes of each stack instead of starting up to a guard size above. */
+#ifndef FREERTOS_CPP_STACK_ALIGNMENT
+#define FREERTOS_CPP_STACK_ALIGNMENT FREERTOS_CPP_STACK_GUARD_SIZE
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void freertosCppStackGuardSwitchedIn(const void* stackBase);
+
+#ifdef __cplusplus
+}
+#endif
+
+/* pxCurrentTCB is in scope where tasks.c expands this hook. */
+#ifndef traceTASK_SWITCHED_IN
+#define traceTASK_SWITCHED_IN() \
+  freertosCppStackGuardSwitchedIn(pxCurrentTCB->pxStack)
+#endif
+
+#endif  // FREERTOS_STACKGUARD_H
@@ -0,0 +1,285 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_STACKGUARD_HPP
+#define FREERTOS_STACKGUARD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief The size, in bytes, of the guard region at the bottom of every task
+ * stack.  It must be a power of two of at least 32, or 256 on ARMv6-M.
+ */
+#ifndef FREERTOS_CPP_STACK_GUARD_SIZE
+#if defined(__ARM_ARCH_6M__)
+#define FREERTOS_CPP_STACK_GUARD_SIZE 256
+#else
+#define FREERTOS_CPP_STACK_GUARD_SIZE 32
+#endif
+#endif /* FREERTOS_CPP_STACK_GUARD_SIZE */
+
+/**
+ * @brief The MPU region used for the guard.  No other code may use it.  On
+ * ARMv7-M and ARMv6-M the highest numbered region has priority over the
+ * others, so the default is region 7.
+ */
+#ifndef FREERTOS_CPP_STACK_GUARD_REGION
+#define FREERTOS_CPP_STACK_GUARD_REGION 7
+#endif
+
+#if defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_7M__) || \
+    defined(__ARM_ARCH_7EM__)
+#define FREERTOS_CPP_STACK_GUARD_PMSAV7
+#elif defined(__ARM_ARCH_8M_BASE__) || defined(__ARM_ARCH_8M_MAIN__) || \
+    defined(__ARM_ARCH_8_1M_MAIN__)
+#define FREERTOS_CPP_STACK_GUARD_PMSAV8
+#endif
+
+namespace FreeRTOS {
+
+/**
+ * @class StackGuard StackGuard.hpp <FreeRTOS/StackGuard.hpp>
+ *
+ * @brief Class that detects stack overflow in hardware, so that
+ * configCHECK_FOR_STACK_OVERFLOW can stay 0.
+ *
+ * ARMv8-M mainline cores, such as the Cortex-M33, have a process stack limit
+ * register.  Their FreeRTOS ports set portHAS_STACK_OVERFLOW_CHECKING and load
+ * PSPLIM with the bottom of the stack of each task as part of the context
+ * switch.  For a FreeRTOS::StaticTask that is the stack array in the object,
+ * so the limit needs no configuration, and a push below it faults before any
+ * memory is written.  setMainStackLimit() does the same for the interrupt
+ * stack.
+ *
+ * Other cores with an MPU use a guard region instead.  init() enables the MPU
+ * with the default memory map as background, and switchedIn() moves a
+ * FREERTOS_CPP_STACK_GUARD_SIZE byte region to the bottom of the stack of the
+ * task being switched in.  The region can not be written (on ARMv7-M and
+ * ARMv6-M it can not be accessed at all), so an overflow raises a MemManage
+ * fault on its first write.  <FreeRTOS/StackGuard.h> calls switchedIn() from
+ * traceTASK_SWITCHED_IN(), which costs two or three register writes per
+ * context switch instead of the pattern check of method 2.  The guard takes
+ * the lowest FREERTOS_CPP_STACK_GUARD_SIZE bytes of each stack, and including
+ * <FreeRTOS/StackGuard.h> aligns the stacks of static tasks so that nothing
+ * else is lost.
+ *
+ * Tasks must run privileged, as they do on the non-MPU ports.  On ARMv8-M the
+ * region uses memory attribute index 0 of MPU_MAIR0.  ARMv6-M and ARMv8-M
+ * baseline cores have no MemManage fault, so an overflow raises a HardFault,
+ * and ARMv6-M needs a guard of at least 256 bytes.
+ *
+ * <b>Example Usage</b>
+ * @include StackGuard/stackGuard.cpp
+ */
+class StackGuard {
+  static_assert((FREERTOS_CPP_STACK_GUARD_SIZE >= 32) &&
+                    ((FREERTOS_CPP_STACK_GUARD_SIZE &
+                      (FREERTOS_CPP_STACK_GUARD_SIZE - 1)) == 0),
+                "FREERTOS_CPP_STACK_GUARD_SIZE must be a power of two of at "
+                "least 32.");
+#if defined(__ARM_ARCH_6M__)
+  static_assert(FREERTOS_CPP_STACK_GUARD_SIZE >= 256,
+                "The ARMv6-M MPU has no regions smaller than 256 bytes.");
+#endif
+
+ public:
+  StackGuard() = delete;
+
+  /**
+   * @brief The size, in bytes, of the guard region.
+   */
+  static constexpr uintptr_t guardSize = FREERTOS_CPP_STACK_GUARD_SIZE;
+
+  /**
+   * StackGuard.hpp
+   *
+   * @brief Function that returns whether the port checks the process stack
+   * limit in hardware, in which case init() and <FreeRTOS/StackGuard.h> are
+   * not needed.
+   *
+   * @return true If portHAS_STACK_OVERFLOW_CHECKING is 1.
+   * @return false Otherwise.
+   */
+  static constexpr bool hasStackLimit() {
+#if defined(portHAS_STACK_OVERFLOW_CHECKING) && \
+    (portHAS_STACK_OVERFLOW_CHECKING == 1)
+    return true;
+#else
+    return false;
+#endif /* portHAS_STACK_OVERFLOW_CHECKING */
+  }
+
+  /**
+   * StackGuard.hpp
+   *
+   * @brief Function that enables the MPU and the MemManage fault.  Call it
+   * once before the scheduler is started.
+   *
+   * @return true If the MPU is present and was enabled.
+   * @return false If the core has no MPU, in which case switchedIn() does
+   * nothing.
+   */
+  static bool init() {
+#if defined(FREERTOS_CPP_STACK_GUARD_PMSAV7) || \
+    defined(FREERTOS_CPP_STACK_GUARD_PMSAV8)
+    if (((reg(mpuType) >> 8) & 0xFF) <= FREERTOS_CPP_STACK_GUARD_REGION) {
+      return false;
+    }
+    reg(mpuControl) = 0;
+    reg(mpuRegionNumber) = FREERTOS_CPP_STACK_GUARD_REGION;
+    reg(mpuRegionLimit) = 0;
+    reg(mpuControl) = mpuPrivilegedDefault | mpuEnable;
+#if !defined(__ARM_ARCH_6M__) && !defined(__ARM_ARCH_8M_BASE__)
+    reg(systemHandlerControl) |= memManageEnable;
+#endif
+    synchronize();
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * StackGuard.hpp
+   *
+   * @brief Function that moves the guard region to the bottom of a stack.  It
+   * is called by the hook in <FreeRTOS/StackGuard.h> for every task that is
+   * switched in.
+   *
+   * @param stackBase The lowest address of the stack.  The guard starts at
+   * the first multiple of FREERTOS_CPP_STACK_GUARD_SIZE at or above it.
+   */
+  static inline void switchedIn(const void* stackBase) {
+#if defined(FREERTOS_CPP_STACK_GUARD_PMSAV7)
+    // Writing the region number with the base address selects the region, and
+    // the size and permissions stay the same for every task.
+    reg(mpuRegionBase) = guardBase(stackBase) | rbarValid |
+                         FREERTOS_CPP_STACK_GUARD_REGION;
+    reg(mpuRegionLimit) = rasrNoAccess();
+#elif defined(FREERTOS_CPP_STACK_GUARD_PMSAV8)
+    // The region is disabled while it moves so that it never covers memory
+    // between the old and the new guard.
+    const uintptr_t base = guardBase(stackBase);
+    reg(mpuRegionLimit) = 0;
+    reg(mpuRegionBase) = base | rbarReadOnly | rbarExecuteNever;
+    reg(mpuRegionLimit) = (base + guardSize - 32) | rlarEnable;
+#else
+    static_cast<void>(stackBase);
+#endif
+  }
+
+  /**
+   * StackGuard.hpp
+   *
+   * @brief Function that returns the lowest address that a task may use when
+   * its stack starts at stackBase.
+   *
+   * @param stackBase The lowest address of the stack.
+   * @return uintptr_t The first address above the guard.
+   */
+  static inline uintptr_t usableBase(const void* stackBase) {
+    return guardBase(stackBase) + guardSize;
+  }
+
+#if defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+  /**
+   * StackGuard.hpp
+   *
+   * @brief Function that sets MSPLIM, the stack limit of the main stack used
+   * by interrupts and by main() before the scheduler starts.
+   *
+   * @param limit The lowest address of the main stack, usually a symbol
+   * defined by the linker script.
+   */
+  static inline void setMainStackLimit(const void* limit) {
+    __asm volatile("msr msplim, %0" ::"r"(limit) : "memory");
+  }
+#endif /* __ARM_ARCH_8M_MAIN__ || __ARM_ARCH_8_1M_MAIN__ */
+
+ private:
+  inline static uintptr_t guardBase(const void* stackBase) {
+    return (reinterpret_cast<uintptr_t>(stackBase) + guardSize - 1) &
+           ~(guardSize - 1);
+  }
+
+#if defined(FREERTOS_CPP_STACK_GUARD_PMSAV7) || \
+    defined(FREERTOS_CPP_STACK_GUARD_PMSAV8)
+  static constexpr uintptr_t systemHandlerControl = 0xE000ED24UL;
+  static constexpr uintptr_t mpuType = 0xE000ED90UL;
+  static constexpr uintptr_t mpuControl = 0xE000ED94UL;
+  static constexpr uintptr_t mpuRegionNumber = 0xE000ED98UL;
+  static constexpr uintptr_t mpuRegionBase = 0xE000ED9CUL;
+  // RASR on ARMv7-M and ARMv6-M, RLAR on ARMv8-M.
+  static constexpr uintptr_t mpuRegionLimit = 0xE000EDA0UL;
+
+  static constexpr uint32_t memManageEnable = (1UL << 16);
+  static constexpr uint32_t mpuEnable = (1UL << 0);
+  static constexpr uint32_t mpuPrivilegedDefault = (1UL << 2);
+
+  static inline volatile uint32_t& reg(const uintptr_t address) {
+    return *reinterpret_cast<volatile uint32_t*>(address);  // NOLINT
+  }
+
+  static inline void synchronize() {
+    __asm volatile("dsb\n\tisb" ::: "memory");
+  }
+#endif
+
+#if defined(FREERTOS_CPP_STACK_GUARD_PMSAV7)
+  static constexpr uint32_t log2(const uint32_t value) {
+    return (value <= 1) ? 0 : 1 + log2(value >> 1);
+  }
+
+  static constexpr uint32_t rbarValid = (1UL << 4);
+  // Enabled, no access, execute never, normal shareable write back memory.
+  static constexpr uint32_t rasrNoAccess() {
+    return (1UL << 28) | (1UL << 18) | (1UL << 17) | (1UL << 16) |
+           ((log2(FREERTOS_CPP_STACK_GUARD_SIZE) - 1) << 1) | (1UL << 0);
+  }
+#elif defined(FREERTOS_CPP_STACK_GUARD_PMSAV8)
+  static constexpr uint32_t rbarReadOnly = (2UL << 1);
+  static constexpr uint32_t rbarExecuteNever = (1UL << 0);
+  static constexpr uint32_t rlarEnable = (1UL << 0);
+#endif
+};
+
+}  // namespace FreeRTOS
+
+/**
+ * @brief Macro that defines the function called by the hook in
+ * <FreeRTOS/StackGuard.h>.  Expand it in exactly one source file.
+ */
+#define FREERTOS_CPP_DEFINE_STACK_GUARD()                                      \
+  extern "C" void freertosCppStackGuardSwitchedIn(const void* stackBase) {     \
+    FreeRTOS::StackGuard::switchedIn(stackBase);                               \
+  }
+
+#endif  // FREERTOS_STACKGUARD_HPP
@@ -0,0 +1,211 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_STACKPROFILER_HPP
+#define FREERTOS_STACKPROFILER_HPP
+
+#include <FreeRTOS/Task.hpp>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (FREERTOS_CPP_STACK_PROFILER == 1) && \
+    (INCLUDE_uxTaskGetStackHighWaterMark == 1) && \
+    (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @brief Stack usage of one task as reported by FreeRTOS::StackProfiler.
+ */
+struct StackUsage {
+  /**
+   * @brief Handle of the task.
+   */
+  TaskHandle_t handle;
+
+  /**
+   * @brief Name of the task.
+   */
+  const char* name;
+
+  /**
+   * @brief The number of words allocated to the stack of the task.  For a
+   * FreeRTOS::StaticTask this is its N template argument.
+   */
+  configSTACK_DEPTH_TYPE allocated;
+
+  /**
+   * @brief The largest number of words the task has used so far.
+   */
+  configSTACK_DEPTH_TYPE used;
+
+  /**
+   * @brief A suggested stack depth in words: used plus the profiler's safety
+   * margin, rounded up to a multiple of 8 words.
+   */
+  configSTACK_DEPTH_TYPE suggested;
+};
+
+/**
+ * @class StackProfiler StackProfiler.hpp <FreeRTOS/StackProfiler.hpp>
+ *
+ * @brief Class that implements a low priority task that periodically samples
+ * the stack high water mark of every FreeRTOS::Task and FreeRTOS::StaticTask
+ * and reports how much of each stack is used.
+ *
+ * FREERTOS_CPP_STACK_PROFILER must be set to 1 so that tasks register their
+ * stacks with FreeRTOS::StackRegistry when they are created, and
+ * INCLUDE_uxTaskGetStackHighWaterMark must be set to 1.  Up to
+ * FREERTOS_CPP_STACK_PROFILER_MAX_TASKS tasks are tracked.
+ *
+ * Finding the high water mark means scanning the unused part of a stack, which
+ * takes time proportional to the stack size.  The profiler does this from its
+ * own task and keeps the results, so forEach() only reads the stored values.
+ *
+ * Run the application through its worst case paths, then use the suggested
+ * depth of each task as the N template argument of its FreeRTOS::StaticTask
+ * (or the stackDepth argument of its FreeRTOS::Task).
+ *
+ * @tparam N The stack depth of the profiler task itself.
+ *
+ * <b>Example Usage</b>
+ * @include StackProfiler/stackProfiler.cpp
+ */
+template <UBaseType_t N = configMINIMAL_STACK_SIZE * 2>
+class StackProfiler : public StaticTask<N> {
+ public:
+  /**
+   * @brief Function called once for each task after every sampling pass.
+   */
+  using Reporter = void (*)(const StackUsage& usage);
+
+  /**
+   * StackProfiler.hpp
+   *
+   * @brief Construct a new StackProfiler object and the task that samples the
+   * registered stacks.
+   *
+   * @param period The number of ticks between sampling passes.
+   * @param reporter Function called for every task after each sampling pass,
+   * or nullptr if the results are only read with forEach().
+   * @param marginPercent Safety margin, as a percentage of the used words,
+   * that is added to form the suggested stack depth.
+   * @param priority The priority of the profiler task.  This should be low so
+   * that sampling does not delay the application.
+   */
+  explicit StackProfiler(const TickType_t period,
+                         const Reporter reporter = nullptr,
+                         const UBaseType_t marginPercent = 25,
+                         const UBaseType_t priority = tskIDLE_PRIORITY + 1)
+      : StaticTask<N>(deferCreate),
+        period(period),
+        reporter(reporter),
+        marginPercent(marginPercent) {
+    // The task is created last, as it reads the period as soon as it runs.
+    this->create(priority, "StackProfiler");
+  }
+  ~StackProfiler() = default;
+
+  StackProfiler(const StackProfiler&) = delete;
+  StackProfiler& operator=(const StackProfiler&) = delete;
+
+  /**
+   * StackProfiler.hpp
+   *
+   * @brief Function that samples the stack high water mark of every registered
+   * task.  This is called periodically by the profiler task, but can also be
+   * called directly.
+   *
+   * The scheduler is suspended while each task is sampled, so that the task
+   * can not be deleted part way through.
+   */
+  static void sample() {
+    for (auto& entry : StackRegistry::entries) {
+      vTaskSuspendAll();
+      if (entry.handle != NULL) {
+        const UBaseType_t unused = uxTaskGetStackHighWaterMark(entry.handle);
+        entry.used = (unused < entry.allocated)
+                         ? (entry.allocated - unused)
+                         : 0;
+      }
+      xTaskResumeAll();
+    }
+  }
+
+  /**
+   * StackProfiler.hpp
+   *
+   * @brief Function that calls function with the stack usage of every
+   * registered task, as of the last sampling pass.
+   *
+   * @param function Function called as <tt>function(const StackUsage&)</tt>.
+   */
+  template <class Function>
+  void forEach(Function&& function) const {
+    for (const auto& entry : StackRegistry::entries) {
+      taskENTER_CRITICAL();
+      const StackRegistry::Entry copy = entry;
+      taskEXIT_CRITICAL();
+      if (copy.handle != NULL) {
+        const StackUsage usage = {copy.handle, pcTaskGetName(copy.handle),
+                                  copy.allocated, copy.used,
+                                  suggest(copy.used)};
+        function(usage);
+      }
+    }
+  }
+
+ private:
+  void taskFunction() final {
+    for (;;) {
+      sample();
+      if (reporter != nullptr) {
+        forEach(reporter);
+      }
+      this->delay(period);
+    }
+  }
+
+  inline configSTACK_DEPTH_TYPE suggest(
+      const configSTACK_DEPTH_TYPE used) const {
+    const uint32_t withMargin =
+        static_cast<uint32_t>(used) * (100 + marginPercent) / 100;
+    return static_cast<configSTACK_DEPTH_TYPE>((withMargin + 7U) & ~7U);
+  }
+
+  const TickType_t period;
+  const Reporter reporter;
+  const UBaseType_t marginPercent;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* FREERTOS_CPP_STACK_PROFILER && INCLUDE_uxTaskGetStackHighWaterMark \
+          && configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_STACKPROFILER_HPP
@@ -0,0 +1,149 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_STATICTASKMEMORY_HPP
+#define FREERTOS_STATICTASKMEMORY_HPP
+
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+/**
+ * @brief The stack depth, in words, of the idle task provided by
+ * FREERTOS_CPP_DEFINE_STATIC_TASK_MEMORY().  On SMP ports the passive idle
+ * tasks use the same depth.
+ */
+#ifndef FREERTOS_CPP_IDLE_TASK_STACK_SIZE
+#define FREERTOS_CPP_IDLE_TASK_STACK_SIZE configMINIMAL_STACK_SIZE
+#endif
+
+/**
+ * @brief The stack depth, in words, of the timer service task provided by
+ * FREERTOS_CPP_DEFINE_STATIC_TASK_MEMORY().
+ */
+#ifndef FREERTOS_CPP_TIMER_TASK_STACK_SIZE
+#define FREERTOS_CPP_TIMER_TASK_STACK_SIZE configTIMER_TASK_STACK_DEPTH
+#endif
+
+namespace FreeRTOS {
+
+/**
+ * @brief The type of the stack size argument of the kernel's task memory
+ * callbacks, which is configSTACK_DEPTH_TYPE from kernel V11.1 and uint32_t
+ * before that.
+ */
+#if (tskKERNEL_VERSION_MAJOR > 11) || \
+    ((tskKERNEL_VERSION_MAJOR == 11) && (tskKERNEL_VERSION_MINOR >= 1))
+using TaskMemoryStackSize = configSTACK_DEPTH_TYPE;
+#else
+using TaskMemoryStackSize = uint32_t;
+#endif /* tskKERNEL_VERSION_MAJOR */
+
+}  // namespace FreeRTOS
+
+#if (configUSE_TIMERS == 1)
+// Defines vApplicationGetTimerTaskMemory() as part of
+// FREERTOS_CPP_DEFINE_STATIC_TASK_MEMORY().
+#define FREERTOS_CPP_DEFINE_TIMER_TASK_MEMORY()                                \
+  extern "C" void vApplicationGetTimerTaskMemory(                              \
+      StaticTask_t** taskBuffer, StackType_t** stackBuffer,                    \
+      FreeRTOS::TaskMemoryStackSize* stackSize) {                              \
+    static StaticTask_t timerTaskBuffer;                                       \
+    static StackType_t timerStack[FREERTOS_CPP_TIMER_TASK_STACK_SIZE];         \
+    *taskBuffer = &timerTaskBuffer;                                            \
+    *stackBuffer = timerStack;                                                 \
+    *stackSize = FREERTOS_CPP_TIMER_TASK_STACK_SIZE;                           \
+  }
+#else
+#define FREERTOS_CPP_DEFINE_TIMER_TASK_MEMORY()
+#endif /* configUSE_TIMERS */
+
+#if (configNUMBER_OF_CORES > 1)
+// Defines vApplicationGetPassiveIdleTaskMemory() as part of
+// FREERTOS_CPP_DEFINE_STATIC_TASK_MEMORY().
+#define FREERTOS_CPP_DEFINE_PASSIVE_IDLE_TASK_MEMORY()                         \
+  extern "C" void vApplicationGetPassiveIdleTaskMemory(                        \
+      StaticTask_t** taskBuffer, StackType_t** stackBuffer,                    \
+      FreeRTOS::TaskMemoryStackSize* stackSize, BaseType_t index) {            \
+    static StaticTask_t idleTaskBuffers[configNUMBER_OF_CORES - 1];            \
+    static StackType_t                                                         \
+        idleStacks[configNUMBER_OF_CORES - 1]                                  \
+                  [FREERTOS_CPP_IDLE_TASK_STACK_SIZE];                         \
+    *taskBuffer = &idleTaskBuffers[index];                                     \
+    *stackBuffer = idleStacks[index];                                          \
+    *stackSize = FREERTOS_CPP_IDLE_TASK_STACK_SIZE;                            \
+  }
+#else
+#define FREERTOS_CPP_DEFINE_PASSIVE_IDLE_TASK_MEMORY()
+#endif /* configNUMBER_OF_CORES */
+
+/**
+ * @brief Macro that defines the memory callbacks that the kernel calls to get
+ * the task control blocks and stacks of its own tasks when
+ * configSUPPORT_STATIC_ALLOCATION is 1.
+ *
+ * Expand this macro in exactly one source file.  It defines
+ * <tt>vApplicationGetIdleTaskMemory()</tt>, plus
+ * <tt>vApplicationGetTimerTaskMemory()</tt> if configUSE_TIMERS is 1 and
+ * <tt>vApplicationGetPassiveIdleTaskMemory()</tt> on SMP ports.  The memory is
+ * statically allocated, with stack depths set by
+ * FREERTOS_CPP_IDLE_TASK_STACK_SIZE and FREERTOS_CPP_TIMER_TASK_STACK_SIZE.
+ * Do not expand it if configKERNEL_PROVIDED_STATIC_MEMORY is 1, as the kernel
+ * then defines the same functions.
+ *
+ * Combined with the Static classes of this library, this allows a build with
+ * configSUPPORT_DYNAMIC_ALLOCATION set to 0, which links none of the kernel's
+ * heap_n.c files and does not initialise a heap at startup.
+ *
+ * @code{cpp}
+ * #include <FreeRTOS/StaticTaskMemory.hpp>
+ *
+ * FREERTOS_CPP_DEFINE_STATIC_TASK_MEMORY()
+ * @endcode
+ *
+ * <b>Example Usage</b>
+ * @include StaticTaskMemory/staticTaskMemory.cpp
+ */
+#define FREERTOS_CPP_DEFINE_STATIC_TASK_MEMORY()                               \
+  extern "C" void vApplicationGetIdleTaskMemory(                               \
+      StaticTask_t** taskBuffer, StackType_t** stackBuffer,                    \
+      FreeRTOS::TaskMemoryStackSize* stackSize) {                              \
+    static StaticTask_t idleTaskBuffer;                                        \
+    static StackType_t idleStack[FREERTOS_CPP_IDLE_TASK_STACK_SIZE];           \
+    *taskBuffer = &idleTaskBuffer;                                             \
+    *stackBuffer = idleStack;                                                  \
+    *stackSize = FREERTOS_CPP_IDLE_TASK_STACK_SIZE;                            \
+  }                                                                            \
+  FREERTOS_CPP_DEFINE_TIMER_TASK_MEMORY()                                      \
+  FREERTOS_CPP_DEFINE_PASSIVE_IDLE_TASK_MEMORY()
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_STATICTASKMEMORY_HPP
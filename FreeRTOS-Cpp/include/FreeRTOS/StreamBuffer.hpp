@@ -28,6 +28,11 @@
 #ifndef FREERTOS_STREAMBUFFER_HPP
 #define FREERTOS_STREAMBUFFER_HPP
 
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/DeferCreate.hpp>
+#include <FreeRTOS/Instrumentation.hpp>
+#include <FreeRTOS/Region.hpp>
+
 #include "FreeRTOS.h"
 #include "stream_buffer.h"
 
@@ -61,7 +66,7 @@ namespace FreeRTOS {
 class StreamBufferBase {
  public:
   friend class StreamBuffer;
-  template <size_t>
+  template <size_t, size_t, class>
   friend class StaticStreamBuffer;
 
   StreamBufferBase(const StreamBufferBase&) = delete;
@@ -132,7 +137,20 @@ class StreamBufferBase {
    */
   inline size_t send(const void* data, const size_t length,
                      const TickType_t ticksToWait = portMAX_DELAY) const {
-    return xStreamBufferSend(handle, data, length, ticksToWait);
+    return Instrument::call(
+        InstrumentedCall::StreamBufferSend, handle, ticksToWait,
+        [&] { return xStreamBufferSend(handle, data, length, ticksToWait); });
+  }
+
+  /**
+   * StreamBuffer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline size_t send(const void* data, const size_t length,
+                     const std::chrono::duration<Rep, Period>& timeout) const {
+    return send(data, length, Clock::toTicks(timeout));
   }
 
   /**
@@ -176,8 +194,10 @@ class StreamBufferBase {
   inline size_t sendFromISR(bool& higherPriorityTaskWoken, const void* data,
                             const size_t length) const {
     BaseType_t taskWoken = pdFALSE;
-    const size_t result =
-        xStreamBufferSendFromISR(handle, data, length, &taskWoken);
+    const size_t result = Instrument::callFromISR(
+        InstrumentedCall::StreamBufferSend, handle, [&] {
+          return xStreamBufferSendFromISR(handle, data, length, &taskWoken);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
@@ -196,7 +216,10 @@ class StreamBufferBase {
    * @overload
    */
   inline size_t sendFromISR(const void* data, const size_t length) const {
-    return xStreamBufferSendFromISR(handle, data, length, NULL);
+    return Instrument::callFromISR(
+        InstrumentedCall::StreamBufferSend, handle, [&] {
+          return xStreamBufferSendFromISR(handle, data, length, NULL);
+        });
   }
 
   /**
@@ -238,7 +261,24 @@ class StreamBufferBase {
    */
   inline size_t receive(void* buffer, const size_t bufferLength,
                         const TickType_t ticksToWait = portMAX_DELAY) const {
-    return xStreamBufferReceive(handle, buffer, bufferLength, ticksToWait);
+    return Instrument::call(
+        InstrumentedCall::StreamBufferReceive, handle, ticksToWait,
+        [&] {
+          return xStreamBufferReceive(handle, buffer, bufferLength,
+                                      ticksToWait);
+        });
+  }
+
+  /**
+   * StreamBuffer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline size_t receive(
+      void* buffer, const size_t bufferLength,
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    return receive(buffer, bufferLength, Clock::toTicks(timeout));
   }
 
   /**
@@ -284,8 +324,11 @@ class StreamBufferBase {
   inline size_t receiveFromISR(bool& higherPriorityTaskWoken, void* buffer,
                                const size_t bufferLength) const {
     BaseType_t taskWoken = pdFALSE;
-    const size_t result =
-        xStreamBufferReceiveFromISR(handle, buffer, bufferLength, &taskWoken);
+    const size_t result = Instrument::callFromISR(
+        InstrumentedCall::StreamBufferReceive, handle, [&] {
+          return xStreamBufferReceiveFromISR(handle, buffer, bufferLength,
+                                             &taskWoken);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
@@ -304,7 +347,11 @@ class StreamBufferBase {
    * @overload
    */
   inline size_t receiveFromISR(void* buffer, const size_t bufferLength) const {
-    return xStreamBufferReceiveFromISR(handle, buffer, bufferLength, NULL);
+    return Instrument::callFromISR(
+        InstrumentedCall::StreamBufferReceive, handle, [&] {
+          return xStreamBufferReceiveFromISR(handle, buffer, bufferLength,
+                                             NULL);
+        });
   }
 
   /**
@@ -447,7 +494,9 @@ class StreamBufferBase {
    * Deletes a stream buffer and free the allocated memory.
    */
   ~StreamBufferBase() {
-    vStreamBufferDelete(this->handle);
+    if (this->handle != NULL) {
+      vStreamBufferDelete(this->handle);
+    }
   }
 
   StreamBufferBase(StreamBufferBase&&) noexcept = default;
@@ -504,6 +553,48 @@ class StreamBuffer : public StreamBufferBase {
   explicit StreamBuffer(const size_t size, const size_t triggerLevel = 0) {
     this->handle = xStreamBufferCreate(size, triggerLevel);
   }
+
+#if (configUSE_SB_COMPLETED_CALLBACK == 1)
+  /**
+   * StreamBuffer.hpp
+   *
+   * @brief Construct a new StreamBuffer object by calling
+   * <tt>StreamBufferHandle_t xStreamBufferCreateWithCallback( size_t
+   * xBufferSizeBytes, size_t xTriggerLevelBytes,
+   * StreamBufferCallbackFunction_t pxSendCompletedCallback,
+   * StreamBufferCallbackFunction_t pxReceiveCompletedCallback )</tt>
+   *
+   * @see <https://www.freertos.org/xStreamBufferCreate.html>
+   *
+   * configUSE_SB_COMPLETED_CALLBACK must be set to 1 in FreeRTOSConfig.h for
+   * this constructor to be available.
+   *
+   * @warning The user should call isValid() on this object to verify that the
+   * stream buffer was created successfully.
+   *
+   * @param size The total number of bytes the stream buffer will be able to
+   * hold at any one time.
+   * @param triggerLevel The number of bytes that must be in the stream buffer
+   * before a task that is blocked on it waiting for data is unblocked.
+   * @param sendCompleted Function called instead of the sbSEND_COMPLETED()
+   * macro each time data is written to the buffer, for example to signal
+   * another core or start a DMA transfer.  It is passed the buffer handle,
+   * whether it is being called from an interrupt, and a pointer through which
+   * it can request a context switch.  NULL uses sbSEND_COMPLETED().
+   * @param receiveCompleted Function called instead of the
+   * sbRECEIVE_COMPLETED() macro each time data is read from the buffer.  NULL
+   * uses sbRECEIVE_COMPLETED().
+   *
+   * <b>Example Usage</b>
+   * @include StreamBuffer/completedCallback.cpp
+   */
+  StreamBuffer(const size_t size, const size_t triggerLevel,
+               const StreamBufferCallbackFunction_t sendCompleted,
+               const StreamBufferCallbackFunction_t receiveCompleted = NULL) {
+    this->handle = xStreamBufferCreateWithCallback(
+        size, triggerLevel, sendCompleted, receiveCompleted);
+  }
+#endif /* configUSE_SB_COMPLETED_CALLBACK */
   ~StreamBuffer() = default;
 
   StreamBuffer(const StreamBuffer&) = delete;
@@ -526,10 +617,32 @@ class StreamBuffer : public StreamBufferBase {
  * the application writer as part of the object instance and allows the RAM to
  * be statically allocated at compile time.
  *
+ * The storage is part of the object instance, so to place it in a particular
+ * memory region, such as non-cacheable, DMA capable or tightly coupled RAM,
+ * give the object declaration a section attribute, for example
+ * <tt>__attribute__((section(".dma_buffers")))</tt>.  The control block is
+ * placed in the same region.
+ *
  * @tparam N The size, in bytes, of the storage buffer for the stream buffer.
+ * @tparam Alignment The alignment, in bytes, of the storage.  Set it to the
+ * data cache line size (for example 32 on a Cortex-M7) when the storage is the
+ * source or destination of DMA transfers, so that cache maintenance on the
+ * storage never touches a line shared with other data.  Must be a power of
+ * two.
+ * @tparam Region The memory region that holds the control block and storage.
+ * By default they are part of the object instance.  A region defined with
+ * FREERTOS_CPP_DEFINE_REGION() places them in a linker section independently
+ * of where the object itself is placed.
+ *
+ * <b>Example Usage</b>
+ * @include StreamBuffer/alignedStorage.cpp
  */
-template <size_t N>
+template <size_t N, size_t Alignment = alignof(uint8_t),
+          class Region = DefaultRegion>
 class StaticStreamBuffer : public StreamBufferBase {
+  static_assert((Alignment & (Alignment - 1)) == 0,
+                "Alignment must be a power of two.");
+
  public:
   /**
    * StreamBuffer.hpp
@@ -560,9 +673,56 @@ class StaticStreamBuffer : public StreamBufferBase {
    * @include StreamBuffer/staticStreamBuffer.cpp
    */
   explicit StaticStreamBuffer(const size_t triggerLevel = 0) {
-    this->handle = xStreamBufferCreateStatic(sizeof(storage), triggerLevel,
-                                             storage, &staticStreamBuffer);
+    create(triggerLevel);
   }
+
+#if (configUSE_SB_COMPLETED_CALLBACK == 1)
+  /**
+   * StreamBuffer.hpp
+   *
+   * @brief Construct a new StaticStreamBuffer object by calling
+   * <tt>StreamBufferHandle_t xStreamBufferCreateStaticWithCallback( size_t
+   * xBufferSizeBytes, size_t xTriggerLevelBytes, uint8_t
+   * *pucStreamBufferStorageArea, StaticStreamBuffer_t *pxStaticStreamBuffer,
+   * StreamBufferCallbackFunction_t pxSendCompletedCallback,
+   * StreamBufferCallbackFunction_t pxReceiveCompletedCallback )</tt>
+   *
+   * @see <https://www.freertos.org/xStreamBufferCreateStatic.html>
+   *
+   * configUSE_SB_COMPLETED_CALLBACK must be set to 1 in FreeRTOSConfig.h for
+   * this constructor to be available.
+   *
+   * @param triggerLevel The number of bytes that must be in the stream buffer
+   * before a task that is blocked on it waiting for data is unblocked.
+   * @param sendCompleted Function called instead of the sbSEND_COMPLETED()
+   * macro each time data is written to the buffer, for example to signal
+   * another core or start a DMA transfer.  It is passed the buffer handle,
+   * whether it is being called from an interrupt, and a pointer through which
+   * it can request a context switch.  NULL uses sbSEND_COMPLETED().
+   * @param receiveCompleted Function called instead of the
+   * sbRECEIVE_COMPLETED() macro each time data is read from the buffer.  NULL
+   * uses sbRECEIVE_COMPLETED().
+   */
+  StaticStreamBuffer(
+      const size_t triggerLevel,
+      const StreamBufferCallbackFunction_t sendCompleted,
+      const StreamBufferCallbackFunction_t receiveCompleted = NULL) {
+    create(triggerLevel, sendCompleted, receiveCompleted);
+  }
+#endif /* configUSE_SB_COMPLETED_CALLBACK */
+
+  /**
+   * StreamBuffer.hpp
+   *
+   * @brief Construct a new StaticStreamBuffer object without creating the
+   * stream buffer.
+   *
+   * This constructor is constexpr, so a global object constructed with it is
+   * constant initialized.  create() must be called before the stream buffer is
+   * used.
+   */
+  constexpr explicit StaticStreamBuffer(DeferCreate)
+      : staticStreamBuffer(deferCreate), storage(deferCreate) {}
   ~StaticStreamBuffer() = default;
 
   StaticStreamBuffer(const StaticStreamBuffer&) = delete;
@@ -571,9 +731,66 @@ class StaticStreamBuffer : public StreamBufferBase {
   StaticStreamBuffer(StaticStreamBuffer&&) noexcept = default;
   StaticStreamBuffer& operator=(StaticStreamBuffer&&) noexcept = default;
 
+  /**
+   * StreamBuffer.hpp
+   *
+   * @brief Function that calls <tt>StreamBufferHandle_t
+   * xStreamBufferCreateStatic( size_t xBufferSizeBytes, size_t
+   * xTriggerLevelBytes, uint8_t *pucStreamBufferStorageArea,
+   * StaticStreamBuffer_t *pxStaticStreamBuffer )</tt> to create a stream
+   * buffer that was constructed with FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/xStreamBufferCreateStatic.html>
+   *
+   * @param triggerLevel The number of bytes that must be in the stream buffer
+   * before a task that is blocked on it waiting for data is unblocked.
+   * @retval true If the stream buffer was created.
+   * @retval false Otherwise.
+   */
+  bool create(const size_t triggerLevel = 0) {
+    configASSERT(this->handle == NULL);
+    this->handle = xStreamBufferCreateStatic(
+        N, triggerLevel, storage.get(), staticStreamBuffer.get());
+    return (this->handle != NULL);
+  }
+
+#if (configUSE_SB_COMPLETED_CALLBACK == 1)
+  /**
+   * StreamBuffer.hpp
+   *
+   * @brief Function that calls <tt>StreamBufferHandle_t
+   * xStreamBufferCreateStaticWithCallback( size_t xBufferSizeBytes, size_t
+   * xTriggerLevelBytes, uint8_t *pucStreamBufferStorageArea,
+   * StaticStreamBuffer_t *pxStaticStreamBuffer, StreamBufferCallbackFunction_t
+   * pxSendCompletedCallback, StreamBufferCallbackFunction_t
+   * pxReceiveCompletedCallback )</tt> to create a stream buffer that was
+   * constructed with FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/xStreamBufferCreateStatic.html>
+   *
+   * @param triggerLevel The number of bytes that must be in the stream buffer
+   * before a task that is blocked on it waiting for data is unblocked.
+   * @param sendCompleted Function called instead of the sbSEND_COMPLETED()
+   * macro, or NULL.
+   * @param receiveCompleted Function called instead of the
+   * sbRECEIVE_COMPLETED() macro, or NULL.
+   * @retval true If the stream buffer was created.
+   * @retval false Otherwise.
+   */
+  bool create(const size_t triggerLevel,
+              const StreamBufferCallbackFunction_t sendCompleted,
+              const StreamBufferCallbackFunction_t receiveCompleted = NULL) {
+    configASSERT(this->handle == NULL);
+    this->handle = xStreamBufferCreateStaticWithCallback(
+        N, triggerLevel, storage.get(), staticStreamBuffer.get(),
+        sendCompleted, receiveCompleted);
+    return (this->handle != NULL);
+  }
+#endif /* configUSE_SB_COMPLETED_CALLBACK */
+
  private:
-  StaticStreamBuffer_t staticStreamBuffer;
-  uint8_t storage[N];
+  RegionStorage<StaticStreamBuffer_t, 1, Region> staticStreamBuffer;
+  RegionStorage<uint8_t, N, Region, Alignment> storage;
 };
 
 #endif /* configSUPPORT_STATIC_ALLOCATION */
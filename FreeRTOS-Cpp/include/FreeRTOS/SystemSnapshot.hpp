@@ -0,0 +1,217 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_SYSTEMSNAPSHOT_HPP
+#define FREERTOS_SYSTEMSNAPSHOT_HPP
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TRACE_FACILITY == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class SystemSnapshot SystemSnapshot.hpp <FreeRTOS/SystemSnapshot.hpp>
+ *
+ * @brief Class that holds the state of every task in the system at one point
+ * in time, as returned by <tt>uxTaskGetSystemState()</tt>.
+ *
+ * The task status records are stored in an array contained in the object
+ * instance, so taking a snapshot does not use the FreeRTOS heap.
+ *
+ * When configGENERATE_RUN_TIME_STATS is 1, two snapshots taken some time apart
+ * can be compared with forEachTaskLoad() to find out how much of the processor
+ * time each task used in between.
+ *
+ * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for this
+ * class to be available.
+ *
+ * @tparam MaxTasks The maximum number of tasks the snapshot can hold.  This
+ * must include the idle and timer service tasks.
+ *
+ * <b>Example Usage</b>
+ * @include SystemSnapshot/systemSnapshot.cpp
+ */
+template <UBaseType_t MaxTasks>
+class SystemSnapshot {
+ public:
+  /**
+   * @brief Type of the run time counters of the kernel.
+   */
+  using RunTimeCounter = decltype(TaskStatus_t::ulRunTimeCounter);
+
+  /**
+   * @brief Processor time used by one task between two snapshots.
+   */
+  struct TaskLoad {
+    /**
+     * @brief Status of the task in the later snapshot.
+     */
+    const TaskStatus_t& status;
+
+    /**
+     * @brief Run time counter ticks used by the task between the snapshots.
+     */
+    RunTimeCounter runTime;
+
+    /**
+     * @brief Percentage of the total run time used by the task between the
+     * snapshots, in hundredths of a percent.  So 2550 means 25.50%.
+     */
+    uint32_t percentHundredths;
+  };
+
+  SystemSnapshot() = default;
+  ~SystemSnapshot() = default;
+
+  /**
+   * SystemSnapshot.hpp
+   *
+   * @brief Function that calls <tt>UBaseType_t uxTaskGetSystemState(
+   * TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize,
+   * unsigned long * const pulTotalRunTime )</tt>
+   *
+   * @see <https://www.freertos.org/uxTaskGetSystemState.html>
+   *
+   * Fills the snapshot with the state of every task.  The scheduler is
+   * suspended while the snapshot is taken, so this should only be used for
+   * debugging.
+   *
+   * @retval true The snapshot was taken.
+   * @retval false There are more than MaxTasks tasks, so the snapshot is
+   * empty.
+   */
+  bool capture() {
+    count = uxTaskGetSystemState(statuses, MaxTasks, &totalRunTime);
+    return (count != 0);
+  }
+
+  /**
+   * SystemSnapshot.hpp
+   *
+   * @brief Function that returns the number of tasks in the snapshot.
+   */
+  inline UBaseType_t size() const {
+    return count;
+  }
+
+  /**
+   * SystemSnapshot.hpp
+   *
+   * @brief Function that returns the total run time counter at the time the
+   * snapshot was taken.  Only meaningful when configGENERATE_RUN_TIME_STATS is
+   * 1.
+   */
+  inline RunTimeCounter getTotalRunTime() const {
+    return totalRunTime;
+  }
+
+  inline const TaskStatus_t& operator[](const UBaseType_t index) const {
+    return statuses[index];
+  }
+
+  inline const TaskStatus_t* begin() const {
+    return statuses;
+  }
+
+  inline const TaskStatus_t* end() const {
+    return statuses + count;
+  }
+
+  /**
+   * SystemSnapshot.hpp
+   *
+   * @brief Function that finds the status of a task in the snapshot.
+   *
+   * @param handle Handle of the task.
+   * @return const TaskStatus_t* The status of the task, or nullptr if the task
+   * is not in the snapshot.
+   */
+  const TaskStatus_t* find(const TaskHandle_t handle) const {
+    for (const auto& status : *this) {
+      if (status.xHandle == handle) {
+        return &status;
+      }
+    }
+    return nullptr;
+  }
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+  /**
+   * SystemSnapshot.hpp
+   *
+   * @brief Function that calls function with the processor time used by each
+   * task between previous and this snapshot.
+   *
+   * Tasks are matched by task number, so a task that was deleted and a new
+   * task that reused its handle are not confused.  Tasks that are not in
+   * previous were created in between, and their whole run time counter is
+   * counted.
+   *
+   * configGENERATE_RUN_TIME_STATS must be defined as 1 in FreeRTOSConfig.h for
+   * this function to be available.
+   *
+   * @param previous A snapshot taken before this one.
+   * @param function Function called as <tt>function(const TaskLoad&)</tt> for
+   * each task in this snapshot.
+   */
+  template <UBaseType_t PreviousMaxTasks, class Function>
+  void forEachTaskLoad(const SystemSnapshot<PreviousMaxTasks>& previous,
+                       Function&& function) const {
+    const RunTimeCounter interval =
+        totalRunTime - previous.getTotalRunTime();
+    for (const auto& status : *this) {
+      RunTimeCounter runTime = status.ulRunTimeCounter;
+      for (const auto& before : previous) {
+        if (before.xTaskNumber == status.xTaskNumber) {
+          runTime -= before.ulRunTimeCounter;
+          break;
+        }
+      }
+      const uint32_t percentHundredths =
+          (interval == 0) ? 0
+                          : static_cast<uint32_t>(
+                                (static_cast<uint64_t>(runTime) * 10000U) /
+                                interval);
+      const TaskLoad load = {status, runTime, percentHundredths};
+      function(load);
+    }
+  }
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+ private:
+  TaskStatus_t statuses[MaxTasks];
+  UBaseType_t count = 0;
+  RunTimeCounter totalRunTime = 0;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TRACE_FACILITY */
+
+#endif  // FREERTOS_SYSTEMSNAPSHOT_HPP
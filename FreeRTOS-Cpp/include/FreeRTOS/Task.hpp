@@ -28,24 +28,156 @@
 #ifndef FREERTOS_TASK_HPP
 #define FREERTOS_TASK_HPP
 
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/DeferCreate.hpp>
 #include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Region.hpp>
 #include <bitset>
+#include <type_traits>
 #include <utility>
 
 #include "FreeRTOS.h"
 #include "task.h"
 
 /**
- * @brief C function that is used to interface this class with the FreeRTOS
- * kernel.
+ * @brief Set FREERTOS_CPP_STACK_PROFILER to 1 in FreeRTOSConfig.h (or on the
+ * compiler command line) to have every FreeRTOS::Task and FreeRTOS::StaticTask
+ * register its stack with FreeRTOS::StackRegistry so that the stack usage of
+ * every task can be reported by FreeRTOS::StackProfiler.
+ */
+#ifndef FREERTOS_CPP_STACK_PROFILER
+#define FREERTOS_CPP_STACK_PROFILER 0
+#endif
+
+/**
+ * @brief The maximum number of tasks FreeRTOS::StackRegistry can track.
+ */
+#ifndef FREERTOS_CPP_STACK_PROFILER_MAX_TASKS
+#define FREERTOS_CPP_STACK_PROFILER_MAX_TASKS 16
+#endif
+
+/**
+ * @brief Set FREERTOS_CPP_TASK_JOIN to 1 in FreeRTOSConfig.h (or on the
+ * compiler command line) to enable FreeRTOS::TaskBase::join() so that a task
+ * can block until another task returns from its taskFunction().
+ */
+#ifndef FREERTOS_CPP_TASK_JOIN
+#define FREERTOS_CPP_TASK_JOIN 0
+#endif
+
+/**
+ * @brief The index of the task notification that join() uses to wait for a
+ * task to finish.  The notification at this index of a task that calls join()
+ * must not be used for any other purpose.
+ */
+#ifndef FREERTOS_CPP_TASK_JOIN_INDEX
+#define FREERTOS_CPP_TASK_JOIN_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+
+/**
+ * @brief Set FREERTOS_CPP_COMPACT to 1 in FreeRTOSConfig.h (or on the compiler
+ * command line) to leave out the members that only some objects use, so that
+ * a task object is its handle plus any static storage.  FreeRTOS::TaskBase
+ * then stores no previous wake time, so delayUntil() must be passed one, and
+ * isValid() checks the handle instead of a stored flag.  The same setting
+ * removes the delete block time from FreeRTOS::TimerBase.
+ */
+#ifndef FREERTOS_CPP_COMPACT
+#define FREERTOS_CPP_COMPACT 0
+#endif
+
+/**
+ * @brief The alignment, in bytes, of the stacks of FreeRTOS::StaticTask and
+ * FreeRTOS::StaticCrtpTask.  <FreeRTOS/StackGuard.h> sets it to the size of
+ * the stack guard region so that the guard covers the bottom of each stack.
+ */
+#ifndef FREERTOS_CPP_STACK_ALIGNMENT
+#define FREERTOS_CPP_STACK_ALIGNMENT alignof(StackType_t)
+#endif
+
+namespace FreeRTOS {
+
+#if (FREERTOS_CPP_STACK_PROFILER == 1)
+
+/**
+ * @class StackRegistry Task.hpp <FreeRTOS/Task.hpp>
+ *
+ * @brief Class that records the stack allocated to every FreeRTOS::Task and
+ * FreeRTOS::StaticTask while FREERTOS_CPP_STACK_PROFILER is set to 1.
  *
- * @note This function should not be called or referenced by the user.
+ * Tasks are added when they are created and removed when they are destroyed.
+ * The registry is read by FreeRTOS::StackProfiler.
  *
- * @param task Pointer to an instance of FreeRTOS::TaskBase.
+ * @note This class is not intended to be used directly by the user.
  */
-void callTaskFunction(void* task);
+class StackRegistry {
+ public:
+  /**
+   * @brief The stack of a registered task.
+   */
+  struct Entry {
+    /**
+     * @brief Handle of the task, or NULL if the entry is unused.
+     */
+    TaskHandle_t handle;
+
+    /**
+     * @brief The number of words allocated to the stack of the task.
+     */
+    configSTACK_DEPTH_TYPE allocated;
+
+    /**
+     * @brief The largest number of words the task has used, as of the last
+     * time the task was sampled.
+     */
+    configSTACK_DEPTH_TYPE used;
+  };
 
-namespace FreeRTOS {
+ private:
+  friend class TaskBase;
+  friend class Task;
+  template <UBaseType_t, class>
+  friend class StaticTask;
+  template <class>
+  friend class CrtpTask;
+  template <class, UBaseType_t>
+  friend class StaticCrtpTask;
+  template <UBaseType_t>
+  friend class StackProfiler;
+
+  static void add(const TaskHandle_t handle,
+                  const configSTACK_DEPTH_TYPE allocated) {
+    taskENTER_CRITICAL();
+    for (auto& entry : entries) {
+      if (entry.handle == NULL) {
+        entry.handle = handle;
+        entry.allocated = allocated;
+        entry.used = 0;
+        break;
+      }
+    }
+    taskEXIT_CRITICAL();
+  }
+
+  static void remove(const TaskHandle_t handle) {
+    taskENTER_CRITICAL();
+    for (auto& entry : entries) {
+      if (entry.handle == handle) {
+        entry.handle = NULL;
+        break;
+      }
+    }
+    taskEXIT_CRITICAL();
+  }
+
+  /**
+   * @brief Registered stacks.  Zero initialized, so every entry starts unused
+   * before any task constructor runs.
+   */
+  static inline Entry entries[FREERTOS_CPP_STACK_PROFILER_MAX_TASKS] = {};
+};
+
+#endif /* FREERTOS_CPP_STACK_PROFILER */
 
 /**
  * @class TaskBase Task.hpp <FreeRTOS/Task.hpp>
@@ -60,8 +192,24 @@ namespace FreeRTOS {
 class TaskBase {
  public:
   friend class Task;
-  template <UBaseType_t>
+  template <UBaseType_t, class>
   friend class StaticTask;
+  template <class>
+  friend class CrtpTask;
+  template <class, UBaseType_t>
+  friend class StaticCrtpTask;
+  template <UBaseType_t, class>
+  friend class NotifyChannel;
+  template <UBaseType_t>
+  friend class NotifySemaphore;
+  template <UBaseType_t>
+  friend class NotifyCountingSemaphore;
+  template <UBaseType_t>
+  friend class EventCounter;
+  template <class, BaseType_t>
+  friend class TaskLocal;
+  template <class, UBaseType_t>
+  friend class ServerQueue;
 
   TaskBase(const TaskBase&) = delete;
   TaskBase& operator=(const TaskBase&) = delete;
@@ -96,22 +244,6 @@ class TaskBase {
 
   using NotificationBits = std::bitset<32>;  // NOLINT
 
-  /**
-   * Task.hpp
-   *
-   * @brief Function that acts as the entry point of the task instance. This
-   * function initializes the previous wake time of the task and calls the user
-   * implemented taskFunction().
-   *
-   * @note This function is only public so that it can be accessed by the C
-   * interface function <tt>callTaskFunction()</tt> and should not be called or
-   * referenced by the user.
-   */
-  virtual inline void taskEntry() final {
-    previousWakeTime = FreeRTOS::Kernel::getTickCount();
-    taskFunction();
-  };
-
 #if (INCLUDE_uxTaskPriorityGet == 1)
   /**
    * Task.hpp
@@ -320,6 +452,185 @@ class TaskBase {
   }
 #endif /* INCLUDE_xTaskAbortDelay */
 
+#if (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1)
+  /**
+   * Task.hpp
+   *
+   * @brief Function that calls <tt>void vTaskCoreAffinitySet( const
+   * TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask )</tt>
+   *
+   * @see <https://www.freertos.org/symmetric-multiprocessing-introduction.html>
+   *
+   * configNUMBER_OF_CORES must be greater than 1 and configUSE_CORE_AFFINITY
+   * must be defined as 1 for this function to be available.
+   *
+   * Sets the core affinity mask for the task, i.e. the cores on which the task
+   * can run.  If the task is running on a core that is no longer in the mask
+   * it is moved to an allowed core.
+   *
+   * @param coreAffinityMask A bitwise value that indicates the cores on which
+   * the task can run.  Cores are numbered from 0 to configNUMBER_OF_CORES - 1.
+   * For example, to ensure that the task can run on core 0 and core 1, set
+   * coreAffinityMask to 0x03.  tskNO_AFFINITY allows the task to run on any
+   * core.
+   *
+   * <b>Example Usage</b>
+   * @include Task/coreAffinity.cpp
+   */
+  inline void setCoreAffinity(const UBaseType_t coreAffinityMask) const {
+    vTaskCoreAffinitySet(handle, coreAffinityMask);
+  }
+
+  /**
+   * Task.hpp
+   *
+   * @brief Function that calls <tt>UBaseType_t vTaskCoreAffinityGet( const
+   * TaskHandle_t xTask )</tt>
+   *
+   * @see <https://www.freertos.org/symmetric-multiprocessing-introduction.html>
+   *
+   * configNUMBER_OF_CORES must be greater than 1 and configUSE_CORE_AFFINITY
+   * must be defined as 1 for this function to be available.
+   *
+   * @return UBaseType_t The core affinity mask of the task, a bitwise value
+   * that indicates the cores on which the task can run.
+   *
+   * <b>Example Usage</b>
+   * @include Task/coreAffinity.cpp
+   */
+  inline UBaseType_t getCoreAffinity() const {
+    return vTaskCoreAffinityGet(handle);
+  }
+#endif /* (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1) */
+
+#if (configUSE_TASK_PREEMPTION_DISABLE == 1)
+  /**
+   * Task.hpp
+   *
+   * @brief Function that calls <tt>void vTaskPreemptionDisable( const
+   * TaskHandle_t xTask )</tt>
+   *
+   * @see <https://www.freertos.org/symmetric-multiprocessing-introduction.html>
+   *
+   * configUSE_TASK_PREEMPTION_DISABLE must be defined as 1 for this function
+   * to be available.
+   *
+   * Disables preemption of the task.  While preemption is disabled the task
+   * keeps its core until it blocks, yields or calls enablePreemption(), even
+   * if a higher priority task becomes ready.  Interrupts are not disabled.
+   *
+   * <b>Example Usage</b>
+   * @include Task/coreAffinity.cpp
+   */
+  inline void disablePreemption() const {
+    vTaskPreemptionDisable(handle);
+  }
+
+  /**
+   * Task.hpp
+   *
+   * @brief Function that calls <tt>void vTaskPreemptionEnable( const
+   * TaskHandle_t xTask )</tt>
+   *
+   * @see <https://www.freertos.org/symmetric-multiprocessing-introduction.html>
+   *
+   * configUSE_TASK_PREEMPTION_DISABLE must be defined as 1 for this function
+   * to be available.
+   *
+   * Enables preemption of the task after a call to disablePreemption().
+   *
+   * <b>Example Usage</b>
+   * @include Task/coreAffinity.cpp
+   */
+  inline void enablePreemption() const {
+    vTaskPreemptionEnable(handle);
+  }
+#endif /* configUSE_TASK_PREEMPTION_DISABLE */
+
+#if (FREERTOS_CPP_TASK_JOIN == 1)
+  /**
+   * Task.hpp
+   *
+   * @brief Function that blocks the calling task until this task returns from
+   * its taskFunction().
+   *
+   * FREERTOS_CPP_TASK_JOIN must be defined as 1 for this function to be
+   * available.
+   *
+   * The calling task waits on its notification at index
+   * FREERTOS_CPP_TASK_JOIN_INDEX, so it does not consume any CPU time while it
+   * waits and it is unblocked as soon as the task finishes.  Only one task at a
+   * time can join a task.
+   *
+   * When a task returns from taskFunction() it does not delete itself, as that
+   * would race with the destructor of its object.  It suspends itself instead,
+   * and the destructor deletes it.  The object can therefore be destroyed as
+   * soon as join() returns true.
+   *
+   * @param ticksToWait The maximum amount of time the calling task should
+   * remain in the Blocked state to wait for the task to finish.
+   * @retval true The task has finished.
+   * @retval false The task did not finish before ticksToWait expired.
+   *
+   * <b>Example Usage</b>
+   * @include Task/join.cpp
+   */
+  bool join(const TickType_t ticksToWait = portMAX_DELAY) {
+    xTaskNotifyStateClearIndexed(NULL, FREERTOS_CPP_TASK_JOIN_INDEX);
+    ulTaskNotifyValueClearIndexed(NULL, FREERTOS_CPP_TASK_JOIN_INDEX,
+                                  UINT32_MAX);
+
+    taskENTER_CRITICAL();
+    const bool alreadyFinished = finished;
+    if (!alreadyFinished) {
+      configASSERT(joiner == NULL);
+      joiner = xTaskGetCurrentTaskHandle();
+    }
+    taskEXIT_CRITICAL();
+
+    if (alreadyFinished) {
+      return true;
+    }
+
+    ulTaskNotifyTakeIndexed(FREERTOS_CPP_TASK_JOIN_INDEX, pdTRUE, ticksToWait);
+
+    taskENTER_CRITICAL();
+    joiner = NULL;
+    const bool result = finished;
+    taskEXIT_CRITICAL();
+    return result;
+  }
+
+  /**
+   * Task.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  bool join(const std::chrono::duration<Rep, Period>& timeout) {
+    return join(Clock::toTicks(timeout));
+  }
+
+  /**
+   * Task.hpp
+   *
+   * @brief Function that returns whether the task has returned from its
+   * taskFunction().
+   *
+   * FREERTOS_CPP_TASK_JOIN must be defined as 1 for this function to be
+   * available.
+   *
+   * @retval true The task has finished.
+   * @retval false Otherwise.
+   */
+  inline bool isFinished() const {
+    taskENTER_CRITICAL();
+    const bool result = finished;
+    taskEXIT_CRITICAL();
+    return result;
+  }
+#endif /* FREERTOS_CPP_TASK_JOIN */
+
 #if (INCLUDE_xTaskGetIdleTaskHandle == 1)
   /**
    * Task.hpp
@@ -939,6 +1250,112 @@ class TaskBase {
                                       NULL) == pdPASS);
   }
 
+  /**
+   * Task.hpp
+   *
+   * @brief Function that sends the same notification to several tasks with
+   * one reschedule, by calling <tt>BaseType_t xTaskNotifyIndexed( TaskHandle_t
+   * xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction
+   * eAction )</tt> for each task with the scheduler suspended.
+   *
+   * @see <https://www.freertos.org/xTaskNotify.html>
+   *
+   * Calling notify() once per task can switch to each woken task in turn
+   * before the next one is notified.  notifyAll() suspends the scheduler, so
+   * every task is notified first and the highest priority task that was woken
+   * runs once the scheduler is resumed.
+   *
+   * @param tasks Pointer to the first element of an array of pointers to the
+   * tasks to notify.
+   * @param count The number of tasks in the array.
+   * @param action How the notification value of each task is updated, as for
+   * notify().
+   * @param value Data that is sent with each notification.
+   * @param index The index within each task's array of notification values to
+   * which the notification is sent.
+   * @return size_t The number of tasks that were notified.  Only a
+   * SetValueWithoutOverwrite notification can fail.
+   *
+   * <b>Example Usage</b>
+   * @include Task/notifyAll.cpp
+   */
+  static size_t notifyAll(const TaskBase* const* tasks, const size_t count,
+                          const NotifyAction action,
+                          const NotificationBits value = 0,
+                          const UBaseType_t index = 0) {
+    size_t notified = 0;
+    vTaskSuspendAll();
+    for (size_t i = 0; i < count; i++) {
+      if (tasks[i]->notify(action, value, index)) {
+        notified++;
+      }
+    }
+    xTaskResumeAll();
+    return notified;
+  }
+
+  /**
+   * Task.hpp
+   *
+   * @brief Function that sends the same notification to several tasks from an
+   * interrupt service routine by calling <tt>BaseType_t
+   * xTaskNotifyIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t
+   * uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t
+   * *pxHigherPriorityTaskWoken )</tt> for each task.
+   *
+   * @see <https://www.freertos.org/xTaskNotifyFromISR.html>
+   *
+   * The tasks are notified inside one interrupt mask, and
+   * higherPriorityTaskWoken is set once for all of them, so a single context
+   * switch is requested when the interrupt exits.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if any
+   * of the notified tasks was unblocked and has a priority higher than the
+   * currently running task.
+   * @param tasks Pointer to the first element of an array of pointers to the
+   * tasks to notify.
+   * @param count The number of tasks in the array.
+   * @param action How the notification value of each task is updated, as for
+   * notify().
+   * @param value Data that is sent with each notification.
+   * @param index The index within each task's array of notification values to
+   * which the notification is sent.
+   * @return size_t The number of tasks that were notified.
+   */
+  static size_t notifyAllFromISR(bool& higherPriorityTaskWoken,
+                                 const TaskBase* const* tasks,
+                                 const size_t count, const NotifyAction action,
+                                 const NotificationBits value = 0,
+                                 const UBaseType_t index = 0) {
+    size_t notified = 0;
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    for (size_t i = 0; i < count; i++) {
+      if (tasks[i]->notifyFromISR(higherPriorityTaskWoken, action, value,
+                                  index)) {
+        notified++;
+      }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return notified;
+  }
+
+  /**
+   * Task.hpp
+   *
+   * @brief Function that sends the same notification to several tasks from an
+   * interrupt service routine.
+   *
+   * @overload
+   */
+  static size_t notifyAllFromISR(const TaskBase* const* tasks,
+                                 const size_t count, const NotifyAction action,
+                                 const NotificationBits value = 0,
+                                 const UBaseType_t index = 0) {
+    bool higherPriorityTaskWoken = false;
+    return notifyAllFromISR(higherPriorityTaskWoken, tasks, count, action,
+                            value, index);
+  }
+
   /**
    * Task.hpp
    *
@@ -1034,6 +1451,21 @@ class TaskBase {
     return std::make_pair(result, NotificationBits(pulNotificationValue));
   }
 
+  /**
+   * Task.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline static std::pair<bool, NotificationBits> notifyWait(
+      const std::chrono::duration<Rep, Period>& timeout,
+      const NotificationBits bitsToClearOnEntry = 0,
+      const NotificationBits bitsToClearOnExit = 0,
+      const UBaseType_t index = 0) {
+    return notifyWait(Clock::toTicks(timeout), bitsToClearOnEntry,
+                      bitsToClearOnExit, index);
+  }
+
   /**
    * Task.hpp
    *
@@ -1116,14 +1548,6 @@ class TaskBase {
 #endif /* configUSE_TASK_NOTIFICATIONS */
 
  protected:
-  /**
-   * Task.hpp
-   *
-   * @brief Abstraction function that acts as the entry point of the task for
-   * the user.
-   */
-  virtual void taskFunction() = 0;
-
 #if (INCLUDE_vTaskDelay == 1)
   /**
    * Task.hpp
@@ -1162,9 +1586,21 @@ class TaskBase {
   inline static void delay(const TickType_t ticksToDelay = 0) {
     vTaskDelay(ticksToDelay);
   }
+
+  /**
+   * Task.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline static void delay(
+      const std::chrono::duration<Rep, Period>& delayTime) {
+    delay(Clock::toTicks(delayTime));
+  }
 #endif /* INCLUDE_vTaskDelay */
 
 #if (INCLUDE_xTaskDelayUntil == 1)
+#if (FREERTOS_CPP_COMPACT != 1)
   /**
    * Task.hpp
    *
@@ -1208,6 +1644,59 @@ class TaskBase {
   inline bool delayUntil(const TickType_t timeIncrement = 0) {
     return (xTaskDelayUntil(&previousWakeTime, timeIncrement) == pdTRUE);
   }
+
+  /**
+   * Task.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool delayUntil(
+      const std::chrono::duration<Rep, Period>& timeIncrement) {
+    return delayUntil(Clock::toTicks(timeIncrement));
+  }
+#endif /* FREERTOS_CPP_COMPACT */
+
+  /**
+   * Task.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTaskDelayUntil( TickType_t
+   * *pxPreviousWakeTime, const TickType_t xTimeIncrement )</tt> with a wake
+   * time held by the caller.
+   *
+   * @see <https://www.freertos.org/xtaskdelayuntiltask-control.html>
+   *
+   * This is the only version of delayUntil() when FREERTOS_CPP_COMPACT is 1,
+   * as the task object then does not store a wake time.
+   *
+   * @param previousWakeTime The time at which the task was last unblocked.  It
+   * must be set to FreeRTOS::Kernel::getTickCount() before the first call, and
+   * is updated by every call.
+   * @param timeIncrement The cycle time period. The task will be unblocked at
+   * time (previousWakeTime + timeIncrement).
+   * @return true If the task way delayed.
+   * @return false Otherwise.  A task will not be delayed if the next expected
+   * wake time is in the past.
+   *
+   * <b>Example Usage</b>
+   * @include Task/delayUntilWakeTime.cpp
+   */
+  inline static bool delayUntil(TickType_t& previousWakeTime,
+                                const TickType_t timeIncrement) {
+    return (xTaskDelayUntil(&previousWakeTime, timeIncrement) == pdTRUE);
+  }
+
+  /**
+   * Task.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline static bool delayUntil(
+      TickType_t& previousWakeTime,
+      const std::chrono::duration<Rep, Period>& timeIncrement) {
+    return delayUntil(previousWakeTime, Clock::toTicks(timeIncrement));
+  }
 #endif /* INCLUDE_xTaskDelayUntil */
 
   /**
@@ -1301,6 +1790,18 @@ class TaskBase {
         ulTaskNotifyTakeIndexed(index, clearCountOnExit, ticksToWait));
   }
 
+  /**
+   * Task.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline static NotificationBits notifyTake(
+      const std::chrono::duration<Rep, Period>& timeout,
+      const bool clearCountOnExit = true, const UBaseType_t index = 0) {
+    return notifyTake(Clock::toTicks(timeout), clearCountOnExit, index);
+  }
+
  private:
   /**
    * @brief Construct a new TaskBase object.  This default constructor is
@@ -1313,6 +1814,51 @@ class TaskBase {
   TaskBase(TaskBase&&) noexcept = default;
   TaskBase& operator=(TaskBase&&) noexcept = default;
 
+  /**
+   * Task.hpp
+   *
+   * @brief Function that is called by the entry point of every task before the
+   * user implemented taskFunction().  It initializes the previous wake time of
+   * the task unless FREERTOS_CPP_COMPACT is 1.
+   */
+  inline void beginTask() {
+#if (FREERTOS_CPP_COMPACT != 1)
+    previousWakeTime = FreeRTOS::Kernel::getTickCount();
+#endif /* FREERTOS_CPP_COMPACT */
+  }
+
+  /**
+   * Task.hpp
+   *
+   * @brief Function that is called by the entry point of every task when the
+   * user implemented taskFunction() returns.
+   *
+   * A FreeRTOS task must never return from its entry point.  When join() is
+   * enabled the task that is waiting for this task is notified, then the task
+   * suspends itself until its object is destroyed and the destructor deletes
+   * it.
+   */
+  inline void endTask() {
+#if (FREERTOS_CPP_TASK_JOIN == 1)
+    taskENTER_CRITICAL();
+    finished = true;
+    const TaskHandle_t waiting = joiner;
+    taskEXIT_CRITICAL();
+
+    if (waiting != NULL) {
+      xTaskNotifyGiveIndexed(waiting, FREERTOS_CPP_TASK_JOIN_INDEX);
+    }
+#endif /* FREERTOS_CPP_TASK_JOIN */
+
+    for (;;) {
+#if (INCLUDE_vTaskSuspend == 1)
+      vTaskSuspend(NULL);
+#else
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#endif /* INCLUDE_vTaskSuspend */
+    }
+  }
+
   /**
    * Task.hpp
    *
@@ -1339,7 +1885,13 @@ class TaskBase {
    * @include Task/task.cpp
    */
   ~TaskBase() {
-#if (INCLUDE_vTaskDelete == 1)
+#if (FREERTOS_CPP_STACK_PROFILER == 1)
+    if (handle != NULL) {
+      StackRegistry::remove(handle);
+    }
+#endif /* FREERTOS_CPP_STACK_PROFILER */
+
+#if (INCLUDE_vTaskDelete == 1)
 
     if (handle != NULL) {
       vTaskDelete(handle);
@@ -1353,10 +1905,24 @@ class TaskBase {
    */
   TaskHandle_t handle = NULL;
 
+#if (FREERTOS_CPP_COMPACT != 1)
   /**
    * @brief Variable that holds the time at which the task was last unblocked.
    */
   TickType_t previousWakeTime = 0;
+#endif /* FREERTOS_CPP_COMPACT */
+
+#if (FREERTOS_CPP_TASK_JOIN == 1)
+  /**
+   * @brief Handle of the task waiting in join(), or NULL.
+   */
+  TaskHandle_t joiner = NULL;
+
+  /**
+   * @brief Variable that is set when the task returns from taskFunction().
+   */
+  bool finished = false;
+#endif /* FREERTOS_CPP_TASK_JOIN */
 };
 
 #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
@@ -1392,7 +1958,11 @@ class Task : public TaskBase {
    * memory.
    */
   bool isValid() const {
+#if (FREERTOS_CPP_COMPACT == 1)
+    return (handle != NULL);
+#else
     return taskCreatedSuccessfully;
+#endif /* FREERTOS_CPP_COMPACT */
   }
 
  protected:
@@ -1412,8 +1982,8 @@ class Task : public TaskBase {
    *
    * @note When calling <tt>xTaskCreate</tt> the constructor passes the
    * <tt>this</tt> pointer as the task function argument. This pointer is used
-   * so that the interface function callTaskFunction() can invoke taskEntry()
-   * for this instance of the class.
+   * so that the static function taskEntry() can invoke taskFunction() for this
+   * instance of the class.
    *
    * @param priority The priority at which the created task will execute.
    * Priorities are asserted to be less than configMAX_PRIORITIES. If
@@ -1438,17 +2008,92 @@ class Task : public TaskBase {
       const UBaseType_t priority = tskIDLE_PRIORITY,
       const configSTACK_DEPTH_TYPE stackDepth = configMINIMAL_STACK_SIZE,
       const char* name = "") {
-    taskCreatedSuccessfully = (xTaskCreate(callTaskFunction, name, stackDepth,
-                                           this, priority, &handle) == pdPASS);
+#if (FREERTOS_CPP_COMPACT == 1)
+    xTaskCreate(taskEntry, name, stackDepth, this, priority, &handle);
+#else
+    taskCreatedSuccessfully = (xTaskCreate(taskEntry, name, stackDepth, this,
+                                           priority, &handle) == pdPASS);
+#endif /* FREERTOS_CPP_COMPACT */
+#if (FREERTOS_CPP_STACK_PROFILER == 1)
+    if (isValid()) {
+      StackRegistry::add(handle, stackDepth);
+    }
+#endif /* FREERTOS_CPP_STACK_PROFILER */
   }
 
+#if (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1)
+  /**
+   * Task.hpp
+   *
+   * @brief Construct a new Task object by calling <tt>BaseType_t
+   * xTaskCreateAffinitySet( TaskFunction_t pxTaskCode, const char * const
+   * pcName, const configSTACK_DEPTH_TYPE uxStackDepth, void * const
+   * pvParameters, UBaseType_t uxPriority, UBaseType_t uxCoreAffinityMask,
+   * TaskHandle_t * const pxCreatedTask )</tt>
+   *
+   * @see <https://www.freertos.org/symmetric-multiprocessing-introduction.html>
+   *
+   * configNUMBER_OF_CORES must be greater than 1 and configUSE_CORE_AFFINITY
+   * must be defined as 1 for this constructor to be available.
+   *
+   * @param priority The priority at which the created task will execute.
+   * @param stackDepth The number of words (not bytes!) to allocate for use as
+   * the task's stack.
+   * @param name A descriptive name for the task.
+   * @param coreAffinityMask A bitwise value that indicates the cores on which
+   * the task can run.  Cores are numbered from 0 to configNUMBER_OF_CORES - 1.
+   * tskNO_AFFINITY allows the task to run on any core.
+   *
+   * <b>Example Usage</b>
+   * @include Task/coreAffinity.cpp
+   */
+  Task(const UBaseType_t priority, const configSTACK_DEPTH_TYPE stackDepth,
+       const char* name, const UBaseType_t coreAffinityMask) {
+#if (FREERTOS_CPP_COMPACT == 1)
+    xTaskCreateAffinitySet(taskEntry, name, stackDepth, this, priority,
+                           coreAffinityMask, &handle);
+#else
+    taskCreatedSuccessfully =
+        (xTaskCreateAffinitySet(taskEntry, name, stackDepth, this, priority,
+                                coreAffinityMask, &handle) == pdPASS);
+#endif /* FREERTOS_CPP_COMPACT */
+#if (FREERTOS_CPP_STACK_PROFILER == 1)
+    if (isValid()) {
+      StackRegistry::add(handle, stackDepth);
+    }
+#endif /* FREERTOS_CPP_STACK_PROFILER */
+  }
+#endif /* (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1) */
+
   ~Task() = default;
 
   Task(Task&&) noexcept = default;
   Task& operator=(Task&&) noexcept = default;
 
+  /**
+   * Task.hpp
+   *
+   * @brief Abstraction function that acts as the entry point of the task for
+   * the user.
+   */
+  virtual void taskFunction() = 0;
+
  private:
+  /**
+   * @brief Function that is passed to the kernel as the entry point of the
+   * task.  It calls taskFunction() on the instance passed as the task
+   * parameter.
+   */
+  static void taskEntry(void* task) {
+    Task* self = static_cast<Task*>(task);
+    self->beginTask();
+    self->taskFunction();
+    self->endTask();
+  }
+
+#if (FREERTOS_CPP_COMPACT != 1)
   bool taskCreatedSuccessfully = false;
+#endif /* FREERTOS_CPP_COMPACT */
 };
 
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
@@ -1477,13 +2122,85 @@ class Task : public TaskBase {
  *
  * @tparam N The number of indexes in the array of <tt>StackType_t</tt> used to
  * store the stack for this task.
+ * @tparam Region The memory region that holds the TCB and the stack.  By
+ * default they are part of the object instance.  A region defined with
+ * FREERTOS_CPP_DEFINE_REGION() places them in a linker section, such as tightly
+ * coupled RAM, independently of where the object itself is placed.
  */
-template <UBaseType_t N = configMINIMAL_STACK_SIZE>
+template <UBaseType_t N = configMINIMAL_STACK_SIZE,
+          class Region = DefaultRegion>
 class StaticTask : public TaskBase {
  public:
   StaticTask(const StaticTask&) = delete;
   StaticTask& operator=(const StaticTask&) = delete;
 
+  /**
+   * Task.hpp
+   *
+   * @brief Function that calls <tt>TaskHandle_t xTaskCreateStatic(
+   * TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t
+   * ulStackDepth, void * const pvParameters, UBaseType_t uxPriority,
+   * StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer
+   * )</tt> to create a task that was constructed with FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/xTaskCreateStatic.html>
+   *
+   * @param priority The priority at which the created task will execute.
+   * @param name A descriptive name for the task.
+   * @retval true If the task was created.
+   * @retval false Otherwise.
+   *
+   * <b>Example Usage</b>
+   * @include DeferCreate/deferCreate.cpp
+   */
+  bool create(const UBaseType_t priority = tskIDLE_PRIORITY,
+              const char* name = "") {
+    configASSERT(handle == NULL);
+    handle = xTaskCreateStatic(taskEntry, name, N, this, priority,
+                               stack.get(), taskBuffer.get());
+#if (FREERTOS_CPP_STACK_PROFILER == 1)
+    if (handle != NULL) {
+      StackRegistry::add(handle, N);
+    }
+#endif /* FREERTOS_CPP_STACK_PROFILER */
+    return (handle != NULL);
+  }
+
+#if (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1)
+  /**
+   * Task.hpp
+   *
+   * @brief Function that calls <tt>TaskHandle_t xTaskCreateStaticAffinitySet(
+   * TaskFunction_t pxTaskCode, const char * const pcName, const
+   * configSTACK_DEPTH_TYPE uxStackDepth, void * const pvParameters,
+   * UBaseType_t uxPriority, StackType_t * const puxStackBuffer, StaticTask_t *
+   * const pxTaskBuffer, UBaseType_t uxCoreAffinityMask )</tt> to create a task
+   * that was constructed with FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/symmetric-multiprocessing-introduction.html>
+   *
+   * @param priority The priority at which the created task will execute.
+   * @param name A descriptive name for the task.
+   * @param coreAffinityMask A bitwise value that indicates the cores on which
+   * the task can run.
+   * @retval true If the task was created.
+   * @retval false Otherwise.
+   */
+  bool create(const UBaseType_t priority, const char* name,
+              const UBaseType_t coreAffinityMask) {
+    configASSERT(handle == NULL);
+    handle = xTaskCreateStaticAffinitySet(taskEntry, name, N, this, priority,
+                                          stack.get(), taskBuffer.get(),
+                                          coreAffinityMask);
+#if (FREERTOS_CPP_STACK_PROFILER == 1)
+    if (handle != NULL) {
+      StackRegistry::add(handle, N);
+    }
+#endif /* FREERTOS_CPP_STACK_PROFILER */
+    return (handle != NULL);
+  }
+#endif /* (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1) */
+
  protected:
   /**
    * Task.hpp
@@ -1498,8 +2215,8 @@ class StaticTask : public TaskBase {
    *
    * @note When calling <tt>xTaskCreateStatic</tt> the constructor passes the
    * <tt>this</tt> pointer as the task function argument. This pointer is used
-   * so that the interface function callTaskFunction() can invoke taskEntry()
-   * for this instance of the class.
+   * so that the static function taskEntry() can invoke taskFunction() for this
+   * instance of the class.
    *
    * @param priority The priority at which the created task will execute.
    * Priorities are asserted to be less than configMAX_PRIORITIES. If
@@ -1515,25 +2232,411 @@ class StaticTask : public TaskBase {
    */
   explicit StaticTask(const UBaseType_t priority = tskIDLE_PRIORITY,
                       const char* name = "") {
-    handle = xTaskCreateStatic(callTaskFunction, name, N, this, priority, stack,
-                               &taskBuffer);
+    create(priority, name);
+  }
+
+#if (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1)
+  /**
+   * Task.hpp
+   *
+   * @brief Construct a new Task object by calling <tt>TaskHandle_t
+   * xTaskCreateStaticAffinitySet( TaskFunction_t pxTaskCode, const char *
+   * const pcName, const configSTACK_DEPTH_TYPE uxStackDepth, void * const
+   * pvParameters, UBaseType_t uxPriority, StackType_t * const puxStackBuffer,
+   * StaticTask_t * const pxTaskBuffer, UBaseType_t uxCoreAffinityMask )</tt>
+   *
+   * @see <https://www.freertos.org/symmetric-multiprocessing-introduction.html>
+   *
+   * configNUMBER_OF_CORES must be greater than 1 and configUSE_CORE_AFFINITY
+   * must be defined as 1 for this constructor to be available.
+   *
+   * @param priority The priority at which the created task will execute.
+   * @param name A descriptive name for the task.
+   * @param coreAffinityMask A bitwise value that indicates the cores on which
+   * the task can run.  Cores are numbered from 0 to configNUMBER_OF_CORES - 1.
+   * tskNO_AFFINITY allows the task to run on any core.
+   *
+   * <b>Example Usage</b>
+   * @include Task/coreAffinity.cpp
+   */
+  StaticTask(const UBaseType_t priority, const char* name,
+             const UBaseType_t coreAffinityMask) {
+    create(priority, name, coreAffinityMask);
   }
+#endif /* (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1) */
+
+  /**
+   * Task.hpp
+   *
+   * @brief Construct a new Task object without creating the task.
+   *
+   * This constructor is constexpr, so a global object of a derived class with
+   * a constexpr constructor is constant initialized.  create() must be called
+   * to create the task.
+   *
+   * <b>Example Usage</b>
+   * @include DeferCreate/deferCreate.cpp
+   */
+  constexpr explicit StaticTask(DeferCreate)
+      : taskBuffer(deferCreate), stack(deferCreate) {}
   ~StaticTask() = default;
 
   StaticTask(StaticTask&&) noexcept = default;
   StaticTask& operator=(StaticTask&&) noexcept = default;
 
+  /**
+   * Task.hpp
+   *
+   * @brief Abstraction function that acts as the entry point of the task for
+   * the user.
+   */
+  virtual void taskFunction() = 0;
+
  private:
+  /**
+   * @brief Function that is passed to the kernel as the entry point of the
+   * task.  It calls taskFunction() on the instance passed as the task
+   * parameter.
+   */
+  static void taskEntry(void* task) {
+    StaticTask* self = static_cast<StaticTask*>(task);
+    self->beginTask();
+    self->taskFunction();
+    self->endTask();
+  }
+
+  RegionStorage<StaticTask_t, 1, Region> taskBuffer;
+  RegionStorage<StackType_t, N, Region, FREERTOS_CPP_STACK_ALIGNMENT> stack;
+};
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+/**
+ * FunctionHolder Task.hpp <FreeRTOS/Task.hpp>
+ *
+ * @brief Class that holds the callable object of a FreeRTOS::FunctionTask or
+ * FreeRTOS::StaticFunctionTask.  It is a separate base class so that the
+ * callable is constructed before the task that calls it is created.
+ *
+ * @note This class is not intended to be instantiated by the user.
+ *
+ * @tparam Function Type of the callable object.
+ */
+template <class Function>
+class FunctionHolder {
+ protected:
+  explicit FunctionHolder(Function function) : function(std::move(function)) {}
+  ~FunctionHolder() = default;
+
+  FunctionHolder(const FunctionHolder&) = delete;
+  FunctionHolder& operator=(const FunctionHolder&) = delete;
+
+  Function function;
+};
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+
+/**
+ * CrtpTask Task.hpp <FreeRTOS/Task.hpp>
+ *
+ * @brief Class that encapsulates the functionality of a FreeRTOS task without
+ * using virtual functions.
+ *
+ * This class behaves like FreeRTOS::Task, but the task entry point calls
+ * Derived::taskFunction() directly instead of through a virtual function.  An
+ * object of a class derived from CrtpTask therefore has no vtable pointer, and
+ * no vtable is emitted for the class.
+ *
+ * @note This class is not intended to be instantiated by the user.  The user
+ * should create a class Derived that derives from CrtpTask<Derived> and
+ * implements a public taskFunction().
+ *
+ * @tparam Derived The class that derives from this class.
+ *
+ * <b>Example Usage</b>
+ * @include Task/crtpTask.cpp
+ */
+template <class Derived>
+class CrtpTask : public TaskBase {
+ public:
+  CrtpTask(const CrtpTask&) = delete;
+  CrtpTask& operator=(const CrtpTask&) = delete;
+
+  /**
+   * @brief Function that checks the return value of the call to xTaskCreate in
+   * the constructor.  This function should be called to ensure the task was
+   * created successfully before starting the scheduler.
+   *
+   * @return true If the task was created successfully.
+   * @return false If the task was not created successfully due to insufficient
+   * memory.
+   */
+  bool isValid() const {
+#if (FREERTOS_CPP_COMPACT == 1)
+    return (handle != NULL);
+#else
+    return taskCreatedSuccessfully;
+#endif /* FREERTOS_CPP_COMPACT */
+  }
+
+ protected:
+  /**
+   * Task.hpp
+   *
+   * @brief Construct a new CrtpTask object by calling <tt>BaseType_t
+   * xTaskCreate( TaskFunction_t pvTaskCode, const char * const pcName,
+   * configSTACK_DEPTH_TYPE usStackDepth, void *pvParameters, BaseType_t
+   * uxPriority, TaskHandle_t *pxCreatedTask )</tt>
+   *
+   * @see <https://www.freertos.org/a00125.html>
+   *
+   * The parameters are the same as those of FreeRTOS::Task().
+   *
+   * @param priority The priority at which the created task will execute.
+   * @param stackDepth The number of words (not bytes!) to allocate for use as
+   * the task's stack.
+   * @param name A descriptive name for the task.
+   */
+  explicit CrtpTask(
+      const UBaseType_t priority = tskIDLE_PRIORITY,
+      const configSTACK_DEPTH_TYPE stackDepth = configMINIMAL_STACK_SIZE,
+      const char* name = "") {
+#if (FREERTOS_CPP_COMPACT == 1)
+    xTaskCreate(taskEntry, name, stackDepth, this, priority, &handle);
+#else
+    taskCreatedSuccessfully = (xTaskCreate(taskEntry, name, stackDepth, this,
+                                           priority, &handle) == pdPASS);
+#endif /* FREERTOS_CPP_COMPACT */
+#if (FREERTOS_CPP_STACK_PROFILER == 1)
+    if (isValid()) {
+      StackRegistry::add(handle, stackDepth);
+    }
+#endif /* FREERTOS_CPP_STACK_PROFILER */
+  }
+
+  ~CrtpTask() = default;
+
+  CrtpTask(CrtpTask&&) noexcept = default;
+  CrtpTask& operator=(CrtpTask&&) noexcept = default;
+
+ private:
+  static void taskEntry(void* task) {
+    CrtpTask* self = static_cast<CrtpTask*>(task);
+    self->beginTask();
+    static_cast<Derived*>(self)->taskFunction();
+    self->endTask();
+  }
+
+#if (FREERTOS_CPP_COMPACT != 1)
+  bool taskCreatedSuccessfully = false;
+#endif /* FREERTOS_CPP_COMPACT */
+};
+
+/**
+ * FunctionTask Task.hpp <FreeRTOS/Task.hpp>
+ *
+ * @brief Class that runs a callable object, such as a lambda, as a FreeRTOS
+ * task without using virtual functions.
+ *
+ * The callable is called once when the task starts.  It is called with a
+ * reference to the FunctionTask if it accepts one, so that it can use
+ * delay(), delayUntil() and notifyTake(), otherwise it is called with no
+ * arguments.
+ *
+ * @tparam Function Type of the callable object.
+ *
+ * <b>Example Usage</b>
+ * @include Task/functionTask.cpp
+ */
+template <class Function>
+class FunctionTask : private FunctionHolder<Function>,
+                     public CrtpTask<FunctionTask<Function>> {
+ public:
+  /**
+   * Task.hpp
+   *
+   * @brief Construct a new FunctionTask object that runs function.
+   *
+   * @param function The callable object that is the body of the task.
+   * @param priority The priority at which the created task will execute.
+   * @param stackDepth The number of words (not bytes!) to allocate for use as
+   * the task's stack.
+   * @param name A descriptive name for the task.
+   */
+  explicit FunctionTask(
+      Function function, const UBaseType_t priority = tskIDLE_PRIORITY,
+      const configSTACK_DEPTH_TYPE stackDepth = configMINIMAL_STACK_SIZE,
+      const char* name = "")
+      : FunctionHolder<Function>(std::move(function)),
+        CrtpTask<FunctionTask>(priority, stackDepth, name) {}
+  ~FunctionTask() = default;
+
+  FunctionTask(const FunctionTask&) = delete;
+  FunctionTask& operator=(const FunctionTask&) = delete;
+
+#if (INCLUDE_vTaskDelay == 1)
+  using TaskBase::delay;
+#endif /* INCLUDE_vTaskDelay */
+#if (INCLUDE_xTaskDelayUntil == 1)
+  using TaskBase::delayUntil;
+#endif /* INCLUDE_xTaskDelayUntil */
+  using TaskBase::notifyTake;
+
+  inline void taskFunction() {
+    if constexpr (std::is_invocable_v<Function&, FunctionTask&>) {
+      this->function(*this);
+    } else {
+      this->function();
+    }
+  }
+};
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+/**
+ * StaticCrtpTask Task.hpp <FreeRTOS/Task.hpp>
+ *
+ * @brief Class that encapsulates the functionality of a FreeRTOS task with
+ * statically allocated memory, without using virtual functions.
+ *
+ * This class behaves like FreeRTOS::StaticTask, but the task entry point calls
+ * Derived::taskFunction() directly instead of through a virtual function.  An
+ * object of a class derived from StaticCrtpTask therefore has no vtable
+ * pointer, and no vtable is emitted for the class.
+ *
+ * @note This class is not intended to be instantiated by the user.  The user
+ * should create a class Derived that derives from StaticCrtpTask<Derived, N>
+ * and implements a public taskFunction().
+ *
+ * @warning This class contains the task's data structures (TCB) and the array
+ * used to store the task's stack, so any instace of this class or class derived
+ * from this class must be persistent (not declared on the stack of another
+ * function).
+ *
+ * @tparam Derived The class that derives from this class.
+ * @tparam N The number of indexes in the array of <tt>StackType_t</tt> used to
+ * store the stack for this task.
+ *
+ * <b>Example Usage</b>
+ * @include Task/crtpTask.cpp
+ */
+template <class Derived, UBaseType_t N = configMINIMAL_STACK_SIZE>
+class StaticCrtpTask : public TaskBase {
+ public:
+  StaticCrtpTask(const StaticCrtpTask&) = delete;
+  StaticCrtpTask& operator=(const StaticCrtpTask&) = delete;
+
+ protected:
+  /**
+   * Task.hpp
+   *
+   * @brief Construct a new StaticCrtpTask object by calling <tt>TaskHandle_t
+   * xTaskCreateStatic( TaskFunction_t pxTaskCode, const char * const pcName,
+   * const uint32_t ulStackDepth, void * const pvParameters, UBaseType_t
+   * uxPriority, StackType_t * const puxStackBuffer, StaticTask_t * const
+   * pxTaskBuffer )</tt>
+   *
+   * @see <https://www.freertos.org/xTaskCreateStatic.html>
+   *
+   * The parameters are the same as those of FreeRTOS::StaticTask().
+   *
+   * @param priority The priority at which the created task will execute.
+   * @param name A descriptive name for the task.
+   */
+  explicit StaticCrtpTask(const UBaseType_t priority = tskIDLE_PRIORITY,
+                          const char* name = "") {
+    handle = xTaskCreateStatic(taskEntry, name, N, this, priority, stack,
+                               &taskBuffer);
+#if (FREERTOS_CPP_STACK_PROFILER == 1)
+    if (handle != NULL) {
+      StackRegistry::add(handle, N);
+    }
+#endif /* FREERTOS_CPP_STACK_PROFILER */
+  }
+  ~StaticCrtpTask() = default;
+
+  StaticCrtpTask(StaticCrtpTask&&) noexcept = default;
+  StaticCrtpTask& operator=(StaticCrtpTask&&) noexcept = default;
+
+ private:
+  static void taskEntry(void* task) {
+    StaticCrtpTask* self = static_cast<StaticCrtpTask*>(task);
+    self->beginTask();
+    static_cast<Derived*>(self)->taskFunction();
+    self->endTask();
+  }
+
   StaticTask_t taskBuffer;
-  StackType_t stack[N];
+  alignas(FREERTOS_CPP_STACK_ALIGNMENT) StackType_t stack[N];
+};
+
+/**
+ * StaticFunctionTask Task.hpp <FreeRTOS/Task.hpp>
+ *
+ * @brief Class that runs a callable object, such as a lambda, as a FreeRTOS
+ * task with statically allocated memory, without using virtual functions.
+ *
+ * The callable is called once when the task starts.  It is called with a
+ * reference to the StaticFunctionTask if it accepts one, so that it can use
+ * delay(), delayUntil() and notifyTake(), otherwise it is called with no
+ * arguments.
+ *
+ * @warning This class contains the task's data structures (TCB) and the array
+ * used to store the task's stack, so it must be persistent (not declared on the
+ * stack of another function).
+ *
+ * @tparam Function Type of the callable object.
+ * @tparam N The number of indexes in the array of <tt>StackType_t</tt> used to
+ * store the stack for this task.
+ *
+ * <b>Example Usage</b>
+ * @include Task/functionTask.cpp
+ */
+template <class Function, UBaseType_t N = configMINIMAL_STACK_SIZE>
+class StaticFunctionTask
+    : private FunctionHolder<Function>,
+      public StaticCrtpTask<StaticFunctionTask<Function, N>, N> {
+ public:
+  /**
+   * Task.hpp
+   *
+   * @brief Construct a new StaticFunctionTask object that runs function.
+   *
+   * @param function The callable object that is the body of the task.
+   * @param priority The priority at which the created task will execute.
+   * @param name A descriptive name for the task.
+   */
+  explicit StaticFunctionTask(Function function,
+                              const UBaseType_t priority = tskIDLE_PRIORITY,
+                              const char* name = "")
+      : FunctionHolder<Function>(std::move(function)),
+        StaticCrtpTask<StaticFunctionTask, N>(priority, name) {}
+  ~StaticFunctionTask() = default;
+
+  StaticFunctionTask(const StaticFunctionTask&) = delete;
+  StaticFunctionTask& operator=(const StaticFunctionTask&) = delete;
+
+#if (INCLUDE_vTaskDelay == 1)
+  using TaskBase::delay;
+#endif /* INCLUDE_vTaskDelay */
+#if (INCLUDE_xTaskDelayUntil == 1)
+  using TaskBase::delayUntil;
+#endif /* INCLUDE_xTaskDelayUntil */
+  using TaskBase::notifyTake;
+
+  inline void taskFunction() {
+    if constexpr (std::is_invocable_v<Function&, StaticFunctionTask&>) {
+      this->function(*this);
+    } else {
+      this->function();
+    }
+  }
 };
 
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
 }  // namespace FreeRTOS
 
-inline void callTaskFunction(void* task) {
-  static_cast<FreeRTOS::TaskBase*>(task)->taskEntry();
-}
-
 #endif  // FREERTOS_TASK_HPP
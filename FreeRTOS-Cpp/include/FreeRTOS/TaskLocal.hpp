@@ -0,0 +1,169 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_TASKLOCAL_HPP
+#define FREERTOS_TASKLOCAL_HPP
+
+#include <FreeRTOS/Task.hpp>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0)
+
+namespace FreeRTOS {
+
+/**
+ * @class TaskLocal TaskLocal.hpp <FreeRTOS/TaskLocal.hpp>
+ *
+ * @brief Class that gives typed access to one of the thread local storage
+ * pointers of a task.
+ *
+ * Each task has configNUM_THREAD_LOCAL_STORAGE_POINTERS pointers that the
+ * kernel stores in its TCB.  TaskLocal<T, Index> stores a pointer to a T in
+ * the pointer at index Index, so a task can find its own context in constant
+ * time and without locking, for example from code that is shared by several
+ * tasks.
+ *
+ * TaskLocal holds no state.  Objects can be declared wherever it is
+ * convenient, and all objects with the same Index refer to the same pointer.
+ *
+ * @warning The slot at index Index must not be used for any other purpose.
+ * Give every TaskLocal type a different Index, for example by listing them in
+ * an enumeration.
+ *
+ * @tparam T Type of the object that the pointer refers to.
+ * @tparam Index The index of the thread local storage pointer.
+ *
+ * <b>Example Usage</b>
+ * @include TaskLocal/taskLocal.cpp
+ */
+template <class T, BaseType_t Index>
+class TaskLocal {
+  static_assert((Index >= 0) &&
+                    (Index < configNUM_THREAD_LOCAL_STORAGE_POINTERS),
+                "Index must be at least 0 and less than "
+                "configNUM_THREAD_LOCAL_STORAGE_POINTERS.");
+
+ public:
+  /**
+   * TaskLocal.hpp
+   *
+   * @brief Function that calls <tt>void *pvTaskGetThreadLocalStoragePointer(
+   * TaskHandle_t xTaskToQuery, BaseType_t xIndex )</tt> for the calling task.
+   *
+   * @see <https://www.freertos.org/thread-local-storage-pointers.html>
+   *
+   * @return T* The pointer stored by the calling task, or nullptr if it has
+   * not stored one.
+   */
+  inline static T* get() {
+    return static_cast<T*>(pvTaskGetThreadLocalStoragePointer(NULL, Index));
+  }
+
+  /**
+   * TaskLocal.hpp
+   *
+   * @brief Function that calls <tt>void *pvTaskGetThreadLocalStoragePointer(
+   * TaskHandle_t xTaskToQuery, BaseType_t xIndex )</tt>
+   *
+   * @see <https://www.freertos.org/thread-local-storage-pointers.html>
+   *
+   * @param task The task to query.
+   * @return T* The pointer stored for task, or nullptr if none has been
+   * stored.
+   */
+  inline static T* get(const TaskBase& task) {
+    return static_cast<T*>(
+        pvTaskGetThreadLocalStoragePointer(task.handle, Index));
+  }
+
+  /**
+   * TaskLocal.hpp
+   *
+   * @brief Function that calls <tt>void vTaskSetThreadLocalStoragePointer(
+   * TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue )</tt> for the
+   * calling task.
+   *
+   * @see <https://www.freertos.org/thread-local-storage-pointers.html>
+   *
+   * @param value The pointer to store.  The object it points to must remain
+   * valid for as long as the pointer is stored.
+   */
+  inline static void set(T* value) {
+    vTaskSetThreadLocalStoragePointer(NULL, Index, value);
+  }
+
+  /**
+   * TaskLocal.hpp
+   *
+   * @brief Function that calls <tt>void vTaskSetThreadLocalStoragePointer(
+   * TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue )</tt>
+   *
+   * @see <https://www.freertos.org/thread-local-storage-pointers.html>
+   *
+   * @param task The task for which the pointer is stored.
+   * @param value The pointer to store.  The object it points to must remain
+   * valid for as long as the pointer is stored.
+   */
+  inline static void set(const TaskBase& task, T* value) {
+    vTaskSetThreadLocalStoragePointer(task.handle, Index, value);
+  }
+
+  /**
+   * TaskLocal.hpp
+   *
+   * @brief Function that returns the pointer stored by the calling task.
+   * Equivalent to get().
+   *
+   * @return T* The pointer stored by the calling task.
+   */
+  inline T* operator->() const {
+    return get();
+  }
+
+  /**
+   * TaskLocal.hpp
+   *
+   * @brief Function that returns the object the calling task's pointer refers
+   * to.  The calling task must have stored a pointer.
+   *
+   * @return T& The object the pointer stored by the calling task refers to.
+   */
+  inline T& operator*() const {
+    T* const value = get();
+    configASSERT(value != nullptr);
+    return *value;
+  }
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 */
+
+#endif  // FREERTOS_TASKLOCAL_HPP
@@ -0,0 +1,283 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_TASKPOOL_HPP
+#define FREERTOS_TASKPOOL_HPP
+
+#include <FreeRTOS/Task.hpp>
+#include <cstddef>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1) && (INCLUDE_vTaskDelete == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class TaskPool TaskPool.hpp <FreeRTOS/TaskPool.hpp>
+ *
+ * @brief Class that creates short lived tasks in a fixed set of task control
+ * blocks and stacks, so that tasks can be started and finished on demand
+ * without the heap.
+ *
+ * spawn() creates a task with <tt>xTaskCreateStatic()</tt> in a slot of the
+ * pool.  When the function of the task returns, the task marks its slot as
+ * finished and blocks forever, instead of deleting itself.  A task that
+ * deletes itself is only removed from the kernel's lists by the idle task, so
+ * its memory could still be in use when the next task is created in it.  The
+ * finished task is instead deleted by the next call to spawn() that reuses
+ * its slot, or by reclaim().  Deleting a task other than the calling one
+ * releases it immediately, so the slot can be reused straight away and the
+ * idle task is never involved.
+ *
+ * spawn() looks at each slot at most once, so it takes constant time for a
+ * given pool, and it returns NULL when every slot holds a task that is still
+ * running.
+ *
+ * On SMP ports a finished task may still be running on another core for a
+ * moment, so spawn() waits for it to block before it deletes it.  That needs
+ * INCLUDE_eTaskGetState to be 1.
+ *
+ * configSUPPORT_STATIC_ALLOCATION and INCLUDE_vTaskDelete must both be defined
+ * as 1 for this class to be available.
+ *
+ * @warning This class contains the stacks of the tasks, so the user should
+ * create this object as a global object or with the static storage specifier
+ * so that the object instance is not on the stack.
+ *
+ * @tparam StackWords The stack depth of each task, in words.
+ * @tparam Count The number of tasks that can exist at the same time.
+ *
+ * <b>Example Usage</b>
+ * @include TaskPool/taskPool.cpp
+ */
+template <UBaseType_t StackWords, size_t Count>
+class TaskPool {
+  static_assert(Count > 0, "A TaskPool needs at least one slot.");
+#if (configNUMBER_OF_CORES > 1)
+  static_assert(INCLUDE_eTaskGetState == 1,
+                "TaskPool needs eTaskGetState() on SMP ports.");
+#endif /* configNUMBER_OF_CORES */
+
+ public:
+  /**
+   * @brief The function that a pooled task runs.  The task finishes when it
+   * returns.
+   */
+  using Function = void (*)(void* parameter);
+
+  TaskPool() = default;
+
+  /**
+   * TaskPool.hpp
+   *
+   * @brief Destroy the TaskPool object, deleting every task that is still in
+   * the pool.
+   */
+  ~TaskPool() {
+    for (Slot& slot : slots) {
+      if (slot.state != State::Free) {
+        vTaskDelete(slot.handle);
+      }
+    }
+  }
+
+  TaskPool(const TaskPool&) = delete;
+  TaskPool& operator=(const TaskPool&) = delete;
+
+  /**
+   * TaskPool.hpp
+   *
+   * @brief Function that creates a task in a free slot of the pool by calling
+   * <tt>TaskHandle_t xTaskCreateStatic( TaskFunction_t pxTaskCode, const char
+   * *const pcName, const uint32_t ulStackDepth, void *const pvParameters,
+   * UBaseType_t uxPriority, StackType_t *const puxStackBuffer, StaticTask_t
+   * *const pxTaskBuffer )</tt>
+   *
+   * @see <https://www.freertos.org/xTaskCreateStatic.html>
+   *
+   * This function must not be called from an interrupt or by a task of the
+   * pool.
+   *
+   * @param function The function the task runs.
+   * @param parameter The value passed to function.
+   * @param priority The priority at which the task executes.
+   * @param name A descriptive name for the task.
+   * @return TaskHandle_t The handle of the new task, or NULL if every slot
+   * holds a task that has not finished.
+   */
+  TaskHandle_t spawn(const Function function, void* parameter = NULL,
+                     const UBaseType_t priority = tskIDLE_PRIORITY + 1,
+                     const char* name = "Pooled") {
+    configASSERT(function != NULL);
+
+    Slot* slot = claim();
+    if (slot == NULL) {
+      return NULL;
+    }
+
+    slot->function = function;
+    slot->parameter = parameter;
+    slot->handle = xTaskCreateStatic(run, name, StackWords, slot, priority,
+                                     slot->stack, &slot->taskBuffer);
+    if (slot->handle == NULL) {
+      slot->state = State::Free;
+    }
+    return slot->handle;
+  }
+
+  /**
+   * TaskPool.hpp
+   *
+   * @brief Function that deletes every finished task, so that the pool holds
+   * no blocked tasks.  Slots are reclaimed by spawn() anyway, so calling this
+   * function is only needed to keep finished tasks out of task listings.
+   *
+   * This function must not be called from an interrupt or by a task of the
+   * pool.
+   *
+   * @return size_t The number of tasks that were deleted.
+   */
+  size_t reclaim() {
+    size_t reclaimed = 0;
+    for (Slot& slot : slots) {
+      taskENTER_CRITICAL();
+      const bool finished = (slot.state == State::Finished);
+      if (finished) {
+        slot.state = State::Claimed;
+      }
+      taskEXIT_CRITICAL();
+
+      if (finished) {
+        release(slot);
+        taskENTER_CRITICAL();
+        slot.state = State::Free;
+        taskEXIT_CRITICAL();
+        reclaimed++;
+      }
+    }
+    return reclaimed;
+  }
+
+  /**
+   * TaskPool.hpp
+   *
+   * @brief Function that returns the number of slots in which a task can be
+   * spawned.
+   *
+   * @return size_t The number of slots that are free or hold a finished task.
+   */
+  size_t available() const {
+    size_t count = 0;
+    taskENTER_CRITICAL();
+    for (const Slot& slot : slots) {
+      if ((slot.state == State::Free) || (slot.state == State::Finished)) {
+        count++;
+      }
+    }
+    taskEXIT_CRITICAL();
+    return count;
+  }
+
+ private:
+  enum class State : uint8_t { Free, Claimed, Running, Finished };
+
+  struct Slot {
+    StaticTask_t taskBuffer;
+    alignas(FREERTOS_CPP_STACK_ALIGNMENT) StackType_t stack[StackWords];
+    TaskHandle_t handle = NULL;
+    Function function = NULL;
+    void* parameter = NULL;
+    volatile State state = State::Free;
+  };
+
+  static void run(void* argument) {
+    Slot* const slot = static_cast<Slot*>(argument);
+    slot->function(slot->parameter);
+
+    taskENTER_CRITICAL();
+    slot->state = State::Finished;
+    taskEXIT_CRITICAL();
+
+    // Wait to be deleted by the task that reuses the slot.
+    for (;;) {
+      vTaskDelay(portMAX_DELAY);
+    }
+  }
+
+  // Waits for a finished task to stop running and deletes it.
+  static void release(Slot& slot) {
+#if (configNUMBER_OF_CORES > 1)
+    while (eTaskGetState(slot.handle) == eRunning) {
+      taskYIELD();
+    }
+#endif /* configNUMBER_OF_CORES */
+    vTaskDelete(slot.handle);
+    slot.handle = NULL;
+  }
+
+  // Prefers a free slot, so that finished tasks are only deleted when needed.
+  Slot* claim() {
+    Slot* free = NULL;
+    Slot* finished = NULL;
+
+    taskENTER_CRITICAL();
+    for (Slot& slot : slots) {
+      if (slot.state == State::Free) {
+        free = &slot;
+        break;
+      }
+      if ((finished == NULL) && (slot.state == State::Finished)) {
+        finished = &slot;
+      }
+    }
+    Slot* const slot = (free != NULL) ? free : finished;
+    if (slot != NULL) {
+      slot->state = State::Claimed;
+    }
+    taskEXIT_CRITICAL();
+
+    if ((slot != NULL) && (slot == finished)) {
+      release(*slot);
+    }
+    if (slot != NULL) {
+      // The new task can not finish before this store, as it does not exist
+      // yet.
+      slot->state = State::Running;
+    }
+    return slot;
+  }
+
+  Slot slots[Count];
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION && INCLUDE_vTaskDelete */
+
+#endif  // FREERTOS_TASKPOOL_HPP
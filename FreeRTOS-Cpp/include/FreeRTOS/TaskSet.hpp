@@ -0,0 +1,289 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_TASKSET_HPP
+#define FREERTOS_TASKSET_HPP
+
+#include <FreeRTOS/PeriodicTask.hpp>
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (INCLUDE_xTaskDelayUntil == 1) && (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class TaskTiming TaskSet.hpp <FreeRTOS/TaskSet.hpp>
+ *
+ * @brief Class that declares the timing of one periodic task of a
+ * FreeRTOS::TaskSet.  All times are in ticks.
+ *
+ * @tparam Period The time between the releases of the task.
+ * @tparam Budget The worst case execution time of one cycle of the task.
+ * @tparam Deadline The time after its release by which a cycle must finish.
+ * It defaults to the period.
+ */
+template <TickType_t Period, TickType_t Budget, TickType_t Deadline = Period>
+struct TaskTiming {
+  static_assert(Period > 0, "The period of a task must be greater than 0.");
+  static_assert((Budget > 0) && (Budget <= Deadline),
+                "The budget of a task must be greater than 0 and no longer "
+                "than its deadline.");
+  static_assert(Deadline <= Period,
+                "The deadline of a task must not be longer than its period.");
+
+  static constexpr TickType_t period = Period;
+  static constexpr TickType_t budget = Budget;
+  static constexpr TickType_t deadline = Deadline;
+};
+
+/**
+ * @class TaskSet TaskSet.hpp <FreeRTOS/TaskSet.hpp>
+ *
+ * @brief Class that checks at compile time that a set of periodic tasks meets
+ * all of its deadlines, and that assigns the priorities of the tasks.
+ *
+ * The priorities are assigned in deadline monotonic order, which for tasks
+ * whose deadlines equal their periods is rate monotonic order: the shorter
+ * the deadline, the higher the priority, and tasks with the same deadline are
+ * ordered by their position in the set.  Every task gets its own priority, so
+ * the set needs size consecutive priorities.
+ *
+ * isSchedulable() runs the exact response time analysis for fixed priority
+ * preemptive scheduling.  The worst case response time of a task is its
+ * budget plus the budgets of every release of a higher priority task that can
+ * preempt it, and the set is schedulable if every response time is within its
+ * deadline.  Use it in a static_assert so that a change to a period or budget
+ * that breaks the timing of the system fails the build.
+ *
+ * The analysis is only as good as the budgets.  Tasks derived from Task<Index>
+ * count every cycle that exceeds its budget, and isSchedulable() can be called
+ * again at run time with the execution times measured by
+ * FreeRTOS::PeriodicTask to check that the set still meets its deadlines.
+ *
+ * The analysis does not include the time spent in interrupts, in the kernel,
+ * or blocked on resources held by lower priority tasks.  Add those to the
+ * budgets.
+ *
+ * @tparam Timings The FreeRTOS::TaskTiming of each task in the set.
+ *
+ * <b>Example Usage</b>
+ * @include TaskSet/taskSet.cpp
+ */
+template <class... Timings>
+class TaskSet {
+  static_assert(sizeof...(Timings) > 0, "A task set must not be empty.");
+
+ public:
+  TaskSet() = delete;
+
+  /**
+   * @brief The number of tasks in the set.
+   */
+  static constexpr size_t size = sizeof...(Timings);
+
+  /**
+   * TaskSet.hpp
+   *
+   * @brief Function that returns the priority of a task relative to the
+   * lowest priority task of the set.
+   *
+   * @param index The position of the task in the set.
+   * @return UBaseType_t 0 for the task with the longest deadline, up to size
+   * - 1 for the task with the shortest deadline.
+   */
+  static constexpr UBaseType_t rank(const size_t index) {
+    UBaseType_t lower = 0;
+    for (size_t other = 0; other < size; other++) {
+      if ((other != index) && !isHigherPriority(other, index)) {
+        lower++;
+      }
+    }
+    return lower;
+  }
+
+  /**
+   * TaskSet.hpp
+   *
+   * @brief Function that returns the processor utilization of the set.
+   *
+   * @return uint32_t The sum of budget / period over all tasks, in parts per
+   * thousand.
+   */
+  static constexpr uint32_t utilization() {
+    uint64_t total = 0;
+    for (size_t index = 0; index < size; index++) {
+      total += (static_cast<uint64_t>(budgets[index]) * 1000) / periods[index];
+    }
+    return static_cast<uint32_t>(total);
+  }
+
+  /**
+   * TaskSet.hpp
+   *
+   * @brief Function that returns the worst case response time of a task.
+   *
+   * @param index The position of the task in the set.
+   * @param execution The execution time of every task in the set, indexed by
+   * position.  nullptr, the default, uses the budgets.
+   * @return TickType_t The worst case response time in ticks, or portMAX_DELAY
+   * if it exceeds the deadline of the task.
+   */
+  static constexpr TickType_t responseTime(
+      const size_t index, const TickType_t* execution = nullptr) {
+    const TickType_t* const times =
+        (execution == nullptr) ? budgets : execution;
+    uint64_t response = times[index];
+    uint64_t previous = 0;
+
+    while (response != previous) {
+      if (response > deadlines[index]) {
+        return portMAX_DELAY;
+      }
+      previous = response;
+      response = times[index];
+      for (size_t other = 0; other < size; other++) {
+        if (isHigherPriority(other, index)) {
+          const uint64_t releases =
+              (previous + periods[other] - 1) / periods[other];
+          response += releases * times[other];
+        }
+      }
+    }
+    return static_cast<TickType_t>(response);
+  }
+
+  /**
+   * TaskSet.hpp
+   *
+   * @brief Function that returns whether every task of the set meets its
+   * deadline.
+   *
+   * @param execution The execution time of every task in the set, indexed by
+   * position.  nullptr, the default, uses the budgets.
+   * @return true If the worst case response time of every task is within its
+   * deadline.
+   * @return false Otherwise.
+   */
+  static constexpr bool isSchedulable(const TickType_t* execution = nullptr) {
+    for (size_t index = 0; index < size; index++) {
+      if (responseTime(index, execution) == portMAX_DELAY) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * TaskSet.hpp
+   *
+   * @brief Function that returns whether the set meets every deadline when it
+   * is scheduled earliest deadline first, for example by a
+   * FreeRTOS::EdfScheduler.
+   *
+   * The test sums budget / deadline over all tasks, rounding every term up.
+   * It is exact when every deadline equals its period and sufficient
+   * otherwise.
+   *
+   * @return true If the density of the set is at most 1.
+   * @return false Otherwise.
+   */
+  static constexpr bool isEdfSchedulable() {
+    constexpr uint64_t one = static_cast<uint64_t>(1) << 32;
+    uint64_t density = 0;
+    for (size_t index = 0; index < size; index++) {
+      density += ((static_cast<uint64_t>(budgets[index]) << 32) +
+                  deadlines[index] - 1) /
+                 deadlines[index];
+    }
+    return density <= one;
+  }
+
+  /**
+   * @class Task TaskSet.hpp <FreeRTOS/TaskSet.hpp>
+   *
+   * @brief Class that implements one task of the set as a
+   * FreeRTOS::PeriodicTask whose period, budget and priority come from the
+   * set.
+   *
+   * @note This class is not intended to be instantiated by the user.  The
+   * user should create a class that derives from this class and implement
+   * cycle().
+   *
+   * @tparam Index The position of the task in the set.
+   * @tparam N The number of indexes in the array of <tt>StackType_t</tt> used
+   * to store the stack for this task.
+   */
+  template <size_t Index, UBaseType_t N = configMINIMAL_STACK_SIZE>
+  class Task : public PeriodicTask<N> {
+    static_assert(Index < size, "The task set has no task at this index.");
+
+   public:
+    using OverrunPolicy = typename PeriodicTask<N>::OverrunPolicy;
+
+   protected:
+    /**
+     * TaskSet.hpp
+     *
+     * @brief Construct a new Task object.
+     *
+     * @param name A descriptive name for the task.
+     * @param lowestPriority The priority of the lowest priority task of the
+     * set.  The set uses this priority and the size - 1 priorities above it.
+     * @param policy What the task does when a cycle overruns its period.
+     */
+    explicit Task(const char* name = "",
+                  const UBaseType_t lowestPriority = tskIDLE_PRIORITY + 1,
+                  const OverrunPolicy policy = OverrunPolicy::CatchUp)
+        : PeriodicTask<N>(periods[Index], (lowestPriority + rank(Index)),
+                          name, policy, budgets[Index]) {
+      configASSERT((lowestPriority + size) <= configMAX_PRIORITIES);
+    }
+    ~Task() = default;
+  };
+
+ private:
+  // Deadline monotonic order, with ties broken by the position in the set.
+  static constexpr bool isHigherPriority(const size_t task,
+                                         const size_t than) {
+    return (deadlines[task] < deadlines[than]) ||
+           ((deadlines[task] == deadlines[than]) && (task < than));
+  }
+
+  static constexpr TickType_t periods[size] = {Timings::period...};
+  static constexpr TickType_t budgets[size] = {Timings::budget...};
+  static constexpr TickType_t deadlines[size] = {Timings::deadline...};
+};
+
+}  // namespace FreeRTOS
+
+#endif /* INCLUDE_xTaskDelayUntil && configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_TASKSET_HPP
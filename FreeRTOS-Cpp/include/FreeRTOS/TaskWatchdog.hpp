@@ -0,0 +1,276 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_TASKWATCHDOG_HPP
+#define FREERTOS_TASKWATCHDOG_HPP
+
+#include <FreeRTOS/Timer.hpp>
+#include <atomic>
+#include <cstddef>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1) && (configUSE_TIMERS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class TaskWatchdog TaskWatchdog.hpp <FreeRTOS/TaskWatchdog.hpp>
+ *
+ * @brief Class that watches several tasks with one timer and kicks a single
+ * channel hardware watchdog only while every task is healthy.
+ *
+ * Each watched task is added with the longest interval it may go without
+ * calling checkIn().  checkIn() stores the tick count in a slot of the task,
+ * so it is a single atomic store that never blocks, takes no lock and is
+ * cheap enough for a 1 kHz loop.  The watchdog is an auto reload timer, and
+ * on every expiry it compares the check in of each task with its interval.
+ * If no task is late the kick callback is called.  Otherwise the kick is
+ * withheld, so the hardware watchdog resets the system, and the stall
+ * callback is called once for every task that has just become late.
+ *
+ * The scan period must be shorter than the timeout of the hardware watchdog,
+ * and each interval should be longer than the scan period.  Both callbacks
+ * run in the timer service task, so they must not block.
+ *
+ * configSUPPORT_STATIC_ALLOCATION and configUSE_TIMERS must both be defined as
+ * 1 for this class to be available.
+ *
+ * @tparam MaxTasks The maximum number of watched tasks.
+ *
+ * <b>Example Usage</b>
+ * @include TaskWatchdog/taskWatchdog.cpp
+ */
+template <size_t MaxTasks>
+class TaskWatchdog : public StaticTimer {
+  static_assert(MaxTasks > 0, "MaxTasks must be at least 1.");
+
+ public:
+  /**
+   * @brief Identifier of a watched task returned by add().
+   */
+  using Id = size_t;
+
+  /**
+   * @brief Function that kicks the hardware watchdog.
+   */
+  using KickCallback = void (*)();
+
+  /**
+   * @brief Function called when a task misses its interval.
+   *
+   * @param id The identifier of the task.
+   * @param task The handle passed to add().
+   * @param elapsed The ticks since the last check in of the task.
+   */
+  using StallCallback = void (*)(Id id, TaskHandle_t task, TickType_t elapsed);
+
+  /**
+   * @brief Value returned by add() when every slot is in use.
+   */
+  static constexpr Id invalidId = MaxTasks;
+
+  /**
+   * TaskWatchdog.hpp
+   *
+   * @brief Construct a new TaskWatchdog object.  The timer is created in the
+   * dormant state, and start() must be called to begin watching.
+   *
+   * @param scanPeriod The period, in ticks, at which the check ins are
+   * scanned.
+   * @param kick Function that kicks the hardware watchdog.
+   * @param stall Function called when a task misses its interval, or nullptr.
+   * @param name The name of the timer.
+   */
+  explicit TaskWatchdog(const TickType_t scanPeriod, const KickCallback kick,
+                        const StallCallback stall = nullptr,
+                        const char* name = "Watchdog")
+      : StaticTimer(scanPeriod, true, name), kick(kick), stall(stall) {}
+  ~TaskWatchdog() = default;
+
+  TaskWatchdog(const TaskWatchdog&) = delete;
+  TaskWatchdog& operator=(const TaskWatchdog&) = delete;
+
+  /**
+   * TaskWatchdog.hpp
+   *
+   * @brief Function that starts watching a task.  The task is treated as
+   * having checked in when it is added.
+   *
+   * @param maxInterval The longest time, in ticks, that the task may go
+   * without calling checkIn().  It must be greater than 0.
+   * @param task The handle reported to the stall callback.  NULL uses the
+   * handle of the calling task.
+   * @return Id The identifier to pass to checkIn(), or invalidId if MaxTasks
+   * tasks have already been added.
+   */
+  Id add(const TickType_t maxInterval, TaskHandle_t task = NULL) {
+    configASSERT(maxInterval > 0);
+    if (task == NULL) {
+      task = xTaskGetCurrentTaskHandle();
+    }
+
+    taskENTER_CRITICAL();
+    const Id id = count.load(std::memory_order_relaxed);
+    if (id < MaxTasks) {
+      Entry& entry = entries[id];
+      entry.task = task;
+      entry.stalled = false;
+      entry.lastCheckIn.store(xTaskGetTickCount(), std::memory_order_relaxed);
+      entry.interval.store(maxInterval, std::memory_order_relaxed);
+      count.store(id + 1, std::memory_order_release);
+    }
+    taskEXIT_CRITICAL();
+
+    return (id < MaxTasks) ? id : invalidId;
+  }
+
+  /**
+   * TaskWatchdog.hpp
+   *
+   * @brief Function that stops watching a task, for example before it is
+   * suspended.  The slot is not reused.
+   *
+   * @param id The identifier returned by add().
+   */
+  inline void remove(const Id id) {
+    configASSERT(id < count.load(std::memory_order_acquire));
+    entries[id].interval.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * TaskWatchdog.hpp
+   *
+   * @brief Function that records that a task is healthy.
+   *
+   * @param id The identifier returned by add().
+   */
+  inline void checkIn(const Id id) {
+    entries[id].lastCheckIn.store(xTaskGetTickCount(),
+                                  std::memory_order_relaxed);
+  }
+
+  /**
+   * TaskWatchdog.hpp
+   *
+   * @brief A version of checkIn() that can be called from an interrupt
+   * service routine.
+   *
+   * @param id The identifier returned by add().
+   */
+  inline void checkInFromISR(const Id id) {
+    entries[id].lastCheckIn.store(xTaskGetTickCountFromISR(),
+                                  std::memory_order_relaxed);
+  }
+
+  /**
+   * TaskWatchdog.hpp
+   *
+   * @brief Function that returns whether every task had checked in at the
+   * last scan.
+   *
+   * @return true If the hardware watchdog was kicked at the last scan.
+   * @return false If a task was late at the last scan.
+   */
+  inline bool isHealthy() const {
+    return healthy.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * TaskWatchdog.hpp
+   *
+   * @brief Function that returns whether a task was late at the last scan.
+   *
+   * @param id The identifier returned by add().
+   * @return true If the task was late.
+   * @return false If the task had checked in or is no longer watched.
+   */
+  inline bool isStalled(const Id id) const {
+    configASSERT(id < MaxTasks);
+    return entries[id].stalled;
+  }
+
+ private:
+  struct Entry {
+    std::atomic<TickType_t> lastCheckIn{0};
+    std::atomic<TickType_t> interval{0};
+    TaskHandle_t task = NULL;
+    bool stalled = false;
+  };
+
+  void timerFunction() final {
+    const Id tasks = count.load(std::memory_order_acquire);
+    bool allHealthy = true;
+
+    for (Id id = 0; id < tasks; id++) {
+      Entry& entry = entries[id];
+      const TickType_t interval =
+          entry.interval.load(std::memory_order_relaxed);
+      if (interval == 0) {
+        entry.stalled = false;
+        continue;
+      }
+
+      // The check in is read before the tick count, so a check in made during
+      // the scan can not appear to be in the future.
+      const TickType_t last =
+          entry.lastCheckIn.load(std::memory_order_relaxed);
+      const TickType_t elapsed = xTaskGetTickCount() - last;
+      if (elapsed <= interval) {
+        entry.stalled = false;
+        continue;
+      }
+
+      allHealthy = false;
+      if (!entry.stalled) {
+        entry.stalled = true;
+        if (stall != nullptr) {
+          stall(id, entry.task, elapsed);
+        }
+      }
+    }
+
+    healthy.store(allHealthy, std::memory_order_relaxed);
+    if (allHealthy) {
+      kick();
+    }
+  }
+
+  const KickCallback kick;
+  const StallCallback stall;
+  std::atomic<Id> count{0};
+  std::atomic<bool> healthy{true};
+  Entry entries[MaxTasks];
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION && configUSE_TIMERS */
+
+#endif  // FREERTOS_TASKWATCHDOG_HPP
@@ -0,0 +1,357 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_TICKTIMER_HPP
+#define FREERTOS_TICKTIMER_HPP
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TICK_HOOK == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class TickTimer TickTimer.hpp <FreeRTOS/TickTimer.hpp>
+ *
+ * @brief Class that implements timers whose callbacks run directly in the tick
+ * interrupt instead of in the timer service task.
+ *
+ * A FreeRTOS::Timer callback is only called once the timer service task has
+ * been scheduled.  That context switch dominates the cost of a tiny callback
+ * such as toggling a pin or setting an event bit.  A TickTimer is dispatched
+ * from the tick hook, so its callback runs in the first tick interrupt at or
+ * after its expiry time.
+ *
+ * The active timers are kept in a list sorted by expiry time, so the tick hook
+ * only compares the current tick count against the first entry when no timer
+ * is due.  vApplicationTickHook() must call tickHook().
+ *
+ * The callback runs in interrupt context, so it may only use FromISR API
+ * functions and must be short.  Its type is declared <tt>noexcept</tt> and it
+ * is passed a higherPriorityTaskWoken reference, so only functions written for
+ * that calling convention can be used as a callback.  There is no need to
+ * request a context switch: the kernel performs one at the end of the tick
+ * interrupt if a callback unblocked a higher priority task.
+ *
+ * configUSE_TICK_HOOK must be defined as 1 for this class to be available.
+ *
+ * @note The tick hook is called once per tick interrupt, so a TickTimer does
+ * not stop tickless idle from sleeping past its expiry time, and while the
+ * scheduler is suspended expiries are delayed until it is resumed.  In both
+ * cases every late timer is dispatched on the next tick.
+ *
+ * @warning A TickTimer must be persistent (not declared on the stack of
+ * another function) while it is active.  The destructor stops the timer.
+ *
+ * <b>Example Usage</b>
+ * @include TickTimer/tickTimer.cpp
+ */
+class TickTimer {
+ public:
+  /**
+   * @brief Function called in the context of the tick interrupt when the
+   * timer expires.
+   *
+   * The callback may use any FromISR function, including those of this and
+   * other TickTimer objects.
+   */
+  using Callback = void (*)(void* argument,
+                            bool& higherPriorityTaskWoken) noexcept;
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief Construct a new TickTimer object.  Timers are created in the
+   * dormant state.
+   *
+   * @param callback Function called from the tick interrupt when the timer
+   * expires.
+   * @param argument Value passed to callback.
+   * @param period The period of the timer in ticks.  The timer period must be
+   * greater than 0.
+   * @param autoReload If true the timer expires repeatedly with a frequency set
+   * by period, otherwise it is a one-shot timer.
+   */
+  TickTimer(const Callback callback, void* argument, const TickType_t period,
+            const bool autoReload = false)
+      : callback(callback),
+        argument(argument),
+        period(period),
+        autoReload(autoReload) {
+    configASSERT(period > 0);
+  }
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief Destroy the TickTimer object.  The timer is stopped first.
+   */
+  ~TickTimer() {
+    stop();
+  }
+
+  TickTimer(const TickTimer&) = delete;
+  TickTimer& operator=(const TickTimer&) = delete;
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief Function that starts the timer, or restarts it if it is already
+   * active, so that it expires period ticks from now.
+   */
+  inline void start() {
+    taskENTER_CRITICAL();
+    arm(xTaskGetTickCount());
+    taskEXIT_CRITICAL();
+  }
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief A version of start() that can be called from an ISR, including the
+   * callback of a TickTimer.
+   */
+  inline void startFromISR() {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    arm(xTaskGetTickCountFromISR());
+    taskEXIT_CRITICAL_FROM_ISR(status);
+  }
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief Function that re-starts the timer.  Equivalent to start().
+   */
+  inline void reset() {
+    start();
+  }
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief A version of reset() that can be called from an ISR.
+   */
+  inline void resetFromISR() {
+    startFromISR();
+  }
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief Function that stops the timer.
+   *
+   * @retval true The timer was active and has been stopped.
+   * @retval false The timer was not active.
+   */
+  inline bool stop() {
+    taskENTER_CRITICAL();
+    const bool result = disarm();
+    taskEXIT_CRITICAL();
+    return result;
+  }
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief A version of stop() that can be called from an ISR.
+   *
+   * @retval true The timer was active and has been stopped.
+   * @retval false The timer was not active.
+   */
+  inline bool stopFromISR() {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool result = disarm();
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return result;
+  }
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief Function that changes the period of the timer and starts it, so
+   * that it expires newPeriod ticks from now.
+   *
+   * @param newPeriod The new period in ticks.  The timer period must be
+   * greater than 0.
+   */
+  inline void changePeriod(const TickType_t newPeriod) {
+    configASSERT(newPeriod > 0);
+    taskENTER_CRITICAL();
+    period = newPeriod;
+    arm(xTaskGetTickCount());
+    taskEXIT_CRITICAL();
+  }
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief A version of changePeriod() that can be called from an ISR.
+   *
+   * @param newPeriod The new period in ticks.
+   */
+  inline void changePeriodFromISR(const TickType_t newPeriod) {
+    configASSERT(newPeriod > 0);
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    period = newPeriod;
+    arm(xTaskGetTickCountFromISR());
+    taskEXIT_CRITICAL_FROM_ISR(status);
+  }
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief Function that returns whether the timer is active.
+   *
+   * @retval true The timer is active.
+   * @retval false The timer is dormant.
+   */
+  inline bool isActive() const {
+    return active;
+  }
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief Function that returns the period of the timer.
+   *
+   * @return TickType_t The period in ticks.
+   */
+  inline TickType_t getPeriod() const {
+    return period;
+  }
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief Function that returns the tick count at which the timer will next
+   * expire.  Only meaningful if the timer is active.
+   *
+   * @return TickType_t The expiry time in ticks.
+   */
+  inline TickType_t getExpiryTime() const {
+    return expiry;
+  }
+
+  /**
+   * TickTimer.hpp
+   *
+   * @brief Function that must be called from <tt>vApplicationTickHook()</tt>.
+   * It calls the callback of every timer whose expiry time has passed.
+   */
+  static void tickHook() {
+    const TickType_t now = xTaskGetTickCountFromISR();
+    if ((head == nullptr) || !expired(head->expiry, now)) {
+      return;
+    }
+
+    bool higherPriorityTaskWoken = false;
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    for (;;) {
+      TickTimer* const timer = head;
+      if ((timer == nullptr) || !expired(timer->expiry, now)) {
+        break;
+      }
+
+      head = timer->next;
+      timer->next = nullptr;
+      if (timer->autoReload) {
+        // Keep the phase of the timer, even if the hook was called late.
+        timer->expiry += timer->period;
+        timer->insert();
+      } else {
+        timer->active = false;
+      }
+
+      timer->callback(timer->argument, higherPriorityTaskWoken);
+    }
+    taskEXIT_CRITICAL_FROM_ISR(status);
+  }
+
+ private:
+  inline static bool expired(const TickType_t time, const TickType_t now) {
+    return (static_cast<TickType_t>(now - time) < (portMAX_DELAY / 2));
+  }
+
+  // Must be called in a critical section.
+  inline void insert() {
+    TickTimer** link = &head;
+    while ((*link != nullptr) && expired((*link)->expiry, expiry)) {
+      link = &(*link)->next;
+    }
+    next = *link;
+    *link = this;
+    active = true;
+  }
+
+  // Must be called in a critical section.
+  inline void remove() {
+    for (TickTimer** link = &head; *link != nullptr; link = &(*link)->next) {
+      if (*link == this) {
+        *link = next;
+        break;
+      }
+    }
+    next = nullptr;
+    active = false;
+  }
+
+  // Must be called in a critical section.
+  inline void arm(const TickType_t now) {
+    if (active) {
+      remove();
+    }
+    expiry = now + period;
+    insert();
+  }
+
+  // Must be called in a critical section.
+  inline bool disarm() {
+    if (!active) {
+      return false;
+    }
+    remove();
+    return true;
+  }
+
+  static inline TickTimer* head = nullptr;
+
+  TickTimer* next = nullptr;
+  const Callback callback;
+  void* const argument;
+  TickType_t period;
+  TickType_t expiry = 0;
+  const bool autoReload;
+  bool active = false;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TICK_HOOK */
+
+#endif  // FREERTOS_TICKTIMER_HPP
@@ -0,0 +1,233 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_TICKLESSIDLE_HPP
+#define FREERTOS_TICKLESSIDLE_HPP
+
+#include <FreeRTOS/Kernel.hpp>
+#include <cstddef>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TICKLESS_IDLE != 0)
+
+namespace FreeRTOS {
+
+/**
+ * @brief Counters collected by FreeRTOS::TicklessIdle.
+ */
+struct TicklessStatistics {
+  /**
+   * @brief The number of times the kernel asked to suppress the tick.
+   */
+  uint32_t requests;
+
+  /**
+   * @brief The number of requests that did not sleep because no low power mode
+   * fitted in the expected idle time, or because a task became ready.
+   */
+  uint32_t aborted;
+
+  /**
+   * @brief The total number of ticks spent with the tick suppressed.
+   */
+  uint32_t ticksSlept;
+};
+
+/**
+ * @class TicklessIdle TicklessIdle.hpp <FreeRTOS/TicklessIdle.hpp>
+ *
+ * @brief Class that implements <tt>portSUPPRESS_TICKS_AND_SLEEP()</tt> by
+ * choosing a low power mode from a table and delegating the hardware specific
+ * steps to a platform class.
+ *
+ * Set configUSE_TICKLESS_IDLE to 2 and define portSUPPRESS_TICKS_AND_SLEEP() in
+ * FreeRTOSConfig.h to call a function that calls sleep() on a TicklessIdle
+ * object.  Each time the idle task finds that no task is ready for at least
+ * configEXPECTED_IDLE_TIME_BEFORE_SLEEP ticks, sleep():
+ * 1. picks the deepest mode in the table whose entry plus exit latency fits in
+ *    the expected idle time,
+ * 2. stops the tick and programs the wake-up source to fire early enough to
+ *    cover the exit latency of the mode,
+ * 3. enters the mode, and
+ * 4. on wake-up, moves the tick count forward by the time that was spent
+ *    asleep with FreeRTOS::Kernel::stepTick() and restarts the tick.
+ *
+ * The platform class must have these static member functions:
+ * - <tt>void disableInterrupts()</tt> and <tt>void enableInterrupts()</tt>
+ *   mask and unmask interrupts in a way that still lets a pending interrupt
+ *   end a wait for interrupt, for example with PRIMASK on Cortex-M.
+ * - <tt>void stopTick()</tt> stops the tick interrupt.
+ * - <tt>void startTick()</tt> restarts the tick interrupt for a full period.
+ * - <tt>void setWakeUp(TickType_t ticks)</tt> programs the wake-up source to
+ *   fire after ticks tick periods.
+ * - <tt>TickType_t cancelWakeUp()</tt> stops the wake-up source and returns
+ *   the number of whole tick periods since setWakeUp() was called.
+ * - <tt>void enter(Mode mode)</tt> enters the low power mode and returns when
+ *   the processor wakes up.
+ *
+ * @tparam Platform Class that gives access to the tick, the wake-up source and
+ * the low power modes of the device.
+ * @tparam Mode Type that identifies a low power mode, usually an enumeration.
+ *
+ * <b>Example Usage</b>
+ * @include TicklessIdle/ticklessIdle.cpp
+ */
+template <class Platform, class Mode>
+class TicklessIdle {
+ public:
+  /**
+   * @brief One entry of the table of low power modes.
+   */
+  struct SleepMode {
+    /**
+     * @brief The mode, as passed to <tt>Platform::enter()</tt>.
+     */
+    Mode mode;
+
+    /**
+     * @brief The number of ticks it takes to enter the mode.
+     */
+    TickType_t entryLatency;
+
+    /**
+     * @brief The number of ticks it takes to be running again after the
+     * wake-up source fires.
+     */
+    TickType_t exitLatency;
+  };
+
+  /**
+   * TicklessIdle.hpp
+   *
+   * @brief Construct a new TicklessIdle object.
+   *
+   * @param modes Table of low power modes, ordered from the lightest to the
+   * deepest.  It must outlive the object.
+   */
+  template <size_t N>
+  explicit TicklessIdle(const SleepMode (&modes)[N])
+      : modes(modes), count(N) {}
+  ~TicklessIdle() = default;
+
+  TicklessIdle(const TicklessIdle&) = delete;
+  TicklessIdle& operator=(const TicklessIdle&) = delete;
+
+  /**
+   * TicklessIdle.hpp
+   *
+   * @brief Function that returns the deepest mode that fits in an idle period.
+   *
+   * @param expectedIdleTime The number of ticks until a task is expected to
+   * become ready.
+   * @return const SleepMode* The deepest mode whose entry plus exit latency is
+   * less than expectedIdleTime, or nullptr if there is none.
+   */
+  const SleepMode* select(const TickType_t expectedIdleTime) const {
+    for (size_t i = count; i > 0; i--) {
+      const SleepMode& candidate = modes[i - 1];
+      if ((candidate.entryLatency + candidate.exitLatency) <
+          expectedIdleTime) {
+        return &candidate;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * TicklessIdle.hpp
+   *
+   * @brief Function that is called by <tt>portSUPPRESS_TICKS_AND_SLEEP()</tt>
+   * to sleep for up to expectedIdleTime ticks.
+   *
+   * @param expectedIdleTime The number of ticks until a task is expected to
+   * become ready, as passed by the kernel.
+   */
+  void sleep(const TickType_t expectedIdleTime) {
+    statistics.requests++;
+    const SleepMode* mode = select(expectedIdleTime);
+    if (mode == nullptr) {
+      statistics.aborted++;
+      return;
+    }
+
+    Platform::disableInterrupts();
+
+    // A task may have become ready, or a context switch may have been pended,
+    // since the idle task decided to sleep.
+    const eSleepModeStatus status = eTaskConfirmSleepModeStatus();
+    if (status == eAbortSleep) {
+      Platform::enableInterrupts();
+      statistics.aborted++;
+      return;
+    }
+
+    Platform::stopTick();
+    if (status != eNoTasksWaitingTimeout) {
+      Platform::setWakeUp(expectedIdleTime - mode->exitLatency);
+    }
+
+    Platform::enter(mode->mode);
+
+    TickType_t slept = Platform::cancelWakeUp();
+    if (slept > expectedIdleTime) {
+      slept = expectedIdleTime;
+    }
+    Kernel::stepTick(slept);
+    statistics.ticksSlept += slept;
+
+    Platform::startTick();
+    Platform::enableInterrupts();
+  }
+
+  /**
+   * TicklessIdle.hpp
+   *
+   * @brief Function that returns a copy of the counters.
+   *
+   * @return TicklessStatistics The counters.
+   */
+  TicklessStatistics getStatistics() const {
+    taskENTER_CRITICAL();
+    const TicklessStatistics copy = statistics;
+    taskEXIT_CRITICAL();
+    return copy;
+  }
+
+ private:
+  const SleepMode* const modes;
+  const size_t count;
+  TicklessStatistics statistics = {0, 0, 0};
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TICKLESS_IDLE */
+
+#endif  // FREERTOS_TICKLESSIDLE_HPP
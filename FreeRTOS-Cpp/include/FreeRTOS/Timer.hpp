@@ -28,21 +28,108 @@
 #ifndef FREERTOS_TIMER_HPP
 #define FREERTOS_TIMER_HPP
 
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/DeferCreate.hpp>
+#include <FreeRTOS/Instrumentation.hpp>
+#include <type_traits>
+#include <utility>
+
 #include "FreeRTOS.h"
+#include "task.h"
 #include "timers.h"
 
 /**
- * @brief C function that is used to interface this class with the FreeRTOS
- * kernel.
- *
- * @note This function should not be called or referenced by the user.
- *
- * @param task Pointer to an instance of FreeRTOS::TimerBase.
+ * @brief Set FREERTOS_CPP_TIMER_STATISTICS to 1 in FreeRTOSConfig.h (or on the
+ * compiler command line) to have every timer record how late its callback is
+ * dispatched and how long the callback takes, which can be read with
+ * FreeRTOS::TimerBase::getStatistics().  When it is 0 (the default) no
+ * statistics are stored and the callback is called directly.
+ */
+#ifndef FREERTOS_CPP_TIMER_STATISTICS
+#define FREERTOS_CPP_TIMER_STATISTICS 0
+#endif
+
+/**
+ * @brief The number of buckets in the lateness histogram of
+ * FreeRTOS::TimerStatistics.
+ */
+#ifndef FREERTOS_CPP_TIMER_STATISTICS_BUCKETS
+#define FREERTOS_CPP_TIMER_STATISTICS_BUCKETS 8
+#endif
+
+/**
+ * @brief Set FREERTOS_CPP_TIMER_SLACK to 1 in FreeRTOSConfig.h (or on the
+ * compiler command line) to make FreeRTOS::TimerBase::setSlack() available.
+ * Timers that are given a slack align their expiry times to a common grid so
+ * that timers that would otherwise expire at nearby times are all processed
+ * in a single wake up of the timer service/daemon task.  When it is 0 (the
+ * default) no slack is stored and every call maps directly onto the kernel.
+ */
+#ifndef FREERTOS_CPP_TIMER_SLACK
+#define FREERTOS_CPP_TIMER_SLACK 0
+#endif
+
+/**
+ * @brief Set FREERTOS_CPP_COMPACT to 1 to leave the delete block time out of
+ * FreeRTOS::TimerBase.  The destructor then never waits for space in the timer
+ * command queue, and the deleteBlockTime constructor arguments are ignored.
+ * FreeRTOS::CrtpTimer and FreeRTOS::StaticCrtpTimer also avoid the virtual
+ * function table pointer of FreeRTOS::Timer and FreeRTOS::StaticTimer.
  */
-void callTimerFunction(TimerHandle_t timer);
+#ifndef FREERTOS_CPP_COMPACT
+#define FREERTOS_CPP_COMPACT 0
+#endif
 
 namespace FreeRTOS {
 
+#if (FREERTOS_CPP_TIMER_STATISTICS == 1)
+
+/**
+ * @brief Dispatch statistics recorded by FreeRTOS::TimerBase when
+ * FREERTOS_CPP_TIMER_STATISTICS is set to 1.
+ *
+ * The lateness of a dispatch is the number of ticks between the time the timer
+ * was due to expire and the time its callback started.  Execution times are in
+ * units of the run time statistics counter when configGENERATE_RUN_TIME_STATS
+ * is 1, and in ticks otherwise.
+ */
+struct TimerStatistics {
+  /**
+   * @brief The number of times the callback has been called.
+   */
+  uint32_t dispatches = 0;
+
+  /**
+   * @brief The smallest lateness of a dispatch, in ticks.
+   */
+  TickType_t minLateness = portMAX_DELAY;
+
+  /**
+   * @brief The largest lateness of a dispatch, in ticks.
+   */
+  TickType_t maxLateness = 0;
+
+  /**
+   * @brief Histogram of the lateness of every dispatch.  Bucket 0 counts
+   * dispatches that were on time, bucket i counts dispatches that were between
+   * 2^(i-1) and 2^i - 1 ticks late, and the last bucket also counts every
+   * later dispatch.
+   */
+  uint32_t latenessHistogram[FREERTOS_CPP_TIMER_STATISTICS_BUCKETS] = {};
+
+  /**
+   * @brief The longest time a call to the callback took.
+   */
+  uint32_t maxExecution = 0;
+
+  /**
+   * @brief The total time spent in the callback.
+   */
+  uint32_t totalExecution = 0;
+};
+
+#endif /* FREERTOS_CPP_TIMER_STATISTICS */
+
 /**
  * @class TimerBase Timer.hpp <FreeRTOS/Timer.hpp>
  *
@@ -57,6 +144,10 @@ class TimerBase {
  public:
   friend class Timer;
   friend class StaticTimer;
+  template <class>
+  friend class CrtpTimer;
+  template <class>
+  friend class StaticCrtpTimer;
 
   TimerBase(const TimerBase&) = delete;
   TimerBase& operator=(const TimerBase&) = delete;
@@ -72,19 +163,6 @@ class TimerBase {
     return ptr;
   }
 
-  /**
-   * Timer.hpp
-   *
-   * @brief Function that acts as the entry point of the timer instance.
-   *
-   * @note This function is only public so that it can be accessed by the C
-   * interface function <tt>callTimerFunction()</tt> and should not be called or
-   * referenced by the user.
-   */
-  virtual inline void timerEntry() final {
-    timerFunction();
-  }
-
   /**
    * Timer.hpp
    *
@@ -167,7 +245,30 @@ class TimerBase {
    * @include Timer/timer.cpp
    */
   inline bool start(const TickType_t blockTime = 0) const {
-    return (xTimerStart(handle, blockTime) == pdPASS);
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+    if (slack > 1) {
+      return Instrument::call(
+          InstrumentedCall::TimerCommand, handle, blockTime, [&] {
+            return (xTimerChangePeriod(
+                        handle, coalesce(nominalPeriod, xTaskGetTickCount()),
+                        blockTime) == pdPASS);
+          });
+    }
+#endif /* FREERTOS_CPP_TIMER_SLACK */
+    return Instrument::call(
+        InstrumentedCall::TimerCommand, handle, blockTime, [&] {
+          return (xTimerStart(handle, blockTime) == pdPASS);
+        });
+  }
+
+  /**
+   * Timer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool start(const std::chrono::duration<Rep, Period>& blockTime) const {
+    return start(Clock::toTicks(blockTime));
   }
 
   /**
@@ -204,8 +305,16 @@ class TimerBase {
    * @include Timer/startFromISR.cpp
    */
   inline bool startFromISR(bool& higherPriorityTaskWoken) const {
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+    if (slack > 1) {
+      return changePeriodFromISR(higherPriorityTaskWoken, nominalPeriod);
+    }
+#endif /* FREERTOS_CPP_TIMER_SLACK */
     BaseType_t taskWoken = pdFALSE;
-    const bool result = (xTimerStartFromISR(handle, &taskWoken) == pdPASS);
+    const bool result = Instrument::callFromISR(
+        InstrumentedCall::TimerCommand, handle, [&] {
+          return (xTimerStartFromISR(handle, &taskWoken) == pdPASS);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
@@ -223,7 +332,14 @@ class TimerBase {
    * @overload
    */
   inline bool startFromISR() const {
-    return (xTimerStartFromISR(handle, NULL) == pdPASS);
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+    if (slack > 1) {
+      return changePeriodFromISR(nominalPeriod);
+    }
+#endif /* FREERTOS_CPP_TIMER_SLACK */
+    return Instrument::callFromISR(InstrumentedCall::TimerCommand, handle, [&] {
+      return (xTimerStartFromISR(handle, NULL) == pdPASS);
+    });
   }
 
   /**
@@ -257,7 +373,20 @@ class TimerBase {
    * @include Timer/timer.cpp
    */
   inline bool stop(const TickType_t blockTime = 0) const {
-    return (xTimerStop(handle, blockTime) == pdPASS);
+    return Instrument::call(
+        InstrumentedCall::TimerCommand, handle, blockTime, [&] {
+          return (xTimerStop(handle, blockTime) == pdPASS);
+        });
+  }
+
+  /**
+   * Timer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool stop(const std::chrono::duration<Rep, Period>& blockTime) const {
+    return stop(Clock::toTicks(blockTime));
   }
 
   /**
@@ -294,7 +423,10 @@ class TimerBase {
    */
   inline bool stopFromISR(bool& higherPriorityTaskWoken) const {
     BaseType_t taskWoken = pdFALSE;
-    const bool result = (xTimerStopFromISR(handle, &taskWoken) == pdPASS);
+    const bool result = Instrument::callFromISR(
+        InstrumentedCall::TimerCommand, handle, [&] {
+          return (xTimerStopFromISR(handle, &taskWoken) == pdPASS);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
@@ -312,7 +444,9 @@ class TimerBase {
    * @overload
    */
   inline bool stopFromISR() const {
-    return (xTimerStopFromISR(handle, NULL) == pdPASS);
+    return Instrument::callFromISR(InstrumentedCall::TimerCommand, handle, [&] {
+      return (xTimerStopFromISR(handle, NULL) == pdPASS);
+    });
   }
 
   /**
@@ -354,7 +488,55 @@ class TimerBase {
    */
   inline bool changePeriod(const TickType_t newPeriod,
                            const TickType_t blockTime = 0) const {
-    return (xTimerChangePeriod(handle, newPeriod, blockTime) == pdPASS);
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+    if (slack > 1) {
+      return Instrument::call(
+          InstrumentedCall::TimerCommand, handle, blockTime, [&] {
+            return (xTimerChangePeriod(handle,
+                                       coalesce(newPeriod, xTaskGetTickCount()),
+                                       blockTime) == pdPASS);
+          });
+    }
+#endif /* FREERTOS_CPP_TIMER_SLACK */
+    return Instrument::call(
+        InstrumentedCall::TimerCommand, handle, blockTime, [&] {
+          return (xTimerChangePeriod(handle, newPeriod, blockTime) == pdPASS);
+        });
+  }
+
+  /**
+   * Timer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool changePeriod(
+      const TickType_t newPeriod,
+      const std::chrono::duration<Rep, Period>& blockTime) const {
+    return changePeriod(newPeriod, Clock::toTicks(blockTime));
+  }
+
+  /**
+   * Timer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool changePeriod(const std::chrono::duration<Rep, Period>& newPeriod,
+                           const TickType_t blockTime = 0) const {
+    return changePeriod(Clock::toTicks(newPeriod), blockTime);
+  }
+
+  /**
+   * Timer.hpp
+   *
+   * @overload
+   */
+  template <class PeriodRep, class PeriodPeriod, class Rep, class Period>
+  inline bool changePeriod(
+      const std::chrono::duration<PeriodRep, PeriodPeriod>& newPeriod,
+      const std::chrono::duration<Rep, Period>& blockTime) const {
+    return changePeriod(Clock::toTicks(newPeriod), Clock::toTicks(blockTime));
   }
 
   /**
@@ -402,8 +584,18 @@ class TimerBase {
   inline bool changePeriodFromISR(bool& higherPriorityTaskWoken,
                                   const TickType_t newPeriod) const {
     BaseType_t taskWoken = pdFALSE;
-    const bool result =
-        (xTimerChangePeriodFromISR(handle, newPeriod, &taskWoken) == pdPASS);
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+    const TickType_t period =
+        (slack > 1) ? coalesce(newPeriod, xTaskGetTickCountFromISR())
+                    : newPeriod;
+#else
+    const TickType_t period = newPeriod;
+#endif /* FREERTOS_CPP_TIMER_SLACK */
+    const bool result = Instrument::callFromISR(
+        InstrumentedCall::TimerCommand, handle, [&] {
+          return (xTimerChangePeriodFromISR(handle, period, &taskWoken) ==
+                  pdPASS);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
@@ -423,7 +615,19 @@ class TimerBase {
    * @overload
    */
   inline bool changePeriodFromISR(const TickType_t newPeriod) const {
-    return (xTimerChangePeriodFromISR(handle, newPeriod, NULL) == pdPASS);
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+    if (slack > 1) {
+      return Instrument::callFromISR(
+          InstrumentedCall::TimerCommand, handle, [&] {
+            return (xTimerChangePeriodFromISR(
+                        handle, coalesce(newPeriod, xTaskGetTickCountFromISR()),
+                        NULL) == pdPASS);
+          });
+    }
+#endif /* FREERTOS_CPP_TIMER_SLACK */
+    return Instrument::callFromISR(InstrumentedCall::TimerCommand, handle, [&] {
+      return (xTimerChangePeriodFromISR(handle, newPeriod, NULL) == pdPASS);
+    });
   }
 
   /**
@@ -459,13 +663,26 @@ class TimerBase {
    * @include Timer/changePeriod.cpp
    */
   inline bool deleteTimer(const TickType_t blockTime = 0) {
-    if (xTimerDelete(handle, blockTime) == pdPASS) {
+    if (Instrument::call(
+            InstrumentedCall::TimerCommand, handle, blockTime, [&] {
+              return (xTimerDelete(handle, blockTime) == pdPASS);
+            })) {
       handle = NULL;
       return true;
     }
     return false;
   }
 
+  /**
+   * Timer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool deleteTimer(const std::chrono::duration<Rep, Period>& blockTime) {
+    return deleteTimer(Clock::toTicks(blockTime));
+  }
+
   /**
    * Timer.hpp
    *
@@ -508,7 +725,30 @@ class TimerBase {
    * @include Timer/reset.cpp
    */
   inline bool reset(const TickType_t blockTime = 0) const {
-    return (xTimerReset(handle, blockTime) == pdPASS);
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+    if (slack > 1) {
+      return Instrument::call(
+          InstrumentedCall::TimerCommand, handle, blockTime, [&] {
+            return (xTimerChangePeriod(
+                        handle, coalesce(nominalPeriod, xTaskGetTickCount()),
+                        blockTime) == pdPASS);
+          });
+    }
+#endif /* FREERTOS_CPP_TIMER_SLACK */
+    return Instrument::call(
+        InstrumentedCall::TimerCommand, handle, blockTime, [&] {
+          return (xTimerReset(handle, blockTime) == pdPASS);
+        });
+  }
+
+  /**
+   * Timer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool reset(const std::chrono::duration<Rep, Period>& blockTime) const {
+    return reset(Clock::toTicks(blockTime));
   }
 
   /**
@@ -545,8 +785,16 @@ class TimerBase {
    * @include Timer/resetFromISR.cpp
    */
   inline bool resetFromISR(bool& higherPriorityTaskWoken) const {
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+    if (slack > 1) {
+      return changePeriodFromISR(higherPriorityTaskWoken, nominalPeriod);
+    }
+#endif /* FREERTOS_CPP_TIMER_SLACK */
     BaseType_t taskWoken = pdFALSE;
-    const bool result = (xTimerResetFromISR(handle, &taskWoken) == pdPASS);
+    const bool result = Instrument::callFromISR(
+        InstrumentedCall::TimerCommand, handle, [&] {
+          return (xTimerResetFromISR(handle, &taskWoken) == pdPASS);
+        });
     if (taskWoken == pdTRUE) {
       higherPriorityTaskWoken = true;
     }
@@ -564,7 +812,14 @@ class TimerBase {
    * @overload
    */
   inline bool resetFromISR() const {
-    return (xTimerResetFromISR(handle, NULL) == pdPASS);
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+    if (slack > 1) {
+      return changePeriodFromISR(nominalPeriod);
+    }
+#endif /* FREERTOS_CPP_TIMER_SLACK */
+    return Instrument::callFromISR(InstrumentedCall::TimerCommand, handle, [&] {
+      return (xTimerResetFromISR(handle, NULL) == pdPASS);
+    });
   }
 
   /**
@@ -686,17 +941,21 @@ class TimerBase {
     return (uxTimerGetReloadMode(handle) == pdTRUE);
   }
 
+#if (FREERTOS_CPP_COMPACT != 1)
   /**
    * Timer.hpp
    *
    * @brief Set the delete block time.  This value is used when the destructor
    * calls deleteTimer().
    *
+   * FREERTOS_CPP_COMPACT must be 0 for this function to be available.
+   *
    * @param deleteBlockTime Delete block time to be set in ticks.
    */
   inline void setDeleteBlockTime(const TickType_t deleteBlockTime = 0) {
     this->deleteBlockTime = deleteBlockTime;
   }
+#endif /* FREERTOS_CPP_COMPACT */
 
   /**
    * Timer.hpp
@@ -704,20 +963,114 @@ class TimerBase {
    * @brief Set the delete block time.  This value is used when the destructor
    * calls deleteTimer().
    *
-   * @return TickType_t Delete block time in ticks.
+   * @return TickType_t Delete block time in ticks.  This is always 0 when
+   * FREERTOS_CPP_COMPACT is 1.
    */
   inline TickType_t getDeleteBlockTime() const {
+#if (FREERTOS_CPP_COMPACT == 1)
+    return 0;
+#else
     return deleteBlockTime;
+#endif /* FREERTOS_CPP_COMPACT */
   }
 
- protected:
+#if (FREERTOS_CPP_TIMER_STATISTICS == 1)
   /**
    * Timer.hpp
    *
-   * @brief Abstraction function that acts as the entry point of the timer
-   * callback for the user.
+   * @brief Function that returns a copy of the dispatch statistics of the
+   * timer.
+   *
+   * FREERTOS_CPP_TIMER_STATISTICS must be defined as 1 for this function to be
+   * available.
+   *
+   * A lateness that grows with the load shows that the timer service task
+   * priority (configTIMER_TASK_PRIORITY) is too low, or that other callbacks
+   * take too long.
+   *
+   * @return TimerStatistics The statistics recorded since the timer was
+   * created or resetStatistics() was last called.
+   *
+   * <b>Example Usage</b>
+   * @include Timer/statistics.cpp
    */
-  virtual void timerFunction() = 0;
+  inline TimerStatistics getStatistics() const {
+    taskENTER_CRITICAL();
+    const TimerStatistics copy = statistics;
+    taskEXIT_CRITICAL();
+    return copy;
+  }
+
+  /**
+   * Timer.hpp
+   *
+   * @brief Function that clears the dispatch statistics of the timer.
+   *
+   * FREERTOS_CPP_TIMER_STATISTICS must be defined as 1 for this function to be
+   * available.
+   */
+  inline void resetStatistics() {
+    taskENTER_CRITICAL();
+    statistics = TimerStatistics();
+    taskEXIT_CRITICAL();
+  }
+#endif /* FREERTOS_CPP_TIMER_STATISTICS */
+
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+  /**
+   * Timer.hpp
+   *
+   * @brief Function that sets how late the timer is allowed to expire so that
+   * its expiry can be coalesced with the expiry of other timers.
+   *
+   * A timer with a slack of more than one tick has its period rounded up to a
+   * multiple of the slack, and start(), reset() and changePeriod() (and their
+   * FromISR versions) place its expiry times on multiples of the slack.  Every
+   * timer that uses the same slack, or a multiple of it, therefore expires on
+   * the same ticks as the other timers with a nearby expiry time, and the timer
+   * service/daemon task processes all of them in a single wake up.  This
+   * reduces the number of context switches and, when configUSE_TICKLESS_IDLE is
+   * used, lets the processor stay asleep for longer.
+   *
+   * The time between starting the timer and its first expiry, and the time
+   * between subsequent expiries of an auto-reload timer, is at least the
+   * requested period and less than the requested period plus the slack.
+   * Powers of two make good slack values as they divide each other evenly.
+   *
+   * FREERTOS_CPP_TIMER_SLACK must be defined as 1 for this function to be
+   * available.
+   *
+   * @note The first expiry after the timer is started is placed on the grid by
+   * temporarily shortening or lengthening the period used by the kernel, and
+   * the requested period is restored by the first expiry.  getPeriod() returns
+   * the temporary period until then.  Set the slack while the timer is dormant.
+   *
+   * @param newSlack The slack of the timer in ticks.  A slack of 0 or 1 turns
+   * coalescing off.
+   *
+   * <b>Example Usage</b>
+   * @include Timer/slack.cpp
+   */
+  inline void setSlack(const TickType_t newSlack) {
+    slack = newSlack;
+    realign = false;
+    nominalPeriod = xTimerGetPeriod(handle);
+  }
+
+  /**
+   * Timer.hpp
+   *
+   * @brief Function that returns the slack set by setSlack().
+   *
+   * FREERTOS_CPP_TIMER_SLACK must be defined as 1 for this function to be
+   * available.
+   *
+   * @return TickType_t The slack of the timer in ticks.
+   */
+  inline TickType_t getSlack() const {
+    return slack;
+  }
+#endif /* FREERTOS_CPP_TIMER_SLACK */
 
  private:
   /**
@@ -729,10 +1082,17 @@ class TimerBase {
    * a base class for creating a task.
    *
    * @param deleteBlockTime Set the delete block time.  This value is used when
-   * the destructor calls deleteTimer().
+   * the destructor calls deleteTimer(), and is ignored when
+   * FREERTOS_CPP_COMPACT is 1.
    */
-  explicit TimerBase(const TickType_t deleteBlockTime = 0)
+#if (FREERTOS_CPP_COMPACT == 1)
+  constexpr explicit TimerBase(const TickType_t deleteBlockTime = 0) {
+    static_cast<void>(deleteBlockTime);
+  }
+#else
+  constexpr explicit TimerBase(const TickType_t deleteBlockTime = 0)
       : deleteBlockTime(deleteBlockTime) {}
+#endif /* FREERTOS_CPP_COMPACT */
 
   /**
    * Timer.hpp
@@ -753,8 +1113,111 @@ class TimerBase {
   TimerBase(TimerBase&&) noexcept = default;
   TimerBase& operator=(TimerBase&&) noexcept = default;
 
+#if (FREERTOS_CPP_TIMER_STATISTICS == 1)
+  inline static uint32_t executionCounter() {
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    return static_cast<uint32_t>(portGET_RUN_TIME_COUNTER_VALUE());
+#else
+    return static_cast<uint32_t>(xTaskGetTickCount());
+#endif /* configGENERATE_RUN_TIME_STATS */
+  }
+
+  inline uint32_t dispatchBegin() {
+    TickType_t due = xTimerGetExpiryTime(handle);
+    if (uxTimerGetReloadMode(handle) != pdFALSE) {
+      // An auto-reload timer has already been reloaded for its next expiry.
+      due -= xTimerGetPeriod(handle);
+    }
+    const TickType_t lateness = xTaskGetTickCount() - due;
+
+    UBaseType_t bucket = 0;
+    while ((bucket < (FREERTOS_CPP_TIMER_STATISTICS_BUCKETS - 1)) &&
+           ((lateness >> bucket) != 0)) {
+      bucket++;
+    }
+
+    taskENTER_CRITICAL();
+    statistics.dispatches++;
+    if (lateness < statistics.minLateness) {
+      statistics.minLateness = lateness;
+    }
+    if (lateness > statistics.maxLateness) {
+      statistics.maxLateness = lateness;
+    }
+    statistics.latenessHistogram[bucket]++;
+    taskEXIT_CRITICAL();
+
+    return executionCounter();
+  }
+
+  inline void dispatchEnd(const uint32_t begin) {
+    const uint32_t execution = executionCounter() - begin;
+    taskENTER_CRITICAL();
+    statistics.totalExecution += execution;
+    if (execution > statistics.maxExecution) {
+      statistics.maxExecution = execution;
+    }
+    taskEXIT_CRITICAL();
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+    restorePeriod();
+#endif /* FREERTOS_CPP_TIMER_SLACK */
+  }
+#else
+  inline static constexpr uint32_t dispatchBegin() {
+    return 0;
+  }
+
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+  inline void dispatchEnd(const uint32_t) {
+    restorePeriod();
+  }
+#else
+  inline void dispatchEnd(const uint32_t) const {}
+#endif /* FREERTOS_CPP_TIMER_SLACK */
+#endif /* FREERTOS_CPP_TIMER_STATISTICS */
+
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+  // Rounds period up to a multiple of the slack, remembers it and returns the
+  // delay from now to the first multiple of the slack at least period away.
+  inline TickType_t coalesce(const TickType_t period,
+                             const TickType_t now) const {
+    nominalPeriod = ((period + slack - 1) / slack) * slack;
+    const TickType_t delay =
+        nominalPeriod + ((slack - ((now + nominalPeriod) % slack)) % slack);
+    realign = (delay != nominalPeriod);
+    return delay;
+  }
+
+  // Called by the timer service task after the callback.  Puts the period of
+  // an auto-reload timer back once its first expiry has been aligned.
+  inline void restorePeriod() {
+    if (realign) {
+      if (uxTimerGetReloadMode(handle) == pdFALSE) {
+        realign = false;
+      } else if (xTimerChangePeriod(
+                     handle, coalesce(nominalPeriod, xTaskGetTickCount()),
+                     0) != pdPASS) {
+        // The command queue is full, try again on the next expiry.
+        realign = true;
+      }
+    }
+  }
+#endif /* FREERTOS_CPP_TIMER_SLACK */
+
   TimerHandle_t handle = NULL;
+#if (FREERTOS_CPP_COMPACT != 1)
   TickType_t deleteBlockTime;
+#endif /* FREERTOS_CPP_COMPACT */
+
+#if (FREERTOS_CPP_TIMER_STATISTICS == 1)
+  TimerStatistics statistics;
+#endif /* FREERTOS_CPP_TIMER_STATISTICS */
+
+#if (FREERTOS_CPP_TIMER_SLACK == 1)
+  TickType_t slack = 0;
+  mutable TickType_t nominalPeriod = 0;
+  mutable bool realign = false;
+#endif /* FREERTOS_CPP_TIMER_SLACK */
 };
 
 #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
@@ -801,8 +1264,8 @@ class Timer : public TimerBase {
    *
    * @note When calling <tt>xTimerCreate</tt> the constructor passes the
    * <tt>this</tt> pointer as the pvTimerID argument. This pointer is used so
-   * that the interface function callTimerFunction() can invoke timerFunction()
-   * for this instance of the class.
+   * that the static function timerEntry() can invoke timerFunction() for this
+   * instance of the class.
    *
    * @param period The period of the timer. The period is specified in ticks,
    * and the macro pdMS_TO_TICKS() can be used to convert a time specified in
@@ -833,12 +1296,28 @@ class Timer : public TimerBase {
                  const char* name = "", const TickType_t deleteBlockTime = 0)
       : TimerBase(deleteBlockTime) {
     this->handle = xTimerCreate(name, period, (autoReload ? pdTRUE : pdFALSE),
-                                this, callTimerFunction);
+                                this, timerEntry);
   }
   ~Timer() = default;
 
   Timer(Timer&&) noexcept = default;
   Timer& operator=(Timer&&) noexcept = default;
+
+  /**
+   * Timer.hpp
+   *
+   * @brief Abstraction function that acts as the entry point of the timer
+   * callback for the user.
+   */
+  virtual void timerFunction() = 0;
+
+ private:
+  static void timerEntry(TimerHandle_t timer) {
+    Timer* self = static_cast<Timer*>(pvTimerGetTimerID(timer));
+    const uint32_t begin = self->dispatchBegin();
+    self->timerFunction();
+    self->dispatchEnd(begin);
+  }
 };
 
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
@@ -870,6 +1349,35 @@ class StaticTimer : public TimerBase {
   StaticTimer(const StaticTimer&) = delete;
   StaticTimer& operator=(const StaticTimer&) = delete;
 
+  /**
+   * Timer.hpp
+   *
+   * @brief Function that calls <tt>TimerHandle_t xTimerCreateStatic( const
+   * char * const pcTimerName, const TickType_t xTimerPeriod, const UBaseType_t
+   * xAutoReload, void * const pvTimerID, TimerCallbackFunction_t
+   * pxCallbackFunction, StaticTimer_t *pxTimerBuffer )</tt> to create a timer
+   * that was constructed with FreeRTOS::deferCreate.
+   *
+   * @see <https://www.freertos.org/xTimerCreateStatic.html>
+   *
+   * @param period The period of the timer in ticks.  The timer period must be
+   * greater than 0.
+   * @param autoReload If autoReload is set to true, then the timer will expire
+   * repeatedly with a frequency set by the period parameter. If autoReload is
+   * set to false, then the timer will be a one-shot.
+   * @param name A human readable text name that is assigned to the timer.
+   * @retval true If the timer was created.
+   * @retval false Otherwise.
+   */
+  bool create(const TickType_t period, const bool autoReload = false,
+              const char* name = "") {
+    configASSERT(this->handle == NULL);
+    this->handle =
+        xTimerCreateStatic(name, period, (autoReload ? pdTRUE : pdFALSE), this,
+                           timerEntry, &staticTimer);
+    return (this->handle != NULL);
+  }
+
  protected:
   /**
    * Timer.hpp
@@ -884,8 +1392,8 @@ class StaticTimer : public TimerBase {
    *
    * @note When calling <tt>xTimerCreateStatic</tt> the constructor passes the
    * <tt>this</tt> pointer as the pvTimerID argument. This pointer is used so
-   * that the interface function callTimerFunction() can invoke timerFunction()
-   * for this instance of the class.
+   * that the static function timerEntry() can invoke timerFunction() for this
+   * instance of the class.
    *
    * @note Timers are created in the dormant state. The start(), reset(),
    * startFromISR(), resetFromISR(), changePeriod() and changePeriodFromISR()
@@ -920,25 +1428,337 @@ class StaticTimer : public TimerBase {
                        const char* name = "",
                        const TickType_t deleteBlockTime = 0)
       : TimerBase(deleteBlockTime) {
-    this->handle =
-        xTimerCreateStatic(name, period, (autoReload ? pdTRUE : pdFALSE), this,
-                           callTimerFunction, &staticTimer);
+    create(period, autoReload, name);
   }
+
+  /**
+   * Timer.hpp
+   *
+   * @brief Construct a new StaticTimer object without creating the timer.
+   *
+   * This constructor is constexpr, so a global object of a derived class with
+   * a constexpr constructor is constant initialized.  create() must be called
+   * before the timer is used.
+   *
+   * @param deleteBlockTime Specifies the time, in ticks, that the destructor
+   * waits for the delete command to be sent to the timer command queue.
+   */
+  constexpr explicit StaticTimer(DeferCreate,
+                                 const TickType_t deleteBlockTime = 0)
+      : TimerBase(deleteBlockTime), staticTimer() {}
   ~StaticTimer() = default;
 
   StaticTimer(StaticTimer&&) noexcept = default;
   StaticTimer& operator=(StaticTimer&&) noexcept = default;
 
+  /**
+   * Timer.hpp
+   *
+   * @brief Abstraction function that acts as the entry point of the timer
+   * callback for the user.
+   */
+  virtual void timerFunction() = 0;
+
  private:
+  static void timerEntry(TimerHandle_t timer) {
+    StaticTimer* self = static_cast<StaticTimer*>(pvTimerGetTimerID(timer));
+    const uint32_t begin = self->dispatchBegin();
+    self->timerFunction();
+    self->dispatchEnd(begin);
+  }
+
   StaticTimer_t staticTimer;
 };
 
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
-}  // namespace FreeRTOS
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+
+/**
+ * CrtpTimer Timer.hpp <FreeRTOS/Timer.hpp>
+ *
+ * @brief Class that encapsulates the functionality of a FreeRTOS timer without
+ * using virtual functions.
+ *
+ * This class behaves like FreeRTOS::Timer, but the timer callback calls
+ * Derived::timerFunction() directly instead of through a virtual function.  An
+ * object of a class derived from CrtpTimer therefore has no vtable pointer, and
+ * every timer callback saves an indirect call.
+ *
+ * @note This class is not intended to be instantiated by the user.  The user
+ * should create a class Derived that derives from CrtpTimer<Derived> and
+ * implements a public timerFunction().
+ *
+ * @tparam Derived The class that derives from this class.
+ *
+ * <b>Example Usage</b>
+ * @include Timer/crtpTimer.cpp
+ */
+template <class Derived>
+class CrtpTimer : public TimerBase {
+ public:
+  CrtpTimer(const CrtpTimer&) = delete;
+  CrtpTimer& operator=(const CrtpTimer&) = delete;
+
+ protected:
+  /**
+   * Timer.hpp
+   *
+   * @brief Construct a new CrtpTimer object by calling <tt>TimerHandle_t
+   * xTimerCreate( const char * const pcTimerName, const TickType_t
+   * xTimerPeriod, const UBaseType_t xAutoReload, void * const pvTimerID,
+   * TimerCallbackFunction_t pxCallbackFunction )</tt>
+   *
+   * @see <https://www.freertos.org/FreeRTOS-timers-xTimerCreate.html>
+   *
+   * The parameters are the same as those of FreeRTOS::Timer().
+   *
+   * @param period The period of the timer in ticks.  The timer period must be
+   * greater than 0.
+   * @param autoReload If autoReload is set to true, then the timer will expire
+   * repeatedly with a frequency set by the period parameter. If autoReload is
+   * set to false, then the timer will be a one-shot and enter the dormant state
+   * after it expires.
+   * @param name A human readable text name that is assigned to the timer.
+   * @param deleteBlockTime Specifies the time, in ticks, that the calling task
+   * should be held in the Blocked state to wait for the delete command to be
+   * successfully sent to the timer command queue when the destructor is
+   * called.
+   */
+  explicit CrtpTimer(const TickType_t period, const bool autoReload = false,
+                     const char* name = "",
+                     const TickType_t deleteBlockTime = 0)
+      : TimerBase(deleteBlockTime) {
+    this->handle = xTimerCreate(name, period, (autoReload ? pdTRUE : pdFALSE),
+                                this, timerEntry);
+  }
+  ~CrtpTimer() = default;
+
+  CrtpTimer(CrtpTimer&&) noexcept = default;
+  CrtpTimer& operator=(CrtpTimer&&) noexcept = default;
+
+ private:
+  static void timerEntry(TimerHandle_t timer) {
+    CrtpTimer* self = static_cast<CrtpTimer*>(pvTimerGetTimerID(timer));
+    const uint32_t begin = self->dispatchBegin();
+    static_cast<Derived*>(self)->timerFunction();
+    self->dispatchEnd(begin);
+  }
+};
+
+/**
+ * FunctionTimer Timer.hpp <FreeRTOS/Timer.hpp>
+ *
+ * @brief Class that calls a callable object, such as a lambda, each time a
+ * FreeRTOS timer expires, without using virtual functions.
+ *
+ * The callable is called from the timer service task.  It is called with a
+ * reference to the FunctionTimer if it accepts one, so that it can for example
+ * stop or change the period of the timer, otherwise it is called with no
+ * arguments.
+ *
+ * @tparam Function Type of the callable object.
+ *
+ * <b>Example Usage</b>
+ * @include Timer/functionTimer.cpp
+ */
+template <class Function>
+class FunctionTimer : public CrtpTimer<FunctionTimer<Function>> {
+ public:
+  /**
+   * Timer.hpp
+   *
+   * @brief Construct a new FunctionTimer object that calls function.
+   *
+   * @param function The callable object called when the timer expires.
+   * @param period The period of the timer in ticks.  The timer period must be
+   * greater than 0.
+   * @param autoReload If autoReload is set to true, then the timer will expire
+   * repeatedly with a frequency set by the period parameter. If autoReload is
+   * set to false, then the timer will be a one-shot and enter the dormant state
+   * after it expires.
+   * @param name A human readable text name that is assigned to the timer.
+   * @param deleteBlockTime Specifies the time, in ticks, that the calling task
+   * should be held in the Blocked state to wait for the delete command to be
+   * successfully sent to the timer command queue when the destructor is
+   * called.
+   */
+  explicit FunctionTimer(Function function, const TickType_t period,
+                         const bool autoReload = false, const char* name = "",
+                         const TickType_t deleteBlockTime = 0)
+      : CrtpTimer<FunctionTimer>(period, autoReload, name, deleteBlockTime),
+        function(std::move(function)) {}
+  ~FunctionTimer() = default;
+
+  FunctionTimer(const FunctionTimer&) = delete;
+  FunctionTimer& operator=(const FunctionTimer&) = delete;
+
+  inline void timerFunction() {
+    if constexpr (std::is_invocable_v<Function&, FunctionTimer&>) {
+      function(*this);
+    } else {
+      function();
+    }
+  }
+
+ private:
+  Function function;
+};
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+/**
+ * StaticCrtpTimer Timer.hpp <FreeRTOS/Timer.hpp>
+ *
+ * @brief Class that encapsulates the functionality of a FreeRTOS timer with
+ * statically allocated memory, without using virtual functions.
+ *
+ * This class behaves like FreeRTOS::StaticTimer, but the timer callback calls
+ * Derived::timerFunction() directly instead of through a virtual function.  An
+ * object of a class derived from StaticCrtpTimer therefore has no vtable
+ * pointer, and every timer callback saves an indirect call.
+ *
+ * @note This class is not intended to be instantiated by the user.  The user
+ * should create a class Derived that derives from StaticCrtpTimer<Derived> and
+ * implements a public timerFunction().
+ *
+ * @warning This class contains the timer data structure, so any instance of
+ * this class or class derived from this class should be persistent (not
+ * declared on the stack of another function).
+ *
+ * @tparam Derived The class that derives from this class.
+ *
+ * <b>Example Usage</b>
+ * @include Timer/crtpTimer.cpp
+ */
+template <class Derived>
+class StaticCrtpTimer : public TimerBase {
+ public:
+  StaticCrtpTimer(const StaticCrtpTimer&) = delete;
+  StaticCrtpTimer& operator=(const StaticCrtpTimer&) = delete;
+
+ protected:
+  /**
+   * Timer.hpp
+   *
+   * @brief Construct a new StaticCrtpTimer object by calling <tt>TimerHandle_t
+   * xTimerCreateStatic( const char * const pcTimerName, const TickType_t
+   * xTimerPeriod, const UBaseType_t xAutoReload, void * const pvTimerID,
+   * TimerCallbackFunction_t pxCallbackFunction StaticTimer_t *pxTimerBuffer
+   * )</tt>
+   *
+   * @see <https://www.freertos.org/xTimerCreateStatic.html>
+   *
+   * The parameters are the same as those of FreeRTOS::StaticTimer().
+   *
+   * @param period The period of the timer in ticks.  The timer period must be
+   * greater than 0.
+   * @param autoReload If autoReload is set to true, then the timer will expire
+   * repeatedly with a frequency set by the period parameter. If autoReload is
+   * set to false, then the timer will be a one-shot and enter the dormant state
+   * after it expires.
+   * @param name A human readable text name that is assigned to the timer.
+   * @param deleteBlockTime Specifies the time, in ticks, that the calling task
+   * should be held in the Blocked state to wait for the delete command to be
+   * successfully sent to the timer command queue when the destructor is
+   * called.
+   */
+  explicit StaticCrtpTimer(const TickType_t period,
+                           const bool autoReload = false,
+                           const char* name = "",
+                           const TickType_t deleteBlockTime = 0)
+      : TimerBase(deleteBlockTime) {
+    this->handle =
+        xTimerCreateStatic(name, period, (autoReload ? pdTRUE : pdFALSE), this,
+                           timerEntry, &staticTimer);
+  }
+  ~StaticCrtpTimer() = default;
+
+  StaticCrtpTimer(StaticCrtpTimer&&) noexcept = default;
+  StaticCrtpTimer& operator=(StaticCrtpTimer&&) noexcept = default;
+
+ private:
+  static void timerEntry(TimerHandle_t timer) {
+    StaticCrtpTimer* self =
+        static_cast<StaticCrtpTimer*>(pvTimerGetTimerID(timer));
+    const uint32_t begin = self->dispatchBegin();
+    static_cast<Derived*>(self)->timerFunction();
+    self->dispatchEnd(begin);
+  }
+
+  StaticTimer_t staticTimer;
+};
+
+/**
+ * StaticFunctionTimer Timer.hpp <FreeRTOS/Timer.hpp>
+ *
+ * @brief Class that calls a callable object, such as a lambda, each time a
+ * FreeRTOS timer with statically allocated memory expires, without using
+ * virtual functions.
+ *
+ * The callable is called from the timer service task.  It is called with a
+ * reference to the StaticFunctionTimer if it accepts one, so that it can for
+ * example stop or change the period of the timer, otherwise it is called with
+ * no arguments.
+ *
+ * @warning This class contains the timer data structure, so it should be
+ * persistent (not declared on the stack of another function).
+ *
+ * @tparam Function Type of the callable object.
+ *
+ * <b>Example Usage</b>
+ * @include Timer/functionTimer.cpp
+ */
+template <class Function>
+class StaticFunctionTimer
+    : public StaticCrtpTimer<StaticFunctionTimer<Function>> {
+ public:
+  /**
+   * Timer.hpp
+   *
+   * @brief Construct a new StaticFunctionTimer object that calls function.
+   *
+   * @param function The callable object called when the timer expires.
+   * @param period The period of the timer in ticks.  The timer period must be
+   * greater than 0.
+   * @param autoReload If autoReload is set to true, then the timer will expire
+   * repeatedly with a frequency set by the period parameter. If autoReload is
+   * set to false, then the timer will be a one-shot and enter the dormant state
+   * after it expires.
+   * @param name A human readable text name that is assigned to the timer.
+   * @param deleteBlockTime Specifies the time, in ticks, that the calling task
+   * should be held in the Blocked state to wait for the delete command to be
+   * successfully sent to the timer command queue when the destructor is
+   * called.
+   */
+  explicit StaticFunctionTimer(Function function, const TickType_t period,
+                               const bool autoReload = false,
+                               const char* name = "",
+                               const TickType_t deleteBlockTime = 0)
+      : StaticCrtpTimer<StaticFunctionTimer>(period, autoReload, name,
+                                             deleteBlockTime),
+        function(std::move(function)) {}
+  ~StaticFunctionTimer() = default;
+
+  StaticFunctionTimer(const StaticFunctionTimer&) = delete;
+  StaticFunctionTimer& operator=(const StaticFunctionTimer&) = delete;
+
+  inline void timerFunction() {
+    if constexpr (std::is_invocable_v<Function&, StaticFunctionTimer&>) {
+      function(*this);
+    } else {
+      function();
+    }
+  }
 
-inline void callTimerFunction(TimerHandle_t timer) {
-  static_cast<FreeRTOS::TimerBase*>(pvTimerGetTimerID(timer))->timerEntry();
-}
+ private:
+  Function function;
+};
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+}  // namespace FreeRTOS
 
 #endif  // FREERTOS_TIMER_HPP
@@ -0,0 +1,336 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_TIMERBATCH_HPP
+#define FREERTOS_TIMERBATCH_HPP
+
+#include <FreeRTOS/Timer.hpp>
+#include <atomic>
+
+#include "FreeRTOS.h"
+#include "timers.h"
+
+#if (INCLUDE_xTimerPendFunctionCall == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class TimerBatch TimerBatch.hpp <FreeRTOS/TimerBatch.hpp>
+ *
+ * @brief Class that collects start, stop, reset and change period operations
+ * on several timers and applies them together from the timer service task.
+ *
+ * The operations are recorded in the object without calling the kernel.
+ * apply() then sends a single <tt>xTimerPendFunctionCall()</tt> command to the
+ * timer service task, which performs all of the operations in one go.  The
+ * calling task therefore makes one queue operation and blocks at most once,
+ * however many timers are in the batch.
+ *
+ * The timer service task processes every command that the batch queues before
+ * it processes any timer expiry, so no timer callback runs part way through a
+ * batch.  This makes the batch suitable for switching a group of timers from
+ * one mode to another.
+ *
+ * INCLUDE_xTimerPendFunctionCall must be defined as 1 for this class to be
+ * available.
+ *
+ * @warning The batch must not be modified or destroyed while isPending() is
+ * true.
+ *
+ * @tparam N The maximum number of operations in the batch.  The operations
+ * are queued to the timer service task from its own context, where they can
+ * not block, so N must be less than configTIMER_QUEUE_LENGTH.
+ *
+ * <b>Example Usage</b>
+ * @include TimerBatch/timerBatch.cpp
+ */
+template <UBaseType_t N>
+class TimerBatch {
+  static_assert(N > 0, "N must be at least 1.");
+  static_assert(N < configTIMER_QUEUE_LENGTH,
+                "N must be less than configTIMER_QUEUE_LENGTH.");
+
+ public:
+  TimerBatch() = default;
+  ~TimerBatch() = default;
+
+  TimerBatch(const TimerBatch&) = delete;
+  TimerBatch& operator=(const TimerBatch&) = delete;
+
+  /**
+   * TimerBatch.hpp
+   *
+   * @brief Function that adds FreeRTOS::TimerBase::start() on timer to the
+   * batch.
+   *
+   * @param timer The timer to start.
+   * @retval true The operation was added.
+   * @retval false The batch is full or pending.
+   */
+  inline bool start(const TimerBase& timer) {
+    return add(Command::Start, timer, 0);
+  }
+
+  /**
+   * TimerBatch.hpp
+   *
+   * @brief Function that adds FreeRTOS::TimerBase::stop() on timer to the
+   * batch.
+   *
+   * @param timer The timer to stop.
+   * @retval true The operation was added.
+   * @retval false The batch is full or pending.
+   */
+  inline bool stop(const TimerBase& timer) {
+    return add(Command::Stop, timer, 0);
+  }
+
+  /**
+   * TimerBatch.hpp
+   *
+   * @brief Function that adds FreeRTOS::TimerBase::reset() on timer to the
+   * batch.
+   *
+   * @param timer The timer to reset.
+   * @retval true The operation was added.
+   * @retval false The batch is full or pending.
+   */
+  inline bool reset(const TimerBase& timer) {
+    return add(Command::Reset, timer, 0);
+  }
+
+  /**
+   * TimerBatch.hpp
+   *
+   * @brief Function that adds FreeRTOS::TimerBase::changePeriod() on timer to
+   * the batch.  Changing the period also starts the timer.
+   *
+   * @param timer The timer whose period is changed.
+   * @param newPeriod The new period in ticks.
+   * @retval true The operation was added.
+   * @retval false The batch is full or pending.
+   */
+  inline bool changePeriod(const TimerBase& timer, const TickType_t newPeriod) {
+    return add(Command::ChangePeriod, timer, newPeriod);
+  }
+
+  /**
+   * TimerBatch.hpp
+   *
+   * @brief Function that removes every operation from the batch.
+   *
+   * @retval true The batch was cleared.
+   * @retval false The batch is pending, so it was not cleared.
+   */
+  inline bool clear() {
+    if (isPending()) {
+      return false;
+    }
+    count = 0;
+    return true;
+  }
+
+  /**
+   * TimerBatch.hpp
+   *
+   * @brief Function that returns the number of operations in the batch.
+   *
+   * @return UBaseType_t The number of operations.
+   */
+  inline UBaseType_t size() const {
+    return count;
+  }
+
+  /**
+   * TimerBatch.hpp
+   *
+   * @brief Function that returns whether the batch has been sent to the timer
+   * service task and not yet been applied.
+   *
+   * @retval true The batch is waiting to be applied.
+   * @retval false Otherwise.
+   */
+  inline bool isPending() const {
+    return pending.load(std::memory_order_acquire);
+  }
+
+  /**
+   * TimerBatch.hpp
+   *
+   * @brief Function that returns the number of operations of the last applied
+   * batch that could not be queued because the timer command queue was full.
+   *
+   * @return UBaseType_t The number of operations that failed.
+   */
+  inline UBaseType_t getFailures() const {
+    return failures;
+  }
+
+  /**
+   * TimerBatch.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTimerPendFunctionCall(
+   * PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t
+   * ulParameter2, TickType_t xTicksToWait )</tt> to apply the batch from the
+   * timer service task.
+   *
+   * @see <https://www.freertos.org/xTimerPendFunctionCall.html>
+   *
+   * The operations stay in the batch after it has been applied, so the same
+   * batch can be applied again once isPending() is false.
+   *
+   * @param ticksToWait The maximum amount of time the calling task should
+   * remain in the Blocked state to wait for space on the timer command queue.
+   * @retval true The batch was sent to the timer service task.
+   * @retval false The batch is empty or already pending, or the timer command
+   * queue remained full for ticksToWait.
+   */
+  bool apply(const TickType_t ticksToWait = 0) {
+    if (!markPending()) {
+      return false;
+    }
+    if (xTimerPendFunctionCall(execute, this, 0, ticksToWait) != pdPASS) {
+      pending.store(false, std::memory_order_release);
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * TimerBatch.hpp
+   *
+   * @brief Function that calls <tt>BaseType_t xTimerPendFunctionCallFromISR(
+   * PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t
+   * ulParameter2, BaseType_t *pxHigherPriorityTaskWoken )</tt> to apply the
+   * batch from the timer service task.
+   *
+   * @see <https://www.freertos.org/xTimerPendFunctionCallFromISR.html>
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if the
+   * timer service task has a priority higher than the currently running task.
+   * @retval true The batch was sent to the timer service task.
+   * @retval false The batch is empty or already pending, or the timer command
+   * queue was full.
+   */
+  bool applyFromISR(bool& higherPriorityTaskWoken) {
+    if (!markPending()) {
+      return false;
+    }
+    BaseType_t taskWoken = pdFALSE;
+    if (xTimerPendFunctionCallFromISR(execute, this, 0, &taskWoken) !=
+        pdPASS) {
+      pending.store(false, std::memory_order_release);
+      return false;
+    }
+    if (taskWoken == pdTRUE) {
+      higherPriorityTaskWoken = true;
+    }
+    return true;
+  }
+
+  /**
+   * TimerBatch.hpp
+   *
+   * @overload
+   */
+  bool applyFromISR() {
+    if (!markPending()) {
+      return false;
+    }
+    if (xTimerPendFunctionCallFromISR(execute, this, 0, NULL) != pdPASS) {
+      pending.store(false, std::memory_order_release);
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  enum class Command : uint8_t { Start, Stop, Reset, ChangePeriod };
+
+  struct Operation {
+    const TimerBase* timer;
+    TickType_t period;
+    Command command;
+  };
+
+  inline bool add(const Command command, const TimerBase& timer,
+                  const TickType_t period) {
+    if (isPending() || (count >= N)) {
+      return false;
+    }
+    operations[count++] = {&timer, period, command};
+    return true;
+  }
+
+  inline bool markPending() {
+    if ((count == 0) || isPending()) {
+      return false;
+    }
+    pending.store(true, std::memory_order_release);
+    return true;
+  }
+
+  static void execute(void* parameter, uint32_t) {
+    TimerBatch* batch = static_cast<TimerBatch*>(parameter);
+    UBaseType_t failed = 0;
+    for (UBaseType_t i = 0; i < batch->count; i++) {
+      const Operation& operation = batch->operations[i];
+      bool queued = false;
+      switch (operation.command) {
+        case Command::Start:
+          queued = operation.timer->start(0);
+          break;
+        case Command::Stop:
+          queued = operation.timer->stop(0);
+          break;
+        case Command::Reset:
+          queued = operation.timer->reset(0);
+          break;
+        case Command::ChangePeriod:
+          queued = operation.timer->changePeriod(operation.period, 0);
+          break;
+      }
+      if (!queued) {
+        failed++;
+      }
+    }
+    batch->failures = failed;
+    batch->pending.store(false, std::memory_order_release);
+  }
+
+  Operation operations[N];
+  UBaseType_t count = 0;
+  UBaseType_t failures = 0;
+  std::atomic<bool> pending{false};
+};
+
+}  // namespace FreeRTOS
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+
+#endif  // FREERTOS_TIMERBATCH_HPP
@@ -0,0 +1,467 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_TIMERPOOL_HPP
+#define FREERTOS_TIMERPOOL_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1) && \
+    (INCLUDE_xTimerPendFunctionCall == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class StaticTimerPool TimerPool.hpp <FreeRTOS/TimerPool.hpp>
+ *
+ * @brief Class that owns a fixed number of statically allocated one-shot
+ * timers and lends them out with a callback stored inside the pool.
+ *
+ * Every timer is created when the pool is constructed, so acquiring and
+ * releasing a timer never touches the heap.  acquire() copies or moves the
+ * callback, typically a lambda, into storage that belongs to the timer slot
+ * and returns a StaticTimerPool::PooledTimer that owns the slot.  The slot is
+ * returned to the pool when the PooledTimer is destroyed or release() is
+ * called.
+ *
+ * Releasing a slot queues a stop command followed by a pended function to the
+ * timer service task.  The callback is destroyed and the slot becomes free
+ * when the timer service task runs the pended function, so the callback is
+ * never destroyed while it is running and a stale expiry can never call the
+ * callback of the next owner of the slot.  A callback can still run if the
+ * timer expires after the PooledTimer was released but before the timer
+ * service task processed the stop command.
+ *
+ * configSUPPORT_STATIC_ALLOCATION and INCLUDE_xTimerPendFunctionCall must be
+ * defined as 1 for this class to be available.
+ *
+ * @warning A PooledTimer must not be released from inside its own callback.
+ * Releasing from an interrupt is not supported.
+ *
+ * @tparam N The number of timers in the pool.
+ * @tparam CallbackSize The number of bytes of storage for the callback of each
+ * timer.  Callbacks that do not fit are rejected at compile time.
+ *
+ * <b>Example Usage</b>
+ * @include TimerPool/timerPool.cpp
+ */
+template <UBaseType_t N, size_t CallbackSize = 4 * sizeof(void*)>
+class StaticTimerPool {
+  static_assert(N > 0, "N must be at least 1.");
+
+  struct Slot {
+    StaticTimer_t timerBuffer;
+    TimerHandle_t handle = NULL;
+    alignas(std::max_align_t) unsigned char storage[CallbackSize];
+    void (*invoke)(void*) = nullptr;
+    void (*destroy)(void*) = nullptr;
+    bool inUse = false;
+  };
+
+ public:
+  /**
+   * @class PooledTimer TimerPool.hpp <FreeRTOS/TimerPool.hpp>
+   *
+   * @brief Move only handle to a timer from a FreeRTOS::StaticTimerPool.
+   */
+  class PooledTimer {
+   public:
+    /**
+     * TimerPool.hpp
+     *
+     * @brief Construct a PooledTimer that does not own a timer.
+     */
+    PooledTimer() = default;
+
+    /**
+     * TimerPool.hpp
+     *
+     * @brief Destroy the PooledTimer object, which returns its timer to the
+     * pool.  The destructor blocks until the release commands have been
+     * queued.
+     */
+    ~PooledTimer() {
+      release(portMAX_DELAY);
+    }
+
+    PooledTimer(const PooledTimer&) = delete;
+    PooledTimer& operator=(const PooledTimer&) = delete;
+
+    PooledTimer(PooledTimer&& other) noexcept : slot(other.slot) {
+      other.slot = nullptr;
+    }
+
+    PooledTimer& operator=(PooledTimer&& other) noexcept {
+      if (this != &other) {
+        release(portMAX_DELAY);
+        slot = other.slot;
+        other.slot = nullptr;
+      }
+      return *this;
+    }
+
+    /**
+     * TimerPool.hpp
+     *
+     * @brief Function that checks whether the handle owns a timer.
+     *
+     * @retval true The handle owns a timer.
+     * @retval false The pool was empty when the handle was acquired, or it has
+     * been released or moved from.
+     */
+    inline bool isValid() const {
+      return (slot != nullptr);
+    }
+
+    /**
+     * TimerPool.hpp
+     *
+     * @brief Function that calls <tt>BaseType_t xTimerChangePeriod(
+     * TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xBlockTime
+     * )</tt> to start the timer so that the callback is called delay ticks from
+     * now.  Starting an active timer restarts it.
+     *
+     * @see <https://www.freertos.org/FreeRTOS-timers-xTimerChangePeriod.html>
+     *
+     * @param delay The time in ticks until the callback is called.  Must be
+     * greater than 0.
+     * @param blockTime The maximum time to wait for space in the timer command
+     * queue.
+     * @retval true The command was sent to the timer command queue.
+     * @retval false The command could not be sent.
+     */
+    inline bool start(const TickType_t delay,
+                      const TickType_t blockTime = 0) const {
+      return (xTimerChangePeriod(slot->handle, delay, blockTime) == pdPASS);
+    }
+
+    /**
+     * TimerPool.hpp
+     *
+     * @brief Function that calls <tt>BaseType_t xTimerChangePeriodFromISR(
+     * TimerHandle_t xTimer, TickType_t xNewPeriod, BaseType_t
+     * *pxHigherPriorityTaskWoken )</tt>
+     *
+     * @see
+     * <https://www.freertos.org/FreeRTOS-timers-xTimerChangePeriodFromISR.html>
+     *
+     * A version of start() that can be called from an interrupt service
+     * routine.
+     *
+     * @param higherPriorityTaskWoken Set to true if the timer service task was
+     * woken and a context switch should be requested before the interrupt
+     * exits.
+     * @param delay The time in ticks until the callback is called.
+     * @retval true The command was sent to the timer command queue.
+     * @retval false The timer command queue was full.
+     */
+    inline bool startFromISR(bool& higherPriorityTaskWoken,
+                             const TickType_t delay) const {
+      BaseType_t taskWoken = pdFALSE;
+      const bool result = (xTimerChangePeriodFromISR(slot->handle, delay,
+                                                     &taskWoken) == pdPASS);
+      if (taskWoken == pdTRUE) {
+        higherPriorityTaskWoken = true;
+      }
+      return result;
+    }
+
+    /**
+     * TimerPool.hpp
+     *
+     * @brief Function that calls <tt>BaseType_t xTimerChangePeriodFromISR(
+     * TimerHandle_t xTimer, TickType_t xNewPeriod, BaseType_t
+     * *pxHigherPriorityTaskWoken )</tt>
+     *
+     * @see
+     * <https://www.freertos.org/FreeRTOS-timers-xTimerChangePeriodFromISR.html>
+     *
+     * @overload
+     */
+    inline bool startFromISR(const TickType_t delay) const {
+      return (xTimerChangePeriodFromISR(slot->handle, delay, NULL) == pdPASS);
+    }
+
+    /**
+     * TimerPool.hpp
+     *
+     * @brief Function that calls <tt>BaseType_t xTimerStop( TimerHandle_t
+     * xTimer, TickType_t xBlockTime )</tt>
+     *
+     * @see <https://www.freertos.org/FreeRTOS-timers-xTimerStop.html>
+     *
+     * @param blockTime The maximum time to wait for space in the timer command
+     * queue.
+     * @retval true The command was sent to the timer command queue.
+     * @retval false The command could not be sent.
+     */
+    inline bool stop(const TickType_t blockTime = 0) const {
+      return (xTimerStop(slot->handle, blockTime) == pdPASS);
+    }
+
+    /**
+     * TimerPool.hpp
+     *
+     * @brief Function that calls <tt>BaseType_t xTimerStopFromISR(
+     * TimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken )</tt>
+     *
+     * @see <https://www.freertos.org/FreeRTOS-timers-xTimerStopFromISR.html>
+     *
+     * @param higherPriorityTaskWoken Set to true if the timer service task was
+     * woken and a context switch should be requested before the interrupt
+     * exits.
+     * @retval true The command was sent to the timer command queue.
+     * @retval false The timer command queue was full.
+     */
+    inline bool stopFromISR(bool& higherPriorityTaskWoken) const {
+      BaseType_t taskWoken = pdFALSE;
+      const bool result =
+          (xTimerStopFromISR(slot->handle, &taskWoken) == pdPASS);
+      if (taskWoken == pdTRUE) {
+        higherPriorityTaskWoken = true;
+      }
+      return result;
+    }
+
+    /**
+     * TimerPool.hpp
+     *
+     * @brief Function that calls <tt>BaseType_t xTimerStopFromISR(
+     * TimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken )</tt>
+     *
+     * @see <https://www.freertos.org/FreeRTOS-timers-xTimerStopFromISR.html>
+     *
+     * @overload
+     */
+    inline bool stopFromISR() const {
+      return (xTimerStopFromISR(slot->handle, NULL) == pdPASS);
+    }
+
+    /**
+     * TimerPool.hpp
+     *
+     * @brief Function that calls <tt>BaseType_t xTimerIsTimerActive(
+     * TimerHandle_t xTimer )</tt>
+     *
+     * @see <https://www.freertos.org/FreeRTOS-timers-xTimerIsTimerActive.html>
+     *
+     * @retval true The timer is waiting to expire.
+     * @retval false The timer is dormant.
+     */
+    inline bool isActive() const {
+      return (xTimerIsTimerActive(slot->handle) != pdFALSE);
+    }
+
+    /**
+     * TimerPool.hpp
+     *
+     * @brief Function that returns the timer to its pool.  The handle no longer
+     * owns a timer if this function returns true.
+     *
+     * When called from the timer service task, for example from the callback
+     * of another timer, the slot is freed immediately and blockTime is
+     * ignored.
+     *
+     * @param blockTime The maximum time to wait for space in the timer command
+     * queue.
+     * @retval true The timer was released, or the handle did not own a timer.
+     * @retval false The release commands could not be queued.  The handle
+     * still owns the timer.
+     */
+    inline bool release(const TickType_t blockTime = 0) {
+      if (slot == nullptr) {
+        return true;
+      }
+      if (xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle()) {
+        // The stop command is processed before any further expiry.
+        const BaseType_t stopped = xTimerStop(slot->handle, 0);
+        configASSERT(stopped == pdPASS);
+        static_cast<void>(stopped);
+        freeSlot(slot, 0);
+      } else if ((xTimerStop(slot->handle, blockTime) != pdPASS) ||
+                 (xTimerPendFunctionCall(freeSlot, slot, 0, blockTime) !=
+                  pdPASS)) {
+        return false;
+      }
+      slot = nullptr;
+      return true;
+    }
+
+   private:
+    friend class StaticTimerPool;
+
+    explicit PooledTimer(Slot* slot) : slot(slot) {}
+
+    Slot* slot = nullptr;
+  };
+
+  /**
+   * TimerPool.hpp
+   *
+   * @brief Construct a new StaticTimerPool object by calling <tt>TimerHandle_t
+   * xTimerCreateStatic( const char * const pcTimerName, const TickType_t
+   * xTimerPeriod, const UBaseType_t uxAutoReload, void * const pvTimerID,
+   * TimerCallbackFunction_t pxCallbackFunction StaticTimer_t *pxTimerBuffer
+   * )</tt> once for each timer in the pool.
+   *
+   * @see <https://www.freertos.org/xTimerCreateStatic.html>
+   *
+   * @param name The name given to every timer in the pool.
+   */
+  explicit StaticTimerPool(const char* name = "") {
+    for (Slot& slot : slots) {
+      slot.handle = xTimerCreateStatic(name, 1, pdFALSE, &slot, timerEntry,
+                                       &slot.timerBuffer);
+    }
+  }
+
+  /**
+   * TimerPool.hpp
+   *
+   * @brief Destroy the StaticTimerPool object, which deletes every timer.
+   *
+   * @warning Every PooledTimer must have been released, and the timer service
+   * task must have processed the release, before the pool is destroyed.
+   */
+  ~StaticTimerPool() {
+    for (Slot& slot : slots) {
+      if (slot.handle != NULL) {
+        xTimerDelete(slot.handle, portMAX_DELAY);
+      }
+    }
+  }
+
+  StaticTimerPool(const StaticTimerPool&) = delete;
+  StaticTimerPool& operator=(const StaticTimerPool&) = delete;
+
+  /**
+   * TimerPool.hpp
+   *
+   * @brief Function that takes a dormant timer from the pool and stores
+   * function as its callback.
+   *
+   * @param function A callable, typically a lambda, taking no arguments.  It
+   * is called from the timer service task each time the timer expires, so it
+   * must not block.
+   * @return PooledTimer The handle that owns the timer.  The handle is not
+   * valid if every timer in the pool is in use.
+   *
+   * <b>Example Usage</b>
+   * @include TimerPool/timerPool.cpp
+   */
+  template <class Function>
+  PooledTimer acquire(Function&& function) {
+    using Callable = std::decay_t<Function>;
+    static_assert(std::is_invocable_v<Callable&>,
+                  "The callback must be callable with no arguments.");
+    static_assert(sizeof(Callable) <= CallbackSize,
+                  "The callback does not fit in CallbackSize bytes.");
+    static_assert(alignof(Callable) <= alignof(std::max_align_t),
+                  "The callback is over aligned.");
+
+    Slot* slot = claimSlot();
+    if (slot == nullptr) {
+      return PooledTimer();
+    }
+    new (slot->storage) Callable(std::forward<Function>(function));
+    slot->destroy = [](void* storage) {
+      static_cast<Callable*>(storage)->~Callable();
+    };
+    slot->invoke = [](void* storage) { (*static_cast<Callable*>(storage))(); };
+    return PooledTimer(slot);
+  }
+
+  /**
+   * TimerPool.hpp
+   *
+   * @brief Function that returns the number of timers that can currently be
+   * acquired.
+   *
+   * @return UBaseType_t The number of free timers.
+   */
+  inline UBaseType_t available() const {
+    UBaseType_t count = 0;
+    taskENTER_CRITICAL();
+    for (const Slot& slot : slots) {
+      if (!slot.inUse && (slot.handle != NULL)) {
+        count++;
+      }
+    }
+    taskEXIT_CRITICAL();
+    return count;
+  }
+
+ private:
+  inline Slot* claimSlot() {
+    Slot* claimed = nullptr;
+    taskENTER_CRITICAL();
+    for (Slot& slot : slots) {
+      if (!slot.inUse && (slot.handle != NULL)) {
+        slot.inUse = true;
+        claimed = &slot;
+        break;
+      }
+    }
+    taskEXIT_CRITICAL();
+    return claimed;
+  }
+
+  // Runs in the timer service task after the stop command of the slot.
+  static void freeSlot(void* parameter, uint32_t) {
+    Slot* slot = static_cast<Slot*>(parameter);
+    slot->invoke = nullptr;
+    slot->destroy(slot->storage);
+    slot->destroy = nullptr;
+    taskENTER_CRITICAL();
+    slot->inUse = false;
+    taskEXIT_CRITICAL();
+  }
+
+  static void timerEntry(TimerHandle_t timer) {
+    Slot* slot = static_cast<Slot*>(pvTimerGetTimerID(timer));
+    if (slot->invoke != nullptr) {
+      slot->invoke(slot->storage);
+    }
+  }
+
+  Slot slots[N];
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION && INCLUDE_xTimerPendFunctionCall \
+        */
+
+#endif  // FREERTOS_TIMERPOOL_HPP
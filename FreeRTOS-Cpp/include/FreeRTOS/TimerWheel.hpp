@@ -0,0 +1,412 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_TIMERWHEEL_HPP
+#define FREERTOS_TIMERWHEEL_HPP
+
+#include <FreeRTOS/Timer.hpp>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+template <UBaseType_t, UBaseType_t>
+class TimerWheel;
+
+/**
+ * @class WheelTimer TimerWheel.hpp <FreeRTOS/TimerWheel.hpp>
+ *
+ * @brief Class that holds one logical timer of a FreeRTOS::TimerWheel.
+ *
+ * A WheelTimer is an intrusive list node plus a callback.  It contains no
+ * kernel object, so arming, re-arming and cancelling it never sends a command
+ * to the timer service task.
+ *
+ * @warning A WheelTimer must not be destroyed while it is armed.
+ */
+class WheelTimer {
+ public:
+  /**
+   * @brief Function called from the timer service task when the timer
+   * expires.
+   */
+  using Callback = void (*)(void* argument);
+
+  /**
+   * TimerWheel.hpp
+   *
+   * @brief Construct a new WheelTimer object.
+   *
+   * @param callback Function called when the timer expires.
+   * @param argument Value passed to callback.
+   */
+  explicit WheelTimer(const Callback callback, void* argument = nullptr)
+      : callback(callback), argument(argument) {}
+  ~WheelTimer() = default;
+
+  WheelTimer(const WheelTimer&) = delete;
+  WheelTimer& operator=(const WheelTimer&) = delete;
+
+  /**
+   * TimerWheel.hpp
+   *
+   * @brief Function that returns whether the timer is armed.
+   *
+   * @retval true The timer is armed and has not expired or been cancelled.
+   * @retval false Otherwise.
+   */
+  inline bool isArmed() const {
+    return (pprev != nullptr);
+  }
+
+ private:
+  template <UBaseType_t, UBaseType_t>
+  friend class TimerWheel;
+
+  WheelTimer* next = nullptr;
+  WheelTimer** pprev = nullptr;
+  uint32_t expiry = 0;
+  const Callback callback;
+  void* const argument;
+};
+
+/**
+ * @class TimerWheel TimerWheel.hpp <FreeRTOS/TimerWheel.hpp>
+ *
+ * @brief Class that multiplexes any number of FreeRTOS::WheelTimer objects onto
+ * one auto-reload FreeRTOS timer using a hierarchical timer wheel.
+ *
+ * The wheel advances one step every resolution ticks.  Level 0 has Slots
+ * slots of one step each, level 1 has Slots slots of Slots steps each, and so
+ * on.  A timer is linked into the slot of the lowest level that covers its
+ * expiry; arm() and cancel() are O(1) and only take a short critical section.
+ * When a step crosses the boundary of a higher level slot, the timers in that
+ * slot are moved down one level, so each timer is moved at most Levels - 1
+ * times before it expires.
+ *
+ * The callbacks are called from the timer service task, in the context of
+ * the callback of the underlying timer, so the same rules apply as to any
+ * other timer callback.  A callback may arm its own timer again.
+ *
+ * @warning This class contains the timer data structure and the wheel, so the
+ * user should create this object as a global object or with static storage
+ * duration.
+ *
+ * @tparam Slots The number of slots per level.  Must be a power of 2.
+ * @tparam Levels The number of levels.  The longest delay is
+ * (Slots - 1) * Slots^(Levels - 1) steps.
+ *
+ * <b>Example Usage</b>
+ * @include TimerWheel/timerWheel.cpp
+ */
+template <UBaseType_t Slots = 32, UBaseType_t Levels = 3>
+class TimerWheel : public StaticCrtpTimer<TimerWheel<Slots, Levels>> {
+  static_assert((Slots > 1) && ((Slots & (Slots - 1)) == 0),
+                "Slots must be a power of 2.");
+  static_assert(Levels > 0, "Levels must be at least 1.");
+
+ public:
+  /**
+   * TimerWheel.hpp
+   *
+   * @brief Construct a new TimerWheel object and its underlying auto-reload
+   * timer.  Call start() to start the wheel.
+   *
+   * @param resolution The number of ticks per step of the wheel.  Delays are
+   * rounded up to a whole number of steps.
+   * @param name A human readable text name that is assigned to the timer.
+   */
+  explicit TimerWheel(const TickType_t resolution = 1,
+                      const char* name = "TimerWheel")
+      : StaticCrtpTimer<TimerWheel>(resolution, true, name),
+        resolution(resolution) {
+    configASSERT(resolution > 0);
+  }
+  ~TimerWheel() = default;
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  /**
+   * TimerWheel.hpp
+   *
+   * @brief Function that returns the longest delay, in ticks, that can be
+   * passed to arm().
+   *
+   * @return TickType_t The longest delay in ticks.
+   */
+  inline TickType_t getMaxDelay() const {
+    return static_cast<TickType_t>(maxSteps * resolution);
+  }
+
+  /**
+   * TimerWheel.hpp
+   *
+   * @brief Function that arms timer to expire after ticks.  If timer is
+   * already armed it is re-armed, so this can also be used to reset it.  No
+   * command is sent to the timer service task.
+   *
+   * @param timer The timer to arm.
+   * @param ticks The delay in ticks.  It is rounded up to a whole number of
+   * steps, and a delay of 0 expires on the next step.
+   * @retval true The timer was armed.
+   * @retval false ticks is more than getMaxDelay(), so the timer was not armed.
+   */
+  bool arm(WheelTimer& timer, const TickType_t ticks) {
+    taskENTER_CRITICAL();
+    const bool result = link(timer, ticks);
+    taskEXIT_CRITICAL();
+    return result;
+  }
+
+  /**
+   * TimerWheel.hpp
+   *
+   * @brief Function that arms timer from an ISR.
+   *
+   * @see arm()
+   *
+   * @param timer The timer to arm.
+   * @param ticks The delay in ticks.
+   * @retval true The timer was armed.
+   * @retval false ticks is more than getMaxDelay(), so the timer was not armed.
+   */
+  bool armFromISR(WheelTimer& timer, const TickType_t ticks) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool result = link(timer, ticks);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return result;
+  }
+
+  /**
+   * TimerWheel.hpp
+   *
+   * @brief Function that cancels timer.  No command is sent to the timer
+   * service task.
+   *
+   * @param timer The timer to cancel.
+   * @retval true The timer was armed and has been cancelled.
+   * @retval false The timer was not armed.
+   */
+  bool cancel(WheelTimer& timer) {
+    taskENTER_CRITICAL();
+    const bool result = unlink(timer);
+    taskEXIT_CRITICAL();
+    return result;
+  }
+
+  /**
+   * TimerWheel.hpp
+   *
+   * @brief Function that cancels timer from an ISR.
+   *
+   * @see cancel()
+   *
+   * @param timer The timer to cancel.
+   * @retval true The timer was armed and has been cancelled.
+   * @retval false The timer was not armed.
+   */
+  bool cancelFromISR(WheelTimer& timer) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool result = unlink(timer);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return result;
+  }
+
+  /**
+   * TimerWheel.hpp
+   *
+   * @brief Function that advances the wheel by one step.  It is called by the
+   * underlying timer and should not be called by the user.
+   */
+  void timerFunction() {
+    taskENTER_CRITICAL();
+    const uint32_t step = ++now;
+    taskEXIT_CRITICAL();
+
+    UBaseType_t level = 1;
+    while ((level < Levels) && ((step & lowMask(level)) == 0)) {
+      level++;
+    }
+    while (--level > 0) {
+      cascade(level, slotIndex(step, level));
+    }
+    expire(slotIndex(step, 0));
+  }
+
+ private:
+  static constexpr UBaseType_t bits() {
+    UBaseType_t result = 0;
+    while ((static_cast<UBaseType_t>(1) << result) < Slots) {
+      result++;
+    }
+    return result;
+  }
+
+  static constexpr uint32_t power(const UBaseType_t exponent) {
+    uint32_t result = 1;
+    for (UBaseType_t i = 0; i < exponent; i++) {
+      result *= Slots;
+    }
+    return result;
+  }
+
+  static constexpr UBaseType_t Bits = bits();
+  static constexpr uint32_t maxSteps = (Slots - 1) * power(Levels - 1);
+
+  static_assert(Bits * Levels < 32,
+                "The wheel must span less than 2^32 steps.");
+
+  static constexpr uint32_t lowMask(const UBaseType_t level) {
+    return (static_cast<uint32_t>(1) << (Bits * level)) - 1;
+  }
+
+  static constexpr UBaseType_t slotIndex(const uint32_t step,
+                                         const UBaseType_t level) {
+    return (step >> (Bits * level)) & (Slots - 1);
+  }
+
+  static inline void push(WheelTimer** head, WheelTimer& timer) {
+    timer.next = *head;
+    if (timer.next != nullptr) {
+      timer.next->pprev = &timer.next;
+    }
+    *head = &timer;
+    timer.pprev = head;
+  }
+
+  static inline bool unlink(WheelTimer& timer) {
+    if (timer.pprev == nullptr) {
+      return false;
+    }
+    *timer.pprev = timer.next;
+    if (timer.next != nullptr) {
+      timer.next->pprev = timer.pprev;
+    }
+    timer.next = nullptr;
+    timer.pprev = nullptr;
+    return true;
+  }
+
+  // Returns how many slots of level lie between now and expiry, allowing for
+  // the step counter wrapping around.
+  inline uint32_t distance(const uint32_t expiry,
+                           const UBaseType_t level) const {
+    const UBaseType_t shift = Bits * level;
+    return ((expiry >> shift) - (now >> shift)) & (UINT32_MAX >> shift);
+  }
+
+  // Must be called in a critical section.
+  inline void place(WheelTimer& timer) {
+    UBaseType_t level = 0;
+    while ((level < (Levels - 1)) && (distance(timer.expiry, level) >= Slots)) {
+      level++;
+    }
+    push(&wheel[level][slotIndex(timer.expiry, level)], timer);
+  }
+
+  // Must be called in a critical section.
+  inline bool link(WheelTimer& timer, const TickType_t ticks) {
+    uint32_t steps = (static_cast<uint32_t>(ticks) + resolution - 1) /
+                     static_cast<uint32_t>(resolution);
+    if (steps == 0) {
+      steps = 1;
+    }
+    if (steps > maxSteps) {
+      return false;
+    }
+    unlink(timer);
+    timer.expiry = now + steps;
+    place(timer);
+    return true;
+  }
+
+  // Moves the timers in a slot of a higher level down to the lower levels.
+  // The slot is detached first so that each timer is moved in its own short
+  // critical section.
+  void cascade(const UBaseType_t level, const UBaseType_t index) {
+    WheelTimer* pending = nullptr;
+    detach(&wheel[level][index], &pending);
+    for (;;) {
+      taskENTER_CRITICAL();
+      WheelTimer* const timer = pending;
+      if (timer != nullptr) {
+        unlink(*timer);
+        place(*timer);
+      }
+      taskEXIT_CRITICAL();
+      if (timer == nullptr) {
+        break;
+      }
+    }
+  }
+
+  // Calls the callback of every timer in a level 0 slot.
+  void expire(const UBaseType_t index) {
+    WheelTimer* pending = nullptr;
+    detach(&wheel[0][index], &pending);
+    for (;;) {
+      taskENTER_CRITICAL();
+      WheelTimer* const timer = pending;
+      if (timer != nullptr) {
+        unlink(*timer);
+      }
+      taskEXIT_CRITICAL();
+      if (timer == nullptr) {
+        break;
+      }
+      timer->callback(timer->argument);
+    }
+  }
+
+  // Moves the whole list at slot to pending.  Timers in pending can still be
+  // cancelled or re-armed while they wait to be processed.
+  static void detach(WheelTimer** slot, WheelTimer** pending) {
+    taskENTER_CRITICAL();
+    *pending = *slot;
+    *slot = nullptr;
+    if (*pending != nullptr) {
+      (*pending)->pprev = pending;
+    }
+    taskEXIT_CRITICAL();
+  }
+
+  const TickType_t resolution;
+  uint32_t now = 0;
+  WheelTimer* wheel[Levels][Slots] = {};
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_TIMERWHEEL_HPP
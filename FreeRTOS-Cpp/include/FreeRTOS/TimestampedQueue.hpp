@@ -0,0 +1,369 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_TIMESTAMPEDQUEUE_HPP
+#define FREERTOS_TIMESTAMPEDQUEUE_HPP
+
+#include <FreeRTOS/ObjectLock.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <cstdint>
+#include <optional>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+/**
+ * @brief Expression that reads the clock used to stamp the items of a
+ * FreeRTOS::TimestampedQueue.  It defaults to the run time stats counter when
+ * configGENERATE_RUN_TIME_STATS is 1, and to the tick count otherwise.  Define
+ * it before including this header to use a cycle counter.  It must be safe to
+ * read from interrupts.
+ */
+#ifndef FREERTOS_CPP_TIMESTAMPED_QUEUE_TIME
+#if (configGENERATE_RUN_TIME_STATS == 1) && \
+    defined(portGET_RUN_TIME_COUNTER_VALUE)
+#define FREERTOS_CPP_TIMESTAMPED_QUEUE_TIME() \
+  static_cast<uint32_t>(portGET_RUN_TIME_COUNTER_VALUE())
+#else
+#define FREERTOS_CPP_TIMESTAMPED_QUEUE_TIME() \
+  static_cast<uint32_t>(xTaskGetTickCountFromISR())
+#endif /* configGENERATE_RUN_TIME_STATS */
+#endif /* FREERTOS_CPP_TIMESTAMPED_QUEUE_TIME */
+
+/**
+ * @brief The number of buckets in the latency histogram of
+ * FreeRTOS::QueueLatencyStatistics.
+ */
+#ifndef FREERTOS_CPP_TIMESTAMPED_QUEUE_BUCKETS
+#define FREERTOS_CPP_TIMESTAMPED_QUEUE_BUCKETS 16
+#endif
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @brief Queueing latency recorded by FreeRTOS::TimestampedQueue.  Times are
+ * in units of FREERTOS_CPP_TIMESTAMPED_QUEUE_TIME().
+ *
+ * The latency of an item is the time between the start of the send that put it
+ * in the queue and the end of the receive that took it out.
+ */
+struct QueueLatencyStatistics {
+  /**
+   * @brief The number of items received.
+   */
+  uint32_t items = 0;
+
+  /**
+   * @brief The smallest latency of an item.
+   */
+  uint32_t minLatency = UINT32_MAX;
+
+  /**
+   * @brief The largest latency of an item.
+   */
+  uint32_t maxLatency = 0;
+
+  /**
+   * @brief The sum of the latencies of every item, for the mean.
+   */
+  uint64_t totalLatency = 0;
+
+  /**
+   * @brief Histogram of the latency of every item.  Bucket 0 counts items with
+   * no measurable latency, bucket i counts items that waited between 2^(i-1)
+   * and 2^i - 1, and the last bucket also counts every longer wait.
+   */
+  uint32_t histogram[FREERTOS_CPP_TIMESTAMPED_QUEUE_BUCKETS] = {};
+};
+
+/**
+ * @class TimestampedQueue TimestampedQueue.hpp <FreeRTOS/TimestampedQueue.hpp>
+ *
+ * @brief Class that wraps a FreeRTOS::StaticQueue so that every item is
+ * stamped when it is sent and its queueing latency is recorded when it is
+ * received.
+ *
+ * In a chain of tasks connected by queues the time an item spends waiting in
+ * each queue is often most of its end to end latency, and it cannot be seen by
+ * timing the tasks alone.  Sending through a TimestampedQueue stores the
+ * current time next to the item, and receiving it adds the time it waited to
+ * the QueueLatencyStatistics of the queue.  Reading the statistics of every
+ * queue in the chain shows where the latency goes.
+ *
+ * Each slot of the queue holds the item and a 32 bit stamp, so the storage
+ * grows by four bytes per item, padding aside.  The statistics are updated on
+ * every receive while holding the FreeRTOS::ObjectLock of the queue.
+ *
+ * @tparam T Type to be stored in the queue.  Must be trivially copyable.
+ * @tparam N The maximum number of items the queue can hold at any one time.
+ *
+ * <b>Example Usage</b>
+ * @include TimestampedQueue/timestampedQueue.cpp
+ */
+template <class T, UBaseType_t N>
+class TimestampedQueue {
+ public:
+  TimestampedQueue() = default;
+  ~TimestampedQueue() = default;
+
+  TimestampedQueue(const TimestampedQueue&) = delete;
+  TimestampedQueue& operator=(const TimestampedQueue&) = delete;
+
+  /**
+   * TimestampedQueue.hpp
+   *
+   * @brief Function that stamps an item and posts it to the back of the queue.
+   *
+   * @param item The item to send.
+   * @param ticksToWait The maximum amount of time the task should block
+   * waiting for space to become available on the queue.
+   * @retval true If the item was successfully posted.
+   * @retval false Otherwise.
+   */
+  inline bool sendToBack(const T& item,
+                         const TickType_t ticksToWait = portMAX_DELAY) const {
+    return queue.sendToBack(stamp(item), ticksToWait);
+  }
+
+  /**
+   * TimestampedQueue.hpp
+   *
+   * @brief Function that stamps an item and posts it to the front of the
+   * queue.
+   *
+   * @param item The item to send.
+   * @param ticksToWait The maximum amount of time the task should block
+   * waiting for space to become available on the queue.
+   * @retval true If the item was successfully posted.
+   * @retval false Otherwise.
+   */
+  inline bool sendToFront(const T& item,
+                          const TickType_t ticksToWait = portMAX_DELAY) const {
+    return queue.sendToFront(stamp(item), ticksToWait);
+  }
+
+  /**
+   * TimestampedQueue.hpp
+   *
+   * @brief Function that stamps an item and posts it to the back of the queue
+   * from an interrupt service routine.
+   *
+   * @param higherPriorityTaskWoken Set to true if sending to the queue caused a
+   * task to unblock, and the unblocked task has a priority higher than the
+   * currently running task.
+   * @param item The item to send.
+   * @retval true If the item was successfully posted.
+   * @retval false Otherwise.
+   */
+  inline bool sendToBackFromISR(bool& higherPriorityTaskWoken,
+                                const T& item) const {
+    return queue.sendToBackFromISR(higherPriorityTaskWoken, stamp(item));
+  }
+
+  /**
+   * TimestampedQueue.hpp
+   *
+   * @overload
+   */
+  inline bool sendToBackFromISR(const T& item) const {
+    return queue.sendToBackFromISR(stamp(item));
+  }
+
+  /**
+   * TimestampedQueue.hpp
+   *
+   * @brief Function that receives an item from the queue and records how long
+   * it waited.
+   *
+   * @param item Reference to the item the received item is copied into.
+   * @param ticksToWait The maximum amount of time the task should block
+   * waiting for an item to receive should the queue be empty at the time of
+   * the call.
+   * @retval true If an item was successfully received from the queue.
+   * @retval false Otherwise.
+   */
+  bool receive(T& item, const TickType_t ticksToWait = portMAX_DELAY) {
+    Stamped stamped;
+    if (!queue.receive(stamped, ticksToWait)) {
+      return false;
+    }
+    item = stamped.item;
+    const uint32_t latency =
+        FREERTOS_CPP_TIMESTAMPED_QUEUE_TIME() - stamped.time;
+    lock.enter();
+    record(latency);
+    lock.exit();
+    return true;
+  }
+
+  /**
+   * TimestampedQueue.hpp
+   *
+   * @brief Function that receives an item from the queue and records how long
+   * it waited.
+   *
+   * @param ticksToWait The maximum amount of time the task should block
+   * waiting for an item to receive should the queue be empty at the time of
+   * the call.
+   * @return std::optional<T> The received item, or std::nullopt if the queue
+   * stayed empty.
+   */
+  std::optional<T> receive(const TickType_t ticksToWait = portMAX_DELAY) {
+    T item;
+    if (receive(item, ticksToWait)) {
+      return item;
+    }
+    return {};
+  }
+
+  /**
+   * TimestampedQueue.hpp
+   *
+   * @brief Function that receives an item from the queue in an interrupt
+   * service routine and records how long it waited.
+   *
+   * @param higherPriorityTaskWoken Set to true if receiving from the queue
+   * caused a task to unblock, and the unblocked task has a priority higher
+   * than the currently running task.
+   * @param item Reference to the item the received item is copied into.
+   * @retval true If an item was successfully received from the queue.
+   * @retval false Otherwise.
+   */
+  bool receiveFromISR(bool& higherPriorityTaskWoken, T& item) {
+    Stamped stamped;
+    if (!queue.receiveFromISR(higherPriorityTaskWoken, stamped)) {
+      return false;
+    }
+    item = stamped.item;
+    const uint32_t latency =
+        FREERTOS_CPP_TIMESTAMPED_QUEUE_TIME() - stamped.time;
+    const UBaseType_t status = lock.enterFromISR();
+    record(latency);
+    lock.exitFromISR(status);
+    return true;
+  }
+
+  /**
+   * TimestampedQueue.hpp
+   *
+   * @overload
+   */
+  bool receiveFromISR(T& item) {
+    bool higherPriorityTaskWoken = false;
+    return receiveFromISR(higherPriorityTaskWoken, item);
+  }
+
+  /**
+   * TimestampedQueue.hpp
+   *
+   * @brief Function that returns the number of items stored in the queue.
+   *
+   * @return UBaseType_t The number of items available in the queue.
+   */
+  inline UBaseType_t messagesWaiting() const {
+    return queue.messagesWaiting();
+  }
+
+  /**
+   * TimestampedQueue.hpp
+   *
+   * @brief Function that returns the number of free spaces in the queue.
+   *
+   * @return UBaseType_t The number of spaces available in the queue.
+   */
+  inline UBaseType_t spacesAvailable() const {
+    return queue.spacesAvailable();
+  }
+
+  /**
+   * TimestampedQueue.hpp
+   *
+   * @brief Function that returns a copy of the latency statistics.  The copy
+   * is taken while holding the lock of the queue so that it is consistent.
+   *
+   * @return QueueLatencyStatistics The statistics of the queue.
+   */
+  QueueLatencyStatistics getStatistics() const {
+    lock.enter();
+    const QueueLatencyStatistics copy = statistics;
+    lock.exit();
+    return copy;
+  }
+
+  /**
+   * TimestampedQueue.hpp
+   *
+   * @brief Function that clears the latency statistics, for example at the
+   * start of a measurement window.
+   */
+  void resetStatistics() {
+    lock.enter();
+    statistics = QueueLatencyStatistics();
+    lock.exit();
+  }
+
+ private:
+  struct Stamped {
+    T item;
+    uint32_t time;
+  };
+
+  StaticQueue<Stamped, N> queue;
+  QueueLatencyStatistics statistics;
+  ObjectLock lock;
+
+  static inline Stamped stamp(const T& item) {
+    return Stamped{item, FREERTOS_CPP_TIMESTAMPED_QUEUE_TIME()};
+  }
+
+  void record(const uint32_t latency) {
+    UBaseType_t bucket = 0;
+    while ((bucket < (FREERTOS_CPP_TIMESTAMPED_QUEUE_BUCKETS - 1)) &&
+           ((latency >> bucket) != 0)) {
+      bucket++;
+    }
+
+    statistics.items++;
+    if (latency < statistics.minLatency) {
+      statistics.minLatency = latency;
+    }
+    if (latency > statistics.maxLatency) {
+      statistics.maxLatency = latency;
+    }
+    statistics.totalLatency += latency;
+    statistics.histogram[bucket]++;
+  }
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_TIMESTAMPEDQUEUE_HPP
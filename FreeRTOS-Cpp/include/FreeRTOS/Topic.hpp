@@ -0,0 +1,617 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_TOPIC_HPP
+#define FREERTOS_TOPIC_HPP
+
+#include <FreeRTOS/Deadline.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <new>
+#include <utility>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @brief What FreeRTOS::Topic::publish() does when the queue of a subscriber is
+ * full.
+ */
+enum class TopicPolicy : uint8_t {
+  /**
+   * @brief Block the publisher until the subscriber makes room or the timeout
+   * expires.  The subscriber misses the sample if the timeout expires.
+   */
+  Block,
+
+  /**
+   * @brief Discard the oldest sample waiting for the subscriber to make room.
+   * The publisher never blocks on this subscriber.
+   */
+  DropOldest,
+};
+
+/**
+ * @class Topic Topic.hpp <FreeRTOS/Topic.hpp>
+ *
+ * @brief Class that publishes samples to several subscriber tasks without
+ * copying them.
+ *
+ * Samples are constructed once in a fixed pool of Count slots that is
+ * contained in the object instance.  publish() sends only a pointer to the slot
+ * to the queue of every subscriber, and each slot keeps a count of the
+ * subscribers that still hold it.  The slot returns to the pool when the last
+ * FreeRTOS::Topic::Sample that refers to it is released, so publishing costs
+ * one pointer send per subscriber no matter how large T is.
+ *
+ * Each subscriber chooses with a FreeRTOS::TopicPolicy whether a full queue
+ * blocks the publisher or loses its oldest sample.
+ *
+ * The reference counts are updated in short critical sections, as atomic
+ * read-modify-write is not available on every port.  Samples can be allocated,
+ * published and released from interrupt service routines.
+ *
+ * @tparam T Type of the samples.
+ * @tparam Subscribers The maximum number of subscribers.
+ * @tparam Count The number of samples that can exist at any one time.
+ * @tparam Depth The length of the queue of each subscriber.
+ *
+ * <b>Example Usage</b>
+ * @include Topic/topic.cpp
+ */
+template <class T, UBaseType_t Subscribers, UBaseType_t Count,
+          UBaseType_t Depth = Count>
+class Topic {
+  static_assert(Subscribers > 0, "A topic needs at least one subscriber.");
+  static_assert(Count > 0, "The pool must contain at least one sample.");
+  static_assert(Depth > 0, "Subscriber queues must hold at least one sample.");
+
+  struct Slot {
+    inline T* get() {
+      return reinterpret_cast<T*>(data);  // NOLINT
+    }
+
+    alignas(T) uint8_t data[sizeof(T)];
+    UBaseType_t references;
+  };
+
+ public:
+  /**
+   * @class Draft Topic.hpp <FreeRTOS/Topic.hpp>
+   *
+   * @brief Move only handle to a sample that has been allocated but not yet
+   * published.  The owner may modify the sample until it is published.
+   */
+  class Draft {
+   public:
+    Draft() = default;
+
+    /**
+     * Topic.hpp
+     *
+     * @brief Destroy the Draft object, returning an unpublished sample to the
+     * pool.
+     */
+    ~Draft() {
+      reset();
+    }
+
+    Draft(const Draft&) = delete;
+    Draft& operator=(const Draft&) = delete;
+
+    Draft(Draft&& other) noexcept
+        : owner(std::exchange(other.owner, nullptr)),
+          slot(std::exchange(other.slot, nullptr)) {}
+
+    Draft& operator=(Draft&& other) noexcept {
+      if (this != &other) {
+        reset();
+        owner = std::exchange(other.owner, nullptr);
+        slot = std::exchange(other.slot, nullptr);
+      }
+      return *this;
+    }
+
+    /**
+     * Topic.hpp
+     *
+     * @brief Function that checks if the draft holds a sample.
+     *
+     * @retval true The draft holds a sample.
+     * @retval false The draft is empty.
+     */
+    inline bool isValid() const {
+      return (slot != nullptr);
+    }
+
+    inline explicit operator bool() const {
+      return isValid();
+    }
+
+    inline T* get() const {
+      return slot->get();
+    }
+
+    inline T& operator*() const {
+      return *slot->get();
+    }
+
+    inline T* operator->() const {
+      return slot->get();
+    }
+
+    /**
+     * Topic.hpp
+     *
+     * @brief Return the sample to the pool without publishing it.
+     */
+    inline void reset() {
+      if (slot != nullptr) {
+        owner->release(std::exchange(slot, nullptr));
+      }
+    }
+
+   private:
+    friend class Topic;
+
+    Draft(Topic* owner, Slot* slot) : owner(owner), slot(slot) {}
+
+    Topic* owner = nullptr;
+    Slot* slot = nullptr;
+  };
+
+  /**
+   * @class Sample Topic.hpp <FreeRTOS/Topic.hpp>
+   *
+   * @brief Handle to a published sample that is shared with the other
+   * subscribers.  The sample is read only.  Copying the handle adds a
+   * reference, and the sample returns to the pool when the last handle is
+   * released.
+   */
+  class Sample {
+   public:
+    Sample() = default;
+
+    /**
+     * Topic.hpp
+     *
+     * @brief Destroy the Sample object, releasing its reference.
+     *
+     * @warning This must not run in an interrupt service routine.  Call
+     * releaseFromISR() before an ISR owned sample goes out of scope.
+     */
+    ~Sample() {
+      reset();
+    }
+
+    Sample(const Sample& other) : owner(other.owner), slot(other.slot) {
+      if (slot != nullptr) {
+        owner->retain(slot);
+      }
+    }
+
+    Sample& operator=(const Sample& other) {
+      if (this != &other) {
+        Sample copy(other);
+        *this = std::move(copy);
+      }
+      return *this;
+    }
+
+    Sample(Sample&& other) noexcept
+        : owner(std::exchange(other.owner, nullptr)),
+          slot(std::exchange(other.slot, nullptr)) {}
+
+    Sample& operator=(Sample&& other) noexcept {
+      if (this != &other) {
+        reset();
+        owner = std::exchange(other.owner, nullptr);
+        slot = std::exchange(other.slot, nullptr);
+      }
+      return *this;
+    }
+
+    /**
+     * Topic.hpp
+     *
+     * @brief Function that checks if the handle refers to a sample.
+     *
+     * @retval true The handle refers to a sample.
+     * @retval false The handle is empty.
+     */
+    inline bool isValid() const {
+      return (slot != nullptr);
+    }
+
+    inline explicit operator bool() const {
+      return isValid();
+    }
+
+    inline const T* get() const {
+      return slot->get();
+    }
+
+    inline const T& operator*() const {
+      return *slot->get();
+    }
+
+    inline const T* operator->() const {
+      return slot->get();
+    }
+
+    /**
+     * Topic.hpp
+     *
+     * @brief Release the reference to the sample.  The handle is empty
+     * afterwards.
+     */
+    inline void reset() {
+      if (slot != nullptr) {
+        owner->release(std::exchange(slot, nullptr));
+      }
+    }
+
+    /**
+     * Topic.hpp
+     *
+     * @brief A version of reset() that can be called from an interrupt service
+     * routine.
+     *
+     * @param higherPriorityTaskWoken A reference that will be set to true if
+     * returning the sample to the pool caused a task that was waiting for a
+     * free sample to unblock, and the unblocked task has a priority higher
+     * than the currently running task.
+     */
+    inline void releaseFromISR(bool& higherPriorityTaskWoken) {
+      if (slot != nullptr) {
+        owner->releaseFromISR(higherPriorityTaskWoken,
+                              std::exchange(slot, nullptr));
+      }
+    }
+
+   private:
+    friend class Topic;
+
+    Sample(Topic* owner, Slot* slot) : owner(owner), slot(slot) {}
+
+    Topic* owner = nullptr;
+    Slot* slot = nullptr;
+  };
+
+  /**
+   * @class Subscription Topic.hpp <FreeRTOS/Topic.hpp>
+   *
+   * @brief Handle that a subscriber task uses to receive the samples published
+   * to a FreeRTOS::Topic.
+   */
+  class Subscription {
+   public:
+    Subscription() = default;
+
+    /**
+     * Topic.hpp
+     *
+     * @brief Function that checks if the subscription is attached to a topic.
+     *
+     * @retval true subscribe() returned a free subscriber queue.
+     * @retval false Every subscriber queue of the topic was already in use.
+     */
+    inline bool isValid() const {
+      return (owner != nullptr);
+    }
+
+    /**
+     * Topic.hpp
+     *
+     * @brief Function that receives the next sample published to the topic.
+     *
+     * @param ticksToWait The maximum amount of time the task should block
+     * waiting for a sample should none be waiting.
+     * @return Sample Handle to the received sample.  The handle is empty if no
+     * sample was received.
+     */
+    inline Sample receive(const TickType_t ticksToWait = portMAX_DELAY) const {
+      Slot* slot = nullptr;
+      return owner->queues[index].receive(slot, ticksToWait)
+                 ? Sample(owner, slot)
+                 : Sample();
+    }
+
+    /**
+     * Topic.hpp
+     *
+     * @brief Function that returns the number of samples waiting for this
+     * subscriber.
+     *
+     * @return UBaseType_t The number of samples waiting.
+     */
+    inline UBaseType_t messagesWaiting() const {
+      return owner->queues[index].messagesWaiting();
+    }
+
+   private:
+    friend class Topic;
+
+    Subscription(Topic* owner, const UBaseType_t index)
+        : owner(owner), index(index) {}
+
+    Topic* owner = nullptr;
+    UBaseType_t index = 0;
+  };
+
+  /**
+   * Topic.hpp
+   *
+   * @brief Construct a new Topic object and place every sample of the pool in
+   * the free list.
+   *
+   * @warning This class contains the storage for the samples and every queue,
+   * so the user should create this object as a global object or with the
+   * static storage specifier so that the object instance is not on the stack.
+   */
+  Topic() {
+    for (auto& slot : storage) {
+      slot.references = 0;
+      freeSlots.sendToBack(&slot, 0);
+    }
+  }
+  ~Topic() = default;
+
+  Topic(const Topic&) = delete;
+  Topic& operator=(const Topic&) = delete;
+  Topic(Topic&&) = delete;
+  Topic& operator=(Topic&&) = delete;
+
+  /**
+   * Topic.hpp
+   *
+   * @brief Function that attaches a new subscriber to the topic.  Subscribers
+   * should be attached before samples are published, as a subscriber only
+   * receives the samples published after it was attached.
+   *
+   * @param policy What publish() does when the queue of this subscriber is
+   * full.
+   * @return Subscription The handle the subscriber receives samples with.  It
+   * is not valid if Subscribers subscriptions already exist.
+   */
+  Subscription subscribe(const TopicPolicy policy = TopicPolicy::Block) {
+    taskENTER_CRITICAL();
+    const UBaseType_t index = subscriberCount;
+    if (index < Subscribers) {
+      policies[index] = policy;
+      subscriberCount++;
+    }
+    taskEXIT_CRITICAL();
+    return (index < Subscribers) ? Subscription(this, index) : Subscription();
+  }
+
+  /**
+   * Topic.hpp
+   *
+   * @brief Function that allocates a sample from the pool and constructs it.
+   *
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for a sample to become free, should the pool be exhausted.
+   * @param args Arguments forwarded to the constructor of T.
+   * @return Draft Handle to the constructed sample.  The handle is empty if no
+   * sample became free before ticksToWait expired.
+   */
+  template <class... Args>
+  Draft allocate(const TickType_t ticksToWait, Args&&... args) {
+    Slot* slot = nullptr;
+    if (!freeSlots.receive(slot, ticksToWait)) {
+      return Draft();
+    }
+    return construct(slot, std::forward<Args>(args)...);
+  }
+
+  /**
+   * Topic.hpp
+   *
+   * @brief A version of allocate() that can be called from an interrupt
+   * service routine.
+   *
+   * @param args Arguments forwarded to the constructor of T.
+   * @return Draft Handle to the constructed sample.  The handle is empty if the
+   * pool is exhausted.
+   */
+  template <class... Args>
+  Draft allocateFromISR(Args&&... args) {
+    Slot* slot = nullptr;
+    if (!freeSlots.receiveFromISR(slot)) {
+      return Draft();
+    }
+    return construct(slot, std::forward<Args>(args)...);
+  }
+
+  /**
+   * Topic.hpp
+   *
+   * @brief Function that publishes a sample to every subscriber.  Only a
+   * pointer to the sample is sent to each subscriber.
+   *
+   * @param draft Handle to the sample.  It is always empty afterwards, and the
+   * sample returns to the pool at once if no subscriber received it.
+   * @param ticksToWait The maximum amount of time the task should block in
+   * total waiting for subscribers with the TopicPolicy::Block policy to make
+   * room.
+   * @return UBaseType_t The number of subscribers the sample was sent to.
+   */
+  UBaseType_t publish(Draft& draft,
+                      const TickType_t ticksToWait = portMAX_DELAY) {
+    if (!draft.isValid()) {
+      return 0;
+    }
+    Slot* const slot = std::exchange(draft.slot, nullptr);
+    const UBaseType_t subscribers = addReferences(slot);
+    const Deadline deadline(ticksToWait);
+
+    UBaseType_t sent = 0;
+    for (UBaseType_t i = 0; i < subscribers; i++) {
+      bool result = false;
+      if (policies[i] == TopicPolicy::Block) {
+        result = queues[i].sendToBack(slot, deadline);
+      } else {
+        while (!(result = queues[i].sendToBack(slot, 0))) {
+          Slot* oldest = nullptr;
+          if (queues[i].receive(oldest, 0)) {
+            release(oldest);
+          }
+        }
+      }
+      if (result) {
+        sent++;
+      } else {
+        release(slot);
+      }
+    }
+
+    release(slot);
+    return sent;
+  }
+
+  /**
+   * Topic.hpp
+   *
+   * @brief A version of publish() that can be called from an interrupt service
+   * routine.  It never blocks, so subscribers with the TopicPolicy::Block
+   * policy miss the sample if their queue is full.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * publishing the sample caused a task to unblock, and the unblocked task has
+   * a priority higher than the currently running task.
+   * @param draft Handle to the sample.  It is always empty afterwards.
+   * @return UBaseType_t The number of subscribers the sample was sent to.
+   */
+  UBaseType_t publishFromISR(bool& higherPriorityTaskWoken, Draft& draft) {
+    if (!draft.isValid()) {
+      return 0;
+    }
+    Slot* const slot = std::exchange(draft.slot, nullptr);
+    const UBaseType_t subscribers = addReferencesFromISR(slot);
+
+    UBaseType_t sent = 0;
+    for (UBaseType_t i = 0; i < subscribers; i++) {
+      bool result = queues[i].sendToBackFromISR(higherPriorityTaskWoken, slot);
+      while (!result && (policies[i] == TopicPolicy::DropOldest)) {
+        Slot* oldest = nullptr;
+        if (queues[i].receiveFromISR(higherPriorityTaskWoken, oldest)) {
+          releaseFromISR(higherPriorityTaskWoken, oldest);
+        }
+        result = queues[i].sendToBackFromISR(higherPriorityTaskWoken, slot);
+      }
+      if (result) {
+        sent++;
+      } else {
+        releaseFromISR(higherPriorityTaskWoken, slot);
+      }
+    }
+
+    releaseFromISR(higherPriorityTaskWoken, slot);
+    return sent;
+  }
+
+  /**
+   * Topic.hpp
+   *
+   * @brief Function that returns the number of samples that can still be
+   * allocated from the pool.
+   *
+   * @return UBaseType_t The number of free samples in the pool.
+   */
+  inline UBaseType_t slotsAvailable() const {
+    return freeSlots.messagesWaiting();
+  }
+
+ private:
+  template <class... Args>
+  inline Draft construct(Slot* slot, Args&&... args) {
+    ::new (slot->data) T(std::forward<Args>(args)...);
+    slot->references = 1;
+    return Draft(this, slot);
+  }
+
+  // Adds one reference per subscriber on top of the publisher's own, which is
+  // dropped once every send has been attempted.
+  inline UBaseType_t addReferences(Slot* slot) {
+    taskENTER_CRITICAL();
+    const UBaseType_t subscribers = subscriberCount;
+    slot->references += subscribers;
+    taskEXIT_CRITICAL();
+    return subscribers;
+  }
+
+  inline UBaseType_t addReferencesFromISR(Slot* slot) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const UBaseType_t subscribers = subscriberCount;
+    slot->references += subscribers;
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    return subscribers;
+  }
+
+  inline void retain(Slot* slot) {
+    taskENTER_CRITICAL();
+    slot->references++;
+    taskEXIT_CRITICAL();
+  }
+
+  inline void release(Slot* slot) {
+    taskENTER_CRITICAL();
+    const bool last = (--slot->references == 0);
+    taskEXIT_CRITICAL();
+    if (last) {
+      slot->get()->~T();
+      freeSlots.sendToBack(slot, 0);
+    }
+  }
+
+  inline void releaseFromISR(bool& higherPriorityTaskWoken, Slot* slot) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    const bool last = (--slot->references == 0);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+    if (last) {
+      slot->get()->~T();
+      freeSlots.sendToBackFromISR(higherPriorityTaskWoken, slot);
+    }
+  }
+
+  StaticQueue<Slot*, Depth> queues[Subscribers];
+  StaticQueue<Slot*, Count> freeSlots;
+  Slot storage[Count];
+  TopicPolicy policies[Subscribers] = {};
+  UBaseType_t subscriberCount = 0;
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_TOPIC_HPP
@@ -0,0 +1,347 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_TRACE_HPP
+#define FREERTOS_TRACE_HPP
+
+#include <FreeRTOS/SpinLock.hpp>
+#include <FreeRTOS/StreamBuffer.hpp>
+#include <FreeRTOS/TraceHooks.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Expression that reads the free running counter used to timestamp
+ * trace records.  It defaults to the run time stats counter.  On a Cortex-M3
+ * or later the DWT cycle counter gives cycle resolution for a single load.
+ * Pass its frequency to the host decoder.
+ */
+#ifndef FREERTOS_CPP_TRACE_TIMESTAMP
+#define FREERTOS_CPP_TRACE_TIMESTAMP() \
+  static_cast<uint32_t>(portGET_RUN_TIME_COUNTER_VALUE())
+#endif
+
+namespace FreeRTOS {
+
+/**
+ * @brief Trace namespace that records a timeline of kernel events.
+ *
+ * <FreeRTOS/TraceHooks.h> defines the kernel <tt>trace*()</tt> hook macros so
+ * that context switches, task, queue, stream buffer, event group, timer and
+ * heap operations are recorded by a StaticRecorder, and isrEnter(), isrExit()
+ * and user() add application events.  The records are copied to a stream
+ * buffer by StaticRecorder::drain() and sent to a host, where
+ * tools/traceDecode.py converts them to the Trace Event Format used by Perfetto
+ * and chrome://tracing.
+ */
+namespace Trace {
+
+/**
+ * @brief A trace record as it is stored and streamed, in the byte order of the
+ * target.
+ */
+struct Record {
+  /**
+   * @brief FREERTOS_CPP_TRACE_TIMESTAMP() when the event was recorded.  NAME
+   * records carry four characters of the name here instead.
+   */
+  uint32_t timestamp;
+
+  /**
+   * @brief The handle of the task or kernel object, truncated to 32 bits.
+   */
+  uint32_t object;
+
+  /**
+   * @brief The low 16 bits of the event specific value, such as a number of
+   * bytes, a notification index or a priority.
+   */
+  uint16_t value;
+
+  /**
+   * @brief One of the FREERTOS_CPP_TRACE_* event numbers.
+   */
+  uint8_t event;
+
+  /**
+   * @brief The core the event was recorded on.
+   */
+  uint8_t core;
+};
+
+static_assert(sizeof(Record) == 12, "Trace records must be 12 bytes.");
+
+/**
+ * @brief Version of the record format, sent as the value of the START record.
+ */
+inline constexpr uint16_t formatVersion = 1;
+
+/**
+ * @class StaticRecorder Trace.hpp <FreeRTOS/Trace.hpp>
+ *
+ * @brief Class that stores trace records in a ring buffer contained in the
+ * object instance.
+ *
+ * Recording masks interrupts for the few instructions that store one record,
+ * as the kernel calls the hooks from tasks, interrupts and its own critical
+ * sections, and no read modify write instructions are needed.  On SMP ports a
+ * SpinLock also excludes the other cores.  When the ring buffer is full new
+ * records are dropped and counted, so records that have been stored are never
+ * overwritten before they are drained.
+ *
+ * Expand FREERTOS_CPP_DEFINE_TRACE() with the recorder in one source file so
+ * that the hooks in <FreeRTOS/TraceHooks.h> reach it.
+ *
+ * @tparam N The number of records in the ring buffer.  Must be a power of two.
+ *
+ * <b>Example Usage</b>
+ * @include Trace/trace.cpp
+ */
+template <size_t N>
+class StaticRecorder {
+  static_assert((N >= 2) && ((N & (N - 1)) == 0),
+                "The number of records must be a power of two.");
+
+ public:
+  StaticRecorder() = default;
+  ~StaticRecorder() = default;
+
+  StaticRecorder(const StaticRecorder&) = delete;
+  StaticRecorder& operator=(const StaticRecorder&) = delete;
+
+  /**
+   * Trace.hpp
+   *
+   * @brief Function that stores one record.  It can be called from a task, an
+   * interrupt or a critical section.
+   *
+   * @param event One of the FREERTOS_CPP_TRACE_* event numbers.
+   * @param object The handle of the task or kernel object.
+   * @param value The event specific value.
+   */
+  inline void record(const uint32_t event, const void* object,
+                     const uint32_t value) {
+    store(FREERTOS_CPP_TRACE_TIMESTAMP(), event, object, value);
+  }
+
+  /**
+   * Trace.hpp
+   *
+   * @brief Function that stores the name of a task or object as a sequence of
+   * NAME records, four characters each, so the decoder can label it.
+   *
+   * @param object The handle of the task or kernel object.
+   * @param name The null terminated name.
+   */
+  void recordName(const void* object, const char* name) {
+    for (uint16_t offset = 0; offset < configMAX_TASK_NAME_LEN; offset += 4) {
+      uint32_t characters = 0;
+      bool end = false;
+      for (uint32_t i = 0; (i < 4) && !end; i++) {
+        end = (name[offset + i] == '\0');
+        characters |= static_cast<uint32_t>(
+                          static_cast<uint8_t>(name[offset + i]))
+                      << (8 * i);
+      }
+      store(characters, FREERTOS_CPP_TRACE_NAME, object, offset);
+      if (end) {
+        break;
+      }
+    }
+  }
+
+  /**
+   * Trace.hpp
+   *
+   * @brief Function that copies stored records into a stream buffer, which a
+   * task can then send to the host.
+   *
+   * Only whole records that fit in the free space of the stream buffer are
+   * copied, so the stream never contains a partial record.  The first call
+   * sends a START record that carries formatVersion.  This function does not
+   * block, and must only be called from one task.
+   *
+   * @param stream The stream buffer to copy the records to.
+   * @return size_t The number of records copied.
+   */
+  size_t drain(const StreamBufferBase& stream) {
+    if (!started) {
+      if (stream.spacesAvailable() < sizeof(Record)) {
+        return 0;
+      }
+      const Record start = {FREERTOS_CPP_TRACE_TIMESTAMP(), 0, formatVersion,
+                            FREERTOS_CPP_TRACE_START, 0};
+      stream.send(&start, sizeof(start), 0);
+      started = true;
+    }
+
+    size_t drained = 0;
+    size_t first = tail.load(std::memory_order_relaxed);
+    const size_t last = head.load(std::memory_order_acquire);
+    while (first != last) {
+      size_t count = last - first;
+      const size_t contiguous = N - (first & (N - 1));
+      const size_t fits = stream.spacesAvailable() / sizeof(Record);
+      count = (count < contiguous) ? count : contiguous;
+      count = (count < fits) ? count : fits;
+      if (count == 0) {
+        break;
+      }
+      stream.send(&records[first & (N - 1)], count * sizeof(Record), 0);
+      first += count;
+      drained += count;
+      tail.store(first, std::memory_order_release);
+    }
+    return drained;
+  }
+
+  /**
+   * Trace.hpp
+   *
+   * @brief Function that returns the number of records that were dropped
+   * because the ring buffer was full.
+   *
+   * @return uint32_t The number of dropped records.
+   */
+  inline uint32_t getDropped() const {
+    return dropped;
+  }
+
+ private:
+  inline void store(const uint32_t timestamp, const uint32_t event,
+                    const void* object, const uint32_t value) {
+    typename SpinLock<>::IsrGuard guard(lock);
+    const size_t index = head.load(std::memory_order_relaxed);
+    if (index - tail.load(std::memory_order_acquire) >= N) {
+      dropped = dropped + 1;
+      return;
+    }
+    Record& slot = records[index & (N - 1)];
+    slot.timestamp = timestamp;
+    slot.object = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(object));
+    slot.value = static_cast<uint16_t>(value);
+    slot.event = static_cast<uint8_t>(event);
+#if (configNUMBER_OF_CORES > 1)
+    slot.core = static_cast<uint8_t>(portGET_CORE_ID());
+#else
+    slot.core = 0;
+#endif /* configNUMBER_OF_CORES */
+    head.store(index + 1, std::memory_order_release);
+  }
+
+  Record records[N];
+  std::atomic<size_t> head{0};
+  std::atomic<size_t> tail{0};
+  volatile uint32_t dropped = 0;
+  bool started = false;
+  SpinLock<> lock;
+};
+
+/**
+ * Trace.hpp
+ *
+ * @brief Function that records the entry to an interrupt service routine.
+ *
+ * @param id A number that identifies the interrupt, such as its IRQ number.
+ */
+inline void isrEnter(const uint32_t id) {
+  freertosCppTraceRecord(FREERTOS_CPP_TRACE_ISR_ENTER, NULL, id);
+}
+
+/**
+ * Trace.hpp
+ *
+ * @brief Function that records the exit from an interrupt service routine.
+ *
+ * @param id The number passed to the matching isrEnter().
+ */
+inline void isrExit(const uint32_t id) {
+  freertosCppTraceRecord(FREERTOS_CPP_TRACE_ISR_EXIT, NULL, id);
+}
+
+/**
+ * Trace.hpp
+ *
+ * @brief Function that records an application defined event.
+ *
+ * @param id A number that identifies the event.
+ * @param value The low 16 bits are recorded with the event.
+ */
+inline void user(const uint32_t id, const uint32_t value = 0) {
+  freertosCppTraceRecord(FREERTOS_CPP_TRACE_USER,
+                         reinterpret_cast<const void*>(uintptr_t{id}), value);
+}
+
+/**
+ * @class IsrScope Trace.hpp <FreeRTOS/Trace.hpp>
+ *
+ * @brief Class that calls isrEnter() when it is constructed and isrExit() when
+ * it goes out of scope.
+ */
+class IsrScope {
+ public:
+  explicit IsrScope(const uint32_t id) : id(id) {
+    isrEnter(id);
+  }
+  ~IsrScope() {
+    isrExit(id);
+  }
+
+  IsrScope(const IsrScope&) = delete;
+  IsrScope& operator=(const IsrScope&) = delete;
+
+ private:
+  const uint32_t id;
+};
+
+}  // namespace Trace
+
+}  // namespace FreeRTOS
+
+/**
+ * @brief Macro that defines the functions called by the hooks in
+ * <FreeRTOS/TraceHooks.h> so that they record to a
+ * FreeRTOS::Trace::StaticRecorder.  Expand it in exactly one source file.
+ *
+ * @param recorder The FreeRTOS::Trace::StaticRecorder object to record to.
+ */
+#define FREERTOS_CPP_DEFINE_TRACE(recorder)                                    \
+  extern "C" void freertosCppTraceRecord(uint32_t event, const void* object,   \
+                                         uint32_t value) {                     \
+    (recorder).record(event, object, value);                                   \
+  }                                                                            \
+  extern "C" void freertosCppTraceName(const void* object,                     \
+                                       const char* name) {                     \
+    (recorder).recordName(object, name);                                       \
+  }
+
+#endif  // FREERTOS_TRACE_HPP
@@ -0,0 +1,258 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_TRACEHOOKS_H
+#define FREERTOS_TRACEHOOKS_H
+
+/*
+ * C header that routes the kernel trace hook macros to FreeRTOS::Trace.  The
+ * kernel is compiled as C, so this header must be valid C.  Include it at the
+ * end of FreeRTOSConfig.h, and expand FREERTOS_CPP_DEFINE_TRACE() from
+ * <FreeRTOS/Trace.hpp> in one C++ source file of the application.
+ *
+ * Trace hooks that are already defined when this header is included are left
+ * alone, so the application can still use any hook for another purpose.
+ */
+
+#include <stdint.h>
+
+#define FREERTOS_CPP_TRACE_TASK_SWITCHED_IN 1
+#define FREERTOS_CPP_TRACE_TASK_SWITCHED_OUT 2
+#define FREERTOS_CPP_TRACE_TASK_CREATE 3
+#define FREERTOS_CPP_TRACE_TASK_DELETE 4
+#define FREERTOS_CPP_TRACE_TASK_DELAY 5
+#define FREERTOS_CPP_TRACE_TASK_DELAY_UNTIL 6
+#define FREERTOS_CPP_TRACE_TASK_SUSPEND 7
+#define FREERTOS_CPP_TRACE_TASK_RESUME 8
+#define FREERTOS_CPP_TRACE_TASK_RESUME_FROM_ISR 9
+#define FREERTOS_CPP_TRACE_TASK_PRIORITY_SET 10
+#define FREERTOS_CPP_TRACE_TASK_NOTIFY 11
+#define FREERTOS_CPP_TRACE_TASK_NOTIFY_FROM_ISR 12
+#define FREERTOS_CPP_TRACE_TASK_NOTIFY_TAKE 13
+#define FREERTOS_CPP_TRACE_TASK_NOTIFY_WAIT 14
+#define FREERTOS_CPP_TRACE_TASK_INCREMENT_TICK 15
+#define FREERTOS_CPP_TRACE_QUEUE_CREATE 20
+#define FREERTOS_CPP_TRACE_QUEUE_SEND 21
+#define FREERTOS_CPP_TRACE_QUEUE_SEND_FAILED 22
+#define FREERTOS_CPP_TRACE_QUEUE_SEND_FROM_ISR 23
+#define FREERTOS_CPP_TRACE_QUEUE_RECEIVE 24
+#define FREERTOS_CPP_TRACE_QUEUE_RECEIVE_FAILED 25
+#define FREERTOS_CPP_TRACE_QUEUE_RECEIVE_FROM_ISR 26
+#define FREERTOS_CPP_TRACE_BLOCKING_ON_QUEUE_SEND 27
+#define FREERTOS_CPP_TRACE_BLOCKING_ON_QUEUE_RECEIVE 28
+#define FREERTOS_CPP_TRACE_STREAM_BUFFER_SEND 30
+#define FREERTOS_CPP_TRACE_STREAM_BUFFER_SEND_FROM_ISR 31
+#define FREERTOS_CPP_TRACE_STREAM_BUFFER_RECEIVE 32
+#define FREERTOS_CPP_TRACE_STREAM_BUFFER_RECEIVE_FROM_ISR 33
+#define FREERTOS_CPP_TRACE_BLOCKING_ON_STREAM_BUFFER_SEND 34
+#define FREERTOS_CPP_TRACE_BLOCKING_ON_STREAM_BUFFER_RECEIVE 35
+#define FREERTOS_CPP_TRACE_EVENT_GROUP_SET_BITS 40
+#define FREERTOS_CPP_TRACE_EVENT_GROUP_WAIT_BITS_BLOCK 41
+#define FREERTOS_CPP_TRACE_TIMER_EXPIRED 45
+#define FREERTOS_CPP_TRACE_MALLOC 50
+#define FREERTOS_CPP_TRACE_FREE 51
+#define FREERTOS_CPP_TRACE_ISR_ENTER 60
+#define FREERTOS_CPP_TRACE_ISR_EXIT 61
+#define FREERTOS_CPP_TRACE_USER 62
+#define FREERTOS_CPP_TRACE_NAME 63
+#define FREERTOS_CPP_TRACE_START 255
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void freertosCppTraceRecord(uint32_t event, const void* object,
+                            uint32_t value);
+void freertosCppTraceName(const void* object, const char* name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define FREERTOS_CPP_TRACE(event, object, value)   \
+  freertosCppTraceRecord(FREERTOS_CPP_TRACE_##event, \
+                         (const void*)(object), (uint32_t)(value))
+
+/* pxCurrentTCB, pxTCB and the TCB name are in scope where tasks.c expands
+ * these hooks. */
+#ifndef traceTASK_SWITCHED_IN
+#define traceTASK_SWITCHED_IN() \
+  FREERTOS_CPP_TRACE(TASK_SWITCHED_IN, pxCurrentTCB, 0)
+#endif
+#ifndef traceTASK_SWITCHED_OUT
+#define traceTASK_SWITCHED_OUT() \
+  FREERTOS_CPP_TRACE(TASK_SWITCHED_OUT, pxCurrentTCB, 0)
+#endif
+#ifndef traceTASK_CREATE
+#define traceTASK_CREATE(xTask)                                    \
+  do {                                                             \
+    freertosCppTraceName((xTask), (xTask)->pcTaskName);            \
+    FREERTOS_CPP_TRACE(TASK_CREATE, (xTask), (xTask)->uxPriority); \
+  } while (0)
+#endif
+#ifndef traceTASK_DELETE
+#define traceTASK_DELETE(xTask) FREERTOS_CPP_TRACE(TASK_DELETE, (xTask), 0)
+#endif
+#ifndef traceTASK_DELAY
+#define traceTASK_DELAY() \
+  FREERTOS_CPP_TRACE(TASK_DELAY, pxCurrentTCB, xTicksToDelay)
+#endif
+#ifndef traceTASK_DELAY_UNTIL
+#define traceTASK_DELAY_UNTIL(xTimeToWake) \
+  FREERTOS_CPP_TRACE(TASK_DELAY_UNTIL, pxCurrentTCB, (xTimeToWake))
+#endif
+#ifndef traceTASK_SUSPEND
+#define traceTASK_SUSPEND(xTask) FREERTOS_CPP_TRACE(TASK_SUSPEND, (xTask), 0)
+#endif
+#ifndef traceTASK_RESUME
+#define traceTASK_RESUME(xTask) FREERTOS_CPP_TRACE(TASK_RESUME, (xTask), 0)
+#endif
+#ifndef traceTASK_RESUME_FROM_ISR
+#define traceTASK_RESUME_FROM_ISR(xTask) \
+  FREERTOS_CPP_TRACE(TASK_RESUME_FROM_ISR, (xTask), 0)
+#endif
+#ifndef traceTASK_PRIORITY_SET
+#define traceTASK_PRIORITY_SET(xTask, uxNewPriority) \
+  FREERTOS_CPP_TRACE(TASK_PRIORITY_SET, (xTask), (uxNewPriority))
+#endif
+#ifndef traceTASK_NOTIFY
+#define traceTASK_NOTIFY(uxIndexToNotify) \
+  FREERTOS_CPP_TRACE(TASK_NOTIFY, pxTCB, (uxIndexToNotify))
+#endif
+#ifndef traceTASK_NOTIFY_FROM_ISR
+#define traceTASK_NOTIFY_FROM_ISR(uxIndexToNotify) \
+  FREERTOS_CPP_TRACE(TASK_NOTIFY_FROM_ISR, pxTCB, (uxIndexToNotify))
+#endif
+#ifndef traceTASK_NOTIFY_GIVE_FROM_ISR
+#define traceTASK_NOTIFY_GIVE_FROM_ISR(uxIndexToNotify) \
+  FREERTOS_CPP_TRACE(TASK_NOTIFY_FROM_ISR, pxTCB, (uxIndexToNotify))
+#endif
+#ifndef traceTASK_NOTIFY_TAKE
+#define traceTASK_NOTIFY_TAKE(uxIndexToWaitOn) \
+  FREERTOS_CPP_TRACE(TASK_NOTIFY_TAKE, pxCurrentTCB, (uxIndexToWaitOn))
+#endif
+#ifndef traceTASK_NOTIFY_WAIT
+#define traceTASK_NOTIFY_WAIT(uxIndexToWaitOn) \
+  FREERTOS_CPP_TRACE(TASK_NOTIFY_WAIT, pxCurrentTCB, (uxIndexToWaitOn))
+#endif
+
+/* The tick hook runs once per tick, so it is only traced on request. */
+#if defined(FREERTOS_CPP_TRACE_TICKS) && (FREERTOS_CPP_TRACE_TICKS == 1)
+#ifndef traceTASK_INCREMENT_TICK
+#define traceTASK_INCREMENT_TICK(xTickCount) \
+  FREERTOS_CPP_TRACE(TASK_INCREMENT_TICK, 0, (xTickCount))
+#endif
+#endif
+
+#ifndef traceQUEUE_CREATE
+#define traceQUEUE_CREATE(pxNewQueue) \
+  FREERTOS_CPP_TRACE(QUEUE_CREATE, (pxNewQueue), 0)
+#endif
+#ifndef traceQUEUE_SEND
+#define traceQUEUE_SEND(pxQueue) FREERTOS_CPP_TRACE(QUEUE_SEND, (pxQueue), 0)
+#endif
+#ifndef traceQUEUE_SEND_FAILED
+#define traceQUEUE_SEND_FAILED(pxQueue) \
+  FREERTOS_CPP_TRACE(QUEUE_SEND_FAILED, (pxQueue), 0)
+#endif
+#ifndef traceQUEUE_SEND_FROM_ISR
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+  FREERTOS_CPP_TRACE(QUEUE_SEND_FROM_ISR, (pxQueue), 0)
+#endif
+#ifndef traceQUEUE_RECEIVE
+#define traceQUEUE_RECEIVE(pxQueue) \
+  FREERTOS_CPP_TRACE(QUEUE_RECEIVE, (pxQueue), 0)
+#endif
+#ifndef traceQUEUE_RECEIVE_FAILED
+#define traceQUEUE_RECEIVE_FAILED(pxQueue) \
+  FREERTOS_CPP_TRACE(QUEUE_RECEIVE_FAILED, (pxQueue), 0)
+#endif
+#ifndef traceQUEUE_RECEIVE_FROM_ISR
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+  FREERTOS_CPP_TRACE(QUEUE_RECEIVE_FROM_ISR, (pxQueue), 0)
+#endif
+#ifndef traceBLOCKING_ON_QUEUE_SEND
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+  FREERTOS_CPP_TRACE(BLOCKING_ON_QUEUE_SEND, (pxQueue), 0)
+#endif
+#ifndef traceBLOCKING_ON_QUEUE_RECEIVE
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+  FREERTOS_CPP_TRACE(BLOCKING_ON_QUEUE_RECEIVE, (pxQueue), 0)
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND
+#define traceSTREAM_BUFFER_SEND(xStreamBuffer, xBytesSent) \
+  FREERTOS_CPP_TRACE(STREAM_BUFFER_SEND, (xStreamBuffer), (xBytesSent))
+#endif
+#ifndef traceSTREAM_BUFFER_SEND_FROM_ISR
+#define traceSTREAM_BUFFER_SEND_FROM_ISR(xStreamBuffer, xBytesSent) \
+  FREERTOS_CPP_TRACE(STREAM_BUFFER_SEND_FROM_ISR, (xStreamBuffer), (xBytesSent))
+#endif
+#ifndef traceSTREAM_BUFFER_RECEIVE
+#define traceSTREAM_BUFFER_RECEIVE(xStreamBuffer, xReceivedLength) \
+  FREERTOS_CPP_TRACE(STREAM_BUFFER_RECEIVE, (xStreamBuffer), (xReceivedLength))
+#endif
+#ifndef traceSTREAM_BUFFER_RECEIVE_FROM_ISR
+#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR(xStreamBuffer, xReceivedLength) \
+  FREERTOS_CPP_TRACE(STREAM_BUFFER_RECEIVE_FROM_ISR, (xStreamBuffer), \
+                     (xReceivedLength))
+#endif
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+#define traceBLOCKING_ON_STREAM_BUFFER_SEND(xStreamBuffer) \
+  FREERTOS_CPP_TRACE(BLOCKING_ON_STREAM_BUFFER_SEND, (xStreamBuffer), 0)
+#endif
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE(xStreamBuffer) \
+  FREERTOS_CPP_TRACE(BLOCKING_ON_STREAM_BUFFER_RECEIVE, (xStreamBuffer), 0)
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS
+#define traceEVENT_GROUP_SET_BITS(xEventGroup, uxBitsToSet) \
+  FREERTOS_CPP_TRACE(EVENT_GROUP_SET_BITS, (xEventGroup), (uxBitsToSet))
+#endif
+#ifndef traceEVENT_GROUP_WAIT_BITS_BLOCK
+#define traceEVENT_GROUP_WAIT_BITS_BLOCK(xEventGroup, uxBitsToWaitFor) \
+  FREERTOS_CPP_TRACE(EVENT_GROUP_WAIT_BITS_BLOCK, (xEventGroup), \
+                     (uxBitsToWaitFor))
+#endif
+
+#ifndef traceTIMER_EXPIRED
+#define traceTIMER_EXPIRED(pxTimer) \
+  FREERTOS_CPP_TRACE(TIMER_EXPIRED, (pxTimer), 0)
+#endif
+
+#ifndef traceMALLOC
+#define traceMALLOC(pvAddress, uiSize) \
+  FREERTOS_CPP_TRACE(MALLOC, (pvAddress), (uiSize))
+#endif
+#ifndef traceFREE
+#define traceFREE(pvAddress, uiSize) \
+  FREERTOS_CPP_TRACE(FREE, (pvAddress), (uiSize))
+#endif
+
+#endif  // FREERTOS_TRACEHOOKS_H
@@ -0,0 +1,286 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_TRIPLEBUFFER_HPP
+#define FREERTOS_TRIPLEBUFFER_HPP
+
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/Deadline.hpp>
+#include <atomic>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class TripleBuffer TripleBuffer.hpp <FreeRTOS/TripleBuffer.hpp>
+ *
+ * @brief Class that hands large frames from one producer to one consumer that
+ * only needs the newest frame, without copying and without either side
+ * blocking the other.
+ *
+ * The object holds three buffers.  The producer always owns the back buffer
+ * and fills it in place through back().  publish() swaps the back buffer with
+ * the middle buffer and marks the middle buffer as fresh, so the producer
+ * carries on into a free buffer straight away.  The consumer always owns the
+ * front buffer and reads it in place through front().  update() swaps the
+ * front buffer with the middle buffer if a fresh frame is waiting there.  A
+ * frame that the consumer is too slow to pick up is simply replaced by the
+ * next one.
+ *
+ * Each swap exchanges two small indices in a critical section of a few
+ * instructions, which works the same on cores without atomic read modify write
+ * instructions.  The frames themselves are never copied.
+ *
+ * Unlike FreeRTOS::Mailbox, which copies a small value for any number of
+ * readers, this class suits frames too large to copy and has exactly one
+ * reader.
+ *
+ * @warning There must only be one producer and one consumer.  The producer can
+ * be a task or an interrupt service routine.
+ *
+ * @warning While the consumer is waiting in wait(), its notification at index
+ * Index is used to unblock it, so it must not use it for any other purpose.
+ *
+ * @tparam T Type of a frame.
+ * @tparam Index The index within the consumer's array of notification values
+ * that is used to unblock it in wait().
+ *
+ * <b>Example Usage</b>
+ * @include TripleBuffer/tripleBuffer.cpp
+ */
+template <class T, UBaseType_t Index = 0>
+class TripleBuffer {
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+
+ public:
+  /**
+   * TripleBuffer.hpp
+   *
+   * @brief Construct a new TripleBuffer object.  No frame is fresh until the
+   * first publish().
+   *
+   * @warning This class contains the three frames, so the user should create
+   * this object as a global object or with the static storage specifier so that
+   * the object instance is not on the stack.
+   */
+  TripleBuffer() = default;
+  ~TripleBuffer() = default;
+
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+  TripleBuffer(TripleBuffer&&) = delete;
+  TripleBuffer& operator=(TripleBuffer&&) = delete;
+
+  /**
+   * TripleBuffer.hpp
+   *
+   * @brief Function that returns the buffer the producer fills.  Only the
+   * producer may call it, and the reference is valid until its next
+   * publish().
+   *
+   * @return T& The back buffer.
+   */
+  inline T& back() {
+    return buffers[backIndex];
+  }
+
+  /**
+   * TripleBuffer.hpp
+   *
+   * @brief Function that makes the back buffer the newest frame and gives the
+   * producer a free buffer to fill next.  This function must not be called
+   * from an interrupt service routine.  See publishFromISR() for an
+   * alternative which may be used in an ISR.
+   */
+  void publish() {
+    taskENTER_CRITICAL();
+    backIndex = exchangeMiddle(backIndex, true);
+    taskEXIT_CRITICAL();
+
+    const TaskHandle_t task = consumer.load();
+    if (task != NULL) {
+      xTaskNotifyGiveIndexed(task, Index);
+    }
+  }
+
+  /**
+   * TripleBuffer.hpp
+   *
+   * @brief A version of publish() that can be called from an interrupt service
+   * routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * publishing the frame caused the consumer to unblock, and the consumer has
+   * a priority higher than the currently running task.
+   */
+  void publishFromISR(bool& higherPriorityTaskWoken) {
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    backIndex = exchangeMiddle(backIndex, true);
+    taskEXIT_CRITICAL_FROM_ISR(status);
+
+    const TaskHandle_t task = consumer.load();
+    if (task != NULL) {
+      BaseType_t taskWoken = pdFALSE;
+      vTaskNotifyGiveIndexedFromISR(task, Index, &taskWoken);
+      if (taskWoken == pdTRUE) {
+        higherPriorityTaskWoken = true;
+      }
+    }
+  }
+
+  /**
+   * TripleBuffer.hpp
+   *
+   * @overload
+   */
+  void publishFromISR() {
+    bool higherPriorityTaskWoken = false;
+    publishFromISR(higherPriorityTaskWoken);
+  }
+
+  /**
+   * TripleBuffer.hpp
+   *
+   * @brief Function that makes the newest published frame the front buffer, if
+   * a frame has been published since the last update.  Only the consumer may
+   * call it.
+   *
+   * @retval true front() now returns a new frame.
+   * @retval false No new frame was published, so front() is unchanged.
+   */
+  bool update() {
+    taskENTER_CRITICAL();
+    const bool fresh = ((middle & freshFlag) != 0);
+    if (fresh) {
+      frontIndex = exchangeMiddle(frontIndex, false);
+    }
+    taskEXIT_CRITICAL();
+    return fresh;
+  }
+
+  /**
+   * TripleBuffer.hpp
+   *
+   * @brief Function that blocks the consumer until a frame has been published
+   * since the last update and then makes it the front buffer.
+   *
+   * @param ticksToWait The maximum amount of time the consumer should block
+   * waiting for a new frame.
+   * @retval true front() now returns a new frame.
+   * @retval false No frame was published in time.
+   */
+  bool wait(const TickType_t ticksToWait = portMAX_DELAY) {
+    if (update()) {
+      return true;
+    }
+    if (ticksToWait == 0) {
+      return false;
+    }
+
+    const Deadline deadline(ticksToWait);
+    for (;;) {
+      consumer.store(xTaskGetCurrentTaskHandle());
+      if (!isFresh()) {
+        ulTaskNotifyTakeIndexed(Index, pdTRUE, deadline);
+      }
+      consumer.store(NULL);
+      if (update()) {
+        return true;
+      }
+      if (deadline.hasExpired()) {
+        return false;
+      }
+    }
+  }
+
+  /**
+   * TripleBuffer.hpp
+   *
+   * @overload
+   */
+  template <class Rep, class Period>
+  inline bool wait(const std::chrono::duration<Rep, Period>& timeout) {
+    return wait(Clock::toTicks(timeout));
+  }
+
+  /**
+   * TripleBuffer.hpp
+   *
+   * @brief Function that returns the buffer the consumer reads.  Only the
+   * consumer may call it, and the reference is valid until its next update()
+   * or wait().  Before the first frame arrives it holds a default constructed
+   * T.
+   *
+   * @return T& The front buffer.
+   */
+  inline T& front() {
+    return buffers[frontIndex];
+  }
+
+  /**
+   * TripleBuffer.hpp
+   *
+   * @brief Function that returns whether a frame has been published since the
+   * last update.
+   *
+   * @retval true The next update() returns a new frame.
+   * @retval false Otherwise.
+   */
+  inline bool isFresh() const {
+    return ((middle & freshFlag) != 0);
+  }
+
+ private:
+  static constexpr uint8_t indexMask = 0x03;
+  static constexpr uint8_t freshFlag = 0x04;
+
+  // Called in a critical section.  Returns the index that was in the middle.
+  inline uint8_t exchangeMiddle(const uint8_t index, const bool fresh) {
+    const uint8_t previous = middle & indexMask;
+    middle = index | (fresh ? freshFlag : 0);
+    return previous;
+  }
+
+  T buffers[3];
+  uint8_t backIndex = 0;
+  uint8_t frontIndex = 1;
+  volatile uint8_t middle = 2;
+  std::atomic<TaskHandle_t> consumer{NULL};
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+#endif  // FREERTOS_TRIPLEBUFFER_HPP
@@ -0,0 +1,463 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_WORKSTEALINGPOOL_HPP
+#define FREERTOS_WORKSTEALINGPOOL_HPP
+
+#include <FreeRTOS/DeferCreate.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1) && \
+    (configUSE_TASK_NOTIFICATIONS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class WorkStealingPool WorkStealingPool.hpp
+ * <FreeRTOS/WorkStealingPool.hpp>
+ *
+ * @brief Class that runs short jobs on a fixed set of worker tasks that each
+ * keep their own job deque and steal from each other when they run out.
+ *
+ * FreeRTOS::WorkerPool shares one queue between all of its workers, so on an
+ * SMP build every submit and every receive takes the same queue lock.  In this
+ * pool a job submitted by a worker is pushed onto the bottom of that worker's
+ * own deque, and the worker pops from the same end, so in the common case no
+ * other core is involved.  A worker whose deque is empty steals from the top
+ * of the other workers' deques.  The deques are Chase-Lev deques: push and pop
+ * are plain loads and stores, and only a steal, or a pop racing a steal for
+ * the last job, needs a compare and swap.
+ *
+ * Jobs submitted by other tasks and by interrupts go to a per-worker inbox, a
+ * FreeRTOS::StaticQueue, chosen round robin or by submitTo().  On an SMP
+ * build with configUSE_CORE_AFFINITY worker i is pinned to core
+ * <tt>i % configNUMBER_OF_CORES</tt>, so submitTo() doubles as a core affinity
+ * hint.
+ *
+ * A worker that finds nothing to do marks itself idle and waits on a task
+ * notification.  A submit wakes at most one idle worker, so a busy pool calls
+ * into the kernel only when a worker actually has to be woken.
+ *
+ * When configNUMBER_OF_CORES is 1 the compare and swap is done in a critical
+ * section, so the pool also works on cores without atomic read modify write
+ * instructions.  On SMP ports the target must support them.
+ *
+ * @warning This class contains the stacks of the workers, their deques and
+ * their inboxes, so the user should create this object as a global object or
+ * with the static storage specifier so that the object instance is not on the
+ * stack.
+ *
+ * @tparam Workers The number of worker tasks.
+ * @tparam Depth The capacity of the deque and of the inbox of each worker.
+ * Must be a power of 2.
+ * @tparam StackWords The stack depth of each worker task, in words.
+ * @tparam JobSize The maximum size in bytes of a job's callable object.
+ *
+ * <b>Example Usage</b>
+ * @include WorkStealingPool/workStealingPool.cpp
+ */
+template <UBaseType_t Workers, UBaseType_t Depth,
+          UBaseType_t StackWords = configMINIMAL_STACK_SIZE,
+          size_t JobSize = 4 * sizeof(void*)>
+class WorkStealingPool {
+  static_assert(Workers > 0, "WorkStealingPool needs at least one worker.");
+  static_assert((Depth > 0) && ((Depth & (Depth - 1)) == 0),
+                "Depth must be a power of 2.");
+
+ public:
+  /**
+   * WorkStealingPool.hpp
+   *
+   * @brief Construct a new WorkStealingPool object and create its worker
+   * tasks.
+   *
+   * @param priority The priority at which the worker tasks execute.
+   * @param name The name given to every worker task.
+   */
+  explicit WorkStealingPool(const UBaseType_t priority = tskIDLE_PRIORITY + 1,
+                            const char* name = "Worker") {
+    for (UBaseType_t i = 0; i < Workers; i++) {
+      workers[i].pool = this;
+      workers[i].index = i;
+#if (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1)
+      workers[i].create(priority, name, 1U << (i % configNUMBER_OF_CORES));
+#else
+      workers[i].create(priority, name);
+#endif /* (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1) */
+    }
+  }
+  ~WorkStealingPool() = default;
+
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+  WorkStealingPool(WorkStealingPool&&) = delete;
+  WorkStealingPool& operator=(WorkStealingPool&&) = delete;
+
+  /**
+   * WorkStealingPool.hpp
+   *
+   * @brief Function that queues a job.  A job submitted by a worker of this
+   * pool goes on that worker's own deque.  A job submitted by any other task
+   * goes to the inbox of the next worker in round robin order.  This function
+   * must not be called from an interrupt service routine.  See submitFromISR()
+   * for an alternative which may be used in an ISR.
+   *
+   * @param function The callable object to run.  It is copied into the deque or
+   * the inbox.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for space in an inbox, should it already be full.  A worker never blocks on
+   * its own deque.
+   * @param notifyOnCompletion Task to notify with notifyGive() once the job has
+   * run, or nullptr.
+   * @param notifyIndex The index of the notification that is given.
+   * @retval true if the job was queued.
+   * @retval false otherwise.
+   */
+  template <class Function>
+  bool submit(Function&& function, const TickType_t ticksToWait = portMAX_DELAY,
+              const TaskBase* notifyOnCompletion = nullptr,
+              const UBaseType_t notifyIndex = 0) {
+    const Job job = makeJob(std::forward<Function>(function),
+                            notifyOnCompletion, notifyIndex);
+    Worker* const self = currentWorker();
+    if ((self != nullptr) && self->deque.push(job)) {
+      wakeIdle(self->index);
+      return true;
+    }
+    return sendToInbox(nextInbox(), job, ticksToWait);
+  }
+
+  /**
+   * WorkStealingPool.hpp
+   *
+   * @brief Function that queues a job for a particular worker.  It may still
+   * be stolen by another worker if that worker falls behind.
+   *
+   * @param worker The index of the worker, from 0 to Workers - 1.  On SMP
+   * builds with core affinity it runs on core <tt>worker %
+   * configNUMBER_OF_CORES</tt>.
+   * @param function The callable object to run.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for space in the inbox, should it already be full.
+   * @param notifyOnCompletion Task to notify with notifyGive() once the job has
+   * run, or nullptr.
+   * @param notifyIndex The index of the notification that is given.
+   * @retval true if the job was queued.
+   * @retval false otherwise.
+   */
+  template <class Function>
+  bool submitTo(const UBaseType_t worker, Function&& function,
+                const TickType_t ticksToWait = portMAX_DELAY,
+                const TaskBase* notifyOnCompletion = nullptr,
+                const UBaseType_t notifyIndex = 0) {
+    configASSERT(worker < Workers);
+    const Job job = makeJob(std::forward<Function>(function),
+                            notifyOnCompletion, notifyIndex);
+    if ((currentWorker() == &workers[worker]) &&
+        workers[worker].deque.push(job)) {
+      wakeIdle(worker);
+      return true;
+    }
+    return sendToInbox(worker, job, ticksToWait);
+  }
+
+  /**
+   * WorkStealingPool.hpp
+   *
+   * @brief A version of submit() that can be called from an interrupt service
+   * routine.  The job goes to the inbox of the next worker in round robin
+   * order.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * queuing the job caused a worker to unblock, and the worker has a priority
+   * higher than the currently running task.
+   * @param function The callable object to run.
+   * @param notifyOnCompletion Task to notify with notifyGive() once the job has
+   * run, or nullptr.
+   * @param notifyIndex The index of the notification that is given.
+   * @retval true if the job was queued.
+   * @retval false if the inbox was full.
+   */
+  template <class Function>
+  bool submitFromISR(bool& higherPriorityTaskWoken, Function&& function,
+                     const TaskBase* notifyOnCompletion = nullptr,
+                     const UBaseType_t notifyIndex = 0) {
+    Worker& worker = workers[nextInbox()];
+    if (!worker.inbox.sendToBackFromISR(
+            higherPriorityTaskWoken,
+            makeJob(std::forward<Function>(function), notifyOnCompletion,
+                    notifyIndex))) {
+      return false;
+    }
+    worker.notifyGiveFromISR(higherPriorityTaskWoken);
+    return true;
+  }
+
+  /**
+   * WorkStealingPool.hpp
+   *
+   * @overload
+   */
+  template <class Function>
+  bool submitFromISR(Function&& function) {
+    bool higherPriorityTaskWoken = false;
+    return submitFromISR(higherPriorityTaskWoken,
+                         std::forward<Function>(function));
+  }
+
+  /**
+   * WorkStealingPool.hpp
+   *
+   * @brief Function that returns the number of jobs a worker has taken from
+   * the other workers' deques.
+   *
+   * @param worker The index of the worker, from 0 to Workers - 1.
+   * @return uint32_t The number of successful steals.
+   */
+  inline uint32_t getSteals(const UBaseType_t worker) const {
+    return workers[worker].steals.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Job {
+    void (*invoke)(void* storage);
+    const TaskBase* notifyOnCompletion;
+    UBaseType_t notifyIndex;
+    alignas(std::max_align_t) uint8_t storage[JobSize];
+
+    inline void run() {
+      invoke(storage);
+      if (notifyOnCompletion != nullptr) {
+        notifyOnCompletion->notifyGive(notifyIndex);
+      }
+    }
+  };
+
+  // Bounded Chase-Lev deque.  Only the owning worker calls push() and pop(),
+  // any worker may call steal().
+  class Deque {
+   public:
+    bool push(const Job& job) {
+      const int32_t b = bottom.load(std::memory_order_relaxed);
+      const int32_t t = top.load(std::memory_order_acquire);
+      if ((b - t) >= static_cast<int32_t>(Depth)) {
+        return false;
+      }
+      ring[b & (Depth - 1)] = job;
+      std::atomic_thread_fence(std::memory_order_release);
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return true;
+    }
+
+    bool pop(Job& job) {
+      const int32_t b = bottom.load(std::memory_order_relaxed) - 1;
+      bottom.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int32_t t = top.load(std::memory_order_relaxed);
+
+      bool result = false;
+      if (t <= b) {
+        job = ring[b & (Depth - 1)];
+        result = true;
+        if (t == b) {
+          // Last job, so race any thief for it.
+          result = claim(t);
+          bottom.store(b + 1, std::memory_order_relaxed);
+        }
+      } else {
+        bottom.store(b + 1, std::memory_order_relaxed);
+      }
+      return result;
+    }
+
+    bool steal(Job& job) {
+      const int32_t t = top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const int32_t b = bottom.load(std::memory_order_acquire);
+      if (t >= b) {
+        return false;
+      }
+      job = ring[t & (Depth - 1)];
+      return claim(t);
+    }
+
+    inline bool isEmpty() const {
+      return (top.load(std::memory_order_acquire) >=
+              bottom.load(std::memory_order_acquire));
+    }
+
+   private:
+    // Moves top from t to t + 1 if no other worker has done so already.
+    inline bool claim(int32_t t) {
+#if (configNUMBER_OF_CORES > 1)
+      return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed);
+#else
+      taskENTER_CRITICAL();
+      const bool claimed = (top.load(std::memory_order_relaxed) == t);
+      if (claimed) {
+        top.store(t + 1, std::memory_order_relaxed);
+      }
+      taskEXIT_CRITICAL();
+      return claimed;
+#endif /* configNUMBER_OF_CORES */
+    }
+
+    std::atomic<int32_t> top{0};
+    std::atomic<int32_t> bottom{0};
+    Job ring[Depth];
+  };
+
+  class Worker : public StaticTask<StackWords> {
+   public:
+    Worker() : StaticTask<StackWords>(deferCreate) {}
+
+    WorkStealingPool* pool = nullptr;
+    UBaseType_t index = 0;
+    std::atomic<TaskHandle_t> self{NULL};
+    std::atomic<bool> idle{false};
+    std::atomic<uint32_t> steals{0};
+    Deque deque;
+    StaticQueue<Job, Depth> inbox;
+
+   private:
+    void taskFunction() final {
+      self.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+
+      Job job;
+      for (;;) {
+        if (pool->findJob(*this, job)) {
+          job.run();
+          continue;
+        }
+
+        // Announce that this worker is idle before looking once more, so that
+        // a submit either sees the flag or its job is found here.
+        idle.store(true, std::memory_order_seq_cst);
+        if (pool->findJob(*this, job)) {
+          idle.store(false, std::memory_order_relaxed);
+          job.run();
+          continue;
+        }
+        this->notifyTake(portMAX_DELAY);
+        idle.store(false, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  bool findJob(Worker& worker, Job& job) {
+    if (worker.deque.pop(job) || worker.inbox.receive(job, 0)) {
+      return true;
+    }
+    for (UBaseType_t i = 1; i < Workers; i++) {
+      Worker& victim = workers[(worker.index + i) % Workers];
+      if (victim.deque.steal(job) || victim.inbox.receive(job, 0)) {
+        worker.steals.store(worker.steals.load(std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Wakes one idle worker other than the one that queued the job.
+  void wakeIdle(const UBaseType_t from) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (UBaseType_t i = 1; i < Workers; i++) {
+      Worker& worker = workers[(from + i) % Workers];
+      if (worker.idle.load(std::memory_order_relaxed)) {
+        worker.notifyGive();
+        return;
+      }
+    }
+  }
+
+  bool sendToInbox(const UBaseType_t index, const Job& job,
+                   const TickType_t ticksToWait) {
+    if (!workers[index].inbox.sendToBack(job, ticksToWait)) {
+      return false;
+    }
+    workers[index].notifyGive();
+    return true;
+  }
+
+  inline Worker* currentWorker() {
+    const TaskHandle_t current = xTaskGetCurrentTaskHandle();
+    for (auto& worker : workers) {
+      if (worker.self.load(std::memory_order_relaxed) == current) {
+        return &worker;
+      }
+    }
+    return nullptr;
+  }
+
+  inline UBaseType_t nextInbox() {
+    const UBaseType_t index = next.load(std::memory_order_relaxed);
+    next.store((index + 1) % Workers, std::memory_order_relaxed);
+    return index;
+  }
+
+  template <class Function>
+  static Job makeJob(Function&& function, const TaskBase* notifyOnCompletion,
+                     const UBaseType_t notifyIndex) {
+    using Callable = std::decay_t<Function>;
+    static_assert(std::is_trivially_copyable_v<Callable>,
+                  "Jobs are copied into deques and queues, so they must be "
+                  "trivially copyable.");
+    static_assert(sizeof(Callable) <= JobSize,
+                  "The job is larger than the JobSize of the pool.");
+    static_assert(alignof(Callable) <= alignof(std::max_align_t),
+                  "The job is over aligned.");
+
+    Job job;
+    job.invoke = [](void* storage) {
+      (*std::launder(reinterpret_cast<Callable*>(storage)))();  // NOLINT
+    };
+    job.notifyOnCompletion = notifyOnCompletion;
+    job.notifyIndex = notifyIndex;
+    ::new (job.storage) Callable(std::forward<Function>(function));
+    return job;
+  }
+
+  std::atomic<UBaseType_t> next{0};
+  Worker workers[Workers];
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION && configUSE_TASK_NOTIFICATIONS */
+
+#endif  // FREERTOS_WORKSTEALINGPOOL_HPP
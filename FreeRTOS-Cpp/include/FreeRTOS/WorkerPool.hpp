@@ -0,0 +1,255 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_WORKERPOOL_HPP
+#define FREERTOS_WORKERPOOL_HPP
+
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class WorkerPool WorkerPool.hpp <FreeRTOS/WorkerPool.hpp>
+ *
+ * @brief Class that runs short jobs on a fixed set of worker tasks.
+ *
+ * The pool is made of Workers FreeRTOS::StaticTask objects that share one
+ * FreeRTOS::StaticQueue of jobs.  A job is any callable object that is
+ * trivially copyable and fits in JobSize bytes, such as a lambda that captures
+ * a few pointers or integers.  The callable is copied into the queue item
+ * itself, so submitting a job never uses the heap and never creates a task.
+ *
+ * A job can optionally notify a task when it has finished by calling
+ * FreeRTOS::TaskBase::notifyGive() on it.
+ *
+ * @warning This class contains the stacks of the workers and the storage for
+ * the queue, so the user should create this object as a global object or with
+ * the static storage specifier so that the object instance is not on the stack.
+ *
+ * @tparam Workers The number of worker tasks.
+ * @tparam Depth The maximum number of jobs waiting to run.
+ * @tparam StackWords The stack depth of each worker task, in words.
+ * @tparam JobSize The maximum size in bytes of a job's callable object.
+ *
+ * <b>Example Usage</b>
+ * @include WorkerPool/workerPool.cpp
+ */
+template <UBaseType_t Workers, UBaseType_t Depth,
+          UBaseType_t StackWords = configMINIMAL_STACK_SIZE,
+          size_t JobSize = 4 * sizeof(void*)>
+class WorkerPool {
+  static_assert(Workers > 0, "WorkerPool needs at least one worker.");
+
+ public:
+  /**
+   * WorkerPool.hpp
+   *
+   * @brief Construct a new WorkerPool object and its worker tasks.
+   *
+   * @param priority The priority at which the worker tasks execute.
+   * @param name The name given to every worker task.
+   */
+  explicit WorkerPool(const UBaseType_t priority = tskIDLE_PRIORITY + 1,
+                      const char* name = "Worker")
+      : WorkerPool(priority, name, std::make_index_sequence<Workers>()) {}
+  ~WorkerPool() = default;
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+  WorkerPool(WorkerPool&&) = delete;
+  WorkerPool& operator=(WorkerPool&&) = delete;
+
+  static void* operator new(size_t) = delete;
+  static void* operator new[](size_t) = delete;
+
+  static void* operator new(size_t, void* ptr) {
+    return ptr;
+  }
+
+  static void* operator new[](size_t, void* ptr) {
+    return ptr;
+  }
+
+  /**
+   * WorkerPool.hpp
+   *
+   * @brief Function that queues a job to run on the next free worker.  This
+   * function must not be called from an interrupt service routine.  See
+   * submitFromISR() for an alternative which may be used in an ISR.
+   *
+   * @param function The callable object to run.  It is copied into the queue.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for space in the queue, should it already be full.
+   * @param notifyOnCompletion Task to notify with notifyGive() once the job has
+   * run, or nullptr.
+   * @param notifyIndex The index of the notification that is given.
+   * @retval true if the job was queued.
+   * @retval false otherwise.
+   */
+  template <class Function>
+  bool submit(Function&& function, const TickType_t ticksToWait = portMAX_DELAY,
+              const TaskBase* notifyOnCompletion = nullptr,
+              const UBaseType_t notifyIndex = 0) const {
+    return jobs.sendToBack(
+        makeJob(std::forward<Function>(function), notifyOnCompletion,
+                notifyIndex),
+        ticksToWait);
+  }
+
+  /**
+   * WorkerPool.hpp
+   *
+   * @brief A version of submit() that can be called from an interrupt service
+   * routine.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * queuing the job caused a worker to unblock, and the worker has a priority
+   * higher than the currently running task.
+   * @param function The callable object to run.  It is copied into the queue.
+   * @param notifyOnCompletion Task to notify with notifyGive() once the job has
+   * run, or nullptr.
+   * @param notifyIndex The index of the notification that is given.
+   * @retval true if the job was queued.
+   * @retval false if the queue was full.
+   */
+  template <class Function>
+  bool submitFromISR(bool& higherPriorityTaskWoken, Function&& function,
+                     const TaskBase* notifyOnCompletion = nullptr,
+                     const UBaseType_t notifyIndex = 0) const {
+    return jobs.sendToBackFromISR(
+        higherPriorityTaskWoken,
+        makeJob(std::forward<Function>(function), notifyOnCompletion,
+                notifyIndex));
+  }
+
+  /**
+   * WorkerPool.hpp
+   *
+   * @brief A version of submit() that can be called from an interrupt service
+   * routine.
+   *
+   * @overload
+   */
+  template <class Function>
+  bool submitFromISR(Function&& function) const {
+    bool higherPriorityTaskWoken = false;
+    return submitFromISR(higherPriorityTaskWoken,
+                         std::forward<Function>(function));
+  }
+
+  /**
+   * WorkerPool.hpp
+   *
+   * @brief Function that returns the number of jobs waiting for a worker.
+   */
+  inline UBaseType_t jobsWaiting() const {
+    return jobs.messagesWaiting();
+  }
+
+ private:
+  struct Job {
+    void (*invoke)(void* storage);
+    const TaskBase* notifyOnCompletion;
+    UBaseType_t notifyIndex;
+    alignas(std::max_align_t) uint8_t storage[JobSize];
+
+    inline void run() {
+      invoke(storage);
+      if (notifyOnCompletion != nullptr) {
+        notifyOnCompletion->notifyGive(notifyIndex);
+      }
+    }
+  };
+
+  class Worker : public StaticTask<StackWords> {
+   public:
+    // The task is created last, as it uses pool as soon as it runs.
+    Worker(const WorkerPool& pool, const UBaseType_t priority,
+           const char* name)
+        : StaticTask<StackWords>(deferCreate), pool(pool) {
+      this->create(priority, name);
+    }
+
+   private:
+    void taskFunction() final {
+      Job job;
+      for (;;) {
+        if (pool.jobs.receive(job, portMAX_DELAY)) {
+          job.run();
+        }
+      }
+    }
+
+    const WorkerPool& pool;
+  };
+
+  template <size_t... Indices>
+  WorkerPool(const UBaseType_t priority, const char* name,
+             std::index_sequence<Indices...>)
+      : workers{((void)Indices, Worker(*this, priority, name))...} {}
+
+  template <class Function>
+  static Job makeJob(Function&& function, const TaskBase* notifyOnCompletion,
+                     const UBaseType_t notifyIndex) {
+    using Callable = std::decay_t<Function>;
+    static_assert(std::is_trivially_copyable_v<Callable>,
+                  "Jobs are copied through a queue, so they must be trivially "
+                  "copyable.");
+    static_assert(sizeof(Callable) <= JobSize,
+                  "The job is larger than the JobSize of the WorkerPool.");
+    static_assert(alignof(Callable) <= alignof(std::max_align_t),
+                  "The job is over aligned.");
+
+    Job job;
+    job.invoke = [](void* storage) {
+      (*std::launder(reinterpret_cast<Callable*>(storage)))();  // NOLINT
+    };
+    job.notifyOnCompletion = notifyOnCompletion;
+    job.notifyIndex = notifyIndex;
+    ::new (job.storage) Callable(std::forward<Function>(function));
+    return job;
+  }
+
+  StaticQueue<Job, Depth> jobs;
+  Worker workers[Workers];
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif  // FREERTOS_WORKERPOOL_HPP
@@ -0,0 +1,458 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+
+#ifndef FREERTOS_ZEROCOPYSTREAMBUFFER_HPP
+#define FREERTOS_ZEROCOPYSTREAMBUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+
+namespace FreeRTOS {
+
+/**
+ * @class StaticZeroCopyStreamBuffer ZeroCopyStreamBuffer.hpp
+ * <FreeRTOS/ZeroCopyStreamBuffer.hpp>
+ *
+ * @brief Class that implements a single writer, single reader byte stream whose
+ * ring storage is written and read in place.
+ *
+ * A FreeRTOS stream buffer always copies bytes between the caller's buffer and
+ * its own storage, and the kernel does not expose its ring indices, so it can
+ * not hand out pointers into that storage.  This class keeps its own ring
+ * storage and indices instead.  The writer calls acquireWrite() to get a
+ * contiguous region of free space, fills it (for example by pointing a DMA
+ * transfer at it) and then calls commitWrite() with the number of bytes
+ * written.  The reader calls acquireRead() to get the stored bytes as up to two
+ * contiguous regions, because the data may wrap around the end of the ring,
+ * and then calls commitRead() with the number of bytes it has finished with.
+ *
+ * As with a stream buffer the reader is only woken once at least the trigger
+ * level number of bytes is stored.  Like FreeRTOS::StaticSpscQueue, neither
+ * side enters a critical section, and a task notification is only sent when
+ * the other side is blocked.
+ *
+ * @warning Exactly one task or interrupt may write, and exactly one task or
+ * interrupt may read.  The notification at index Index of the reading and
+ * writing tasks must not be used for any other purpose.
+ *
+ * @tparam N The number of bytes the stream can hold at any one time.
+ * @tparam Index The index within the tasks' array of notification values that
+ * is used to unblock a waiting writer or reader.
+ * @tparam Alignment The alignment, in bytes, of the ring storage.  Set it to
+ * the data cache line size when the storage is the source or destination of
+ * DMA transfers.  Must be a power of two.  As with FreeRTOS::StaticStreamBuffer
+ * a section attribute on the object declaration places the storage in a
+ * particular memory region.
+ *
+ * <b>Example Usage</b>
+ * @include ZeroCopyStreamBuffer/zeroCopyStreamBuffer.cpp
+ */
+template <size_t N, UBaseType_t Index = 0,
+          size_t Alignment = alignof(uint8_t)>
+class StaticZeroCopyStreamBuffer {
+  static_assert(N > 0, "StaticZeroCopyStreamBuffer must hold at least a byte.");
+  static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "Index must be less than "
+                "configTASK_NOTIFICATION_ARRAY_ENTRIES.");
+  static_assert((Alignment & (Alignment - 1)) == 0,
+                "Alignment must be a power of two.");
+
+ public:
+  /**
+   * @brief A contiguous region of the ring storage.
+   */
+  struct Span {
+    uint8_t* data;
+    size_t size;
+  };
+
+  /**
+   * @brief The stored bytes, in order.  second is only non-empty if the data
+   * wraps around the end of the ring storage.
+   */
+  struct ReadSpans {
+    Span first;
+    Span second;
+
+    inline size_t size() const {
+      return first.size + second.size;
+    }
+  };
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief Construct a new StaticZeroCopyStreamBuffer object.
+   *
+   * @warning This class contains the storage buffer for the stream, so the
+   * user should create this object as a global object or with the static
+   * storage specifier so that the object instance is not on the stack.
+   *
+   * @param triggerLevel The number of bytes that must be stored before a reader
+   * that is blocked in acquireRead() is woken.  A trigger level of 0 is treated
+   * as 1, and it must not be greater than N.
+   */
+  explicit StaticZeroCopyStreamBuffer(const size_t triggerLevel = 0)
+      : triggerLevel((triggerLevel == 0) ? 1 : triggerLevel) {
+    configASSERT(triggerLevel <= N);
+  }
+  ~StaticZeroCopyStreamBuffer() = default;
+
+  StaticZeroCopyStreamBuffer(const StaticZeroCopyStreamBuffer&) = delete;
+  StaticZeroCopyStreamBuffer& operator=(const StaticZeroCopyStreamBuffer&) =
+      delete;
+  StaticZeroCopyStreamBuffer(StaticZeroCopyStreamBuffer&&) = delete;
+  StaticZeroCopyStreamBuffer& operator=(StaticZeroCopyStreamBuffer&&) = delete;
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief Function that returns a contiguous region of free space that the
+   * writer can fill in place.  This function must not be called from an
+   * interrupt service routine.  See acquireWriteFromISR() for an alternative
+   * which may be used in an ISR.
+   *
+   * @param maxLength The largest region the caller wants.
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for space to become available, should the stream already be full.
+   * @return Span The free region.  Its size is 0 if ticksToWait expired while
+   * the stream was full, and may be smaller than maxLength if there is less
+   * free space or the free space wraps around the end of the ring.
+   */
+  Span acquireWrite(const size_t maxLength,
+                    const TickType_t ticksToWait = portMAX_DELAY) {
+    waitFor(writer, ticksToWait, [this] { return !isFull(); });
+    return acquireWriteFromISR(maxLength);
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief A version of acquireWrite() that does not block, and so can be
+   * called from an interrupt service routine.
+   *
+   * @param maxLength The largest region the caller wants.
+   * @return Span The free region.  Its size is 0 if the stream is full.
+   */
+  Span acquireWriteFromISR(const size_t maxLength) {
+    const size_t first = head.load();
+    const size_t last = tail.load(std::memory_order_relaxed);
+    // The byte before head must stay empty, so the region stops short of the
+    // end of the ring when head is at the start.
+    size_t length = (last >= first) ? (Slots - last) : (first - last - 1);
+    if (first == 0) {
+      length--;
+    }
+    return Span{&storage[last], (length < maxLength) ? length : maxLength};
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief Function that publishes bytes written into the region returned by
+   * the last acquireWrite(), and wakes the reader if the trigger level is
+   * reached.  This function must not be called from an interrupt service
+   * routine.
+   *
+   * @param length The number of bytes that were written.  Must not be more than
+   * the size of the acquired region.
+   */
+  void commitWrite(const size_t length) {
+    advance(tail, length);
+    if (bytesAvailable() >= triggerLevel.load()) {
+      wake(reader);
+    }
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief A version of commitWrite() that can be called from an interrupt
+   * service routine, for example from a DMA transfer complete interrupt.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * committing caused the reader to unblock, and the reader has a priority
+   * higher than the currently running task.
+   * @param length The number of bytes that were written.
+   */
+  void commitWriteFromISR(bool& higherPriorityTaskWoken, const size_t length) {
+    advance(tail, length);
+    if (bytesAvailable() >= triggerLevel.load()) {
+      wakeFromISR(higherPriorityTaskWoken, reader);
+    }
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @overload
+   */
+  void commitWriteFromISR(const size_t length) {
+    bool higherPriorityTaskWoken = false;
+    commitWriteFromISR(higherPriorityTaskWoken, length);
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief Function that returns the stored bytes so that the reader can use
+   * them in place.  This function must not be called from an interrupt service
+   * routine.  See acquireReadFromISR() for an alternative which may be used in
+   * an ISR.
+   *
+   * @param ticksToWait The maximum amount of time the task should block waiting
+   * for the trigger level to be reached.  If it expires, whatever bytes are
+   * stored are still returned.
+   * @return ReadSpans The stored bytes.
+   */
+  ReadSpans acquireRead(const TickType_t ticksToWait = portMAX_DELAY) {
+    waitFor(reader, ticksToWait,
+            [this] { return bytesAvailable() >= triggerLevel.load(); });
+    return acquireReadFromISR();
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief A version of acquireRead() that does not block, and so can be
+   * called from an interrupt service routine.
+   *
+   * @return ReadSpans The stored bytes.
+   */
+  ReadSpans acquireReadFromISR() {
+    const size_t first = head.load(std::memory_order_relaxed);
+    const size_t last = tail.load();
+    if (last >= first) {
+      return ReadSpans{Span{&storage[first], last - first},
+                       Span{&storage[0], 0}};
+    }
+    return ReadSpans{Span{&storage[first], Slots - first},
+                     Span{&storage[0], last}};
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief Function that releases bytes the reader has finished with, and wakes
+   * the writer if it is waiting for space.  This function must not be called
+   * from an interrupt service routine.
+   *
+   * @param length The number of bytes to release, starting at the oldest.  Must
+   * not be more than the size of the acquired regions.
+   */
+  void commitRead(const size_t length) {
+    advance(head, length);
+    wake(writer);
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief A version of commitRead() that can be called from an interrupt
+   * service routine, for example from a DMA transfer complete interrupt.
+   *
+   * @param higherPriorityTaskWoken A reference that will be set to true if
+   * committing caused the writer to unblock, and the writer has a priority
+   * higher than the currently running task.
+   * @param length The number of bytes to release, starting at the oldest.
+   */
+  void commitReadFromISR(bool& higherPriorityTaskWoken, const size_t length) {
+    advance(head, length);
+    wakeFromISR(higherPriorityTaskWoken, writer);
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @overload
+   */
+  void commitReadFromISR(const size_t length) {
+    bool higherPriorityTaskWoken = false;
+    commitReadFromISR(higherPriorityTaskWoken, length);
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief Function that returns the number of bytes stored.
+   *
+   * @return size_t The number of bytes that can be read.
+   */
+  size_t bytesAvailable() const {
+    const size_t first = head.load();
+    const size_t last = tail.load();
+    return (last >= first) ? (last - first) : (last + Slots - first);
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief Function that returns the number of free bytes.
+   *
+   * @return size_t The number of bytes that can be written.
+   */
+  size_t spacesAvailable() const {
+    return N - bytesAvailable();
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief Function that changes the trigger level.
+   *
+   * @param triggerLevel The new trigger level.  0 is treated as 1.
+   * @retval true The trigger level was changed.
+   * @retval false triggerLevel was greater than N, so it was not changed.
+   */
+  bool setTriggerLevel(const size_t triggerLevel = 0) {
+    if (triggerLevel > N) {
+      return false;
+    }
+    this->triggerLevel.store((triggerLevel == 0) ? 1 : triggerLevel);
+    return true;
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief Queries the stream to determine if it is empty.
+   *
+   * @retval true if the stream is empty.
+   * @retval false if the stream is not empty.
+   */
+  bool isEmpty() const {
+    return (head.load() == tail.load());
+  }
+
+  /**
+   * ZeroCopyStreamBuffer.hpp
+   *
+   * @brief Queries the stream to determine if it is full.
+   *
+   * @retval true if the stream is full.
+   * @retval false if the stream is not full.
+   */
+  bool isFull() const {
+    return (bytesAvailable() == N);
+  }
+
+ private:
+  /**
+   * @brief One byte is always left empty so that a full stream can be told
+   * apart from an empty stream without a shared counter.
+   */
+  static constexpr size_t Slots = N + 1;
+
+  static void advance(std::atomic<size_t>& position, const size_t length) {
+    const size_t next = position.load(std::memory_order_relaxed) + length;
+    position.store((next >= Slots) ? (next - Slots) : next);
+  }
+
+  // Same protocol as StaticSpscQueue::waitFor().
+  template <class Predicate>
+  static bool waitFor(std::atomic<TaskHandle_t>& waiter,
+                      TickType_t ticksToWait, Predicate ready) {
+    if (ready()) {
+      return true;
+    }
+    if (ticksToWait == 0) {
+      return false;
+    }
+
+    TimeOut_t timeOut;
+    vTaskSetTimeOutState(&timeOut);
+    for (;;) {
+      waiter.store(xTaskGetCurrentTaskHandle());
+      if (!ready()) {
+        ulTaskNotifyTakeIndexed(Index, pdTRUE, ticksToWait);
+      }
+      waiter.store(NULL);
+      if (ready()) {
+        return true;
+      }
+      if (xTaskCheckForTimeOut(&timeOut, &ticksToWait) == pdTRUE) {
+        return false;
+      }
+    }
+  }
+
+  static void wake(const std::atomic<TaskHandle_t>& waiter) {
+    const TaskHandle_t task = waiter.load();
+    if (task != NULL) {
+      xTaskNotifyGiveIndexed(task, Index);
+    }
+  }
+
+  static void wakeFromISR(bool& higherPriorityTaskWoken,
+                          const std::atomic<TaskHandle_t>& waiter) {
+    const TaskHandle_t task = waiter.load();
+    if (task != NULL) {
+      BaseType_t taskWoken = pdFALSE;
+      vTaskNotifyGiveIndexedFromISR(task, Index, &taskWoken);
+      if (taskWoken == pdTRUE) {
+        higherPriorityTaskWoken = true;
+      }
+    }
+  }
+
+  /**
+   * @brief Index of the oldest stored byte.  Only written by the reader.
+   */
+  std::atomic<size_t> head{0};
+
+  /**
+   * @brief Index of the next free byte.  Only written by the writer.
+   */
+  std::atomic<size_t> tail{0};
+
+  std::atomic<size_t> triggerLevel;
+
+  /**
+   * @brief Task blocked waiting for the trigger level, or NULL.
+   */
+  std::atomic<TaskHandle_t> reader{NULL};
+
+  /**
+   * @brief Task blocked waiting for space, or NULL.
+   */
+  std::atomic<TaskHandle_t> writer{NULL};
+
+  alignas(Alignment) uint8_t storage[Slots];
+};
+
+}  // namespace FreeRTOS
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+#endif  // FREERTOS_ZEROCOPYSTREAMBUFFER_HPP
@@ -0,0 +1,358 @@
+/*
+ * FreeRTOS-Cpp
+ * Copyright (C) 2021 Jon Enz. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * https://github.com/jonenz/FreeRTOS-Cpp
+ */
+
+#ifndef FREERTOS_BENCHMARK_HPP
+#define FREERTOS_BENCHMARK_HPP
+
+#include <FreeRTOS/Task.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Function provided by the application that writes a null terminated
+ * string to the serial port (or any other output) used to collect benchmark
+ * results.
+ *
+ * @param string The string to write.
+ */
+extern "C" void benchmarkWrite(const char* string);
+
+/**
+ * @brief Function that counts context switches for the throughput benchmarks.
+ * To enable the context switch column, add the following to FreeRTOSConfig.h:
+ * @code{c}
+ * void benchmarkTaskSwitchedIn(void);
+ * #define traceTASK_SWITCHED_IN() benchmarkTaskSwitchedIn()
+ * @endcode
+ * Without it the benchmarks still run, but every context switch count is zero.
+ */
+extern "C" void benchmarkTaskSwitchedIn(void);
+
+/**
+ * @brief Set to 1 to also run the benchmarks that need an interrupt, which are
+ * the throughput benchmarks with an interrupt producer and the interrupt to
+ * task latency benchmarks.  The application must then implement
+ * benchmarkPendInterrupt() and call Benchmark::interruptHandler() from the
+ * handler of that interrupt.
+ */
+#ifndef BENCHMARK_ISR_PRODUCER
+#define BENCHMARK_ISR_PRODUCER 0
+#endif
+
+#if (BENCHMARK_ISR_PRODUCER == 1)
+/**
+ * @brief Function provided by the application that sets a spare interrupt
+ * pending, for example by writing its number to the NVIC software trigger
+ * interrupt register.  The interrupt priority must be at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY so that it can use the FreeRTOS API.
+ */
+extern "C" void benchmarkPendInterrupt(void);
+#endif /* BENCHMARK_ISR_PRODUCER */
+
+/**
+ * @brief Set to 1 when the benchmarks are built for the FreeRTOS POSIX port.
+ * Measurements are then taken with the monotonic clock of the host, in
+ * nanoseconds, and the application must implement benchmarkFinished().
+ */
+#ifndef BENCHMARK_HOST
+#define BENCHMARK_HOST 0
+#endif
+
+#if (BENCHMARK_HOST == 1)
+/**
+ * @brief Function provided by the application that is called once every
+ * benchmark has run.  The host application uses it to flush the results and
+ * exit, so that the results can be compared by tools/benchmarkCompare.py.
+ */
+extern "C" void benchmarkFinished(void);
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__)
+#define BENCHMARK_USE_DWT
+#endif
+
+namespace Benchmark {
+
+/**
+ * @brief Class that reads a free running cycle counter.
+ *
+ * On the host (BENCHMARK_HOST) the counter is the monotonic clock in
+ * nanoseconds.  The absolute numbers then say little about a microcontroller,
+ * but the difference between a wrapper and its C call still shows overhead.
+ *
+ * The DWT cycle counter is used on cores that have one (ARMv7-M and the ARMv8-M
+ * mainline profile).  ARMv6-M and ARMv8-M baseline cores such as the Cortex-M0
+ * do not have a DWT cycle counter, so the SysTick current value register is
+ * used instead.  SysTick is assumed to be clocked from the processor clock,
+ * which is how the FreeRTOS Cortex-M ports configure it.  Because SysTick
+ * reloads every tick, a single measurement must be shorter than one tick.
+ */
+class CycleCounter {
+ public:
+  /**
+   * @brief Function that enables the cycle counter.  This must be called once
+   * before any measurement is taken.
+   */
+  static inline void init() {
+#if defined(BENCHMARK_USE_DWT)
+    demcr() |= demcrTraceEnable;
+    dwtCycleCount() = 0;
+    dwtControl() |= dwtCycleCountEnable;
+#endif
+  }
+
+  /**
+   * @brief Function that reads the current value of the cycle counter.
+   *
+   * @return uint32_t The raw counter value.  Only the difference between two
+   * values returned by elapsed() is meaningful.
+   */
+  static inline uint32_t now() {
+#if (BENCHMARK_HOST == 1)
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint32_t>((static_cast<uint64_t>(time.tv_sec) *
+                                  1000000000ULL) +
+                                 static_cast<uint64_t>(time.tv_nsec));
+#elif defined(BENCHMARK_USE_DWT)
+    return dwtCycleCount();
+#else
+    return sysTickValue();
+#endif
+  }
+
+  /**
+   * @brief Function that returns the number of cycles between two calls to
+   * now().
+   *
+   * @param start Value returned by now() at the start of the measurement.
+   * @param end Value returned by now() at the end of the measurement.
+   * @return uint32_t The number of cycles that have elapsed.
+   */
+  static inline uint32_t elapsed(const uint32_t start, const uint32_t end) {
+#if (BENCHMARK_HOST == 1) || defined(BENCHMARK_USE_DWT)
+    return end - start;
+#else
+    // SysTick counts down and reloads with the value of the reload register.
+    return (start >= end) ? (start - end) : (start + sysTickReload() + 1 - end);
+#endif
+  }
+
+ private:
+#if defined(BENCHMARK_USE_DWT)
+  static constexpr uint32_t demcrTraceEnable = (1UL << 24);
+  static constexpr uint32_t dwtCycleCountEnable = (1UL << 0);
+
+  static inline volatile uint32_t& demcr() {
+    return *reinterpret_cast<volatile uint32_t*>(0xE000EDFCUL);  // NOLINT
+  }
+
+  static inline volatile uint32_t& dwtControl() {
+    return *reinterpret_cast<volatile uint32_t*>(0xE0001000UL);  // NOLINT
+  }
+
+  static inline volatile uint32_t& dwtCycleCount() {
+    return *reinterpret_cast<volatile uint32_t*>(0xE0001004UL);  // NOLINT
+  }
+#elif (BENCHMARK_HOST != 1)
+  static inline uint32_t sysTickReload() {
+    return *reinterpret_cast<volatile uint32_t*>(0xE000E014UL);  // NOLINT
+  }
+
+  static inline uint32_t sysTickValue() {
+    return *reinterpret_cast<volatile uint32_t*>(0xE000E018UL);  // NOLINT
+  }
+#endif
+};
+
+/**
+ * @brief Summary of the cycles taken by every iteration of a measurement.
+ */
+struct Result {
+  uint32_t min = UINT32_MAX;
+  uint32_t max = 0;
+  uint64_t total = 0;
+  uint32_t count = 0;
+
+  inline uint32_t mean() const {
+    return (count == 0) ? 0 : static_cast<uint32_t>(total / count);
+  }
+
+  inline void add(const uint32_t cycles) {
+    min = (cycles < min) ? cycles : min;
+    max = (cycles > max) ? cycles : max;
+    total += cycles;
+    count++;
+  }
+};
+
+/**
+ * @brief Function that measures a function a number of times.
+ *
+ * @param function The function to measure.  It is called once per iteration.
+ * @param iterations The number of iterations to measure.
+ * @param overhead The number of cycles taken by an empty measurement, which is
+ * subtracted from every iteration.
+ * @return Result The cycles taken by the iterations.
+ */
+template <class Function>
+Result measure(Function&& function, const uint32_t iterations,
+               const uint32_t overhead = 0) {
+  Result result;
+  for (uint32_t i = 0; i < iterations; i++) {
+    const uint32_t start = CycleCounter::now();
+    function();
+    const uint32_t cycles = CycleCounter::elapsed(start, CycleCounter::now());
+    result.add((cycles > overhead) ? (cycles - overhead) : 0);
+  }
+  return result;
+}
+
+/**
+ * @brief Function that returns the minimum number of cycles taken by an empty
+ * measurement.
+ */
+inline uint32_t overhead() {
+  return measure([] {}, 64).min;
+}
+
+/**
+ * @brief Function that writes one result line using benchmarkWrite().
+ *
+ * @param name Name of the measurement.
+ * @param result The result to write.
+ */
+inline void report(const char* name, const Result& result) {
+  char line[96];
+  snprintf(line, sizeof(line), "%-40s min %6lu mean %6lu max %6lu\r\n", name,
+           static_cast<unsigned long>(result.min),
+           static_cast<unsigned long>(result.mean()),
+           static_cast<unsigned long>(result.max));
+  benchmarkWrite(line);
+}
+
+/**
+ * @brief Function that measures the C++ wrapper and C API versions of the same
+ * operation and reports both.
+ *
+ * @param name Name of the operation.
+ * @param wrapper Function that performs the operation through FreeRTOS-Cpp.
+ * @param raw Function that performs the operation through the C API.
+ * @param iterations The number of iterations to measure each version.
+ */
+template <class Wrapper, class Raw>
+void compare(const char* name, Wrapper&& wrapper, Raw&& raw,
+             const uint32_t iterations = 1000) {
+  const uint32_t emptyCycles = overhead();
+  char label[48];
+
+  snprintf(label, sizeof(label), "%s (C++)", name);
+  report(label, measure(wrapper, iterations, emptyCycles));
+
+  snprintf(label, sizeof(label), "%s (C)", name);
+  report(label, measure(raw, iterations, emptyCycles));
+}
+
+void queueSendReceive();
+void semaphoreGiveTake();
+void mutexLockUnlock();
+void streamBufferSendReceive();
+void messageBufferSendReceive();
+void streamBufferThroughput();
+void mpmcQueueProducers();
+void eventGroupSetClear();
+void kernelTickCount();
+
+#if (configNUMBER_OF_CORES > 1)
+/**
+ * @brief Function that compares FreeRTOS::WorkerPool with
+ * FreeRTOS::WorkStealingPool on a tree of jobs that spawn jobs.
+ */
+void workStealingSpawn();
+
+#if (configUSE_CORE_AFFINITY == 1)
+/**
+ * @brief Function that measures how two cores updating unrelated objects
+ * contend with the kernel critical section and with FreeRTOS::ObjectLock.
+ */
+void objectLockContention();
+#endif /* configUSE_CORE_AFFINITY */
+#endif /* configNUMBER_OF_CORES */
+
+#if (BENCHMARK_ISR_PRODUCER == 1)
+/**
+ * @brief Function that runs the interrupt side of the benchmark that set the
+ * interrupt pending.  Call it from the handler of the interrupt set pending by
+ * benchmarkPendInterrupt().
+ */
+void interruptHandler();
+
+/**
+ * @brief Function that sets the function run by the next interruptHandler()
+ * and then calls benchmarkPendInterrupt().
+ *
+ * @param function The function to run from the interrupt.
+ */
+void pendInterrupt(void (*function)());
+
+#if (configUSE_SB_COMPLETED_CALLBACK == 1)
+/**
+ * @brief Function that measures the latency and throughput of
+ * FreeRTOS::InterCoreChannel with both ends on the same core.
+ */
+void interCoreChannel();
+#endif /* configUSE_SB_COMPLETED_CALLBACK */
+#endif /* BENCHMARK_ISR_PRODUCER */
+
+/**
+ * @brief Task that runs every benchmark once and then idles.  It runs at the
+ * highest priority so that other tasks do not preempt a measurement.
+ */
+class Runner : public FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 4> {
+ public:
+  Runner()
+      : FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 4>(
+            configMAX_PRIORITIES - 1, "Benchmark") {}
+
+  void taskFunction() final;
+
+ private:
+  // Task notifications can only be waited on from inside the task, so these
+  // benchmarks are members of the task that runs them.
+  void taskNotifyWait();
+  void taskPriority();
+#if (BENCHMARK_ISR_PRODUCER == 1)
+  void interruptLatency();
+#endif /* BENCHMARK_ISR_PRODUCER */
+};
+
+}  // namespace Benchmark
+
+#endif  // FREERTOS_BENCHMARK_HPP
@@ -0,0 +1,38 @@
+#include <Benchmark.hpp>
+#include <FreeRTOS/EventGroups.hpp>
+
+#include "event_groups.h"
+
+static FreeRTOS::StaticEventGroup eventGroup;
+
+static StaticEventGroup_t rawEventGroupBuffer;
+
+void Benchmark::eventGroupSetClear() {
+  EventGroupHandle_t rawEventGroup =
+      xEventGroupCreateStatic(&rawEventGroupBuffer);
+
+  compare(
+      "EventGroup set/clear",
+      [&] {
+        eventGroup.set(0x01);
+        eventGroup.clear(0x01);
+      },
+      [&] {
+        xEventGroupSetBits(rawEventGroup, 0x01);
+        xEventGroupClearBits(rawEventGroup, 0x01);
+      });
+
+  // The bits are already set, so the wait returns without blocking.
+  compare(
+      "EventGroup set/wait",
+      [&] {
+        eventGroup.set(0x01);
+        eventGroup.wait(0x01, true, false, 0);
+      },
+      [&] {
+        xEventGroupSetBits(rawEventGroup, 0x01);
+        xEventGroupWaitBits(rawEventGroup, 0x01, pdTRUE, pdFALSE, 0);
+      });
+
+  vEventGroupDelete(rawEventGroup);
+}
@@ -0,0 +1,23 @@
+#include <Benchmark.hpp>
+#include <FreeRTOS/Kernel.hpp>
+#include <cstdio>
+#include <cstdlib>
+
+// Entry point of benchmark-host, which links every benchmark with the FreeRTOS
+// POSIX port.  Results are written to stdout for tools/benchmarkCompare.py.
+
+extern "C" void benchmarkWrite(const char* string) {
+  fputs(string, stdout);
+}
+
+extern "C" void benchmarkFinished(void) {
+  fflush(stdout);
+  exit(EXIT_SUCCESS);
+}
+
+int main() {
+  FreeRTOS::Kernel::startScheduler();
+
+  // The scheduler only returns if it could not be started.
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,124 @@
+#include <Benchmark.hpp>
+#include <FreeRTOS/InterCoreChannel.hpp>
+#include <FreeRTOS/Task.hpp>
+
+#include "task.h"
+
+#if (BENCHMARK_ISR_PRODUCER == 1) && (configUSE_SB_COMPLETED_CALLBACK == 1)
+
+// Both ends run on this core.  The software interrupt used by the other ISR
+// benchmarks stands in for the inter-core interrupt, so the results are the
+// cost of the channel itself without the hardware mailbox or a second core.
+
+namespace {
+
+constexpr size_t messageSizes[] = {4, 16, 64};
+constexpr size_t maxMessageSize = 64;
+constexpr uint32_t latencyIterations = 200;
+constexpr uint32_t throughputMessages = 512;
+
+FreeRTOS::InterCoreChannel<1024> channel;
+
+volatile uint32_t sendStart = 0;
+volatile uint32_t latency = 0;
+volatile uint32_t remaining = 0;
+TaskHandle_t runner = NULL;
+
+void receiverISR() {
+  bool higherPriorityTaskWoken = false;
+  channel.handleInterrupt(higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+void raiseInterrupt() {
+  Benchmark::pendInterrupt(receiverISR);
+}
+
+// Runs above the benchmark runner, which lowers its own priority while these
+// benchmarks run, as the receiving core would take the message at once.
+class Receiver : public FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 2> {
+ public:
+  Receiver()
+      : FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 2>(
+            configMAX_PRIORITIES - 1, "Receiver") {}
+
+  void taskFunction() final {
+    uint8_t message[maxMessageSize];
+    for (;;) {
+      channel.receive(message, sizeof(message), portMAX_DELAY);
+      latency = Benchmark::CycleCounter::elapsed(
+          sendStart, Benchmark::CycleCounter::now());
+      if ((remaining == 0) || (--remaining == 0)) {
+        xTaskNotifyGive(runner);
+      }
+    }
+  }
+};
+
+Receiver receiver;
+
+void measureLatency(const size_t size, const uint32_t emptyCycles) {
+  const uint8_t message[maxMessageSize] = {0};
+  Benchmark::Result result;
+
+  remaining = 0;
+  for (uint32_t i = 0; i < latencyIterations; i++) {
+    sendStart = Benchmark::CycleCounter::now();
+    channel.send(message, size);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    result.add((latency > emptyCycles) ? (latency - emptyCycles) : 0);
+  }
+
+  char name[48];
+  snprintf(name, sizeof(name), "InterCoreChannel latency %u B",
+           static_cast<unsigned>(size));
+  Benchmark::report(name, result);
+}
+
+void measureThroughput(const size_t size) {
+  const uint8_t message[maxMessageSize] = {0};
+
+  remaining = throughputMessages;
+  const TickType_t start = xTaskGetTickCount();
+  for (uint32_t sent = 0; sent < throughputMessages;) {
+    if (channel.send(message, size) > 0) {
+      sent++;
+    }
+  }
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  const TickType_t elapsed = xTaskGetTickCount() - start;
+
+  const uint64_t bytes = static_cast<uint64_t>(throughputMessages) * size;
+  const uint64_t rate =
+      (elapsed == 0) ? 0 : (bytes * configTICK_RATE_HZ) / elapsed;
+
+  char line[96];
+  snprintf(line, sizeof(line),
+           "InterCoreChannel throughput %2u B %10lu B/s\r\n",
+           static_cast<unsigned>(size), static_cast<unsigned long>(rate));
+  benchmarkWrite(line);
+}
+
+}  // namespace
+
+void Benchmark::interCoreChannel() {
+  const uint32_t emptyCycles = overhead();
+  runner = xTaskGetCurrentTaskHandle();
+
+  const UBaseType_t priority = uxTaskPriorityGet(NULL);
+  vTaskPrioritySet(NULL, configMAX_PRIORITIES - 2);
+  if (!channel.isReady()) {
+    channel.create(raiseInterrupt);
+  }
+
+  for (const size_t size : messageSizes) {
+    measureLatency(size, emptyCycles);
+  }
+  for (const size_t size : messageSizes) {
+    measureThroughput(size);
+  }
+
+  vTaskPrioritySet(NULL, priority);
+}
+
+#endif /* BENCHMARK_ISR_PRODUCER && configUSE_SB_COMPLETED_CALLBACK */
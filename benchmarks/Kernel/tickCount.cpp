@@ -0,0 +1,35 @@
+#include <Benchmark.hpp>
+#include <FreeRTOS/Kernel.hpp>
+
+#include "task.h"
+
+void Benchmark::kernelTickCount() {
+  volatile TickType_t ticks = 0;
+
+  compare(
+      "Kernel getTickCount",
+      [&] { ticks = FreeRTOS::Kernel::getTickCount(); },
+      [&] { ticks = xTaskGetTickCount(); });
+
+  compare(
+      "Kernel suspendAll/resumeAll",
+      [] {
+        FreeRTOS::Kernel::suspendAll();
+        FreeRTOS::Kernel::resumeAll();
+      },
+      [] {
+        vTaskSuspendAll();
+        xTaskResumeAll();
+      });
+
+  compare(
+      "Kernel enterCritical/exitCritical",
+      [] {
+        FreeRTOS::Kernel::enterCritical();
+        FreeRTOS::Kernel::exitCritical();
+      },
+      [] {
+        taskENTER_CRITICAL();
+        taskEXIT_CRITICAL();
+      });
+}
@@ -0,0 +1,169 @@
+#include <Benchmark.hpp>
+#include <FreeRTOS/EventGroups.hpp>
+#include <FreeRTOS/NotifyEventGroup.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Semaphore.hpp>
+#include <FreeRTOS/StreamBuffer.hpp>
+#include <FreeRTOS/Task.hpp>
+
+#include "task.h"
+
+#if (BENCHMARK_ISR_PRODUCER == 1)
+
+namespace {
+
+// Ways an interrupt can wake a task.  EventGroupSet is deferred to the timer
+// service task, so its latency includes a switch to and from that task, which
+// NotifyEventGroupSet avoids.
+enum class Path {
+  NotifyGive,
+  Notify,
+  BinarySemaphore,
+  Queue,
+  EventGroupSet,
+  NotifyEventGroupSet,
+  StreamBuffer,
+};
+
+constexpr uint32_t iterations = 200;
+constexpr EventBits_t wakeBit = 0x01;
+
+volatile Path path = Path::NotifyGive;
+volatile uint32_t isrEntry = 0;
+volatile uint32_t latency = 0;
+
+FreeRTOS::StaticBinarySemaphore semaphore;
+FreeRTOS::StaticQueue<uint32_t, 1> queue;
+FreeRTOS::StaticEventGroup eventGroup;
+FreeRTOS::NotifyEventGroup<1> notifyEventGroup;
+FreeRTOS::StaticStreamBuffer<16> streamBuffer(1);
+
+// Runs above the benchmark runner, which lowers its own priority while these
+// benchmarks run, so that every signal switches straight to this task.
+class Waiter : public FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 2> {
+ public:
+  Waiter()
+      : FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 2>(
+            configMAX_PRIORITIES - 1, "Waiter") {}
+
+  void setRunner(const TaskHandle_t runner) {
+    this->runner = runner;
+  }
+
+  void taskFunction() final {
+    for (;;) {
+      wait();
+      latency = Benchmark::CycleCounter::elapsed(
+          isrEntry, Benchmark::CycleCounter::now());
+      xTaskNotifyGive(runner);
+    }
+  }
+
+ private:
+  TaskHandle_t runner = NULL;
+
+  void wait() const {
+    uint8_t byte;
+
+    switch (path) {
+      case Path::NotifyGive:
+        notifyTake(portMAX_DELAY);
+        break;
+      case Path::Notify:
+        notifyWait(portMAX_DELAY);
+        break;
+      case Path::BinarySemaphore:
+        semaphore.take(portMAX_DELAY);
+        break;
+      case Path::Queue:
+        queue.receive(portMAX_DELAY);
+        break;
+      case Path::EventGroupSet:
+        eventGroup.wait(wakeBit, true, false, portMAX_DELAY);
+        break;
+      case Path::NotifyEventGroupSet:
+        notifyEventGroup.wait(wakeBit, true, false, portMAX_DELAY);
+        break;
+      case Path::StreamBuffer:
+        streamBuffer.receive(&byte, sizeof(byte), portMAX_DELAY);
+        break;
+    }
+  }
+};
+
+Waiter waiter;
+
+void signalISR() {
+  // Taken first so that the latency counts from the start of the handler.
+  isrEntry = Benchmark::CycleCounter::now();
+
+  bool higherPriorityTaskWoken = false;
+  const uint8_t byte = 0;
+
+  switch (path) {
+    case Path::NotifyGive:
+      waiter.notifyGiveFromISR(higherPriorityTaskWoken);
+      break;
+    case Path::Notify:
+      waiter.notifyFromISR(higherPriorityTaskWoken,
+                           FreeRTOS::Task::NotifyAction::SetValueWithOverwrite,
+                           1);
+      break;
+    case Path::BinarySemaphore:
+      semaphore.giveFromISR(higherPriorityTaskWoken);
+      break;
+    case Path::Queue:
+      queue.sendToBackFromISR(higherPriorityTaskWoken, 1);
+      break;
+    case Path::EventGroupSet:
+      eventGroup.setFromISR(higherPriorityTaskWoken, wakeBit);
+      break;
+    case Path::NotifyEventGroupSet:
+      notifyEventGroup.setFromISR(higherPriorityTaskWoken, wakeBit);
+      break;
+    case Path::StreamBuffer:
+      streamBuffer.sendFromISR(higherPriorityTaskWoken, &byte, sizeof(byte));
+      break;
+  }
+
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+}  // namespace
+
+void Benchmark::Runner::interruptLatency() {
+  const uint32_t emptyCycles = overhead();
+  const struct {
+    Path path;
+    const char* name;
+  } paths[] = {
+      {Path::NotifyGive, "ISR->Task notifyGiveFromISR"},
+      {Path::Notify, "ISR->Task notifyFromISR"},
+      {Path::BinarySemaphore, "ISR->Task BinarySemaphore giveFromISR"},
+      {Path::Queue, "ISR->Task Queue sendToBackFromISR"},
+      {Path::EventGroupSet, "ISR->Task EventGroup setFromISR"},
+      {Path::NotifyEventGroupSet, "ISR->Task NotifyEventGroup setFromISR"},
+      {Path::StreamBuffer, "ISR->Task StreamBuffer sendFromISR"},
+  };
+
+  const UBaseType_t priority = getPriority();
+  setPriority(configMAX_PRIORITIES - 2);
+  waiter.setRunner(xTaskGetCurrentTaskHandle());
+
+  for (const auto& entry : paths) {
+    Result result;
+    path = entry.path;
+    for (uint32_t i = 0; i < iterations; i++) {
+      // The waiter preempts this task from the interrupt, so by the time this
+      // task takes the notification the measurement is complete.
+      pendInterrupt(signalISR);
+      notifyTake(portMAX_DELAY);
+      result.add((latency > emptyCycles) ? (latency - emptyCycles) : 0);
+    }
+    report(entry.name, result);
+  }
+
+  setPriority(priority);
+}
+
+#endif /* BENCHMARK_ISR_PRODUCER */
@@ -0,0 +1,29 @@
+#include <Benchmark.hpp>
+#include <FreeRTOS/MessageBuffer.hpp>
+
+#include "message_buffer.h"
+
+static FreeRTOS::StaticMessageBuffer<64> messageBuffer;
+
+static StaticMessageBuffer_t rawMessageBufferBuffer;
+static uint8_t rawMessageBufferStorage[64];
+
+void Benchmark::messageBufferSendReceive() {
+  MessageBufferHandle_t rawMessageBuffer = xMessageBufferCreateStatic(
+      sizeof(rawMessageBufferStorage), rawMessageBufferStorage,
+      &rawMessageBufferBuffer);
+  uint8_t data[16] = {0};
+
+  compare(
+      "MessageBuffer send/receive 16 bytes",
+      [&] {
+        messageBuffer.send(data, sizeof(data), 0);
+        messageBuffer.receive(data, sizeof(data), 0);
+      },
+      [&] {
+        xMessageBufferSend(rawMessageBuffer, data, sizeof(data), 0);
+        xMessageBufferReceive(rawMessageBuffer, data, sizeof(data), 0);
+      });
+
+  vMessageBufferDelete(rawMessageBuffer);
+}
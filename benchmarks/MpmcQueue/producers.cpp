@@ -0,0 +1,99 @@
+#include <Benchmark.hpp>
+#include <FreeRTOS/MpmcQueue.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <initializer_list>
+
+// Number of items sent by every producer in one run.
+#ifndef BENCHMARK_MPMC_ITEMS
+#define BENCHMARK_MPMC_ITEMS 4096
+#endif
+
+namespace {
+
+constexpr UBaseType_t maxProducers = 4;
+
+FreeRTOS::StaticQueue<uint32_t, 64> kernelQueue;
+FreeRTOS::StaticMpmcQueue<uint32_t, 64> mpmcQueue;
+
+volatile bool useMpmc = false;
+
+// Runs below the benchmark runner, which consumes every item, so that the
+// producers fill the queue from the other cores.
+class Producer : public FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 2> {
+ public:
+  Producer()
+      : FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 2>(
+            configMAX_PRIORITIES - 2, "Producer") {}
+
+  void taskFunction() final {
+    for (;;) {
+      notifyTake(portMAX_DELAY);
+      for (uint32_t i = 0; i < BENCHMARK_MPMC_ITEMS; i++) {
+        if (useMpmc) {
+          mpmcQueue.sendToBack(i, portMAX_DELAY);
+        } else {
+          kernelQueue.sendToBack(i, portMAX_DELAY);
+        }
+      }
+    }
+  }
+};
+
+Producer producers[maxProducers];
+
+// Time base that can span a whole run.  SysTick reloads every tick, so the
+// tick count is used on cores without a DWT cycle counter.
+inline uint32_t timeNow() {
+#if defined(BENCHMARK_USE_DWT)
+  return Benchmark::CycleCounter::now();
+#else
+  return xTaskGetTickCount();
+#endif
+}
+
+inline uint64_t itemsPerSecond(const uint32_t items, const uint32_t start,
+                               const uint32_t end) {
+#if defined(BENCHMARK_USE_DWT)
+  const uint64_t elapsed = Benchmark::CycleCounter::elapsed(start, end);
+  const uint64_t rate = configCPU_CLOCK_HZ;
+#else
+  const uint64_t elapsed = static_cast<TickType_t>(end - start);
+  const uint64_t rate = configTICK_RATE_HZ;
+#endif
+  return (elapsed == 0) ? 0 : (static_cast<uint64_t>(items) * rate) / elapsed;
+}
+
+void run(const char* name, const bool mpmc, const UBaseType_t count) {
+  const uint32_t items = BENCHMARK_MPMC_ITEMS * count;
+  uint32_t item = 0;
+
+  useMpmc = mpmc;
+  const uint32_t start = timeNow();
+  for (UBaseType_t i = 0; i < count; i++) {
+    producers[i].notifyGive();
+  }
+  for (uint32_t received = 0; received < items; received++) {
+    if (mpmc) {
+      mpmcQueue.receive(item, portMAX_DELAY);
+    } else {
+      kernelQueue.receive(item, portMAX_DELAY);
+    }
+  }
+  const uint32_t end = timeNow();
+
+  char line[96];
+  snprintf(line, sizeof(line), "%-24s %u producers %10lu items/s\r\n", name,
+           static_cast<unsigned>(count),
+           static_cast<unsigned long>(itemsPerSecond(items, start, end)));
+  benchmarkWrite(line);
+}
+
+}  // namespace
+
+void Benchmark::mpmcQueueProducers() {
+  benchmarkWrite("Multiple producer queue throughput\r\n");
+  for (const UBaseType_t count : {UBaseType_t(2), maxProducers}) {
+    run("StaticQueue", false, count);
+    run("StaticMpmcQueue", true, count);
+  }
+}
@@ -0,0 +1,53 @@
+#include <Benchmark.hpp>
+#include <FreeRTOS/Mutex.hpp>
+
+#include "semphr.h"
+
+static FreeRTOS::StaticMutex mutex;
+static FreeRTOS::StaticRecursiveMutex recursiveMutex;
+
+static StaticSemaphore_t rawMutexBuffer;
+static StaticSemaphore_t rawRecursiveMutexBuffer;
+
+void Benchmark::mutexLockUnlock() {
+  SemaphoreHandle_t rawMutex = xSemaphoreCreateMutexStatic(&rawMutexBuffer);
+
+  compare(
+      "Mutex lock/unlock",
+      [&] {
+        mutex.lock(0);
+        mutex.unlock();
+      },
+      [&] {
+        xSemaphoreTake(rawMutex, 0);
+        xSemaphoreGive(rawMutex);
+      });
+
+  vSemaphoreDelete(rawMutex);
+
+  // Three nested levels, as a layered driver re-locks the same bus mutex.  The
+  // wrapper only enters the kernel for the outermost lock and final unlock.
+  SemaphoreHandle_t rawRecursiveMutex =
+      xSemaphoreCreateRecursiveMutexStatic(&rawRecursiveMutexBuffer);
+
+  compare(
+      "RecursiveMutex nested lock/unlock x3",
+      [&] {
+        recursiveMutex.lock(0);
+        recursiveMutex.lock(0);
+        recursiveMutex.lock(0);
+        recursiveMutex.unlock();
+        recursiveMutex.unlock();
+        recursiveMutex.unlock();
+      },
+      [&] {
+        xSemaphoreTakeRecursive(rawRecursiveMutex, 0);
+        xSemaphoreTakeRecursive(rawRecursiveMutex, 0);
+        xSemaphoreTakeRecursive(rawRecursiveMutex, 0);
+        xSemaphoreGiveRecursive(rawRecursiveMutex);
+        xSemaphoreGiveRecursive(rawRecursiveMutex);
+        xSemaphoreGiveRecursive(rawRecursiveMutex);
+      });
+
+  vSemaphoreDelete(rawRecursiveMutex);
+}
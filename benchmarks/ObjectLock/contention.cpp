@@ -0,0 +1,122 @@
+#include <Benchmark.hpp>
+
+#if (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1)
+
+#include <FreeRTOS/ObjectLock.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// Number of protected updates made by each core in every run.
+#ifndef BENCHMARK_CONTENTION_UPDATES
+#define BENCHMARK_CONTENTION_UPDATES 100000
+#endif
+
+namespace {
+
+// How every core protects the update of its own, unrelated object.
+enum class Method {
+  KernelCritical,
+  ObjectLock,
+};
+
+// Each core updates its own object, so any waiting is caused by the lock and
+// not by the data.
+struct Object {
+  FreeRTOS::ObjectLock lock;
+  volatile uint32_t value = 0;
+};
+
+volatile Method method = Method::KernelCritical;
+TaskHandle_t runner = NULL;
+
+class Worker : public FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 2> {
+ public:
+  explicit Worker(const UBaseType_t core)
+      : FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 2>(
+            configMAX_PRIORITIES - 2, "Contender", 1UL << core) {}
+
+  void taskFunction() final {
+    for (;;) {
+      notifyTake(portMAX_DELAY);
+      if (method == Method::KernelCritical) {
+        for (uint32_t i = 0; i < BENCHMARK_CONTENTION_UPDATES; i++) {
+          taskENTER_CRITICAL();
+          object.value = object.value + 1;
+          taskEXIT_CRITICAL();
+        }
+      } else {
+        for (uint32_t i = 0; i < BENCHMARK_CONTENTION_UPDATES; i++) {
+          object.lock.enter();
+          object.value = object.value + 1;
+          object.lock.exit();
+        }
+      }
+      xTaskNotifyGive(runner);
+    }
+  }
+
+ private:
+  Object object;
+};
+
+Worker core0(0);
+Worker core1(1);
+
+// Time base that can span a whole run.  SysTick reloads every tick, so the
+// tick count is used on cores without a DWT cycle counter.
+inline uint32_t timeNow() {
+#if defined(BENCHMARK_USE_DWT)
+  return Benchmark::CycleCounter::now();
+#else
+  return xTaskGetTickCount();
+#endif
+}
+
+inline uint64_t updatesPerSecond(const uint32_t updates, const uint32_t start,
+                                 const uint32_t end) {
+#if defined(BENCHMARK_USE_DWT)
+  const uint64_t elapsed = Benchmark::CycleCounter::elapsed(start, end);
+  const uint64_t rate = configCPU_CLOCK_HZ;
+#else
+  const uint64_t elapsed = static_cast<TickType_t>(end - start);
+  const uint64_t rate = configTICK_RATE_HZ;
+#endif
+  return (elapsed == 0) ? 0 : (static_cast<uint64_t>(updates) * rate) / elapsed;
+}
+
+void run(const char* name, const Method selected, const bool bothCores) {
+  method = selected;
+  runner = xTaskGetCurrentTaskHandle();
+
+  const uint32_t start = timeNow();
+  core0.notifyGive();
+  if (bothCores) {
+    core1.notifyGive();
+  }
+  for (uint32_t done = 0; done < (bothCores ? 2U : 1U);) {
+    done += ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+  }
+  const uint32_t end = timeNow();
+
+  const uint32_t updates =
+      BENCHMARK_CONTENTION_UPDATES * (bothCores ? 2U : 1U);
+  char line[96];
+  snprintf(line, sizeof(line), "%-40s %10lu updates/s\r\n", name,
+           static_cast<unsigned long>(updatesPerSecond(updates, start, end)));
+  benchmarkWrite(line);
+}
+
+}  // namespace
+
+void Benchmark::objectLockContention() {
+#if (FREERTOS_CPP_OBJECT_LOCKS == 1)
+  benchmarkWrite("Independent objects on two cores (object locks)\r\n");
+#else
+  benchmarkWrite("Independent objects on two cores (object locks off)\r\n");
+#endif /* FREERTOS_CPP_OBJECT_LOCKS */
+  run("taskENTER_CRITICAL, one core", Method::KernelCritical, false);
+  run("taskENTER_CRITICAL, two cores", Method::KernelCritical, true);
+  run("ObjectLock, one core", Method::ObjectLock, false);
+  run("ObjectLock, two cores", Method::ObjectLock, true);
+}
+
+#endif /* configNUMBER_OF_CORES && configUSE_CORE_AFFINITY */
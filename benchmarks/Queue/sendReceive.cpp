@@ -0,0 +1,39 @@
+#include <Benchmark.hpp>
+#include <FreeRTOS/Queue.hpp>
+
+#include "queue.h"
+
+static FreeRTOS::StaticQueue<uint32_t, 4> queue;
+
+static StaticQueue_t rawQueueBuffer;
+static uint8_t rawQueueStorage[4 * sizeof(uint32_t)];
+
+void Benchmark::queueSendReceive() {
+  QueueHandle_t rawQueue = xQueueCreateStatic(4, sizeof(uint32_t),
+                                              rawQueueStorage, &rawQueueBuffer);
+  uint32_t value = 0;
+
+  compare(
+      "Queue send/receive",
+      [&] {
+        queue.sendToBack(value, 0);
+        queue.receive(value, 0);
+      },
+      [&] {
+        xQueueSendToBack(rawQueue, &value, 0);
+        xQueueReceive(rawQueue, &value, 0);
+      });
+
+  compare(
+      "Queue send/receive (optional)",
+      [&] {
+        queue.sendToBack(value, 0);
+        value = queue.receive(0).value_or(0);
+      },
+      [&] {
+        xQueueSendToBack(rawQueue, &value, 0);
+        xQueueReceive(rawQueue, &value, 0);
+      });
+
+  vQueueDelete(rawQueue);
+}
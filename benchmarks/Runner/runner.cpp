@@ -0,0 +1,61 @@
+#include <Benchmark.hpp>
+
+void Benchmark::Runner::taskFunction() {
+  CycleCounter::init();
+
+#if (BENCHMARK_HOST == 1)
+  benchmarkWrite("FreeRTOS-Cpp benchmarks (ns)\r\n");
+#else
+  benchmarkWrite("FreeRTOS-Cpp benchmarks (cycles)\r\n");
+#endif /* BENCHMARK_HOST */
+  queueSendReceive();
+  semaphoreGiveTake();
+  mutexLockUnlock();
+  taskNotifyWait();
+  taskPriority();
+  eventGroupSetClear();
+  kernelTickCount();
+  streamBufferSendReceive();
+  messageBufferSendReceive();
+  streamBufferThroughput();
+  mpmcQueueProducers();
+#if (BENCHMARK_ISR_PRODUCER == 1)
+  interruptLatency();
+#if (configUSE_SB_COMPLETED_CALLBACK == 1)
+  interCoreChannel();
+#endif /* configUSE_SB_COMPLETED_CALLBACK */
+#endif /* BENCHMARK_ISR_PRODUCER */
+#if (configNUMBER_OF_CORES > 1)
+  workStealingSpawn();
+#if (configUSE_CORE_AFFINITY == 1)
+  objectLockContention();
+#endif /* configUSE_CORE_AFFINITY */
+#endif /* configNUMBER_OF_CORES */
+  benchmarkWrite("Done\r\n");
+#if (BENCHMARK_HOST == 1)
+  benchmarkFinished();
+#endif /* BENCHMARK_HOST */
+
+  for (;;) {
+    delay(portMAX_DELAY);
+  }
+}
+
+#if (BENCHMARK_ISR_PRODUCER == 1)
+namespace {
+void (*volatile interruptFunction)() = NULL;
+}  // namespace
+
+void Benchmark::interruptHandler() {
+  if (interruptFunction != NULL) {
+    interruptFunction();
+  }
+}
+
+void Benchmark::pendInterrupt(void (*function)()) {
+  interruptFunction = function;
+  benchmarkPendInterrupt();
+}
+#endif /* BENCHMARK_ISR_PRODUCER */
+
+static Benchmark::Runner runner;
@@ -0,0 +1,26 @@
+#include <Benchmark.hpp>
+#include <FreeRTOS/Semaphore.hpp>
+
+#include "semphr.h"
+
+static FreeRTOS::StaticBinarySemaphore semaphore;
+
+static StaticSemaphore_t rawSemaphoreBuffer;
+
+void Benchmark::semaphoreGiveTake() {
+  SemaphoreHandle_t rawSemaphore =
+      xSemaphoreCreateBinaryStatic(&rawSemaphoreBuffer);
+
+  compare(
+      "Semaphore give/take",
+      [&] {
+        semaphore.give();
+        semaphore.take(0);
+      },
+      [&] {
+        xSemaphoreGive(rawSemaphore);
+        xSemaphoreTake(rawSemaphore, 0);
+      });
+
+  vSemaphoreDelete(rawSemaphore);
+}
@@ -0,0 +1,28 @@
+#include <Benchmark.hpp>
+#include <FreeRTOS/StreamBuffer.hpp>
+
+#include "stream_buffer.h"
+
+static FreeRTOS::StaticStreamBuffer<64> streamBuffer;
+
+static StaticStreamBuffer_t rawStreamBufferBuffer;
+static uint8_t rawStreamBufferStorage[64 + 1];
+
+void Benchmark::streamBufferSendReceive() {
+  StreamBufferHandle_t rawStreamBuffer = xStreamBufferCreateStatic(
+      64, 1, rawStreamBufferStorage, &rawStreamBufferBuffer);
+  uint8_t data[16] = {0};
+
+  compare(
+      "StreamBuffer send/receive 16 bytes",
+      [&] {
+        streamBuffer.send(data, sizeof(data), 0);
+        streamBuffer.receive(data, sizeof(data), 0);
+      },
+      [&] {
+        xStreamBufferSend(rawStreamBuffer, data, sizeof(data), 0);
+        xStreamBufferReceive(rawStreamBuffer, data, sizeof(data), 0);
+      });
+
+  vStreamBufferDelete(rawStreamBuffer);
+}
@@ -0,0 +1,183 @@
+#include <Benchmark.hpp>
+#include <FreeRTOS/StreamBuffer.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <initializer_list>
+
+// Number of bytes moved through the stream buffer by every combination.
+#ifndef BENCHMARK_THROUGHPUT_BYTES
+#define BENCHMARK_THROUGHPUT_BYTES 16384
+#endif
+
+namespace {
+
+constexpr size_t chunkSizes[] = {1, 16, 64};
+constexpr size_t readSizes[] = {16, 64};
+constexpr size_t maxChunkSize = 64;
+constexpr size_t maxReadSize = 64;
+
+volatile uint32_t contextSwitches = 0;
+
+// State shared with the producer.  It is written by the consumer before the
+// producer is started, and remaining is only changed by the producer.
+struct Transfer {
+  const FreeRTOS::StreamBufferBase* streamBuffer = NULL;
+  size_t chunkSize = 0;
+  volatile size_t remaining = 0;
+};
+
+Transfer transfer;
+uint8_t source[maxChunkSize] = {0};
+
+inline size_t nextChunk() {
+  return (transfer.remaining < transfer.chunkSize) ? transfer.remaining
+                                                   : transfer.chunkSize;
+}
+
+// Runs below the benchmark runner so that the consumer is woken by the send
+// that reaches the trigger level, as a UART bridge reader would be.
+class Producer : public FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 2> {
+ public:
+  Producer()
+      : FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 2>(
+            configMAX_PRIORITIES - 2, "Producer") {}
+
+  void taskFunction() final {
+    for (;;) {
+      notifyTake(portMAX_DELAY);
+      while (transfer.remaining > 0) {
+        transfer.remaining -=
+            transfer.streamBuffer->send(source, nextChunk(), portMAX_DELAY);
+      }
+    }
+  }
+};
+
+Producer producer;
+
+#if (BENCHMARK_ISR_PRODUCER == 1)
+void producerISR() {
+  bool higherPriorityTaskWoken = false;
+
+  // Write whole chunks until the stream buffer is full, as a receive interrupt
+  // would.  The consumer sets the interrupt pending again after every read.
+  while (transfer.remaining > 0) {
+    const size_t length = nextChunk();
+    if (transfer.streamBuffer->spacesAvailable() < length) {
+      break;
+    }
+    transfer.remaining -= transfer.streamBuffer->sendFromISR(
+        higherPriorityTaskWoken, source, length);
+  }
+
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+#endif /* BENCHMARK_ISR_PRODUCER */
+
+// Time base that can span a whole transfer.  SysTick reloads every tick, so
+// the tick count is used on cores without a DWT cycle counter.
+inline uint32_t timeNow() {
+#if defined(BENCHMARK_USE_DWT)
+  return Benchmark::CycleCounter::now();
+#else
+  return xTaskGetTickCount();
+#endif
+}
+
+inline uint64_t bytesPerSecond(const uint32_t start, const uint32_t end) {
+#if defined(BENCHMARK_USE_DWT)
+  const uint64_t elapsed = Benchmark::CycleCounter::elapsed(start, end);
+  const uint64_t rate = configCPU_CLOCK_HZ;
+#else
+  const uint64_t elapsed = static_cast<TickType_t>(end - start);
+  const uint64_t rate = configTICK_RATE_HZ;
+#endif
+  return (elapsed == 0) ? 0 : (BENCHMARK_THROUGHPUT_BYTES * rate) / elapsed;
+}
+
+void run(const FreeRTOS::StreamBufferBase& streamBuffer, const size_t size,
+         const size_t chunkSize, const size_t triggerLevel,
+         const size_t readSize, const bool isrProducer) {
+  uint8_t sink[maxReadSize];
+  size_t received = 0;
+
+  streamBuffer.reset();
+  streamBuffer.setTriggerLevel(triggerLevel);
+  transfer.streamBuffer = &streamBuffer;
+  transfer.chunkSize = chunkSize;
+  transfer.remaining = BENCHMARK_THROUGHPUT_BYTES;
+
+  const uint32_t start = timeNow();
+  contextSwitches = 0;
+
+  if (!isrProducer) {
+    producer.notifyGive();
+  }
+
+  while (received < BENCHMARK_THROUGHPUT_BYTES) {
+    // The final bytes may never reach the trigger level, so lower it rather
+    // than waiting for a timeout that would distort the result.
+    if ((BENCHMARK_THROUGHPUT_BYTES - received) < triggerLevel) {
+      streamBuffer.setTriggerLevel(1);
+    }
+#if (BENCHMARK_ISR_PRODUCER == 1)
+    if (isrProducer && (transfer.remaining > 0)) {
+      Benchmark::pendInterrupt(producerISR);
+    }
+#endif /* BENCHMARK_ISR_PRODUCER */
+    received += streamBuffer.receive(sink, readSize, portMAX_DELAY);
+  }
+
+  const uint32_t switches = contextSwitches;
+  const uint32_t end = timeNow();
+
+  // Context switches per KiB are reported with one decimal place.
+  const uint32_t switchesPerKiB = static_cast<uint32_t>(
+      (static_cast<uint64_t>(switches) * 1024 * 10) /
+      BENCHMARK_THROUGHPUT_BYTES);
+
+  char line[96];
+  snprintf(line, sizeof(line), "%5u %5u %5u %5u %-4s %10lu %6lu.%lu\r\n",
+           static_cast<unsigned>(size), static_cast<unsigned>(chunkSize),
+           static_cast<unsigned>(triggerLevel),
+           static_cast<unsigned>(readSize), isrProducer ? "ISR" : "Task",
+           static_cast<unsigned long>(bytesPerSecond(start, end)),
+           static_cast<unsigned long>(switchesPerKiB / 10),
+           static_cast<unsigned long>(switchesPerKiB % 10));
+  benchmarkWrite(line);
+}
+
+template <size_t N>
+void sweep() {
+  static FreeRTOS::StaticStreamBuffer<N> streamBuffer;
+  const size_t triggerLevels[] = {1, 16, N / 2};
+
+  for (const bool isrProducer : {false, true}) {
+#if (BENCHMARK_ISR_PRODUCER != 1)
+    if (isrProducer) {
+      continue;
+    }
+#endif /* BENCHMARK_ISR_PRODUCER */
+    for (const size_t chunkSize : chunkSizes) {
+      for (const size_t triggerLevel : triggerLevels) {
+        for (const size_t readSize : readSizes) {
+          run(streamBuffer, N, chunkSize, triggerLevel, readSize, isrProducer);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+extern "C" void benchmarkTaskSwitchedIn(void) {
+  contextSwitches = contextSwitches + 1;
+}
+
+void Benchmark::streamBufferThroughput() {
+  benchmarkWrite("StreamBuffer throughput (bytes/s, context switches/KiB)\r\n");
+  benchmarkWrite(" size chunk trig  read prod    bytes/s  cs/KiB\r\n");
+
+  sweep<64>();
+  sweep<256>();
+  sweep<1024>();
+}
@@ -0,0 +1,30 @@
+#include <Benchmark.hpp>
+
+#include "task.h"
+
+void Benchmark::Runner::taskNotifyWait() {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+  // The running task notifies itself, so no context switch is measured.
+  compare(
+      "Task notifyGive/notifyTake",
+      [&] {
+        notifyGive();
+        notifyTake(0);
+      },
+      [&] {
+        xTaskNotifyGive(self);
+        ulTaskNotifyTake(pdTRUE, 0);
+      });
+
+  compare(
+      "Task notifyGive/notifyWait",
+      [&] {
+        notifyGive();
+        notifyWait(0);
+      },
+      [&] {
+        xTaskNotifyGive(self);
+        xTaskNotifyWait(0, 0, NULL, 0);
+      });
+}
@@ -0,0 +1,16 @@
+#include <Benchmark.hpp>
+
+#include "task.h"
+
+void Benchmark::Runner::taskPriority() {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  const UBaseType_t priority = getPriority();
+
+  // Setting the priority that the task already has never switches context.
+  compare(
+      "Task getPriority/setPriority",
+      [&] { setPriority(getPriority()); },
+      [&] { vTaskPrioritySet(self, uxTaskPriorityGet(self)); });
+
+  setPriority(priority);
+}
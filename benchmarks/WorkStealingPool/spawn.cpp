@@ -0,0 +1,112 @@
+#include <Benchmark.hpp>
+
+#if (configNUMBER_OF_CORES > 1)
+
+#include <FreeRTOS/WorkStealingPool.hpp>
+#include <FreeRTOS/WorkerPool.hpp>
+#include <atomic>
+
+// Depth of the binary tree of jobs.  Every leaf of the tree is one job.
+#ifndef BENCHMARK_SPAWN_DEPTH
+#define BENCHMARK_SPAWN_DEPTH 12
+#endif
+
+// Number of loop iterations of busy work done by every leaf.
+#ifndef BENCHMARK_SPAWN_WORK
+#define BENCHMARK_SPAWN_WORK 64
+#endif
+
+namespace {
+
+constexpr uint32_t leaves = 1UL << BENCHMARK_SPAWN_DEPTH;
+
+FreeRTOS::WorkerPool<configNUMBER_OF_CORES, 64, configMINIMAL_STACK_SIZE * 2>
+    sharedPool(configMAX_PRIORITIES - 2, "Shared");
+FreeRTOS::WorkStealingPool<configNUMBER_OF_CORES, 64,
+                           configMINIMAL_STACK_SIZE * 2>
+    stealingPool(configMAX_PRIORITIES - 2, "Stealing");
+
+std::atomic<uint32_t> finished{0};
+TaskHandle_t waiter = NULL;
+
+inline void leaf() {
+  for (volatile uint32_t i = 0; i < BENCHMARK_SPAWN_WORK; i = i + 1) {
+  }
+  if (finished.fetch_add(1, std::memory_order_relaxed) == (leaves - 1)) {
+    xTaskNotifyGive(waiter);
+  }
+}
+
+// Queues one half of the tree and runs the other half, as a divide and conquer
+// algorithm would.  When the pool is full the job runs inline instead.
+template <class Pool>
+struct Spawn {
+  Pool* pool;
+  uint32_t depth;
+
+  void operator()() const {
+    uint32_t level = depth;
+    while (level > 0) {
+      level--;
+      if (!pool->submit(Spawn{pool, level}, 0)) {
+        Spawn{pool, level}();
+      }
+    }
+    leaf();
+  }
+};
+
+// Time base that can span a whole tree.  SysTick reloads every tick, so the
+// tick count is used on cores without a DWT cycle counter.
+inline uint32_t timeNow() {
+#if defined(BENCHMARK_USE_DWT)
+  return Benchmark::CycleCounter::now();
+#else
+  return xTaskGetTickCount();
+#endif
+}
+
+inline uint64_t jobsPerSecond(const uint32_t start, const uint32_t end) {
+#if defined(BENCHMARK_USE_DWT)
+  const uint64_t elapsed = Benchmark::CycleCounter::elapsed(start, end);
+  const uint64_t rate = configCPU_CLOCK_HZ;
+#else
+  const uint64_t elapsed = static_cast<TickType_t>(end - start);
+  const uint64_t rate = configTICK_RATE_HZ;
+#endif
+  return (elapsed == 0) ? 0 : (static_cast<uint64_t>(leaves) * rate) / elapsed;
+}
+
+template <class Pool>
+void run(const char* name, Pool& pool) {
+  finished.store(0, std::memory_order_relaxed);
+  waiter = xTaskGetCurrentTaskHandle();
+
+  const uint32_t start = timeNow();
+  pool.submit(Spawn<Pool>{&pool, BENCHMARK_SPAWN_DEPTH});
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  const uint32_t end = timeNow();
+
+  char line[96];
+  snprintf(line, sizeof(line), "%-40s %10lu jobs/s\r\n", name,
+           static_cast<unsigned long>(jobsPerSecond(start, end)));
+  benchmarkWrite(line);
+}
+
+}  // namespace
+
+void Benchmark::workStealingSpawn() {
+  benchmarkWrite("Worker pool spawn throughput\r\n");
+  run("WorkerPool (shared queue)", sharedPool);
+  run("WorkStealingPool", stealingPool);
+
+  char line[64];
+  for (UBaseType_t i = 0; i < configNUMBER_OF_CORES; i++) {
+    snprintf(line, sizeof(line), "  worker %u steals %lu\r\n",
+             static_cast<unsigned>(i),
+             static_cast<unsigned long>(stealingPool.getSteals(i)));
+    benchmarkWrite(line);
+  }
+}
+
+#endif /* configNUMBER_OF_CORES */
@@ -0,0 +1,63 @@
+#include <FreeRTOS/ActiveObject.hpp>
+#include <FreeRTOS/IsrContext.hpp>
+#include <FreeRTOS/Kernel.hpp>
+#include <variant>
+
+struct Start {
+  uint16_t speed;
+};
+
+struct Stop {};
+
+struct Fault {
+  uint8_t code;
+};
+
+using MotorEvent = std::variant<Start, Stop, Fault>;
+
+// Motor controller.  Every event is handled by the on() overload for its type,
+// and a handler that takes longer than 2 ticks is reported.
+class Motor : public FreeRTOS::ActiveObject<Motor, MotorEvent, 8, 256> {
+ public:
+  Motor()
+      : FreeRTOS::ActiveObject<Motor, MotorEvent, 8, 256>(tskIDLE_PRIORITY + 2,
+                                                          "Motor", 2) {}
+
+  void on(const Start& event) {
+    speed = event.speed;
+  }
+
+  void on(const Stop&) {
+    speed = 0;
+  }
+
+  void on(const Fault& event) {
+    speed = 0;
+    lastFault = event.code;
+  }
+
+  void onBudgetExceeded(const TickType_t elapsed) {
+    // Log the overrun here.
+    static_cast<void>(elapsed);
+  }
+
+ private:
+  uint16_t speed = 0;
+  uint8_t lastFault = 0;
+};
+
+static Motor motor;
+
+// Overcurrent comparator.  The fault jumps the queue ahead of any pending
+// speed changes.
+extern "C" void COMP_IRQHandler(void) {
+  FreeRTOS::IsrContext context;
+  motor.postUrgentFromISR(context, Fault{1});
+}
+
+void aFunction() {
+  motor.post(Start{1500});
+  motor.post(Stop{});
+
+  FreeRTOS::Kernel::startScheduler();
+}
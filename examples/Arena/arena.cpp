@@ -0,0 +1,40 @@
+#include <FreeRTOS/Arena.hpp>
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// Replaces heap_4.c, so every dynamically allocated kernel object comes from
+// this arena.  The arena freezes itself once the scheduler has started.
+static FreeRTOS::StaticArena<4096> arena;
+FREERTOS_CPP_DEFINE_ARENA_HEAP(arena)
+
+class MyTask : public FreeRTOS::Task {
+ public:
+  explicit MyTask(const FreeRTOS::Queue<uint32_t>& queue)
+      : FreeRTOS::Task(tskIDLE_PRIORITY + 1, 256, "MyTask"), queue(queue) {}
+
+  void taskFunction() final {
+    for (;;) {
+      if (auto value = queue.receive()) {
+        // Process *value here.
+      }
+    }
+  }
+
+ private:
+  const FreeRTOS::Queue<uint32_t>& queue;
+};
+
+void vAFunction() {
+  // Created at boot, so the task and the queue are bump allocated.
+  static FreeRTOS::Queue<uint32_t> queue(8);
+  static MyTask myTask(queue);
+
+  // Check how much of the arena the objects used.
+  size_t arenaUsed = arena.getUsedSize();
+  (void)arenaUsed;
+
+  FreeRTOS::Kernel::startScheduler();
+
+  // Will not get here unless a task calls FreeRTOS::Kernel::endScheduler()
+}
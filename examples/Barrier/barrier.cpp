@@ -0,0 +1,36 @@
+#include <FreeRTOS/Barrier.hpp>
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// Four DSP stages meet at the end of every audio frame.
+static FreeRTOS::Barrier<4> frameBarrier;
+
+class StageTask : public FreeRTOS::StaticTask<256> {
+ public:
+  explicit StageTask(const char* name)
+      : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 2, name) {}
+
+  void taskFunction() final {
+    FreeRTOS::Barrier<4>::Participant participant =
+        frameBarrier.participant();
+
+    for (;;) {
+      // Process this stage of the current frame here.
+
+      // One kernel call per frame.  Every stage leaves together, and the
+      // barrier is ready for the next frame straight away.
+      if (!participant.arriveAndWait(pdMS_TO_TICKS(20))) {
+        // A stage overran the frame.  This stage retries the same frame.
+      }
+    }
+  }
+};
+
+static StageTask filter("Filter");
+static StageTask mixer("Mixer");
+static StageTask limiter("Limiter");
+static StageTask output("Output");
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
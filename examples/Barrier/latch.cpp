@@ -0,0 +1,45 @@
+#include <FreeRTOS/Barrier.hpp>
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// The application tasks must not start until all three drivers are ready.
+static FreeRTOS::Latch driversReady(3);
+
+class DriverTask : public FreeRTOS::StaticTask<256> {
+ public:
+  explicit DriverTask(const char* name)
+      : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 3, name) {}
+
+  void taskFunction() final {
+    // Initialise the peripheral here.
+    driversReady.countDown();
+
+    for (;;) {
+      delay(portMAX_DELAY);
+    }
+  }
+};
+
+static DriverTask spi("Spi");
+static DriverTask i2c("I2c");
+static DriverTask uart("Uart");
+
+class AppTask : public FreeRTOS::StaticTask<512> {
+ public:
+  AppTask() : FreeRTOS::StaticTask<512>(tskIDLE_PRIORITY + 1, "App") {}
+
+  void taskFunction() final {
+    driversReady.wait();
+
+    for (;;) {
+      // Run the application here.
+      delay(pdMS_TO_TICKS(10));
+    }
+  }
+};
+
+static AppTask app;
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
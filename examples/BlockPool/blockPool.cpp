@@ -0,0 +1,51 @@
+#include <FreeRTOS/BlockPool.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+
+struct Frame {
+  uint16_t length;
+  uint8_t data[256];
+};
+
+// Frames are passed between the interrupt and the task by pointer, so the
+// frame contents are never copied and the heap is never touched.
+static FreeRTOS::StaticBlockPool<sizeof(Frame), 8> framePool;
+static FreeRTOS::StaticQueue<Frame*, 8> rxFrames;
+
+extern "C" void vEthernetRxHandler(void) {
+  bool higherPriorityTaskWoken = false;
+
+  void* block = framePool.allocateFromISR();
+  if (block == NULL) {
+    return;  // Every frame is in use, so drop this one.
+  }
+
+  Frame* frame = new (block) Frame;
+  frame->length = 0;
+  // Fill in frame here.
+
+  rxFrames.sendToBackFromISR(higherPriorityTaskWoken, frame);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+class NetworkTask : public FreeRTOS::StaticTask<512> {
+ public:
+  NetworkTask() : FreeRTOS::StaticTask<512>(tskIDLE_PRIORITY + 2, "Net") {}
+
+  void taskFunction() final {
+    for (;;) {
+      if (auto frame = rxFrames.receive()) {
+        // Process **frame here.
+
+        framePool.free(*frame);
+      }
+
+      // Check how close the pool came to running out.
+      if (framePool.getHighWaterMark() == 8) {
+        // Consider a larger pool.
+      }
+    }
+  }
+};
+
+static NetworkTask networkTask;
@@ -0,0 +1,47 @@
+#include <FreeRTOS/Clock.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+static FreeRTOS::StaticQueue<uint32_t, 8> samples;
+
+// The timeouts are converted to ticks at compile time and rounded up, so 1500us
+// waits for at least two ticks with a 1 kHz tick.
+static_assert(FreeRTOS::Clock::toTicks(1500us) == 2);
+
+// Log how long each batch of samples took to arrive.  The 64-bit clock never
+// wraps, so the elapsed time is correct even if the kernel tick count
+// overflows between two readings.
+class Logger : public FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE> {
+ public:
+  Logger() : FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE>(2, "Logger") {}
+
+  void taskFunction() final {
+    for (;;) {
+      const FreeRTOS::Clock::time_point start = FreeRTOS::Clock::now();
+
+      uint32_t sample = 0;
+      while (samples.receive(sample, 20ms)) {
+        // Process the sample here.
+      }
+
+      const FreeRTOS::Clock::duration elapsed = FreeRTOS::Clock::now() - start;
+      if (elapsed > 1s) {
+        // The producer has fallen behind.
+      }
+
+      delay(100ms);
+    }
+  }
+};
+
+static Logger logger;
+
+#if (configUSE_TICK_HOOK == 1)
+// Keep the overflow tracking up to date however rarely the clock is read.
+extern "C" void vApplicationTickHook(void) {
+  FreeRTOS::Clock::onTick();
+}
+#endif /* configUSE_TICK_HOOK */
@@ -0,0 +1,51 @@
+#include <FreeRTOS/ConditionVariable.hpp>
+#include <FreeRTOS/Mutex.hpp>
+#include <FreeRTOS/Task.hpp>
+
+static FreeRTOS::StaticMutex stateMutex;
+static FreeRTOS::ConditionVariable<1> stateChanged;
+static bool linkUp = false;
+static uint32_t framesPending = 0;
+
+void onLinkChange(const bool up) {
+  stateMutex.lock();
+  linkUp = up;
+  stateMutex.unlock();
+  stateChanged.notify_all();
+}
+
+void onFrameQueued() {
+  stateMutex.lock();
+  framesPending++;
+  stateMutex.unlock();
+  stateChanged.notify_one();
+}
+
+class TransmitTask : public FreeRTOS::StaticTask<512> {
+ public:
+  TransmitTask()
+      : FreeRTOS::StaticTask<512>(tskIDLE_PRIORITY + 2, "Transmit") {}
+
+  void taskFunction() final {
+    for (;;) {
+      stateMutex.lock();
+
+      // Block until there is something to send and the link is up, without
+      // polling.
+      const bool ready = stateChanged.wait_until(
+          stateMutex, [] { return linkUp && (framesPending > 0); },
+          pdMS_TO_TICKS(1000));
+      if (ready) {
+        framesPending--;
+      }
+
+      stateMutex.unlock();
+
+      if (ready) {
+        // Send one frame here.
+      }
+    }
+  }
+};
+
+static TransmitTask transmitTask;
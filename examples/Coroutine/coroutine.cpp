@@ -0,0 +1,72 @@
+#include <FreeRTOS/Coroutine.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Semaphore.hpp>
+
+#if defined(__cpp_impl_coroutine)
+
+struct Frame {
+  uint8_t address;
+  uint8_t command;
+};
+
+static FreeRTOS::CoroutineExecutor<configMINIMAL_STACK_SIZE * 4> executor(2);
+static FreeRTOS::StaticQueue<Frame, 16> frames;
+static FreeRTOS::StaticBinarySemaphore linkReady;
+static FreeRTOS::CoroutineNotification timeTick;
+
+// One protocol session.  Its state lives in the coroutine frame, so many
+// sessions run on the single executor task without a stack each.
+static FreeRTOS::Coroutine session(const uint8_t address) {
+  if (!co_await FreeRTOS::Await::take(linkReady, pdMS_TO_TICKS(500))) {
+    co_return;
+  }
+  linkReady.give();
+
+  for (;;) {
+    std::optional<Frame> frame =
+        co_await FreeRTOS::Await::receive(frames, pdMS_TO_TICKS(1000));
+    if (!frame) {
+      // No traffic for a second, end the session.
+      co_return;
+    }
+    if (frame->address != address) {
+      // Not for this session, leave it for the others.
+      frames.sendToBack(*frame, 0);
+      co_await FreeRTOS::Await::yield();
+      continue;
+    }
+    // Answer the command here, then pace the next one.
+    co_await FreeRTOS::Await::delay(pdMS_TO_TICKS(5));
+  }
+}
+
+// Runs a housekeeping step every time an interrupt signals the notification.
+static FreeRTOS::Coroutine housekeeping() {
+  for (;;) {
+    const uint32_t bits = co_await FreeRTOS::Await::notification(timeTick);
+    if (bits != 0) {
+      // Age the session table here.
+    }
+  }
+}
+
+void aFunction() {
+  for (uint8_t address = 1; address <= 100; address++) {
+    if (!executor.spawn(session(address))) {
+      // The coroutine frame could not be allocated.
+    }
+  }
+  executor.spawn(housekeeping());
+}
+
+// Frames arrive from the receive interrupt.  Waking the executor lets the
+// sessions see the frame without waiting for the next poll.
+void frameReceivedISR(const Frame& frame) {
+  bool higherPriorityTaskWoken = false;
+  frames.sendToBackFromISR(higherPriorityTaskWoken, frame);
+  executor.wakeFromISR(higherPriorityTaskWoken);
+  timeTick.notifyFromISR(higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+#endif /* __cpp_impl_coroutine */
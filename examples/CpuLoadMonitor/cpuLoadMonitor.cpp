@@ -0,0 +1,36 @@
+#include <FreeRTOS/CpuLoadMonitor.hpp>
+#include <FreeRTOS/Timer.hpp>
+
+// Report an overload when any window is at least 85% busy.
+static void overloaded(size_t window, uint32_t load) {
+  // Log the window index and the load, in parts per thousand, here.
+}
+
+// Windows of 1, 10 and 100 samples, which with a sample every 100 ms measure
+// the load over 100 ms, 1 s and 10 s.
+static FreeRTOS::CpuLoadMonitor<3> monitor({1, 10, 100}, 850, overloaded);
+
+class SampleTimer : public FreeRTOS::StaticTimer {
+ public:
+  SampleTimer() : FreeRTOS::StaticTimer(pdMS_TO_TICKS(100), true, "Load") {}
+
+  void timerFunction() final {
+    monitor.sample();
+  }
+};
+
+static SampleTimer sampleTimer;
+
+void aFunction() {
+  sampleTimer.start();
+}
+
+uint32_t currentLoad() {
+  // The load over the last complete second.
+  return monitor.getLoad(1);
+}
+
+uint32_t worstLoad() {
+  // The busiest 100 ms since the monitor was started.
+  return monitor.getPeakLoad(0);
+}
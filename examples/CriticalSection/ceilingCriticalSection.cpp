@@ -0,0 +1,29 @@
+#include <FreeRTOS/CriticalSection.hpp>
+
+// The encoder interrupt runs at priority 3 and is the only interrupt that
+// touches the position.  The UART interrupt runs at priority 2, which still
+// calls FreeRTOS API functions, and the motor commutation interrupt at
+// priority 1, so neither is delayed by the section.
+constexpr UBaseType_t encoderPriority = 3 << (8 - configPRIO_BITS);
+
+using PositionLock = FreeRTOS::CeilingCriticalSection<encoderPriority>;
+
+static int32_t position = 0;
+static uint32_t overflows = 0;
+
+int32_t readPosition(uint32_t* overflowCount) {
+  // Only interrupts at priority 3 are masked.
+  PositionLock lock;
+  *overflowCount = overflows;
+  return position;
+}
+
+extern "C" void vEncoderISR(void) {
+  // The same guard protects the data in the interrupt, which matters if the
+  // encoder interrupt can be preempted by another that shares the data.
+  PositionLock lock;
+  position++;
+  if (position == 0) {
+    overflows++;
+  }
+}
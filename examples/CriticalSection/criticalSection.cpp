@@ -0,0 +1,37 @@
+#include <FreeRTOS/CriticalSection.hpp>
+
+static uint32_t eventCount = 0;
+static uint32_t lastEventTime = 0;
+
+bool recordEvent(const uint32_t time) {
+  // Interrupts are masked until section goes out of scope, including on the
+  // early return below.
+  FreeRTOS::CriticalSection section;
+
+  if (time == lastEventTime) {
+    return false;
+  }
+
+  eventCount++;
+  lastEventTime = time;
+  return true;
+}
+
+extern "C" void vTimerISR(void) {
+  // The interrupt version saves the interrupt status and restores it when it
+  // goes out of scope.
+  FreeRTOS::CriticalSectionFromISR section;
+  eventCount++;
+}
+
+void reportLongestCriticalSection() {
+#if (FREERTOS_CPP_CRITICAL_SECTION_TIMING == 1)
+  // Shows which function held interrupts masked for the longest time, which
+  // bounds the worst case interrupt latency.
+  FreeRTOS::HoldTime longest = FreeRTOS::CriticalSection::getHoldTime();
+  // longest.function and longest.line locate the guard, and longest.longest
+  // is how long it was held for.
+  (void)longest;
+  FreeRTOS::CriticalSection::resetHoldTime();
+#endif /* FREERTOS_CPP_CRITICAL_SECTION_TIMING */
+}
@@ -0,0 +1,32 @@
+#include <FreeRTOS/CriticalSection.hpp>
+#include <FreeRTOS/Task.hpp>
+
+struct Settings {
+  uint32_t gain;
+  uint32_t offset;
+};
+
+static Settings settings;
+
+class MyTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+void MyTask::taskFunction() {
+  for (;;) {
+    {
+      // No other task can run until lock goes out of scope, but interrupts
+      // still run.  A context switch needed in the meantime happens when the
+      // scheduler is resumed at the end of the scope.
+      FreeRTOS::SchedulerLock lock;
+
+      if (settings.gain == 0) {
+        continue;  // The scheduler is resumed here too.
+      }
+      settings.offset += settings.gain;
+    }
+
+    delay(10);
+  }
+}
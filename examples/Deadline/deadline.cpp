@@ -0,0 +1,32 @@
+#include <FreeRTOS/Deadline.hpp>
+#include <FreeRTOS/Mutex.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Semaphore.hpp>
+
+static FreeRTOS::StaticBinarySemaphore requestReady;
+static FreeRTOS::StaticQueue<uint32_t, 8> requests;
+static FreeRTOS::StaticMutex resultLock;
+
+// Handle one request within a total budget of 50 ms.  Each blocking call only
+// waits for the part of the budget that the previous calls did not use.
+bool handleRequest() {
+  FreeRTOS::Deadline deadline(pdMS_TO_TICKS(50));
+
+  if (!requestReady.take(deadline)) {
+    return false;
+  }
+
+  uint32_t request = 0;
+  if (!requests.receive(request, deadline)) {
+    return false;
+  }
+
+  if (!resultLock.lock(deadline)) {
+    return false;
+  }
+  // Store the result of the request here.
+  resultLock.unlock();
+
+  // The deadline can also be queried directly.
+  return !deadline.hasExpired();
+}
@@ -0,0 +1,40 @@
+#include <FreeRTOS/DeferCreate.hpp>
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Mutex.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// None of these objects has a constructor that runs before main(), so they
+// are placed in .bss and the order in which they are created is chosen below.
+static FreeRTOS::StaticQueue<uint32_t, 16> requests(FreeRTOS::deferCreate);
+static FreeRTOS::StaticMutex logLock(FreeRTOS::deferCreate);
+
+class Server : public FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 2> {
+ public:
+  constexpr Server()
+      : FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE * 2>(
+            FreeRTOS::deferCreate) {}
+
+  void taskFunction() final {
+    for (;;) {
+      uint32_t request = 0;
+      if (requests.receive(request, portMAX_DELAY)) {
+        logLock.lock();
+        // Log the request here.
+        logLock.unlock();
+      }
+    }
+  }
+};
+
+static Server server;
+
+void aFunction() {
+  // Bring up the hardware first, then create the objects that the server
+  // uses before the server itself.
+  requests.create();
+  logLock.create();
+  server.create(2, "Server");
+
+  FreeRTOS::Kernel::startScheduler();
+}
@@ -0,0 +1,39 @@
+#include <FreeRTOS/DeferredHandler.hpp>
+#include <FreeRTOS/IsrContext.hpp>
+
+struct UartEvent {
+  uint8_t byte;
+  uint8_t status;
+};
+
+// Bottom half of the UART driver.  handle() is called for every byte received
+// since the task last ran.
+class UartHandler : public FreeRTOS::DeferredHandler<UartEvent, 64, 256> {
+ public:
+  UartHandler()
+      : FreeRTOS::DeferredHandler<UartEvent, 64, 256>(tskIDLE_PRIORITY + 3,
+                                                      "UART") {}
+
+ protected:
+  void handle(const UartEvent& event) final {
+    // Parse event.byte here.
+    static_cast<void>(event);
+  }
+};
+
+static UartHandler uartHandler;
+
+// Top half of the UART driver.
+extern "C" void UART_IRQHandler(void) {
+  FreeRTOS::IsrContext context;
+
+  const UartEvent event = {0 /* Read the data register here. */,
+                           0 /* Read the status register here. */};
+  if (!uartHandler.postFromISR(context, event)) {
+    // The handler is too far behind and the event was dropped.
+  }
+}
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
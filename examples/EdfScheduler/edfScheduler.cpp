@@ -0,0 +1,54 @@
+#include <FreeRTOS/EdfScheduler.hpp>
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <FreeRTOS/TaskSet.hpp>
+
+// The periods and budgets of the tasks, in ticks.  At 84% utilization rate
+// monotonic priorities let the slowest task miss its deadline, but earliest
+// deadline first meets all of them.
+using Tasks = FreeRTOS::TaskSet<FreeRTOS::TaskTiming<11, 3>,   // Control
+                                FreeRTOS::TaskTiming<14, 4>,   // Filter
+                                FreeRTOS::TaskTiming<18, 5>>;  // Telemetry
+
+static_assert(!Tasks::isSchedulable(), "Fixed priorities would be enough.");
+static_assert(Tasks::isEdfSchedulable(), "The tasks miss deadlines.");
+
+// The group owns tskIDLE_PRIORITY + 1 to tskIDLE_PRIORITY + 4.  Tasks above
+// the band are never delayed by it.
+static FreeRTOS::EdfScheduler<3> edf(tskIDLE_PRIORITY + 1,
+                                     tskIDLE_PRIORITY + 4);
+
+class EdfTask : public FreeRTOS::StaticTask<256> {
+ public:
+  EdfTask(const char* name, const TickType_t period)
+      : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 1, name),
+        period(period) {}
+
+ private:
+  const TickType_t period;
+
+  void taskFunction() final {
+    edf.add(*this);
+
+    TickType_t release = xTaskGetTickCount();
+    for (;;) {
+      // Each job must finish before the next one is released.
+      edf.release(*this, release + period);
+      // Do the work of one job here.
+      if (!edf.complete(*this)) {
+        // Log edf.getStatistics(*this).maxLateness here.
+      }
+      xTaskDelayUntil(&release, period);
+    }
+  }
+};
+
+static EdfTask control("Control", 11);
+static EdfTask filter("Filter", 14);
+static EdfTask telemetry("Telemetry", 18);
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+
+  // edf.getMisses() stays at 0 while the budgets hold.
+}
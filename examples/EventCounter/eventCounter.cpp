@@ -0,0 +1,30 @@
+#include <FreeRTOS/EventCounter.hpp>
+#include <FreeRTOS/Task.hpp>
+
+class EncoderTask : public FreeRTOS::StaticTask<256> {
+ public:
+  EncoderTask() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 2, "Encoder") {}
+
+  // Wake up once at least 16 edges are waiting, instead of on every edge.
+  FreeRTOS::EventCounter<1> edges{*this, 16};
+
+  void taskFunction() final {
+    for (;;) {
+      // Handle slow rotation too by collecting whatever has arrived after
+      // 10 ms.
+      const uint32_t count = edges.take(pdMS_TO_TICKS(10));
+      position += count;
+    }
+  }
+
+ private:
+  uint32_t position = 0;
+};
+
+static EncoderTask encoderTask;
+
+extern "C" void vEncoderInterruptHandler(void) {
+  bool higherPriorityTaskWoken = false;
+  encoderTask.edges.addFromISR(higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
@@ -0,0 +1,50 @@
+#include <FreeRTOS/EventFlags.hpp>
+#include <FreeRTOS/EventGroups.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// Each enumerator is a bit number.  A flag that does not fit in an event group
+// is a compile error wherever it is used.
+enum class Radio : UBaseType_t {
+  RxDone,
+  TxDone,
+  Timeout,
+  Shutdown,
+};
+
+static FreeRTOS::StaticEventGroup radioGroup;
+static const FreeRTOS::EventFlags<Radio> radioFlags(radioGroup);
+
+extern "C" void RADIO_IRQHandler(void) {
+  bool higherPriorityTaskWoken = false;
+  radioFlags.setFromISR<Radio::RxDone>(higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+class RadioTask : public FreeRTOS::StaticTask<256> {
+ public:
+  RadioTask() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 2, "Radio") {}
+
+  void taskFunction() final {
+    for (;;) {
+      const auto events =
+          radioFlags.waitAny<Radio::RxDone, Radio::TxDone, Radio::Shutdown>(
+              true, pdMS_TO_TICKS(500));
+
+      if (events.test(Radio::Shutdown)) {
+        break;
+      }
+      if (events.test(Radio::RxDone)) {
+        // Read the received packet here.
+      }
+      if (!events.any<Radio::RxDone, Radio::TxDone>()) {
+        radioFlags.set<Radio::Timeout>();
+      }
+    }
+  }
+};
+
+static RadioTask radioTask;
+
+void powerDown() {
+  radioFlags.set<Radio::Shutdown>();
+}
@@ -0,0 +1,35 @@
+#include <FreeRTOS/EventGroups.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// Plain EventBits_t masks select the overloads that pass the value straight to
+// the kernel, without converting through FreeRTOS::EventGroup::EventBits.
+constexpr EventBits_t rxComplete = (1 << 0);
+constexpr EventBits_t txComplete = (1 << 1);
+
+static FreeRTOS::StaticEventGroup uartEvents;
+
+extern "C" void UART_IRQHandler(void) {
+  bool higherPriorityTaskWoken = false;
+  uartEvents.setFromISR(higherPriorityTaskWoken, rxComplete);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+class UartTask : public FreeRTOS::StaticTask<256> {
+ public:
+  UartTask() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 2, "Uart") {}
+
+  void taskFunction() final {
+    for (;;) {
+      const EventBits_t bits =
+          uartEvents.wait(rxComplete | txComplete, true, false);
+      if ((bits & rxComplete) != 0) {
+        // Handle the received data here.
+      }
+      if ((bits & txComplete) != 0) {
+        // Queue the next transmission here.
+      }
+    }
+  }
+};
+
+static UartTask uartTask;
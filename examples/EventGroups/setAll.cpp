@@ -0,0 +1,17 @@
+#include <FreeRTOS/EventGroups.hpp>
+
+#define BIT_SHUTDOWN (1 << 7)
+
+// Each subsystem waits on its own event group.
+FreeRTOS::EventGroup motors;
+FreeRTOS::EventGroup sensors;
+FreeRTOS::EventGroup logging;
+
+const FreeRTOS::EventGroupBase* const subsystems[] = {&motors, &sensors,
+                                                      &logging};
+
+void aFunction() {
+  // Tell every subsystem to shut down.  The tasks woken by the first group do
+  // not run until the last group has been set.
+  FreeRTOS::EventGroupBase::setAll(subsystems, 3, BIT_SHUTDOWN);
+}
@@ -0,0 +1,54 @@
+#include <FreeRTOS/FastChannel.hpp>
+#include <FreeRTOS/Task.hpp>
+
+struct Reading {
+  uint16_t channel;
+  uint16_t value;
+};
+
+struct Calibration {
+  float gain;
+  float offset;
+};
+
+class SensorTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+SensorTask sensorTask;
+
+// Reading fits in 32 bits, so it is carried by notification index 1 of
+// sensorTask.  Calibration does not, so that channel holds a queue of one.
+FreeRTOS::FastChannel<Reading> readings(sensorTask);
+FreeRTOS::FastChannel<Calibration> calibrations(sensorTask);
+
+static_assert(decltype(readings)::usesNotification);
+static_assert(!decltype(calibrations)::usesNotification);
+
+void adcISR() {
+  bool higherPriorityTaskWoken = false;
+
+  // Fails if the task has not taken the previous reading yet.
+  readings.sendFromISR(higherPriorityTaskWoken, Reading{3, 1024});
+
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+void calibrate(const float gain, const float offset) {
+  calibrations.send(Calibration{gain, offset});
+}
+
+void SensorTask::taskFunction() {
+  Calibration calibration{1.0F, 0.0F};
+
+  for (;;) {
+    calibrations.receive(calibration, 0);
+
+    if (auto reading = readings.receive(pdMS_TO_TICKS(100))) {
+      const float value = (reading->value * calibration.gain) +
+                          calibration.offset;
+      // Use value.
+    }
+  }
+}
@@ -0,0 +1,36 @@
+#include <FreeRTOS/FastMutex.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <mutex>
+
+struct Config {
+  uint32_t baudRate = 115200;
+  uint32_t sampleRate = 1000;
+};
+
+// Almost every access to the configuration is uncontended, so it rarely
+// enters the kernel.
+static FreeRTOS::FastMutex configMutex;
+static Config config;
+
+uint32_t getSampleRate() {
+  std::lock_guard<FreeRTOS::FastMutex> guard(configMutex);
+  return config.sampleRate;
+}
+
+class ShellTask : public FreeRTOS::StaticTask<512> {
+ public:
+  ShellTask() : FreeRTOS::StaticTask<512>(tskIDLE_PRIORITY + 1, "Shell") {}
+
+  void taskFunction() final {
+    for (;;) {
+      // Wait for a command here.
+
+      if (configMutex.lock(pdMS_TO_TICKS(10))) {
+        config.baudRate = 9600;
+        configMutex.unlock();
+      }
+    }
+  }
+};
+
+static ShellTask shellTask;
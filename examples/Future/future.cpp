@@ -0,0 +1,57 @@
+#include <FreeRTOS/Future.hpp>
+#include <FreeRTOS/IsrContext.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+
+struct Conversion {
+  uint8_t channel;
+  FreeRTOS::Promise<uint16_t> result;
+};
+
+static FreeRTOS::StaticQueue<Conversion, 4> conversions;
+static FreeRTOS::Promise<uint16_t> pending;
+
+// ADC driver task.  It starts one conversion at a time and the end of
+// conversion interrupt delivers the result straight to the requester.
+class Adc : public FreeRTOS::StaticTask<128> {
+ public:
+  Adc() : FreeRTOS::StaticTask<128>(tskIDLE_PRIORITY + 3, "ADC") {}
+
+  void taskFunction() final {
+    for (;;) {
+      Conversion conversion;
+      if (conversions.receive(conversion, portMAX_DELAY)) {
+        pending = conversion.result;
+        // Select conversion.channel and start the conversion here.
+        notifyTake(portMAX_DELAY, true, 1);
+      }
+    }
+  }
+};
+
+static Adc adc;
+
+extern "C" void ADC_IRQHandler(void) {
+  FreeRTOS::IsrContext context;
+  const uint16_t sample = 0;  // Read the data register here.
+  pending.setValueFromISR(context, sample);
+  adc.notifyGiveFromISR(context, 1);
+}
+
+// Called from any task.  The call costs one queue send and one notification
+// round-trip, and no reply queue is created.
+uint16_t readChannel(const uint8_t channel) {
+  FreeRTOS::Future<uint16_t> future;
+  conversions.sendToBack({channel, future.getPromise()});
+
+  const std::optional<uint16_t> sample = future.get(pdMS_TO_TICKS(10));
+  if (!sample) {
+    // The future must outlive the promise, so wait for the late result.
+    return future.get().value_or(0);
+  }
+  return *sample;
+}
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
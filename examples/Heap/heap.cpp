@@ -0,0 +1,48 @@
+#include <FreeRTOS/Heap.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <vector>
+
+// Route every new and delete in the application to pvPortMalloc() and
+// vPortFree().  This must only appear in one source file.
+FREERTOS_CPP_DEFINE_GLOBAL_NEW()
+
+class MyTask : public FreeRTOS::Task {
+ public:
+  MyTask() : FreeRTOS::Task(tskIDLE_PRIORITY + 1, 256, "MyTask") {}
+
+  void taskFunction() final {
+    // The vector's storage comes from the FreeRTOS heap.
+    std::vector<uint32_t, FreeRTOS::Allocator<uint32_t>> samples;
+    samples.reserve(32);
+
+    for (;;) {
+      samples.push_back(xTaskGetTickCount());
+      if (samples.size() == samples.capacity()) {
+        samples.clear();
+      }
+
+      // Check how close the heap has come to running out.
+      if (FreeRTOS::Heap::getMinimumEverFreeSize() < 512) {
+        // Consider a larger configTOTAL_HEAP_SIZE.
+      }
+      size_t liveAllocations = FreeRTOS::Heap::getAllocationCount();
+      (void)liveAllocations;
+
+      delay(100);
+    }
+  }
+};
+
+struct Message {
+  uint32_t id;
+  uint8_t payload[64];
+};
+
+void example() {
+  // With the global operator new replaced, plain C++ objects are also
+  // allocated from the FreeRTOS heap.
+  Message* message = new Message;
+  delete message;
+}
+
+static MyTask myTask;
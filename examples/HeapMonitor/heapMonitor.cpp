@@ -0,0 +1,42 @@
+#include <FreeRTOS/HeapMonitor.hpp>
+#include <FreeRTOS/Timer.hpp>
+
+// Called once each time an alarm is raised.
+static void heapAlarm(FreeRTOS::HeapMonitor::Alarm alarm,
+                      const FreeRTOS::HeapStatistics& statistics) {
+  if (alarm == FreeRTOS::HeapMonitor::Alarm::LowLargestBlock) {
+    // The next connection task, which needs its 1 KiB stack and a 512 byte
+    // queue, may fail to be created.  Send the statistics to the server.
+  }
+}
+
+// Alarm when less than 2 KiB is free, when no free block can hold a 1 KiB
+// task stack, or when more than 60% of the free memory is fragmented.
+static FreeRTOS::HeapMonitor monitor(2048, 1024, 600, heapAlarm);
+
+class SampleTimer : public FreeRTOS::StaticTimer {
+ public:
+  SampleTimer() : FreeRTOS::StaticTimer(pdMS_TO_TICKS(1000), true, "Heap") {}
+
+  void timerFunction() final {
+    monitor.sample();
+  }
+};
+
+static SampleTimer sampleTimer;
+
+void aFunction() {
+  sampleTimer.start();
+}
+
+void reportTelemetry() {
+  const FreeRTOS::HeapStatistics statistics = monitor.getStatistics();
+
+  // Send these with the rest of the telemetry to follow the trend across the
+  // fleet.
+  const size_t minimumEverFree = statistics.minimumEverFree;
+  const size_t liveBlocks = statistics.allocations - statistics.frees;
+  const size_t worstLargestBlock = monitor.getLowestLargestBlock();
+  const uint32_t worstFragmentation = monitor.getPeakFragmentation();
+  // ...
+}
@@ -0,0 +1,69 @@
+#include <FreeRTOS/HighResTimer.hpp>
+#include <FreeRTOS/IsrContext.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// Compare channel 1 of a 32-bit general purpose timer, counting at 1 MHz.
+#define TIM2_DIER (*reinterpret_cast<volatile uint32_t*>(0x4000000C))
+#define TIM2_EGR (*reinterpret_cast<volatile uint32_t*>(0x40000014))
+#define TIM2_CNT (*reinterpret_cast<volatile uint32_t*>(0x40000024))
+#define TIM2_CCR1 (*reinterpret_cast<volatile uint32_t*>(0x40000034))
+
+struct Tim2 {
+  static constexpr uint32_t ticksPerMicrosecond = 1;
+
+  static uint32_t now() {
+    return TIM2_CNT;
+  }
+  static void setCompare(const uint32_t time) {
+    TIM2_CCR1 = time;
+    TIM2_DIER |= (1 << 1);
+  }
+  static void disableCompare() {
+    TIM2_DIER &= ~(1 << 1);
+  }
+  static void trigger() {
+    TIM2_EGR = (1 << 1);
+  }
+};
+
+using Timer = FreeRTOS::HighResTimer<Tim2>;
+
+// Commutate the motor every 50 us, directly in the compare interrupt.
+static void commutate(void* argument, bool& higherPriorityTaskWoken) {
+  // Update the motor phase outputs here.
+  static_cast<void>(argument);
+  static_cast<void>(higherPriorityTaskWoken);
+}
+
+static Timer commutationTimer(commutate, nullptr,
+                              50 * Tim2::ticksPerMicrosecond, true);
+
+// A task that is woken 250 us after each received frame to send the reply.
+class ReplyTask : public FreeRTOS::StaticTask<256> {
+ public:
+  ReplyTask() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 3, "Reply") {}
+  void taskFunction() final {
+    for (;;) {
+      notifyTake(portMAX_DELAY, true, 1);
+      // Send the reply here.
+    }
+  }
+};
+
+static ReplyTask replyTask;
+static Timer replyTimer(replyTask, 1, 250 * Tim2::ticksPerMicrosecond);
+
+void frameReceivedFromISR() {
+  replyTimer.startFromISR();
+}
+
+extern "C" void TIM2_IRQHandler(void) {
+  FreeRTOS::IsrContext context;
+  // Clear the compare interrupt flag here.
+  Timer::handleCompareFromISR(context);
+}
+
+void aFunction() {
+  commutationTimer.start();
+  FreeRTOS::Kernel::startScheduler();
+}
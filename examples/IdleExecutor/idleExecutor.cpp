@@ -0,0 +1,57 @@
+#include <FreeRTOS/IdleExecutor.hpp>
+#include <FreeRTOS/Kernel.hpp>
+#include <cstddef>
+#include <cstdint>
+
+static FreeRTOS::IdleExecutor background;
+
+// Progress of a CRC scrub over a block of memory.  Each step checks one chunk,
+// so the job can be resumed wherever the idle slice ended.
+struct Scrub {
+  const uint8_t* data;
+  size_t size;
+  size_t offset;
+  uint32_t crc;
+};
+
+static const uint8_t image[4096] = {0};
+static Scrub scrub = {image, sizeof(image), 0, 0xFFFFFFFFUL};
+
+static bool scrubStep(void* argument) {
+  Scrub& state = *static_cast<Scrub*>(argument);
+  const size_t end = (state.offset + 64 < state.size) ? state.offset + 64
+                                                      : state.size;
+  for (; state.offset < end; state.offset++) {
+    state.crc ^= state.data[state.offset];
+    for (int bit = 0; bit < 8; bit++) {
+      state.crc = (state.crc >> 1) ^ (0xEDB88320UL & -(state.crc & 1));
+    }
+  }
+  // Compare ~state.crc with the stored value here once the end is reached.
+  return state.offset == state.size;
+}
+
+static bool compactStep(void*) {
+  // Move one log record towards the start of the log here.  Return true when
+  // there is nothing left to move.
+  return true;
+}
+
+// The scrub may use two run time counter units of each idle slice.  The
+// compaction moves one record per slice.
+static FreeRTOS::IdleJob scrubJob(scrubStep, &scrub, 2);
+static FreeRTOS::IdleJob compactJob(compactStep);
+
+#if (configUSE_IDLE_HOOK == 1)
+FREERTOS_CPP_DEFINE_IDLE_EXECUTOR_HOOK(background)
+#endif /* configUSE_IDLE_HOOK */
+
+void aFunction() {
+  background.post(scrubJob);
+  background.post(compactJob);
+
+  FreeRTOS::Kernel::startScheduler();
+
+  // Post scrubJob again from a timer to repeat the scrub every hour, and use
+  // background.getStatistics().overruns to check that the steps are short.
+}
@@ -0,0 +1,77 @@
+// FREERTOS_CPP_INSTRUMENTATION is normally set to 1 in FreeRTOSConfig.h so
+// that every translation unit sees the same value.
+#define FREERTOS_CPP_INSTRUMENTATION 1
+
+#include <FreeRTOS/Instrumentation.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+
+namespace {
+
+constexpr size_t callCount =
+    static_cast<size_t>(FreeRTOS::InstrumentedCall::MessageBufferReceive) + 1;
+
+// Longest time spent blocked and number of failures for every call.  Entries
+// are only written by the hooks, which may run in several tasks at once, so a
+// reader must tolerate a value that is being updated.
+volatile uint32_t worstBlockTime[callCount] = {0};
+volatile uint32_t failures[callCount] = {0};
+volatile uint32_t isrFailures[callCount] = {0};
+
+inline size_t indexOf(const FreeRTOS::InstrumentedCall call) {
+  return static_cast<size_t>(call);
+}
+
+}  // namespace
+
+// The hooks are declared by FreeRTOS::ApplicationInstrumentation and must be
+// defined exactly once by the application.
+void FreeRTOS::ApplicationInstrumentation::onBlockBegin(
+    InstrumentedCall call, const void* object, TickType_t ticksToWait,
+    uint32_t timestamp) {}
+
+void FreeRTOS::ApplicationInstrumentation::onBlockEnd(InstrumentedCall call,
+                                                      const void* object,
+                                                      uint32_t begin,
+                                                      uint32_t end) {
+  const uint32_t elapsed = end - begin;
+  if (elapsed > worstBlockTime[indexOf(call)]) {
+    worstBlockTime[indexOf(call)] = elapsed;
+  }
+}
+
+void FreeRTOS::ApplicationInstrumentation::onFail(InstrumentedCall call,
+                                                  const void* object,
+                                                  uint32_t timestamp) {
+  failures[indexOf(call)] = failures[indexOf(call)] + 1;
+}
+
+void FreeRTOS::ApplicationInstrumentation::onIsrCall(InstrumentedCall call,
+                                                     const void* object,
+                                                     bool succeeded,
+                                                     uint32_t timestamp) {
+  if (!succeeded) {
+    isrFailures[indexOf(call)] = isrFailures[indexOf(call)] + 1;
+  }
+}
+
+class Consumer : public FreeRTOS::Task {
+ public:
+  explicit Consumer(const FreeRTOS::Queue<uint32_t>& queue)
+      : FreeRTOS::Task(1, configMINIMAL_STACK_SIZE, "Consumer"), queue(queue) {}
+
+  void taskFunction() final {
+    for (;;) {
+      // Every receive that waits reports its blocking time, and every receive
+      // that times out is counted as a failure.
+      auto value = queue.receive(pdMS_TO_TICKS(100));
+      if (!value.has_value()) {
+        // The producer is late.  Its worst case can be read from
+        // worstBlockTime[indexOf(FreeRTOS::InstrumentedCall::QueueSend)].
+      }
+    }
+  }
+
+ private:
+  const FreeRTOS::Queue<uint32_t>& queue;
+};
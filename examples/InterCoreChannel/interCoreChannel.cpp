@@ -0,0 +1,69 @@
+#include <FreeRTOS/InterCoreChannel.hpp>
+#include <FreeRTOS/Task.hpp>
+
+#if (configUSE_SB_COMPLETED_CALLBACK == 1)
+
+// Both images declare the channel the same way.  Both linker scripts place
+// .shared_ram at the same address as NOLOAD, in memory the MPU marks as
+// non-cacheable.
+__attribute__((section(".shared_ram")))
+FreeRTOS::InterCoreChannel<1024> toCoreB;
+
+// Fake peripheral interface functions.
+void raiseMailboxInterrupt() {}
+void clearMailboxInterrupt() {}
+
+// ---- Core A, the sender ----
+
+struct Sample {
+  uint32_t timestamp;
+  int16_t values[8];
+};
+
+class AcquisitionTask : public FreeRTOS::StaticTask<256> {
+ public:
+  AcquisitionTask() : FreeRTOS::StaticTask<256>(3, "Acquire") {}
+
+  void taskFunction() final {
+    const bool created = toCoreB.create(raiseMailboxInterrupt);
+    configASSERT(created);
+
+    for (;;) {
+      const Sample sample = {xTaskGetTickCount(), {0}};
+      if (toCoreB.send(&sample, sizeof(sample)) == 0) {
+        // Core B has fallen behind, so the sample is dropped.
+      }
+      delay(pdMS_TO_TICKS(1));
+    }
+  }
+};
+
+// ---- Core B, the receiver ----
+
+extern "C" void MAILBOX_IRQHandler(void) {
+  bool higherPriorityTaskWoken = false;
+  clearMailboxInterrupt();
+  toCoreB.handleInterrupt(higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+class ProcessingTask : public FreeRTOS::StaticTask<512> {
+ public:
+  ProcessingTask() : FreeRTOS::StaticTask<512>(2, "Process") {}
+
+  void taskFunction() final {
+    // Core A may still be booting.
+    while (!toCoreB.isReady()) {
+      delay(1);
+    }
+
+    for (;;) {
+      Sample sample;
+      if (toCoreB.receive(&sample, sizeof(sample)) == sizeof(sample)) {
+        // Process sample.
+      }
+    }
+  }
+};
+
+#endif /* configUSE_SB_COMPLETED_CALLBACK */
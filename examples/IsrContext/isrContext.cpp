@@ -0,0 +1,37 @@
+#include <FreeRTOS/IsrContext.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Semaphore.hpp>
+#include <FreeRTOS/Task.hpp>
+
+class MyTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+MyTask task;
+FreeRTOS::Queue<uint8_t> rxQueue(32);
+FreeRTOS::BinarySemaphore lineReady;
+
+// A UART interrupt that may wake several tasks in a single invocation.
+void uartISR(void) {
+  // Every *FromISR call below records whether it woke a higher priority task
+  // in isr.  A single context switch is requested when isr goes out of scope
+  // at the end of the interrupt, instead of one per call.
+  FreeRTOS::IsrContext isr;
+
+  const uint8_t byte = 0;  // Read the received byte from the peripheral.
+
+  rxQueue.sendToBackFromISR(isr, byte);
+
+  if (byte == '\n') {
+    lineReady.giveFromISR(isr);
+  }
+
+  task.notifyGiveFromISR(isr);
+}
+
+void MyTask::taskFunction() {
+  for (;;) {
+    notifyTake(portMAX_DELAY);
+  }
+}
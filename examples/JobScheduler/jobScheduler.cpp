@@ -0,0 +1,45 @@
+#include <FreeRTOS/JobScheduler.hpp>
+#include <FreeRTOS/Kernel.hpp>
+
+// One 256 word stack serves every job below, where three tasks would each
+// need a stack of their own.
+static FreeRTOS::JobScheduler<256> jobs(tskIDLE_PRIORITY + 1, "Jobs");
+
+static void blinkLed(void*) {
+  // Toggle the status LED here.
+}
+
+static void pollStatus(void*) {
+  // Read a status register and log any change here.
+}
+
+static void kickWatchdog(void*) {
+  // Refresh the independent watchdog here.
+}
+
+static void handleButton(void*) {
+  // Debounce and act on the button press here.
+}
+
+static FreeRTOS::Job led(blinkLed);
+static FreeRTOS::Job status(pollStatus);
+static FreeRTOS::Job watchdog(kickWatchdog, nullptr, 2);
+static FreeRTOS::Job button(handleButton, nullptr, 1);
+
+// The interrupt only marks the job ready.  The work runs in the scheduler
+// task once the interrupt has returned.
+extern "C" void EXTI0_IRQHandler(void) {
+  bool higherPriorityTaskWoken = false;
+  jobs.triggerFromISR(higherPriorityTaskWoken, button);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+void aFunction() {
+  jobs.schedule(led, 0, pdMS_TO_TICKS(500));
+  jobs.schedule(status, pdMS_TO_TICKS(10), pdMS_TO_TICKS(100));
+  jobs.schedule(watchdog, 0, pdMS_TO_TICKS(250));
+
+  FreeRTOS::Kernel::startScheduler();
+
+  // Print led.getStatistics().maxTime to see how long the longest blink took.
+}
@@ -0,0 +1,36 @@
+#include <FreeRTOS/Log.hpp>
+#include <FreeRTOS/Task.hpp>
+
+static FreeRTOS::StaticLog<2048> eventLog;
+
+extern "C" void vAdcInterruptHandler(void) {
+  const uint16_t sample = 0;
+
+  // Only the format string address, the tick count and one word are stored.
+  eventLog.writeFromISR("adc sample %u\n", sample);
+}
+
+void setMode(const int mode) {
+  eventLog.write("mode %d -> %d\n", 0, mode);
+}
+
+class LogTask : public FreeRTOS::StaticTask<512> {
+ public:
+  LogTask() : FreeRTOS::StaticTask<512>(tskIDLE_PRIORITY + 1, "Log") {}
+
+  void taskFunction() final {
+    FreeRTOS::LogRecord record;
+    char text[96];
+    for (;;) {
+      if (eventLog.receive(record)) {
+        // The text is produced here, at low priority, rather than at the call
+        // site.
+        eventLog.format(record, text, sizeof(text));
+
+        // Send text to the console here.
+      }
+    }
+  }
+};
+
+static LogTask logTask;
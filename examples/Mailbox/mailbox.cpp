@@ -0,0 +1,60 @@
+#include <FreeRTOS/Mailbox.hpp>
+#include <FreeRTOS/Task.hpp>
+
+struct ControllerState {
+  int32_t position;
+  int32_t velocity;
+  uint32_t flags;
+};
+
+// The latest controller state.  Up to two readers can block waiting for a new
+// state, any number of readers can poll it.
+static FreeRTOS::Mailbox<ControllerState, 2> state;
+
+// Called from the control loop interrupt every cycle.
+void controlLoopISR() {
+  bool higherPriorityTaskWoken = false;
+  ControllerState current = {0, 0, 0};
+
+  // ... Compute the new state.
+
+  // Publish it.  Readers never stop the writer from updating the state.
+  state.writeFromISR(higherPriorityTaskWoken, current);
+
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+class DisplayTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+void DisplayTask::taskFunction() {
+  ControllerState current;
+  uint32_t version = 0;
+
+  for (;;) {
+    // Block until a state newer than the last one displayed is written.
+    if (state.wait(current, version, pdMS_TO_TICKS(100))) {
+      // Display current.
+    }
+  }
+}
+
+class LoggerTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+void LoggerTask::taskFunction() {
+  ControllerState current;
+
+  for (;;) {
+    // Poll the latest state.  read() never blocks and never takes a critical
+    // section.  It returns 0 until the first state is written.
+    if (state.read(current) != 0) {
+      // Log current.
+    }
+    delay(pdMS_TO_TICKS(1000));
+  }
+}
@@ -0,0 +1,20 @@
+#include <FreeRTOS/MessageBuffer.hpp>
+
+#if (configUSE_SB_COMPLETED_CALLBACK == 1)
+
+// Fake peripheral interface function.
+void startTransmitDma() {}
+
+// Each queued frame starts the transmitter straight away, without waking a
+// task to do it.
+void frameQueued(StreamBufferHandle_t messageBuffer, BaseType_t isInsideISR,
+                 BaseType_t* const higherPriorityTaskWoken) {
+  (void)messageBuffer;
+  (void)isInsideISR;
+  (void)higherPriorityTaskWoken;
+  startTransmitDma();
+}
+
+static FreeRTOS::StaticMessageBuffer<512> txFrames(frameQueued);
+
+#endif /* configUSE_SB_COMPLETED_CALLBACK */
@@ -0,0 +1,33 @@
+#include <FreeRTOS/MessageBuffer.hpp>
+#include <FreeRTOS/Task.hpp>
+
+struct Header {
+  uint8_t type;
+  uint8_t sequence;
+  uint16_t length;
+};
+
+// Fake checksum function.
+uint16_t crc16(const void* data, size_t length) {
+  (void)data;
+  (void)length;
+  return 0;
+}
+
+static FreeRTOS::StaticMessageBuffer<1024> radioFrames;
+
+// radioFrames has a single writer, so one scratch buffer serves every call to
+// sendFrame() instead of a frame sized buffer on the stack of each caller.
+static uint8_t frameScratch[260];
+
+bool sendFrame(const uint8_t type, const void* payload, const uint16_t length) {
+  static uint8_t sequence = 0;
+  const Header header{type, sequence++, length};
+  const uint16_t crc = crc16(payload, length);
+
+  return (radioFrames.send({{&header, sizeof(header)},
+                            {payload, length},
+                            {&crc, sizeof(crc)}},
+                           frameScratch, sizeof(frameScratch),
+                           pdMS_TO_TICKS(10)) != 0);
+}
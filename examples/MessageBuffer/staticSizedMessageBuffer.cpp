@@ -0,0 +1,37 @@
+#include <FreeRTOS/MessageBuffer.hpp>
+#include <FreeRTOS/Task.hpp>
+
+struct Reading {
+  uint16_t channel;
+  int32_t value;
+};
+
+// Room for 8 commands of up to 48 bytes each, with the length word of every
+// message accounted for.
+static FreeRTOS::StaticSizedMessageBuffer<48, 8> commands;
+
+// Trivially copyable readings are sent and received directly.
+static FreeRTOS::StaticSizedMessageBuffer<sizeof(Reading), 16> readings;
+
+class CommandTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final {
+    for (;;) {
+      // The buffer is exactly large enough for the longest command.
+      decltype(commands)::Buffer buffer;
+      const auto command = commands.receive(buffer, pdMS_TO_TICKS(100));
+      if (!command.empty()) {
+        // Handle command.size bytes at command.data.
+      }
+
+      Reading reading;
+      while (readings.receiveObject(reading, 0)) {
+        // Handle reading.
+      }
+    }
+  }
+};
+
+void sampleComplete(const uint16_t channel, const int32_t value) {
+  readings.sendObject(Reading{channel, value}, 0);
+}
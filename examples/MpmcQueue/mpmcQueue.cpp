@@ -0,0 +1,54 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/MpmcQueue.hpp>
+#include <FreeRTOS/Task.hpp>
+
+struct Packet {
+  uint16_t port;
+  uint16_t length;
+  uint8_t* payload;
+};
+
+// Shared by the receive tasks on both cores and the protocol workers.
+static FreeRTOS::StaticMpmcQueue<Packet, 32> packets;
+
+class Receiver : public FreeRTOS::StaticTask<256> {
+ public:
+  explicit Receiver(const char* name)
+      : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 3, name) {}
+
+  void taskFunction() final {
+    for (;;) {
+      notifyTake(portMAX_DELAY);
+      // Fill the packet from the network interface here.
+      const Packet packet = {0, 0, nullptr};
+      if (!packets.sendToBack(packet, pdMS_TO_TICKS(5))) {
+        // Drop the packet if the workers are too far behind.
+      }
+    }
+  }
+};
+
+class ProtocolWorker : public FreeRTOS::StaticTask<512> {
+ public:
+  explicit ProtocolWorker(const char* name)
+      : FreeRTOS::StaticTask<512>(tskIDLE_PRIORITY + 2, name) {}
+
+  void taskFunction() final {
+    Packet packet;
+    for (;;) {
+      // Only blocks in the kernel when the queue is empty.
+      if (packets.receive(packet)) {
+        // Handle the packet here.
+      }
+    }
+  }
+};
+
+static Receiver receiver0("Rx0");
+static Receiver receiver1("Rx1");
+static ProtocolWorker worker0("Proto0");
+static ProtocolWorker worker1("Proto1");
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
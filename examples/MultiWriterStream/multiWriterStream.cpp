@@ -0,0 +1,39 @@
+#include <FreeRTOS/MultiWriterStream.hpp>
+#include <FreeRTOS/StreamBuffer.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <cstring>
+
+static FreeRTOS::StaticStreamBuffer<2048> logBuffer;
+
+// Any task or interrupt can log through logWriter without a mutex.  Each 32
+// bytes of a line use one of the 16 staging slots until the line has been
+// copied into logBuffer.
+static FreeRTOS::StaticMultiWriterStream<16, 32> logWriter(logBuffer);
+
+void log(const char* line) {
+  logWriter.write(line, std::strlen(line));
+}
+
+extern "C" void vDmaErrorHandler(void) {
+  static const char message[] = "DMA error\n";
+  bool higherPriorityTaskWoken = false;
+  logWriter.writeFromISR(higherPriorityTaskWoken, message, sizeof(message) - 1);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+class LogTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final {
+    char buffer[64];
+    for (;;) {
+      const size_t length =
+          logBuffer.receive(buffer, sizeof(buffer), pdMS_TO_TICKS(100));
+
+      // Send length bytes to the UART here.
+      (void)length;
+
+      // Stage anything that was waiting for the space just made.
+      logWriter.flush();
+    }
+  }
+};
@@ -0,0 +1,42 @@
+// Mutexes only record contention when FREERTOS_CPP_MUTEX_PROFILER is 1.  It is
+// normally set in FreeRTOSConfig.h so that every translation unit agrees.
+#define FREERTOS_CPP_MUTEX_PROFILER 1
+
+#include <FreeRTOS/Mutex.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <cstdio>
+
+static FreeRTOS::StaticMutex busMutex;
+static FreeRTOS::StaticMutex logMutex;
+
+class Monitor : public FreeRTOS::StaticTask<512> {
+ public:
+  Monitor() : FreeRTOS::StaticTask<512>(tskIDLE_PRIORITY + 1, "Monitor") {}
+
+  void taskFunction() final {
+    busMutex.setName("bus");
+    logMutex.setName("log");
+
+    for (;;) {
+      delay(pdMS_TO_TICKS(10000));
+
+      // Print the three most contended mutexes.
+      const FreeRTOS::MutexBase* top[3] = {};
+      for (UBaseType_t i = 0; i < 3; i++) {
+        top[i] = FreeRTOS::MutexRegistry::mostContended(top, i);
+        if (top[i] == nullptr) {
+          break;
+        }
+        const FreeRTOS::MutexStatistics statistics = top[i]->getStatistics();
+        printf("%s: %lu of %lu locks contended, max wait %lu, max hold %lu\n",
+               top[i]->getName(),
+               static_cast<unsigned long>(statistics.contended),
+               static_cast<unsigned long>(statistics.locks),
+               static_cast<unsigned long>(statistics.maxWait),
+               static_cast<unsigned long>(statistics.maxHold));
+      }
+    }
+  }
+};
+
+static Monitor monitor;
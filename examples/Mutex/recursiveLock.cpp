@@ -11,7 +11,7 @@ class MyOtherTask : public FreeRTOS::Task {
   void taskFunction() final;
 };
 
-FreeRTOS::StaticMutex mutex;
+FreeRTOS::StaticRecursiveMutex mutex;
 
 // A task that uses the mutex.
 void MyTask::taskFunction() {
@@ -0,0 +1,43 @@
+#include <FreeRTOS/NotifyChannel.hpp>
+#include <FreeRTOS/Task.hpp>
+
+enum class Command : uint8_t { Start, Stop, Reset };
+
+class MotorTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+MotorTask motorTask;
+
+// Commands are carried by notification index 1 of motorTask, and the latest
+// speed set point by index 2.  Neither channel allocates a kernel object.
+FreeRTOS::NotifyChannel<1, Command> commands(motorTask);
+FreeRTOS::NotifyChannel<2, int16_t> setPoint(motorTask);
+
+void buttonISR() {
+  bool higherPriorityTaskWoken = false;
+
+  // Fails if the previous command has not been handled yet.
+  commands.sendFromISR(higherPriorityTaskWoken, Command::Stop);
+
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+void setSpeed(const int16_t speed) {
+  // Only the most recent set point matters, so replace any pending one.
+  setPoint.overwrite(speed);
+}
+
+void MotorTask::taskFunction() {
+  for (;;) {
+    if (auto command = commands.receive(pdMS_TO_TICKS(10))) {
+      // Handle *command.
+    }
+
+    int16_t speed;
+    if (setPoint.receive(speed, 0)) {
+      // Apply speed.
+    }
+  }
+}
@@ -0,0 +1,50 @@
+#include <FreeRTOS/NotifyEventGroup.hpp>
+#include <FreeRTOS/Task.hpp>
+
+constexpr uint32_t rxComplete = (1UL << 0);
+constexpr uint32_t txComplete = (1UL << 1);
+constexpr uint32_t lineError = (1UL << 2);
+
+// Only the UART task waits, so one waiter slot is enough.  Index 1 of its
+// notification array is left free for other uses.
+static FreeRTOS::NotifyEventGroup<1> uartEvents;
+
+class UartTask : public FreeRTOS::StaticTask<256> {
+ public:
+  UartTask() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 3, "UART") {}
+
+  void taskFunction() final {
+    for (;;) {
+      // Wake on any event and clear the ones that were handled.
+      const uint32_t events =
+          uartEvents.wait(rxComplete | txComplete | lineError, true, false,
+                          pdMS_TO_TICKS(100));
+
+      if ((events & lineError) != 0) {
+        // Reset the peripheral here.
+      }
+      if ((events & rxComplete) != 0) {
+        // Read the received frame here.
+      }
+      if ((events & txComplete) != 0) {
+        // Queue the next frame here.
+      }
+      if (events == 0) {
+        // Nothing happened for 100 ms.
+      }
+    }
+  }
+};
+
+static UartTask uartTask;
+
+extern "C" void USART1_IRQHandler(void) {
+  bool higherPriorityTaskWoken = false;
+
+  // The UART task is woken directly from here.  Unlike
+  // EventGroupBase::setFromISR() nothing is posted to the timer service task,
+  // so a burst of interrupts cannot fill the timer command queue.
+  uartEvents.setFromISR(higherPriorityTaskWoken, rxComplete);
+
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
@@ -0,0 +1,30 @@
+#include <FreeRTOS/NotifySemaphore.hpp>
+#include <FreeRTOS/Task.hpp>
+
+class PacketTask : public FreeRTOS::Task {
+ public:
+  PacketTask() : FreeRTOS::Task(tskIDLE_PRIORITY + 2, 256, "Packets") {}
+
+  // Counts packets that have arrived but have not been processed yet.
+  FreeRTOS::NotifyCountingSemaphore<2> packetsReady{*this};
+
+  void taskFunction() final {
+    for (;;) {
+      packetsReady.take();
+
+      // Process one packet here.
+    }
+  }
+};
+
+static PacketTask packetTask;
+
+extern "C" void vRxInterruptHandler(void) {
+  bool higherPriorityTaskWoken = false;
+
+  // Several packets may arrive before packetTask runs, and each one is
+  // counted.
+  packetTask.packetsReady.giveFromISR(higherPriorityTaskWoken);
+
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
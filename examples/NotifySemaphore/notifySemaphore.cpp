@@ -0,0 +1,31 @@
+#include <FreeRTOS/NotifySemaphore.hpp>
+#include <FreeRTOS/Task.hpp>
+
+class AdcTask : public FreeRTOS::StaticTask<256> {
+ public:
+  AdcTask() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 2, "ADC") {}
+
+  // Only this task ever takes the semaphore, so it can live in the task's own
+  // notification value at index 1 instead of a semaphore control block.
+  FreeRTOS::NotifySemaphore<1> conversionDone{*this};
+
+  void taskFunction() final {
+    for (;;) {
+      // Start a conversion here.
+
+      if (conversionDone.take(pdMS_TO_TICKS(5))) {
+        // Read the result here.
+      } else {
+        // The conversion timed out.
+      }
+    }
+  }
+};
+
+static AdcTask adcTask;
+
+extern "C" void vAdcInterruptHandler(void) {
+  bool higherPriorityTaskWoken = false;
+  adcTask.conversionDone.giveFromISR(higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
@@ -0,0 +1,44 @@
+#include <FreeRTOS/ObjectLock.hpp>
+#include <cstdint>
+
+// A counter of dropped packets kept by each network interface.  The interfaces
+// are serviced by tasks and interrupts on different cores, and each counter
+// only needs to exclude users of the same interface.
+class DropCounter {
+ public:
+  void add(const uint32_t packets, const uint32_t bytes) {
+    const FreeRTOS::ObjectLock::Guard guard(lock);
+    droppedPackets += packets;
+    droppedBytes += bytes;
+  }
+
+  void addFromISR(const uint32_t packets, const uint32_t bytes) {
+    const UBaseType_t status = lock.enterFromISR();
+    droppedPackets += packets;
+    droppedBytes += bytes;
+    lock.exitFromISR(status);
+  }
+
+  uint64_t bytesPerPacket() const {
+    const FreeRTOS::ObjectLock::Guard guard(lock);
+    return (droppedPackets == 0) ? 0 : droppedBytes / droppedPackets;
+  }
+
+ private:
+  FreeRTOS::ObjectLock lock;
+  uint64_t droppedPackets = 0;
+  uint64_t droppedBytes = 0;
+};
+
+static DropCounter ethernet;
+static DropCounter wifi;
+
+extern "C" void ETH_IRQHandler(void) {
+  // With FREERTOS_CPP_OBJECT_LOCKS set to 1 this never waits for a core that
+  // is updating the wifi counter.
+  ethernet.addFromISR(1, 1514);
+}
+
+void aFunction() {
+  wifi.add(2, 3000);
+}
@@ -0,0 +1,53 @@
+#include <FreeRTOS/ObjectRegistry.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Semaphore.hpp>
+#include <FreeRTOS/Task.hpp>
+
+struct Command {
+  uint8_t opcode;
+  uint8_t argument;
+};
+
+class WorkerTask : public FreeRTOS::StaticTask<256> {
+ public:
+  WorkerTask() : FreeRTOS::StaticTask<256>(2, "worker") {}
+
+  void taskFunction() final {
+    for (;;) {
+      delay(pdMS_TO_TICKS(100));
+    }
+  }
+};
+
+static WorkerTask worker;
+static FreeRTOS::StaticQueue<Command, 8> commands;
+static FreeRTOS::StaticBinarySemaphore ready;
+
+// Sixteen slots for the dozen or so objects the diagnostics shell can reach.
+static FreeRTOS::ObjectRegistry<16> registry;
+
+void registerObjects() {
+  registry.add("worker", worker);
+  registry.add("commands", commands);
+  registry.add("ready", ready);
+}
+
+// Called by the diagnostics shell with the names typed by the user.
+void shellSuspend(const char* name) {
+  // The worker is stored as a TaskBase, so it is found as one.
+  if (FreeRTOS::TaskBase* task = registry.find<FreeRTOS::TaskBase>(name)) {
+    task->suspend();
+  }
+}
+
+bool shellSend(const char* name, const Command& command) {
+  // Only a queue of Command is returned, so the item type always matches.
+  auto* queue = registry.find<FreeRTOS::QueueBase<Command>>(name);
+  return (queue != nullptr) && queue->sendToBack(command, 0);
+}
+
+void shellGive(const char* name) {
+  if (auto* semaphore = registry.find<FreeRTOS::SemaphoreBase>(name)) {
+    semaphore->give();
+  }
+}
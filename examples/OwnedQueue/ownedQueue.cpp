@@ -0,0 +1,54 @@
+#include <FreeRTOS/OwnedQueue.hpp>
+#include <FreeRTOS/Task.hpp>
+
+class CameraTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+class EncoderTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+// A large message that would be expensive to copy through a queue by value.
+struct ImageTile {
+  explicit ImageTile(uint16_t index) : index(index) {}
+
+  uint16_t index;
+  uint8_t pixels[2048];
+};
+
+// At most four tiles exist at any one time.  Only pointers to the tiles are
+// copied through the queue.
+FreeRTOS::OwnedQueue<ImageTile, 4> tileQueue;
+
+void CameraTask::taskFunction() {
+  uint16_t index = 0;
+
+  for (;;) {
+    // Construct a tile in the pool.  Block for up to 10 ticks if all of the
+    // tiles are currently in use.
+    auto tile = tileQueue.allocate(10, index++);
+    if (!tile) {
+      continue;
+    }
+
+    // ... Fill tile->pixels.
+
+    // Pass ownership of the tile to the encoder task.  If the queue is full
+    // the tile stays owned by this task and is returned to the pool when tile
+    // goes out of scope.
+    tileQueue.sendToBack(tile, 10);
+  }
+}
+
+void EncoderTask::taskFunction() {
+  for (;;) {
+    if (auto tile = tileQueue.receive()) {
+      // ... Encode tile->pixels.
+
+      // The tile is returned to the pool when tile goes out of scope.
+    }
+  }
+}
@@ -0,0 +1,43 @@
+#include <FreeRTOS/Parallel.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// One helper for the second core of a dual core part.
+static FreeRTOS::ParallelPool<1, 256> pool(tskIDLE_PRIORITY + 2);
+
+static constexpr size_t width = 320;
+static constexpr size_t height = 240;
+static uint8_t input[height][width];
+static uint8_t output[height][width];
+
+static void blurRow(const size_t row) {
+  for (size_t x = 1; x < (width - 1); x++) {
+    output[row][x] = static_cast<uint8_t>(
+        (input[row][x - 1] + 2 * input[row][x] + input[row][x + 1]) / 4);
+  }
+}
+
+static void histogram() {}
+static void edges() {}
+
+class Camera : public FreeRTOS::StaticTask<256> {
+ public:
+  Camera() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 2, "Camera") {}
+
+  void taskFunction() final {
+    for (;;) {
+      notifyTake(portMAX_DELAY);
+
+      // Rows are claimed 16 at a time by this task and the helper.
+      pool.parallelFor(height, 16, [](const size_t row) { blurRow(row); });
+
+      // Two independent passes over the output, one on each core.
+      pool.forkJoin(histogram, edges);
+    }
+  }
+};
+
+static Camera camera;
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
@@ -0,0 +1,46 @@
+#include <FreeRTOS/PeriodicTask.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// A 1 kHz control loop.  If a cycle overruns, the missed periods are dropped
+// so that the loop does not run several cycles back to back.
+class ControlLoop : public FreeRTOS::PeriodicTask<256> {
+ public:
+  ControlLoop()
+      : FreeRTOS::PeriodicTask<256>(pdMS_TO_TICKS(1), (tskIDLE_PRIORITY + 3),
+                                    "Control", OverrunPolicy::Skip) {}
+
+ protected:
+  void cycle() final {
+    // Read sensors, run the controller and update the actuators here.
+  }
+
+  void overrun(const TickType_t lateness) final {
+    // Called when a cycle finished after the start of the next period.
+    static_cast<void>(lateness);
+  }
+};
+
+static ControlLoop controlLoop;
+
+// A low priority task that checks the timing of the control loop.
+class Monitor : public FreeRTOS::StaticTask<256> {
+ public:
+  Monitor() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 1, "Monitor") {}
+
+  void taskFunction() final {
+    for (;;) {
+      delay(pdMS_TO_TICKS(1000));
+      const FreeRTOS::PeriodicStatistics statistics =
+          controlLoop.getStatistics();
+      if ((statistics.overruns > 0) || (statistics.maxJitter > 0)) {
+        // Report that the control loop missed its timing.
+      }
+    }
+  }
+};
+
+static Monitor monitor;
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
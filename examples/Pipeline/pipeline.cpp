@@ -0,0 +1,66 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Pipeline.hpp>
+#include <cstdint>
+#include <optional>
+
+struct Sample {
+  int16_t value;
+};
+
+struct Level {
+  int32_t energy;
+};
+
+struct Detection {
+  uint32_t block;
+  int32_t energy;
+};
+
+static Sample acquire() {
+  // Wait for the next ADC conversion here.
+  vTaskDelay(1);
+  return Sample{0};
+}
+
+static Sample filter(const Sample& sample) {
+  static int32_t state = 0;
+  state += (sample.value - state) / 4;
+  return Sample{static_cast<int16_t>(state)};
+}
+
+// Runs once per block of 32 filtered samples.
+static std::optional<Detection> detect(const Sample* samples,
+                                       const size_t count) {
+  static uint32_t block = 0;
+  int32_t energy = 0;
+  for (size_t i = 0; i < count; i++) {
+    energy += samples[i].value * samples[i].value;
+  }
+  block++;
+  if (energy < 1000) {
+    return std::nullopt;
+  }
+  return Detection{block, energy};
+}
+
+static void report(const Detection& detection) {
+  // Send the detection to the host here.
+  static_cast<void>(detection);
+}
+
+// The detector takes whole blocks, so its queue holds two of them.  The
+// report queue is short because detections are rare.
+static FreeRTOS::Pipeline<
+    FreeRTOS::Stage<decltype(&acquire), 256>,
+    FreeRTOS::Stage<decltype(&filter), 256, 8>,
+    FreeRTOS::Stage<decltype(&detect), 256, 64, 32>,
+    FreeRTOS::Stage<decltype(&report), 512, 2>>
+    pipeline("Dsp", tskIDLE_PRIORITY + 2, acquire, filter, detect, report);
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+
+  // A stage whose queue keeps reaching its depth is the bottleneck.  Compare
+  // pipeline.getStatistics(stage).peakOccupancy with the depth of each stage,
+  // and sample the processed counts once a second for the throughput.
+}
@@ -0,0 +1,40 @@
+#include <FreeRTOS/PriorityQueue.hpp>
+#include <FreeRTOS/Task.hpp>
+
+struct Message {
+  uint8_t id;
+  uint8_t payload[16];
+};
+
+enum Priority : UBaseType_t { Bulk = 0, Normal = 1, Control = 2 };
+
+// Three priority levels that can each hold 8 messages.
+static FreeRTOS::PriorityQueue<Message, 3, 8> messageQueue;
+
+class MyTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+void producer() {
+  Message bulk{};
+  Message stop{};
+
+  // Queue a bulk transfer that may take a while to drain.
+  messageQueue.sendToBack(bulk, Bulk, 0);
+
+  // A control message sent later is still received first.
+  messageQueue.sendToBack(stop, Control, 0);
+}
+
+void MyTask::taskFunction() {
+  Message message;
+
+  for (;;) {
+    // Block until a message is available on any level.  The highest priority
+    // message waiting is always returned first.
+    if (messageQueue.receive(message, portMAX_DELAY)) {
+      // Process message.
+    }
+  }
+}
@@ -0,0 +1,40 @@
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+
+class MyTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+// A sensor frame that is large enough that copying it twice per item is
+// noticeable.  The type does not need to be default constructible to be
+// received in place.
+class SensorFrame {
+ public:
+  explicit SensorFrame(uint32_t sequence) : sequence(sequence) {}
+
+  uint32_t sequence;
+  uint8_t samples[96];
+};
+
+// Queue used to send and receive complete SensorFrame objects.
+FreeRTOS::StaticQueue<SensorFrame, 4> frameQueue;
+
+// The frame is owned by the task and reused for every item received.
+static SensorFrame frame(0);
+
+void MyTask::taskFunction() {
+  for (;;) {
+    // Receive a frame directly into the caller owned object.  Block for 10
+    // ticks if a frame is not immediately available.  The kernel copies the
+    // item straight into frame, so no temporary object is created.
+    if (frameQueue.receive(frame, 10)) {
+      // frame now contains the received item.
+    }
+
+    // Look at the next frame without removing it from the queue.
+    if (frameQueue.peek(frame, 0)) {
+      // frame now contains a copy of the item at the front of the queue.
+    }
+  }
+}
@@ -0,0 +1,50 @@
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Task.hpp>
+
+class ProducerTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+class TelemetryTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+struct Sample {
+  uint32_t timestamp;
+  int16_t value;
+};
+
+constexpr size_t batchSize = 8;
+
+// Queue used to pass samples from the producer to the telemetry task.
+FreeRTOS::StaticQueue<Sample, 32> sampleQueue;
+
+void ProducerTask::taskFunction() {
+  Sample samples[batchSize] = {};
+
+  for (;;) {
+    // ... Fill samples.
+
+    // Post the whole batch.  Only the first sample may block waiting for
+    // space, the rest are posted for as long as there is room in the queue.
+    const size_t sent = sampleQueue.sendToBackN(samples, batchSize, 10);
+    if (sent < batchSize) {
+      // The queue filled up before the whole batch could be posted.
+    }
+  }
+}
+
+void TelemetryTask::taskFunction() {
+  Sample samples[batchSize];
+
+  for (;;) {
+    // Block until at least one sample is available, then drain everything
+    // else that is already waiting without blocking again.
+    const size_t count = sampleQueue.receiveN(samples, batchSize);
+    for (size_t i = 0; i < count; i++) {
+      // Process samples[i].
+    }
+  }
+}
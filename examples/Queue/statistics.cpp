@@ -0,0 +1,32 @@
+// Statistics are only recorded when FREERTOS_CPP_QUEUE_STATISTICS is 1.  It is
+// normally set in FreeRTOSConfig.h so that every translation unit agrees.
+#define FREERTOS_CPP_QUEUE_STATISTICS 1
+
+#include <FreeRTOS/Queue.hpp>
+
+void aFunction() {
+  // Create a queue that can hold 10 integers.
+  static FreeRTOS::Queue<int> queue(10);
+
+  for (int i = 0; i < 20; i++) {
+    // Attempts to post to a full queue are counted as send failures.
+    queue.sendToBack(i, 0);
+  }
+
+  int value;
+  while (queue.receive(value, 1)) {
+    // Blocking receives add the ticks spent waiting to the totals.
+  }
+
+  const FreeRTOS::QueueStatistics statistics = queue.getStatistics();
+
+  // statistics.maxMessagesWaiting is 10, statistics.sendFailures is 10 and
+  // statistics.receiveFailures is 1.  Use the high-water mark to size the
+  // queue and the failure counts to spot producers that outrun consumers.
+  if (statistics.maxMessagesWaiting == 10) {
+    // The queue filled up completely at least once.
+  }
+
+  // Start a new measurement period.
+  queue.resetStatistics();
+}
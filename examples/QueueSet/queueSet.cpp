@@ -0,0 +1,55 @@
+#include <FreeRTOS/QueueSet.hpp>
+#include <FreeRTOS/Task.hpp>
+
+class GatewayTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+constexpr UBaseType_t queueLength1 = 10;
+constexpr UBaseType_t queueLength2 = 10;
+constexpr UBaseType_t binarySemaphoreLength = 1;
+
+// The members that the gateway task needs to wait on.
+FreeRTOS::StaticQueue<uint32_t, queueLength1> queue1;
+FreeRTOS::StaticQueue<uint32_t, queueLength2> queue2;
+FreeRTOS::StaticBinarySemaphore semaphore;
+
+// The queue set must be large enough to hold an event for every space in every
+// queue and semaphore that is a member of the set.
+FreeRTOS::StaticQueueSet<queueLength1 + queueLength2 + binarySemaphoreLength>
+    queueSet;
+
+void GatewayTask::taskFunction() {
+  // Check everything was created.
+  configASSERT(queueSet.isValid());
+
+  // Add the queues and semaphore to the set.  Reading from these queues and
+  // semaphore can only be performed after a call to select() has returned the
+  // queue or semaphore handle from this point on.
+  queueSet.add(queue1);
+  queueSet.add(queue2);
+  queueSet.add(semaphore);
+
+  for (;;) {
+    // Block to wait for something to be available from the queues or
+    // semaphore that have been added to the set.  Don't block longer than
+    // 200ms.
+    auto member = queueSet.select(pdMS_TO_TICKS(200));
+
+    // Which set member was selected?  Receives and takes can use a block time
+    // of zero as they are guaranteed to pass because select() would not have
+    // returned the member unless something was available.
+    if (auto* queue = member.as(queue1)) {
+      auto value = queue->receive(0);
+      // Process the value received from queue1.
+    } else if (auto* queue = member.as(queue2)) {
+      auto value = queue->receive(0);
+      // Process the value received from queue2.
+    } else if (member.is(semaphore)) {
+      semaphore.take(0);
+    } else {
+      // The 200ms block time expired without a member becoming ready.
+    }
+  }
+}
@@ -0,0 +1,39 @@
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/RamBudget.hpp>
+#include <FreeRTOS/StreamBuffer.hpp>
+#include <FreeRTOS/Task.hpp>
+
+class RxTask : public FreeRTOS::StaticTask<256> {
+ public:
+  RxTask() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 2, "Rx") {}
+  void taskFunction() final;
+};
+
+class LogTask : public FreeRTOS::StaticTask<128> {
+ public:
+  LogTask() : FreeRTOS::StaticTask<128>(tskIDLE_PRIORITY + 1, "Log") {}
+  void taskFunction() final;
+};
+
+static RxTask rxTask;
+static FreeRTOS::StaticQueue<uint32_t, 32> rxQueue;
+
+static LogTask logTask;
+static FreeRTOS::StaticStreamBuffer<1024> logBuffer;
+
+// One budget per subsystem, built from the declarations above, so increasing a
+// stack depth or a queue length is checked when it is compiled.
+using CommsBudget =
+    FreeRTOS::RamBudget<2048, decltype(rxTask), decltype(rxQueue)>;
+using LoggingBudget =
+    FreeRTOS::RamBudget<2048, decltype(logTask), decltype(logBuffer)>;
+
+// The budget for the application fails to compile if the subsystems together
+// use more than 4 KiB.
+using ApplicationBudget = FreeRTOS::RamBudget<4096, CommsBudget, LoggingBudget>;
+
+// The breakdown is available as constants, for example to publish the margin
+// left in each subsystem.
+constexpr size_t commsUsed = CommsBudget::used;
+constexpr size_t loggingRemaining = LoggingBudget::remaining;
+constexpr size_t applicationUsed = ApplicationBudget::used;
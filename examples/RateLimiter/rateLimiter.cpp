@@ -0,0 +1,40 @@
+#include <FreeRTOS/RateLimiter.hpp>
+#include <FreeRTOS/StreamBuffer.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// The radio duty cycle allows 1000 bytes per second on average, with bursts of
+// up to 256 bytes.
+static FreeRTOS::RateLimiter airtime(1000, pdMS_TO_TICKS(1000), 256);
+
+static FreeRTOS::StaticStreamBuffer<1024> outgoing;
+
+class RadioTx : public FreeRTOS::StaticTask<256> {
+ public:
+  RadioTx() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 2, "RadioTx") {}
+
+  void taskFunction() final {
+    uint8_t packet[64];
+    for (;;) {
+      const size_t length =
+          outgoing.receive(packet, sizeof(packet), portMAX_DELAY);
+
+      // Only sleeps when the budget for this packet has been used up.
+      if (airtime.acquire(static_cast<uint32_t>(length))) {
+        // Transmit the packet here.
+      }
+    }
+  }
+};
+
+static RadioTx radioTx;
+
+// Beacons are dropped rather than delayed when the budget is exhausted.
+extern "C" void BEACON_IRQHandler(void) {
+  if (airtime.tryAcquireFromISR(16)) {
+    // Queue the beacon here.
+  }
+}
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
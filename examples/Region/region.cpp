@@ -0,0 +1,43 @@
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/Region.hpp>
+#include <FreeRTOS/StreamBuffer.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// Zero wait state RAM.  The linker script must define a .dtcm_bss output
+// section (it can be NOLOAD) in the DTCM memory region.
+FREERTOS_CPP_DEFINE_REGION(Dtcm, ".dtcm_bss", 8192)
+
+// Slower bulk SRAM.
+FREERTOS_CPP_DEFINE_REGION(Sram2, ".sram2_bss", 32768)
+
+struct Sample {
+  uint16_t channel;
+  uint16_t value;
+};
+
+// The queue is used on every sample, so its control block and storage go in
+// DTCM.
+static FreeRTOS::StaticQueue<Sample, 64, Dtcm> samples;
+
+// The log buffer is large and rarely touched, so it goes in SRAM2.
+static FreeRTOS::StaticStreamBuffer<16384, alignof(uint8_t), Sram2> logBuffer;
+
+// The TCB and stack of this task are in DTCM, which speeds up the context
+// switches into and out of it.
+class ControlTask : public FreeRTOS::StaticTask<512, Dtcm> {
+ public:
+  ControlTask()
+      : FreeRTOS::StaticTask<512, Dtcm>(configMAX_PRIORITIES - 1, "Control") {}
+
+  void taskFunction() final {
+    for (;;) {
+      if (auto sample = samples.receive()) {
+        // Run the control loop on *sample here.
+
+        logBuffer.send(&sample->value, sizeof(sample->value), 0);
+      }
+    }
+  }
+};
+
+static ControlTask controlTask;
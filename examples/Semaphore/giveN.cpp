@@ -0,0 +1,23 @@
+#include <FreeRTOS/Semaphore.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// Counts the free DMA descriptors.  Four worker tasks block on it.
+FreeRTOS::CountingSemaphore descriptors(8, 0);
+
+extern "C" void DMA1_Stream0_IRQHandler(void) {
+  bool higherPriorityTaskWoken = false;
+
+  // Return the descriptors completed by this transfer.  However many workers
+  // wake, a single context switch is requested.
+  descriptors.giveNFromISR(higherPriorityTaskWoken, 4);
+
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+void aFunction() {
+  // Release every waiting worker at once.  The highest priority worker runs
+  // once all four gives have been made.
+  if (descriptors.giveN(4) < 4) {
+    // The semaphore reached its maximum count.
+  }
+}
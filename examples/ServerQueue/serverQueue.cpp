@@ -0,0 +1,54 @@
+#include <FreeRTOS/ServerQueue.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <cstdint>
+
+struct FlashWrite {
+  uint32_t address;
+  uint32_t word;
+};
+
+// Writes to flash on behalf of other tasks.  It normally runs below the tasks
+// that do the periodic work.
+class FlashServer : public FreeRTOS::StaticTask<256> {
+ public:
+  FlashServer() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 1, "Flash") {}
+
+  FreeRTOS::ServerQueue<FlashWrite, 8> requests{*this};
+
+  void taskFunction() final {
+    for (;;) {
+      // While a control task has a write queued or in progress this task runs
+      // at the priority of that control task.
+      const auto request = requests.receive();
+      if (request) {
+        // Program request->word at request->address here.
+      }
+
+      // The client has been served, so drop back to the base priority before
+      // doing housekeeping that nobody is waiting for.
+      requests.complete();
+
+      // Compact the log here.
+    }
+  }
+};
+
+static FlashServer flashServer;
+
+class ControlTask : public FreeRTOS::StaticTask<256> {
+ public:
+  ControlTask()
+      : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 4, "Control") {}
+
+  void taskFunction() final {
+    for (;;) {
+      // Tasks with priorities between the server and this task cannot delay
+      // the write, as the server runs at this task's priority until it is
+      // complete.
+      flashServer.requests.sendToBack({0x08020000, 0xC0FFEE}, portMAX_DELAY);
+      vTaskDelay(pdMS_TO_TICKS(10));
+    }
+  }
+};
+
+static ControlTask controlTask;
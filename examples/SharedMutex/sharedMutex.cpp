@@ -0,0 +1,47 @@
+#include <FreeRTOS/SharedMutex.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <mutex>
+#include <shared_mutex>
+
+struct Route {
+  uint32_t destination;
+  uint32_t nextHop;
+};
+
+static FreeRTOS::StaticSharedMutex routesMutex;
+static Route routes[32];
+
+uint32_t lookup(const uint32_t destination) {
+  // Any number of tasks can look up a route at the same time.
+  std::shared_lock<FreeRTOS::StaticSharedMutex> guard(routesMutex);
+  for (const Route& route : routes) {
+    if (route.destination == destination) {
+      return route.nextHop;
+    }
+  }
+  return 0;
+}
+
+class RoutingTask : public FreeRTOS::StaticTask<512> {
+ public:
+  RoutingTask() : FreeRTOS::StaticTask<512>(tskIDLE_PRIORITY + 1, "Routing") {}
+
+  void taskFunction() final {
+    for (;;) {
+      delay(pdMS_TO_TICKS(60000));
+
+      // New readers wait while the table is updated.
+      if (routesMutex.lock(pdMS_TO_TICKS(100))) {
+        // Rebuild the routing table here.
+        routesMutex.unlock();
+      }
+    }
+  }
+};
+
+static RoutingTask routingTask;
+
+void addRoute(const Route& route) {
+  std::lock_guard<FreeRTOS::StaticSharedMutex> guard(routesMutex);
+  routes[0] = route;
+}
@@ -0,0 +1,40 @@
+#include <FreeRTOS/SpinLock.hpp>
+#include <FreeRTOS/Task.hpp>
+
+struct Position {
+  int32_t x = 0;
+  int32_t y = 0;
+};
+
+// Updated by the encoder interrupt on one core and read by a task that may
+// run on any core.
+static FreeRTOS::TicketSpinLock positionLock;
+static Position position;
+
+extern "C" void vEncoderInterruptHandler(void) {
+  FreeRTOS::TicketSpinLock::IsrGuard guard(positionLock);
+  position.x++;
+  position.y--;
+}
+
+class ControlTask : public FreeRTOS::StaticTask<512> {
+ public:
+  ControlTask() : FreeRTOS::StaticTask<512>(tskIDLE_PRIORITY + 2, "Control") {}
+
+  void taskFunction() final {
+    for (;;) {
+      Position snapshot;
+      {
+        FreeRTOS::TicketSpinLock::Guard guard(positionLock);
+        snapshot = position;
+      }
+
+      // Use the snapshot here without holding the lock.
+      (void)snapshot;
+
+      delay(pdMS_TO_TICKS(1));
+    }
+  }
+};
+
+static ControlTask controlTask;
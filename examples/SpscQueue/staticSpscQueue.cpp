@@ -0,0 +1,41 @@
+#include <FreeRTOS/SpscQueue.hpp>
+#include <FreeRTOS/Task.hpp>
+
+class MyTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+// Fake peripheral interface function.
+uint8_t readReceivedByte() {
+  return 0;
+}
+
+// Queue used to pass received bytes from the UART interrupt to a task.  The
+// interrupt is the only producer and the task is the only consumer.
+FreeRTOS::StaticSpscQueue<uint8_t, 64> rxQueue;
+
+void uartInterruptHandler() {
+  bool higherPriorityTaskWoken = false;
+
+  // Post the byte without entering a critical section.  The task is only
+  // notified if it is blocked waiting for data.
+  if (!rxQueue.sendToBackFromISR(higherPriorityTaskWoken, readReceivedByte())) {
+    // The queue was full and the byte was dropped.
+  }
+
+  if (higherPriorityTaskWoken) {
+    FreeRTOS::Kernel::yield();
+  }
+}
+
+void MyTask::taskFunction() {
+  uint8_t byte;
+
+  for (;;) {
+    // Block for up to 100 ticks waiting for a byte to arrive.
+    if (rxQueue.receive(byte, 100)) {
+      // Process byte.
+    }
+  }
+}
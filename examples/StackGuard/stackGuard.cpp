@@ -0,0 +1,49 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/StackGuard.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// FreeRTOSConfig.h ends with:
+//
+//   #define configCHECK_FOR_STACK_OVERFLOW 0
+//   #include <FreeRTOS/StackGuard.h>
+//
+// so that every context switch moves the guard to the stack of the task that
+// is switched in.  This defines the function that the hook calls.
+FREERTOS_CPP_DEFINE_STACK_GUARD()
+
+class ParserTask : public FreeRTOS::StaticTask<256> {
+ public:
+  ParserTask() : FreeRTOS::StaticTask<256>(2, "Parser") {}
+
+  void taskFunction() final {
+    for (;;) {
+      // Deep recursion that runs past the bottom of the stack writes to the
+      // guard and raises a MemManage fault, instead of silently corrupting
+      // the object that follows the stack in RAM.
+      // ...
+      delay(pdMS_TO_TICKS(10));
+    }
+  }
+};
+
+ParserTask parserTask;
+
+extern "C" void MemManage_Handler() {
+  // MMFAR holds the faulting address, which lies in the guard of the task
+  // returned by xTaskGetCurrentTaskHandle().
+  for (;;) {
+  }
+}
+
+int main() {
+  if (!FreeRTOS::StackGuard::hasStackLimit()) {
+    // The port does not load PSPLIM on context switches, so use the MPU.
+    const bool guarded = FreeRTOS::StackGuard::init();
+    configASSERT(guarded);
+  }
+
+  FreeRTOS::Kernel::startScheduler();
+
+  // Idle task should take over. This line should never be reached.
+  return 0;
+}
@@ -0,0 +1,32 @@
+// Tasks only register their stacks when FREERTOS_CPP_STACK_PROFILER is 1.  It
+// is normally set in FreeRTOSConfig.h so that every translation unit agrees.
+#define FREERTOS_CPP_STACK_PROFILER 1
+
+#include <FreeRTOS/StackProfiler.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <cstdio>
+
+class MyTask : public FreeRTOS::StaticTask<256> {
+ public:
+  MyTask() : FreeRTOS::StaticTask<256>(2, "MyTask") {}
+  void taskFunction() final;
+};
+
+void MyTask::taskFunction() {
+  for (;;) {
+    // ... Application code.
+  }
+}
+
+MyTask myTask;
+
+void printUsage(const FreeRTOS::StackUsage& usage) {
+  // For example "MyTask 256 words allocated, 98 used, suggest 128".
+  printf("%s %u words allocated, %u used, suggest %u\n", usage.name,
+         static_cast<unsigned>(usage.allocated),
+         static_cast<unsigned>(usage.used),
+         static_cast<unsigned>(usage.suggested));
+}
+
+// Sample every task once a second and print the results.
+FreeRTOS::StackProfiler<> stackProfiler(pdMS_TO_TICKS(1000), printUsage);
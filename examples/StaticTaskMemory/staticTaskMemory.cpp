@@ -0,0 +1,35 @@
+// Give the timer service task a deeper stack than the default.  This must be
+// defined before the header is included, for example in FreeRTOSConfig.h.
+#define FREERTOS_CPP_TIMER_TASK_STACK_SIZE (configMINIMAL_STACK_SIZE * 3)
+
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Queue.hpp>
+#include <FreeRTOS/StaticTaskMemory.hpp>
+#include <FreeRTOS/Task.hpp>
+
+// Supply the memory of the idle task and the timer service task.  With every
+// object of the application static as well, configSUPPORT_DYNAMIC_ALLOCATION
+// can be set to 0 and no heap implementation needs to be linked.
+FREERTOS_CPP_DEFINE_STATIC_TASK_MEMORY()
+
+static FreeRTOS::StaticQueue<uint32_t, 8> queue;
+
+class Worker : public FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE> {
+ public:
+  Worker() : FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE>(1, "Worker") {}
+
+  void taskFunction() final {
+    for (;;) {
+      uint32_t item = 0;
+      if (queue.receive(item, portMAX_DELAY)) {
+        // Process the item here.
+      }
+    }
+  }
+};
+
+static Worker worker;
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
@@ -0,0 +1,11 @@
+#include <FreeRTOS/StreamBuffer.hpp>
+
+// Cortex-M7 data cache line size.
+constexpr size_t cacheLine = 32;
+
+// The storage starts on a cache line boundary, so cleaning or invalidating the
+// lines covering it never touches the control block or neighbouring objects.
+// The section attribute places the whole object in a DMA capable RAM region
+// defined by the linker script.
+__attribute__((section(".dma_buffers")))
+FreeRTOS::StaticStreamBuffer<512, cacheLine> uartRxBuffer(16);
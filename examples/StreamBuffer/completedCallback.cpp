@@ -0,0 +1,24 @@
+#include <FreeRTOS/StreamBuffer.hpp>
+
+#if (configUSE_SB_COMPLETED_CALLBACK == 1)
+
+// Fake peripheral interface function.
+void raiseInterCoreInterrupt() {}
+
+// Called on this core each time bytes are written to the buffer.  The other
+// core is interrupted directly, rather than through the default
+// sbSEND_COMPLETED() behaviour which only unblocks a task on this core.
+void bytesSent(StreamBufferHandle_t streamBuffer, BaseType_t isInsideISR,
+               BaseType_t* const higherPriorityTaskWoken) {
+  (void)streamBuffer;
+  (void)isInsideISR;
+  (void)higherPriorityTaskWoken;
+  raiseInterCoreInterrupt();
+}
+
+// Buffer in memory shared with the other core.  Received bytes still use the
+// default sbRECEIVE_COMPLETED() behaviour.
+__attribute__((section(".shared_ram")))
+FreeRTOS::StaticStreamBuffer<256> toOtherCore(1, bytesSent);
+
+#endif /* configUSE_SB_COMPLETED_CALLBACK */
@@ -0,0 +1,35 @@
+#include <FreeRTOS/SystemSnapshot.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <cstdio>
+
+// Two snapshots of up to 8 tasks, kept out of the stack of the monitor task.
+static FreeRTOS::SystemSnapshot<8> snapshots[2];
+
+class MonitorTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+void MonitorTask::taskFunction() {
+  UBaseType_t current = 0;
+  snapshots[current].capture();
+
+  for (;;) {
+    delay(pdMS_TO_TICKS(5000));
+
+    const auto& previous = snapshots[current];
+    current ^= 1;
+    if (!snapshots[current].capture()) {
+      // More tasks exist than the snapshot can hold.
+      continue;
+    }
+
+    // Print the CPU load of every task over the last five seconds.
+    snapshots[current].forEachTaskLoad(previous, [](const auto& load) {
+      printf("%-16s %3lu.%02lu%%  stack free %u\n", load.status.pcTaskName,
+             static_cast<unsigned long>(load.percentHundredths / 100),
+             static_cast<unsigned long>(load.percentHundredths % 100),
+             static_cast<unsigned>(load.status.usStackHighWaterMark));
+    });
+  }
+}
@@ -0,0 +1,50 @@
+#include <FreeRTOS/Task.hpp>
+
+#if (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1)
+
+// A latency critical task that is pinned to core 1 so that its code and data
+// stay in that core's caches.
+class ControlTask : public FreeRTOS::StaticTask<256> {
+ public:
+  ControlTask()
+      : FreeRTOS::StaticTask<256>((tskIDLE_PRIORITY + 3), "Control",
+                                  (1 << 1)) {}
+  void taskFunction() final;
+};
+
+void ControlTask::taskFunction() {
+  for (;;) {
+#if (configUSE_TASK_PREEMPTION_DISABLE == 1)
+    // Run a short section that must not be preempted by other tasks.
+    disablePreemption();
+    // ...
+    enablePreemption();
+#endif /* configUSE_TASK_PREEMPTION_DISABLE */
+    delay(pdMS_TO_TICKS(1));
+  }
+}
+
+// A background task that may run on either core.
+class LoggingTask : public FreeRTOS::StaticTask<256> {
+ public:
+  LoggingTask()
+      : FreeRTOS::StaticTask<256>((tskIDLE_PRIORITY + 1), "Logging",
+                                  tskNO_AFFINITY) {}
+  void taskFunction() final {
+    for (;;) {
+      delay(pdMS_TO_TICKS(100));
+    }
+  }
+};
+
+static ControlTask controlTask;
+static LoggingTask loggingTask;
+
+void aFunction() {
+  // Keep the logging task off the core used by the control task.
+  loggingTask.setCoreAffinity(loggingTask.getCoreAffinity() & ~(1 << 1));
+
+  FreeRTOS::Kernel::startScheduler();
+}
+
+#endif /* (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1) */
@@ -0,0 +1,30 @@
+#include <FreeRTOS/Task.hpp>
+
+// A task that derives from FreeRTOS::StaticCrtpTask has no vtable.  The task
+// entry point calls MyTask::taskFunction() directly.
+class MyTask : public FreeRTOS::StaticCrtpTask<MyTask> {
+ public:
+  MyTask(const UBaseType_t priority, const char* name)
+      : FreeRTOS::StaticCrtpTask<MyTask>(priority, name) {}
+  void taskFunction();
+};
+
+// Task to be created.
+void MyTask::taskFunction() {
+  for (;;) {
+    // Task code goes here.
+    delay(pdMS_TO_TICKS(100));
+  }
+}
+
+// Create the task in persistent storage.
+static MyTask task((tskIDLE_PRIORITY + 1), "NAME");
+
+// Function that starts the scheduler.
+void aFunction() {
+  // Sanity check: no vtable pointer is stored in the object.
+  static_assert(!std::is_polymorphic_v<MyTask>);
+
+  // Start the scheduler.
+  FreeRTOS::Kernel::startScheduler();
+}
@@ -0,0 +1,25 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Task.hpp>
+
+class MyTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+// Perform an action every 10 ticks.  The wake time is a local variable, so
+// this works when FREERTOS_CPP_COMPACT is 1 and the task object does not
+// store one.
+void MyTask::taskFunction() {
+  const TickType_t xFrequency = 10;
+
+  // Initialise the wake time with the current time.
+  TickType_t lastWakeTime = FreeRTOS::Kernel::getTickCount();
+
+  for (;;) {
+    // Wait for the next cycle.
+    auto wasDelayed = delayUntil(lastWakeTime, xFrequency);
+
+    // Perform action here. wasDelayed value can be used to determine whether a
+    // deadline was missed if the code here took too long.
+  }
+}
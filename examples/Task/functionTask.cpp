@@ -0,0 +1,31 @@
+#include <FreeRTOS/Task.hpp>
+
+// A task whose body is a lambda.  The lambda is given a reference to the task
+// so that it can call delayUntil().
+static FreeRTOS::StaticFunctionTask blinkTask(
+    [](auto& task) {
+      for (;;) {
+        // Toggle an LED here.
+        task.delayUntil(pdMS_TO_TICKS(500));
+      }
+    },
+    (tskIDLE_PRIORITY + 1), "Blink");
+
+// A lambda that does not need access to the task takes no arguments.
+static auto workerBody = []() {
+  for (;;) {
+    // Task code goes here.
+  }
+};
+
+// Function that starts the scheduler.
+void aFunction() {
+  // Create a task with dynamically allocated memory.
+  static FreeRTOS::FunctionTask workerTask(workerBody, tskIDLE_PRIORITY,
+                                           configMINIMAL_STACK_SIZE, "Worker");
+
+  if (workerTask.isValid()) {
+    // Start the scheduler.
+    FreeRTOS::Kernel::startScheduler();
+  }
+}
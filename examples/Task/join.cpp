@@ -0,0 +1,54 @@
+// join() is only available when FREERTOS_CPP_TASK_JOIN is 1.  It is normally
+// set in FreeRTOSConfig.h so that every translation unit agrees.
+#define FREERTOS_CPP_TASK_JOIN 1
+
+#include <FreeRTOS/Task.hpp>
+
+// A worker that processes one half of a buffer and then returns.
+class Worker : public FreeRTOS::Task {
+ public:
+  Worker(uint32_t* data, const size_t length)
+      : FreeRTOS::Task(tskIDLE_PRIORITY + 1, configMINIMAL_STACK_SIZE,
+                       "Worker"),
+        data(data),
+        length(length) {}
+
+  void taskFunction() final {
+    for (size_t i = 0; i < length; i++) {
+      data[i] *= 2;
+    }
+    // Returning ends the task.  join() in other tasks returns true.
+  }
+
+ private:
+  uint32_t* data;
+  size_t length;
+};
+
+class Coordinator : public FreeRTOS::StaticTask<256> {
+ public:
+  Coordinator() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 2, "Main") {}
+
+  void taskFunction() final {
+    static uint32_t data[128] = {};
+
+    for (;;) {
+      // Fork: process both halves of the buffer in parallel.
+      Worker first(data, 64);
+      Worker second(data + 64, 64);
+
+      // Join: block until both workers have returned.  The workers are deleted
+      // by their destructors when they go out of scope.
+      const bool bothFinished = first.join() && second.join();
+      configASSERT(bothFinished);
+
+      delay(pdMS_TO_TICKS(100));
+    }
+  }
+};
+
+static Coordinator coordinator;
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
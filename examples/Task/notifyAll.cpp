@@ -0,0 +1,34 @@
+#include <FreeRTOS/Task.hpp>
+
+class Worker : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+void Worker::taskFunction() {
+  for (;;) {
+    // Wait for the start of the next frame.
+    notifyTake(portMAX_DELAY);
+    // ...
+  }
+}
+
+Worker audio;
+Worker video;
+Worker network;
+
+const FreeRTOS::TaskBase* const workers[] = {&audio, &video, &network};
+
+void aFunction() {
+  // Start all three workers on the same frame.  None of them runs until every
+  // one has been notified.
+  FreeRTOS::Task::notifyAll(workers, 3,
+                            FreeRTOS::Task::NotifyAction::Increment);
+}
+
+extern "C" void TIM2_IRQHandler(void) {
+  bool higherPriorityTaskWoken = false;
+  FreeRTOS::Task::notifyAllFromISR(higherPriorityTaskWoken, workers, 3,
+                                   FreeRTOS::Task::NotifyAction::Increment);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
@@ -0,0 +1,50 @@
+#include <FreeRTOS/Task.hpp>
+#include <FreeRTOS/TaskLocal.hpp>
+
+// Give every kind of task local data its own slot.
+enum TaskLocalSlot : BaseType_t {
+  ConnectionSlot = 0,
+};
+
+struct Connection {
+  uint32_t id;
+  uint32_t bytesSent;
+};
+
+using CurrentConnection = FreeRTOS::TaskLocal<Connection, ConnectionSlot>;
+
+// Code that is shared by several tasks finds the connection of the calling
+// task without a lookup table or a lock.
+void send(const uint8_t* data, size_t length) {
+  CurrentConnection connection;
+  connection->bytesSent += length;
+  // Send data on connection->id here.
+  static_cast<void>(data);
+}
+
+class ConnectionTask : public FreeRTOS::StaticTask<256> {
+ public:
+  explicit ConnectionTask(const uint32_t id)
+      : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 1, "Connection"),
+        connection{id, 0} {}
+
+  void taskFunction() final {
+    CurrentConnection::set(&connection);
+
+    for (;;) {
+      const uint8_t data[] = {1, 2, 3};
+      send(data, sizeof(data));
+      delay(pdMS_TO_TICKS(100));
+    }
+  }
+
+ private:
+  Connection connection;
+};
+
+static ConnectionTask first(1);
+static ConnectionTask second(2);
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
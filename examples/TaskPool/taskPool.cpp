@@ -0,0 +1,38 @@
+#include <FreeRTOS/Task.hpp>
+#include <FreeRTOS/TaskPool.hpp>
+
+// Up to four connections are served at the same time, each by its own task
+// with a 512 word stack.  None of them touches the heap.
+static FreeRTOS::TaskPool<512, 4> connectionTasks;
+
+int acceptConnection();
+void closeConnection(int socket);
+
+static void serveConnection(void* parameter) {
+  const int socket = static_cast<int>(reinterpret_cast<intptr_t>(parameter));
+  // Handle requests until the peer closes the connection.
+  // ...
+  closeConnection(socket);
+  // Returning finishes the task and frees its slot for the next connection.
+}
+
+class ListenerTask : public FreeRTOS::StaticTask<256> {
+ public:
+  ListenerTask() : FreeRTOS::StaticTask<256>(3, "Listener") {}
+
+  void taskFunction() final {
+    for (;;) {
+      const int socket = acceptConnection();
+      void* parameter = reinterpret_cast<void*>(static_cast<intptr_t>(socket));
+
+      if (connectionTasks.spawn(serveConnection, parameter, 2, "Conn") ==
+          NULL) {
+        // Every slot holds a connection that is still open, so refuse this
+        // one.
+        closeConnection(socket);
+      }
+    }
+  }
+};
+
+static ListenerTask listener;
@@ -0,0 +1,68 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/TaskSet.hpp>
+
+// The timing of the periodic tasks, in ticks, taken from the design rather
+// than measured.  The motor loop must finish within 1 ms of its release even
+// though it runs every 2 ms.
+using Tasks = FreeRTOS::TaskSet<FreeRTOS::TaskTiming<2, 1, 1>,   // Motor
+                                FreeRTOS::TaskTiming<10, 2>,     // Sensors
+                                FreeRTOS::TaskTiming<100, 20>>;  // Logger
+
+// The build fails if a change to a period or a budget makes any task miss its
+// deadline.
+static_assert(Tasks::isSchedulable(), "The periodic tasks miss deadlines.");
+static_assert(Tasks::utilization() <= 900, "Leave 10% for interrupts.");
+static_assert(Tasks::responseTime(1) <= 5, "Sensor data is too old.");
+
+class MotorTask : public Tasks::Task<0, 256> {
+ public:
+  MotorTask() : Tasks::Task<0, 256>("Motor") {}
+
+ protected:
+  void cycle() final {
+    // Update the motor outputs here.
+  }
+};
+
+class SensorTask : public Tasks::Task<1, 256> {
+ public:
+  SensorTask() : Tasks::Task<1, 256>("Sensors") {}
+
+ protected:
+  void cycle() final {
+    // Read the sensors here.
+  }
+};
+
+static MotorTask motorTask;
+static SensorTask sensorTask;
+
+class LoggerTask : public Tasks::Task<2, 512> {
+ public:
+  LoggerTask() : Tasks::Task<2, 512>("Logger") {}
+
+ protected:
+  void cycle() final {
+    // Check the budgets against the measured execution times, which include
+    // any time the tasks were preempted and so are pessimistic.
+    const TickType_t measured[Tasks::size] = {
+        motorTask.getStatistics().maxExecution,
+        sensorTask.getStatistics().maxExecution,
+        getStatistics().maxExecution,
+    };
+    if (!Tasks::isSchedulable(measured) ||
+        (motorTask.getStatistics().budgetOverruns > 0)) {
+      // Report that the timing analysis no longer holds.
+    }
+  }
+};
+
+static LoggerTask loggerTask;
+
+void aFunction() {
+  // The motor task runs at tskIDLE_PRIORITY + 3, the sensor task at
+  // tskIDLE_PRIORITY + 2 and the logger at tskIDLE_PRIORITY + 1.
+  static_assert(Tasks::rank(0) == 2, "The motor task has the highest rank.");
+
+  FreeRTOS::Kernel::startScheduler();
+}
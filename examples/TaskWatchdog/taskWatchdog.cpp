@@ -0,0 +1,53 @@
+#include <FreeRTOS/Task.hpp>
+#include <FreeRTOS/TaskWatchdog.hpp>
+
+void kickHardwareWatchdog() {
+  // Reload the hardware watchdog here, for example by writing the reload key
+  // to its key register.
+}
+
+void reportStall(size_t id, TaskHandle_t task, TickType_t elapsed) {
+  // Log the name of the task before the hardware watchdog resets the system.
+  const char* name = pcTaskGetName(task);
+  // ...
+}
+
+// Scan every 100 ms, well within a hardware watchdog timeout of 500 ms.
+FreeRTOS::TaskWatchdog<4> watchdog(pdMS_TO_TICKS(100), kickHardwareWatchdog,
+                                   reportStall);
+
+class ControlTask : public FreeRTOS::Task {
+ public:
+  ControlTask() : FreeRTOS::Task(3, configMINIMAL_STACK_SIZE, "Control") {}
+
+  void taskFunction() final {
+    // The control loop runs at 1 kHz and must never miss more than 10 ms.
+    const auto id = watchdog.add(pdMS_TO_TICKS(10));
+
+    for (;;) {
+      delayUntil(pdMS_TO_TICKS(1));
+      // ...
+      watchdog.checkIn(id);
+    }
+  }
+};
+
+class CommsTask : public FreeRTOS::Task {
+ public:
+  CommsTask() : FreeRTOS::Task(2, configMINIMAL_STACK_SIZE, "Comms") {}
+
+  void taskFunction() final {
+    const auto id = watchdog.add(pdMS_TO_TICKS(250));
+
+    for (;;) {
+      // Waiting for a message may take up to 200 ms.
+      notifyTake(pdMS_TO_TICKS(200));
+      // ...
+      watchdog.checkIn(id);
+    }
+  }
+};
+
+void startWatchdog() {
+  watchdog.start();
+}
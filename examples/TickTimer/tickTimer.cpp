@@ -0,0 +1,38 @@
+#include <FreeRTOS/EventGroups.hpp>
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/TickTimer.hpp>
+
+#if (configUSE_TICK_HOOK == 1)
+
+#define GPIOA_ODR (*reinterpret_cast<volatile uint32_t*>(0x48000014))
+
+static FreeRTOS::StaticEventGroup events;
+
+// Toggle the heartbeat LED every 250 ms without waking the timer service task.
+static void heartbeat(void*, bool&) noexcept {
+  GPIOA_ODR ^= (1 << 5);
+}
+
+// Tell the logger task that it is time to flush, 10 ms after the last write.
+static void flush(void*, bool& higherPriorityTaskWoken) noexcept {
+  events.setFromISR(higherPriorityTaskWoken, 0x01);
+}
+
+static FreeRTOS::TickTimer heartbeatTimer(heartbeat, nullptr,
+                                          pdMS_TO_TICKS(250), true);
+static FreeRTOS::TickTimer flushTimer(flush, nullptr, pdMS_TO_TICKS(10));
+
+extern "C" void vApplicationTickHook(void) {
+  FreeRTOS::TickTimer::tickHook();
+}
+
+void logWritten() {
+  flushTimer.reset();
+}
+
+void aFunction() {
+  heartbeatTimer.start();
+  FreeRTOS::Kernel::startScheduler();
+}
+
+#endif /* configUSE_TICK_HOOK */
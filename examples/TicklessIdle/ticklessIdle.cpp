@@ -0,0 +1,54 @@
+#include <FreeRTOS/TicklessIdle.hpp>
+
+// FreeRTOSConfig.h contains:
+//   #define configUSE_TICKLESS_IDLE 2
+//   #define portSUPPRESS_TICKS_AND_SLEEP(x) applicationSleep(x)
+#if (configUSE_TICKLESS_IDLE == 2)
+
+enum class PowerMode { Sleep, Stop, Standby };
+
+// Platform specific steps, here for a device with a low power timer that keeps
+// counting in every mode.
+struct Platform {
+  static void disableInterrupts() {
+    // __disable_irq();
+  }
+  static void enableInterrupts() {
+    // __enable_irq();
+  }
+  static void stopTick() {
+    // Stop SysTick.
+  }
+  static void startTick() {
+    // Reload and restart SysTick.
+  }
+  static void setWakeUp(const TickType_t ticks) {
+    // Start the low power timer to interrupt after ticks tick periods.
+    static_cast<void>(ticks);
+  }
+  static TickType_t cancelWakeUp() {
+    // Stop the low power timer and convert its count to tick periods.
+    return 0;
+  }
+  static void enter(const PowerMode mode) {
+    // Configure the power controller for mode, then __WFI().
+    static_cast<void>(mode);
+  }
+};
+
+using Idle = FreeRTOS::TicklessIdle<Platform, PowerMode>;
+
+// Ordered from the lightest to the deepest mode.  The latencies are in ticks.
+static const Idle::SleepMode modes[] = {
+    {PowerMode::Sleep, 0, 0},
+    {PowerMode::Stop, 1, 2},
+    {PowerMode::Standby, 5, 20},
+};
+
+static Idle idle(modes);
+
+extern "C" void applicationSleep(const TickType_t expectedIdleTime) {
+  idle.sleep(expectedIdleTime);
+}
+
+#endif /* configUSE_TICKLESS_IDLE == 2 */
@@ -0,0 +1,41 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Timer.hpp>
+
+// A timer that derives from FreeRTOS::StaticCrtpTimer has no vtable.  The timer
+// callback calls MyTimer::timerFunction() directly.
+class MyTimer : public FreeRTOS::StaticCrtpTimer<MyTimer> {
+ public:
+  MyTimer() : FreeRTOS::StaticCrtpTimer<MyTimer>(pdMS_TO_TICKS(100), true) {}
+  void timerFunction();
+
+ private:
+  uint8_t count = 0;
+};
+
+// Stop the timer once it has expired 10 times.
+void MyTimer::timerFunction() {
+  constexpr uint8_t maxExpiryCountBeforeStopping = 10;
+
+  if (++count >= maxExpiryCountBeforeStopping) {
+    // Do not use a block time if calling a timer API function from a timer
+    // callback function, as doing so could cause a deadlock!
+    stop();
+  }
+}
+
+static MyTimer timer;
+
+void aFunction() {
+  // Start the timer before the scheduler so it runs as soon as the scheduler
+  // starts.
+  if (timer.isValid()) {
+    timer.start();
+  }
+
+  FreeRTOS::Kernel::startScheduler();
+
+  // Should not reach here.
+  for (;;) {
+    ;
+  }
+}
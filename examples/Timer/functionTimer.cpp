@@ -0,0 +1,33 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Timer.hpp>
+
+// A one-shot timer whose callback is a lambda.  The lambda takes no arguments
+// as it does not need access to the timer.
+static FreeRTOS::StaticFunctionTimer backlightTimer(
+    []() {
+      // Turn the backlight off here.
+    },
+    pdMS_TO_TICKS(5000), false, "Backlight");
+
+// An auto-reload timer whose callback is given a reference to the timer so
+// that it can stop itself.
+static FreeRTOS::StaticFunctionTimer heartbeatTimer(
+    [count = 0](auto& timer) mutable {
+      // Toggle a heartbeat LED here.
+      if (++count >= 100) {
+        timer.stop();
+      }
+    },
+    pdMS_TO_TICKS(500), true, "Heartbeat");
+
+void aFunction() {
+  backlightTimer.start();
+  heartbeatTimer.start();
+
+  FreeRTOS::Kernel::startScheduler();
+
+  // Should not reach here.
+  for (;;) {
+    ;
+  }
+}
@@ -0,0 +1,38 @@
+// Timers only accept a slack when FREERTOS_CPP_TIMER_SLACK is 1.  It is
+// normally set in FreeRTOSConfig.h so that every translation unit agrees.
+#define FREERTOS_CPP_TIMER_SLACK 1
+
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Timer.hpp>
+
+class LedTimer : public FreeRTOS::StaticTimer {
+ public:
+  LedTimer() : FreeRTOS::StaticTimer(pdMS_TO_TICKS(500), true, "Led") {}
+  void timerFunction() final {
+    // Toggle the heartbeat LED here.
+  }
+};
+
+class SensorTimer : public FreeRTOS::StaticTimer {
+ public:
+  SensorTimer() : FreeRTOS::StaticTimer(pdMS_TO_TICKS(300), true, "Sensor") {}
+  void timerFunction() final {
+    // Sample the temperature sensor here.
+  }
+};
+
+static LedTimer ledTimer;
+static SensorTimer sensorTimer;
+
+void aFunction() {
+  // Neither timer needs to be accurate, so allow each to be up to 64 ticks
+  // late.  Both now expire on multiples of 64 ticks and the timer service task
+  // wakes up once for both whenever their expiry times line up.
+  ledTimer.setSlack(64);
+  sensorTimer.setSlack(64);
+
+  ledTimer.start();
+  sensorTimer.start();
+
+  FreeRTOS::Kernel::startScheduler();
+}
@@ -0,0 +1,48 @@
+// Timers only record statistics when FREERTOS_CPP_TIMER_STATISTICS is 1.  It is
+// normally set in FreeRTOSConfig.h so that every translation unit agrees.
+#define FREERTOS_CPP_TIMER_STATISTICS 1
+
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <FreeRTOS/Timer.hpp>
+
+class ControlTimer : public FreeRTOS::StaticTimer {
+ public:
+  ControlTimer() : FreeRTOS::StaticTimer(pdMS_TO_TICKS(5), true, "Control") {}
+  void timerFunction() final {
+    // Run the control step here.
+  }
+};
+
+static ControlTimer controlTimer;
+
+class Monitor : public FreeRTOS::StaticTask<256> {
+ public:
+  Monitor() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 1, "Monitor") {}
+
+  void taskFunction() final {
+    for (;;) {
+      delay(pdMS_TO_TICKS(1000));
+
+      const FreeRTOS::TimerStatistics statistics =
+          controlTimer.getStatistics();
+      if (statistics.maxLateness > 1) {
+        // The timer service task is not keeping up.  Either its priority is
+        // too low or other timer callbacks take too long.
+      }
+      if (statistics.dispatches > 0) {
+        const uint32_t averageExecution =
+            statistics.totalExecution / statistics.dispatches;
+        static_cast<void>(averageExecution);
+      }
+      controlTimer.resetStatistics();
+    }
+  }
+};
+
+static Monitor monitor;
+
+void aFunction() {
+  controlTimer.start();
+  FreeRTOS::Kernel::startScheduler();
+}
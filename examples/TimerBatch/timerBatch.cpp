@@ -0,0 +1,40 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Timer.hpp>
+#include <FreeRTOS/TimerBatch.hpp>
+
+class SampleTimer : public FreeRTOS::StaticTimer {
+ public:
+  explicit SampleTimer(const TickType_t period)
+      : FreeRTOS::StaticTimer(period, true, "Sample") {}
+  void timerFunction() final {
+    // Sample a sensor here.
+  }
+};
+
+static SampleTimer fastSensor(pdMS_TO_TICKS(10));
+static SampleTimer slowSensor(pdMS_TO_TICKS(100));
+static SampleTimer statusLed(pdMS_TO_TICKS(500));
+
+// Switch every timer to low power mode with one command to the timer service
+// task.  No timer callback runs between the individual changes.
+void enterLowPowerMode() {
+  static FreeRTOS::TimerBatch<3> batch;
+
+  if (!batch.isPending()) {
+    batch.clear();
+    batch.changePeriod(fastSensor, pdMS_TO_TICKS(1000));
+    batch.changePeriod(slowSensor, pdMS_TO_TICKS(5000));
+    batch.stop(statusLed);
+    if (!batch.apply(pdMS_TO_TICKS(10))) {
+      // The timer command queue stayed full.
+    }
+  }
+}
+
+void aFunction() {
+  fastSensor.start();
+  slowSensor.start();
+  statusLed.start();
+
+  FreeRTOS::Kernel::startScheduler();
+}
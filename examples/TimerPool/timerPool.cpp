@@ -0,0 +1,38 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <FreeRTOS/TimerPool.hpp>
+
+static FreeRTOS::StaticTimerPool<8> timeouts("Timeout");
+
+class Requester : public FreeRTOS::StaticTask<256> {
+ public:
+  Requester() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 1, "Requester") {}
+
+  void taskFunction() final {
+    for (;;) {
+      timedOut = false;
+
+      // The lambda is stored inside the pool, so no heap is used.
+      auto timeout = timeouts.acquire([this] { timedOut = true; });
+      if (timeout.isValid()) {
+        timeout.start(pdMS_TO_TICKS(50));
+
+        // Send the request and wait for the reply here.
+
+        timeout.stop();
+      }
+      // The timer goes back to the pool when timeout goes out of scope.
+
+      delay(pdMS_TO_TICKS(100));
+    }
+  }
+
+ private:
+  volatile bool timedOut = false;
+};
+
+static Requester requester;
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
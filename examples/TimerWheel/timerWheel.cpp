@@ -0,0 +1,41 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/TimerWheel.hpp>
+
+// One kernel timer drives every protocol timeout, with a resolution of 10 ms.
+static FreeRTOS::TimerWheel<> wheel(pdMS_TO_TICKS(10));
+
+struct Session {
+  uint32_t id;
+  FreeRTOS::WheelTimer keepalive;
+
+  explicit Session(const uint32_t id)
+      : id(id), keepalive(keepaliveExpired, this) {}
+
+  static void keepaliveExpired(void* argument) {
+    Session* session = static_cast<Session*>(argument);
+    // The peer has been silent for too long, close the session here.
+    static_cast<void>(session);
+  }
+};
+
+static Session sessions[] = {Session(1), Session(2), Session(3)};
+
+// Called for every packet received on a session.  Re-arming a WheelTimer does
+// not use the timer command queue, so this can run at any packet rate.
+void packetReceived(Session& session) {
+  wheel.arm(session.keepalive, pdMS_TO_TICKS(30000));
+}
+
+void sessionClosed(Session& session) {
+  wheel.cancel(session.keepalive);
+}
+
+void aFunction() {
+  for (auto& session : sessions) {
+    packetReceived(session);
+  }
+
+  wheel.start();
+
+  FreeRTOS::Kernel::startScheduler();
+}
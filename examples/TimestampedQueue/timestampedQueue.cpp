@@ -0,0 +1,70 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <FreeRTOS/TimestampedQueue.hpp>
+#include <cstdint>
+#include <initializer_list>
+
+struct Frame {
+  uint16_t id;
+  uint8_t data[8];
+};
+
+// Frames go from the receive interrupt to the decoder, and from the decoder to
+// the logger.  Each hop records how long the frames waited.
+static FreeRTOS::TimestampedQueue<Frame, 16> received;
+static FreeRTOS::TimestampedQueue<Frame, 8> decoded;
+
+extern "C" void CAN1_RX0_IRQHandler(void) {
+  bool higherPriorityTaskWoken = false;
+  Frame frame = {};
+  // Read the frame from the controller here.
+  received.sendToBackFromISR(higherPriorityTaskWoken, frame);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+class Decoder : public FreeRTOS::StaticTask<256> {
+ public:
+  Decoder() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 2, "Decoder") {}
+
+  void taskFunction() final {
+    Frame frame;
+    for (;;) {
+      if (received.receive(frame)) {
+        // Decode the frame here.
+        decoded.sendToBack(frame);
+      }
+    }
+  }
+};
+
+class Logger : public FreeRTOS::StaticTask<512> {
+ public:
+  Logger() : FreeRTOS::StaticTask<512>(tskIDLE_PRIORITY + 1, "Logger") {}
+
+  void taskFunction() final {
+    for (;;) {
+      if (auto frame = decoded.receive(pdMS_TO_TICKS(1000))) {
+        // Write the frame to the log here.
+        continue;
+      }
+
+      // Once a second of silence, report where the frames waited.  A high
+      // maxLatency on decoded means the logger is the bottleneck.
+      for (const FreeRTOS::QueueLatencyStatistics& hop :
+           {received.getStatistics(), decoded.getStatistics()}) {
+        if (hop.items > 0) {
+          // Print hop.totalLatency / hop.items and hop.histogram here.
+        }
+      }
+      received.resetStatistics();
+      decoded.resetStatistics();
+    }
+  }
+};
+
+static Decoder decoder;
+static Logger logger;
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
@@ -0,0 +1,56 @@
+#include <FreeRTOS/Task.hpp>
+#include <FreeRTOS/Topic.hpp>
+
+struct ImuSample {
+  int16_t acceleration[3];
+  int16_t rotation[3];
+  uint32_t timestamp;
+};
+
+// Up to 4 subscribers, 8 samples in flight, 4 queued per subscriber.
+static FreeRTOS::Topic<ImuSample, 4, 8, 4> imu;
+
+class Consumer : public FreeRTOS::StaticTask<256> {
+ public:
+  Consumer(const UBaseType_t priority, const char* name,
+           const FreeRTOS::TopicPolicy policy)
+      : FreeRTOS::StaticTask<256>(priority, name),
+        subscription(imu.subscribe(policy)) {}
+
+  void taskFunction() final {
+    for (;;) {
+      // Every subscriber reads the same copy of the sample.  It returns to the
+      // pool when the last subscriber lets go of it.
+      const auto sample = subscription.receive();
+      if (sample) {
+        static_cast<void>(sample->timestamp);
+      }
+    }
+  }
+
+ private:
+  const FreeRTOS::Topic<ImuSample, 4, 8, 4>::Subscription subscription;
+};
+
+// The attitude filter must see every sample, while the logger may skip some.
+static Consumer filter(tskIDLE_PRIORITY + 3, "Filter",
+                       FreeRTOS::TopicPolicy::Block);
+static Consumer logger(tskIDLE_PRIORITY + 1, "Logger",
+                       FreeRTOS::TopicPolicy::DropOldest);
+
+extern "C" void IMU_IRQHandler(void) {
+  bool higherPriorityTaskWoken = false;
+
+  auto draft = imu.allocateFromISR();
+  if (draft) {
+    // Read the sensor registers into *draft here.
+    draft->timestamp = xTaskGetTickCountFromISR();
+    imu.publishFromISR(higherPriorityTaskWoken, draft);
+  }
+
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
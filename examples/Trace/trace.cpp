@@ -0,0 +1,50 @@
+#include <FreeRTOS/StreamBuffer.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <FreeRTOS/Trace.hpp>
+
+// FreeRTOSConfig.h ends with:
+//
+//   #define FREERTOS_CPP_TRACE_TIMESTAMP() (DWT->CYCCNT)
+//   #include <FreeRTOS/TraceHooks.h>
+//
+// so the kernel records its events through the hooks.
+
+static FreeRTOS::Trace::StaticRecorder<1024> recorder;
+FREERTOS_CPP_DEFINE_TRACE(recorder)
+
+static FreeRTOS::StaticStreamBuffer<512> traceStream;
+
+extern "C" void vUartISR(void) {
+  // Shows as a slice on the interrupts thread of the timeline.
+  FreeRTOS::Trace::IsrScope scope(37);
+
+  // Handle the interrupt here.
+}
+
+void uartWrite(const void* data, size_t length);
+
+class TraceTask : public FreeRTOS::StaticTask<256> {
+ public:
+  TraceTask() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 1, "Trace") {}
+
+  void taskFunction() final {
+    uint8_t chunk[96];
+
+    for (;;) {
+      // Move the recorded events into the stream buffer, then out of the UART.
+      // On the host, run:
+      //   tools/traceDecode.py capture.bin trace.json --frequency 168000000
+      recorder.drain(traceStream);
+      size_t length = traceStream.receive(chunk, sizeof(chunk), 10);
+      if (length > 0) {
+        uartWrite(chunk, length);
+      }
+
+      if (recorder.getDropped() > 0) {
+        // Drain more often or use a larger recorder.
+      }
+    }
+  }
+};
+
+static TraceTask traceTask;
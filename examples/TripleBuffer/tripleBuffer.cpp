@@ -0,0 +1,44 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <FreeRTOS/TripleBuffer.hpp>
+
+struct Frame {
+  uint32_t sequence;
+  uint16_t samples[2046];
+};
+
+static FreeRTOS::TripleBuffer<Frame> frames;
+
+// The DMA writes straight into the back buffer, so a frame is never copied.
+extern "C" void DMA_IRQHandler(void) {
+  static uint32_t sequence = 0;
+  bool higherPriorityTaskWoken = false;
+
+  frames.back().sequence = ++sequence;
+  frames.publishFromISR(higherPriorityTaskWoken);
+  // Point the DMA at frames.back().samples for the next frame here.
+
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+class Display : public FreeRTOS::StaticTask<512> {
+ public:
+  Display() : FreeRTOS::StaticTask<512>(tskIDLE_PRIORITY + 1, "Display") {}
+
+  void taskFunction() final {
+    for (;;) {
+      // Frames published while the previous one was being drawn are skipped,
+      // and only the newest one is drawn.
+      if (frames.wait(pdMS_TO_TICKS(100))) {
+        const Frame& frame = frames.front();
+        static_cast<void>(frame.samples[0]);
+      }
+    }
+  }
+};
+
+static Display display;
+
+void aFunction() {
+  FreeRTOS::Kernel::startScheduler();
+}
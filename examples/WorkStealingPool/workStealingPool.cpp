@@ -0,0 +1,42 @@
+#include <FreeRTOS/Kernel.hpp>
+#include <FreeRTOS/WorkStealingPool.hpp>
+
+// One worker per core of a dual core part, with room for 32 jobs each.
+static FreeRTOS::WorkStealingPool<2, 32, 256> pool(tskIDLE_PRIORITY + 2);
+
+static constexpr size_t tileCount = 64;
+static constexpr size_t tileSize = 1024;
+static uint8_t tiles[tileCount][tileSize];
+
+static void compressTile(const size_t tile) {
+  // Compress tiles[tile] here.
+  static_cast<void>(tiles[tile]);
+}
+
+// Splits the range in two until it is a single tile.  The half that is queued
+// stays on this worker's deque unless the other worker is idle and steals it.
+struct Split {
+  size_t first;
+  size_t last;
+
+  void operator()() const {
+    size_t begin = first;
+    size_t end = last;
+    while ((end - begin) > 1) {
+      const size_t middle = begin + ((end - begin) / 2);
+      if (!pool.submit(Split{middle, end}, 0)) {
+        Split{middle, end}();
+      }
+      end = middle;
+    }
+    compressTile(begin);
+  }
+};
+
+void aFunction() {
+  // The first job goes to a worker's inbox.  Every job it spawns is pushed on
+  // the worker's own deque without a kernel call.
+  pool.submit(Split{0, tileCount});
+
+  FreeRTOS::Kernel::startScheduler();
+}
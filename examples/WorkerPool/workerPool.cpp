@@ -0,0 +1,44 @@
+#include <FreeRTOS/Task.hpp>
+#include <FreeRTOS/WorkerPool.hpp>
+
+// Two workers sharing a queue of up to 8 jobs.
+static FreeRTOS::WorkerPool<2, 8, 256> workerPool(3);
+
+static uint8_t frame[64];
+
+void processFrame(uint8_t* data, size_t length) {
+  // ... Parse a received frame.
+}
+
+// A receive complete interrupt hands the frame off to a worker.
+void receiveCompleteISR() {
+  bool higherPriorityTaskWoken = false;
+
+  workerPool.submitFromISR(higherPriorityTaskWoken,
+                           [] { processFrame(frame, sizeof(frame)); });
+
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
+
+class MyTask : public FreeRTOS::Task {
+ public:
+  void taskFunction() final;
+};
+
+void MyTask::taskFunction() {
+  uint32_t checksum = 0;
+
+  // Run a job and wait for it to finish.  The worker notifies this task once
+  // the job has run.
+  uint32_t* result = &checksum;
+  workerPool.submit(
+      [result] {
+        *result = 0;  // ... Compute the checksum.
+      },
+      portMAX_DELAY, this);
+  notifyTake(portMAX_DELAY);
+
+  for (;;) {
+    delay(portMAX_DELAY);
+  }
+}
@@ -0,0 +1,60 @@
+#include <FreeRTOS/NotifySemaphore.hpp>
+#include <FreeRTOS/Task.hpp>
+#include <FreeRTOS/ZeroCopyStreamBuffer.hpp>
+#include <cstdio>
+
+// Fake peripheral interface function.
+void startUartDma(const uint8_t* data, size_t length) {
+  (void)data;
+  (void)length;
+}
+
+// Log text is formatted straight into the ring and sent to the UART by DMA
+// straight out of it, so no byte is copied.  The UART task is only woken once
+// 32 bytes are waiting.
+static FreeRTOS::StaticZeroCopyStreamBuffer<1024, 1> logStream(32);
+
+void log(const char* message, const int value) {
+  auto region = logStream.acquireWrite(64, 0);
+  if (region.size == 0) {
+    return;  // The log is full, so drop the message.
+  }
+  const int length = std::snprintf(reinterpret_cast<char*>(region.data),
+                                   region.size, "%s %d\n", message, value);
+  if (length > 0) {
+    const size_t written = static_cast<size_t>(length);
+    logStream.commitWrite((written < region.size) ? written : region.size - 1);
+  }
+}
+
+class UartTask : public FreeRTOS::StaticTask<256> {
+ public:
+  UartTask() : FreeRTOS::StaticTask<256>(tskIDLE_PRIORITY + 1, "UART") {}
+
+  FreeRTOS::NotifySemaphore<2> dmaDone{*this};
+
+  void taskFunction() final {
+    for (;;) {
+      // Flush whatever is there after 100 ms, even below the trigger level.
+      const auto stored = logStream.acquireRead(pdMS_TO_TICKS(100));
+      if (stored.first.size == 0) {
+        continue;
+      }
+
+      // Only the first region is sent each time.  Any bytes that wrapped
+      // around the end of the ring are in the second region, and are sent next
+      // time round.
+      startUartDma(stored.first.data, stored.first.size);
+      dmaDone.take();
+      logStream.commitRead(stored.first.size);
+    }
+  }
+};
+
+static UartTask uartTask;
+
+extern "C" void vUartDmaCompleteHandler(void) {
+  bool higherPriorityTaskWoken = false;
+  uartTask.dmaDone.giveFromISR(higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken ? pdTRUE : pdFALSE);
+}
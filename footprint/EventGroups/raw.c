@@ -0,0 +1,25 @@
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "event_groups.h"
+
+static StaticEventGroup_t eventGroupBuffer;
+static EventGroupHandle_t eventGroup;
+
+bool eventGroupCreate(void) {
+  eventGroup = xEventGroupCreateStatic(&eventGroupBuffer);
+  return (eventGroup != NULL);
+}
+
+EventBits_t eventGroupSet(const EventBits_t bits) {
+  return xEventGroupSetBits(eventGroup, bits);
+}
+
+EventBits_t eventGroupClear(const EventBits_t bits) {
+  return xEventGroupClearBits(eventGroup, bits);
+}
+
+EventBits_t eventGroupWait(const EventBits_t bits,
+                           const TickType_t ticksToWait) {
+  return xEventGroupWaitBits(eventGroup, bits, pdTRUE, pdFALSE, ticksToWait);
+}
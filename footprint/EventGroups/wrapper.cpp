@@ -0,0 +1,24 @@
+#include <FreeRTOS/EventGroups.hpp>
+
+using EventBits = FreeRTOS::EventGroupBase::EventBits;
+
+static FreeRTOS::StaticEventGroup eventGroup(FreeRTOS::deferCreate);
+
+extern "C" bool eventGroupCreate(void) {
+  return eventGroup.create();
+}
+
+extern "C" EventBits_t eventGroupSet(const EventBits_t bits) {
+  return eventGroup.set(EventBits(bits)).to_ulong();
+}
+
+extern "C" EventBits_t eventGroupClear(const EventBits_t bits) {
+  return eventGroup.clear(EventBits(bits)).to_ulong();
+}
+
+extern "C" EventBits_t eventGroupWait(const EventBits_t bits,
+                                      const TickType_t ticksToWait) {
+  return eventGroup
+      .wait(EventBits(bits), true, false, ticksToWait)
+      .to_ulong();
+}
@@ -0,0 +1,20 @@
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+static StaticSemaphore_t mutexBuffer;
+static SemaphoreHandle_t mutex;
+
+bool mutexCreate(void) {
+  mutex = xSemaphoreCreateMutexStatic(&mutexBuffer);
+  return (mutex != NULL);
+}
+
+bool mutexLock(const TickType_t ticksToWait) {
+  return (xSemaphoreTake(mutex, ticksToWait) == pdTRUE);
+}
+
+bool mutexUnlock(void) {
+  return (xSemaphoreGive(mutex) == pdTRUE);
+}
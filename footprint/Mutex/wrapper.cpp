@@ -0,0 +1,15 @@
+#include <FreeRTOS/Mutex.hpp>
+
+static FreeRTOS::StaticMutex mutex(FreeRTOS::deferCreate);
+
+extern "C" bool mutexCreate(void) {
+  return mutex.create();
+}
+
+extern "C" bool mutexLock(const TickType_t ticksToWait) {
+  return mutex.lock(ticksToWait);
+}
+
+extern "C" bool mutexUnlock(void) {
+  return mutex.unlock();
+}
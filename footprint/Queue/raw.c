@@ -0,0 +1,30 @@
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+static StaticQueue_t queueBuffer;
+static uint8_t queueStorage[4 * sizeof(uint32_t)];
+static QueueHandle_t queue;
+
+bool queueCreate(void) {
+  queue = xQueueCreateStatic(4, sizeof(uint32_t), queueStorage, &queueBuffer);
+  return (queue != NULL);
+}
+
+bool queueSend(const uint32_t value) {
+  return (xQueueSendToBack(queue, &value, 0) == pdPASS);
+}
+
+bool queueReceive(uint32_t* value) {
+  return (xQueueReceive(queue, value, 0) == pdPASS);
+}
+
+uint32_t queueReceiveOptional(void) {
+  uint32_t value = 0;
+  return (xQueueReceive(queue, &value, 0) == pdPASS) ? value : 0;
+}
+
+UBaseType_t queueMessagesWaiting(void) {
+  return uxQueueMessagesWaiting(queue);
+}
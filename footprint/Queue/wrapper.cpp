@@ -0,0 +1,23 @@
+#include <FreeRTOS/Queue.hpp>
+
+static FreeRTOS::StaticQueue<uint32_t, 4> queue(FreeRTOS::deferCreate);
+
+extern "C" bool queueCreate(void) {
+  return queue.create();
+}
+
+extern "C" bool queueSend(const uint32_t value) {
+  return queue.sendToBack(value, 0);
+}
+
+extern "C" bool queueReceive(uint32_t* value) {
+  return queue.receive(*value, 0);
+}
+
+extern "C" uint32_t queueReceiveOptional(void) {
+  return queue.receive(0).value_or(0);
+}
+
+extern "C" UBaseType_t queueMessagesWaiting(void) {
+  return queue.messagesWaiting();
+}
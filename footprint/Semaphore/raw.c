@@ -0,0 +1,30 @@
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+static StaticSemaphore_t semaphoreBuffer;
+static SemaphoreHandle_t semaphore;
+
+bool semaphoreCreate(void) {
+  semaphore = xSemaphoreCreateBinaryStatic(&semaphoreBuffer);
+  return (semaphore != NULL);
+}
+
+bool semaphoreGive(void) {
+  return (xSemaphoreGive(semaphore) == pdTRUE);
+}
+
+bool semaphoreTake(const TickType_t ticksToWait) {
+  return (xSemaphoreTake(semaphore, ticksToWait) == pdTRUE);
+}
+
+bool semaphoreGiveFromISR(bool* higherPriorityTaskWoken) {
+  BaseType_t taskWoken = pdFALSE;
+  const bool result =
+      (xSemaphoreGiveFromISR(semaphore, &taskWoken) == pdTRUE);
+  if (taskWoken == pdTRUE) {
+    *higherPriorityTaskWoken = true;
+  }
+  return result;
+}
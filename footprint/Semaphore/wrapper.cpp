@@ -0,0 +1,19 @@
+#include <FreeRTOS/Semaphore.hpp>
+
+static FreeRTOS::StaticBinarySemaphore semaphore(FreeRTOS::deferCreate);
+
+extern "C" bool semaphoreCreate(void) {
+  return semaphore.create();
+}
+
+extern "C" bool semaphoreGive(void) {
+  return semaphore.give();
+}
+
+extern "C" bool semaphoreTake(const TickType_t ticksToWait) {
+  return semaphore.take(ticksToWait);
+}
+
+extern "C" bool semaphoreGiveFromISR(bool* higherPriorityTaskWoken) {
+  return semaphore.giveFromISR(*higherPriorityTaskWoken);
+}
@@ -0,0 +1,27 @@
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "stream_buffer.h"
+
+static StaticStreamBuffer_t streamBufferStruct;
+static uint8_t streamBufferStorage[64];
+static StreamBufferHandle_t streamBuffer;
+
+bool streamBufferCreate(void) {
+  streamBuffer = xStreamBufferCreateStatic(sizeof(streamBufferStorage), 1,
+                                           streamBufferStorage,
+                                           &streamBufferStruct);
+  return (streamBuffer != NULL);
+}
+
+size_t streamBufferSend(const void* data, const size_t length) {
+  return xStreamBufferSend(streamBuffer, data, length, 0);
+}
+
+size_t streamBufferReceive(void* buffer, const size_t length) {
+  return xStreamBufferReceive(streamBuffer, buffer, length, 0);
+}
+
+size_t streamBufferBytesAvailable(void) {
+  return xStreamBufferBytesAvailable(streamBuffer);
+}
@@ -0,0 +1,19 @@
+#include <FreeRTOS/StreamBuffer.hpp>
+
+static FreeRTOS::StaticStreamBuffer<64> streamBuffer(FreeRTOS::deferCreate);
+
+extern "C" bool streamBufferCreate(void) {
+  return streamBuffer.create(1);
+}
+
+extern "C" size_t streamBufferSend(const void* data, const size_t length) {
+  return streamBuffer.send(data, length, 0);
+}
+
+extern "C" size_t streamBufferReceive(void* buffer, const size_t length) {
+  return streamBuffer.receive(buffer, length, 0);
+}
+
+extern "C" size_t streamBufferBytesAvailable(void) {
+  return streamBuffer.bytesAvailable();
+}
@@ -0,0 +1,33 @@
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+extern void work(void);
+
+static StaticTask_t workerBuffer;
+static StackType_t workerStack[configMINIMAL_STACK_SIZE];
+static TaskHandle_t worker;
+
+static void workerFunction(void* parameters) {
+  (void)parameters;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    work();
+  }
+}
+
+bool taskCreate(void) {
+  worker = xTaskCreateStatic(workerFunction, "Worker",
+                             configMINIMAL_STACK_SIZE, NULL,
+                             tskIDLE_PRIORITY + 1, workerStack, &workerBuffer);
+  return (worker != NULL);
+}
+
+void taskNotify(void) {
+  xTaskNotifyGive(worker);
+}
+
+UBaseType_t taskGetPriority(void) {
+  return uxTaskPriorityGet(worker);
+}
@@ -0,0 +1,31 @@
+#include <FreeRTOS/Task.hpp>
+
+extern "C" void work(void);
+
+class Worker : public FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE> {
+ public:
+  Worker()
+      : FreeRTOS::StaticTask<configMINIMAL_STACK_SIZE>(FreeRTOS::deferCreate) {
+  }
+
+  void taskFunction() final {
+    for (;;) {
+      notifyTake(portMAX_DELAY);
+      work();
+    }
+  }
+};
+
+static Worker worker;
+
+extern "C" bool taskCreate(void) {
+  return worker.create(tskIDLE_PRIORITY + 1, "Worker");
+}
+
+extern "C" void taskNotify(void) {
+  worker.notifyGive();
+}
+
+extern "C" UBaseType_t taskGetPriority(void) {
+  return worker.getPriority();
+}
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+#
+# FreeRTOS-Cpp
+# Copyright (C) 2021 Jon Enz. All Rights Reserved.
+#
+# SPDX-License-Identifier: MIT
+#
+# https://github.com/jonenz/FreeRTOS-Cpp
+#
+"""Check benchmark results for wrapper overhead and regressions.
+
+The input is the output of the benchmark runner, either read from a file (for
+example a serial capture from a board) or produced by running benchmark-host.
+Every "<name> (C++)" line is checked against its "<name> (C)" line, so that a
+wrapper that is meant to be a plain inline call fails if it becomes slower
+than the C API.  When a baseline is given, every line is also checked against
+the result recorded in it.  The minimum of each measurement is compared
+because it is the least affected by interrupts and, on the host, by the
+operating system.
+"""
+
+import argparse
+import json
+import re
+import subprocess
+import sys
+
+LINE = re.compile(r"^(?P<name>.+?)\s+min\s+(?P<min>\d+)\s+mean\s+(?P<mean>\d+)"
+                  r"\s+max\s+(?P<max>\d+)\s*$")
+
+
+def parse(text):
+    results = {}
+    for line in text.splitlines():
+        match = LINE.match(line.strip())
+        if match:
+            results[match.group("name")] = int(match.group("min"))
+    return results
+
+
+def exceeds(value, reference, tolerance, slack):
+    return value > (reference * (1.0 + tolerance)) + slack
+
+
+def checkOverhead(results, tolerance, slack):
+    failures = []
+    for name, value in sorted(results.items()):
+        if not name.endswith(" (C++)"):
+            continue
+        operation = name[:-len(" (C++)")]
+        raw = results.get(operation + " (C)")
+        if raw is None:
+            failures.append("%s: no matching C result" % operation)
+        elif exceeds(value, raw, tolerance, slack):
+            failures.append("%s: wrapper %d, C API %d" %
+                            (operation, value, raw))
+    return failures
+
+
+def checkBaseline(results, baseline, tolerance, slack):
+    failures = []
+    for name, reference in sorted(baseline.items()):
+        value = results.get(name)
+        if value is None:
+            failures.append("%s: missing from the results" % name)
+        elif exceeds(value, reference, tolerance, slack):
+            failures.append("%s: %d, baseline %d" % (name, value, reference))
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--input", help="file that holds benchmark output")
+    source.add_argument("--run", help="benchmark executable to run")
+    parser.add_argument("--baseline", help="JSON file of previous results")
+    parser.add_argument("--update-baseline", action="store_true",
+                        help="write the results to --baseline and exit")
+    parser.add_argument("--tolerance", type=float, default=0.10,
+                        help="allowed relative increase (default 0.10)")
+    parser.add_argument("--slack", type=int, default=20,
+                        help="allowed absolute increase, in the units of the "
+                        "results (default 20)")
+    parser.add_argument("--timeout", type=float, default=600.0,
+                        help="seconds to wait for --run (default 600)")
+    args = parser.parse_args()
+
+    if args.run:
+        output = subprocess.run([args.run], check=True, capture_output=True,
+                                text=True, timeout=args.timeout).stdout
+    else:
+        with open(args.input) as capture:
+            output = capture.read()
+    sys.stdout.write(output)
+
+    results = parse(output)
+    if not results:
+        sys.exit("error: no benchmark results found")
+
+    if args.update_baseline:
+        if not args.baseline:
+            sys.exit("error: --update-baseline needs --baseline")
+        with open(args.baseline, "w") as baseline:
+            json.dump(results, baseline, indent=2, sort_keys=True)
+            baseline.write("\n")
+        return
+
+    failures = checkOverhead(results, args.tolerance, args.slack)
+    if args.baseline:
+        with open(args.baseline) as baseline:
+            failures += checkBaseline(results, json.load(baseline),
+                                      args.tolerance, args.slack)
+
+    for failure in failures:
+        print("FAIL " + failure)
+    if failures:
+        sys.exit(1)
+    print("OK %d results" % len(results))
+
+
+if __name__ == "__main__":
+    main()
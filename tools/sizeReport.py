@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+#
+# FreeRTOS-Cpp
+# Copyright (C) 2021 Jon Enz. All Rights Reserved.
+#
+# SPDX-License-Identifier: MIT
+#
+# https://github.com/jonenz/FreeRTOS-Cpp
+#
+"""Report the footprint of each wrapper class against the equivalent C code.
+
+Each class is given as NAME=WRAPPER_OBJECT,C_OBJECT, where both objects define
+the same extern "C" functions, one through FreeRTOS-Cpp and one through the C
+API.  The report lists the .text, .data and .bss difference of the objects,
+the size difference of every function they share, and the symbols that exist
+only in the wrapper object, such as vtables and out of line template code.
+When a baseline is given and exists, the report fails if the difference of any
+section of any class grew.
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+SYMBOL = re.compile(r"^[0-9a-fA-F]+ (?P<size>[0-9a-fA-F]+) \S (?P<name>.+)$")
+
+
+def sections(size, path):
+    output = subprocess.run([size, path], check=True, capture_output=True,
+                            text=True).stdout.splitlines()
+    text, data, bss = output[1].split()[:3]
+    return {"text": int(text), "data": int(data), "bss": int(bss)}
+
+
+def symbols(nm, path):
+    output = subprocess.run([nm, "-S", "-C", "--defined-only", path],
+                            check=True, capture_output=True,
+                            text=True).stdout.splitlines()
+    result = {}
+    for line in output:
+        match = SYMBOL.match(line)
+        if match:
+            result[match.group("name")] = int(match.group("size"), 16)
+    return result
+
+
+def measure(size, nm, wrapper, raw):
+    wrapperSections = sections(size, wrapper)
+    rawSections = sections(size, raw)
+    delta = {name: wrapperSections[name] - rawSections[name]
+             for name in wrapperSections}
+    wrapperSymbols = symbols(nm, wrapper)
+    rawSymbols = symbols(nm, raw)
+    functions = {name: (wrapperSymbols[name], rawSymbols[name])
+                 for name in wrapperSymbols if name in rawSymbols}
+    extra = {name: value for name, value in wrapperSymbols.items()
+             if name not in rawSymbols}
+    return delta, functions, extra
+
+
+def report(name, delta, functions, extra):
+    print("%-20s text %+6d  data %+6d  bss %+6d" %
+          (name, delta["text"], delta["data"], delta["bss"]))
+    for function, (wrapper, raw) in sorted(functions.items()):
+        print("  %-34s %6d  C %6d  %+6d" %
+              (function, wrapper, raw, wrapper - raw))
+    for symbol, value in sorted(extra.items()):
+        print("  only in wrapper: %-40s %6d" % (symbol, value))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("classes", nargs="+",
+                        help="NAME=WRAPPER_OBJECT,C_OBJECT")
+    parser.add_argument("--size", default="size", help="size executable")
+    parser.add_argument("--nm", default="nm", help="nm executable")
+    parser.add_argument("--baseline",
+                        help="JSON file of previous section differences")
+    parser.add_argument("--update-baseline", action="store_true",
+                        help="write the differences to --baseline and exit")
+    args = parser.parse_args()
+
+    results = {}
+    for entry in args.classes:
+        name, objects = entry.split("=", 1)
+        wrapper, raw = objects.split(",", 1)
+        delta, functions, extra = measure(args.size, args.nm, wrapper, raw)
+        report(name, delta, functions, extra)
+        results[name] = delta
+
+    if args.update_baseline:
+        if not args.baseline:
+            sys.exit("error: --update-baseline needs --baseline")
+        with open(args.baseline, "w") as baseline:
+            json.dump(results, baseline, indent=2, sort_keys=True)
+            baseline.write("\n")
+        return
+
+    if (not args.baseline) or (not os.path.exists(args.baseline)):
+        return
+    with open(args.baseline) as baseline:
+        previous = json.load(baseline)
+    failures = []
+    for name, delta in sorted(results.items()):
+        for section, value in sorted(delta.items()):
+            reference = previous.get(name, {}).get(section)
+            if (reference is not None) and (value > reference):
+                failures.append("%s %s: %+d, baseline %+d" %
+                                (name, section, value, reference))
+    for failure in failures:
+        print("FAIL " + failure)
+    if failures:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+#
+# FreeRTOS-Cpp
+# Copyright (C) 2021 Jon Enz. All Rights Reserved.
+#
+# SPDX-License-Identifier: MIT
+#
+# https://github.com/jonenz/FreeRTOS-Cpp
+#
+"""Convert a FreeRTOS::Trace capture to the Trace Event Format.
+
+The input is the raw byte stream written by StaticRecorder::drain(), for
+example saved from a serial port.  The output is JSON that can be opened with
+https://ui.perfetto.dev or chrome://tracing.  Each core is a process, each task
+is a thread with a slice for every period it was running, and interrupts are
+slices on their own thread.  Object operations are instant events on the task
+that was running when they happened.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+RECORD = struct.Struct("<IIHBB")
+
+EVENTS = {
+    1: "TASK_SWITCHED_IN",
+    2: "TASK_SWITCHED_OUT",
+    3: "TASK_CREATE",
+    4: "TASK_DELETE",
+    5: "TASK_DELAY",
+    6: "TASK_DELAY_UNTIL",
+    7: "TASK_SUSPEND",
+    8: "TASK_RESUME",
+    9: "TASK_RESUME_FROM_ISR",
+    10: "TASK_PRIORITY_SET",
+    11: "TASK_NOTIFY",
+    12: "TASK_NOTIFY_FROM_ISR",
+    13: "TASK_NOTIFY_TAKE",
+    14: "TASK_NOTIFY_WAIT",
+    15: "TASK_INCREMENT_TICK",
+    20: "QUEUE_CREATE",
+    21: "QUEUE_SEND",
+    22: "QUEUE_SEND_FAILED",
+    23: "QUEUE_SEND_FROM_ISR",
+    24: "QUEUE_RECEIVE",
+    25: "QUEUE_RECEIVE_FAILED",
+    26: "QUEUE_RECEIVE_FROM_ISR",
+    27: "BLOCKING_ON_QUEUE_SEND",
+    28: "BLOCKING_ON_QUEUE_RECEIVE",
+    30: "STREAM_BUFFER_SEND",
+    31: "STREAM_BUFFER_SEND_FROM_ISR",
+    32: "STREAM_BUFFER_RECEIVE",
+    33: "STREAM_BUFFER_RECEIVE_FROM_ISR",
+    34: "BLOCKING_ON_STREAM_BUFFER_SEND",
+    35: "BLOCKING_ON_STREAM_BUFFER_RECEIVE",
+    40: "EVENT_GROUP_SET_BITS",
+    41: "EVENT_GROUP_WAIT_BITS_BLOCK",
+    45: "TIMER_EXPIRED",
+    50: "MALLOC",
+    51: "FREE",
+    60: "ISR_ENTER",
+    61: "ISR_EXIT",
+    62: "USER",
+    63: "NAME",
+    255: "START",
+}
+
+ISR_THREAD = 0xFFFFFFFF
+
+
+def read_records(data):
+    """Yield the records in data, starting at the first START record."""
+    start = 0
+    while start + RECORD.size <= len(data):
+        if RECORD.unpack_from(data, start)[3] == 255:
+            break
+        start += 1
+    for offset in range(start, len(data) - RECORD.size + 1, RECORD.size):
+        yield RECORD.unpack_from(data, offset)
+
+
+def decode(data, frequency):
+    names = {}
+    running = {}
+    events = []
+    high = 0
+    previous = None
+
+    def microseconds(timestamp):
+        # Timestamps are 32 bit counters, so unwrap them as they are read.
+        nonlocal high, previous
+        if previous is not None and timestamp < previous:
+            high += 1 << 32
+        previous = timestamp
+        return (high + timestamp) * 1e6 / frequency
+
+    for timestamp, obj, value, event, core in read_records(data):
+        name = EVENTS.get(event, "EVENT_%d" % event)
+        if event == 63:
+            text = struct.pack("<I", timestamp).split(b"\0")[0]
+            names[obj] = names.get(obj, "")[:value] + text.decode(
+                "ascii", "replace")
+            continue
+        if event == 255:
+            if value != 1:
+                sys.exit("Unsupported trace format version %d" % value)
+            continue
+
+        ts = microseconds(timestamp)
+        if event == 1:
+            running[core] = obj
+            events.append({"name": names.get(obj, "0x%08x" % obj), "ph": "B",
+                           "ts": ts, "pid": core, "tid": obj})
+        elif event == 2:
+            events.append({"ph": "E", "ts": ts, "pid": core, "tid": obj})
+        elif event in (60, 61):
+            events.append({"name": "ISR %d" % value,
+                           "ph": "B" if event == 60 else "E", "ts": ts,
+                           "pid": core, "tid": ISR_THREAD})
+        else:
+            events.append({"name": name, "ph": "i", "s": "t", "ts": ts,
+                           "pid": core, "tid": running.get(core, 0),
+                           "args": {"object": "0x%08x" % obj,
+                                    "value": value}})
+
+    cores = {e["pid"] for e in events} or {0}
+    for obj, name in names.items():
+        for core in cores:
+            events.append({"name": "thread_name", "ph": "M", "pid": core,
+                           "tid": obj, "args": {"name": name}})
+    for core in cores:
+        events.append({"name": "process_name", "ph": "M", "pid": core,
+                       "args": {"name": "Core %d" % core}})
+        events.append({"name": "thread_name", "ph": "M", "pid": core,
+                       "tid": ISR_THREAD, "args": {"name": "Interrupts"}})
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="raw trace capture")
+    parser.add_argument("output", help="Trace Event Format JSON file")
+    parser.add_argument("--frequency", type=float, required=True,
+                        help="frequency of FREERTOS_CPP_TRACE_TIMESTAMP() "
+                        "in Hz")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as capture:
+        data = capture.read()
+    with open(args.output, "w") as output:
+        json.dump(decode(data, args.frequency), output)
+
+
+if __name__ == "__main__":
+    main()